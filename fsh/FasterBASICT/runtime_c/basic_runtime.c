@@ -111,11 +111,13 @@ void basic_clear_temps(void) {
 // =============================================================================
 
 void basic_error(int32_t line_number, const char* message) {
+    basic_output_flush();  // Keep program output ahead of the message
     fprintf(stderr, "Runtime error at line %d: %s\n", line_number, message);
     exit(1);
 }
 
 void basic_error_msg(const char* message) {
+    basic_output_flush();
     if (g_current_line > 0) {
         fprintf(stderr, "Runtime error at line %d: %s\n", g_current_line, message);
     } else {
@@ -225,6 +227,13 @@ void file_close_all(void) {
 // Internal: Register file in global table
 void _basic_register_file(BasicFile* file) {
     if (!file) return;
+
+    // Numbered files live in their own slot so lookups are O(1)
+    if (file->file_number > 0 && file->file_number < MAX_FILES &&
+        !g_files[file->file_number]) {
+        g_files[file->file_number] = file;
+        return;
+    }
     
     for (int i = 0; i < MAX_FILES; i++) {
         if (!g_files[i]) {
@@ -236,6 +245,22 @@ void _basic_register_file(BasicFile* file) {
     basic_error_msg("Too many open files");
 }
 
+// Internal: Find open file by BASIC file number (NULL if not open)
+BasicFile* _basic_find_file(int32_t file_number) {
+    if (file_number <= 0) return NULL;
+
+    if (file_number < MAX_FILES && g_files[file_number] &&
+        g_files[file_number]->file_number == file_number) {
+        return g_files[file_number];
+    }
+    for (int i = 0; i < MAX_FILES; i++) {
+        if (g_files[i] && g_files[i]->file_number == file_number) {
+            return g_files[i];
+        }
+    }
+    return NULL;
+}
+
 // Internal: Unregister file from global table
 void _basic_unregister_file(BasicFile* file) {
     if (!file) return;
@@ -340,6 +365,7 @@ void basic_throw(int32_t error_code) {
             case ERR_DISK_NOT_READY:  error_msg = "Disk not ready"; break;
         }
         
+        basic_output_flush();
         fprintf(stderr, "Unhandled exception at line %d: %s (error code %d)\n",
                 g_current_line, error_msg, error_code);
         exit(1);
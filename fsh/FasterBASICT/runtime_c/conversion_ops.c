@@ -145,4 +145,147 @@ double str_to_double(BasicString* str) {
     
     // Parse double
     return atof(p);
-}
\ No newline at end of file
+}
+// =============================================================================
+// Text to Number (file input)
+// =============================================================================
+//
+// INPUT # and READCSV parse numbers straight out of the file buffer, which
+// is not NUL-terminated.  Most data files hold short decimals such as
+// "-12.75" or "3.1e4": when the significant digits fit in 53 bits and the
+// power of ten is at most 22, both are exact doubles and one multiply or
+// divide gives the correctly rounded result (Clinger's fast path, the
+// first stage of fast_float).  Everything else - long mantissas, large
+// exponents, hex, INF/NAN - goes to strtod on a terminated copy, so the
+// result never differs from strtod.
+
+static const double g_pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static bool is_letter(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// strtod/strtoll on p[0..n), reporting how many characters were used
+static double parse_double_slow(const char* p, int64_t n, int64_t* used) {
+    char small[128];
+    char* buf = n < (int64_t)sizeof(small) ? small : (char*)malloc((size_t)n + 1);
+    if (!buf) {
+        *used = 0;
+        return 0.0;
+    }
+    memcpy(buf, p, (size_t)n);
+    buf[n] = '\0';
+    char* end;
+    double value = strtod(buf, &end);
+    *used = end - buf;
+    if (buf != small) free(buf);
+    return value;
+}
+
+static int64_t parse_long_slow(const char* p, int64_t n, int64_t* used) {
+    char small[64];
+    char* buf = n < (int64_t)sizeof(small) ? small : (char*)malloc((size_t)n + 1);
+    if (!buf) {
+        *used = 0;
+        return 0;
+    }
+    memcpy(buf, p, (size_t)n);
+    buf[n] = '\0';
+    char* end;
+    long long value = strtoll(buf, &end, 10);
+    *used = end - buf;
+    if (buf != small) free(buf);
+    return (int64_t)value;
+}
+
+double basic_parse_double(const char* p, int64_t n, int64_t* used) {
+    int64_t i = 0;
+    while (i < n && (p[i] == ' ' || p[i] == '\t')) i++;
+
+    bool negative = false;
+    if (i < n && (p[i] == '-' || p[i] == '+')) {
+        negative = p[i] == '-';
+        i++;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;         // significant digits in mantissa
+    int64_t exponent = 0;
+    bool any = false;
+
+    for (; i < n && is_digit(p[i]); i++) {
+        any = true;
+        if (mantissa == 0 && p[i] == '0') continue;
+        if (++digits > 19) return parse_double_slow(p, n, used);
+        mantissa = mantissa * 10 + (uint64_t)(p[i] - '0');
+    }
+    if (i < n && p[i] == '.') {
+        for (i++; i < n && is_digit(p[i]); i++) {
+            any = true;
+            exponent--;
+            if (mantissa == 0 && p[i] == '0') continue;
+            if (++digits > 19) return parse_double_slow(p, n, used);
+            mantissa = mantissa * 10 + (uint64_t)(p[i] - '0');
+        }
+    }
+    if (!any) return parse_double_slow(p, n, used);
+
+    if (i < n && (p[i] == 'e' || p[i] == 'E')) {
+        int64_t j = i + 1;
+        bool exp_negative = false;
+        if (j < n && (p[j] == '-' || p[j] == '+')) {
+            exp_negative = p[j] == '-';
+            j++;
+        }
+        if (j < n && is_digit(p[j])) {
+            int64_t e = 0;
+            for (; j < n && is_digit(p[j]); j++) {
+                if (e < 100000) e = e * 10 + (p[j] - '0');
+            }
+            exponent += exp_negative ? -e : e;
+            i = j;
+        }
+    }
+    if (i < n && is_letter(p[i])) return parse_double_slow(p, n, used);
+
+    if (mantissa > (UINT64_C(1) << 53) || exponent < -22 || exponent > 22) {
+        return parse_double_slow(p, n, used);
+    }
+
+    double value = (double)mantissa;
+    value = exponent < 0 ? value / g_pow10[-exponent] : value * g_pow10[exponent];
+    *used = i;
+    return negative ? -value : value;
+}
+
+int64_t basic_parse_long(const char* p, int64_t n, int64_t* used) {
+    int64_t i = 0;
+    while (i < n && (p[i] == ' ' || p[i] == '\t')) i++;
+
+    bool negative = false;
+    if (i < n && (p[i] == '-' || p[i] == '+')) {
+        negative = p[i] == '-';
+        i++;
+    }
+
+    uint64_t value = 0;
+    int64_t first = i;
+    for (; i < n && is_digit(p[i]); i++) {
+        if (i - first >= 18) return parse_long_slow(p, n, used);
+        value = value * 10 + (uint64_t)(p[i] - '0');
+    }
+    if (i == first) {
+        *used = 0;
+        return 0;
+    }
+
+    *used = i;
+    return negative ? -(int64_t)value : (int64_t)value;
+}
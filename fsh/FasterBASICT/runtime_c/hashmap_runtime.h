@@ -0,0 +1,228 @@
+/*
+ * hashmap_runtime.h
+ * FasterBASIC Runtime — HASHMAP
+ *
+ * Open-addressing hash table in the style of SwissTable:
+ *
+ *   - capacity is a power of two; slot i has a control byte ctrl[i] that
+ *     is EMPTY, DELETED, or FULL with the low 7 bits of the key's hash
+ *   - a lookup loads 16 control bytes at once and compares them against
+ *     the 7-bit tag with one vector compare (SSE2 / NEON, scalar
+ *     elsewhere), so a probe touches a key only when its tag matches;
+ *     the group probe sequence is triangular over the whole table
+ *   - each slot caches the full 64-bit hash, so tag collisions are
+ *     rejected without comparing keys and a resize never rehashes a key
+ *   - at most 7/8 of the slots are in use (FULL or DELETED)
+ *   - a resize of a large map is incremental: the old table stays live
+ *     and every insert, lookup and remove moves a few of its slots into
+ *     the new one, so no single operation pays for the whole rehash
+ *     (hashmap_set_incremental(map, 0) restores one-go resizing)
+ *   - an ordered map (hashmap_set_ordered) also keeps its entries in a
+ *     dense array in insertion order; table slots then hold the entry's
+ *     index in place of the value, so iteration reads memory in sequence
+ *     and yields entries in the order their keys were first inserted
+ *
+ * Keys:
+ *   HASHMAP_KEY_STRING  StringDescriptor*, compared by length and
+ *                       characters (an ASCII and a UTF-32 string with the
+ *                       same characters are the same key).  The map keeps
+ *                       a reference to each key (string_retain).
+ *   HASHMAP_KEY_INT     int64_t
+ *   HASHMAP_KEY_DOUBLE  double, compared by value (0.0 = -0.0; all NaNs
+ *                       are one key)
+ *
+ * Values:
+ *   HASHMAP_VALUE_RAW     stored as given (void*); the map never retains
+ *                         or frees them
+ *   HASHMAP_VALUE_STRING  StringDescriptor*s the map owns: an insert
+ *                         takes over the caller's reference, and the map
+ *                         string_release()s a value when it is replaced,
+ *                         removed, cleared or freed.  BASIC's HASHMAP is
+ *                         one of these (hashmap_new_string_values), and
+ *                         dict("key") = value$ retains the string before
+ *                         the insert.
+ *
+ * The char* entry points (hashmap_insert, hashmap_lookup, ...) take NUL-
+ * terminated UTF-8 keys for C callers; generated code passes the key's
+ * StringDescriptor* to the _str variants and never converts it.
+ *
+ * Not thread-safe: protect shared maps externally.
+ */
+
+#ifndef HASHMAP_RUNTIME_H
+#define HASHMAP_RUNTIME_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "string_descriptor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HASHMAP_KEY_STRING  0
+#define HASHMAP_KEY_INT     1
+#define HASHMAP_KEY_DOUBLE  2
+
+#define HASHMAP_VALUE_RAW     0
+#define HASHMAP_VALUE_STRING  1
+
+#define HASHMAP_MIN_CAPACITY  16
+#define HASHMAP_GROUP_WIDTH   16
+
+/* Maps with fewer entries resize in one go (a pause well under 1 ms) */
+#ifndef HASHMAP_INCREMENTAL_MIN
+#define HASHMAP_INCREMENTAL_MIN  8192
+#endif
+
+/* Old-table slots moved per operation during an incremental resize */
+#ifndef HASHMAP_MIGRATE_STEP
+#define HASHMAP_MIGRATE_STEP     64
+#endif
+
+/* Moved old slots are returned to the OS in chunks of this many bytes */
+#ifndef HASHMAP_RELEASE_CHUNK
+#define HASHMAP_RELEASE_CHUNK    (256 * 1024)
+#endif
+
+/* Control bytes: FULL slots hold the 7-bit hash tag (0x00-0x7F) */
+#define HASHMAP_CTRL_EMPTY    0x80
+#define HASHMAP_CTRL_DELETED  0xFE
+
+/* A table slot, and an ordered map's entry.  Generated code reads key and
+ * value of the entries hashmap_iter_next returns at these offsets. */
+typedef struct HashMapSlot {
+    uint64_t hash;              /* full hash of the key                  */
+    union {
+        StringDescriptor* str;
+        int64_t           i;
+        double            d;
+    } key;                      /* offset HASHMAP_SLOT_KEY_OFFSET        */
+    void*    value;             /* offset HASHMAP_SLOT_VALUE_OFFSET      */
+} HashMapSlot;
+
+#define HASHMAP_SLOT_KEY_OFFSET    8
+#define HASHMAP_SLOT_VALUE_OFFSET  16
+
+typedef struct HashMap {
+    int64_t      capacity;      /* slots (power of two)                  */
+    int64_t      size;          /* FULL slots                            */
+    int64_t      tombstones;    /* DELETED slots                         */
+    int64_t      growth_left;   /* EMPTY slots usable before a resize    */
+    uint8_t*     ctrl;          /* capacity + GROUP_WIDTH bytes; the last
+                                   GROUP_WIDTH mirror the first ones     */
+    HashMapSlot* slots;
+    int32_t      key_kind;      /* HASHMAP_KEY_*                         */
+    int32_t      value_kind;    /* HASHMAP_VALUE_*                       */
+    int32_t      incremental;   /* resize incrementally (default 1)      */
+
+    /* Ordered maps: entries in insertion order.  A removed entry stays
+       in place, marked, until an append needs its room.                 */
+    HashMapSlot* entries;       /* NULL unless ordered                   */
+    int64_t      entries_used;  /* appended, including removed           */
+    int64_t      entries_capacity;
+
+    /* Previous table while an incremental resize is under way */
+    uint8_t*     old_ctrl;      /* NULL when no resize is in progress    */
+    HashMapSlot* old_slots;
+    int64_t      old_capacity;
+    int64_t      old_size;      /* entries not yet moved                 */
+    int64_t      migrate_pos;   /* next old slot to move                 */
+    int64_t      old_released;  /* bytes of moved old slots given back   */
+
+    /* Statistics (hashmap_stats) */
+    int64_t      resizes;
+    int64_t      max_pause_ns;  /* longest resize work in one operation  */
+    int64_t      last_pause_ns;
+} HashMap;
+
+typedef struct HashMapStats {
+    int64_t size;
+    int64_t capacity;           /* current table                         */
+    int64_t tombstones;
+    int64_t migrating;          /* entries still in the old table        */
+    int64_t resizes;
+    int64_t max_pause_ns;       /* worst time one insert/lookup/remove
+                                   spent resizing: the tail latency a
+                                   resize adds                           */
+    int64_t last_pause_ns;
+    int32_t incremental;
+    int32_t ordered;
+} HashMapStats;
+
+/* Construction */
+HashMap* hashmap_new(int32_t initial_capacity);          /* string keys */
+HashMap* hashmap_new_string_values(int32_t initial_capacity); /* BASIC HASHMAP */
+HashMap* hashmap_new_int(int32_t initial_capacity);
+HashMap* hashmap_new_double(int32_t initial_capacity);
+void     hashmap_free(HashMap* map);
+
+/* 0: resize in one go (finishes any resize in progress); 1: incremental */
+void     hashmap_set_incremental(HashMap* map, int32_t incremental);
+
+/* 1: keep entries in insertion order; 0: table order (the default).
+ * Either switch keeps the map's contents. */
+void     hashmap_set_ordered(HashMap* map, int32_t ordered);
+
+/* String keys (StringDescriptor*) */
+int32_t hashmap_insert_str(HashMap* map, StringDescriptor* key, void* value);
+void*   hashmap_lookup_str(HashMap* map, const StringDescriptor* key);
+int32_t hashmap_has_key_str(HashMap* map, const StringDescriptor* key);
+int32_t hashmap_remove_str(HashMap* map, const StringDescriptor* key);
+
+/* String keys (NUL-terminated UTF-8) */
+int32_t hashmap_insert(HashMap* map, const char* key, void* value);
+void*   hashmap_lookup(HashMap* map, const char* key);
+int32_t hashmap_has_key(HashMap* map, const char* key);
+int32_t hashmap_remove(HashMap* map, const char* key);
+
+/* Integer keys */
+int32_t hashmap_insert_int(HashMap* map, int64_t key, void* value);
+void*   hashmap_lookup_int(HashMap* map, int64_t key);
+int32_t hashmap_has_key_int(HashMap* map, int64_t key);
+int32_t hashmap_remove_int(HashMap* map, int64_t key);
+
+/* Double keys */
+int32_t hashmap_insert_double(HashMap* map, double key, void* value);
+void*   hashmap_lookup_double(HashMap* map, double key);
+int32_t hashmap_has_key_double(HashMap* map, double key);
+int32_t hashmap_remove_double(HashMap* map, double key);
+
+/* All maps */
+int64_t hashmap_size(HashMap* map);
+void    hashmap_clear(HashMap* map);
+
+/* Statistics.  hashmap_stats_string is the one-line form returned by
+ * BASIC's dict.STATS(); hashmap_max_pause is max_pause_ns. */
+void              hashmap_stats(HashMap* map, HashMapStats* stats);
+StringDescriptor* hashmap_stats_string(HashMap* map);
+int64_t           hashmap_max_pause(HashMap* map);
+void              hashmap_reset_stats(HashMap* map);
+
+/* Iteration without allocation.  pos starts at 0; each call returns the
+ * next entry, key and value together, and advances pos, or NULL when no
+ * entries are left.  Starting an unordered map (pos 0) finishes a resize
+ * in progress.
+ * Removing the returned entry's key is safe; keys inserted during the
+ * loop may or may not be visited, and an insert that grows an unordered
+ * map may repeat entries. */
+HashMapSlot* hashmap_iter_next(HashMap* map, int64_t* pos);
+
+/* Bulk form of hashmap_iter_next: copies up to max entries into out and
+ * returns how many (0 at the end).  Keys are not retained. */
+int64_t hashmap_export(HashMap* map, int64_t* pos, HashMapSlot* out, int64_t max);
+
+/* NULL-terminated array of the UTF-8 forms of a string map's keys (owned
+ * by the keys); free() the array, not the keys. */
+void**  hashmap_keys(HashMap* map);
+
+/* 64-bit key hashes (exposed for tests and benchmarks) */
+uint64_t hashmap_hash_string(const StringDescriptor* key);
+uint64_t hashmap_hash_int(int64_t key);
+uint64_t hashmap_hash_double(double key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HASHMAP_RUNTIME_H */
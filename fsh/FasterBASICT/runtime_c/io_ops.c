@@ -10,6 +10,54 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "string_simd.h"
+
+// =============================================================================
+// Console Output Buffering
+// =============================================================================
+//
+// PRINT writes through stdio.  Instead of flushing after every item, stdout
+// is given a large buffer at program start:
+//
+//   AUTO        line-buffered on a terminal (output appears a line at a time),
+//               block-buffered when redirected to a file or pipe
+//   BUFFERED    block-buffered even on a terminal
+//   UNBUFFERED  flushed after every PRINT item (the old behaviour)
+//
+// Buffered output is always flushed before reading the keyboard (INPUT,
+// LINE INPUT, INKEY$) and when the program exits.
+
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+
+static char g_output_buffer[OUTPUT_BUFFER_SIZE];
+static bool g_flush_every_print = false;
+
+void basic_output_init(int32_t mode) {
+    bool tty = isatty(STDOUT_FILENO);
+
+    g_flush_every_print = (mode == BASIC_OUTPUT_UNBUFFERED);
+    if (mode == BASIC_OUTPUT_UNBUFFERED) {
+        return;  // Keep the stdio default; every item is flushed anyway
+    }
+    if (mode == BASIC_OUTPUT_AUTO && tty) {
+        setvbuf(stdout, g_output_buffer, _IOLBF, OUTPUT_BUFFER_SIZE);
+    } else {
+        setvbuf(stdout, g_output_buffer, _IOFBF, OUTPUT_BUFFER_SIZE);
+    }
+}
+
+void basic_output_flush(void) {
+    fflush(stdout);
+}
+
+void _basic_output_written(void) {
+    if (g_flush_every_print) {
+        fflush(stdout);
+    }
+}
 
 // =============================================================================
 // Console Output
@@ -17,35 +65,35 @@
 
 void basic_print_int(int64_t value) {
     printf("%lld", (long long)value);
-    fflush(stdout);
+    _basic_output_written();
 }
 
 void basic_print_long(int64_t value) {
     printf("%lld", (long long)value);
-    fflush(stdout);
+    _basic_output_written();
 }
 
 void basic_print_float(float value) {
     printf("%g", value);
-    fflush(stdout);
+    _basic_output_written();
 }
 
 void basic_print_double(double value) {
     printf("%g", value);
-    fflush(stdout);
+    _basic_output_written();
 }
 
 void basic_print_string(BasicString* str) {
     if (!str) return;
     printf("%s", str->data);
-    fflush(stdout);
+    _basic_output_written();
 }
 
 // Print a C string literal (for compile-time string constants)
 void basic_print_cstr(const char* str) {
     if (!str) return;
     printf("%s", str);
-    fflush(stdout);
+    _basic_output_written();
 }
 
 // Print UTF-32 StringDescriptor (converts to UTF-8 for output)
@@ -53,34 +101,34 @@ void basic_print_string_desc(StringDescriptor* desc) {
     if (!desc) return;
     const char* utf8 = string_to_utf8(desc);
     printf("%s", utf8);
-    fflush(stdout);
+    _basic_output_written();
 }
 
 void basic_print_hex(int64_t value) {
     printf("0x%llx", (unsigned long long)value);
-    fflush(stdout);
+    _basic_output_written();
 }
 
 void basic_print_pointer(void* ptr) {
     printf("0x%llx", (unsigned long long)(uintptr_t)ptr);
-    fflush(stdout);
+    _basic_output_written();
 }
 
 void debug_print_hashmap(void* map) {
     printf("[HASHMAP@");
     basic_print_pointer(map);
     printf("]");
-    fflush(stdout);
+    _basic_output_written();
 }
 
 void basic_print_newline(void) {
     printf("\n");
-    fflush(stdout);
+    _basic_output_written();
 }
 
 void basic_print_tab(void) {
     printf("\t");
-    fflush(stdout);
+    _basic_output_written();
 }
 
 void basic_print_at(int32_t row, int32_t col, BasicString* str) {
@@ -89,13 +137,13 @@ void basic_print_at(int32_t row, int32_t col, BasicString* str) {
     if (str) {
         printf("%s", str->data);
     }
-    fflush(stdout);
+    _basic_output_written();
 }
 
 void basic_cls(void) {
     // ANSI escape code to clear screen and move cursor to home
     printf("\033[2J\033[H");
-    fflush(stdout);
+    _basic_output_written();
 }
 
 // =============================================================================
@@ -105,7 +153,7 @@ void basic_cls(void) {
 // LOCATE: Move cursor to specific row, column (1-based)
 void basic_locate(int32_t row, int32_t col) {
     printf("\033[%d;%dH", row, col);
-    fflush(stdout);
+    _basic_output_written();
 }
 
 // COLOR: Set foreground and background colors using ANSI codes
@@ -131,7 +179,7 @@ void basic_color(int32_t foreground, int32_t background) {
     }
     
     printf("\033[%d;%dm", fg, bg);
-    fflush(stdout);
+    _basic_output_written();
 }
 
 // WIDTH: Set terminal width (informational - actual effect depends on terminal)
@@ -179,6 +227,8 @@ void _basic_update_cursor_pos(int32_t row, int32_t col) {
 #include <termios.h>
 
 StringDescriptor* basic_inkey(void) {
+    basic_output_flush();
+
     // Set stdin to non-blocking mode
     int flags = fcntl(STDIN_FILENO, F_GETFL, 0);
     fcntl(STDIN_FILENO, F_SETFL, flags | O_NONBLOCK);
@@ -204,8 +254,8 @@ StringDescriptor* basic_inkey(void) {
 StringDescriptor* basic_line_input(const char* prompt) {
     if (prompt && prompt[0]) {
         printf("%s", prompt);
-        fflush(stdout);
     }
+    basic_output_flush();
     
     char buffer[4096];
     
@@ -227,6 +277,8 @@ StringDescriptor* basic_line_input(const char* prompt) {
 // =============================================================================
 
 BasicString* basic_input_string(void) {
+    basic_output_flush();
+
     char buffer[4096];
     
     if (fgets(buffer, sizeof(buffer), stdin) == NULL) {
@@ -245,7 +297,6 @@ BasicString* basic_input_string(void) {
 BasicString* basic_input_prompt(BasicString* prompt) {
     if (prompt && prompt->length > 0) {
         printf("%s", prompt->data);
-        fflush(stdout);
     }
     
     return basic_input_string();
@@ -267,6 +318,8 @@ double basic_input_double(void) {
 
 // UTF-32 StringDescriptor input (reads UTF-8 from console, converts to UTF-32)
 StringDescriptor* basic_input_line(void) {
+    basic_output_flush();
+
     char buffer[4096];
     
     if (fgets(buffer, sizeof(buffer), stdin) == NULL) {
@@ -285,44 +338,116 @@ StringDescriptor* basic_input_line(void) {
 // =============================================================================
 // File Operations
 // =============================================================================
+//
+// Every open file gets a FILE_BUFFER_SIZE stdio buffer.  Writes are never
+// flushed per item or per line: data reaches the disk when the buffer fills,
+// on file_flush(), on CLOSE and at program exit (stdio flushes all open
+// streams).  Reads go through getline() into a per-file line buffer that
+// grows as needed, so LINE INPUT # returns lines of any length whole and a
+// large file is read with a few hundred read() calls instead of one per line.
+//
+// OPEN FOR INPUT on a regular file of FILE_MMAP_MIN bytes or more maps the
+// whole file instead.  Lines and fields are then found by scanning the
+// mapping with simd_scan_u8() (which also reports, in the same pass,
+// whether the text is plain ASCII), and an ASCII line is handed to the
+// program as a view of the mapping: no bytes are copied unless the string
+// is kept (retained elsewhere) or modified.  Non-ASCII lines are decoded
+// as usual.  The mapping is released when the file is closed and the last
+// string viewing it is gone.
+
+#define FILE_BUFFER_SIZE (256 * 1024)
+
+#ifndef FILE_MMAP_MIN
+#define FILE_MMAP_MIN (64 * 1024)
+#endif
+
+// A line or field just read: points into the mapping or at file->read_buf
+typedef struct {
+    const char* text;
+    int64_t     length;
+    bool        non_ascii;
+    bool        end_of_row;     // field was ended by a line end or end of file
+} FileSpan;
 
 // Forward declarations for internal functions
 extern void _basic_register_file(BasicFile* file);
 extern void _basic_unregister_file(BasicFile* file);
+extern BasicFile* _basic_find_file(int32_t file_number);
 
-BasicFile* file_open(BasicString* filename, BasicString* mode) {
-    if (!filename || !mode) {
-        basic_error_msg("Invalid file open parameters");
-        return NULL;
+// Map a regular file opened for reading; false leaves it on stdio
+static bool map_file(BasicFile* file) {
+    struct stat st;
+    int fd = fileno(file->fp);
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < FILE_MMAP_MIN) {
+        return false;
     }
-    
+
+    void* base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (base == MAP_FAILED) return false;
+#ifdef MADV_SEQUENTIAL
+    madvise(base, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+
+    file->mapping = string_new_mapped(base, (int64_t)st.st_size);
+    if (!file->mapping) {
+        munmap(base, (size_t)st.st_size);
+        return false;
+    }
+    return true;
+}
+
+static BasicFile* open_file(const char* filename, const char* mode, bool map) {
     BasicFile* file = (BasicFile*)malloc(sizeof(BasicFile));
     if (!file) {
         basic_error_msg("Out of memory (file allocation)");
         return NULL;
     }
-    
-    file->filename = strdup(filename->data);
-    file->mode = strdup(mode->data);
-    file->file_number = 0;  // Will be set by caller if needed
-    file->is_open = false;
-    
-    // Open the file
-    file->fp = fopen(filename->data, mode->data);
+
+    file->fp = fopen(filename, mode);
     if (!file->fp) {
-        free(file->filename);
-        free(file->mode);
         free(file);
-        
+        return NULL;
+    }
+    file->io_buf = NULL;
+    file->mapping = NULL;
+    if (!map || !map_file(file)) {
+        // glibc ignores the size when it allocates the buffer itself
+        file->io_buf = (char*)malloc(FILE_BUFFER_SIZE);
+        if (file->io_buf) {
+            setvbuf(file->fp, file->io_buf, _IOFBF, FILE_BUFFER_SIZE);
+        }
+    }
+
+    file->filename = strdup(filename);
+    file->mode = strdup(mode);
+    file->file_number = 0;  // Will be set by caller if needed
+    file->is_open = true;
+    file->read_buf = NULL;
+    file->read_buf_size = 0;
+    file->read_pos = 0;
+    file->released_pos = 0;
+    file->columns = NULL;
+    file->column_count = 0;
+    file->column_capacity = 0;
+    file->column_rows = 0;
+    return file;
+}
+
+BasicFile* file_open(BasicString* filename, BasicString* mode) {
+    if (!filename || !mode) {
+        basic_error_msg("Invalid file open parameters");
+        return NULL;
+    }
+
+    BasicFile* file = open_file(filename->data, mode->data, false);
+    if (!file) {
         char err_msg[256];
         snprintf(err_msg, sizeof(err_msg), "Cannot open file: %s", filename->data);
         basic_error_msg(err_msg);
         return NULL;
     }
-    
-    file->is_open = true;
+
     _basic_register_file(file);
-    
     return file;
 }
 
@@ -346,10 +471,20 @@ void file_close(BasicFile* file) {
         free(file->mode);
         file->mode = NULL;
     }
-    
+
+    string_release(file->mapping);  // Lines still viewing it keep it mapped
+    free(file->io_buf);
+    free(file->read_buf);
+    free(file->columns);
     free(file);
 }
 
+void file_flush(BasicFile* file) {
+    if (file && file->is_open && file->fp) {
+        fflush(file->fp);
+    }
+}
+
 void file_print_string(BasicFile* file, BasicString* str) {
     if (!file || !file->is_open || !file->fp) {
         basic_error_msg("File not open for writing");
@@ -358,18 +493,11 @@ void file_print_string(BasicFile* file, BasicString* str) {
     
     if (!str) return;
     
-    fprintf(file->fp, "%s", str->data);
-    fflush(file->fp);
+    fwrite(str->data, 1, str->length, file->fp);
 }
 
 void file_print_int(BasicFile* file, int32_t value) {
-    if (!file || !file->is_open || !file->fp) {
-        basic_error_msg("File not open for writing");
-        return;
-    }
-    
-    fprintf(file->fp, "%d", value);
-    fflush(file->fp);
+    file_print_long(file, value);
 }
 
 void file_print_newline(BasicFile* file) {
@@ -378,8 +506,171 @@ void file_print_newline(BasicFile* file) {
         return;
     }
     
-    fprintf(file->fp, "\n");
-    fflush(file->fp);
+    putc('\n', file->fp);
+}
+
+// Make room for n bytes plus a NUL in file->read_buf
+static bool reserve_read_buf(BasicFile* file, size_t n) {
+    if (n + 1 <= file->read_buf_size) return true;
+    size_t cap = file->read_buf_size ? file->read_buf_size * 2 : 256;
+    while (cap < n + 1) cap *= 2;
+    uint8_t* grown = (uint8_t*)realloc(file->read_buf, cap);
+    if (!grown) {
+        basic_error_msg("Out of memory (file read buffer)");
+        return false;
+    }
+    file->read_buf = grown;
+    file->read_buf_size = cap;
+    return true;
+}
+
+static bool has_high_bit(const uint8_t* p, int64_t n) {
+    uint8_t high = 0;
+    for (int64_t i = 0; i < n; i++) {
+        high |= p[i];
+    }
+    return high >= 0x80;
+}
+
+// Next line, without the "\n" or "\r\n".  False at end of file.
+static bool next_line(BasicFile* file, FileSpan* span) {
+    if (file->mapping) {
+        const uint8_t* base = (const uint8_t*)file->mapping->data;
+        int64_t size = file->mapping->length;
+        int64_t pos = (int64_t)file->read_pos;
+        if (pos >= size) return false;
+
+        int64_t len = simd_scan_u8(base + pos, size - pos, '\n', '\n', &span->non_ascii);
+        file->read_pos = (size_t)(pos + len + (pos + len < size ? 1 : 0));
+        if (len > 0 && base[pos + len - 1] == '\r') len--;
+        span->text = (const char*)base + pos;
+        span->length = len;
+        return true;
+    }
+
+    char* line = (char*)file->read_buf;
+    size_t cap = file->read_buf_size;
+    ssize_t len = getline(&line, &cap, file->fp);
+    file->read_buf = (uint8_t*)line;
+    file->read_buf_size = cap;
+    if (len < 0) return false;
+
+    if (len > 0 && line[len - 1] == '\n') len--;
+    if (len > 0 && line[len - 1] == '\r') len--;
+    line[len] = '\0';
+    span->text = line;
+    span->length = (int64_t)len;
+    span->non_ascii = has_high_bit((const uint8_t*)line, len);
+    return true;
+}
+
+// Next INPUT # field.  Fields are separated by commas or line ends;
+// leading blanks are skipped and a field may be "quoted" to include
+// commas.  False at end of file.
+static bool next_field_mapped(BasicFile* file, FileSpan* span) {
+    const uint8_t* base = (const uint8_t*)file->mapping->data;
+    int64_t size = file->mapping->length;
+    int64_t pos = (int64_t)file->read_pos;
+    bool skipped_non_ascii;
+
+    while (pos < size && (base[pos] == ' ' || base[pos] == '\t')) pos++;
+    if (pos >= size) {
+        file->read_pos = (size_t)pos;
+        return false;
+    }
+
+    int64_t start, len;
+    if (base[pos] == '"') {
+        start = pos + 1;
+        len = simd_scan_u8(base + start, size - start, '"', '\n', &span->non_ascii);
+        pos = start + len;
+        if (pos < size && base[pos] == '"') {
+            // Skip to the separator after the closing quote
+            pos++;
+            pos += simd_scan_u8(base + pos, size - pos, ',', '\n', &skipped_non_ascii);
+        }
+    } else {
+        start = pos;
+        len = simd_scan_u8(base + start, size - start, ',', '\n', &span->non_ascii);
+        pos = start + len;
+        while (len > 0 && (base[start + len - 1] == ' ' || base[start + len - 1] == '\t' ||
+                           base[start + len - 1] == '\r')) {
+            len--;
+        }
+    }
+
+    span->end_of_row = pos >= size || base[pos] == '\n';
+    file->read_pos = (size_t)(pos < size ? pos + 1 : pos);  // consume the separator
+    span->text = (const char*)base + start;
+    span->length = len;
+    return true;
+}
+
+static bool next_field(BasicFile* file, FileSpan* span) {
+    if (file->mapping) return next_field_mapped(file, span);
+
+    FILE* fp = file->fp;
+    int64_t len = 0;
+    int c;
+
+    do {
+        c = getc(fp);
+    } while (c == ' ' || c == '\t');
+    if (c == EOF) return false;
+
+    bool quoted = (c == '"');
+    if (quoted) c = getc(fp);
+
+    for (;;) {
+        if (c == EOF || c == '\n') break;
+        if (quoted ? c == '"' : c == ',') break;
+        if (!reserve_read_buf(file, (size_t)len + 1)) return false;
+        file->read_buf[len++] = (uint8_t)c;
+        c = getc(fp);
+    }
+
+    if (quoted && c == '"') {
+        // Skip to the separator after the closing quote
+        do {
+            c = getc(fp);
+        } while (c != EOF && c != ',' && c != '\n');
+    } else {
+        while (len > 0 && (file->read_buf[len - 1] == ' ' ||
+                           file->read_buf[len - 1] == '\t' ||
+                           file->read_buf[len - 1] == '\r')) {
+            len--;
+        }
+    }
+
+    if (!reserve_read_buf(file, (size_t)len)) return false;
+    file->read_buf[len] = '\0';
+    span->text = (const char*)file->read_buf;
+    span->length = len;
+    span->non_ascii = has_high_bit(file->read_buf, len);
+    span->end_of_row = c != ',';
+    return true;
+}
+
+// NUL-terminated copy of a span (mapped text is not terminated)
+static const char* span_cstr(BasicFile* file, const FileSpan* span) {
+    if (span->text == (const char*)file->read_buf) return span->text;
+    if (!reserve_read_buf(file, (size_t)span->length)) return "";
+    memcpy(file->read_buf, span->text, (size_t)span->length);
+    file->read_buf[span->length] = '\0';
+    return (const char*)file->read_buf;
+}
+
+// S$ = span: a view of the mapping for ASCII text, else a decoded copy
+static StringDescriptor* assign_span(BasicFile* file, StringDescriptor* target,
+                                     const FileSpan* span) {
+    if (file->mapping && !span->non_ascii) {
+        int64_t start = span->text - (const char*)file->mapping->data;
+        return string_assign_view(target, file->mapping, start, span->length);
+    }
+    if (!span->non_ascii) {
+        return string_assign_utf8(target, span->text, span->length);
+    }
+    return string_assign_utf8(target, span_cstr(file, span), span->length);
 }
 
 BasicString* file_read_line(BasicFile* file) {
@@ -388,25 +679,353 @@ BasicString* file_read_line(BasicFile* file) {
         return str_new("");
     }
     
-    char buffer[4096];
-    
-    if (fgets(buffer, sizeof(buffer), file->fp) == NULL) {
+    FileSpan span;
+    if (!next_line(file, &span)) {
         return str_new("");
     }
     
-    // Remove trailing newline
-    size_t len = strlen(buffer);
-    if (len > 0 && buffer[len - 1] == '\n') {
-        buffer[len - 1] = '\0';
-    }
-    
-    return str_new(buffer);
+    return str_new(span_cstr(file, &span));
 }
 
 bool file_eof(BasicFile* file) {
     if (!file || !file->is_open || !file->fp) {
         return true;
     }
+    if (file->mapping) {
+        return (int64_t)file->read_pos >= file->mapping->length;
+    }
     
-    return feof(file->fp) != 0;
-}
\ No newline at end of file
+    // Peek, so EOF is true before a read would fail (not only after)
+    int c = getc(file->fp);
+    if (c == EOF) return true;
+    ungetc(c, file->fp);
+    return false;
+}
+
+// =============================================================================
+// Numbered Files (OPEN ... AS #n, PRINT #n, LINE INPUT #n, CLOSE #n)
+// =============================================================================
+
+void file_open_number(int32_t file_number, StringDescriptor* filename, int32_t mode) {
+    static const char* const modes[] = { "r", "w", "a" };
+
+    if (mode < BASIC_FILE_INPUT || mode > BASIC_FILE_APPEND || !filename) {
+        basic_throw(ERR_BAD_FILE);
+        return;
+    }
+    if (_basic_find_file(file_number)) {
+        basic_throw(ERR_BAD_FILE);  // File already open
+        return;
+    }
+
+    BasicFile* file = open_file(string_to_utf8(filename), modes[mode],
+                                mode == BASIC_FILE_INPUT);
+    if (!file) {
+        basic_throw(ERR_FILE_NOT_FOUND);
+        return;
+    }
+
+    file->file_number = file_number;
+    _basic_register_file(file);
+}
+
+void file_close_number(int32_t file_number) {
+    BasicFile* file = _basic_find_file(file_number);
+    if (file) {
+        file_close(file);
+    }
+}
+
+BasicFile* file_get_handle(int32_t file_number) {
+    BasicFile* file = _basic_find_file(file_number);
+    if (!file) {
+        basic_throw(ERR_BAD_FILE);
+    }
+    return file;
+}
+
+int32_t file_eof_number(int32_t file_number) {
+    return file_eof(file_get_handle(file_number)) ? -1 : 0;
+}
+
+void file_print_string_desc(BasicFile* file, StringDescriptor* str) {
+    if (!file || !str || str->length == 0) return;
+
+    if (str->encoding == STRING_ENCODING_ASCII) {
+        fwrite(str->data, 1, (size_t)str->length, file->fp);
+    } else {
+        fputs(string_to_utf8(str), file->fp);
+    }
+}
+
+void file_print_long(BasicFile* file, int64_t value) {
+    if (!file || !file->is_open || !file->fp) {
+        basic_error_msg("File not open for writing");
+        return;
+    }
+
+    // Format by hand: this is the hot path when writing numeric data
+    char buf[24];
+    char* p = buf + sizeof(buf);
+    uint64_t u = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    do {
+        *--p = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (value < 0) *--p = '-';
+    fwrite(p, 1, (size_t)(buf + sizeof(buf) - p), file->fp);
+}
+
+void file_print_double(BasicFile* file, double value) {
+    if (!file) return;
+    fprintf(file->fp, "%g", value);
+}
+
+void file_print_tab(BasicFile* file) {
+    if (!file) return;
+    putc('\t', file->fp);
+}
+
+void file_print_char(BasicFile* file, int32_t c) {
+    if (!file) return;
+    putc(c, file->fp);
+}
+
+// WRITE # string item: "text" (embedded quotes are not escaped, as in QBasic)
+void file_write_string_desc(BasicFile* file, StringDescriptor* str) {
+    if (!file) return;
+    putc('"', file->fp);
+    file_print_string_desc(file, str);
+    putc('"', file->fp);
+}
+
+StringDescriptor* file_line_input(BasicFile* file, StringDescriptor* target) {
+    FileSpan span;
+    if (!file || !next_line(file, &span)) {
+        return string_assign_utf8(target, "", 0);
+    }
+    return assign_span(file, target, &span);
+}
+
+StringDescriptor* file_input_string(BasicFile* file, StringDescriptor* target) {
+    FileSpan span;
+    if (!file || !next_field(file, &span)) {
+        return string_assign_utf8(target, "", 0);
+    }
+    return assign_span(file, target, &span);
+}
+
+// Numeric fields are parsed in place (mapped text is not NUL-terminated)
+static double span_double(const FileSpan* span) {
+    int64_t used;
+    return basic_parse_double(span->text, span->length, &used);
+}
+
+static int64_t span_long(const FileSpan* span) {
+    int64_t used;
+    int64_t value = basic_parse_long(span->text, span->length, &used);
+    if (used < span->length) {
+        char c = span->text[used];
+        if (c == '.' || c == 'e' || c == 'E') {
+            return (int64_t)basic_parse_double(span->text, span->length, &used);
+        }
+    }
+    return value;
+}
+
+double file_input_double(BasicFile* file) {
+    FileSpan span;
+    if (!file || !next_field(file, &span) || span.length == 0) return 0.0;
+    return span_double(&span);
+}
+
+int64_t file_input_long(BasicFile* file) {
+    FileSpan span;
+    if (!file || !next_field(file, &span) || span.length == 0) return 0;
+    return span_long(&span);
+}
+
+// =============================================================================
+// Bulk Input (READCSV)
+// =============================================================================
+//
+// rows = READCSV(n, a(), b$(), ...) reads one line of file #n per row and
+// stores its comma-separated fields straight into the arrays, so a large
+// delimited file is loaded without a statement, a handle lookup and a
+// variable store per field.  Fields follow the INPUT # rules (quotes,
+// blanks) and numbers go through basic_parse_double/long.  Missing fields
+// leave 0 or ""; extra fields are skipped.  A UDT array takes one field per
+// member, in declaration order.
+//
+// Reading stops when the arrays are full, so calling READCSV again on the
+// same arrays streams the file a chunk at a time.  On a mapped file the
+// pages behind the previous chunk are handed back to the kernel at each
+// call (they are read-only file pages, so strings still viewing them just
+// fault them back in): memory stays flat however large the file is.
+
+static bool add_column(BasicFile* file, uint8_t* data, size_t stride, char kind,
+                       int64_t rows) {
+    if (file->column_count == file->column_capacity) {
+        int32_t cap = file->column_capacity ? file->column_capacity * 2 : 8;
+        BasicColumn* grown = (BasicColumn*)realloc(file->columns, (size_t)cap * sizeof(BasicColumn));
+        if (!grown) {
+            basic_error_msg("Out of memory (READCSV columns)");
+            return false;
+        }
+        file->columns = grown;
+        file->column_capacity = cap;
+    }
+    if (file->column_count == 0 || rows < file->column_rows) {
+        file->column_rows = rows;
+    }
+    BasicColumn* col = &file->columns[file->column_count++];
+    col->data = data;
+    col->stride = stride;
+    col->kind = kind;
+    return true;
+}
+
+// Elements of a one-dimensional array, or -1
+static int64_t column_length(BasicArray* array) {
+    if (!array || !array->data || array->dimensions != 1) {
+        basic_error_msg("READCSV needs one-dimensional arrays");
+        return -1;
+    }
+    return (int64_t)array->bounds[1] - array->bounds[0] + 1;
+}
+
+void file_column_array(BasicFile* file, BasicArray* array) {
+    int64_t rows = column_length(array);
+    if (!file || rows < 0) return;
+
+    char kind;
+    switch (array->type_suffix) {
+        case 'b': kind = 'b'; break;
+        case 'h': kind = 'h'; break;
+        case '%': kind = 'w'; break;
+        case '&': kind = 'l'; break;
+        case '!': kind = 's'; break;
+        case '$': kind = '$'; break;
+        default:  kind = 'd'; break;
+    }
+    add_column(file, (uint8_t*)array->data, array->element_size, kind, rows);
+}
+
+void file_column_record(BasicFile* file, BasicArray* array, const char* layout) {
+    int64_t rows = column_length(array);
+    if (!file || rows < 0 || !layout) return;
+
+    size_t offset = 0;
+    for (const char* k = layout; *k; k++) {
+        if (!add_column(file, (uint8_t*)array->data + offset, array->element_size, *k, rows)) {
+            return;
+        }
+        switch (*k) {
+            case 'b': offset += 1; break;
+            case 'h': offset += 2; break;
+            case 'w': case 's': offset += 4; break;
+            default:  offset += 8; break;
+        }
+    }
+}
+
+static void store_field(BasicFile* file, const BasicColumn* col, int64_t row,
+                        const FileSpan* span) {
+    uint8_t* slot = col->data + (size_t)row * col->stride;
+    switch (col->kind) {
+        case '$': {
+            StringDescriptor** s = (StringDescriptor**)slot;
+            *s = span ? assign_span(file, *s, span) : string_assign_utf8(*s, "", 0);
+            return;
+        }
+        case 'd': {
+            double v = span ? span_double(span) : 0.0;
+            memcpy(slot, &v, sizeof(v));
+            return;
+        }
+        case 's': {
+            float v = span ? (float)span_double(span) : 0.0f;
+            memcpy(slot, &v, sizeof(v));
+            return;
+        }
+        default: {
+            int64_t v = span ? span_long(span) : 0;
+            if (col->kind == 'b') {
+                *slot = (uint8_t)v;
+            } else if (col->kind == 'h') {
+                int16_t h = (int16_t)v;
+                memcpy(slot, &h, sizeof(h));
+            } else if (col->kind == 'w') {
+                int32_t w = (int32_t)v;
+                memcpy(slot, &w, sizeof(w));
+            } else {
+                memcpy(slot, &v, sizeof(v));
+            }
+            return;
+        }
+    }
+}
+
+// Skip the rest of the current line (fields beyond the last column)
+static void skip_row(BasicFile* file) {
+    if (file->mapping) {
+        const uint8_t* base = (const uint8_t*)file->mapping->data;
+        int64_t size = file->mapping->length;
+        int64_t pos = (int64_t)file->read_pos;
+        bool non_ascii;
+        pos += simd_scan_u8(base + pos, size - pos, '\n', '\n', &non_ascii);
+        file->read_pos = (size_t)(pos < size ? pos + 1 : pos);
+        return;
+    }
+    int c;
+    do {
+        c = getc(file->fp);
+    } while (c != EOF && c != '\n');
+}
+
+// Give back the mapped pages of earlier chunks
+static void release_read_pages(BasicFile* file) {
+#ifdef MADV_DONTNEED
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t end = file->read_pos / page * page;
+    if (end > file->released_pos) {
+        madvise((uint8_t*)file->mapping->data + file->released_pos,
+                end - file->released_pos, MADV_DONTNEED);
+        file->released_pos = end;
+    }
+#else
+    (void)file;
+#endif
+}
+
+int32_t file_read_columns(BasicFile* file) {
+    if (!file) return 0;
+    int32_t ncols = file->column_count;
+    int64_t capacity = file->column_rows;
+    file->column_count = 0;
+    if (ncols == 0 || !file->is_open || !file->fp) return 0;
+    if (capacity > INT32_MAX) capacity = INT32_MAX;
+
+    if (file->mapping) release_read_pages(file);
+
+    int64_t rows = 0;
+    while (rows < capacity) {
+        FileSpan span;
+        if (!next_field(file, &span)) break;
+
+        store_field(file, &file->columns[0], rows, &span);
+        bool end_of_row = span.end_of_row;
+        for (int32_t c = 1; c < ncols; c++) {
+            if (!end_of_row && next_field(file, &span)) {
+                store_field(file, &file->columns[c], rows, &span);
+                end_of_row = span.end_of_row;
+            } else {
+                store_field(file, &file->columns[c], rows, NULL);
+                end_of_row = true;
+            }
+        }
+        if (!end_of_row) skip_row(file);
+        rows++;
+    }
+    return (int32_t)rows;
+}
@@ -11,7 +11,10 @@
  *   - String atoms call string_retain() on add, string_release() on remove
  *   - Nested list atoms are recursively freed via list_free()
  *   - SAMM integration: headers tracked as SAMM_ALLOC_LIST,
- *     atoms tracked as SAMM_ALLOC_LIST_ATOM
+ *     atoms of linked lists tracked as SAMM_ALLOC_LIST_ATOM
+ *   - Typed lists (INT / FLOAT / STRING) keep their atoms in ListChunks;
+ *     every add/remove goes through the cell_* / take_* helpers below,
+ *     which pick the representation, so the public functions don't care
  *
  * Build:
  *   cc -std=c99 -O2 -c list_ops.c -o list_ops.o
@@ -102,15 +105,15 @@ static void atom_release_payload(ListAtom* atom) {
 }
 
 /**
- * Free a single atom: release payload, then return shell to pool.
+ * Return an atom shell to the pool without touching its payload.
+ * atom_free() releases the payload first.
  *
  * Phase 2: the atom struct is returned to g_list_atom_pool via
  * samm_slab_pool_free() instead of system free().  The payload
- * (string data, nested list) is released first via atom_release_payload().
+ * (string data, nested list) is released first via atom_release_payload()
+ * in atom_free().
  */
-static void atom_free(ListAtom* atom) {
-    if (!atom) return;
-    atom_release_payload(atom);
+static void atom_recycle(ListAtom* atom) {
     /* Untrack from SAMM before returning to pool so that SAMM's
      * scope-exit cleanup won't try to list_atom_free_from_samm on an
      * already-recycled atom (double-free). */
@@ -123,6 +126,12 @@ static void atom_free(ListAtom* atom) {
     samm_slab_pool_free(&g_list_atom_pool, atom);
 }
 
+static void atom_free(ListAtom* atom) {
+    if (!atom) return;
+    atom_release_payload(atom);
+    atom_recycle(atom);
+}
+
 /**
  * Walk to the atom at 1-based position `pos` in the chain starting at `head`.
  * Returns NULL if pos is out of range [1..length].
@@ -223,6 +232,460 @@ static void list_insert_atom(ListHeader* list, int64_t pos, ListAtom* atom) {
     list->length++;
 }
 
+/**
+ * Internal: remove the first atom of a linked list and return it. Caller
+ * owns the atom.
+ * Returns NULL if list is empty.
+ */
+static ListAtom* list_shift_atom(ListHeader* list) {
+    if (!list || !list->head) return NULL;
+
+    ListAtom* atom = list->head;
+    list->head = atom->next;
+    atom->next = NULL;
+
+    if (!list->head) {
+        list->tail = NULL;
+    }
+    list->length--;
+
+    return atom;
+}
+
+/**
+ * Internal: remove the last atom of a linked list and return it. Caller
+ * owns the atom.  O(n) because we need to find the new tail in a
+ * singly-linked list (a chunked list pops in O(1), see take_last).
+ */
+static ListAtom* list_pop_atom(ListHeader* list) {
+    if (!list || !list->head) return NULL;
+
+    /* Single element? */
+    if (list->head == list->tail) {
+        ListAtom* atom = list->head;
+        list->head = NULL;
+        list->tail = NULL;
+        list->length = 0;
+        atom->next = NULL;
+        return atom;
+    }
+
+    /* Walk to the second-to-last element */
+    ListAtom* prev = list->head;
+    while (prev->next != list->tail) {
+        prev = prev->next;
+    }
+
+    ListAtom* atom = list->tail;
+    prev->next = NULL;
+    list->tail = prev;
+    list->length--;
+    atom->next = NULL;
+
+    return atom;
+}
+
+/* ========================================================================= */
+/* Internal: Chunked storage (typed lists)                                    */
+/* ========================================================================= */
+/*
+ * The atoms of a chunked list live in cells[start .. start+count-1] of a
+ * chain of ListChunks, and are still linked through `next` across chunk
+ * boundaries.  atom->pad is the atom's index in its chunk, so any atom
+ * leads back to its chunk; the first chunk is the head's, the last the
+ * tail's.  A chunk never stays empty — it is unlinked and freed.
+ *
+ * After a chunk's cells move, chunk_relink() rewrites pad/next of the
+ * moved range and the links at both ends of the chunk.
+ */
+
+static inline ListChunk* chunk_of(ListAtom* atom) {
+    return (ListChunk*)((char*)(atom - atom->pad) - offsetof(ListChunk, cells));
+}
+
+static inline ListAtom* chunk_first(ListChunk* c) {
+    return &c->cells[c->start];
+}
+
+static inline ListAtom* chunk_last(ListChunk* c) {
+    return &c->cells[c->start + c->count - 1];
+}
+
+/**
+ * Capacity for a new chunk: grows with the list, from LIST_CHUNK_MIN to
+ * LIST_CHUNK_MAX, so short lists stay small.
+ */
+static int32_t chunk_capacity_for(const ListHeader* list) {
+    int32_t cap = LIST_CHUNK_MIN;
+    while (cap < LIST_CHUNK_MAX && cap < list->length) {
+        cap *= 2;
+    }
+    return cap;
+}
+
+static ListChunk* chunk_new(int32_t capacity, int32_t start) {
+    ListChunk* c = (ListChunk*)malloc(sizeof(ListChunk) +
+                                      (size_t)capacity * sizeof(ListAtom));
+    if (!c) {
+        fprintf(stderr, "list_ops: out of memory allocating ListChunk\n");
+        abort();
+    }
+    c->prev     = NULL;
+    c->next     = NULL;
+    c->start    = start;
+    c->count    = 0;
+    c->capacity = capacity;
+    c->pad      = 0;
+    return c;
+}
+
+/**
+ * Relink cells [from, to) of a non-empty chunk, then the chunk's ends:
+ * its last atom to the next chunk, the previous chunk's last atom (or
+ * list->head) to its first, and list->tail if it is the last chunk.
+ */
+static void chunk_relink(ListHeader* list, ListChunk* c, int32_t from, int32_t to) {
+    for (int32_t i = from; i < to; i++) {
+        c->cells[i].pad  = i;
+        c->cells[i].next = &c->cells[i + 1];
+    }
+
+    ListAtom* first = chunk_first(c);
+    ListAtom* last  = chunk_last(c);
+    last->next = c->next ? chunk_first(c->next) : NULL;
+    if (c->prev) {
+        chunk_last(c->prev)->next = first;
+    } else {
+        list->head = first;
+    }
+    if (!c->next) {
+        list->tail = last;
+    }
+}
+
+/**
+ * Unlink and free an empty chunk.
+ */
+static void chunk_unlink(ListHeader* list, ListChunk* c) {
+    if (c->prev) {
+        c->prev->next = c->next;
+        chunk_last(c->prev)->next = c->next ? chunk_first(c->next) : NULL;
+    } else {
+        list->head = c->next ? chunk_first(c->next) : NULL;
+    }
+    if (c->next) {
+        c->next->prev = c->prev;
+    } else {
+        list->tail = c->prev ? chunk_last(c->prev) : NULL;
+    }
+    free(c);
+}
+
+/**
+ * Link chunk n into the chain after chunk c (before the first chunk when
+ * c is NULL).  n's cells are relinked by the caller.
+ */
+static void chunk_insert_after(ListHeader* list, ListChunk* c, ListChunk* n) {
+    n->prev = c;
+    n->next = c ? c->next : (list->head ? chunk_of(list->head) : NULL);
+    if (n->next) n->next->prev = n;
+    if (c) c->next = n;
+}
+
+/**
+ * Find the chunk holding 1-based position pos (1 <= pos <= length),
+ * walking from whichever end is nearer.  *out_k is the atom's offset from
+ * the chunk's start.
+ */
+static ListChunk* chunk_find(ListHeader* list, int64_t pos, int32_t* out_k) {
+    ListChunk* c;
+    if (pos <= list->length / 2) {
+        int64_t i = pos - 1;
+        c = chunk_of(list->head);
+        while (i >= c->count) {
+            i -= c->count;
+            c = c->next;
+        }
+        *out_k = (int32_t)i;
+    } else {
+        int64_t i = list->length - pos;     /* counted from the end */
+        c = chunk_of(list->tail);
+        while (i >= c->count) {
+            i -= c->count;
+            c = c->prev;
+        }
+        *out_k = c->count - 1 - (int32_t)i;
+    }
+    return c;
+}
+
+/**
+ * Free every chunk of a chunked list, releasing the atoms' payloads.
+ */
+static void chunks_free(ListHeader* list) {
+    ListChunk* c = list->head ? chunk_of(list->head) : NULL;
+    while (c) {
+        ListChunk* next = c->next;
+        for (int32_t i = c->start; i < c->start + c->count; i++) {
+            atom_release_payload(&c->cells[i]);
+        }
+        free(c);
+        c = next;
+    }
+    list->head   = NULL;
+    list->tail   = NULL;
+    list->length = 0;
+}
+
+/**
+ * Open a gap at offset k of a chunk that has room, moving whichever side
+ * has space, and return the new cell.
+ */
+static ListAtom* chunk_open_at(ListHeader* list, ListChunk* c, int32_t k) {
+    if (c->start + c->count < c->capacity) {
+        memmove(&c->cells[c->start + k + 1], &c->cells[c->start + k],
+                (size_t)(c->count - k) * sizeof(ListAtom));
+    } else {
+        memmove(&c->cells[c->start - 1], &c->cells[c->start],
+                (size_t)k * sizeof(ListAtom));
+        c->start--;
+    }
+    c->count++;
+    chunk_relink(list, c, c->start, c->start + c->count);
+    return &c->cells[c->start + k];
+}
+
+/* ========================================================================= */
+/* Internal: Add / remove one cell, either representation                     */
+/* ========================================================================= */
+/*
+ * The cell_* functions return a new atom already linked into the list
+ * (length updated); the caller sets its type and value.  The take_*
+ * functions unlink an atom, copy it to *out and return 1 (0 if there is
+ * none); the caller owns its payload.
+ */
+
+static ListAtom* cell_append(ListHeader* list) {
+    if (!list_is_chunked(list)) {
+        ListAtom* atom = atom_alloc();
+        list_append_atom(list, atom);
+        return atom;
+    }
+
+    ListChunk* c = list->tail ? chunk_of(list->tail) : NULL;
+    if (!c || c->start + c->count == c->capacity) {
+        ListChunk* n = chunk_new(chunk_capacity_for(list), 0);
+        chunk_insert_after(list, c, n);
+        c = n;
+    }
+    int32_t i = c->start + c->count++;
+    list->length++;
+    chunk_relink(list, c, i > c->start ? i - 1 : i, i + 1);
+    return &c->cells[i];
+}
+
+static ListAtom* cell_prepend(ListHeader* list) {
+    if (!list_is_chunked(list)) {
+        ListAtom* atom = atom_alloc();
+        list_prepend_atom(list, atom);
+        return atom;
+    }
+
+    ListChunk* c = list->head ? chunk_of(list->head) : NULL;
+    if (!c || c->start == 0) {
+        int32_t cap = chunk_capacity_for(list);
+        ListChunk* n = chunk_new(cap, cap);
+        chunk_insert_after(list, NULL, n);
+        c = n;
+    }
+    int32_t i = --c->start;
+    c->count++;
+    list->length++;
+    chunk_relink(list, c, i, i + 1);
+    return &c->cells[i];
+}
+
+static ListAtom* cell_insert(ListHeader* list, int64_t pos) {
+    /* Clamp position: 1 = prepend, past the end = append */
+    if (pos <= 1) return cell_prepend(list);
+    if (pos > list->length) return cell_append(list);
+
+    if (!list_is_chunked(list)) {
+        ListAtom* atom = atom_alloc();
+        list_insert_atom(list, pos, atom);
+        return atom;
+    }
+
+    int32_t k;
+    ListChunk* c = chunk_find(list, pos, &k);
+    list->length++;
+    if (c->count < c->capacity) {
+        return chunk_open_at(list, c, k);
+    }
+
+    /* Full: move the upper half into a new chunk after c */
+    int32_t half = c->count / 2;
+    ListChunk* n = chunk_new(c->capacity, 0);
+    n->count = c->count - half;
+    memcpy(&n->cells[0], &c->cells[c->start + half],
+           (size_t)n->count * sizeof(ListAtom));
+    c->count = half;
+    chunk_insert_after(list, c, n);
+    chunk_relink(list, n, 0, n->count);
+    chunk_relink(list, c, c->start, c->start + c->count);
+
+    return k <= half ? chunk_open_at(list, c, k)
+                     : chunk_open_at(list, n, k - half);
+}
+
+static int take_first(ListHeader* list, ListAtom* out) {
+    if (!list || !list->head) return 0;
+
+    if (!list_is_chunked(list)) {
+        ListAtom* atom = list_shift_atom(list);
+        *out = *atom;
+        atom_recycle(atom);
+        return 1;
+    }
+
+    ListChunk* c = chunk_of(list->head);
+    *out = *list->head;
+    out->next = NULL;
+    c->start++;
+    c->count--;
+    list->length--;
+    if (c->count == 0) {
+        chunk_unlink(list, c);
+    } else {
+        chunk_relink(list, c, c->start, c->start);
+    }
+    return 1;
+}
+
+static int take_last(ListHeader* list, ListAtom* out) {
+    if (!list || !list->head) return 0;
+
+    if (!list_is_chunked(list)) {
+        ListAtom* atom = list_pop_atom(list);
+        *out = *atom;
+        atom_recycle(atom);
+        return 1;
+    }
+
+    ListChunk* c = chunk_of(list->tail);
+    *out = *list->tail;
+    out->next = NULL;
+    c->count--;
+    list->length--;
+    if (c->count == 0) {
+        chunk_unlink(list, c);
+    } else {
+        chunk_relink(list, c, c->start, c->start);
+    }
+    return 1;
+}
+
+static int take_at(ListHeader* list, int64_t pos, ListAtom* out) {
+    if (!list || !list->head || pos < 1 || pos > list->length) return 0;
+    if (pos == 1) return take_first(list, out);
+    if (pos == list->length) return take_last(list, out);
+
+    if (!list_is_chunked(list)) {
+        /* Walk to the atom at position pos and its predecessor */
+        ListAtom* prev = NULL;
+        ListAtom* target = atom_walk_to(list->head, pos, &prev);
+        if (!target || !prev) return 0;
+
+        /* target can't be tail here (handled by take_last above) */
+        prev->next = target->next;
+        list->length--;
+        *out = *target;
+        out->next = NULL;
+        atom_recycle(target);
+        return 1;
+    }
+
+    int32_t k;
+    ListChunk* c = chunk_find(list, pos, &k);
+    *out = c->cells[c->start + k];
+    out->next = NULL;
+
+    /* Close the gap from the shorter side */
+    if (k < c->count / 2) {
+        memmove(&c->cells[c->start + 1], &c->cells[c->start],
+                (size_t)k * sizeof(ListAtom));
+        c->start++;
+    } else {
+        memmove(&c->cells[c->start + k], &c->cells[c->start + k + 1],
+                (size_t)(c->count - k - 1) * sizeof(ListAtom));
+    }
+    c->count--;
+    list->length--;
+    if (c->count == 0) {
+        chunk_unlink(list, c);
+    } else {
+        chunk_relink(list, c, c->start, c->start + c->count);
+    }
+    return 1;
+}
+
+/**
+ * Atom at 1-based position pos, or NULL if out of range.
+ */
+static ListAtom* atom_at(ListHeader* list, int64_t pos) {
+    if (!list_is_chunked(list)) {
+        return atom_walk_to(list->head, pos, NULL);
+    }
+    if (pos < 1 || pos > list->length) return NULL;
+    int32_t k;
+    ListChunk* c = chunk_find(list, pos, &k);
+    return &c->cells[c->start + k];
+}
+
+/* ========================================================================= */
+/* Internal: Runs of contiguous atoms                                         */
+/* ========================================================================= */
+
+/**
+ * Number of atoms stored contiguously from `atom` on: the rest of its
+ * chunk in a chunked list, 1 in a linked one.  Bulk operations loop over
+ * run[0 .. n-1] and continue at run[n-1].next, so a chunked list is read
+ * with plain indexed loops instead of a pointer chase per element.
+ */
+static inline int32_t run_length(const ListHeader* list, ListAtom* atom) {
+    if (!list_is_chunked(list)) return 1;
+    ListChunk* c = chunk_of(atom);
+    return c->start + c->count - atom->pad;
+}
+
+/**
+ * Append a copy of an atom to dest: strings are retained, nested lists
+ * deep-copied.
+ */
+static void append_atom_copy(ListHeader* dest, const ListAtom* atom) {
+    switch (atom->type) {
+        case ATOM_INT:
+            list_append_int(dest, atom->value.int_value);
+            break;
+        case ATOM_FLOAT:
+            list_append_float(dest, atom->value.float_value);
+            break;
+        case ATOM_STRING:
+            /* string_retain is called inside list_append_string */
+            list_append_string(dest, (StringDescriptor*)atom->value.ptr_value);
+            break;
+        case ATOM_LIST:
+            /* Deep copy nested list */
+            list_append_list(dest, list_copy((ListHeader*)atom->value.ptr_value));
+            break;
+        case ATOM_OBJECT:
+            list_append_object(dest, atom->value.ptr_value);
+            break;
+        default:
+            break;
+    }
+}
+
 /* ========================================================================= */
 /* Creation & Destruction                                                     */
 /* ========================================================================= */
@@ -277,16 +740,7 @@ void list_free(ListHeader* list) {
     }
 
     /* Free all atoms (returns each to g_list_atom_pool) */
-    ListAtom* curr = list->head;
-    while (curr) {
-        ListAtom* next = curr->next;
-        atom_free(curr);
-        curr = next;
-    }
-
-    list->head   = NULL;
-    list->tail   = NULL;
-    list->length = 0;
+    list_clear(list);
 
     /* Record bytes freed for SAMM accounting */
     samm_record_bytes_freed((uint64_t)sizeof(ListHeader));
@@ -300,49 +754,44 @@ void list_free(ListHeader* list) {
 
 void list_append_int(ListHeader* list, int64_t value) {
     if (!list) return;
-    ListAtom* atom = atom_alloc();
+    ListAtom* atom = cell_append(list);
     atom->type = ATOM_INT;
     atom->value.int_value = value;
-    list_append_atom(list, atom);
 }
 
 void list_append_float(ListHeader* list, double value) {
     if (!list) return;
-    ListAtom* atom = atom_alloc();
+    ListAtom* atom = cell_append(list);
     atom->type = ATOM_FLOAT;
     atom->value.float_value = value;
-    list_append_atom(list, atom);
 }
 
 void list_append_string(ListHeader* list, StringDescriptor* value) {
     if (!list) return;
-    ListAtom* atom = atom_alloc();
+    ListAtom* atom = cell_append(list);
     atom->type = ATOM_STRING;
     /* Retain the string — the list now co-owns it */
     if (value) {
         string_retain(value);
     }
     atom->value.ptr_value = (void*)value;
-    list_append_atom(list, atom);
 }
 
 void list_append_list(ListHeader* list, ListHeader* nested) {
     if (!list) return;
-    ListAtom* atom = atom_alloc();
+    ListAtom* atom = cell_append(list);
     atom->type = ATOM_LIST;
     /* We store a reference to the nested list.
      * The caller is responsible for ensuring the nested list outlives
      * this reference, or that this list owns it (e.g., LIST(...) constructor). */
     atom->value.ptr_value = (void*)nested;
-    list_append_atom(list, atom);
 }
 
 void list_append_object(ListHeader* list, void* object_ptr) {
     if (!list) return;
-    ListAtom* atom = atom_alloc();
+    ListAtom* atom = cell_append(list);
     atom->type = ATOM_OBJECT;
     atom->value.ptr_value = object_ptr;
-    list_append_atom(list, atom);
 }
 
 /* ========================================================================= */
@@ -351,37 +800,33 @@ void list_append_object(ListHeader* list, void* object_ptr) {
 
 void list_prepend_int(ListHeader* list, int64_t value) {
     if (!list) return;
-    ListAtom* atom = atom_alloc();
+    ListAtom* atom = cell_prepend(list);
     atom->type = ATOM_INT;
     atom->value.int_value = value;
-    list_prepend_atom(list, atom);
 }
 
 void list_prepend_float(ListHeader* list, double value) {
     if (!list) return;
-    ListAtom* atom = atom_alloc();
+    ListAtom* atom = cell_prepend(list);
     atom->type = ATOM_FLOAT;
     atom->value.float_value = value;
-    list_prepend_atom(list, atom);
 }
 
 void list_prepend_string(ListHeader* list, StringDescriptor* value) {
     if (!list) return;
-    ListAtom* atom = atom_alloc();
+    ListAtom* atom = cell_prepend(list);
     atom->type = ATOM_STRING;
     if (value) {
         string_retain(value);
     }
     atom->value.ptr_value = (void*)value;
-    list_prepend_atom(list, atom);
 }
 
 void list_prepend_list(ListHeader* list, ListHeader* nested) {
     if (!list) return;
-    ListAtom* atom = atom_alloc();
+    ListAtom* atom = cell_prepend(list);
     atom->type = ATOM_LIST;
     atom->value.ptr_value = (void*)nested;
-    list_prepend_atom(list, atom);
 }
 
 /* ========================================================================= */
@@ -390,29 +835,26 @@ void list_prepend_list(ListHeader* list, ListHeader* nested) {
 
 void list_insert_int(ListHeader* list, int64_t pos, int64_t value) {
     if (!list) return;
-    ListAtom* atom = atom_alloc();
+    ListAtom* atom = cell_insert(list, pos);
     atom->type = ATOM_INT;
     atom->value.int_value = value;
-    list_insert_atom(list, pos, atom);
 }
 
 void list_insert_float(ListHeader* list, int64_t pos, double value) {
     if (!list) return;
-    ListAtom* atom = atom_alloc();
+    ListAtom* atom = cell_insert(list, pos);
     atom->type = ATOM_FLOAT;
     atom->value.float_value = value;
-    list_insert_atom(list, pos, atom);
 }
 
 void list_insert_string(ListHeader* list, int64_t pos, StringDescriptor* value) {
     if (!list) return;
-    ListAtom* atom = atom_alloc();
+    ListAtom* atom = cell_insert(list, pos);
     atom->type = ATOM_STRING;
     if (value) {
         string_retain(value);
     }
     atom->value.ptr_value = (void*)value;
-    list_insert_atom(list, pos, atom);
 }
 
 /* ========================================================================= */
@@ -424,26 +866,7 @@ void list_extend(ListHeader* dest, ListHeader* src) {
 
     ListAtom* curr = src->head;
     while (curr) {
-        switch (curr->type) {
-            case ATOM_INT:
-                list_append_int(dest, curr->value.int_value);
-                break;
-            case ATOM_FLOAT:
-                list_append_float(dest, curr->value.float_value);
-                break;
-            case ATOM_STRING:
-                list_append_string(dest, (StringDescriptor*)curr->value.ptr_value);
-                break;
-            case ATOM_LIST:
-                /* Deep copy the nested list to avoid shared ownership issues */
-                list_append_list(dest, list_copy((ListHeader*)curr->value.ptr_value));
-                break;
-            case ATOM_OBJECT:
-                list_append_object(dest, curr->value.ptr_value);
-                break;
-            default:
-                break;
-        }
+        append_atom_copy(dest, curr);
         curr = curr->next;
     }
 }
@@ -452,55 +875,23 @@ void list_extend(ListHeader* dest, ListHeader* src) {
 /* Removing Elements — Shift (remove first)                                   */
 /* ========================================================================= */
 
-/**
- * Internal: remove the first atom and return it. Caller owns the atom.
- * Returns NULL if list is empty.
- */
-static ListAtom* list_shift_atom(ListHeader* list) {
-    if (!list || !list->head) return NULL;
-
-    ListAtom* atom = list->head;
-    list->head = atom->next;
-    atom->next = NULL;
-
-    if (!list->head) {
-        list->tail = NULL;
-    }
-    list->length--;
-
-    return atom;
-}
-
 int64_t list_shift_int(ListHeader* list) {
-    ListAtom* atom = list_shift_atom(list);
-    if (!atom) return 0;
-    int64_t val = atom->value.int_value;
-    /* Don't release payload for INT — just return shell to pool */
-    if (samm_is_enabled()) samm_untrack(atom);
-    samm_record_bytes_freed((uint64_t)sizeof(ListAtom));
-    samm_slab_pool_free(&g_list_atom_pool, atom);
-    return val;
+    ListAtom atom;
+    if (!take_first(list, &atom)) return 0;
+    return atom.value.int_value;
 }
 
 double list_shift_float(ListHeader* list) {
-    ListAtom* atom = list_shift_atom(list);
-    if (!atom) return 0.0;
-    double val = atom->value.float_value;
-    if (samm_is_enabled()) samm_untrack(atom);
-    samm_record_bytes_freed((uint64_t)sizeof(ListAtom));
-    samm_slab_pool_free(&g_list_atom_pool, atom);
-    return val;
+    ListAtom atom;
+    if (!take_first(list, &atom)) return 0.0;
+    return atom.value.float_value;
 }
 
 void* list_shift_ptr(ListHeader* list) {
-    ListAtom* atom = list_shift_atom(list);
-    if (!atom) return NULL;
-    void* val = atom->value.ptr_value;
+    ListAtom atom;
+    if (!take_first(list, &atom)) return NULL;
     /* Don't release the string/list — caller now owns the reference */
-    if (samm_is_enabled()) samm_untrack(atom);
-    samm_record_bytes_freed((uint64_t)sizeof(ListAtom));
-    samm_slab_pool_free(&g_list_atom_pool, atom);
-    return val;
+    return atom.value.ptr_value;
 }
 
 int32_t list_shift_type(ListHeader* list) {
@@ -509,83 +900,39 @@ int32_t list_shift_type(ListHeader* list) {
 }
 
 void list_shift(ListHeader* list) {
-    ListAtom* atom = list_shift_atom(list);
-    if (atom) {
-        atom_free(atom); /* Release payload and free */
+    ListAtom atom;
+    if (take_first(list, &atom)) {
+        atom_release_payload(&atom);
     }
 }
 
 /* ========================================================================= */
-/* Removing Elements — Pop (remove last, O(n))                                */
+/* Removing Elements — Pop (remove last; O(n) linked, O(1) chunked)          */
 /* ========================================================================= */
 
-/**
- * Internal: remove the last atom and return it. Caller owns the atom.
- * O(n) because we need to find the new tail in a singly-linked list.
- */
-static ListAtom* list_pop_atom(ListHeader* list) {
-    if (!list || !list->head) return NULL;
-
-    /* Single element? */
-    if (list->head == list->tail) {
-        ListAtom* atom = list->head;
-        list->head = NULL;
-        list->tail = NULL;
-        list->length = 0;
-        atom->next = NULL;
-        return atom;
-    }
-
-    /* Walk to the second-to-last element */
-    ListAtom* prev = list->head;
-    while (prev->next != list->tail) {
-        prev = prev->next;
-    }
-
-    ListAtom* atom = list->tail;
-    prev->next = NULL;
-    list->tail = prev;
-    list->length--;
-    atom->next = NULL;
-
-    return atom;
-}
-
 int64_t list_pop_int(ListHeader* list) {
-    ListAtom* atom = list_pop_atom(list);
-    if (!atom) return 0;
-    int64_t val = atom->value.int_value;
-    if (samm_is_enabled()) samm_untrack(atom);
-    samm_record_bytes_freed((uint64_t)sizeof(ListAtom));
-    samm_slab_pool_free(&g_list_atom_pool, atom);
-    return val;
+    ListAtom atom;
+    if (!take_last(list, &atom)) return 0;
+    return atom.value.int_value;
 }
 
 double list_pop_float(ListHeader* list) {
-    ListAtom* atom = list_pop_atom(list);
-    if (!atom) return 0.0;
-    double val = atom->value.float_value;
-    if (samm_is_enabled()) samm_untrack(atom);
-    samm_record_bytes_freed((uint64_t)sizeof(ListAtom));
-    samm_slab_pool_free(&g_list_atom_pool, atom);
-    return val;
+    ListAtom atom;
+    if (!take_last(list, &atom)) return 0.0;
+    return atom.value.float_value;
 }
 
 void* list_pop_ptr(ListHeader* list) {
-    ListAtom* atom = list_pop_atom(list);
-    if (!atom) return NULL;
-    void* val = atom->value.ptr_value;
+    ListAtom atom;
+    if (!take_last(list, &atom)) return NULL;
     /* Caller now owns the reference */
-    if (samm_is_enabled()) samm_untrack(atom);
-    samm_record_bytes_freed((uint64_t)sizeof(ListAtom));
-    samm_slab_pool_free(&g_list_atom_pool, atom);
-    return val;
+    return atom.value.ptr_value;
 }
 
 void list_pop(ListHeader* list) {
-    ListAtom* atom = list_pop_atom(list);
-    if (atom) {
-        atom_free(atom);
+    ListAtom atom;
+    if (take_last(list, &atom)) {
+        atom_release_payload(&atom);
     }
 }
 
@@ -594,35 +941,20 @@ void list_pop(ListHeader* list) {
 /* ========================================================================= */
 
 void list_remove(ListHeader* list, int64_t pos) {
-    if (!list || !list->head || pos < 1 || pos > list->length) return;
-
-    if (pos == 1) {
-        list_shift(list);
-        return;
-    }
-
-    if (pos == list->length) {
-        list_pop(list);
-        return;
+    ListAtom atom;
+    if (take_at(list, pos, &atom)) {
+        atom_release_payload(&atom);
     }
-
-    /* Walk to the atom at position pos and its predecessor */
-    ListAtom* prev = NULL;
-    ListAtom* target = atom_walk_to(list->head, pos, &prev);
-
-    if (!target || !prev) return;
-
-    prev->next = target->next;
-    target->next = NULL;
-
-    /* target can't be tail here (handled by pop case above) */
-    list->length--;
-    atom_free(target);
 }
 
 void list_clear(ListHeader* list) {
     if (!list) return;
 
+    if (list_is_chunked(list)) {
+        chunks_free(list);
+        return;
+    }
+
     ListAtom* curr = list->head;
     while (curr) {
         ListAtom* next = curr->next;
@@ -641,28 +973,28 @@ void list_clear(ListHeader* list) {
 
 int64_t list_get_int(ListHeader* list, int64_t pos) {
     if (!list) return 0;
-    ListAtom* atom = atom_walk_to(list->head, pos, NULL);
+    ListAtom* atom = atom_at(list, pos);
     if (!atom) return 0;
     return atom->value.int_value;
 }
 
 double list_get_float(ListHeader* list, int64_t pos) {
     if (!list) return 0.0;
-    ListAtom* atom = atom_walk_to(list->head, pos, NULL);
+    ListAtom* atom = atom_at(list, pos);
     if (!atom) return 0.0;
     return atom->value.float_value;
 }
 
 void* list_get_ptr(ListHeader* list, int64_t pos) {
     if (!list) return NULL;
-    ListAtom* atom = atom_walk_to(list->head, pos, NULL);
+    ListAtom* atom = atom_at(list, pos);
     if (!atom) return NULL;
     return atom->value.ptr_value;
 }
 
 int32_t list_get_type(ListHeader* list, int64_t pos) {
     if (!list) return ATOM_SENTINEL;
-    ListAtom* atom = atom_walk_to(list->head, pos, NULL);
+    ListAtom* atom = atom_at(list, pos);
     if (!atom) return ATOM_SENTINEL;
     return atom->type;
 }
@@ -751,27 +1083,7 @@ ListHeader* list_copy(ListHeader* list) {
 
     ListAtom* curr = list->head;
     while (curr) {
-        switch (curr->type) {
-            case ATOM_INT:
-                list_append_int(copy, curr->value.int_value);
-                break;
-            case ATOM_FLOAT:
-                list_append_float(copy, curr->value.float_value);
-                break;
-            case ATOM_STRING:
-                /* string_retain is called inside list_append_string */
-                list_append_string(copy, (StringDescriptor*)curr->value.ptr_value);
-                break;
-            case ATOM_LIST:
-                /* Deep copy nested list */
-                list_append_list(copy, list_copy((ListHeader*)curr->value.ptr_value));
-                break;
-            case ATOM_OBJECT:
-                list_append_object(copy, curr->value.ptr_value);
-                break;
-            default:
-                break;
-        }
+        append_atom_copy(copy, curr);
         curr = curr->next;
     }
 
@@ -787,25 +1099,7 @@ ListHeader* list_rest(ListHeader* list) {
     /* Skip the first element, copy the rest */
     ListAtom* curr = list->head->next;
     while (curr) {
-        switch (curr->type) {
-            case ATOM_INT:
-                list_append_int(rest, curr->value.int_value);
-                break;
-            case ATOM_FLOAT:
-                list_append_float(rest, curr->value.float_value);
-                break;
-            case ATOM_STRING:
-                list_append_string(rest, (StringDescriptor*)curr->value.ptr_value);
-                break;
-            case ATOM_LIST:
-                list_append_list(rest, list_copy((ListHeader*)curr->value.ptr_value));
-                break;
-            case ATOM_OBJECT:
-                list_append_object(rest, curr->value.ptr_value);
-                break;
-            default:
-                break;
-        }
+        append_atom_copy(rest, curr);
         curr = curr->next;
     }
 
@@ -836,10 +1130,9 @@ ListHeader* list_reverse(ListHeader* list) {
                 break;
             case ATOM_OBJECT: {
                 /* prepend_object doesn't exist, use manual atom creation */
-                ListAtom* atom = atom_alloc();
+                ListAtom* atom = cell_prepend(rev);
                 atom->type = ATOM_OBJECT;
                 atom->value.ptr_value = curr->value.ptr_value;
-                list_prepend_atom(rev, atom);
                 break;
             }
             default:
@@ -1057,9 +1350,345 @@ StringDescriptor* list_join(ListHeader* list, StringDescriptor* separator) {
 }
 
 /* ========================================================================= */
-/* Debug                                                                      */
+/* Operations — Sort                                                          */
 /* ========================================================================= */
 
+/* Sort classes: numbers, then strings, then everything else */
+static inline int atom_sort_class(const ListAtom* a) {
+    switch (a->type) {
+        case ATOM_INT:
+        case ATOM_FLOAT:  return 0;
+        case ATOM_STRING: return 1;
+        default:          return 2;
+    }
+}
+
+/**
+ * Three-way comparison for list_sort.  NULL strings sort first; NaN
+ * sorts after every other number.
+ */
+static int atom_sort_compare(const ListAtom* a, const ListAtom* b, int nocase) {
+    int ca = atom_sort_class(a);
+    int cb = atom_sort_class(b);
+    if (ca != cb) return ca < cb ? -1 : 1;
+
+    if (ca == 0) {
+        if (a->type == ATOM_INT && b->type == ATOM_INT) {
+            int64_t x = a->value.int_value, y = b->value.int_value;
+            return (x > y) - (x < y);
+        }
+        double x = a->type == ATOM_INT ? (double)a->value.int_value : a->value.float_value;
+        double y = b->type == ATOM_INT ? (double)b->value.int_value : b->value.float_value;
+        if (x < y) return -1;
+        if (x > y) return 1;
+        if (x == y) return 0;
+        return isnan(x) ? (isnan(y) ? 0 : 1) : -1;
+    }
+
+    if (ca == 1) {
+        const StringDescriptor* x = (const StringDescriptor*)a->value.ptr_value;
+        const StringDescriptor* y = (const StringDescriptor*)b->value.ptr_value;
+        if (!x || !y) return (x != NULL) - (y != NULL);
+        int c = nocase ? string_compare_nocase(x, y) : string_compare(x, y);
+        return (c > 0) - (c < 0);
+    }
+
+    return 0;   /* other atoms keep their order */
+}
+
+/**
+ * Bottom-up merge sort of a[0..n-1] using tmp[0..n-1]; stable.
+ */
+static void atoms_merge_sort(ListAtom* a, ListAtom* tmp, int64_t n,
+                             int descending, int nocase) {
+    ListAtom* src = a;
+    ListAtom* dst = tmp;
+
+    for (int64_t width = 1; width < n; width *= 2) {
+        for (int64_t lo = 0; lo < n; lo += 2 * width) {
+            int64_t mid = lo + width < n ? lo + width : n;
+            int64_t hi  = lo + 2 * width < n ? lo + 2 * width : n;
+            int64_t i = lo, j = mid, k = lo;
+
+            while (i < mid && j < hi) {
+                int c = atom_sort_compare(&src[j], &src[i], nocase);
+                /* Take from the right run only when strictly before */
+                if (descending ? c > 0 : c < 0) {
+                    dst[k++] = src[j++];
+                } else {
+                    dst[k++] = src[i++];
+                }
+            }
+            while (i < mid) dst[k++] = src[i++];
+            while (j < hi)  dst[k++] = src[j++];
+        }
+        ListAtom* t = src;
+        src = dst;
+        dst = t;
+    }
+
+    if (src != a) {
+        memcpy(a, src, (size_t)n * sizeof(ListAtom));
+    }
+}
+
+void list_sort(ListHeader* list, int32_t descending, int32_t nocase) {
+    if (!list || list->length < 2) return;
+
+    int64_t n = list->length;
+    ListAtom* vals = (ListAtom*)malloc((size_t)n * 2 * sizeof(ListAtom));
+    if (!vals) {
+        fprintf(stderr, "list_ops: out of memory in list_sort\n");
+        abort();
+    }
+
+    int64_t k = 0;
+    for (ListAtom* run = list->head; run; ) {
+        int32_t len = run_length(list, run);
+        memcpy(&vals[k], run, (size_t)len * sizeof(ListAtom));
+        k += len;
+        run = run[len - 1].next;
+    }
+
+    atoms_merge_sort(vals, vals + n, n, descending, nocase);
+
+    /* Move the values back; the atoms and their links stay put */
+    k = 0;
+    for (ListAtom* curr = list->head; curr; curr = curr->next, k++) {
+        curr->type  = vals[k].type;
+        curr->value = vals[k].value;
+    }
+    free(vals);
+}
+
+/* ========================================================================= */
+/* Operations — Reductions                                                    */
+/* ========================================================================= */
+
+/**
+ * Sum, min, max and count of the numeric atoms, as doubles and (exact for
+ * INT atoms) as int64_t.
+ */
+typedef struct {
+    int64_t count;
+    int64_t isum, imin, imax;
+    double  fsum, fmin, fmax;
+} ListReduction;
+
+static void list_reduce(ListHeader* list, ListReduction* r) {
+    memset(r, 0, sizeof(*r));
+    if (!list) return;
+
+    for (ListAtom* run = list->head; run; ) {
+        int32_t len = run_length(list, run);
+        for (int32_t i = 0; i < len; i++) {
+            int64_t iv;
+            double  fv;
+            if (run[i].type == ATOM_INT) {
+                iv = run[i].value.int_value;
+                fv = (double)iv;
+            } else if (run[i].type == ATOM_FLOAT) {
+                fv = run[i].value.float_value;
+                iv = (int64_t)fv;
+            } else {
+                continue;
+            }
+            if (r->count++ == 0) {
+                r->imin = r->imax = iv;
+                r->fmin = r->fmax = fv;
+            } else {
+                if (iv < r->imin) r->imin = iv;
+                if (iv > r->imax) r->imax = iv;
+                if (fv < r->fmin) r->fmin = fv;
+                if (fv > r->fmax) r->fmax = fv;
+            }
+            r->isum += iv;
+            r->fsum += fv;
+        }
+        run = run[len - 1].next;
+    }
+}
+
+int64_t list_sum_int(ListHeader* list) {
+    ListReduction r;
+    list_reduce(list, &r);
+    return r.isum;
+}
+
+double list_sum_float(ListHeader* list) {
+    ListReduction r;
+    list_reduce(list, &r);
+    return r.fsum;
+}
+
+int64_t list_min_int(ListHeader* list) {
+    ListReduction r;
+    list_reduce(list, &r);
+    return r.imin;
+}
+
+double list_min_float(ListHeader* list) {
+    ListReduction r;
+    list_reduce(list, &r);
+    return r.fmin;
+}
+
+int64_t list_max_int(ListHeader* list) {
+    ListReduction r;
+    list_reduce(list, &r);
+    return r.imax;
+}
+
+double list_max_float(ListHeader* list) {
+    ListReduction r;
+    list_reduce(list, &r);
+    return r.fmax;
+}
+
+double list_avg(ListHeader* list) {
+    ListReduction r;
+    list_reduce(list, &r);
+    return r.count ? r.fsum / (double)r.count : 0.0;
+}
+
+/* ========================================================================= */
+/* Operations — Filter / Map                                                  */
+/* ========================================================================= */
+
+enum { LIST_OP_BAD, LIST_OP_EQ, LIST_OP_NE, LIST_OP_LT, LIST_OP_LE, LIST_OP_GT,
+       LIST_OP_GE, LIST_OP_ADD, LIST_OP_SUB, LIST_OP_MUL, LIST_OP_DIV, LIST_OP_MOD };
+
+static int parse_list_op(StringDescriptor* op, int arithmetic) {
+    const char* s = op ? string_to_utf8(op) : NULL;
+    if (!s) s = "";
+
+    static const struct { const char* name; int code; int arithmetic; } ops[] = {
+        { "=",  LIST_OP_EQ, 0 }, { "==", LIST_OP_EQ, 0 },
+        { "<>", LIST_OP_NE, 0 }, { "!=", LIST_OP_NE, 0 },
+        { "<",  LIST_OP_LT, 0 }, { "<=", LIST_OP_LE, 0 },
+        { ">",  LIST_OP_GT, 0 }, { ">=", LIST_OP_GE, 0 },
+        { "+",  LIST_OP_ADD, 1 }, { "-", LIST_OP_SUB, 1 },
+        { "*",  LIST_OP_MUL, 1 }, { "/", LIST_OP_DIV, 1 },
+        { "MOD", LIST_OP_MOD, 1 }, { "mod", LIST_OP_MOD, 1 },
+    };
+    for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        if (ops[i].arithmetic == arithmetic && strcmp(s, ops[i].name) == 0) {
+            return ops[i].code;
+        }
+    }
+    fprintf(stderr, "list_ops: unknown %s operator \"%s\"\n",
+            arithmetic ? "MAP" : "FILTER", s);
+    return LIST_OP_BAD;
+}
+
+/* Does a three-way comparison result c satisfy op? */
+static inline int list_op_holds(int op, int c) {
+    switch (op) {
+        case LIST_OP_EQ: return c == 0;
+        case LIST_OP_NE: return c != 0;
+        case LIST_OP_LT: return c < 0;
+        case LIST_OP_LE: return c <= 0;
+        case LIST_OP_GT: return c > 0;
+        case LIST_OP_GE: return c >= 0;
+        default:         return 0;
+    }
+}
+
+/**
+ * New list with the atoms of `list` for which `atom op key` holds,
+ * comparing only atoms of key's sort class (numbers or strings).
+ */
+static ListHeader* list_filter_atoms(ListHeader* list, StringDescriptor* op,
+                                     const ListAtom* key) {
+    ListHeader* out = list_create_typed(list ? list_elem_type_flag(list) : 0);
+    int code = parse_list_op(op, 0);
+    if (!list || code == LIST_OP_BAD) return out;
+
+    int cls = atom_sort_class(key);
+    for (ListAtom* run = list->head; run; ) {
+        int32_t len = run_length(list, run);
+        for (int32_t i = 0; i < len; i++) {
+            if (atom_sort_class(&run[i]) == cls &&
+                list_op_holds(code, atom_sort_compare(&run[i], key, 0))) {
+                append_atom_copy(out, &run[i]);
+            }
+        }
+        run = run[len - 1].next;
+    }
+    return out;
+}
+
+ListHeader* list_filter_int(ListHeader* list, StringDescriptor* op, int64_t value) {
+    ListAtom key = { ATOM_INT, 0, { .int_value = value }, NULL };
+    return list_filter_atoms(list, op, &key);
+}
+
+ListHeader* list_filter_float(ListHeader* list, StringDescriptor* op, double value) {
+    ListAtom key = { ATOM_FLOAT, 0, { .float_value = value }, NULL };
+    return list_filter_atoms(list, op, &key);
+}
+
+ListHeader* list_filter_string(ListHeader* list, StringDescriptor* op, StringDescriptor* value) {
+    ListAtom key = { ATOM_STRING, 0, { .ptr_value = value }, NULL };
+    return list_filter_atoms(list, op, &key);
+}
+
+ListHeader* list_map_int(ListHeader* list, StringDescriptor* op, int64_t value) {
+    ListHeader* out = list_create_typed(list ? list_elem_type_flag(list) : 0);
+    int code = parse_list_op(op, 1);
+    if (!list || code == LIST_OP_BAD) return out;
+
+    for (ListAtom* run = list->head; run; ) {
+        int32_t len = run_length(list, run);
+        for (int32_t i = 0; i < len; i++) {
+            if (run[i].type != ATOM_INT && run[i].type != ATOM_FLOAT) {
+                append_atom_copy(out, &run[i]);
+                continue;
+            }
+            int64_t x = run[i].type == ATOM_INT ? run[i].value.int_value
+                                                : (int64_t)run[i].value.float_value;
+            switch (code) {
+                case LIST_OP_ADD: x += value; break;
+                case LIST_OP_SUB: x -= value; break;
+                case LIST_OP_MUL: x *= value; break;
+                case LIST_OP_DIV: x = value ? x / value : 0; break;
+                case LIST_OP_MOD: x = value ? x % value : 0; break;
+            }
+            list_append_int(out, x);
+        }
+        run = run[len - 1].next;
+    }
+    return out;
+}
+
+ListHeader* list_map_float(ListHeader* list, StringDescriptor* op, double value) {
+    ListHeader* out = list_create_typed(list ? list_elem_type_flag(list) : 0);
+    int code = parse_list_op(op, 1);
+    if (!list || code == LIST_OP_BAD) return out;
+
+    for (ListAtom* run = list->head; run; ) {
+        int32_t len = run_length(list, run);
+        for (int32_t i = 0; i < len; i++) {
+            if (run[i].type != ATOM_INT && run[i].type != ATOM_FLOAT) {
+                append_atom_copy(out, &run[i]);
+                continue;
+            }
+            double x = run[i].type == ATOM_INT ? (double)run[i].value.int_value
+                                               : run[i].value.float_value;
+            switch (code) {
+                case LIST_OP_ADD: x += value; break;
+                case LIST_OP_SUB: x -= value; break;
+                case LIST_OP_MUL: x *= value; break;
+                case LIST_OP_DIV: x /= value; break;
+                case LIST_OP_MOD: x = fmod(x, value); break;
+            }
+            list_append_float(out, x);
+        }
+        run = run[len - 1].next;
+    }
+    return out;
+}
+
 /* ========================================================================= */
 /* SAMM Cleanup Path                                                          */
 /* ========================================================================= */
@@ -1079,7 +1708,13 @@ void list_free_from_samm(void* header_ptr) {
      *
      * We just zero out the header and return the shell to the pool.
      * (Phase 2: pool-based recycling instead of system free.)
+     *
+     * A chunked list's atoms are not tracked — they belong to the header,
+     * so its chunks go with it.
      */
+    if (list_is_chunked(list)) {
+        chunks_free(list);
+    }
     list->head   = NULL;
     list->tail   = NULL;
     list->length = 0;
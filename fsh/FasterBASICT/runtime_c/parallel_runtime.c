@@ -0,0 +1,188 @@
+/*
+ * parallel_runtime.c
+ * FasterBASIC Runtime — PARALLEL FOR (see parallel_runtime.h)
+ */
+
+#include "parallel_runtime.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+extern void basic_error_msg(const char *message);
+
+// =============================================================================
+// Thread pool
+// =============================================================================
+//
+// Helper threads sleep on work_cv until a loop is published (generation
+// changes), then pull chunks off `next` until it passes the iteration
+// count, and report on done_cv.  The thread that called
+// basic_parallel_for pulls chunks the same way before waiting for the
+// helpers, so a loop never waits for a helper to wake up to make
+// progress.
+
+#define PARALLEL_MAX_THREADS      256
+#define PARALLEL_CHUNKS_PER_THREAD 8
+
+typedef struct {
+    int32_t         nthreads;     /* total, the caller included */
+    pthread_mutex_t lock;
+    pthread_cond_t  work_cv;
+    pthread_cond_t  done_cv;
+    uint64_t        generation;   /* bumped for every loop */
+    int32_t         busy;         /* helpers still on the current loop */
+
+    /* The loop being run */
+    ParallelBody    body;
+    void           *env;
+    int64_t         count;
+    int64_t         chunk;
+    atomic_llong    next;         /* first iteration not yet handed out */
+} ParallelPool;
+
+static ParallelPool    g_pool;
+static pthread_once_t  g_pool_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t g_loop_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t g_reduce_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void run_chunks(ParallelBody body, void *env, int64_t count, int64_t chunk) {
+    for (;;) {
+        int64_t first = atomic_fetch_add(&g_pool.next, chunk);
+        if (first >= count) break;
+        int64_t last = first + chunk < count ? first + chunk : count;
+        body(env, first, last);
+    }
+}
+
+static void *pool_thread_main(void *arg) {
+    (void)arg;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&g_pool.lock);
+    for (;;) {
+        while (g_pool.generation == seen) {
+            pthread_cond_wait(&g_pool.work_cv, &g_pool.lock);
+        }
+        seen = g_pool.generation;
+        ParallelBody body = g_pool.body;
+        void *env = g_pool.env;
+        int64_t count = g_pool.count;
+        int64_t chunk = g_pool.chunk;
+        pthread_mutex_unlock(&g_pool.lock);
+
+        run_chunks(body, env, count, chunk);
+
+        pthread_mutex_lock(&g_pool.lock);
+        if (--g_pool.busy == 0) {
+            pthread_cond_signal(&g_pool.done_cv);
+        }
+    }
+    return NULL;
+}
+
+static void pool_init(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    const char *env = getenv("BASIC_THREADS");
+    if (env && atol(env) > 0) n = atol(env);
+    if (n < 1) n = 1;
+    if (n > PARALLEL_MAX_THREADS) n = PARALLEL_MAX_THREADS;
+
+    pthread_mutex_init(&g_pool.lock, NULL);
+    pthread_cond_init(&g_pool.work_cv, NULL);
+    pthread_cond_init(&g_pool.done_cv, NULL);
+    g_pool.nthreads = 1;
+
+    // Helpers never exit; they die with the process.
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    for (long i = 1; i < n; i++) {
+        pthread_t t;
+        if (pthread_create(&t, &attr, pool_thread_main, NULL) != 0) break;
+        g_pool.nthreads++;
+    }
+    pthread_attr_destroy(&attr);
+}
+
+int32_t basic_parallel_threads(void) {
+    pthread_once(&g_pool_once, pool_init);
+    return g_pool.nthreads;
+}
+
+// =============================================================================
+// PARALLEL FOR
+// =============================================================================
+
+int64_t basic_parallel_for(ParallelBody body, void *env,
+                           int64_t start, int64_t end, int64_t step) {
+    if (step == 0) {
+        basic_error_msg("PARALLEL FOR with STEP 0");
+        return 0;
+    }
+
+    int64_t count;
+    if (step > 0) {
+        count = end < start ? 0 : (int64_t)((uint64_t)(end - start) / (uint64_t)step) + 1;
+    } else {
+        count = end > start ? 0 : (int64_t)((uint64_t)(start - end) / (uint64_t)-step) + 1;
+    }
+    if (count == 0) return 0;
+
+    int32_t nthreads = basic_parallel_threads();
+    if (nthreads == 1 || count < 2) {
+        body(env, 0, count);
+        return count;
+    }
+
+    int64_t chunk = count / ((int64_t)nthreads * PARALLEL_CHUNKS_PER_THREAD);
+    if (chunk < 1) chunk = 1;
+
+    pthread_mutex_lock(&g_loop_lock);
+
+    pthread_mutex_lock(&g_pool.lock);
+    g_pool.body  = body;
+    g_pool.env   = env;
+    g_pool.count = count;
+    g_pool.chunk = chunk;
+    atomic_store(&g_pool.next, 0);
+    g_pool.busy  = nthreads - 1;
+    g_pool.generation++;
+    pthread_cond_broadcast(&g_pool.work_cv);
+    pthread_mutex_unlock(&g_pool.lock);
+
+    run_chunks(body, env, count, chunk);
+
+    pthread_mutex_lock(&g_pool.lock);
+    while (g_pool.busy > 0) {
+        pthread_cond_wait(&g_pool.done_cv, &g_pool.lock);
+    }
+    pthread_mutex_unlock(&g_pool.lock);
+
+    pthread_mutex_unlock(&g_loop_lock);
+    return count;
+}
+
+// =============================================================================
+// REDUCE
+// =============================================================================
+
+void basic_parallel_reduce_long(int64_t *acc, int64_t value, int32_t op) {
+    pthread_mutex_lock(&g_reduce_lock);
+    switch (op) {
+        case PARALLEL_REDUCE_MIN: if (value < *acc) *acc = value; break;
+        case PARALLEL_REDUCE_MAX: if (value > *acc) *acc = value; break;
+        default:                  *acc += value; break;
+    }
+    pthread_mutex_unlock(&g_reduce_lock);
+}
+
+void basic_parallel_reduce_double(double *acc, double value, int32_t op) {
+    pthread_mutex_lock(&g_reduce_lock);
+    switch (op) {
+        case PARALLEL_REDUCE_MIN: if (value < *acc) *acc = value; break;
+        case PARALLEL_REDUCE_MAX: if (value > *acc) *acc = value; break;
+        default:                  *acc += value; break;
+    }
+    pthread_mutex_unlock(&g_reduce_lock);
+}
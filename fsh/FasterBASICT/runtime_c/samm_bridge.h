@@ -98,6 +98,10 @@ int samm_is_enabled(void);
 /* Emitted by codegen at SUB/FUNCTION/METHOD/FOR/WHILE boundaries.            */
 /* Every samm_enter_scope() must have a matching samm_exit_scope() on         */
 /* every control-flow path (including early RETURN).                          */
+/*                                                                            */
+/* Each thread has its own scope stack (created on first use), so these and  */
+/* the tracking calls below are lock-free and only see the calling thread's  */
+/* scopes.  A pointer belongs to the thread that tracked it.                  */
 /* ========================================================================= */
 
 /**
@@ -288,6 +292,18 @@ void samm_track_string(void* string_desc_ptr);
  */
 void* samm_alloc_string(void);
 
+/**
+ * Allocate a StringDescriptor without tracking it in any scope.
+ *
+ * Used for compiler-proven non-escaping temporaries (e.g. a string
+ * literal that is only printed or compared). The generated code
+ * releases the descriptor with string_release() right after its last
+ * use, so registering it with the scope would be wasted work.
+ *
+ * @return Pointer to a zeroed StringDescriptor, or NULL on failure
+ */
+void* samm_alloc_string_untracked(void);
+
 /* ========================================================================= */
 /* Destructor Registration                                                    */
 /*                                                                            */
@@ -338,10 +354,16 @@ typedef struct {
     size_t   bloom_memory_bytes;        /* Bloom filter memory usage         */
     double   total_cleanup_time_ms;     /* Total background cleanup time     */
     int      background_worker_active;  /* Non-zero if worker thread running */
+    int      active_threads;            /* Threads with a live scope stack   */
+    uint64_t scopes_coalesced;          /* Small scopes merged into a batch  */
+    uint64_t worker_wakeups;            /* Times the idle worker was woken   */
 } SAMMStats;
 
 /**
  * Get a snapshot of SAMM statistics.
+ * Counters are kept per thread and summed here (live threads plus those
+ * that have already exited).  current_scope_depth is the calling
+ * thread's depth; peak_scope_depth is the maximum over all threads.
  * @param out_stats  Pointer to struct to fill in
  */
 void samm_get_stats(SAMMStats* out_stats);
@@ -363,7 +385,9 @@ void samm_set_trace(int enabled);
 /**
  * Block until all queued background cleanup work is complete.
  * Useful before program exit to ensure all destructors have run
- * and diagnostic output is complete.
+ * and diagnostic output is complete.  Flushes the calling thread's
+ * coalesced small scopes first; other threads' pending batches are
+ * handed over when they exit.
  */
 void samm_wait(void);
 
@@ -386,9 +410,25 @@ void samm_record_bytes_freed(uint64_t bytes);
 /** Initial capacity for per-scope pointer tracking arrays. */
 #define SAMM_SCOPE_INITIAL_CAPACITY 32
 
-/** Maximum cleanup queue depth before blocking. */
+/** Initial bucket count for the per-thread pointer -> scope index
+ *  (power of two; grows at 50% load). */
+#define SAMM_INDEX_INITIAL_CAPACITY 64
+
+/** Cleanup ring capacity in batches (power of two).  When the ring is
+ *  full the exiting scope is cleaned synchronously instead. */
 #define SAMM_MAX_QUEUE_DEPTH        1024
 
+/** Scopes tracking at most this many pointers are not queued on their
+ *  own: their pointers are appended to a per-thread pending batch. */
+#define SAMM_COALESCE_SCOPE_MAX     64
+
+/** A thread's pending batch is handed to the worker once it holds this
+ *  many pointers (or on samm_wait / thread exit / shutdown). */
+#define SAMM_COALESCE_BATCH         256
+
+/** Empty-ring polls the worker makes before sleeping on its condvar. */
+#define SAMM_WORKER_SPIN_ITERS      128
+
 /**
  * Bloom filter configuration — LAZY allocation (Phase 4).
  *
@@ -12,19 +12,34 @@
  * be compiled with a plain C compiler.
  *
  * Components:
- *   1. Scope Stack    — fixed-depth array of dynamic pointer vectors
+ *   1. Scope Stacks   — one per thread, fixed-depth array of pointer vectors
  *   2. Bloom Filter   — lazily allocated double-free detector (Phase 4)
- *   3. Cleanup Queue  — bounded ring buffer of pointer batches
- *   4. Background Worker — pthread that drains the cleanup queue
- *   5. Metrics        — atomic counters for diagnostics
+ *   3. Cleanup Ring   — lock-free bounded MPSC ring of pointer batches
+ *   4. Background Worker — pthread that drains the cleanup ring
+ *   5. Metrics        — per-thread counters rolled up on demand
  *
  * Thread safety:
- *   - scope_mutex_   protects the scope stack (hot path, minimal hold time)
- *   - queue_mutex_   protects the cleanup queue (producer/consumer)
- *   - Bloom filter writes are protected by scope_mutex_ (freed pointers
- *     are only added during samm_free_object or background cleanup).
- *     The filter is lazily allocated on first overflow-class object
- *     free — programs with no >1024 B objects never allocate it.
+ *   - Scope stacks are thread-confined.  Each thread reaches its own
+ *     SAMMThreadScopes through a thread-local pointer, so track /
+ *     untrack / enter / exit / retain take no lock at all.  A pointer
+ *     is owned by the thread that tracked it; cross-thread hand-off
+ *     goes through MARSHALL, which deep-copies.
+ *   - The registry mutex protects the list of live thread stacks.  It is
+ *     only taken when a thread first touches SAMM, when it exits, and
+ *     when statistics are rolled up.
+ *   - The cleanup ring is lock-free: producers claim a slot with a CAS on
+ *     the tail and publish it through a per-slot sequence number; the
+ *     worker is the only consumer.  Small scopes are first coalesced into
+ *     a per-thread pending batch, so a tight call loop publishes one
+ *     batch per SAMM_COALESCE_BATCH pointers rather than one per return.
+ *   - wake_mutex / wake_cv are only used to park an idle worker.  The
+ *     worker spins briefly on an empty ring, then sleeps; producers only
+ *     signal when the worker has announced that it is sleeping.
+ *   - bloom_mutex    protects the Bloom filter (freed pointers are only
+ *     added during samm_free_object or background cleanup of
+ *     overflow-class objects).  The filter is lazily allocated on first
+ *     overflow-class object free — programs with no >1024 B objects
+ *     never allocate it or take this lock.
  *
  * Build:
  *   cc -O2 -c samm_core.c -o samm_core.o -lpthread
@@ -40,6 +55,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <pthread.h>
+#include <sched.h>
+#include <time.h>
 #include <inttypes.h>
 
 /* string_release is defined in string_utf32.c and declared in
@@ -59,6 +76,17 @@ typedef _Atomic int      samm_atomic_int;
 #define SAMM_ATOMIC_STORE(x, v)    atomic_store(&(x), (v))
 #define SAMM_ATOMIC_INC(x)         atomic_fetch_add(&(x), 1)
 #define SAMM_ATOMIC_ADD(x, v)      atomic_fetch_add(&(x), (v))
+#define SAMM_ATOMIC_LOAD_ACQ(x)    atomic_load_explicit(&(x), memory_order_acquire)
+#define SAMM_ATOMIC_STORE_REL(x, v) atomic_store_explicit(&(x), (v), memory_order_release)
+/* Compare-and-swap; on failure *expp receives the current value. */
+#define SAMM_ATOMIC_CAS(x, expp, v) atomic_compare_exchange_weak(&(x), (expp), (v))
+#define SAMM_ATOMIC_FENCE()        atomic_thread_fence(memory_order_seq_cst)
+/* Single-writer counters: only the owning thread writes, other threads
+ * may read during a stats rollup.  Relaxed load+store, no lock prefix. */
+#define SAMM_LOCAL_ADD(x, v)       atomic_store_explicit(&(x), \
+                                       atomic_load_explicit(&(x), memory_order_relaxed) + (v), \
+                                       memory_order_relaxed)
+#define SAMM_THREAD_LOCAL          _Thread_local
 #else
 /* Fallback: GCC/Clang __sync builtins */
 typedef volatile uint64_t samm_atomic_u64;
@@ -67,6 +95,28 @@ typedef volatile int      samm_atomic_int;
 #define SAMM_ATOMIC_STORE(x, v)    do { __sync_lock_test_and_set(&(x), (v)); } while(0)
 #define SAMM_ATOMIC_INC(x)         __sync_fetch_and_add(&(x), 1)
 #define SAMM_ATOMIC_ADD(x, v)      __sync_fetch_and_add(&(x), (v))
+#define SAMM_ATOMIC_LOAD_ACQ(x)    __sync_add_and_fetch(&(x), 0)
+#define SAMM_ATOMIC_STORE_REL(x, v) do { __sync_synchronize(); (x) = (v); } while(0)
+#define SAMM_ATOMIC_CAS(x, expp, v) __extension__ ({                       \
+        __typeof__(*(expp)) samm_cas_old_ =                                 \
+            __sync_val_compare_and_swap(&(x), *(expp), (v));                \
+        int samm_cas_ok_ = (samm_cas_old_ == *(expp));                      \
+        *(expp) = samm_cas_old_;                                            \
+        samm_cas_ok_; })
+#define SAMM_ATOMIC_FENCE()        __sync_synchronize()
+#define SAMM_LOCAL_ADD(x, v)       do { (x) += (v); } while(0)
+#define SAMM_THREAD_LOCAL          __thread
+#endif
+
+#define SAMM_LOCAL_INC(x)          SAMM_LOCAL_ADD(x, 1)
+
+/* Spin-wait hint for the worker's idle loop */
+#if defined(__x86_64__) || defined(__i386__)
+#define SAMM_CPU_RELAX()           __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define SAMM_CPU_RELAX()           __asm__ __volatile__("yield")
+#else
+#define SAMM_CPU_RELAX()           do { } while (0)
 #endif
 
 /* ========================================================================= */
@@ -114,38 +164,24 @@ static void scope_push(SAMMScope* s, void* ptr, SAMMAllocType type, uint8_t size
     s->count++;
 }
 
-/* Remove first occurrence of ptr from scope.  Returns 1 if found, 0 if not.
- * If out_size_class is non-NULL, stores the removed entry's size class. */
-static int scope_remove(SAMMScope* s, void* ptr, uint8_t* out_size_class) {
-    for (size_t i = 0; i < s->count; i++) {
-        if (s->ptrs[i] == ptr) {
-            if (out_size_class) {
-                *out_size_class = s->size_classes[i];
-            }
-            /* Swap with last element for O(1) removal */
-            s->count--;
-            s->ptrs[i]         = s->ptrs[s->count];
-            s->types[i]        = s->types[s->count];
-            s->size_classes[i] = s->size_classes[s->count];
-            return 1;
-        }
-    }
-    return 0;
+/* Remove the entry at index i by swapping the last element into its place.
+ * Returns the pointer that moved into slot i, or NULL if i was the last. */
+static void* scope_remove_at(SAMMScope* s, size_t i) {
+    s->count--;
+    if (i == s->count) return NULL;
+    s->ptrs[i]         = s->ptrs[s->count];
+    s->types[i]        = s->types[s->count];
+    s->size_classes[i] = s->size_classes[s->count];
+    return s->ptrs[i];
 }
 
-/* Find the type and size class for a given pointer.
- * Returns SAMM_ALLOC_UNKNOWN if not found.
- * If out_size_class is non-NULL, stores the entry's size class. */
-static SAMMAllocType scope_find_type(SAMMScope* s, void* ptr, uint8_t* out_size_class) {
+/* Linear search for the first occurrence of ptr.  Returns its index or -1.
+ * Only used for pointers tracked more than once (see the membership index). */
+static ptrdiff_t scope_find(const SAMMScope* s, const void* ptr) {
     for (size_t i = 0; i < s->count; i++) {
-        if (s->ptrs[i] == ptr) {
-            if (out_size_class) {
-                *out_size_class = s->size_classes[i];
-            }
-            return s->types[i];
-        }
+        if (s->ptrs[i] == ptr) return (ptrdiff_t)i;
     }
-    return SAMM_ALLOC_UNKNOWN;
+    return -1;
 }
 
 static void scope_destroy(SAMMScope* s) {
@@ -159,6 +195,127 @@ static void scope_destroy(SAMMScope* s) {
     s->capacity     = 0;
 }
 
+/* An exited, empty scope keeps small arrays for the next scope entered at
+ * the same depth, so a tight call loop does not malloc/free per call. */
+static void scope_recycle(SAMMScope* s) {
+    if (s->capacity > SAMM_COALESCE_SCOPE_MAX) {
+        scope_destroy(s);
+    }
+}
+
+/* ========================================================================= */
+/* Scope Membership Index: pointer -> (depth, slot)                           */
+/*                                                                            */
+/* Open-addressed, linear-probing table with backward-shift deletion (no     */
+/* tombstones).  untrack / free_object / retain look a pointer up here in    */
+/* O(1) instead of scanning every scope's ptrs[] from the innermost scope    */
+/* outward, so deleting N objects from one scope is O(N), not O(N^2).        */
+/*                                                                            */
+/* Swap-remove keeps working as before; the element that moves into the     */
+/* vacated slot has its index entry patched.                                 */
+/*                                                                            */
+/* A pointer tracked more than once keeps a single entry with count > 1.    */
+/* Its depth/slot are then not authoritative and removal falls back to the  */
+/* linear innermost-first scan, which preserves the original semantics.     */
+/* ========================================================================= */
+
+typedef struct {
+    void*    key;       /* NULL = empty bucket                        */
+    uint32_t slot;      /* Index into scopes[depth].ptrs (count == 1) */
+    uint16_t depth;     /* Scope depth (count == 1)                   */
+    uint16_t count;     /* Number of times this pointer is tracked    */
+} SAMMIndexEntry;
+
+typedef struct {
+    SAMMIndexEntry* entries;
+    size_t          capacity;   /* Power of two, 0 until first insert */
+    size_t          count;
+} SAMMScopeIndex;
+
+static inline size_t index_hash(const void* ptr, size_t mask) {
+    /* fmix64 finaliser — pool slots share low bits, so mix them well */
+    uint64_t h = (uint64_t)(uintptr_t)ptr;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return (size_t)h & mask;
+}
+
+static SAMMIndexEntry* index_find(const SAMMScopeIndex* ix, const void* ptr) {
+    if (ix->count == 0) return NULL;
+    size_t mask = ix->capacity - 1;
+    for (size_t i = index_hash(ptr, mask); ; i = (i + 1) & mask) {
+        SAMMIndexEntry* e = &ix->entries[i];
+        if (e->key == ptr) return e;
+        if (!e->key) return NULL;
+    }
+}
+
+static void index_grow(SAMMScopeIndex* ix) {
+    size_t new_cap = ix->capacity ? ix->capacity * 2 : SAMM_INDEX_INITIAL_CAPACITY;
+    SAMMIndexEntry* fresh = (SAMMIndexEntry*)calloc(new_cap, sizeof(SAMMIndexEntry));
+    if (!fresh) {
+        fprintf(stderr, "SAMM FATAL: scope index alloc failed (cap=%zu)\n", new_cap);
+        abort();
+    }
+    size_t mask = new_cap - 1;
+    for (size_t i = 0; i < ix->capacity; i++) {
+        SAMMIndexEntry* e = &ix->entries[i];
+        if (!e->key) continue;
+        size_t j = index_hash(e->key, mask);
+        while (fresh[j].key) j = (j + 1) & mask;
+        fresh[j] = *e;
+    }
+    free(ix->entries);
+    ix->entries  = fresh;
+    ix->capacity = new_cap;
+}
+
+static void index_insert(SAMMScopeIndex* ix, void* ptr, int depth, size_t slot) {
+    SAMMIndexEntry* e = index_find(ix, ptr);
+    if (e) {
+        e->count++;
+        return;
+    }
+    /* Keep load factor <= 1/2 so probe sequences stay short */
+    if ((ix->count + 1) * 2 > ix->capacity) index_grow(ix);
+    size_t mask = ix->capacity - 1;
+    size_t i = index_hash(ptr, mask);
+    while (ix->entries[i].key) i = (i + 1) & mask;
+    ix->entries[i].key   = ptr;
+    ix->entries[i].slot  = (uint32_t)slot;
+    ix->entries[i].depth = (uint16_t)depth;
+    ix->entries[i].count = 1;
+    ix->count++;
+}
+
+/* Backward-shift deletion: pull later members of the probe run into the
+ * hole so lookups never need tombstones. */
+static void index_erase(SAMMScopeIndex* ix, SAMMIndexEntry* e) {
+    size_t mask = ix->capacity - 1;
+    size_t hole = (size_t)(e - ix->entries);
+    size_t j = hole;
+    for (;;) {
+        j = (j + 1) & mask;
+        SAMMIndexEntry* next = &ix->entries[j];
+        if (!next->key) break;
+        size_t home = index_hash(next->key, mask);
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            ix->entries[hole] = *next;
+            hole = j;
+        }
+    }
+    ix->entries[hole].key = NULL;
+    ix->count--;
+}
+
+static void index_reset(SAMMScopeIndex* ix) {
+    free(ix->entries);
+    ix->entries  = NULL;
+    ix->capacity = 0;
+    ix->count    = 0;
+}
+
 /* ========================================================================= */
 /* Cleanup Batch: a snapshot of pointers to clean up                          */
 /* ========================================================================= */
@@ -170,6 +327,13 @@ typedef struct {
     size_t        count;
 } SAMMCleanupBatch;
 
+/* One cleanup ring slot.  seq == position means free for the producer
+ * claiming that position; seq == position + 1 means published. */
+typedef struct {
+    samm_atomic_u64  seq;
+    SAMMCleanupBatch batch;
+} SAMMRingSlot;
+
 /* ========================================================================= */
 /* Bloom Filter — Lazily Allocated (Phase 4)                                  */
 /*                                                                            */
@@ -216,7 +380,7 @@ static void bloom_init(SAMMBloomFilter* bf) {
     bf->items_added = 0;
 }
 
-/* Allocate the filter on first use.  Called under scope_mutex. */
+/* Allocate the filter on first use.  Called under bloom_mutex. */
 static void bloom_ensure_allocated(SAMMBloomFilter* bf) {
     if (bf->bits) return;  /* Already allocated */
 
@@ -270,32 +434,189 @@ static int bloom_check(const SAMMBloomFilter* bf, const void* ptr) {
     return 1;  /* Probably in the set */
 }
 
+/* ========================================================================= */
+/* Per-Thread State: scope stack + counters                                   */
+/*                                                                            */
+/* Every thread that tracks allocations owns one SAMMThreadScopes, created   */
+/* lazily on first use and reached through the t_samm thread-local pointer.  */
+/* Only the owning thread mutates its scopes or bumps its counters, so the   */
+/* hot path (track/untrack/enter/exit) is lock-free.  Counters are read by   */
+/* other threads only when samm_get_stats() rolls them up.                   */
+/* ========================================================================= */
+
+enum {
+    SAMM_STAT_SCOPES_ENTERED = 0,
+    SAMM_STAT_SCOPES_EXITED,
+    SAMM_STAT_OBJECTS_ALLOCATED,
+    SAMM_STAT_OBJECTS_FREED,
+    SAMM_STAT_OBJECTS_CLEANED,
+    SAMM_STAT_CLEANUP_BATCHES,
+    SAMM_STAT_DOUBLE_FREE_ATTEMPTS,
+    SAMM_STAT_RETAIN_CALLS,
+    SAMM_STAT_BYTES_ALLOCATED,
+    SAMM_STAT_BYTES_FREED,
+    SAMM_STAT_STRINGS_TRACKED,
+    SAMM_STAT_STRINGS_CLEANED,
+    SAMM_STAT_SCOPES_COALESCED,
+    SAMM_STAT_COUNT
+};
+
+typedef struct SAMMThreadScopes {
+    SAMMScope        scopes[SAMM_MAX_SCOPE_DEPTH];
+    int              scope_depth;      /* Current depth (0 = thread's global) */
+    samm_atomic_int  peak_scope_depth;
+    samm_atomic_u64  stats[SAMM_STAT_COUNT];
+    SAMMScopeIndex   index;            /* ptr -> (depth, slot) membership  */
+    SAMMScope        pending;          /* Coalesced small scopes, not yet
+                                        * handed to the worker            */
+    struct SAMMThreadScopes* next;     /* Registry link (registry mutex)    */
+} SAMMThreadScopes;
+
+/*
+ * Registry of live per-thread stacks.  Kept outside g_samm (which
+ * samm_init() memsets) so that threads attached before initialisation
+ * stay registered, and statically initialised so attaching never
+ * depends on samm_init() having run.
+ */
+static struct {
+    pthread_mutex_t   mutex;
+    pthread_once_t    key_once;
+    pthread_key_t     key;              /* Destructor hook for thread exit */
+    SAMMThreadScopes* head;
+    uint64_t          retired[SAMM_STAT_COUNT]; /* Counters of exited threads */
+    int               retired_peak_depth;
+} g_samm_threads = { .mutex = PTHREAD_MUTEX_INITIALIZER, .key_once = PTHREAD_ONCE_INIT };
+
+static SAMM_THREAD_LOCAL SAMMThreadScopes* t_samm = NULL;
+
+static SAMMThreadScopes* samm_thread_attach(void);
+
+/* Fast path: the calling thread's scope stack (attached on first use). */
+static inline SAMMThreadScopes* samm_thread(void) {
+    SAMMThreadScopes* ts = t_samm;
+    return ts ? ts : samm_thread_attach();
+}
+
+static inline void samm_stat_add(int id, uint64_t v) {
+    SAMM_LOCAL_ADD(samm_thread()->stats[id], v);
+}
+
+/* ========================================================================= */
+/* Per-Thread Tracking: scope arrays + membership index kept in step          */
+/* ========================================================================= */
+
+static void ts_push(SAMMThreadScopes* ts, int depth, void* ptr,
+                    SAMMAllocType type, uint8_t size_class) {
+    SAMMScope* s = &ts->scopes[depth];
+    index_insert(&ts->index, ptr, depth, s->count);
+    scope_push(s, ptr, type, size_class);
+}
+
+/* Remove scopes[depth].ptrs[i], patching the index entry of whichever
+ * pointer the swap-remove moved into slot i. */
+static void ts_remove_at(SAMMThreadScopes* ts, int depth, size_t i) {
+    void* moved = scope_remove_at(&ts->scopes[depth], i);
+    if (moved) {
+        SAMMIndexEntry* m = index_find(&ts->index, moved);
+        if (m && m->count == 1) m->slot = (uint32_t)i;
+    }
+}
+
+/* Innermost-first linear search over scopes [0, max_depth]. */
+static int ts_locate(SAMMThreadScopes* ts, const void* ptr, int max_depth,
+                     size_t* out_slot) {
+    for (int d = max_depth; d >= 0; d--) {
+        ptrdiff_t i = scope_find(&ts->scopes[d], ptr);
+        if (i >= 0) {
+            *out_slot = (size_t)i;
+            return d;
+        }
+    }
+    return -1;
+}
+
+/* A multiply-tracked pointer dropped to a single occurrence: find it
+ * again so its index entry becomes authoritative. */
+static void ts_relocate(SAMMThreadScopes* ts, SAMMIndexEntry* e, int max_depth) {
+    size_t slot = 0;
+    int d = ts_locate(ts, e->key, max_depth, &slot);
+    if (d >= 0) {
+        e->depth = (uint16_t)d;
+        e->slot  = (uint32_t)slot;
+    }
+}
+
+/* Remove one tracked occurrence of ptr from the calling thread's scopes.
+ * Returns the depth it was found at (-1 if not tracked) and optionally its
+ * type and size class.  O(1) unless the pointer is tracked more than once. */
+static int ts_remove(SAMMThreadScopes* ts, void* ptr,
+                     SAMMAllocType* out_type, uint8_t* out_size_class) {
+    SAMMIndexEntry* e = index_find(&ts->index, ptr);
+    if (!e) return -1;
+
+    int    d;
+    size_t i;
+    if (e->count == 1) {
+        d = e->depth;
+        i = e->slot;
+    } else {
+        d = ts_locate(ts, ptr, ts->scope_depth, &i);
+        if (d < 0) return -1;
+    }
+
+    SAMMScope* s = &ts->scopes[d];
+    if (out_type)       *out_type       = s->types[i];
+    if (out_size_class) *out_size_class = s->size_classes[i];
+
+    ts_remove_at(ts, d, i);
+
+    if (e->count == 1) {
+        index_erase(&ts->index, e);
+    } else if (--e->count == 1) {
+        ts_relocate(ts, e, ts->scope_depth);
+    }
+    return d;
+}
+
+/* Drop index entries for a scope whose arrays were just detached for
+ * cleanup.  outer_depth is the innermost scope that is still live. */
+static void ts_unindex(SAMMThreadScopes* ts, void** ptrs, size_t count,
+                       int outer_depth) {
+    for (size_t k = 0; k < count; k++) {
+        SAMMIndexEntry* e = index_find(&ts->index, ptrs[k]);
+        if (!e) continue;
+        if (e->count == 1) {
+            index_erase(&ts->index, e);
+        } else if (--e->count == 1) {
+            ts_relocate(ts, e, outer_depth);
+        }
+    }
+}
+
 /* ========================================================================= */
 /* Singleton State                                                            */
 /* ========================================================================= */
 
 typedef struct {
-    /* --- Scope stack --- */
-    SAMMScope       scopes[SAMM_MAX_SCOPE_DEPTH];
-    int             scope_depth;      /* Current depth (0 = global) */
-    int             peak_scope_depth;
-    pthread_mutex_t scope_mutex;
-
     /* --- Bloom filter (lazily allocated — see Phase 4) --- */
     SAMMBloomFilter bloom;
+    pthread_mutex_t bloom_mutex;
 
-    /* --- Cleanup queue (bounded ring buffer) --- */
-    SAMMCleanupBatch queue[SAMM_MAX_QUEUE_DEPTH];
-    int              queue_head;
-    int              queue_tail;
-    int              queue_count;
-    pthread_mutex_t  queue_mutex;
-    pthread_cond_t   queue_cv;
+    /* --- Cleanup ring (lock-free MPSC, see ring_enqueue) --- */
+    SAMMRingSlot     ring[SAMM_MAX_QUEUE_DEPTH];
+    samm_atomic_u64  ring_tail;        /* Next position producers claim     */
+    uint64_t         ring_head;        /* Next position to consume (worker) */
+    samm_atomic_u64  batches_queued;   /* Batches published to the ring     */
+    samm_atomic_u64  batches_done;     /* Batches taken off and cleaned     */
 
     /* --- Background worker --- */
     pthread_t        worker_thread;
     int              worker_running;   /* boolean */
-    int              shutdown_flag;    /* boolean */
+    samm_atomic_int  shutdown_flag;    /* boolean */
+    samm_atomic_int  worker_sleeping;  /* worker is (about to be) parked    */
+    pthread_mutex_t  wake_mutex;
+    pthread_cond_t   wake_cv;
+    samm_atomic_u64  worker_wakeups;
 
     /* --- Custom cleanup functions (one per alloc type) --- */
     samm_cleanup_fn  cleanup_fns[8];   /* indexed by SAMMAllocType */
@@ -305,24 +626,121 @@ typedef struct {
     int              trace;
     int              initialised;
 
-    /* --- Metrics (atomics) --- */
-    samm_atomic_u64 stat_scopes_entered;
-    samm_atomic_u64 stat_scopes_exited;
-    samm_atomic_u64 stat_objects_allocated;
-    samm_atomic_u64 stat_objects_freed;
-    samm_atomic_u64 stat_objects_cleaned;
-    samm_atomic_u64 stat_cleanup_batches;
-    samm_atomic_u64 stat_double_free_attempts;
-    samm_atomic_u64 stat_retain_calls;
-    samm_atomic_u64 stat_total_bytes_allocated;
-    samm_atomic_u64 stat_total_bytes_freed;
-    samm_atomic_u64 stat_strings_tracked;
-    samm_atomic_u64 stat_strings_cleaned;
-    double          stat_total_cleanup_time_ms;  /* protected by queue_mutex */
+    /* --- Metrics (per-thread counters live in SAMMThreadScopes) --- */
+    samm_atomic_u64 cleanup_time_ns;   /* written by the worker only */
 } SAMMState;
 
 static SAMMState g_samm = {0};
 
+/* ========================================================================= */
+/* Per-Thread State: attach / detach                                          */
+/* ========================================================================= */
+
+static void cleanup_batch(SAMMCleanupBatch* batch);
+static void pending_flush(SAMMThreadScopes* ts);
+static void samm_thread_detach(void* arg);
+
+static void samm_thread_key_init(void) {
+    pthread_key_create(&g_samm_threads.key, samm_thread_detach);
+}
+
+static SAMMThreadScopes* samm_thread_attach(void) {
+    SAMMThreadScopes* ts = (SAMMThreadScopes*)calloc(1, sizeof(SAMMThreadScopes));
+    if (!ts) {
+        fprintf(stderr, "SAMM FATAL: per-thread scope stack alloc failed\n");
+        abort();
+    }
+    scope_init(&ts->scopes[0]);
+    ts->scope_depth = 0;
+
+    pthread_once(&g_samm_threads.key_once, samm_thread_key_init);
+    pthread_setspecific(g_samm_threads.key, ts);
+
+    pthread_mutex_lock(&g_samm_threads.mutex);
+    ts->next = g_samm_threads.head;
+    g_samm_threads.head = ts;
+    pthread_mutex_unlock(&g_samm_threads.mutex);
+
+    t_samm = ts;
+    return ts;
+}
+
+/* Clean every scope still open on a thread's stack, innermost first.
+ *
+ * Each scope's arrays are detached BEFORE calling cleanup_batch(), exactly
+ * as samm_exit_scope() does.  If a cleanup function (e.g. string_release
+ * -> samm_untrack -> ts_remove) tries to mutate the scope, it finds an
+ * empty scope and harmlessly returns 0. */
+static void scopes_release_all(SAMMThreadScopes* ts) {
+    pending_flush(ts);
+    for (int d = ts->scope_depth; d >= 0; d--) {
+        SAMMScope* s = &ts->scopes[d];
+        if (s->count > 0) {
+            if (g_samm.trace) {
+                fprintf(stderr, "SAMM: Cleaning up %zu objects from scope depth %d\n",
+                        s->count, d);
+            }
+            SAMMCleanupBatch batch;
+            batch.ptrs         = s->ptrs;
+            batch.types        = s->types;
+            batch.size_classes = s->size_classes;
+            batch.count        = s->count;
+
+            s->ptrs         = NULL;
+            s->types        = NULL;
+            s->size_classes = NULL;
+            s->count        = 0;
+            s->capacity     = 0;
+            ts_unindex(ts, batch.ptrs, batch.count, d - 1);
+
+            cleanup_batch(&batch);
+            /* cleanup_batch freed the detached arrays */
+        } else {
+            scope_destroy(s);
+        }
+    }
+    /* Free arrays kept for reuse by scopes that have already exited */
+    for (int d = 1; d < SAMM_MAX_SCOPE_DEPTH; d++) {
+        scope_destroy(&ts->scopes[d]);
+    }
+    ts->scope_depth = 0;
+    /* Anything tracked by destructors during the sweep above landed in an
+     * already-swept scope; forget it rather than keep stale slots. */
+    index_reset(&ts->index);
+}
+
+/* Fold a thread's counters into the retired totals and unregister it.
+ * Runs as the pthread key destructor when a thread exits, and from
+ * samm_shutdown() for the calling thread. */
+static void samm_thread_detach(void* arg) {
+    SAMMThreadScopes* ts = (SAMMThreadScopes*)arg;
+    if (!ts) return;
+
+    /* Keep t_samm valid while nested cleanup calls back into SAMM, but
+     * clear the key so the destructor never sees a freed stack. */
+    t_samm = ts;
+    pthread_setspecific(g_samm_threads.key, NULL);
+    scopes_release_all(ts);
+
+    pthread_mutex_lock(&g_samm_threads.mutex);
+    SAMMThreadScopes** link = &g_samm_threads.head;
+    while (*link && *link != ts) link = &(*link)->next;
+    if (*link) *link = ts->next;
+    for (int i = 0; i < SAMM_STAT_COUNT; i++) {
+        g_samm_threads.retired[i] += SAMM_ATOMIC_LOAD(ts->stats[i]);
+    }
+    int peak = SAMM_ATOMIC_LOAD(ts->peak_scope_depth);
+    if (peak > g_samm_threads.retired_peak_depth) {
+        g_samm_threads.retired_peak_depth = peak;
+    }
+    pthread_mutex_unlock(&g_samm_threads.mutex);
+
+    t_samm = NULL;
+    index_reset(&ts->index);
+    scope_destroy(&ts->pending);
+    free(ts);
+}
+
 /* ========================================================================= */
 /* Default Cleanup: CLASS object destructor via vtable                         */
 /* ========================================================================= */
@@ -395,7 +813,7 @@ static void cleanup_batch(SAMMCleanupBatch* batch) {
                     /* Return object shell to size-class pool or free */
                     if (sc < SAMM_OBJECT_SIZE_CLASSES) {
                         uint32_t slot_sz = samm_object_slot_sizes[sc];
-                        SAMM_ATOMIC_ADD(g_samm.stat_total_bytes_freed, (uint64_t)slot_sz);
+                        samm_stat_add(SAMM_STAT_BYTES_FREED, (uint64_t)slot_sz);
                         samm_slab_pool_free(&g_object_pools[sc], ptr);
                     } else {
                         /* Overflow object (> 1024 B) — return to system */
@@ -409,7 +827,7 @@ static void cleanup_batch(SAMMCleanupBatch* batch) {
                      * independently by their own SAMM_ALLOC_LIST_ATOM
                      * tracking entries. */
                     list_free_from_samm(ptr);
-                    SAMM_ATOMIC_ADD(g_samm.stat_total_bytes_freed, (uint64_t)sizeof(ListHeader));
+                    samm_stat_add(SAMM_STAT_BYTES_FREED, (uint64_t)sizeof(ListHeader));
                     break;
                 case SAMM_ALLOC_LIST_ATOM:
                     /* Phase 2: list_atom_free_from_samm() releases the
@@ -417,7 +835,7 @@ static void cleanup_batch(SAMMCleanupBatch* batch) {
                      * list_free for nested lists) then returns the atom
                      * shell to g_list_atom_pool via samm_slab_pool_free(). */
                     list_atom_free_from_samm(ptr);
-                    SAMM_ATOMIC_ADD(g_samm.stat_total_bytes_freed, (uint64_t)sizeof(ListAtom));
+                    samm_stat_add(SAMM_STAT_BYTES_FREED, (uint64_t)sizeof(ListAtom));
                     break;
                 case SAMM_ALLOC_STRING:
                     /* Call string_release which decrements the refcount and
@@ -426,7 +844,7 @@ static void cleanup_batch(SAMMCleanupBatch* batch) {
                      * string was retained elsewhere (refcount > 1), this
                      * just drops SAMM's ownership claim. */
                     string_release((StringDescriptor*)ptr);
-                    SAMM_ATOMIC_INC(g_samm.stat_strings_cleaned);
+                    samm_stat_add(SAMM_STAT_STRINGS_CLEANED, 1);
                     break;
                 default:
                     default_generic_cleanup(ptr);
@@ -438,12 +856,12 @@ static void cleanup_batch(SAMMCleanupBatch* batch) {
          * Pool-managed types don't need the filter (their pools detect
          * double-free via the in_use counter). */
         if (type == SAMM_ALLOC_OBJECT && sc >= SAMM_OBJECT_SIZE_CLASSES) {
-            pthread_mutex_lock(&g_samm.scope_mutex);
+            pthread_mutex_lock(&g_samm.bloom_mutex);
             bloom_add(&g_samm.bloom, ptr);
-            pthread_mutex_unlock(&g_samm.scope_mutex);
+            pthread_mutex_unlock(&g_samm.bloom_mutex);
         }
 
-        SAMM_ATOMIC_INC(g_samm.stat_objects_cleaned);
+        samm_stat_add(SAMM_STAT_OBJECTS_CLEANED, 1);
     }
 
     /* Free the batch arrays */
@@ -456,10 +874,101 @@ static void cleanup_batch(SAMMCleanupBatch* batch) {
     batch->count        = 0;
 }
 
+/* ========================================================================= */
+/* Cleanup ring: lock-free multi-producer / single-consumer                   */
+/*                                                                            */
+/* Bounded ring of SAMM_MAX_QUEUE_DEPTH slots (power of two) with a          */
+/* sequence number per slot (Vyukov).  A producer claims position `pos` by   */
+/* CAS on ring_tail once the slot's seq equals pos, fills in the batch and   */
+/* publishes it by storing seq = pos + 1.  The single consumer (the worker,  */
+/* or drain_queue_sync() once the worker is gone) takes a slot whose seq is  */
+/* head + 1 and frees it for the next lap by storing head + DEPTH.           */
+/* ========================================================================= */
+
+#if (SAMM_MAX_QUEUE_DEPTH & (SAMM_MAX_QUEUE_DEPTH - 1)) != 0
+#error "SAMM_MAX_QUEUE_DEPTH must be a power of two"
+#endif
+
+static void ring_reset(void) {
+    for (uint64_t i = 0; i < SAMM_MAX_QUEUE_DEPTH; i++) {
+        SAMM_ATOMIC_STORE(g_samm.ring[i].seq, i);
+    }
+    SAMM_ATOMIC_STORE(g_samm.ring_tail, 0);
+    g_samm.ring_head = 0;
+}
+
+/* Returns 1 if the batch was published, 0 if the ring is full. */
+static int ring_enqueue(const SAMMCleanupBatch* batch) {
+    uint64_t pos = SAMM_ATOMIC_LOAD(g_samm.ring_tail);
+    SAMMRingSlot* slot;
+    for (;;) {
+        slot = &g_samm.ring[pos & (SAMM_MAX_QUEUE_DEPTH - 1)];
+        uint64_t seq = SAMM_ATOMIC_LOAD_ACQ(slot->seq);
+        int64_t diff = (int64_t)(seq - pos);
+        if (diff == 0) {
+            if (SAMM_ATOMIC_CAS(g_samm.ring_tail, &pos, pos + 1)) break;
+        } else if (diff < 0) {
+            return 0;
+        } else {
+            pos = SAMM_ATOMIC_LOAD(g_samm.ring_tail);
+        }
+    }
+    slot->batch = *batch;
+    SAMM_ATOMIC_STORE_REL(slot->seq, pos + 1);
+    return 1;
+}
+
+/* Consumer side.  Non-zero if a published batch is waiting. */
+static int ring_ready(void) {
+    uint64_t pos = g_samm.ring_head;
+    SAMMRingSlot* slot = &g_samm.ring[pos & (SAMM_MAX_QUEUE_DEPTH - 1)];
+    return SAMM_ATOMIC_LOAD_ACQ(slot->seq) == pos + 1;
+}
+
+/* Consumer side.  Returns 1 and fills *out, or 0 if the ring is empty. */
+static int ring_dequeue(SAMMCleanupBatch* out) {
+    uint64_t pos = g_samm.ring_head;
+    SAMMRingSlot* slot = &g_samm.ring[pos & (SAMM_MAX_QUEUE_DEPTH - 1)];
+    if (SAMM_ATOMIC_LOAD_ACQ(slot->seq) != pos + 1) return 0;
+    *out = slot->batch;
+    SAMM_ATOMIC_STORE_REL(slot->seq, pos + SAMM_MAX_QUEUE_DEPTH);
+    g_samm.ring_head = pos + 1;
+    return 1;
+}
+
 /* ========================================================================= */
 /* Background cleanup worker thread                                           */
 /* ========================================================================= */
 
+/* Wait for work: spin for a short while, then park on wake_cv.
+ * Returns 0 once shutdown has been requested and the ring is empty. */
+static int worker_wait_for_work(void) {
+    for (int i = 0; i < SAMM_WORKER_SPIN_ITERS; i++) {
+        if (ring_ready()) return 1;
+        if (SAMM_ATOMIC_LOAD(g_samm.shutdown_flag)) return ring_ready();
+        if (i < SAMM_WORKER_SPIN_ITERS / 8) {
+            SAMM_CPU_RELAX();
+        } else {
+            sched_yield();
+        }
+    }
+
+    /* Announce that we are going to sleep, then re-check.  Producers
+     * publish, fence, then read worker_sleeping; we store it, fence, then
+     * read the ring — so at least one side sees the other. */
+    pthread_mutex_lock(&g_samm.wake_mutex);
+    SAMM_ATOMIC_STORE(g_samm.worker_sleeping, 1);
+    SAMM_ATOMIC_FENCE();
+    while (!ring_ready() && !SAMM_ATOMIC_LOAD(g_samm.shutdown_flag)) {
+        pthread_cond_wait(&g_samm.wake_cv, &g_samm.wake_mutex);
+    }
+    SAMM_ATOMIC_STORE(g_samm.worker_sleeping, 0);
+    pthread_mutex_unlock(&g_samm.wake_mutex);
+    SAMM_ATOMIC_INC(g_samm.worker_wakeups);
+
+    return ring_ready();
+}
+
 static void* samm_worker_fn(void* arg) {
     (void)arg;
 
@@ -469,33 +978,12 @@ static void* samm_worker_fn(void* arg) {
 
     while (1) {
         SAMMCleanupBatch batch;
-        batch.ptrs         = NULL;
-        batch.types        = NULL;
-        batch.size_classes = NULL;
-        batch.count        = 0;
-
-        /* Wait for work */
-        pthread_mutex_lock(&g_samm.queue_mutex);
-        while (g_samm.queue_count == 0 && !g_samm.shutdown_flag) {
-            pthread_cond_wait(&g_samm.queue_cv, &g_samm.queue_mutex);
-        }
 
-        if (g_samm.queue_count == 0 && g_samm.shutdown_flag) {
-            pthread_mutex_unlock(&g_samm.queue_mutex);
-            break;
+        if (!ring_dequeue(&batch)) {
+            if (!worker_wait_for_work()) break;
+            continue;
         }
 
-        /* Dequeue one batch */
-        batch = g_samm.queue[g_samm.queue_head];
-        /* Clear the slot */
-        g_samm.queue[g_samm.queue_head].ptrs         = NULL;
-        g_samm.queue[g_samm.queue_head].types        = NULL;
-        g_samm.queue[g_samm.queue_head].size_classes = NULL;
-        g_samm.queue[g_samm.queue_head].count        = 0;
-        g_samm.queue_head = (g_samm.queue_head + 1) % SAMM_MAX_QUEUE_DEPTH;
-        g_samm.queue_count--;
-        pthread_mutex_unlock(&g_samm.queue_mutex);
-
         /* Process the batch */
         if (batch.count > 0) {
             /* Time the cleanup */
@@ -511,17 +999,16 @@ static void* samm_worker_fn(void* arg) {
             }
 
             cleanup_batch(&batch);
-            SAMM_ATOMIC_INC(g_samm.stat_cleanup_batches);
+            samm_stat_add(SAMM_STAT_CLEANUP_BATCHES, 1);
 
 #if defined(CLOCK_MONOTONIC)
             clock_gettime(CLOCK_MONOTONIC, &t_end);
-            double ms = (double)(t_end.tv_sec - t_start.tv_sec) * 1000.0
-                      + (double)(t_end.tv_nsec - t_start.tv_nsec) / 1e6;
-            pthread_mutex_lock(&g_samm.queue_mutex);
-            g_samm.stat_total_cleanup_time_ms += ms;
-            pthread_mutex_unlock(&g_samm.queue_mutex);
+            int64_t ns = (int64_t)(t_end.tv_sec - t_start.tv_sec) * 1000000000
+                       + (int64_t)(t_end.tv_nsec - t_start.tv_nsec);
+            if (ns > 0) SAMM_ATOMIC_ADD(g_samm.cleanup_time_ns, (uint64_t)ns);
 #endif
         }
+        SAMM_ATOMIC_INC(g_samm.batches_done);
     }
 
     if (g_samm.trace) {
@@ -543,68 +1030,68 @@ static void enqueue_for_cleanup(void** ptrs, SAMMAllocType* types,
         return;
     }
 
-    pthread_mutex_lock(&g_samm.queue_mutex);
-
-    if (g_samm.queue_count >= SAMM_MAX_QUEUE_DEPTH) {
-        /* Queue full — clean up synchronously as fallback */
-        pthread_mutex_unlock(&g_samm.queue_mutex);
+    SAMMCleanupBatch batch;
+    batch.ptrs         = ptrs;
+    batch.types        = types;
+    batch.size_classes = size_classes;
+    batch.count        = count;
 
+    if (!ring_enqueue(&batch)) {
+        /* Ring full — clean up synchronously as fallback */
         if (g_samm.trace) {
             fprintf(stderr, "SAMM: Queue full, cleaning %zu objects synchronously\n", count);
         }
-
-        SAMMCleanupBatch batch;
-        batch.ptrs         = ptrs;
-        batch.types        = types;
-        batch.size_classes = size_classes;
-        batch.count        = count;
         cleanup_batch(&batch);
-        SAMM_ATOMIC_INC(g_samm.stat_cleanup_batches);
+        samm_stat_add(SAMM_STAT_CLEANUP_BATCHES, 1);
         return;
     }
+    SAMM_ATOMIC_INC(g_samm.batches_queued);
+
+    /* Only pay for the mutex when the worker is actually parked. */
+    SAMM_ATOMIC_FENCE();
+    if (SAMM_ATOMIC_LOAD(g_samm.worker_sleeping)) {
+        pthread_mutex_lock(&g_samm.wake_mutex);
+        pthread_cond_signal(&g_samm.wake_cv);
+        pthread_mutex_unlock(&g_samm.wake_mutex);
+    }
+}
+
+/* Hand a thread's coalesced pending batch to the worker (or clean it
+ * here when there is no worker).  The arrays are detached first so that
+ * cleanup re-entering SAMM on this thread sees an empty buffer. */
+static void pending_flush(SAMMThreadScopes* ts) {
+    SAMMScope* p = &ts->pending;
+    if (p->count == 0) return;
 
-    int slot = g_samm.queue_tail;
-    g_samm.queue[slot].ptrs         = ptrs;
-    g_samm.queue[slot].types        = types;
-    g_samm.queue[slot].size_classes = size_classes;
-    g_samm.queue[slot].count        = count;
-    g_samm.queue_tail = (g_samm.queue_tail + 1) % SAMM_MAX_QUEUE_DEPTH;
-    g_samm.queue_count++;
+    SAMMCleanupBatch batch;
+    batch.ptrs         = p->ptrs;
+    batch.types        = p->types;
+    batch.size_classes = p->size_classes;
+    batch.count        = p->count;
+    scope_init(p);
 
-    pthread_cond_signal(&g_samm.queue_cv);
-    pthread_mutex_unlock(&g_samm.queue_mutex);
+    if (g_samm.worker_running) {
+        enqueue_for_cleanup(batch.ptrs, batch.types,
+                            batch.size_classes, batch.count);
+    } else {
+        cleanup_batch(&batch);
+        samm_stat_add(SAMM_STAT_CLEANUP_BATCHES, 1);
+    }
 }
 
 /* ========================================================================= */
 /* Internal: drain the queue synchronously (for shutdown / samm_wait)          */
 /* ========================================================================= */
 
+/* Only valid when the worker is not running (never started, or joined). */
 static void drain_queue_sync(void) {
-    while (1) {
-        SAMMCleanupBatch batch;
-        batch.ptrs         = NULL;
-        batch.types        = NULL;
-        batch.size_classes = NULL;
-        batch.count        = 0;
-
-        pthread_mutex_lock(&g_samm.queue_mutex);
-        if (g_samm.queue_count == 0) {
-            pthread_mutex_unlock(&g_samm.queue_mutex);
-            break;
-        }
-        batch = g_samm.queue[g_samm.queue_head];
-        g_samm.queue[g_samm.queue_head].ptrs         = NULL;
-        g_samm.queue[g_samm.queue_head].types        = NULL;
-        g_samm.queue[g_samm.queue_head].size_classes = NULL;
-        g_samm.queue[g_samm.queue_head].count        = 0;
-        g_samm.queue_head = (g_samm.queue_head + 1) % SAMM_MAX_QUEUE_DEPTH;
-        g_samm.queue_count--;
-        pthread_mutex_unlock(&g_samm.queue_mutex);
-
+    SAMMCleanupBatch batch;
+    while (ring_dequeue(&batch)) {
         if (batch.count > 0) {
             cleanup_batch(&batch);
-            SAMM_ATOMIC_INC(g_samm.stat_cleanup_batches);
+            samm_stat_add(SAMM_STAT_CLEANUP_BATCHES, 1);
         }
+        SAMM_ATOMIC_INC(g_samm.batches_done);
     }
 }
 
@@ -618,9 +1105,9 @@ void samm_init(void) {
     memset(&g_samm, 0, sizeof(g_samm));
 
     /* Initialise mutexes and condition variable */
-    pthread_mutex_init(&g_samm.scope_mutex, NULL);
-    pthread_mutex_init(&g_samm.queue_mutex, NULL);
-    pthread_cond_init(&g_samm.queue_cv, NULL);
+    pthread_mutex_init(&g_samm.bloom_mutex, NULL);
+    pthread_mutex_init(&g_samm.wake_mutex, NULL);
+    pthread_cond_init(&g_samm.wake_cv, NULL);
 
     /* Initialise Bloom filter (lazy — no memory allocated until first
      * overflow-class object is freed via DELETE or scope cleanup) */
@@ -667,18 +1154,25 @@ void samm_init(void) {
                             samm_object_pool_names[sc]);
     }
 
-    /* Initialise global scope (depth 0) */
-    scope_init(&g_samm.scopes[0]);
-    g_samm.scope_depth      = 0;
-    g_samm.peak_scope_depth = 0;
+    /* Reset counters for this run.  Per-thread stacks (and each thread's
+     * global scope at depth 0) are created lazily on first use, so the
+     * registry itself survives re-initialisation. */
+    pthread_mutex_lock(&g_samm_threads.mutex);
+    memset(g_samm_threads.retired, 0, sizeof(g_samm_threads.retired));
+    g_samm_threads.retired_peak_depth = 0;
+    for (SAMMThreadScopes* ts = g_samm_threads.head; ts; ts = ts->next) {
+        for (int i = 0; i < SAMM_STAT_COUNT; i++) {
+            SAMM_ATOMIC_STORE(ts->stats[i], 0);
+        }
+        SAMM_ATOMIC_STORE(ts->peak_scope_depth, ts->scope_depth);
+    }
+    pthread_mutex_unlock(&g_samm_threads.mutex);
 
-    /* Initialise cleanup queue */
-    g_samm.queue_head  = 0;
-    g_samm.queue_tail  = 0;
-    g_samm.queue_count = 0;
+    /* Initialise cleanup ring */
+    ring_reset();
 
     /* Start background worker */
-    g_samm.shutdown_flag  = 0;
+    SAMM_ATOMIC_STORE(g_samm.shutdown_flag, 0);
     g_samm.worker_running = 0;
 
     int rc = pthread_create(&g_samm.worker_thread, NULL, samm_worker_fn, NULL);
@@ -712,11 +1206,14 @@ void samm_shutdown(void) {
         fprintf(stderr, "SAMM: Shutting down...\n");
     }
 
-    /* Signal worker to stop */
-    pthread_mutex_lock(&g_samm.queue_mutex);
-    g_samm.shutdown_flag = 1;
-    pthread_cond_signal(&g_samm.queue_cv);
-    pthread_mutex_unlock(&g_samm.queue_mutex);
+    /* Hand this thread's coalesced scopes to the worker before it stops */
+    pending_flush(samm_thread());
+
+    /* Signal worker to stop (it drains the ring first) */
+    pthread_mutex_lock(&g_samm.wake_mutex);
+    SAMM_ATOMIC_STORE(g_samm.shutdown_flag, 1);
+    pthread_cond_signal(&g_samm.wake_cv);
+    pthread_mutex_unlock(&g_samm.wake_mutex);
 
     /* Join worker thread */
     if (g_samm.worker_running) {
@@ -727,42 +1224,20 @@ void samm_shutdown(void) {
     /* Drain any remaining items in the queue synchronously */
     drain_queue_sync();
 
-    /* Clean up all remaining scopes (including global).
+    /* Clean up all remaining scopes (including each thread's global scope).
      *
-     * We detach each scope's arrays BEFORE calling cleanup_batch(), exactly
-     * as samm_exit_scope() does.  This way, if a cleanup function (e.g.
-     * string_release -> samm_untrack -> scope_remove) tries to mutate the
-     * scope, it finds an empty scope and harmlessly returns 0.  SAMM stays
-     * enabled throughout shutdown so tracking/untracking semantics remain
-     * correct for any nested operations triggered by cleanup. */
-    for (int d = g_samm.scope_depth; d >= 0; d--) {
-        SAMMScope* s = &g_samm.scopes[d];
-        if (s->count > 0) {
-            if (g_samm.trace) {
-                fprintf(stderr, "SAMM: Cleaning up %zu objects from scope depth %d\n",
-                        s->count, d);
-            }
-            /* Take ownership of the arrays — detach from scope first
-             * so scope_remove() during cleanup finds nothing to mutate. */
-            SAMMCleanupBatch batch;
-            batch.ptrs         = s->ptrs;
-            batch.types        = s->types;
-            batch.size_classes = s->size_classes;
-            batch.count        = s->count;
-
-            /* Detach scope (same pattern as samm_exit_scope) */
-            s->ptrs         = NULL;
-            s->types        = NULL;
-            s->size_classes = NULL;
-            s->count        = 0;
-            s->capacity     = 0;
-
-            cleanup_batch(&batch);
-            /* cleanup_batch freed the detached arrays */
-        } else {
-            scope_destroy(s);
-        }
+     * By the time samm_shutdown() runs every other thread must have
+     * finished with SAMM, so walking their stacks from here is safe.
+     * SAMM stays enabled throughout shutdown so tracking/untracking
+     * semantics remain correct for any nested operations triggered by
+     * cleanup (which only ever touch the calling thread's stack). */
+    SAMMThreadScopes* self = samm_thread();
+    pthread_mutex_lock(&g_samm_threads.mutex);
+    for (SAMMThreadScopes* ts = g_samm_threads.head; ts; ts = ts->next) {
+        if (ts != self) scopes_release_all(ts);
     }
+    pthread_mutex_unlock(&g_samm_threads.mutex);
+    scopes_release_all(self);
 
     /* Print stats if tracing enabled or SAMM_STATS env var is set.
      * This lets users see SAMM diagnostics without enabling the
@@ -803,13 +1278,17 @@ void samm_shutdown(void) {
         samm_slab_pool_destroy(&g_object_pools[sc]);
     }
 
+    /* Release the calling thread's stack; its counters fold into the
+     * retired totals.  Other threads detach when they exit. */
+    samm_thread_detach(self);
+
     /* Destroy Bloom filter */
     bloom_destroy(&g_samm.bloom);
 
     /* Destroy mutexes */
-    pthread_mutex_destroy(&g_samm.scope_mutex);
-    pthread_mutex_destroy(&g_samm.queue_mutex);
-    pthread_cond_destroy(&g_samm.queue_cv);
+    pthread_mutex_destroy(&g_samm.bloom_mutex);
+    pthread_mutex_destroy(&g_samm.wake_mutex);
+    pthread_cond_destroy(&g_samm.wake_cv);
 
     g_samm.initialised = 0;
     g_samm.enabled     = 0;
@@ -837,25 +1316,24 @@ int samm_is_enabled(void) {
 void samm_enter_scope(void) {
     if (!g_samm.enabled) return;
 
-    pthread_mutex_lock(&g_samm.scope_mutex);
+    SAMMThreadScopes* ts = samm_thread();
 
-    int new_depth = g_samm.scope_depth + 1;
+    int new_depth = ts->scope_depth + 1;
     if (new_depth >= SAMM_MAX_SCOPE_DEPTH) {
-        pthread_mutex_unlock(&g_samm.scope_mutex);
         fprintf(stderr, "SAMM FATAL: Maximum scope depth (%d) exceeded\n",
                 SAMM_MAX_SCOPE_DEPTH);
         abort();
     }
 
-    scope_init(&g_samm.scopes[new_depth]);
-    g_samm.scope_depth = new_depth;
-    if (new_depth > g_samm.peak_scope_depth) {
-        g_samm.peak_scope_depth = new_depth;
+    /* The slot may still hold arrays from the last scope at this depth
+     * (see scope_recycle); reuse them. */
+    ts->scopes[new_depth].count = 0;
+    ts->scope_depth = new_depth;
+    if (new_depth > SAMM_ATOMIC_LOAD(ts->peak_scope_depth)) {
+        SAMM_ATOMIC_STORE(ts->peak_scope_depth, new_depth);
     }
 
-    pthread_mutex_unlock(&g_samm.scope_mutex);
-
-    SAMM_ATOMIC_INC(g_samm.stat_scopes_entered);
+    SAMM_LOCAL_INC(ts->stats[SAMM_STAT_SCOPES_ENTERED]);
 
     if (g_samm.trace) {
         fprintf(stderr, "SAMM: Enter scope (depth: %d)\n", new_depth);
@@ -865,77 +1343,77 @@ void samm_enter_scope(void) {
 void samm_exit_scope(void) {
     if (!g_samm.enabled) return;
 
-    void**        ptrs_to_clean  = NULL;
-    SAMMAllocType* types_to_clean = NULL;
-    uint8_t*      sc_to_clean    = NULL;
-    size_t        count_to_clean = 0;
+    SAMMThreadScopes* ts = samm_thread();
 
-    pthread_mutex_lock(&g_samm.scope_mutex);
-
-    if (g_samm.scope_depth <= 0) {
+    if (ts->scope_depth <= 0) {
         /* Cannot exit global scope */
-        pthread_mutex_unlock(&g_samm.scope_mutex);
         if (g_samm.trace) {
             fprintf(stderr, "SAMM: Cannot exit global scope (depth 0)\n");
         }
         return;
     }
 
-    SAMMScope* s = &g_samm.scopes[g_samm.scope_depth];
+    SAMMScope* s = &ts->scopes[ts->scope_depth];
+    size_t count_to_clean = s->count;
 
-    if (s->count > 0) {
-        /* Take ownership of the arrays — the queue/worker will free them */
-        ptrs_to_clean  = s->ptrs;
-        types_to_clean = s->types;
-        sc_to_clean    = s->size_classes;
-        count_to_clean = s->count;
+    ts->scope_depth--;
 
-        /* Detach from scope (don't free here, queue takes ownership) */
-        s->ptrs         = NULL;
-        s->types        = NULL;
-        s->size_classes = NULL;
-        s->count        = 0;
-        s->capacity     = 0;
-    } else {
-        scope_destroy(s);
+    if (count_to_clean > 0) {
+        ts_unindex(ts, s->ptrs, count_to_clean, ts->scope_depth);
     }
 
-    g_samm.scope_depth--;
-
-    pthread_mutex_unlock(&g_samm.scope_mutex);
-
-    SAMM_ATOMIC_INC(g_samm.stat_scopes_exited);
+    SAMM_LOCAL_INC(ts->stats[SAMM_STAT_SCOPES_EXITED]);
 
     if (g_samm.trace) {
         fprintf(stderr, "SAMM: Exit scope (depth now: %d, cleaning: %zu objects)\n",
-                g_samm.scope_depth, count_to_clean);
+                ts->scope_depth, count_to_clean);
     }
 
-    /* Enqueue for background cleanup (or sync if no worker) */
-    if (count_to_clean > 0) {
-        if (g_samm.worker_running) {
-            enqueue_for_cleanup(ptrs_to_clean, types_to_clean,
-                                sc_to_clean, count_to_clean);
-        } else {
-            /* No worker — clean synchronously */
-            SAMMCleanupBatch batch;
-            batch.ptrs         = ptrs_to_clean;
-            batch.types        = types_to_clean;
-            batch.size_classes = sc_to_clean;
-            batch.count        = count_to_clean;
-            cleanup_batch(&batch);
-            SAMM_ATOMIC_INC(g_samm.stat_cleanup_batches);
+    if (count_to_clean == 0) {
+        scope_recycle(s);
+        return;
+    }
+
+    /* Small scope with a worker running: append to this thread's pending
+     * batch and keep the scope's arrays for the next call at this depth.
+     * The worker only sees a batch every SAMM_COALESCE_BATCH pointers. */
+    if (g_samm.worker_running && count_to_clean <= SAMM_COALESCE_SCOPE_MAX) {
+        SAMMScope* p = &ts->pending;
+        for (size_t i = 0; i < count_to_clean; i++) {
+            scope_push(p, s->ptrs[i], s->types[i], s->size_classes[i]);
+        }
+        s->count = 0;
+        scope_recycle(s);
+        SAMM_LOCAL_INC(ts->stats[SAMM_STAT_SCOPES_COALESCED]);
+        if (p->count >= SAMM_COALESCE_BATCH) {
+            pending_flush(ts);
         }
+        return;
+    }
+
+    /* Take ownership of the arrays — the queue/worker will free them */
+    SAMMCleanupBatch batch;
+    batch.ptrs         = s->ptrs;
+    batch.types        = s->types;
+    batch.size_classes = s->size_classes;
+    batch.count        = count_to_clean;
+    scope_init(s);
+
+    /* Enqueue for background cleanup (or sync if no worker) */
+    if (g_samm.worker_running) {
+        pending_flush(ts);
+        enqueue_for_cleanup(batch.ptrs, batch.types,
+                            batch.size_classes, batch.count);
+    } else {
+        /* No worker — clean synchronously */
+        cleanup_batch(&batch);
+        samm_stat_add(SAMM_STAT_CLEANUP_BATCHES, 1);
     }
 }
 
 int samm_scope_depth(void) {
     if (!g_samm.enabled) return 0;
-    int depth;
-    pthread_mutex_lock(&g_samm.scope_mutex);
-    depth = g_samm.scope_depth;
-    pthread_mutex_unlock(&g_samm.scope_mutex);
-    return depth;
+    return samm_thread()->scope_depth;
 }
 
 /* ========================================================================= */
@@ -945,10 +1423,10 @@ int samm_scope_depth(void) {
 /*
  * Last object size class allocated — used to communicate the size class
  * from samm_alloc_object() to samm_track_object() without changing the
- * public API.  This is safe because alloc+track are always called
- * sequentially on the main thread (the background worker only frees).
+ * public API.  Thread-local, so concurrent alloc+track pairs on different
+ * threads never see each other's size class.
  */
-static uint8_t g_last_object_size_class = SAMM_SIZE_CLASS_NONE;
+static SAMM_THREAD_LOCAL uint8_t t_last_object_size_class = SAMM_SIZE_CLASS_NONE;
 
 void* samm_alloc_object(size_t size) {
     void* ptr;
@@ -959,16 +1437,17 @@ void* samm_alloc_object(size_t size) {
          * samm_slab_pool_alloc returns a zeroed block of
          * samm_object_slot_sizes[sc] bytes (>= size). */
         ptr = samm_slab_pool_alloc(&g_object_pools[sc]);
-        g_last_object_size_class = (uint8_t)sc;
+        t_last_object_size_class = (uint8_t)sc;
     } else {
         /* Overflow object (> 1024 B) — fall back to calloc */
         ptr = calloc(1, size);
-        g_last_object_size_class = SAMM_SIZE_CLASS_NONE;
+        t_last_object_size_class = SAMM_SIZE_CLASS_NONE;
     }
 
     if (ptr) {
-        SAMM_ATOMIC_INC(g_samm.stat_objects_allocated);
-        SAMM_ATOMIC_ADD(g_samm.stat_total_bytes_allocated, (uint64_t)size);
+        SAMMThreadScopes* ts = samm_thread();
+        SAMM_LOCAL_INC(ts->stats[SAMM_STAT_OBJECTS_ALLOCATED]);
+        SAMM_LOCAL_ADD(ts->stats[SAMM_STAT_BYTES_ALLOCATED], (uint64_t)size);
     }
     return ptr;
 }
@@ -979,55 +1458,45 @@ void samm_free_object(void* ptr) {
     uint8_t sc = SAMM_SIZE_CLASS_NONE;
 
     if (g_samm.enabled) {
-        pthread_mutex_lock(&g_samm.scope_mutex);
-
-        /* Try to untrack from whichever scope owns this pointer.
-         * Search from innermost scope outward, matching samm_untrack().
-         * scope_remove now outputs the size class so we know which
-         * pool to return the object to. */
-        int found = 0;
-        for (int d = g_samm.scope_depth; d >= 0; d--) {
-            if (scope_remove(&g_samm.scopes[d], ptr, &sc)) {
-                if (g_samm.trace) {
-                    fprintf(stderr, "SAMM: samm_free_object untracked %p from scope %d (sc=%u)\n",
-                            ptr, d, (unsigned)sc);
-                }
-                found = 1;
-                break;
-            }
+        SAMMThreadScopes* ts = samm_thread();
+
+        /* Untrack from whichever scope owns this pointer (O(1) via the
+         * membership index).  ts_remove outputs the size class so we know
+         * which pool to return the object to. */
+        int d = ts_remove(ts, ptr, NULL, &sc);
+        int found = (d >= 0);
+        if (found && g_samm.trace) {
+            fprintf(stderr, "SAMM: samm_free_object untracked %p from scope %d (sc=%u)\n",
+                    ptr, d, (unsigned)sc);
         }
 
-        if (!found) {
-            /* Pointer is not tracked in any scope.  For overflow objects
-             * (malloc'd, sc == SAMM_SIZE_CLASS_NONE), consult the Bloom
-             * filter for double-free detection.  Pool-managed objects
-             * don't need this — the pool detects double-free via the
-             * in_use counter. */
-            if (sc == SAMM_SIZE_CLASS_NONE) {
-                int probably_freed = bloom_check(&g_samm.bloom, ptr);
-                if (probably_freed) {
-                    pthread_mutex_unlock(&g_samm.scope_mutex);
-                    SAMM_ATOMIC_INC(g_samm.stat_double_free_attempts);
-                    if (g_samm.trace) {
-                        fprintf(stderr, "SAMM WARNING: Possible double-free on %p "
-                                "(Bloom filter hit, not tracked)\n", ptr);
-                    }
-                    return;
+        /* Only overflow-class objects (malloc'd, sc == SAMM_SIZE_CLASS_NONE)
+         * go through the Bloom filter.  Pool-managed objects don't need
+         * it — the pool detects double-free via the in_use counter. */
+        if (sc == SAMM_SIZE_CLASS_NONE) {
+            pthread_mutex_lock(&g_samm.bloom_mutex);
+
+            if (!found && bloom_check(&g_samm.bloom, ptr)) {
+                pthread_mutex_unlock(&g_samm.bloom_mutex);
+                samm_stat_add(SAMM_STAT_DOUBLE_FREE_ATTEMPTS, 1);
+                if (g_samm.trace) {
+                    fprintf(stderr, "SAMM WARNING: Possible double-free on %p "
+                            "(Bloom filter hit, not tracked)\n", ptr);
                 }
+                return;
             }
-            /* Not tracked and not in Bloom — could be an untracked
-             * allocation (e.g. from before SAMM was enabled).  Proceed
-             * with the free but log if tracing. */
-            if (g_samm.trace) {
-                fprintf(stderr, "SAMM: samm_free_object freeing untracked %p\n", ptr);
-            }
-        }
 
-        /* Record in Bloom filter — only for overflow-class objects */
-        if (sc == SAMM_SIZE_CLASS_NONE) {
+            /* Record in Bloom filter */
             bloom_add(&g_samm.bloom, ptr);
+            pthread_mutex_unlock(&g_samm.bloom_mutex);
+        }
+
+        /* Not tracked and not in Bloom — could be an untracked
+         * allocation (e.g. from before SAMM was enabled).  Proceed
+         * with the free but log if tracing. */
+        if (!found && g_samm.trace) {
+            fprintf(stderr, "SAMM: samm_free_object freeing untracked %p\n", ptr);
         }
-        pthread_mutex_unlock(&g_samm.scope_mutex);
     }
 
     /* Do NOT run the destructor here — class_object_delete() already
@@ -1038,69 +1507,55 @@ void samm_free_object(void* ptr) {
     /* Return object to correct size-class pool, or free for overflow */
     if (sc < SAMM_OBJECT_SIZE_CLASSES) {
         uint32_t slot_sz = samm_object_slot_sizes[sc];
-        SAMM_ATOMIC_ADD(g_samm.stat_total_bytes_freed, (uint64_t)slot_sz);
+        samm_stat_add(SAMM_STAT_BYTES_FREED, (uint64_t)slot_sz);
         samm_slab_pool_free(&g_object_pools[sc], ptr);
     } else {
         free(ptr);
     }
-    SAMM_ATOMIC_INC(g_samm.stat_objects_freed);
+    samm_stat_add(SAMM_STAT_OBJECTS_FREED, 1);
 }
 
 /* ========================================================================= */
 /* Public API: Scope Tracking                                                  */
+/*                                                                            */
+/* All of these operate on the calling thread's own scope stack and take no  */
+/* lock.                                                                      */
 /* ========================================================================= */
 
 void samm_track(void* ptr, SAMMAllocType type) {
     if (!g_samm.enabled || !ptr) return;
 
-    pthread_mutex_lock(&g_samm.scope_mutex);
-    if (g_samm.scope_depth >= 0 && g_samm.scope_depth < SAMM_MAX_SCOPE_DEPTH) {
-        scope_push(&g_samm.scopes[g_samm.scope_depth], ptr, type,
-                    SAMM_SIZE_CLASS_NONE);
-        if (g_samm.trace) {
-            fprintf(stderr, "SAMM: Tracked %p (type=%d) in scope %d (scope size: %zu)\n",
-                    ptr, (int)type, g_samm.scope_depth,
-                    g_samm.scopes[g_samm.scope_depth].count);
-        }
+    SAMMThreadScopes* ts = samm_thread();
+    ts_push(ts, ts->scope_depth, ptr, type, SAMM_SIZE_CLASS_NONE);
+    if (g_samm.trace) {
+        fprintf(stderr, "SAMM: Tracked %p (type=%d) in scope %d (scope size: %zu)\n",
+                ptr, (int)type, ts->scope_depth,
+                ts->scopes[ts->scope_depth].count);
     }
-    pthread_mutex_unlock(&g_samm.scope_mutex);
 }
 
 void samm_track_object(void* obj) {
     if (!g_samm.enabled || !obj) return;
 
-    /* Read the size class stashed by samm_alloc_object().
-     * This is safe because alloc+track are always called sequentially
-     * on the main thread. */
-    uint8_t sc = g_last_object_size_class;
+    /* Read the size class stashed by samm_alloc_object() on this thread. */
+    uint8_t sc = t_last_object_size_class;
 
-    pthread_mutex_lock(&g_samm.scope_mutex);
-    if (g_samm.scope_depth >= 0 && g_samm.scope_depth < SAMM_MAX_SCOPE_DEPTH) {
-        scope_push(&g_samm.scopes[g_samm.scope_depth], obj,
-                    SAMM_ALLOC_OBJECT, sc);
-        if (g_samm.trace) {
-            fprintf(stderr, "SAMM: Tracked object %p (sc=%u) in scope %d (scope size: %zu)\n",
-                    obj, (unsigned)sc, g_samm.scope_depth,
-                    g_samm.scopes[g_samm.scope_depth].count);
-        }
+    SAMMThreadScopes* ts = samm_thread();
+    ts_push(ts, ts->scope_depth, obj, SAMM_ALLOC_OBJECT, sc);
+    if (g_samm.trace) {
+        fprintf(stderr, "SAMM: Tracked object %p (sc=%u) in scope %d (scope size: %zu)\n",
+                obj, (unsigned)sc, ts->scope_depth,
+                ts->scopes[ts->scope_depth].count);
     }
-    pthread_mutex_unlock(&g_samm.scope_mutex);
 }
 
 void samm_untrack(void* ptr) {
     if (!g_samm.enabled || !ptr) return;
 
-    pthread_mutex_lock(&g_samm.scope_mutex);
-    /* Search from innermost scope outward */
-    for (int d = g_samm.scope_depth; d >= 0; d--) {
-        if (scope_remove(&g_samm.scopes[d], ptr, NULL)) {
-            if (g_samm.trace) {
-                fprintf(stderr, "SAMM: Untracked %p from scope %d\n", ptr, d);
-            }
-            break;
-        }
+    int d = ts_remove(samm_thread(), ptr, NULL, NULL);
+    if (d >= 0 && g_samm.trace) {
+        fprintf(stderr, "SAMM: Untracked %p from scope %d\n", ptr, d);
     }
-    pthread_mutex_unlock(&g_samm.scope_mutex);
 }
 
 /* ========================================================================= */
@@ -1110,56 +1565,31 @@ void samm_untrack(void* ptr) {
 void samm_retain(void* ptr, int parent_offset) {
     if (!g_samm.enabled || !ptr || parent_offset <= 0) return;
 
-    SAMM_ATOMIC_INC(g_samm.stat_retain_calls);
-
-    pthread_mutex_lock(&g_samm.scope_mutex);
+    SAMMThreadScopes* ts = samm_thread();
+    SAMM_LOCAL_INC(ts->stats[SAMM_STAT_RETAIN_CALLS]);
 
-    /* Find and remove from current scope */
-    int current = g_samm.scope_depth;
+    /* Find and remove it — normally from the current scope, but it may
+     * already live in an outer scope (innermost occurrence wins). */
+    int current = ts->scope_depth;
     SAMMAllocType type = SAMM_ALLOC_UNKNOWN;
     uint8_t sc = SAMM_SIZE_CLASS_NONE;
-    int found = 0;
+    int d = ts_remove(ts, ptr, &type, &sc);
 
-    if (current >= 0) {
-        type = scope_find_type(&g_samm.scopes[current], ptr, &sc);
-        found = scope_remove(&g_samm.scopes[current], ptr, NULL);
-    }
-
-    if (found) {
+    if (d >= 0) {
         /* Compute target scope depth */
-        int target = current - parent_offset;
+        int target = d - parent_offset;
         if (target < 0) target = 0;  /* Clamp to global scope */
 
-        scope_push(&g_samm.scopes[target], ptr, type, sc);
+        ts_push(ts, target, ptr, type, sc);
 
         if (g_samm.trace) {
-            fprintf(stderr, "SAMM: Retained %p from scope %d to scope %d\n",
-                    ptr, current, target);
-        }
-    } else {
-        /* Pointer wasn't in current scope — might be in an outer scope already.
-         * Search outward and move it if found. */
-        for (int d = current - 1; d >= 0; d--) {
-            type = scope_find_type(&g_samm.scopes[d], ptr, &sc);
-            if (scope_remove(&g_samm.scopes[d], ptr, NULL)) {
-                int target = d - parent_offset;
-                if (target < 0) target = 0;
-                scope_push(&g_samm.scopes[target], ptr, type, sc);
-                if (g_samm.trace) {
-                    fprintf(stderr, "SAMM: Retained %p from scope %d to scope %d (found in outer scope)\n",
-                            ptr, d, target);
-                }
-                found = 1;
-                break;
-            }
-        }
-
-        if (!found && g_samm.trace) {
-            fprintf(stderr, "SAMM: Retain failed — %p not found in any scope\n", ptr);
+            fprintf(stderr, "SAMM: Retained %p from scope %d to scope %d%s\n",
+                    ptr, d, target,
+                    d == current ? "" : " (found in outer scope)");
         }
+    } else if (g_samm.trace) {
+        fprintf(stderr, "SAMM: Retain failed — %p not found in any scope\n", ptr);
     }
-
-    pthread_mutex_unlock(&g_samm.scope_mutex);
 }
 
 void samm_retain_parent(void* ptr) {
@@ -1174,9 +1604,9 @@ int samm_is_probably_freed(void* ptr) {
     if (!g_samm.enabled || !ptr) return 0;
 
     int result;
-    pthread_mutex_lock(&g_samm.scope_mutex);
+    pthread_mutex_lock(&g_samm.bloom_mutex);
     result = bloom_check(&g_samm.bloom, ptr);
-    pthread_mutex_unlock(&g_samm.scope_mutex);
+    pthread_mutex_unlock(&g_samm.bloom_mutex);
     return result;
 }
 
@@ -1192,7 +1622,7 @@ void* samm_alloc_list(void) {
      * from malloc address reuse. */
     void* ptr = samm_slab_pool_alloc(&g_list_header_pool);
     if (!ptr) return NULL;
-    SAMM_ATOMIC_ADD(g_samm.stat_total_bytes_allocated, (uint64_t)sizeof(ListHeader));
+    samm_stat_add(SAMM_STAT_BYTES_ALLOCATED, (uint64_t)sizeof(ListHeader));
     return ptr;
 }
 
@@ -1206,7 +1636,7 @@ void* samm_alloc_list_atom(void) {
      * Same pool pattern as ListHeader above. */
     void* ptr = samm_slab_pool_alloc(&g_list_atom_pool);
     if (!ptr) return NULL;
-    SAMM_ATOMIC_ADD(g_samm.stat_total_bytes_allocated, (uint64_t)sizeof(ListAtom));
+    samm_stat_add(SAMM_STAT_BYTES_ALLOCATED, (uint64_t)sizeof(ListAtom));
     return ptr;
 }
 
@@ -1217,7 +1647,7 @@ void* samm_alloc_list_atom(void) {
 void samm_track_string(void* string_desc_ptr) {
     if (!string_desc_ptr) return;
     samm_track(string_desc_ptr, SAMM_ALLOC_STRING);
-    SAMM_ATOMIC_INC(g_samm.stat_strings_tracked);
+    samm_stat_add(SAMM_STAT_STRINGS_TRACKED, 1);
 }
 
 /* ========================================================================= */
@@ -1234,13 +1664,24 @@ void* samm_alloc_string(void) {
      * positives caused by malloc address reuse. */
     StringDescriptor* desc = string_desc_alloc();
     if (!desc) return NULL;
-    SAMM_ATOMIC_ADD(g_samm.stat_total_bytes_allocated, (uint64_t)sizeof(StringDescriptor));
+    samm_stat_add(SAMM_STAT_BYTES_ALLOCATED, (uint64_t)sizeof(StringDescriptor));
     if (g_samm.enabled) {
         samm_track_string(desc);
     }
     return desc;
 }
 
+void* samm_alloc_string_untracked(void) {
+    /* Same slab-pool allocation as samm_alloc_string(), minus the scope
+     * registration.  The compiler only emits this for temporaries it has
+     * proven do not escape the statement, and pairs it with an explicit
+     * string_release(). */
+    StringDescriptor* desc = string_desc_alloc();
+    if (!desc) return NULL;
+    samm_stat_add(SAMM_STAT_BYTES_ALLOCATED, (uint64_t)sizeof(StringDescriptor));
+    return desc;
+}
+
 /* ========================================================================= */
 /* Public API: Destructor Registration                                         */
 /* ========================================================================= */
@@ -1258,30 +1699,51 @@ void samm_register_cleanup(SAMMAllocType type, samm_cleanup_fn fn) {
 void samm_get_stats(SAMMStats* out) {
     if (!out) return;
 
-    out->scopes_entered        = SAMM_ATOMIC_LOAD(g_samm.stat_scopes_entered);
-    out->scopes_exited         = SAMM_ATOMIC_LOAD(g_samm.stat_scopes_exited);
-    out->objects_allocated     = SAMM_ATOMIC_LOAD(g_samm.stat_objects_allocated);
-    out->objects_freed         = SAMM_ATOMIC_LOAD(g_samm.stat_objects_freed);
-    out->objects_cleaned       = SAMM_ATOMIC_LOAD(g_samm.stat_objects_cleaned);
-    out->cleanup_batches       = SAMM_ATOMIC_LOAD(g_samm.stat_cleanup_batches);
-    out->double_free_attempts  = SAMM_ATOMIC_LOAD(g_samm.stat_double_free_attempts);
+    /* Roll up per-thread counters: retired threads plus every live stack.
+     * The calling thread is attached first so its depth is reported even
+     * if it has not tracked anything yet. */
+    SAMMThreadScopes* self = samm_thread();
+    uint64_t totals[SAMM_STAT_COUNT];
+    int peak    = 0;
+    int threads = 0;
+
+    pthread_mutex_lock(&g_samm_threads.mutex);
+    memcpy(totals, g_samm_threads.retired, sizeof(totals));
+    peak = g_samm_threads.retired_peak_depth;
+    for (SAMMThreadScopes* ts = g_samm_threads.head; ts; ts = ts->next) {
+        for (int i = 0; i < SAMM_STAT_COUNT; i++) {
+            totals[i] += SAMM_ATOMIC_LOAD(ts->stats[i]);
+        }
+        int p = SAMM_ATOMIC_LOAD(ts->peak_scope_depth);
+        if (p > peak) peak = p;
+        threads++;
+    }
+    pthread_mutex_unlock(&g_samm_threads.mutex);
+
+    out->scopes_entered        = totals[SAMM_STAT_SCOPES_ENTERED];
+    out->scopes_exited         = totals[SAMM_STAT_SCOPES_EXITED];
+    out->objects_allocated     = totals[SAMM_STAT_OBJECTS_ALLOCATED];
+    out->objects_freed         = totals[SAMM_STAT_OBJECTS_FREED];
+    out->objects_cleaned       = totals[SAMM_STAT_OBJECTS_CLEANED];
+    out->cleanup_batches       = totals[SAMM_STAT_CLEANUP_BATCHES];
+    out->double_free_attempts  = totals[SAMM_STAT_DOUBLE_FREE_ATTEMPTS];
     out->bloom_false_positives = 0; /* TODO: estimate from Bloom filter fill ratio */
-    out->retain_calls          = SAMM_ATOMIC_LOAD(g_samm.stat_retain_calls);
-    out->total_bytes_allocated = SAMM_ATOMIC_LOAD(g_samm.stat_total_bytes_allocated);
-    out->total_bytes_freed     = SAMM_ATOMIC_LOAD(g_samm.stat_total_bytes_freed);
-    out->strings_tracked       = SAMM_ATOMIC_LOAD(g_samm.stat_strings_tracked);
-    out->strings_cleaned       = SAMM_ATOMIC_LOAD(g_samm.stat_strings_cleaned);
+    out->retain_calls          = totals[SAMM_STAT_RETAIN_CALLS];
+    out->total_bytes_allocated = totals[SAMM_STAT_BYTES_ALLOCATED];
+    out->total_bytes_freed     = totals[SAMM_STAT_BYTES_FREED];
+    out->strings_tracked       = totals[SAMM_STAT_STRINGS_TRACKED];
+    out->strings_cleaned       = totals[SAMM_STAT_STRINGS_CLEANED];
 
-    pthread_mutex_lock(&g_samm.scope_mutex);
-    out->current_scope_depth = g_samm.scope_depth;
-    out->peak_scope_depth    = g_samm.peak_scope_depth;
-    pthread_mutex_unlock(&g_samm.scope_mutex);
+    out->current_scope_depth = self->scope_depth;
+    out->peak_scope_depth    = peak;
+    out->active_threads      = threads;
 
     out->bloom_memory_bytes        = g_samm.bloom.size_bytes;
 
-    pthread_mutex_lock(&g_samm.queue_mutex);
-    out->total_cleanup_time_ms     = g_samm.stat_total_cleanup_time_ms;
-    pthread_mutex_unlock(&g_samm.queue_mutex);
+    out->total_cleanup_time_ms     =
+        (double)SAMM_ATOMIC_LOAD(g_samm.cleanup_time_ns) / 1e6;
+    out->scopes_coalesced          = totals[SAMM_STAT_SCOPES_COALESCED];
+    out->worker_wakeups            = SAMM_ATOMIC_LOAD(g_samm.worker_wakeups);
 
     out->background_worker_active  = g_samm.worker_running;
 }
@@ -1300,12 +1762,15 @@ void samm_print_stats(void) {
     fprintf(stderr, "  Strings tracked:      %" PRIu64 "\n", s.strings_tracked);
     fprintf(stderr, "  Strings cleaned:      %" PRIu64 "\n", s.strings_cleaned);
     fprintf(stderr, "  Cleanup batches:      %" PRIu64 "\n", s.cleanup_batches);
+    fprintf(stderr, "  Scopes coalesced:     %" PRIu64 "\n", s.scopes_coalesced);
+    fprintf(stderr, "  Worker wakeups:       %" PRIu64 "\n", s.worker_wakeups);
     fprintf(stderr, "  Double-free catches:  %" PRIu64 "\n", s.double_free_attempts);
     fprintf(stderr, "  RETAIN calls:         %" PRIu64 "\n", s.retain_calls);
     fprintf(stderr, "  Bytes allocated:      %" PRIu64 "\n", s.total_bytes_allocated);
     fprintf(stderr, "  Bytes freed:          %" PRIu64 "\n", s.total_bytes_freed);
     fprintf(stderr, "  Current scope depth:  %d\n", s.current_scope_depth);
     fprintf(stderr, "  Peak scope depth:     %d\n", s.peak_scope_depth);
+    fprintf(stderr, "  Threads with scopes:  %d\n", s.active_threads);
     if (s.bloom_memory_bytes > 0) {
         fprintf(stderr, "  Bloom filter memory:  %zu bytes (%.1f KB)\n",
                 s.bloom_memory_bytes, (double)s.bloom_memory_bytes / 1024.0);
@@ -1327,17 +1792,15 @@ void samm_wait(void) {
     if (!g_samm.enabled) return;
 
     if (g_samm.worker_running) {
-        /* Spin until the queue is empty */
-        int remaining;
-        do {
-            /* Give the worker time to process */
-            struct timespec ts = {0, 1000000}; /* 1ms */
+        /* Publish this thread's coalesced scopes, then wait until the
+         * worker has finished every batch queued so far (including one
+         * it may be in the middle of). */
+        pending_flush(samm_thread());
+        uint64_t target = SAMM_ATOMIC_LOAD(g_samm.batches_queued);
+        while (SAMM_ATOMIC_LOAD(g_samm.batches_done) < target) {
+            struct timespec ts = {0, 100000}; /* 0.1ms */
             nanosleep(&ts, NULL);
-
-            pthread_mutex_lock(&g_samm.queue_mutex);
-            remaining = g_samm.queue_count;
-            pthread_mutex_unlock(&g_samm.queue_mutex);
-        } while (remaining > 0);
+        }
     } else {
         /* No worker — drain synchronously */
         drain_queue_sync();
@@ -1349,5 +1812,5 @@ void samm_wait(void) {
 }
 
 void samm_record_bytes_freed(uint64_t bytes) {
-    SAMM_ATOMIC_ADD(g_samm.stat_total_bytes_freed, bytes);
+    samm_stat_add(SAMM_STAT_BYTES_FREED, bytes);
 }
\ No newline at end of file
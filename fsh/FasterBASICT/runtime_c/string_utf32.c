@@ -11,6 +11,7 @@
 #include "basic_runtime.h"
 #include "samm_bridge.h"
 #include "string_pool.h"
+#include "string_simd.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -37,6 +38,29 @@ static inline StringDescriptor* alloc_descriptor(void) {
     return (StringDescriptor*)samm_alloc_string();
 }
 
+// Literal construction may skip scope tracking for compiler-proven
+// temporaries (string_new_utf8_temp); everything else goes through
+// alloc_descriptor().
+static inline StringDescriptor* alloc_descriptor_ex(bool tracked) {
+    return tracked ? alloc_descriptor()
+                   : (StringDescriptor*)samm_alloc_string_untracked();
+}
+
+// Point desc->data at room for `length` ASCII characters: the descriptor's
+// own sso_buf when the string is short enough (SSO), a heap block
+// otherwise.  Pool slots arrive zeroed, so an inline string is always
+// NUL-terminated.  Returns false if the heap allocation fails.
+static inline bool alloc_ascii_data(StringDescriptor* desc, int64_t length) {
+    if (length <= SSO_THRESHOLD) {
+        desc->data = desc->sso_buf;
+        return true;
+    }
+    desc->data = malloc((size_t)length);
+    if (!desc->data) return false;
+    desc->capacity = length;
+    return true;
+}
+
 // Helper macros for encoding-aware data access
 #define STR_CHAR(str, i) (str->encoding == STRING_ENCODING_ASCII ? \
     ((uint8_t*)str->data)[i] : ((uint32_t*)str->data)[i])
@@ -181,9 +205,9 @@ int64_t utf32_to_utf8(const uint32_t* utf32_data, int64_t length,
 // =============================================================================
 
 // Create new ASCII string from 7-bit ASCII C string
-StringDescriptor* string_new_ascii(const char* ascii_str) {
+static StringDescriptor* new_ascii(const char* ascii_str, bool tracked) {
     if (!ascii_str || *ascii_str == '\0') {
-        StringDescriptor* desc = alloc_descriptor();
+        StringDescriptor* desc = alloc_descriptor_ex(tracked);
         if (desc) {
             desc->encoding = STRING_ENCODING_ASCII;
         }
@@ -192,13 +216,12 @@ StringDescriptor* string_new_ascii(const char* ascii_str) {
     
     size_t len = strlen(ascii_str);
     
-    // Allocate descriptor (tracked by SAMM automatically)
-    StringDescriptor* desc = alloc_descriptor();
+    // Allocate descriptor (tracked by SAMM unless a temporary)
+    StringDescriptor* desc = alloc_descriptor_ex(tracked);
     if (!desc) return NULL;
     
-    // Allocate ASCII buffer (1 byte per char)
-    desc->data = (uint8_t*)malloc(len);
-    if (!desc->data) {
+    // Allocate ASCII buffer (1 byte per char, inline when short)
+    if (!alloc_ascii_data(desc, (int64_t)len)) {
         string_release(desc);
         return NULL;
     }
@@ -206,12 +229,15 @@ StringDescriptor* string_new_ascii(const char* ascii_str) {
     // Copy ASCII data
     memcpy(desc->data, ascii_str, len);
     desc->length = len;
-    desc->capacity = len;
     desc->encoding = STRING_ENCODING_ASCII;
     
     return desc;
 }
 
+StringDescriptor* string_new_ascii(const char* ascii_str) {
+    return new_ascii(ascii_str, true);
+}
+
 // Create new ASCII string from buffer and length
 StringDescriptor* string_new_ascii_len(const uint8_t* data, int64_t length) {
     if (!data || length <= 0) {
@@ -225,25 +251,23 @@ StringDescriptor* string_new_ascii_len(const uint8_t* data, int64_t length) {
     StringDescriptor* desc = alloc_descriptor();
     if (!desc) return NULL;
     
-    desc->data = (uint8_t*)malloc(length * sizeof(uint8_t));
-    if (!desc->data) {
+    if (!alloc_ascii_data(desc, length)) {
         string_release(desc);
         return NULL;
     }
     
     memcpy(desc->data, data, length * sizeof(uint8_t));
     desc->length = length;
-    desc->capacity = length;
     desc->encoding = STRING_ENCODING_ASCII;
     
     return desc;
 }
 
 // Create new string from UTF-8 C string (auto-detects ASCII vs UTF-32)
-StringDescriptor* string_new_utf8(const char* utf8_str) {
+static StringDescriptor* new_utf8(const char* utf8_str, bool tracked) {
     if (!utf8_str || *utf8_str == '\0') {
         // Empty string - default to UTF-32
-        StringDescriptor* desc = alloc_descriptor();
+        StringDescriptor* desc = alloc_descriptor_ex(tracked);
         if (desc) {
             desc->encoding = STRING_ENCODING_UTF32;
         }
@@ -260,24 +284,23 @@ StringDescriptor* string_new_utf8(const char* utf8_str) {
     }
     
     // If pure ASCII, use ASCII encoding for efficiency
-    // (string_new_ascii allocates via alloc_descriptor, already tracked)
     if (is_ascii) {
-        return string_new_ascii(utf8_str);
+        return new_ascii(utf8_str, tracked);
     }
     
     // Contains non-ASCII - use UTF-32
     // Get length in code points
     int64_t cp_len = utf8_length_in_codepoints(utf8_str);
     if (cp_len == 0) {
-        StringDescriptor* desc = alloc_descriptor();
+        StringDescriptor* desc = alloc_descriptor_ex(tracked);
         if (desc) {
             desc->encoding = STRING_ENCODING_UTF32;
         }
         return desc;
     }
     
-    // Allocate descriptor (tracked by SAMM automatically)
-    StringDescriptor* desc = alloc_descriptor();
+    // Allocate descriptor (tracked by SAMM unless a temporary)
+    StringDescriptor* desc = alloc_descriptor_ex(tracked);
     if (!desc) return NULL;
     
     // Allocate UTF-32 buffer
@@ -296,6 +319,16 @@ StringDescriptor* string_new_utf8(const char* utf8_str) {
     return desc;
 }
 
+StringDescriptor* string_new_utf8(const char* utf8_str) {
+    return new_utf8(utf8_str, true);
+}
+
+// Untracked literal for a compiler-proven non-escaping temporary; the
+// generated code string_release()s it right after its last use.
+StringDescriptor* string_new_utf8_temp(const char* utf8_str) {
+    return new_utf8(utf8_str, false);
+}
+
 // Create new string from UTF-32 data
 StringDescriptor* string_new_utf32(const uint32_t* data, int64_t length) {
     if (!data || length <= 0) {
@@ -346,13 +379,9 @@ StringDescriptor* string_new_ascii_capacity(int64_t capacity) {
     StringDescriptor* desc = alloc_descriptor();
     if (!desc) return NULL;
     
-    if (capacity > 0) {
-        desc->data = (uint8_t*)malloc(capacity * sizeof(uint8_t));
-        if (!desc->data) {
-            string_release(desc);
-            return NULL;
-        }
-        desc->capacity = capacity;
+    if (capacity > 0 && !alloc_ascii_data(desc, capacity)) {
+        string_release(desc);
+        return NULL;
     }
     
     desc->encoding = STRING_ENCODING_ASCII;
@@ -366,23 +395,18 @@ StringDescriptor* string_new_repeat(uint32_t codepoint, int64_t count) {
         return string_new_capacity(0);
     }
     
-    StringDescriptor* desc = string_new_capacity(count);
-    if (!desc) return NULL;
+    StringDescriptor* desc;
     
-    // If codepoint is ASCII (<128), use ASCII encoding
+    // If codepoint is ASCII (<128), use ASCII encoding (inline when short,
+    // so CHR$ and short SPACE$ results never touch malloc)
     if (codepoint < 128) {
-        desc->encoding = STRING_ENCODING_ASCII;
-        // Realloc to 1 byte per char
-        uint8_t* ascii_data = (uint8_t*)realloc(desc->data, count);
-        if (ascii_data) {
-            desc->data = ascii_data;
-            desc->capacity = count;
-            for (int64_t i = 0; i < count; i++) {
-                ((uint8_t*)desc->data)[i] = (uint8_t)codepoint;
-            }
-        }
+        desc = string_new_ascii_capacity(count);
+        if (!desc) return NULL;
+        memset(desc->data, (int)codepoint, (size_t)count);
     } else {
         // UTF-32 for non-ASCII
+        desc = string_new_capacity(count);
+        if (!desc) return NULL;
         desc->encoding = STRING_ENCODING_UTF32;
         for (int64_t i = 0; i < count; i++) {
             ((uint32_t*)desc->data)[i] = codepoint;
@@ -401,6 +425,7 @@ StringDescriptor* string_promote_to_utf32(StringDescriptor* str) {
     }
     
     // Convert ASCII → UTF-32 in-place
+    string_materialize(str);
     uint8_t* ascii_data = (uint8_t*)str->data;
     int64_t len = str->length;
     
@@ -418,12 +443,15 @@ StringDescriptor* string_promote_to_utf32(StringDescriptor* str) {
     }
     
     // Copy ASCII bytes to UTF-32 code points (expand 1:1)
-    for (int64_t i = 0; i < len; i++) {
-        utf32_data[i] = (uint32_t)ascii_data[i];
-    }
+    simd_widen_u8_u32(utf32_data, ascii_data, len);
     
-    // Free old ASCII buffer and replace
-    free(ascii_data);
+    // Free old ASCII buffer and replace.  An inline (SSO) string has no
+    // buffer to free; its sso_buf becomes capacity/utf8_cache again.
+    if (string_is_inline(str)) {
+        str->utf8_cache = NULL;
+    } else {
+        free(ascii_data);
+    }
     str->data = utf32_data;
     str->capacity = len;
     str->encoding = STRING_ENCODING_UTF32;
@@ -447,10 +475,25 @@ StringDescriptor* string_clone(const StringDescriptor* str) {
 // Retain string (increment refcount)
 StringDescriptor* string_retain(StringDescriptor* str) {
     if (!str) return NULL;
+    // A view that gains an owner escapes its statement: stop sharing
+    if (string_is_view(str)) string_materialize(str);
     str->refcount++;
     return str;
 }
 
+// Share a string with a slot that borrows it (array element, UDT/CLASS field)
+StringDescriptor* string_share(StringDescriptor* str) {
+    if (!str || !(str->flags & (STRING_FLAG_OWNED | STRING_FLAG_VIEW))) return str;
+    if (string_is_view(str)) string_materialize(str);
+    // Only the variable holds an untracked descriptor, so dropping it would
+    // free the slot's copy.  Give the current scope a reference instead,
+    // which also makes it ineligible for in-place appends.
+    str->flags &= (uint8_t)~STRING_FLAG_OWNED;
+    str->refcount++;
+    samm_track_string(str);
+    return str;
+}
+
 // Release string (decrement refcount, free if 0)
 void string_release(StringDescriptor* str) {
     if (!str) return;
@@ -485,6 +528,12 @@ const char* string_to_utf8(StringDescriptor* str) {
     
     if (str->length == 0) return "";
     
+    // SSO: inline ASCII is its own NUL-terminated UTF-8 form
+    if (string_is_inline(str)) {
+        str->sso_buf[str->length] = '\0';
+        return str->sso_buf;
+    }
+    
     // If cache is valid, use it
     if (!str->dirty && str->utf8_cache) {
         return str->utf8_cache;
@@ -562,10 +611,7 @@ StringDescriptor* string_concat(const StringDescriptor* a, const StringDescripto
         if (a->length > 0) {
             if (a->encoding == STRING_ENCODING_ASCII) {
                 // Convert ASCII to UTF-32 on the fly
-                uint8_t* src = (uint8_t*)a->data;
-                for (int64_t i = 0; i < a->length; i++) {
-                    dest[i] = (uint32_t)src[i];
-                }
+                simd_widen_u8_u32(dest, (const uint8_t*)a->data, a->length);
             } else {
                 // Copy UTF-32 directly
                 memcpy(dest, a->data, a->length * sizeof(uint32_t));
@@ -577,10 +623,7 @@ StringDescriptor* string_concat(const StringDescriptor* a, const StringDescripto
         if (b->length > 0) {
             if (b->encoding == STRING_ENCODING_ASCII) {
                 // Convert ASCII to UTF-32 on the fly
-                uint8_t* src = (uint8_t*)b->data;
-                for (int64_t i = 0; i < b->length; i++) {
-                    dest[i] = (uint32_t)src[i];
-                }
+                simd_widen_u8_u32(dest, (const uint8_t*)b->data, b->length);
             } else {
                 // Copy UTF-32 directly
                 memcpy(dest, b->data, b->length * sizeof(uint32_t));
@@ -593,6 +636,200 @@ StringDescriptor* string_concat(const StringDescriptor* a, const StringDescripto
     return result;
 }
 
+// Capacity for an append that needs `needed` characters: at least double
+// the current capacity, so a loop of appends reallocates O(log n) times.
+static inline int64_t append_capacity(int64_t needed, int64_t current) {
+    int64_t cap = current * 2;
+    if (cap < needed) cap = needed;
+    if (cap < 32) cap = 32;
+    return cap;
+}
+
+// Make room for `total` characters in an exclusively owned string,
+// moving inline (SSO) characters out to the heap if they no longer fit.
+static bool reserve_for_append(StringDescriptor* str, int64_t total) {
+    if (str->encoding == STRING_ENCODING_ASCII) {
+        if (string_is_inline(str)) {
+            if (total <= SSO_THRESHOLD) return true;
+            int64_t cap = append_capacity(total, SSO_THRESHOLD);
+            uint8_t* buf = (uint8_t*)malloc((size_t)cap);
+            if (!buf) return false;
+            memcpy(buf, str->sso_buf, (size_t)str->length);
+            str->data = buf;
+            str->capacity = cap;
+            str->utf8_cache = NULL;
+            return true;
+        }
+        if (str->data && str->capacity >= total) return true;
+        int64_t cap = append_capacity(total, str->capacity);
+        uint8_t* buf = (uint8_t*)realloc(str->data, (size_t)cap);
+        if (!buf) return false;
+        str->data = buf;
+        str->capacity = cap;
+        return true;
+    }
+
+    if (str->data && str->capacity >= total) return true;
+    int64_t cap = append_capacity(total, str->capacity);
+    uint32_t* buf = (uint32_t*)realloc(str->data, (size_t)cap * sizeof(uint32_t));
+    if (!buf) return false;
+    str->data = buf;
+    str->capacity = cap;
+    return true;
+}
+
+// Slow path of string_append: the target is shared, tracked or NULL, so build a
+// new descriptor holding target + suffix and drop the caller's reference.
+// The result is not tracked by SAMM: the assignment target is its only
+// owner, which is what lets the next append happen in place.
+static StringDescriptor* append_copy(StringDescriptor* target, const StringDescriptor* suffix) {
+    int64_t tlen = target ? target->length : 0;
+    int64_t total = tlen + suffix->length;
+    bool ascii = (!target || target->encoding == STRING_ENCODING_ASCII) &&
+                 suffix->encoding == STRING_ENCODING_ASCII;
+
+    StringDescriptor* result = alloc_descriptor_ex(false);
+    if (!result) return target;
+    result->encoding = ascii ? STRING_ENCODING_ASCII : STRING_ENCODING_UTF32;
+    result->flags = STRING_FLAG_OWNED;
+
+    if (ascii && total <= SSO_THRESHOLD) {
+        result->data = result->sso_buf;
+    } else if (!reserve_for_append(result, append_capacity(total, tlen))) {
+        string_release(result);
+        return target;
+    }
+
+    for (int64_t i = 0; i < tlen; i++) {
+        STR_SET_CHAR(result, i, STR_CHAR(target, i));
+    }
+    for (int64_t i = 0; i < suffix->length; i++) {
+        STR_SET_CHAR(result, tlen + i, STR_CHAR(suffix, i));
+    }
+    result->length = total;
+
+    string_release(target);
+    return result;
+}
+
+// Self-append: S$ = S$ + X$
+StringDescriptor* string_append(StringDescriptor* target, const StringDescriptor* suffix) {
+    if (!suffix || suffix->length == 0) return target;
+    if (!target || target->refcount > 1 || !(target->flags & STRING_FLAG_OWNED)) {
+        return append_copy(target, suffix);
+    }
+
+    // Exclusively owned: append in place.  suffix may alias target
+    // (S$ = S$ + S$), so capture its length before growing.
+    int64_t tlen = target->length;
+    int64_t slen = suffix->length;
+    int64_t total = tlen + slen;
+
+    if (target->encoding == STRING_ENCODING_ASCII &&
+        suffix->encoding == STRING_ENCODING_UTF32) {
+        string_promote_to_utf32(target);
+        if (target->encoding != STRING_ENCODING_UTF32) {
+            return append_copy(target, suffix);
+        }
+    }
+    if (!reserve_for_append(target, total)) {
+        return append_copy(target, suffix);
+    }
+
+    if (target->encoding == STRING_ENCODING_ASCII) {
+        memmove((uint8_t*)target->data + tlen, suffix->data, (size_t)slen);
+    } else if (suffix->encoding == STRING_ENCODING_UTF32) {
+        memmove((uint32_t*)target->data + tlen, suffix->data, (size_t)slen * sizeof(uint32_t));
+    } else {
+        simd_widen_u8_u32((uint32_t*)target->data + tlen,
+                          (const uint8_t*)suffix->data, slen);
+    }
+    target->length = total;
+    string_mark_dirty(target);
+
+    return target;
+}
+
+// Assignment from UTF-8 text: S$ = <text read from a file>
+StringDescriptor* string_assign_utf8(StringDescriptor* target, const char* text, int64_t length) {
+    uint8_t high = 0;
+    for (int64_t i = 0; i < length; i++) {
+        high |= (uint8_t)text[i];
+    }
+    bool ascii = high < 0x80;
+
+    // Exclusively owned ASCII target: overwrite in place, keeping its buffer
+    if (ascii && target && target->refcount == 1 && (target->flags & STRING_FLAG_OWNED) &&
+        target->encoding == STRING_ENCODING_ASCII) {
+        bool fits = string_is_inline(target) ? length <= SSO_THRESHOLD
+                                             : (target->data && target->capacity >= length);
+        target->length = 0;  // nothing to preserve if the buffer has to grow
+        if (fits || reserve_for_append(target, length)) {
+            memcpy(target->data, text, (size_t)length);
+            target->length = length;
+            string_mark_dirty(target);
+            return target;
+        }
+    }
+
+    StringDescriptor* result;
+    if (ascii) {
+        result = alloc_descriptor_ex(false);
+        if (result && length > 0) {
+            if (alloc_ascii_data(result, length)) {
+                memcpy(result->data, text, (size_t)length);
+                result->length = length;
+            }
+        }
+    } else {
+        result = new_utf8(text, false);
+    }
+    if (!result) return target;
+    if (ascii) result->encoding = STRING_ENCODING_ASCII;
+    result->flags |= STRING_FLAG_OWNED;
+
+    if (target) string_release(target);
+    return result;
+}
+
+// Assignment of a slice of an ASCII buffer (LINE INPUT # on a mapped file)
+StringDescriptor* string_assign_view(StringDescriptor* target, StringDescriptor* owner,
+                                     int64_t start, int64_t length) {
+    if (length <= SSO_THRESHOLD) {
+        return string_assign_utf8(target, (const char*)owner->data + start, length);
+    }
+
+    // Views are never tracked, so refcount 1 means the variable is the only holder
+    if (target && target->refcount == 1 && string_is_view(target)) {
+        if (target->parent != owner) {
+            owner->refcount++;
+            string_release(target->parent);
+            target->parent = owner;
+        }
+        target->data = (uint8_t*)owner->data + start;
+        target->length = length;
+        target->encoding = STRING_ENCODING_ASCII;
+        string_mark_dirty(target);
+        return target;
+    }
+
+    StringDescriptor* view = string_view(owner, start, length);
+    if (!view) return target;
+    if (target) string_release(target);
+    return view;
+}
+
+StringDescriptor* string_new_mapped(void* base, int64_t size) {
+    StringDescriptor* desc = alloc_descriptor_ex(false);
+    if (!desc) return NULL;
+    desc->data = base;
+    desc->length = size;
+    desc->capacity = size;
+    desc->encoding = STRING_ENCODING_ASCII;
+    desc->flags = STRING_FLAG_MAPPED;
+    return desc;
+}
+
 // Substring (MID$)
 StringDescriptor* string_mid(const StringDescriptor* str, int64_t start, int64_t length) {
     if (!str || start < 0 || start >= str->length || length <= 0) {
@@ -609,7 +846,7 @@ StringDescriptor* string_mid(const StringDescriptor* str, int64_t start, int64_t
         return string_new_ascii_len(str->data + start, length);
     } else {
         // UTF-32 encoding
-        return string_new_utf32(str->data + start, length);
+        return string_new_utf32((const uint32_t*)str->data + start, length);
     }
 }
 
@@ -633,7 +870,7 @@ StringDescriptor* string_right(const StringDescriptor* str, int64_t count) {
     if (str->encoding == STRING_ENCODING_ASCII) {
         return string_new_ascii_len(str->data + (str->length - count), count);
     } else {
-        return string_new_utf32(str->data + (str->length - count), count);
+        return string_new_utf32((const uint32_t*)str->data + (str->length - count), count);
     }
 }
 
@@ -663,10 +900,102 @@ StringDescriptor* string_slice(const StringDescriptor* str, int64_t start, int64
     if (str->encoding == STRING_ENCODING_ASCII) {
         return string_new_ascii_len(str->data + start, length);
     } else {
-        return string_new_utf32(str->data + start, length);
+        return string_new_utf32((const uint32_t*)str->data + start, length);
     }
 }
 
+// =============================================================================
+// Substring Views
+// =============================================================================
+//
+// A view shares the parent's characters instead of copying them (see
+// string_descriptor.h).  Views are untracked, so the parent reference is
+// always dropped by the thread running the statement, never by the SAMM
+// cleanup worker.
+
+StringDescriptor* string_view(const StringDescriptor* str, int64_t start, int64_t length) {
+    StringDescriptor* view = alloc_descriptor_ex(false);
+    if (!view) return NULL;
+    if (!str || start < 0 || start >= str->length || length <= 0) {
+        return view;  // Empty string
+    }
+    if (length > str->length - start) {
+        length = str->length - start;
+    }
+
+    view->length = length;
+    view->encoding = str->encoding;
+    if (str->encoding == STRING_ENCODING_ASCII) {
+        const uint8_t* src = (const uint8_t*)str->data + start;
+        if (length <= SSO_THRESHOLD) {
+            // Copying a few bytes inline is cheaper than sharing
+            memcpy(view->sso_buf, src, (size_t)length);
+            view->data = view->sso_buf;
+            return view;
+        }
+        view->data = (void*)src;
+    } else {
+        view->data = (uint32_t*)str->data + start;
+    }
+
+    // Reference the buffer's owner directly so views never chain
+    StringDescriptor* owner = string_is_view(str) ? str->parent : (StringDescriptor*)str;
+    owner->refcount++;
+    view->parent = owner;
+    view->flags = STRING_FLAG_VIEW;
+    return view;
+}
+
+StringDescriptor* string_mid_view(const StringDescriptor* str, int64_t start, int64_t length) {
+    return string_view(str, start, length);
+}
+
+StringDescriptor* string_left_view(const StringDescriptor* str, int64_t count) {
+    return string_view(str, 0, count);
+}
+
+StringDescriptor* string_right_view(const StringDescriptor* str, int64_t count) {
+    if (!str || count <= 0) return string_view(NULL, 0, 0);
+    if (count > str->length) count = str->length;
+    return string_view(str, str->length - count, count);
+}
+
+StringDescriptor* string_slice_view(const StringDescriptor* str, int64_t start, int64_t end) {
+    if (!str || start < 1 || (end != -1 && end < start) || start > str->length) {
+        return string_view(NULL, 0, 0);
+    }
+    if (end == -1 || end > str->length) {
+        end = str->length;
+    }
+    // 1-based inclusive range → 0-based start + length
+    return string_view(str, start - 1, end - start + 1);
+}
+
+void string_materialize(StringDescriptor* str) {
+    if (!str || !string_is_view(str)) return;
+
+    StringDescriptor* parent = str->parent;
+    const void* src = str->data;
+    int64_t len = str->length;
+
+    if (str->encoding == STRING_ENCODING_ASCII && len <= SSO_THRESHOLD) {
+        char* cache = str->utf8_cache;
+        memcpy(str->sso_buf, src, (size_t)len);
+        str->sso_buf[len] = '\0';
+        str->data = str->sso_buf;
+        free(cache);
+    } else {
+        size_t unit = (str->encoding == STRING_ENCODING_ASCII) ? sizeof(uint8_t) : sizeof(uint32_t);
+        void* copy = malloc((size_t)len * unit);
+        if (!copy) return;  // Stay a (still valid) view
+        memcpy(copy, src, (size_t)len * unit);
+        str->data = copy;
+        str->capacity = len;  // Overwrites parent
+    }
+    str->flags &= (uint8_t)~STRING_FLAG_VIEW;
+    string_release(parent);
+}
+
 // Find substring starting from position (0-based, returns 0-based index or -1)
 int64_t string_instr(const StringDescriptor* haystack, const StringDescriptor* needle, int64_t start_pos) {
     if (!haystack || !needle || needle->length == 0) return -1;
@@ -674,6 +1003,21 @@ int64_t string_instr(const StringDescriptor* haystack, const StringDescriptor* n
     if (start_pos >= haystack->length) return -1;
     if (needle->length > haystack->length - start_pos) return -1;
     
+    int64_t span = haystack->length - start_pos;
+    int64_t found = -1;
+    
+    // Same encoding: vector search over the raw buffers
+    if (haystack->encoding == needle->encoding) {
+        if (haystack->encoding == STRING_ENCODING_ASCII) {
+            found = simd_find_u8((const uint8_t*)haystack->data + start_pos, span,
+                                 (const uint8_t*)needle->data, needle->length);
+        } else {
+            found = simd_find_u32((const uint32_t*)haystack->data + start_pos, span,
+                                  (const uint32_t*)needle->data, needle->length);
+        }
+        return found < 0 ? -1 : start_pos + found;
+    }
+    
     int64_t max_pos = haystack->length - needle->length;
     
     for (int64_t pos = start_pos; pos <= max_pos; pos++) {
@@ -698,6 +1042,17 @@ int string_compare(const StringDescriptor* a, const StringDescriptor* b) {
     
     int64_t min_len = (a->length < b->length) ? a->length : b->length;
     
+    // Same encoding: find the first difference with the vector kernel
+    if (a->encoding == b->encoding) {
+        int64_t i = (a->encoding == STRING_ENCODING_ASCII)
+            ? simd_mismatch_u8((const uint8_t*)a->data, (const uint8_t*)b->data, min_len)
+            : simd_mismatch_u32((const uint32_t*)a->data, (const uint32_t*)b->data, min_len);
+        if (i < min_len) {
+            return STR_CHAR(a, i) < STR_CHAR(b, i) ? -1 : 1;
+        }
+        min_len = 0;
+    }
+    
     for (int64_t i = 0; i < min_len; i++) {
         uint32_t ac = STR_CHAR(a, i);
         uint32_t bc = STR_CHAR(b, i);
@@ -735,8 +1090,10 @@ StringDescriptor* string_upper(const StringDescriptor* str) {
     StringDescriptor* result = string_clone(str);
     if (!result) return NULL;
     
-    for (int64_t i = 0; i < result->length; i++) {
-        STR_SET_CHAR(result, i, char_to_upper(STR_CHAR(result, i)));
+    if (result->encoding == STRING_ENCODING_ASCII) {
+        simd_case_u8((uint8_t*)result->data, (const uint8_t*)result->data, result->length, true);
+    } else {
+        simd_case_u32((uint32_t*)result->data, (const uint32_t*)result->data, result->length, true);
     }
     
     return result;
@@ -749,8 +1106,10 @@ StringDescriptor* string_lower(const StringDescriptor* str) {
     StringDescriptor* result = string_clone(str);
     if (!result) return NULL;
     
-    for (int64_t i = 0; i < result->length; i++) {
-        STR_SET_CHAR(result, i, char_to_lower(STR_CHAR(result, i)));
+    if (result->encoding == STRING_ENCODING_ASCII) {
+        simd_case_u8((uint8_t*)result->data, (const uint8_t*)result->data, result->length, false);
+    } else {
+        simd_case_u32((uint32_t*)result->data, (const uint32_t*)result->data, result->length, false);
     }
     
     return result;
@@ -776,25 +1135,11 @@ StringDescriptor* string_trim(const StringDescriptor* str) {
     
     // Create substring
     int64_t new_len = end - start;
-    StringDescriptor* result = string_new_capacity(new_len);
-    if (!result) return NULL;
-    
-    result->encoding = str->encoding;
-    result->length = new_len;
-    
     if (str->encoding == STRING_ENCODING_ASCII) {
-        uint8_t* src = ((uint8_t*)str->data) + start;
-        uint8_t* dst = (uint8_t*)realloc(result->data, new_len);
-        if (dst) {
-            result->data = dst;
-            memcpy(result->data, src, new_len);
-        }
+        return string_new_ascii_len(((uint8_t*)str->data) + start, new_len);
     } else {
-        uint32_t* src = ((uint32_t*)str->data) + start;
-        memcpy(result->data, src, new_len * sizeof(uint32_t));
+        return string_new_utf32(((uint32_t*)str->data) + start, new_len);
     }
-    
-    return result;
 }
 
 // Trim left whitespace
@@ -809,25 +1154,11 @@ StringDescriptor* string_ltrim(const StringDescriptor* str) {
     if (start >= str->length) return string_new_capacity(0);
     
     // Create substring from start to end
-    StringDescriptor* result = string_new_capacity(str->length - start);
-    if (!result) return NULL;
-    
-    result->encoding = str->encoding;
-    result->length = str->length - start;
-    
     if (str->encoding == STRING_ENCODING_ASCII) {
-        uint8_t* src = ((uint8_t*)str->data) + start;
-        uint8_t* dst = (uint8_t*)realloc(result->data, result->length);
-        if (dst) {
-            result->data = dst;
-            memcpy(result->data, src, result->length);
-        }
+        return string_new_ascii_len(((uint8_t*)str->data) + start, str->length - start);
     } else {
-        uint32_t* src = ((uint32_t*)str->data) + start;
-        memcpy(result->data, src, result->length * sizeof(uint32_t));
+        return string_new_utf32(((uint32_t*)str->data) + start, str->length - start);
     }
-    
-    return result;
 }
 
 // Trim right whitespace
@@ -842,23 +1173,11 @@ StringDescriptor* string_rtrim(const StringDescriptor* str) {
     if (end < 0) return string_new_capacity(0);
     
     // Create substring from start to end+1
-    StringDescriptor* result = string_new_capacity(end + 1);
-    if (!result) return NULL;
-    
-    result->encoding = str->encoding;
-    result->length = end + 1;
-    
     if (str->encoding == STRING_ENCODING_ASCII) {
-        uint8_t* dst = (uint8_t*)realloc(result->data, result->length);
-        if (dst) {
-            result->data = dst;
-            memcpy(result->data, str->data, result->length);
-        }
+        return string_new_ascii_len((uint8_t*)str->data, end + 1);
     } else {
-        memcpy(result->data, str->data, result->length * sizeof(uint32_t));
+        return string_new_utf32((uint32_t*)str->data, end + 1);
     }
-    
-    return result;
 }
 
 // Reverse string
@@ -1453,6 +1772,7 @@ int string_set_char_at(StringDescriptor* str, int64_t index, uint32_t codepoint)
     if (!str || index < 0 || index >= str->length) {
         return 0;  // Out of bounds
     }
+    string_materialize(str);
     
     // Check if we need to promote ASCII → UTF-32
     if (str->encoding == STRING_ENCODING_ASCII && codepoint >= 128) {
@@ -1479,6 +1799,20 @@ int string_set_char_at(StringDescriptor* str, int64_t index, uint32_t codepoint)
 // Ensure capacity (may reallocate)
 bool string_ensure_capacity(StringDescriptor* str, int64_t required_capacity) {
     if (!str) return false;
+    string_materialize(str);
+    
+    if (string_is_inline(str)) {
+        if (required_capacity <= SSO_THRESHOLD) return true;
+        // Move the inline characters out to a heap buffer
+        uint32_t* heap_data = (uint32_t*)malloc(required_capacity * sizeof(uint32_t));
+        if (!heap_data) return false;
+        memcpy(heap_data, str->sso_buf, (size_t)str->length);
+        str->data = heap_data;
+        str->capacity = required_capacity;
+        str->utf8_cache = NULL;
+        return true;
+    }
+    
     if (str->capacity >= required_capacity) return true;
     
     uint32_t* new_data = (uint32_t*)realloc(str->data, required_capacity * sizeof(uint32_t));
@@ -1491,7 +1825,8 @@ bool string_ensure_capacity(StringDescriptor* str, int64_t required_capacity) {
 
 // Shrink capacity to match length
 void string_shrink_to_fit(StringDescriptor* str) {
-    if (!str || str->capacity == str->length) return;
+    if (!str || string_is_inline(str) || string_is_view(str) ||
+        str->capacity == str->length) return;
     
     if (str->length == 0) {
         free(str->data);
@@ -1520,10 +1855,18 @@ void string_debug_print(const StringDescriptor* str) {
     
     printf("StringDescriptor {\n");
     printf("  length: %lld\n", (long long)str->length);
-    printf("  capacity: %lld\n", (long long)str->capacity);
+    if (string_is_inline(str)) {
+        printf("  capacity: %d (inline)\n", SSO_THRESHOLD);
+    } else if (string_is_view(str)) {
+        printf("  view of: %p\n", (void*)str->parent);
+    } else {
+        printf("  capacity: %lld\n", (long long)str->capacity);
+    }
     printf("  refcount: %d\n", str->refcount);
     printf("  dirty: %d\n", str->dirty);
-    printf("  utf8_cache: %p\n", (void*)str->utf8_cache);
+    if (!string_is_inline(str)) {
+        printf("  utf8_cache: %p\n", (void*)str->utf8_cache);
+    }
     printf("  content: \"%s\"\n", string_to_utf8((StringDescriptor*)str));
     printf("}\n");
 }
@@ -1533,7 +1876,10 @@ size_t string_memory_usage(const StringDescriptor* str) {
     if (!str) return 0;
     
     size_t total = sizeof(StringDescriptor);
-    total += str->capacity * sizeof(uint32_t);
+    if (string_is_inline(str)) return total;  // SSO: no heap buffers
+    if (!string_is_view(str)) {               // Views borrow the parent's buffer
+        total += str->capacity * sizeof(uint32_t);
+    }
     
     if (str->utf8_cache) {
         total += strlen(str->utf8_cache) + 1;
@@ -1554,6 +1900,7 @@ StringDescriptor* string_mid_assign(StringDescriptor* str, int64_t pos, int64_t
         str->refcount--;  // Decrement refcount on original
         str = new_str;    // Work with the new copy
     }
+    string_materialize(str);
     
     // Adjust for 1-based indexing
     pos--;  // Convert to 0-based
@@ -1569,11 +1916,7 @@ StringDescriptor* string_mid_assign(StringDescriptor* str, int64_t pos, int64_t
             STR_SET_CHAR(str, pos + i, STR_CHAR(replacement, i));
         }
         // Clear UTF-8 cache since string changed
-        if (str->utf8_cache) {
-            free(str->utf8_cache);
-            str->utf8_cache = NULL;
-            str->dirty = 1;
-        }
+        string_mark_dirty(str);
         return str;
     }
     
@@ -1601,14 +1944,11 @@ StringDescriptor* string_mid_assign(StringDescriptor* str, int64_t pos, int64_t
     
     // Free old string — untrack from SAMM first so it won't try to
     // string_release() an already-freed descriptor at scope exit.
+    // The descriptor shell goes back to the slab pool it came from.
     samm_untrack(str);
-    if (str->data) {
-        free(str->data);
-    }
-    if (str->utf8_cache) {
-        free(str->utf8_cache);
-    }
-    free(str);
+    string_desc_free_data(str);
+    string_desc_free(str);
+    samm_record_bytes_freed((uint64_t)sizeof(StringDescriptor));
     
     return new_str;
 }
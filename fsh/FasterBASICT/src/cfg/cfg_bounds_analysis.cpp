@@ -0,0 +1,698 @@
+//
+// cfg_bounds_analysis.cpp
+// FasterBASIC - Array bounds-check elimination for FOR loops
+//
+// See cfg_bounds_analysis.h for what is proved and when.
+//
+
+#include "cfg_bounds_analysis.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <functional>
+
+namespace FasterBASIC {
+
+namespace {
+
+// Constants beyond this never take part in a proof, so that adding a
+// STEP or a subscript offset to them cannot overflow a 32-bit index
+const int64_t kMaxConstant = int64_t(1) << 30;
+
+// Upper-case name without its type suffix: FOR I% and LET i = ... may
+// name the same variable, so writes are matched on this
+std::string baseName(const std::string& name) {
+    static const char* suffixes[] = {"_INT", "_LONG", "_DOUBLE", "_FLOAT", "_STRING",
+                                     "_BYTE", "_SHORT"};
+    std::string base = name;
+    for (const char* s : suffixes) {
+        size_t len = std::char_traits<char>::length(s);
+        if (base.size() > len && base.compare(base.size() - len, len, s) == 0) {
+            base.erase(base.size() - len);
+            break;
+        }
+    }
+    while (!base.empty() && std::string("%&!#$@^").find(base.back()) != std::string::npos) {
+        base.pop_back();
+    }
+    std::transform(base.begin(), base.end(), base.begin(), ::toupper);
+    return base;
+}
+
+// Visit a statement and every statement nested inside it
+void forEachNested(const Statement* stmt, const std::function<void(const Statement*)>& visit) {
+    if (!stmt) return;
+    visit(stmt);
+    auto visitAll = [&](const std::vector<StatementPtr>& body) {
+        for (const auto& s : body) forEachNested(s.get(), visit);
+    };
+    switch (stmt->getType()) {
+        case ASTNodeType::STMT_IF: {
+            const auto* ifStmt = static_cast<const IfStatement*>(stmt);
+            visitAll(ifStmt->thenStatements);
+            for (const auto& clause : ifStmt->elseIfClauses) visitAll(clause.statements);
+            visitAll(ifStmt->elseStatements);
+            break;
+        }
+        case ASTNodeType::STMT_FOR:
+            visitAll(static_cast<const ForStatement*>(stmt)->body);
+            break;
+        case ASTNodeType::STMT_FOR_IN:
+            visitAll(static_cast<const ForInStatement*>(stmt)->body);
+            break;
+        case ASTNodeType::STMT_WHILE:
+            visitAll(static_cast<const WhileStatement*>(stmt)->body);
+            break;
+        case ASTNodeType::STMT_DO:
+            visitAll(static_cast<const DoStatement*>(stmt)->body);
+            break;
+        case ASTNodeType::STMT_REPEAT:
+            visitAll(static_cast<const RepeatStatement*>(stmt)->body);
+            break;
+        case ASTNodeType::STMT_CASE: {
+            const auto* caseStmt = static_cast<const CaseStatement*>(stmt);
+            for (const auto& clause : caseStmt->whenClauses) visitAll(clause.statements);
+            visitAll(caseStmt->otherwiseStatements);
+            break;
+        }
+        case ASTNodeType::STMT_TRY_CATCH: {
+            const auto* tryStmt = static_cast<const TryCatchStatement*>(stmt);
+            visitAll(tryStmt->tryBlock);
+            for (const auto& clause : tryStmt->catchClauses) visitAll(clause.block);
+            visitAll(tryStmt->finallyBlock);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Visit every array subscript list in an expression
+using SubscriptVisitor = std::function<void(const std::string&, const std::vector<ExpressionPtr>&)>;
+
+void forEachSubscript(const Expression* expr, const SubscriptVisitor& visit) {
+    if (!expr) return;
+    switch (expr->getType()) {
+        case ASTNodeType::EXPR_ARRAY_ACCESS: {
+            const auto* access = static_cast<const ArrayAccessExpression*>(expr);
+            visit(access->name, access->indices);
+            for (const auto& index : access->indices) forEachSubscript(index.get(), visit);
+            break;
+        }
+        case ASTNodeType::EXPR_BINARY: {
+            const auto* bin = static_cast<const BinaryExpression*>(expr);
+            forEachSubscript(bin->left.get(), visit);
+            forEachSubscript(bin->right.get(), visit);
+            break;
+        }
+        case ASTNodeType::EXPR_UNARY:
+            forEachSubscript(static_cast<const UnaryExpression*>(expr)->expr.get(), visit);
+            break;
+        case ASTNodeType::EXPR_FUNCTION_CALL:
+            if (const auto* call = dynamic_cast<const FunctionCallExpression*>(expr)) {
+                for (const auto& arg : call->arguments) forEachSubscript(arg.get(), visit);
+            }
+            break;
+        case ASTNodeType::EXPR_IIF: {
+            const auto* iif = static_cast<const IIFExpression*>(expr);
+            forEachSubscript(iif->condition.get(), visit);
+            forEachSubscript(iif->trueValue.get(), visit);
+            forEachSubscript(iif->falseValue.get(), visit);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Visit the subscripts a single statement evaluates (not those of nested statements)
+void forEachStatementSubscript(const Statement* stmt, const SubscriptVisitor& visit) {
+    switch (stmt->getType()) {
+        case ASTNodeType::STMT_LET: {
+            const auto* let = static_cast<const LetStatement*>(stmt);
+            if (!let->indices.empty() && let->memberChain.empty()) {
+                visit(let->variable, let->indices);
+            }
+            for (const auto& index : let->indices) forEachSubscript(index.get(), visit);
+            forEachSubscript(let->value.get(), visit);
+            break;
+        }
+        case ASTNodeType::STMT_PRINT:
+            for (const auto& item : static_cast<const PrintStatement*>(stmt)->items) {
+                forEachSubscript(item.expr.get(), visit);
+            }
+            break;
+        case ASTNodeType::STMT_IF: {
+            const auto* ifStmt = static_cast<const IfStatement*>(stmt);
+            forEachSubscript(ifStmt->condition.get(), visit);
+            for (const auto& clause : ifStmt->elseIfClauses) {
+                forEachSubscript(clause.condition.get(), visit);
+            }
+            break;
+        }
+        case ASTNodeType::STMT_FOR: {
+            const auto* forStmt = static_cast<const ForStatement*>(stmt);
+            forEachSubscript(forStmt->start.get(), visit);
+            forEachSubscript(forStmt->end.get(), visit);
+            forEachSubscript(forStmt->step.get(), visit);
+            break;
+        }
+        case ASTNodeType::STMT_WHILE:
+            forEachSubscript(static_cast<const WhileStatement*>(stmt)->condition.get(), visit);
+            break;
+        case ASTNodeType::STMT_DO: {
+            const auto* doStmt = static_cast<const DoStatement*>(stmt);
+            forEachSubscript(doStmt->preCondition.get(), visit);
+            forEachSubscript(doStmt->postCondition.get(), visit);
+            break;
+        }
+        case ASTNodeType::STMT_CALL:
+            for (const auto& arg : static_cast<const CallStatement*>(stmt)->arguments) {
+                forEachSubscript(arg.get(), visit);
+            }
+            break;
+        case ASTNodeType::STMT_INC:
+        case ASTNodeType::STMT_DEC: {
+            const auto& indices = stmt->getType() == ASTNodeType::STMT_INC
+                ? static_cast<const IncStatement*>(stmt)->indices
+                : static_cast<const DecStatement*>(stmt)->indices;
+            const std::string& name = stmt->getType() == ASTNodeType::STMT_INC
+                ? static_cast<const IncStatement*>(stmt)->varName
+                : static_cast<const DecStatement*>(stmt)->varName;
+            if (!indices.empty()) visit(name, indices);
+            for (const auto& index : indices) forEachSubscript(index.get(), visit);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+} // namespace
+
+// =============================================================================
+// Construction and program-wide facts
+// =============================================================================
+
+BoundsCheckAnalysis::BoundsCheckAnalysis(const SymbolTable& symbols)
+    : symbols_(symbols) {}
+
+void BoundsCheckAnalysis::analyze(const ProgramCFG& program) {
+    std::vector<const ControlFlowGraph*> cfgs;
+    if (program.mainCFG) cfgs.push_back(program.mainCFG.get());
+    for (const auto& [name, cfg] : program.functionCFGs) {
+        if (cfg) cfgs.push_back(cfg.get());
+    }
+
+    // Which arrays can change shape, and where
+    for (const ControlFlowGraph* cfg : cfgs) {
+        for (const auto& param : cfg->parameters) {
+            parameterArrays_.insert(param);
+        }
+        for (const auto& block : cfg->blocks) {
+            if (!block) continue;
+            for (const Statement* stmt : block->statements) {
+                forEachNested(stmt, [&](const Statement* s) { scanStatement(s, *cfg); });
+            }
+        }
+    }
+
+    for (const ControlFlowGraph* cfg : cfgs) {
+        analyzeCFG(*cfg);
+    }
+}
+
+void BoundsCheckAnalysis::scanStatement(const Statement* stmt, const ControlFlowGraph& cfg) {
+    bool inFunction = cfg.functionName != "main";
+    auto resizedInFunction = [&](const std::string& name) {
+        if (!inFunction) return;
+        functionResized_.insert(name);
+        if (std::find(cfg.parameters.begin(), cfg.parameters.end(), name) != cfg.parameters.end()) {
+            resizesParameter_ = true;
+        }
+    };
+
+    switch (stmt->getType()) {
+        case ASTNodeType::STMT_DIM:
+            for (const auto& decl : static_cast<const DimStatement*>(stmt)->arrays) {
+                if (decl.dimensions.empty()) continue;
+                dims_[decl.name].insert(stmt);
+                resizedInFunction(decl.name);
+            }
+            break;
+        case ASTNodeType::STMT_REDIM:
+            for (const auto& decl : static_cast<const RedimStatement*>(stmt)->arrays) {
+                resized_.insert(decl.name);
+                resizedInFunction(decl.name);
+            }
+            break;
+        case ASTNodeType::STMT_ERASE:
+            for (const auto& name : static_cast<const EraseStatement*>(stmt)->arrayNames) {
+                resized_.insert(name);
+                resizedInFunction(name);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+bool BoundsCheckAnalysis::isStaticArray(const std::string& arrayName) const {
+    auto it = symbols_.arrays.find(arrayName);
+    if (it == symbols_.arrays.end() || it->second.dimensions.empty()) return false;
+    for (int extent : it->second.dimensions) {
+        if (extent <= 0) return false;
+    }
+    auto dimIt = dims_.find(arrayName);
+    return dimIt != dims_.end() && dimIt->second.size() == 1 &&
+           !resized_.count(arrayName) && !parameterArrays_.count(arrayName);
+}
+
+// =============================================================================
+// Loop discovery
+// =============================================================================
+
+void BoundsCheckAnalysis::analyzeCFG(const ControlFlowGraph& cfg) {
+    for (const auto& block : cfg.blocks) {
+        if (!block || block->label.find("For_Init") == std::string::npos) continue;
+        for (const Statement* stmt : block->statements) {
+            if (stmt && stmt->getType() == ASTNodeType::STMT_FOR &&
+                !static_cast<const ForStatement*>(stmt)->parallel) {
+                analyzeLoop(cfg, *block, *static_cast<const ForStatement*>(stmt));
+                break;
+            }
+        }
+    }
+}
+
+void BoundsCheckAnalysis::analyzeLoop(const ControlFlowGraph& cfg, const BasicBlock& init,
+                                      const ForStatement& stmt) {
+    auto blockAt = [&](int id) -> const BasicBlock* {
+        return (id >= 0 && id < static_cast<int>(cfg.blocks.size())) ? cfg.blocks[id].get() : nullptr;
+    };
+
+    if (init.successors.size() != 1) return;
+    const BasicBlock* header = blockAt(init.successors[0]);
+    if (!header || header->label.find("For_Header") == std::string::npos) return;
+    const BasicBlock* body = nullptr;
+    for (int succ : header->successors) {
+        const BasicBlock* b = blockAt(succ);
+        if (b && b->label.find("For_Body") != std::string::npos) body = b;
+    }
+    if (!body) return;
+
+    // STEP must be a known, non-zero constant
+    auto loop = std::make_unique<InductionLoop>();
+    loop->stmt = &stmt;
+    if (stmt.step && !constantValue(stmt.step.get(), loop->step)) return;
+    if (loop->step == 0 || std::llabs(loop->step) >= kMaxConstant) return;
+
+    // The natural loop: everything that reaches the back edge without
+    // passing through the header
+    std::vector<int> work;
+    for (int pred : header->predecessors) {
+        if (pred != init.id) work.push_back(pred);
+    }
+    while (!work.empty()) {
+        int id = work.back();
+        work.pop_back();
+        if (id == header->id || loop->blocks.count(id)) continue;
+        const BasicBlock* b = blockAt(id);
+        if (!b) return;
+        loop->blocks.insert(id);
+        for (int pred : b->predecessors) work.push_back(pred);
+    }
+    if (!loop->blocks.count(body->id)) return;
+
+    // Single entry: only the header enters the body, and nothing outside
+    // the loop jumps into it or back to the header
+    for (int id : loop->blocks) {
+        for (int pred : blockAt(id)->predecessors) {
+            if (id == body->id ? pred != header->id : !loop->blocks.count(pred)) return;
+        }
+    }
+    for (int pred : header->predecessors) {
+        if (pred != init.id && !loop->blocks.count(pred)) return;
+    }
+
+    // The loop variable may only change at NEXT.  SHARED and GLOBAL
+    // variables can be changed by any SUB the body calls.
+    const std::string var = baseName(stmt.variable);
+    for (const auto& [name, sym] : symbols_.variables) {
+        if (sym.isGlobal && baseName(sym.name) == var) return;
+    }
+    bool writes = false;
+    auto scan = [&](const Statement* s) {
+        auto is = [&](const std::string& name) { return baseName(name) == var; };
+        switch (s->getType()) {
+            case ASTNodeType::STMT_LET: {
+                const auto* let = static_cast<const LetStatement*>(s);
+                if (let->indices.empty() && is(let->variable)) writes = true;
+                break;
+            }
+            case ASTNodeType::STMT_FOR:
+                if (is(static_cast<const ForStatement*>(s)->variable)) writes = true;
+                break;
+            case ASTNodeType::STMT_FOR_IN: {
+                const auto* forIn = static_cast<const ForInStatement*>(s);
+                if (is(forIn->variable) || is(forIn->indexVariable)) writes = true;
+                break;
+            }
+            case ASTNodeType::STMT_INC:
+                if (is(static_cast<const IncStatement*>(s)->varName)) writes = true;
+                break;
+            case ASTNodeType::STMT_DEC:
+                if (is(static_cast<const DecStatement*>(s)->varName)) writes = true;
+                break;
+            case ASTNodeType::STMT_SWAP: {
+                const auto* swap = static_cast<const SwapStatement*>(s);
+                if (is(swap->var1) || is(swap->var2)) writes = true;
+                break;
+            }
+            case ASTNodeType::STMT_DIM:
+                for (const auto& decl : static_cast<const DimStatement*>(s)->arrays) {
+                    if (decl.dimensions.empty()) {
+                        if (is(decl.name)) writes = true;
+                    } else {
+                        loop->resizedArrays.insert(decl.name);
+                    }
+                }
+                break;
+            case ASTNodeType::STMT_REDIM:
+                for (const auto& decl : static_cast<const RedimStatement*>(s)->arrays) {
+                    loop->resizedArrays.insert(decl.name);
+                }
+                break;
+            case ASTNodeType::STMT_ERASE:
+                for (const auto& name : static_cast<const EraseStatement*>(s)->arrayNames) {
+                    loop->resizedArrays.insert(name);
+                }
+                break;
+            case ASTNodeType::STMT_SHARED:
+                for (const auto& v : static_cast<const SharedStatement*>(s)->variables) {
+                    if (is(v.name)) writes = true;
+                }
+                break;
+            // Statements that write variables the analysis does not track,
+            // or that leave and re-enter the loop behind the CFG's back
+            case ASTNodeType::STMT_INPUT:
+            case ASTNodeType::STMT_INPUT_AT:
+            case ASTNodeType::STMT_READ:
+            case ASTNodeType::STMT_LOCAL:
+            case ASTNodeType::STMT_GLOBAL:
+            case ASTNodeType::STMT_GOSUB:
+            case ASTNodeType::STMT_ON_GOSUB:
+            case ASTNodeType::STMT_ON_CALL:
+            case ASTNodeType::STMT_ON_EVENT:
+            case ASTNodeType::STMT_TRY_CATCH:
+            case ASTNodeType::STMT_MATCH_TYPE:
+            case ASTNodeType::STMT_AFTER:
+            case ASTNodeType::STMT_EVERY:
+            case ASTNodeType::STMT_AFTERFRAMES:
+            case ASTNodeType::STMT_EVERYFRAME:
+            case ASTNodeType::STMT_RUN:
+                writes = true;
+                break;
+            default:
+                break;
+        }
+    };
+    for (int id : loop->blocks) {
+        for (const Statement* s : blockAt(id)->statements) forEachNested(s, scan);
+    }
+    if (writes) return;
+
+    // The body sees every value from start to limit (in STEP's direction)
+    Bound start = classifyBound(stmt.start.get());
+    Bound limit = classifyBound(stmt.end.get());
+    loop->low = loop->step > 0 ? start : limit;
+    loop->high = loop->step > 0 ? limit : start;
+
+    // Subscripts of the loop variable that the loop's range cannot prove:
+    // candidates for a single test in the For_Init block
+    InductionLoop* raw = loop.get();
+    loops_.push_back(std::move(loop));
+    loopsByStmt_[&stmt] = raw;
+    auto candidate = [&](const std::string& array, const std::vector<ExpressionPtr>& indices) {
+        if (indices.size() < 1 || indices.size() > 2 || !symbols_.arrays.count(array)) return;
+        for (size_t d = 0; d < indices.size(); d++) {
+            std::string v;
+            int64_t offset = 0;
+            if (affineIndex(indices[d].get(), v, offset) && v == stmt.variable) {
+                raw->preLoopChecks.insert(PreLoopCheck{array, static_cast<int>(d), offset});
+            }
+        }
+    };
+    for (int id : raw->blocks) {
+        for (const Statement* s : blockAt(id)->statements) {
+            forEachNested(s, [&](const Statement* n) { forEachStatementSubscript(n, candidate); });
+        }
+        loopsByBlock_[blockAt(id)].push_back(raw);
+    }
+
+    // Drop the tests the bounds already prove, and those on arrays that
+    // can be resized while the loop runs
+    for (auto it = raw->preLoopChecks.begin(); it != raw->preLoopChecks.end();) {
+        if (raw->resizedArrays.count(it->array) || functionResized_.count(it->array) ||
+            resizesParameter_) {
+            it = raw->preLoopChecks.erase(it);
+            continue;
+        }
+        BinaryExpression index(std::make_unique<VariableExpression>(stmt.variable), TokenType::PLUS,
+                               std::make_unique<NumberExpression>(static_cast<double>(it->offset)));
+        if (classify(body, it->array, it->dimension, &index).kind == CheckKind::NONE) {
+            it = raw->preLoopChecks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// =============================================================================
+// Subscript classification
+// =============================================================================
+
+BoundsCheckAnalysis::SubscriptCheck BoundsCheckAnalysis::classify(
+        const BasicBlock* block, const std::string& arrayName,
+        int dimension, const Expression* index) const {
+    SubscriptCheck result;
+    auto arrIt = symbols_.arrays.find(arrayName);
+    if (arrIt == symbols_.arrays.end()) {
+        result.reason = "not a declared array";
+        return result;
+    }
+    if (dimension < 0 || dimension >= static_cast<int>(arrIt->second.dimensions.size())) {
+        result.reason = "subscript count does not match the DIM";
+        return result;
+    }
+    bool isStatic = isStaticArray(arrayName);
+    int64_t upper = isStatic ? arrIt->second.dimensions[dimension] - 1 : 0;
+
+    int64_t offset = 0;
+    std::string variable;
+    if (constantValue(index, offset)) {
+        if (isStatic && offset >= 0 && offset <= upper) {
+            result.kind = CheckKind::NONE;
+        } else {
+            result.reason = isStatic ? "constant subscript outside the DIM"
+                                     : "array is not a constant DIM";
+        }
+        return result;
+    }
+    if (!affineIndex(index, variable, offset)) {
+        result.reason = "subscript is not a loop variable plus a constant";
+        return result;
+    }
+
+    const InductionLoop* loop = nullptr;
+    auto blockIt = block ? loopsByBlock_.find(block) : loopsByBlock_.end();
+    if (blockIt != loopsByBlock_.end()) {
+        for (const InductionLoop* candidate : blockIt->second) {
+            if (candidate->stmt->variable == variable) {
+                loop = candidate;
+                break;
+            }
+        }
+    }
+    if (!loop) {
+        result.reason = "'" + sourceName(variable) + "' is not the variable of an enclosing FOR loop";
+        return result;
+    }
+    if (loop->resizedArrays.count(arrayName)) {
+        result.reason = "array is resized inside the loop";
+        return result;
+    }
+    if (functionResized_.count(arrayName) || resizesParameter_) {
+        result.reason = "array is resized by a SUB or FUNCTION";
+        return result;
+    }
+
+    // low + offset >= lower bound, high + offset <= upper bound
+    const Bound& low = loop->low;
+    const Bound& high = loop->high;
+    bool lowOk = (low.kind == Bound::Kind::CONSTANT && isStatic && low.offset + offset >= 0) ||
+                 (low.kind == Bound::Kind::LBOUND && low.array == arrayName &&
+                  low.dimension == dimension + 1 && low.offset + offset >= 0);
+    bool highOk = (high.kind == Bound::Kind::CONSTANT && isStatic && high.offset + offset <= upper) ||
+                  (high.kind == Bound::Kind::UBOUND && high.array == arrayName &&
+                   high.dimension == dimension + 1 && high.offset + offset <= 0);
+    if (lowOk && highOk) {
+        result.kind = CheckKind::NONE;
+        return result;
+    }
+
+    PreLoopCheck test{arrayName, dimension, offset};
+    if (loop->preLoopChecks.count(test)) {
+        result.kind = CheckKind::PRE_LOOP;
+        result.loop = loop;
+        result.test = test;
+        return result;
+    }
+    result.reason = "loop range is not known to fit the array";
+    return result;
+}
+
+const BoundsCheckAnalysis::InductionLoop* BoundsCheckAnalysis::loopFor(const ForStatement* stmt) const {
+    auto it = loopsByStmt_.find(stmt);
+    return it != loopsByStmt_.end() ? it->second : nullptr;
+}
+
+// =============================================================================
+// Expression forms
+// =============================================================================
+
+std::string BoundsCheckAnalysis::boundsCallArray(const FunctionCallExpression& call) {
+    if (call.arguments.empty()) return "";
+    const Expression* arg = call.arguments[0].get();
+    if (arg->getType() == ASTNodeType::EXPR_VARIABLE) {
+        return static_cast<const VariableExpression*>(arg)->name;
+    }
+    if (arg->getType() == ASTNodeType::EXPR_ARRAY_ACCESS &&
+        static_cast<const ArrayAccessExpression*>(arg)->indices.empty()) {
+        return static_cast<const ArrayAccessExpression*>(arg)->name;
+    }
+    return "";
+}
+
+bool BoundsCheckAnalysis::constantValue(const Expression* expr, int64_t& value) {
+    if (!expr) return false;
+    switch (expr->getType()) {
+        case ASTNodeType::EXPR_NUMBER: {
+            double v = static_cast<const NumberExpression*>(expr)->value;
+            if (v != std::floor(v) || std::fabs(v) >= static_cast<double>(kMaxConstant)) return false;
+            value = static_cast<int64_t>(v);
+            return true;
+        }
+        case ASTNodeType::EXPR_UNARY: {
+            const auto* unary = static_cast<const UnaryExpression*>(expr);
+            if (unary->op != TokenType::MINUS || !constantValue(unary->expr.get(), value)) return false;
+            value = -value;
+            return true;
+        }
+        case ASTNodeType::EXPR_BINARY: {
+            const auto* bin = static_cast<const BinaryExpression*>(expr);
+            int64_t l = 0, r = 0;
+            if ((bin->op != TokenType::PLUS && bin->op != TokenType::MINUS) ||
+                !constantValue(bin->left.get(), l) || !constantValue(bin->right.get(), r)) {
+                return false;
+            }
+            value = bin->op == TokenType::PLUS ? l + r : l - r;
+            return std::llabs(value) < kMaxConstant;
+        }
+        default:
+            return false;
+    }
+}
+
+bool BoundsCheckAnalysis::affineIndex(const Expression* expr, std::string& variable, int64_t& offset) {
+    if (!expr) return false;
+    if (expr->getType() == ASTNodeType::EXPR_VARIABLE) {
+        variable = static_cast<const VariableExpression*>(expr)->name;
+        offset = 0;
+        return true;
+    }
+    if (expr->getType() != ASTNodeType::EXPR_BINARY) return false;
+    const auto* bin = static_cast<const BinaryExpression*>(expr);
+    int64_t c = 0;
+    if (bin->op == TokenType::PLUS) {
+        if (bin->left->getType() == ASTNodeType::EXPR_VARIABLE && constantValue(bin->right.get(), c)) {
+            variable = static_cast<const VariableExpression*>(bin->left.get())->name;
+            offset = c;
+            return true;
+        }
+        if (bin->right->getType() == ASTNodeType::EXPR_VARIABLE && constantValue(bin->left.get(), c)) {
+            variable = static_cast<const VariableExpression*>(bin->right.get())->name;
+            offset = c;
+            return true;
+        }
+    } else if (bin->op == TokenType::MINUS) {
+        if (bin->left->getType() == ASTNodeType::EXPR_VARIABLE && constantValue(bin->right.get(), c)) {
+            variable = static_cast<const VariableExpression*>(bin->left.get())->name;
+            offset = -c;
+            return true;
+        }
+    }
+    return false;
+}
+
+BoundsCheckAnalysis::Bound BoundsCheckAnalysis::classifyBound(const Expression* expr) const {
+    Bound bound;
+    if (!expr) return bound;
+    if (constantValue(expr, bound.offset)) {
+        bound.kind = Bound::Kind::CONSTANT;
+        return bound;
+    }
+    if (expr->getType() == ASTNodeType::EXPR_FUNCTION_CALL) {
+        const auto* call = dynamic_cast<const FunctionCallExpression*>(expr);
+        if (!call || call->isFN) return bound;
+        std::string name = call->name;
+        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+        if (name != "LBOUND" && name != "UBOUND") return bound;
+        std::string array = boundsCallArray(*call);
+        int64_t dimension = 1;
+        if (array.empty() || !symbols_.arrays.count(array) || call->arguments.size() > 2 ||
+            (call->arguments.size() == 2 && !constantValue(call->arguments[1].get(), dimension))) {
+            return bound;
+        }
+        bound.kind = name == "LBOUND" ? Bound::Kind::LBOUND : Bound::Kind::UBOUND;
+        bound.array = array;
+        bound.dimension = static_cast<int>(dimension);
+        bound.offset = 0;
+        return bound;
+    }
+    if (expr->getType() == ASTNodeType::EXPR_BINARY) {
+        const auto* bin = static_cast<const BinaryExpression*>(expr);
+        int64_t c = 0;
+        if (bin->op == TokenType::PLUS || bin->op == TokenType::MINUS) {
+            if (constantValue(bin->right.get(), c)) {
+                Bound inner = classifyBound(bin->left.get());
+                if (inner.kind == Bound::Kind::LBOUND || inner.kind == Bound::Kind::UBOUND) {
+                    inner.offset += bin->op == TokenType::PLUS ? c : -c;
+                    if (std::llabs(inner.offset) < kMaxConstant) return inner;
+                }
+            } else if (bin->op == TokenType::PLUS && constantValue(bin->left.get(), c)) {
+                Bound inner = classifyBound(bin->right.get());
+                if (inner.kind == Bound::Kind::LBOUND || inner.kind == Bound::Kind::UBOUND) {
+                    inner.offset += c;
+                    if (std::llabs(inner.offset) < kMaxConstant) return inner;
+                }
+            }
+        }
+    }
+    return bound;
+}
+
+std::string BoundsCheckAnalysis::sourceName(const std::string& name) {
+    static const std::pair<const char*, char> suffixes[] = {
+        {"_INT", '%'}, {"_LONG", '&'}, {"_DOUBLE", '#'}, {"_FLOAT", '!'},
+        {"_STRING", '$'}, {"_BYTE", '@'}, {"_SHORT", '^'}};
+    for (const auto& [suffix, sigil] : suffixes) {
+        size_t len = std::char_traits<char>::length(suffix);
+        if (name.size() > len && name.compare(name.size() - len, len, suffix) == 0) {
+            return name.substr(0, name.size() - len) + sigil;
+        }
+    }
+    return name;
+}
+
+} // namespace FasterBASIC
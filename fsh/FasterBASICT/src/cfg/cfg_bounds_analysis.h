@@ -0,0 +1,149 @@
+//
+// cfg_bounds_analysis.h
+// FasterBASIC - Array bounds-check elimination for FOR loops
+//
+// Array subscripts are range-checked inline on every access.  Inside a
+// FOR loop whose variable is only changed by NEXT, every iteration of
+// the body sees a value between the start and the limit the loop was
+// entered with, so a subscript  a(i + c)  can be decided once:
+//
+//   NONE      the range is provably inside the array, either against a
+//             constant DIM (FOR i = 0 TO 99 over DIM a(99)) or against
+//             the array's own bounds (FOR i = LBOUND(a) TO UBOUND(a))
+//   PRE_LOOP  the range is tested once when the loop is entered; the
+//             body only re-checks when that test failed
+//   FULL      the subscript is checked on every access, as before
+//
+// The analysis works on the CFG built by CFGBuilder.  A loop qualifies
+// only if it is entered through its For_Init block alone (no GOTO or
+// GOSUB into the middle), its variable is not assigned in any block of
+// the loop, and its STEP is a constant.
+//
+
+#ifndef FASTERBASIC_CFG_BOUNDS_ANALYSIS_H
+#define FASTERBASIC_CFG_BOUNDS_ANALYSIS_H
+
+#include "../fasterbasic_ast.h"
+#include "../fasterbasic_cfg.h"
+#include "../fasterbasic_semantic.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace FasterBASIC {
+
+class BoundsCheckAnalysis {
+public:
+    enum class CheckKind { FULL, PRE_LOOP, NONE };
+
+    // A loop start or limit, as far as the analysis can tell
+    struct Bound {
+        enum class Kind { OTHER, CONSTANT, LBOUND, UBOUND };
+        Kind kind = Kind::OTHER;
+        int64_t offset = 0;       // the constant, or the amount added to LBOUND/UBOUND
+        std::string array;        // LBOUND/UBOUND only
+        int dimension = 1;        // LBOUND/UBOUND only (1-based)
+    };
+
+    // One range test emitted in a loop's For_Init block:
+    // low + offset and high + offset both inside dimension `dimension` of `array`
+    struct PreLoopCheck {
+        std::string array;
+        int dimension = 0;        // 0-based
+        int64_t offset = 0;
+
+        bool operator<(const PreLoopCheck& other) const {
+            if (array != other.array) return array < other.array;
+            if (dimension != other.dimension) return dimension < other.dimension;
+            return offset < other.offset;
+        }
+    };
+
+    // A FOR loop whose variable only changes at NEXT
+    struct InductionLoop {
+        const ForStatement* stmt = nullptr;
+        int64_t step = 1;
+        Bound low;                // smallest value the body sees
+        Bound high;               // largest value the body sees
+        std::set<int> blocks;     // loop blocks other than the header
+        std::set<std::string> resizedArrays;    // DIM/REDIM/ERASE inside the loop
+        std::set<PreLoopCheck> preLoopChecks;   // subscripts worth a pre-loop test
+    };
+
+    // How one subscript is checked
+    struct SubscriptCheck {
+        CheckKind kind = CheckKind::FULL;
+        const InductionLoop* loop = nullptr;    // PRE_LOOP: the loop holding the test
+        PreLoopCheck test;                      // PRE_LOOP: the test
+        std::string reason;                     // FULL: why the check stays
+    };
+
+    explicit BoundsCheckAnalysis(const SymbolTable& symbols);
+
+    /**
+     * Find the induction loops of every CFG in the program
+     */
+    void analyze(const ProgramCFG& program);
+
+    /**
+     * Decide how subscript `dimension` (0-based) of `arrayName`, written
+     * as `index`, is checked when it is evaluated in `block`
+     */
+    SubscriptCheck classify(const BasicBlock* block, const std::string& arrayName,
+                            int dimension, const Expression* index) const;
+
+    /**
+     * The analysed loop started by `stmt`, or nullptr
+     */
+    const InductionLoop* loopFor(const ForStatement* stmt) const;
+
+    /**
+     * True when every access to `arrayName` sees the bounds of its
+     * constant DIM: lower bound 0 and upper bound dimensions[d] - 1
+     */
+    bool isStaticArray(const std::string& arrayName) const;
+
+    /**
+     * The array named by the first argument of LBOUND/UBOUND, written
+     * a or a(); empty if the argument is neither
+     */
+    static std::string boundsCallArray(const FunctionCallExpression& call);
+
+    /**
+     * A variable or array name as written in the source: the parser's
+     * type suffix (_INT, _STRING, ...) turned back into its sigil (%, $, ...)
+     */
+    static std::string sourceName(const std::string& name);
+
+private:
+    // Per-CFG facts
+    void analyzeCFG(const ControlFlowGraph& cfg);
+    void analyzeLoop(const ControlFlowGraph& cfg, const BasicBlock& init,
+                     const ForStatement& stmt);
+
+    // Program-wide scans
+    void scanStatement(const Statement* stmt, const ControlFlowGraph& cfg);
+
+    Bound classifyBound(const Expression* expr) const;
+    static bool constantValue(const Expression* expr, int64_t& value);
+    static bool affineIndex(const Expression* expr, std::string& variable, int64_t& offset);
+
+    const SymbolTable& symbols_;
+
+    std::vector<std::unique_ptr<InductionLoop>> loops_;
+    std::map<const ForStatement*, const InductionLoop*> loopsByStmt_;
+    std::map<const BasicBlock*, std::vector<const InductionLoop*>> loopsByBlock_;  // innermost first
+
+    std::map<std::string, std::set<const Statement*>> dims_;     // DIM statements per array
+    std::set<std::string> resized_;          // arrays with a REDIM or ERASE anywhere
+    std::set<std::string> functionResized_;  // arrays DIM'd/REDIM'd/ERASEd inside a SUB/FUNCTION
+    std::set<std::string> parameterArrays_;  // names used for array parameters
+    bool resizesParameter_ = false;          // a SUB/FUNCTION resizes an array it was passed
+};
+
+} // namespace FasterBASIC
+
+#endif // FASTERBASIC_CFG_BOUNDS_ANALYSIS_H
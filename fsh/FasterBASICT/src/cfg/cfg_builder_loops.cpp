@@ -116,6 +116,13 @@ BasicBlock* CFGBuilder::buildFor(
         std::cout << "[CFG] Building FOR loop" << std::endl;
     }
     
+    // PARALLEL FOR is a single statement: its body is outlined by the
+    // code generator and never branches back into this CFG
+    if (stmt.parallel) {
+        addStatementToBlock(incoming, &stmt, getLineNumber(&stmt));
+        return incoming;
+    }
+    
     // 1. Create blocks
     BasicBlock* initBlock = createBlock("For_Init");
     BasicBlock* headerBlock = createBlock("For_Header");
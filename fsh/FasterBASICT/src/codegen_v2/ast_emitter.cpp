@@ -6,6 +6,8 @@
 #include <iostream>
 #include <cstring>
 #include <cstdlib>
+#include <algorithm>
+#include <cctype>
 
 namespace fbc {
 
@@ -26,6 +28,349 @@ bool ASTEmitter::isSAMMEnabled() const {
     return semantic_.getSymbolTable().sammEnabled;
 }
 
+// === SAMM Tracking Elision ===
+//
+// Every string/list/object allocation is registered with the current SAMM
+// scope so it can be released when the scope exits.  That bookkeeping is
+// wasted when the compiler can prove it is unnecessary:
+//
+//   - A SUB/FUNCTION that never creates a trackable allocation does not
+//     need samm_enter_scope()/samm_exit_scope() at all.
+//   - A string temporary that dies at the end of its statement (a literal
+//     that is printed or compared, a concatenation that is printed) can be
+//     released directly instead of waiting for scope exit.  Literals are
+//     then created untracked (string_new_utf8_temp).
+//
+// Both analyses are conservative: anything they do not fully understand
+// is assumed to allocate / escape.
+
+bool ASTEmitter::needsSAMMScope(const ControlFlowGraph* cfg) {
+    if (!cfg) return true;
+    sammElision_.functionsAnalyzed++;
+
+    std::string currentFunc = symbolMapper_.getCurrentFunction();
+    const auto& symbolTable = semantic_.getSymbolTable();
+
+    // Non-numeric parameters, return value or locals all imply string /
+    // object traffic inside the body.
+    auto funcIt = symbolTable.functions.find(currentFunc);
+    if (funcIt == symbolTable.functions.end()) return true;
+    BaseType returnType = funcIt->second.returnTypeDesc.baseType;
+    if (returnType != BaseType::VOID && !typeManager_.isNumeric(returnType)) return true;
+    for (const auto& paramType : funcIt->second.parameterTypeDescs) {
+        if (!typeManager_.isNumeric(paramType.baseType)) return true;
+    }
+    for (const auto& pair : symbolTable.variables) {
+        const auto& varSymbol = pair.second;
+        if (varSymbol.scope.isFunction() && varSymbol.scope.name == currentFunc &&
+            !typeManager_.isNumeric(varSymbol.typeDesc.baseType)) {
+            return true;
+        }
+    }
+    for (const auto& pair : symbolTable.arrays) {
+        if (pair.second.functionScope == currentFunc) return true;
+    }
+
+    for (const auto& block : cfg->blocks) {
+        if (!block) continue;
+        for (const Statement* stmt : block->statements) {
+            if (statementMayTrack(stmt)) return true;
+        }
+    }
+
+    sammElision_.scopesElided++;
+    return false;
+}
+
+bool ASTEmitter::expressionMayTrack(const Expression* expr) {
+    if (!expr) return false;
+    if (!typeManager_.isNumeric(getExpressionType(expr))) return true;
+
+    switch (expr->getType()) {
+        case ASTNodeType::EXPR_NUMBER:
+        case ASTNodeType::EXPR_VARIABLE:
+            return false;
+
+        case ASTNodeType::EXPR_UNARY:
+            return expressionMayTrack(static_cast<const UnaryExpression*>(expr)->expr.get());
+
+        case ASTNodeType::EXPR_BINARY: {
+            const auto* bin = static_cast<const BinaryExpression*>(expr);
+            return expressionMayTrack(bin->left.get()) || expressionMayTrack(bin->right.get());
+        }
+
+        case ASTNodeType::EXPR_ARRAY_ACCESS: {
+            const auto* arr = static_cast<const ArrayAccessExpression*>(expr);
+            for (const auto& idx : arr->indices) {
+                if (expressionMayTrack(idx.get())) return true;
+            }
+            return false;
+        }
+
+        case ASTNodeType::EXPR_FUNCTION_CALL: {
+            // Built-in and user functions with numeric results; a user
+            // FUNCTION manages its own scope.  Registry (plugin) calls are
+            // opaque.
+            const auto* call = dynamic_cast<const FunctionCallExpression*>(expr);
+            if (!call) return true;
+            for (const auto& arg : call->arguments) {
+                if (expressionMayTrack(arg.get())) return true;
+            }
+            return false;
+        }
+
+        case ASTNodeType::EXPR_IIF: {
+            const auto* iif = static_cast<const IIFExpression*>(expr);
+            return expressionMayTrack(iif->condition.get()) ||
+                   expressionMayTrack(iif->trueValue.get()) ||
+                   expressionMayTrack(iif->falseValue.get());
+        }
+
+        default:
+            return true;
+    }
+}
+
+bool ASTEmitter::statementMayTrack(const Statement* stmt) {
+    if (!stmt) return false;
+
+    auto anyMayTrack = [this](const std::vector<StatementPtr>& stmts) {
+        for (const auto& s : stmts) {
+            if (statementMayTrack(s.get())) return true;
+        }
+        return false;
+    };
+
+    switch (stmt->getType()) {
+        case ASTNodeType::STMT_REM:
+        case ASTNodeType::STMT_LABEL:
+        case ASTNodeType::STMT_GOTO:
+        case ASTNodeType::STMT_EXIT:
+        case ASTNodeType::STMT_NEXT:
+        case ASTNodeType::STMT_WEND:
+        case ASTNodeType::STMT_END:
+            return false;
+
+        case ASTNodeType::STMT_PRINT: {
+            const auto* print = static_cast<const PrintStatement*>(stmt);
+            if (print->hasUsing) return true;
+            // Non-escaping items are released before the statement ends
+            for (const auto& item : print->items) {
+                if (isNonEscapingExpression(item.expr.get())) continue;
+                if (expressionMayTrack(item.expr.get())) return true;
+            }
+            return false;
+        }
+
+        case ASTNodeType::STMT_LET: {
+            const auto* let = static_cast<const LetStatement*>(stmt);
+            if (!let->memberChain.empty()) return true;
+            const auto& symbolTable = semantic_.getSymbolTable();
+            auto arrIt = symbolTable.arrays.find(let->variable);
+            if (let->indices.empty()) {
+                // Whole-array assignment may build temporaries
+                if (arrIt != symbolTable.arrays.end()) return true;
+                if (!typeManager_.isNumeric(getVariableType(let->variable)) &&
+                    !isNumericReturnAssignment(let->variable)) {
+                    return true;
+                }
+            } else {
+                // Only plain numeric arrays; lists and hashmaps also use ()
+                if (arrIt == symbolTable.arrays.end()) return true;
+                if (!typeManager_.isNumeric(arrIt->second.elementTypeDesc.baseType)) return true;
+                for (const auto& idx : let->indices) {
+                    if (expressionMayTrack(idx.get())) return true;
+                }
+            }
+            return expressionMayTrack(let->value.get());
+        }
+
+        case ASTNodeType::STMT_INC:
+        case ASTNodeType::STMT_DEC: {
+            const auto& indices = stmt->getType() == ASTNodeType::STMT_INC
+                ? static_cast<const IncStatement*>(stmt)->indices
+                : static_cast<const DecStatement*>(stmt)->indices;
+            const auto& memberChain = stmt->getType() == ASTNodeType::STMT_INC
+                ? static_cast<const IncStatement*>(stmt)->memberChain
+                : static_cast<const DecStatement*>(stmt)->memberChain;
+            const Expression* amount = stmt->getType() == ASTNodeType::STMT_INC
+                ? static_cast<const IncStatement*>(stmt)->incrementExpr.get()
+                : static_cast<const DecStatement*>(stmt)->decrementExpr.get();
+            if (!indices.empty() || !memberChain.empty()) return true;
+            return expressionMayTrack(amount);
+        }
+
+        case ASTNodeType::STMT_LOCAL: {
+            const auto* local = static_cast<const LocalStatement*>(stmt);
+            std::string currentFunc = symbolMapper_.getCurrentFunction();
+            for (const auto& var : local->variables) {
+                const auto* varSymbol = semantic_.lookupVariableScoped(var.name, currentFunc);
+                if (!varSymbol || !typeManager_.isNumeric(varSymbol->typeDesc.baseType)) return true;
+                if (expressionMayTrack(var.initialValue.get())) return true;
+            }
+            return false;
+        }
+
+        case ASTNodeType::STMT_RETURN:
+            return expressionMayTrack(static_cast<const ReturnStatement*>(stmt)->returnValue.get());
+
+        case ASTNodeType::STMT_CALL: {
+            // The callee enters its own scope; only the arguments matter.
+            const auto* call = static_cast<const CallStatement*>(stmt);
+            if (call->methodCallExpr) return true;
+            for (const auto& arg : call->arguments) {
+                if (expressionMayTrack(arg.get())) return true;
+            }
+            return false;
+        }
+
+        case ASTNodeType::STMT_IF: {
+            const auto* ifStmt = static_cast<const IfStatement*>(stmt);
+            if (expressionMayTrack(ifStmt->condition.get())) return true;
+            if (anyMayTrack(ifStmt->thenStatements)) return true;
+            for (const auto& clause : ifStmt->elseIfClauses) {
+                if (expressionMayTrack(clause.condition.get())) return true;
+                if (anyMayTrack(clause.statements)) return true;
+            }
+            return anyMayTrack(ifStmt->elseStatements);
+        }
+
+        case ASTNodeType::STMT_FOR: {
+            const auto* forStmt = static_cast<const ForStatement*>(stmt);
+            return expressionMayTrack(forStmt->start.get()) ||
+                   expressionMayTrack(forStmt->end.get()) ||
+                   expressionMayTrack(forStmt->step.get()) ||
+                   anyMayTrack(forStmt->body);
+        }
+
+        case ASTNodeType::STMT_WHILE: {
+            const auto* whileStmt = static_cast<const WhileStatement*>(stmt);
+            return expressionMayTrack(whileStmt->condition.get()) ||
+                   anyMayTrack(whileStmt->body);
+        }
+
+        case ASTNodeType::STMT_DO: {
+            const auto* doStmt = static_cast<const DoStatement*>(stmt);
+            return expressionMayTrack(doStmt->preCondition.get()) ||
+                   expressionMayTrack(doStmt->postCondition.get()) ||
+                   anyMayTrack(doStmt->body);
+        }
+
+        case ASTNodeType::STMT_LOOP:
+            return expressionMayTrack(static_cast<const LoopStatement*>(stmt)->condition.get());
+
+        case ASTNodeType::STMT_REPEAT: {
+            const auto* repeat = static_cast<const RepeatStatement*>(stmt);
+            return expressionMayTrack(repeat->condition.get()) || anyMayTrack(repeat->body);
+        }
+
+        case ASTNodeType::STMT_UNTIL:
+            return expressionMayTrack(static_cast<const UntilStatement*>(stmt)->condition.get());
+
+        default:
+            return true;
+    }
+}
+
+// `FuncName = value` inside a FUNCTION assigns the return value.
+bool ASTEmitter::isNumericReturnAssignment(const std::string& varName) {
+    std::string currentFunc = symbolMapper_.getCurrentFunction();
+    if (currentFunc.empty() || varName.size() != currentFunc.size() ||
+        !std::equal(varName.begin(), varName.end(), currentFunc.begin(),
+                    [](char a, char b) { return std::toupper((unsigned char)a) ==
+                                                std::toupper((unsigned char)b); })) {
+        return false;
+    }
+    auto funcIt = semantic_.getSymbolTable().functions.find(currentFunc);
+    return funcIt != semantic_.getSymbolTable().functions.end() &&
+           typeManager_.isNumeric(funcIt->second.returnTypeDesc.baseType);
+}
+
+bool ASTEmitter::isNonEscapingExpression(const Expression* expr) {
+    if (!expr) return false;
+
+    switch (expr->getType()) {
+        case ASTNodeType::EXPR_STRING:
+        case ASTNodeType::EXPR_NUMBER:
+        case ASTNodeType::EXPR_VARIABLE:
+            return true;
+
+        case ASTNodeType::EXPR_UNARY:
+            return isNonEscapingExpression(static_cast<const UnaryExpression*>(expr)->expr.get());
+
+        case ASTNodeType::EXPR_BINARY: {
+            // string_concat always returns a fresh descriptor and
+            // string_compare keeps no reference, so both operands die here.
+            // Mixed string/number operands need a tracked conversion.
+            const auto* bin = static_cast<const BinaryExpression*>(expr);
+            BaseType leftType = getExpressionType(bin->left.get());
+            BaseType rightType = getExpressionType(bin->right.get());
+            if (leftType == BaseType::USER_DEFINED || rightType == BaseType::USER_DEFINED) {
+                return false;
+            }
+            if (typeManager_.isString(leftType) != typeManager_.isString(rightType)) {
+                return false;
+            }
+            return isNonEscapingExpression(bin->left.get()) &&
+                   isNonEscapingExpression(bin->right.get());
+        }
+
+        case ASTNodeType::EXPR_FUNCTION_CALL: {
+            // Substrings are emitted as untracked views of their argument
+            // and LEN/ASC keep no reference, so the arguments die here too.
+            // MID$/LEFT$/RIGHT$ reach codegen as registry function nodes.
+            const std::vector<ExpressionPtr>* args = nullptr;
+            std::string upperName;
+            if (const auto* call = dynamic_cast<const FunctionCallExpression*>(expr)) {
+                if (call->isFN) return false;
+                upperName = call->name;
+                args = &call->arguments;
+            } else if (const auto* reg = dynamic_cast<const RegistryFunctionExpression*>(expr)) {
+                upperName = reg->name;
+                args = &reg->arguments;
+            } else {
+                return false;
+            }
+            std::transform(upperName.begin(), upperName.end(), upperName.begin(), ::toupper);
+            static const std::unordered_set<std::string> statementLocal = {
+                "MID", "MID$", "LEFT", "LEFT$", "RIGHT", "RIGHT$",
+                "__STRING_SLICE", "LEN", "ASC"
+            };
+            if (statementLocal.count(upperName) == 0) return false;
+            const auto* pluginFunc =
+                FasterBASIC::ModularCommands::getGlobalCommandRegistry().getFunction(upperName);
+            if (pluginFunc && pluginFunc->functionPtr != nullptr) {
+                return false;  // Plugin functions take precedence over built-ins
+            }
+            for (const auto& arg : *args) {
+                if (!isNonEscapingExpression(arg.get())) return false;
+            }
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+std::string ASTEmitter::emitNonEscapingExpression(const Expression* expr) {
+    if (!isNonEscapingExpression(expr)) {
+        return emitExpression(expr);
+    }
+    nonEscapingScope_ = true;
+    std::string value = emitExpression(expr);
+    nonEscapingScope_ = false;
+    return value;
+}
+
+void ASTEmitter::releaseNonEscapingTemps() {
+    for (const auto& temp : nonEscapingTemps_) {
+        runtime_.emitStringRelease(temp);
+        sammElision_.tempsReleased++;
+    }
+    nonEscapingTemps_.clear();
+}
+
 // === Expression Emission ===
 
 std::string ASTEmitter::emitExpression(const Expression* expr) {
@@ -571,6 +916,17 @@ std::string ASTEmitter::emitStringLiteral(const StringExpression* expr) {
         builder_.emitComment("WARNING: String not pre-registered: " + expr->value);
     }
     
+    // A literal that dies with its statement is created untracked and
+    // released by releaseNonEscapingTemps().
+    if (nonEscapingScope_) {
+        std::string temp = runtime_.emitStringLiteralTemp(label);
+        nonEscapingTemps_.push_back(temp);
+        if (isSAMMEnabled()) {
+            sammElision_.literalTracksElided++;
+        }
+        return temp;
+    }
+
     // Convert C string to FasterBASIC string descriptor
     return runtime_.emitStringLiteral(label);
 }
@@ -1495,6 +1851,25 @@ std::string ASTEmitter::emitFunctionCall(const FunctionCallExpression* expr) {
         }
     }
     
+    // LBOUND(a [, dim]) / UBOUND(a [, dim]) - array bounds (dim defaults to 1)
+    if (upperName == "LBOUND" || upperName == "UBOUND") {
+        std::string arrayName = BoundsCheckAnalysis::boundsCallArray(*expr);
+        if (arrayName.empty()) {
+            builder_.emitComment("ERROR: " + upperName + " requires an array");
+            return "0";
+        }
+        std::string arrPtr = builder_.newTemp();
+        builder_.emitLoad(arrPtr, "l", getArrayDescriptorPtr(arrayName));
+        std::string dim = "1";
+        if (expr->arguments.size() > 1) {
+            dim = emitExpressionAs(expr->arguments[1].get(), BaseType::INTEGER);
+        }
+        std::string result = builder_.newTemp();
+        builder_.emitCall(result, "w", upperName == "LBOUND" ? "array_lbound" : "array_ubound",
+                          "l " + arrPtr + ", w " + dim);
+        return result;
+    }
+
     if (upperName == "LEN") {
         // LEN(string$) - returns length of string
         if (expr->arguments.size() != 1) {
@@ -1505,6 +1880,22 @@ std::string ASTEmitter::emitFunctionCall(const FunctionCallExpression* expr) {
         return runtime_.emitStringLen(strArg);
     }
     
+    if (upperName == "EOF") {
+        // EOF(n) - -1 when the next read from file #n would hit end of file
+        if (expr->arguments.size() != 1) {
+            builder_.emitComment("ERROR: EOF requires exactly 1 argument");
+            return "0";
+        }
+        std::string fileNum = emitExpressionAs(expr->arguments[0].get(), BaseType::INTEGER);
+        std::string result = builder_.newTemp();
+        builder_.emitCall(result, "w", "file_eof_number", "w " + fileNum);
+        return result;
+    }
+    
+    if (upperName == "READCSV") {
+        return emitReadCsvCall(expr);
+    }
+    
     if (upperName == "MID" || upperName == "MID$") {
         // MID$(string$, start[, length]) - substring extraction
         if (expr->arguments.size() < 2 || expr->arguments.size() > 3) {
@@ -1515,7 +1906,9 @@ std::string ASTEmitter::emitFunctionCall(const FunctionCallExpression* expr) {
         std::string startArg = emitExpression(expr->arguments[1].get());
         std::string lenArg = expr->arguments.size() == 3 ? 
                              emitExpression(expr->arguments[2].get()) : "";
-        return runtime_.emitMid(strArg, startArg, lenArg);
+        std::string result = runtime_.emitMid(strArg, startArg, lenArg, nonEscapingScope_);
+        if (nonEscapingScope_) nonEscapingTemps_.push_back(result);
+        return result;
     }
     
     if (upperName == "LEFT" || upperName == "LEFT$") {
@@ -1526,7 +1919,9 @@ std::string ASTEmitter::emitFunctionCall(const FunctionCallExpression* expr) {
         }
         std::string strArg = emitExpression(expr->arguments[0].get());
         std::string lenArg = emitExpression(expr->arguments[1].get());
-        return runtime_.emitLeft(strArg, lenArg);
+        std::string result = runtime_.emitLeft(strArg, lenArg, nonEscapingScope_);
+        if (nonEscapingScope_) nonEscapingTemps_.push_back(result);
+        return result;
     }
     
     if (upperName == "RIGHT" || upperName == "RIGHT$") {
@@ -1537,7 +1932,9 @@ std::string ASTEmitter::emitFunctionCall(const FunctionCallExpression* expr) {
         }
         std::string strArg = emitExpression(expr->arguments[0].get());
         std::string lenArg = emitExpression(expr->arguments[1].get());
-        return runtime_.emitRight(strArg, lenArg);
+        std::string result = runtime_.emitRight(strArg, lenArg, nonEscapingScope_);
+        if (nonEscapingScope_) nonEscapingTemps_.push_back(result);
+        return result;
     }
     
     if (upperName == "CHR" || upperName == "CHR$") {
@@ -1633,16 +2030,66 @@ std::string ASTEmitter::emitFunctionCall(const FunctionCallExpression* expr) {
             endArg = emitTypeConversion(endArg, endType, BaseType::LONG);
         }
         
-        // Call string_slice runtime function
+        // Call string_slice runtime function (a view inside a non-escaping
+        // expression)
         std::string result = builder_.newTemp();
-        builder_.emitCall(result, "l", "string_slice", "l " + strArg + ", l " + startArg + ", l " + endArg);
+        builder_.emitCall(result, "l", nonEscapingScope_ ? "string_slice_view" : "string_slice",
+                          "l " + strArg + ", l " + startArg + ", l " + endArg);
+        if (nonEscapingScope_) nonEscapingTemps_.push_back(result);
         return result;
     }
     
-    // Note: INSTR not yet implemented in runtime library
     if (upperName == "INSTR") {
-        builder_.emitComment("TODO: INSTR function not yet implemented");
-        return "0";
+        // INSTR([start,] haystack$, needle$) - 1-based position of needle$
+        // at or after start, 0 if not found.  string_instr is 0-based and
+        // returns -1 when not found, so adding 1 gives the BASIC result.
+        // An empty needle$ matches at start while start is within haystack$.
+        size_t argc = expr->arguments.size();
+        if (argc < 2 || argc > 3) {
+            builder_.emitComment("ERROR: INSTR requires 2 or 3 arguments");
+            return "0";
+        }
+        
+        std::string startArg = "1";
+        if (argc == 3) {
+            startArg = emitExpressionAs(expr->arguments[0].get(), BaseType::LONG);
+        }
+        std::string hayArg = emitExpression(expr->arguments[argc - 2].get());
+        std::string needleArg = emitExpression(expr->arguments[argc - 1].get());
+        
+        std::string startPos = builder_.newTemp();
+        builder_.emitBinary(startPos, "l", "sub", startArg, "1");
+        std::string found = builder_.newTemp();
+        builder_.emitCall(found, "l", "string_instr",
+                          "l " + hayArg + ", l " + needleArg + ", l " + startPos);
+        std::string position = builder_.newTemp();
+        builder_.emitBinary(position, "l", "add", found, "1");
+        
+        // Empty needle$: string_instr gave -1, so position is 0 and
+        // start is added when 1 <= start <= LEN(haystack$)
+        std::string needleLen = runtime_.emitStringLen(needleArg);
+        std::string hayLen = builder_.newTemp();
+        builder_.emitExtend(hayLen, "l", "extsw", runtime_.emitStringLen(hayArg));
+        std::string isEmpty = builder_.newTemp();
+        builder_.emitCompare(isEmpty, "w", "eq", needleLen, "0");
+        std::string aboveOne = builder_.newTemp();
+        builder_.emitCompare(aboveOne, "l", "sge", startArg, "1");
+        std::string withinHay = builder_.newTemp();
+        builder_.emitCompare(withinHay, "l", "sle", startArg, hayLen);
+        std::string emptyHit = builder_.newTemp();
+        builder_.emitBinary(emptyHit, "w", "and", isEmpty, aboveOne);
+        std::string emptyHitIn = builder_.newTemp();
+        builder_.emitBinary(emptyHitIn, "w", "and", emptyHit, withinHay);
+        std::string emptyHitL = builder_.newTemp();
+        builder_.emitExtend(emptyHitL, "l", "extuw", emptyHitIn);
+        std::string emptyPos = builder_.newTemp();
+        builder_.emitBinary(emptyPos, "l", "mul", emptyHitL, startArg);
+        std::string positionL = builder_.newTemp();
+        builder_.emitBinary(positionL, "l", "add", position, emptyPos);
+        
+        std::string result = builder_.newTemp();
+        builder_.emitTrunc(result, "w", positionL);
+        return result;
     }
     
     // Math functions that map to runtime
@@ -2210,9 +2657,32 @@ std::string ASTEmitter::emitMethodCall(const MethodCallExpression* expr) {
                 else if (upperMethod == "POP") runtimeFunc = "list_pop_ptr";
             }
             // else: keep default _int functions
+        } else if (upperMethod == "SUM" || upperMethod == "MIN" || upperMethod == "MAX") {
+            // Reductions: integer lists reduce exactly, all others as DOUBLE
+            std::string baseName = "list_" + upperMethod;
+            std::transform(baseName.begin(), baseName.end(), baseName.begin(), ::tolower);
+            bool intList = (elemType == FasterBASIC::BaseType::INTEGER || elemType == FasterBASIC::BaseType::LONG ||
+                            elemType == FasterBASIC::BaseType::BYTE || elemType == FasterBASIC::BaseType::SHORT);
+            runtimeFunc = baseName + (intList ? "_int" : "_float");
+        } else if (upperMethod == "FILTER" || upperMethod == "MAP") {
+            // FILTER(op$, value) / MAP(op$, value): dispatch on the element
+            // type, or on the value's type for LIST OF ANY
+            if (elemType == FasterBASIC::BaseType::UNKNOWN && providedArgs > 1) {
+                dispatchType = getExpressionType(expr->arguments[1].get());
+            }
+            std::string baseName = (upperMethod == "FILTER") ? "list_filter" : "list_map";
+            if (dispatchType == FasterBASIC::BaseType::DOUBLE || dispatchType == FasterBASIC::BaseType::SINGLE) {
+                runtimeFunc = baseName + "_float";
+            } else if (dispatchType == FasterBASIC::BaseType::STRING || dispatchType == FasterBASIC::BaseType::UNICODE) {
+                // Strings can be filtered; MAP leaves them as they are
+                runtimeFunc = (upperMethod == "FILTER") ? "list_filter_string" : "list_map_float";
+            } else {
+                runtimeFunc = baseName + "_int";
+            }
         }
-        // LENGTH, EMPTY, CLEAR, REMOVE, EXTEND, REST, COPY, REVERSE, JOIN
-        // don't need type dispatch — they use the same function regardless of element type
+        // LENGTH, EMPTY, CLEAR, REMOVE, EXTEND, REST, COPY, REVERSE, JOIN,
+        // SORT, AVG don't need type dispatch — they use the same function
+        // regardless of element type
         
         builder_.emitComment("LIST dispatch: " + runtimeFunc);
     }
@@ -2232,13 +2702,16 @@ std::string ASTEmitter::emitMethodCall(const MethodCallExpression* expr) {
             if (upperMethod == "APPEND" || upperMethod == "PREPEND" || 
                 upperMethod == "CONTAINS" || upperMethod == "INDEXOF") {
                 isValueParam = (i == 0);
-            } else if (upperMethod == "INSERT") {
+            } else if (upperMethod == "INSERT" || upperMethod == "FILTER" || upperMethod == "MAP") {
                 isValueParam = (i == 1);
             }
             
             if (isValueParam) {
                 FasterBASIC::BaseType dispType = (elemType != FasterBASIC::BaseType::UNKNOWN) 
                     ? elemType : getExpressionType(expr->arguments[i].get());
+                if (runtimeFunc == "list_map_float") {
+                    dispType = FasterBASIC::BaseType::DOUBLE;
+                }
                 if (dispType == FasterBASIC::BaseType::DOUBLE || dispType == FasterBASIC::BaseType::SINGLE) {
                     actualParamType = FasterBASIC::BaseType::DOUBLE;
                 } else if (dispType == FasterBASIC::BaseType::STRING || dispType == FasterBASIC::BaseType::UNICODE) {
@@ -2252,23 +2725,23 @@ std::string ASTEmitter::emitMethodCall(const MethodCallExpression* expr) {
         std::string argValue = emitExpressionAs(expr->arguments[i].get(), actualParamType);
         
         if (actualParamType == BaseType::STRING) {
-            if (objectTypeDesc.isList()) {
-                // LIST runtime functions (list_append_string, list_contains_string,
-                // list_indexof_string, list_join, etc.) expect StringDescriptor*,
-                // NOT a C-string (char*). Pass the descriptor pointer directly.
-                argsStr += ", l " + argValue;
-            } else {
-                // HASHMAP and other object types expect C-strings (char*)
-                std::string cStringPtr = builder_.newTemp();
-                builder_.emitCall(cStringPtr, "l", "string_to_utf8", "l " + argValue);
-                argsStr += ", l " + cStringPtr;
-            }
+            // LIST and HASHMAP runtime functions (list_append_string,
+            // hashmap_has_key_str, etc.) take the StringDescriptor* itself,
+            // NOT a C-string (char*). Pass the descriptor pointer directly.
+            argsStr += ", l " + argValue;
         } else {
             std::string qbeType = typeManager_.getQBEType(actualParamType);
             argsStr += ", " + qbeType + " " + argValue;
         }
     }
     
+    // Omitted optional parameters take their registered defaults
+    for (size_t i = providedArgs; i < method->parameters.size(); ++i) {
+        const auto& param = method->parameters[i];
+        if (!param.isOptional || param.defaultValue.empty()) break;
+        argsStr += ", " + typeManager_.getQBEType(param.type) + " " + param.defaultValue;
+    }
+    
     if (method->returnType == BaseType::UNKNOWN) {
         builder_.emitCall("", "", runtimeFunc, argsStr);
         return "0";
@@ -2288,10 +2761,14 @@ std::string ASTEmitter::emitMethodCall(const MethodCallExpression* expr) {
                 } else if (elemType == FasterBASIC::BaseType::OBJECT) {
                     actualReturnType = FasterBASIC::BaseType::LONG; // opaque pointer
                 }
-            } else if (upperMethod == "REST" || upperMethod == "COPY" || upperMethod == "REVERSE") {
+            } else if (upperMethod == "REST" || upperMethod == "COPY" || upperMethod == "REVERSE" ||
+                       upperMethod == "FILTER" || upperMethod == "MAP") {
                 actualReturnType = FasterBASIC::BaseType::LONG; // ListHeader pointer
                 // SAMM: track newly created lists returned by copy/reverse/rest
                 // (done after the call below)
+            } else if (upperMethod == "SUM" || upperMethod == "MIN" || upperMethod == "MAX") {
+                actualReturnType = (runtimeFunc.find("_float") != std::string::npos)
+                    ? FasterBASIC::BaseType::DOUBLE : FasterBASIC::BaseType::LONG;
             }
         }
         
@@ -2299,7 +2776,7 @@ std::string ASTEmitter::emitMethodCall(const MethodCallExpression* expr) {
         std::string result = builder_.newTemp();
         builder_.emitCall(result, qbeReturnType, runtimeFunc, argsStr);
         
-        // Note: COPY, REVERSE, REST internally call list_create() which
+        // Note: COPY, REVERSE, REST, FILTER, MAP internally call list_create() which
         // already calls samm_track_list() — do NOT track again here.
         
         if (actualReturnType == BaseType::LONG && qbeReturnType == "l") {
@@ -2428,7 +2905,11 @@ std::string ASTEmitter::emitStringOp(const std::string& left, const std::string&
                                      TokenType op) {
     if (op == TokenType::PLUS) {
         // String concatenation
-        return runtime_.emitStringConcat(left, right);
+        std::string result = runtime_.emitStringConcat(left, right);
+        if (nonEscapingScope_) {
+            nonEscapingTemps_.push_back(result);
+        }
+        return result;
     } else if (op == TokenType::EQUAL) {
         // String equality
         std::string cmpResult = runtime_.emitStringCompare(left, right);
@@ -2507,6 +2988,7 @@ void ASTEmitter::emitStatement(const Statement* stmt) {
         builder_.emitComment("ERROR: null statement");
         return;
     }
+    currentStatementLine_ = stmt->location.line;
     
     switch (stmt->getType()) {
         case ASTNodeType::STMT_LET:
@@ -2542,7 +3024,9 @@ void ASTEmitter::emitStatement(const Statement* stmt) {
             break;
             
         case ASTNodeType::STMT_FOR:
-            if (currentClassContext_ || inDirectEmitContext_) {
+            if (static_cast<const ForStatement*>(stmt)->parallel) {
+                emitParallelFor(static_cast<const ForStatement*>(stmt));
+            } else if (currentClassContext_ || inDirectEmitContext_) {
                 emitForDirect(static_cast<const ForStatement*>(stmt));
             } else {
                 emitForInit(static_cast<const ForStatement*>(stmt));
@@ -2620,6 +3104,10 @@ void ASTEmitter::emitStatement(const Statement* stmt) {
         case ASTNodeType::STMT_RETURN:
             emitReturnStatement(static_cast<const ReturnStatement*>(stmt));
             break;
+
+        case ASTNodeType::STMT_DEF:
+            emitDefStatement(static_cast<const DefStatement*>(stmt));
+            break;
             
         // CLASS & Object System statements
         case ASTNodeType::STMT_CLASS:
@@ -2636,12 +3124,86 @@ void ASTEmitter::emitStatement(const Statement* stmt) {
             break;
         }
             
+        case ASTNodeType::STMT_OPEN:
+            emitOpenStatement(static_cast<const OpenStatement*>(stmt));
+            break;
+            
+        case ASTNodeType::STMT_CLOSE:
+            emitCloseStatement(static_cast<const CloseStatement*>(stmt));
+            break;
+            
         default:
             builder_.emitComment("TODO: statement type " + std::to_string(static_cast<int>(stmt->getType())) + " not yet implemented");
             break;
     }
 }
 
+// S$ = S$ + X$ [+ Y$ ...]: the left spine of the concatenation bottoms out
+// in the assignment target, so each suffix can be appended to the target's
+// own descriptor instead of copying the whole string on every iteration.
+// Only plain string variables that hold their own reference qualify;
+// parameters, FOR EACH variables and METHOD locals use the generic path.
+bool ASTEmitter::isOwnedStringVariable(const std::string& name) {
+    if (!typeManager_.isString(getVariableType(name))) return false;
+    if (methodParamAddresses_.count(name) > 0 || forEachVarTypes_.count(name) > 0) return false;
+    if (symbolMapper_.inFunctionScope() && symbolMapper_.isParameter(name)) return false;
+    return semantic_.lookupVariableScoped(name, symbolMapper_.getCurrentFunction()) != nullptr;
+}
+
+bool ASTEmitter::tryEmitStringSelfAppend(const LetStatement* stmt) {
+    if (!stmt->indices.empty() || !stmt->memberChain.empty()) return false;
+    if (!stmt->value || stmt->value->getType() != ASTNodeType::EXPR_BINARY) return false;
+
+    std::string target = normalizeVariableName(stmt->variable);
+    if (!isOwnedStringVariable(target)) return false;
+
+    // Collect the suffixes (right operands) walking down the left spine
+    std::vector<const Expression*> suffixes;
+    const Expression* node = stmt->value.get();
+    while (node->getType() == ASTNodeType::EXPR_BINARY) {
+        const auto* bin = static_cast<const BinaryExpression*>(node);
+        if (bin->op != TokenType::PLUS) return false;
+        if (!typeManager_.isString(getExpressionType(bin->right.get()))) return false;
+        suffixes.push_back(bin->right.get());
+        node = bin->left.get();
+    }
+    if (node->getType() != ASTNodeType::EXPR_VARIABLE) return false;
+    const auto* base = static_cast<const VariableExpression*>(node);
+    if (normalizeVariableName(base->name) != target) return false;
+
+    // In a chain, a later suffix naming the target would see the earlier
+    // appends (S$ = S$ + "x" + S$); leave that to plain concatenation.
+    if (suffixes.size() > 1) {
+        for (const Expression* suffix : suffixes) {
+            if (suffix->getType() == ASTNodeType::EXPR_VARIABLE &&
+                normalizeVariableName(static_cast<const VariableExpression*>(suffix)->name) == target) {
+                return false;
+            }
+        }
+    }
+
+    builder_.emitComment("String self-append: " + stmt->variable + " += " +
+                         std::to_string(suffixes.size()) + " operand(s)");
+
+    // string_append copies the suffix, so literal/concat suffixes die here
+    std::vector<std::string> values;
+    for (auto it = suffixes.rbegin(); it != suffixes.rend(); ++it) {
+        values.push_back(emitNonEscapingExpression(*it));
+    }
+
+    // string_append consumes the variable's reference and returns the one
+    // to store back, so no retain/release pair is needed here.
+    std::string addr = getVariableAddress(target);
+    std::string current = builder_.newTemp();
+    builder_.emitLoad(current, "l", addr);
+    for (const auto& value : values) {
+        current = runtime_.emitStringAppend(current, value);
+    }
+    builder_.emitStore("l", current, addr);
+    releaseNonEscapingTemps();
+    return true;
+}
+
 void ASTEmitter::emitLetStatement(const LetStatement* stmt) {
     // Invalidate array element cache - assignment may change index variables or array contents
     clearArrayElementCache();
@@ -2723,6 +3285,8 @@ void ASTEmitter::emitLetStatement(const LetStatement* stmt) {
                     } else if (fieldInfo->typeDesc.baseType == FasterBASIC::BaseType::SHORT ||
                                fieldInfo->typeDesc.baseType == FasterBASIC::BaseType::USHORT) {
                         builder_.emitRaw("    storeh " + val + ", " + fieldAddr + "\n");
+                    } else if (fieldInfo->typeDesc.baseType == FasterBASIC::BaseType::STRING) {
+                        emitStringSlotStore(val, fieldAddr);
                     } else {
                         builder_.emitRaw("    storel " + val + ", " + fieldAddr + "\n");
                     }
@@ -2815,8 +3379,10 @@ void ASTEmitter::emitLetStatement(const LetStatement* stmt) {
                     } else if (fieldInfo->typeDesc.baseType == FasterBASIC::BaseType::SHORT ||
                                fieldInfo->typeDesc.baseType == FasterBASIC::BaseType::USHORT) {
                         builder_.emitRaw("    storeh " + val + ", " + fieldAddr + "\n");
+                    } else if (fieldInfo->typeDesc.baseType == FasterBASIC::BaseType::STRING) {
+                        emitStringSlotStore(val, fieldAddr);
                     } else {
-                        // Default: pointer-sized store (STRING, CLASS_INSTANCE, LONG, etc.)
+                        // Default: pointer-sized store (CLASS_INSTANCE, LONG, etc.)
                         builder_.emitRaw("    storel " + val + ", " + fieldAddr + "\n");
                     }
                     return;
@@ -3080,7 +3646,7 @@ void ASTEmitter::emitLetStatement(const LetStatement* stmt) {
         std::string qbeType = typeManager_.getQBEType(fieldType);
         if (fieldType == BaseType::STRING) {
             // String fields are stored as pointers to StringDescriptor
-            builder_.emitStore("l", value, fieldPtr);
+            emitStringSlotStore(value, fieldPtr);
         } else {
             builder_.emitStore(qbeType, value, fieldPtr);
         }
@@ -3204,13 +3770,8 @@ void ASTEmitter::emitLetStatement(const LetStatement* stmt) {
                 
                 std::string keyValue = emitExpressionAs(stmt->indices[0].get(), objDesc->subscriptKeyType.baseType);
                 
-                // If key is a string descriptor, extract C string pointer
+                // String keys are passed as the StringDescriptor* itself
                 std::string keyArg = keyValue;
-                if (objDesc->subscriptKeyType.baseType == BaseType::STRING) {
-                    std::string cStringPtr = builder_.newTemp();
-                    builder_.emitCall(cStringPtr, "l", "string_to_utf8", "l " + keyValue);
-                    keyArg = cStringPtr;
-                }
                 
                 // Evaluate the value expression
                 std::string value = emitExpression(stmt->value.get());
@@ -3219,6 +3780,13 @@ void ASTEmitter::emitLetStatement(const LetStatement* stmt) {
                 // For now, assume value is already a pointer (works for strings/arrays)
                 std::string boxedValue = value;
                 
+                // The map owns a reference to string values and releases it
+                // when the value is replaced or removed
+                if (typeManager_.isString(getExpressionType(stmt->value.get()))) {
+                    boxedValue = builder_.newTemp();
+                    builder_.emitCall(boxedValue, "l", "string_retain", "l " + value);
+                }
+                
                 // Call the subscript set function from registry
                 std::string resultReg = builder_.newTemp();
                 builder_.emitCall(resultReg, "w", objDesc->subscriptSetFunction,
@@ -3289,6 +3857,11 @@ void ASTEmitter::emitLetStatement(const LetStatement* stmt) {
         }
     }
 
+    // S$ = S$ + X$: append in place rather than re-copying the whole string
+    if (tryEmitStringSelfAppend(stmt)) {
+        return;
+    }
+
     // Determine target type based on whether it's an array or scalar
     BaseType targetType;
     
@@ -3323,10 +3896,17 @@ void ASTEmitter::emitLetStatement(const LetStatement* stmt) {
 }
 
 void ASTEmitter::emitPrintStatement(const PrintStatement* stmt) {
+    if (stmt->fileNumber > 0) {
+        emitFilePrintStatement(stmt);
+        return;
+    }
+
     for (const auto& item : stmt->items) {
         if (item.expr) {
             BaseType exprType = getExpressionType(item.expr.get());
-            std::string value = emitExpression(item.expr.get());
+            std::string value = exprType == BaseType::USER_DEFINED
+                ? emitExpression(item.expr.get())
+                : emitNonEscapingExpression(item.expr.get());
             
             if (exprType == BaseType::USER_DEFINED) {
                 // Whole-UDT PRINT: TypeName(field1, field2, ...)
@@ -3350,6 +3930,7 @@ void ASTEmitter::emitPrintStatement(const PrintStatement* stmt) {
             } else {
                 runtime_.emitPrintInt(value, exprType);
             }
+            releaseNonEscapingTemps();
         }
         
         // Handle separators
@@ -3367,6 +3948,11 @@ void ASTEmitter::emitPrintStatement(const PrintStatement* stmt) {
 void ASTEmitter::emitInputStatement(const InputStatement* stmt) {
     // Invalidate array element cache - INPUT modifies a variable
     clearArrayElementCache();
+
+    if (stmt->fileNumber > 0) {
+        emitFileInputStatement(stmt);
+        return;
+    }
     // TODO: Handle prompt
     
     for (const auto& varName : stmt->variables) {
@@ -3387,6 +3973,226 @@ void ASTEmitter::emitInputStatement(const InputStatement* stmt) {
     }
 }
 
+// === File I/O ===
+//
+// Files are buffered by the runtime (io_ops.c); PRINT #/INPUT # look the
+// handle up once per statement and then call one runtime function per item.
+
+void ASTEmitter::emitOpenStatement(const OpenStatement* stmt) {
+    std::string mode = stmt->mode;
+    std::transform(mode.begin(), mode.end(), mode.begin(), ::toupper);
+
+    int modeCode;
+    if (mode == "INPUT") {
+        modeCode = 0;   // BASIC_FILE_INPUT
+    } else if (mode == "OUTPUT") {
+        modeCode = 1;   // BASIC_FILE_OUTPUT
+    } else if (mode == "APPEND") {
+        modeCode = 2;   // BASIC_FILE_APPEND
+    } else {
+        // Rejected by the semantic analyzer
+        builder_.emitComment("ERROR: unsupported OPEN mode " + mode);
+        return;
+    }
+
+    builder_.emitComment("OPEN \"" + stmt->filename + "\" FOR " + mode +
+                         " AS #" + std::to_string(stmt->fileNumber));
+    std::string label = builder_.registerString(stmt->filename);
+    std::string filename = runtime_.emitStringLiteral(label);
+    builder_.emitCall("", "", "file_open_number",
+                      "w " + std::to_string(stmt->fileNumber) + ", l " + filename +
+                      ", w " + std::to_string(modeCode));
+}
+
+void ASTEmitter::emitCloseStatement(const CloseStatement* stmt) {
+    if (stmt->closeAll) {
+        builder_.emitComment("CLOSE");
+        builder_.emitCall("", "", "file_close_all", "");
+    } else {
+        builder_.emitComment("CLOSE #" + std::to_string(stmt->fileNumber));
+        builder_.emitCall("", "", "file_close_number",
+                          "w " + std::to_string(stmt->fileNumber));
+    }
+}
+
+void ASTEmitter::emitFilePrintStatement(const PrintStatement* stmt) {
+    builder_.emitComment(std::string(stmt->isWrite ? "WRITE #" : "PRINT #") +
+                         std::to_string(stmt->fileNumber));
+    std::string file = builder_.newTemp();
+    builder_.emitCall(file, "l", "file_get_handle", "w " + std::to_string(stmt->fileNumber));
+
+    for (const auto& item : stmt->items) {
+        if (item.expr) {
+            BaseType exprType = getExpressionType(item.expr.get());
+            if (exprType == BaseType::USER_DEFINED) {
+                // Same TypeName(field1, field2, ...) text as console PRINT
+                std::string value = emitExpression(item.expr.get());
+                std::string udtName = getUDTTypeNameForExpr(item.expr.get());
+                const auto& symbolTable = semantic_.getSymbolTable();
+                auto udtIt = symbolTable.types.find(udtName);
+                if (!udtName.empty() && udtIt != symbolTable.types.end()) {
+                    emitPrintUDTValue(value, udtIt->second, symbolTable.types, file);
+                } else {
+                    builder_.emitComment("PRINT # UDT: unknown type '" + udtName + "'");
+                }
+            } else {
+                std::string value = emitNonEscapingExpression(item.expr.get());
+                if (typeManager_.isString(exprType)) {
+                    builder_.emitCall("", "", stmt->isWrite ? "file_write_string_desc"
+                                                            : "file_print_string_desc",
+                                      "l " + file + ", l " + value);
+                } else if (typeManager_.isFloatingPoint(exprType)) {
+                    if (exprType == BaseType::SINGLE) {
+                        std::string wide = builder_.newTemp();
+                        builder_.emitConvert(wide, "d", "exts", value);
+                        value = wide;
+                    }
+                    builder_.emitCall("", "", "file_print_double", "l " + file + ", d " + value);
+                } else {
+                    if (typeManager_.getQBEType(exprType) == "w") {
+                        std::string wide = builder_.newTemp();
+                        builder_.emitConvert(wide, "l", "extsw", value);
+                        value = wide;
+                    }
+                    builder_.emitCall("", "", "file_print_long", "l " + file + ", l " + value);
+                }
+                releaseNonEscapingTemps();
+            }
+        }
+
+        if (item.comma) {
+            if (stmt->isWrite) {
+                builder_.emitCall("", "", "file_print_char", "l " + file + ", w 44");
+            } else {
+                builder_.emitCall("", "", "file_print_tab", "l " + file);
+            }
+        }
+    }
+
+    if (stmt->trailingNewline) {
+        builder_.emitCall("", "", "file_print_char", "l " + file + ", w 10");
+    }
+}
+
+void ASTEmitter::emitFileInputStatement(const InputStatement* stmt) {
+    builder_.emitComment(std::string(stmt->isLineInput ? "LINE INPUT #" : "INPUT #") +
+                         std::to_string(stmt->fileNumber));
+    std::string file = builder_.newTemp();
+    builder_.emitCall(file, "l", "file_get_handle", "w " + std::to_string(stmt->fileNumber));
+
+    for (const auto& varName : stmt->variables) {
+        BaseType varType = getVariableType(varName);
+        std::string qbeType = typeManager_.getQBEType(varType);
+        std::string value = builder_.newTemp();
+
+        if (typeManager_.isString(varType)) {
+            // The runtime consumes the variable's reference and overwrites
+            // its buffer in place when nothing else shares it, so a read
+            // loop does not allocate a string per line.
+            const char* func = stmt->isLineInput ? "file_line_input" : "file_input_string";
+            std::string target = normalizeVariableName(varName);
+            if (isOwnedStringVariable(target)) {
+                std::string addr = getVariableAddress(target);
+                std::string current = builder_.newTemp();
+                builder_.emitLoad(current, "l", addr);
+                builder_.emitCall(value, "l", func, "l " + file + ", l " + current);
+                builder_.emitStore("l", value, addr);
+            } else {
+                builder_.emitCall(value, "l", func, "l " + file + ", l 0");
+                storeVariable(varName, value);
+                builder_.emitCall("", "", "string_release", "l " + value);
+            }
+            continue;
+        } else if (stmt->isLineInput) {
+            builder_.emitComment("ERROR: LINE INPUT # requires a string variable: " + varName);
+            continue;
+        } else if (typeManager_.isFloatingPoint(varType)) {
+            builder_.emitCall(value, "d", "file_input_double", "l " + file);
+            if (qbeType == "s") {
+                std::string narrow = builder_.newTemp();
+                builder_.emitInstruction(narrow + " =s truncd " + value);
+                value = narrow;
+            }
+        } else if (qbeType == "w" || qbeType == "l") {
+            builder_.emitCall(value, "l", "file_input_long", "l " + file);
+            if (qbeType == "w") {
+                std::string narrow = builder_.newTemp();
+                builder_.emitInstruction(narrow + " =w copy " + value);
+                value = narrow;
+            }
+        } else {
+            builder_.emitComment("ERROR: unsupported variable type for INPUT #: " + varName);
+            continue;
+        }
+
+        storeVariable(varName, value);
+    }
+}
+
+std::string ASTEmitter::emitReadCsvCall(const FunctionCallExpression* expr) {
+    if (expr->arguments.size() < 2) {
+        builder_.emitComment("ERROR: READCSV requires a file number and at least one array");
+        return "0";
+    }
+    builder_.emitComment("READCSV");
+    std::string fileNum = emitExpressionAs(expr->arguments[0].get(), BaseType::INTEGER);
+    std::string file = builder_.newTemp();
+    builder_.emitCall(file, "l", "file_get_handle", "w " + fileNum);
+
+    // Each array becomes one column (a UDT array one per field); the
+    // runtime then fills them all in a single pass over the file.
+    const auto& symbolTable = semantic_.getSymbolTable();
+    for (size_t i = 1; i < expr->arguments.size(); i++) {
+        const Expression* arg = expr->arguments[i].get();
+        if (!isWholeArrayRef(arg)) {
+            builder_.emitComment("ERROR: READCSV arguments after the file number must be arrays, e.g. A()");
+            continue;
+        }
+        const auto* arrRef = static_cast<const ArrayAccessExpression*>(arg);
+        const auto& arraySymbol = symbolTable.arrays.at(arrRef->name);
+
+        std::string arrPtr = builder_.newTemp();
+        builder_.emitLoad(arrPtr, "l", getArrayDescriptorPtr(arrRef->name));
+
+        if (arraySymbol.elementTypeDesc.baseType != BaseType::USER_DEFINED) {
+            builder_.emitCall("", "", "file_column_array", "l " + file + ", l " + arrPtr);
+            continue;
+        }
+
+        // Field kinds in declaration order, as the runtime lays them out
+        auto udtIt = symbolTable.types.find(arraySymbol.elementTypeDesc.udtName);
+        if (udtIt == symbolTable.types.end()) continue;
+        std::string layout;
+        for (const auto& field : udtIt->second.fields) {
+            switch (field.typeDesc.baseType) {
+                case BaseType::BYTE:     case BaseType::UBYTE:    layout += 'b'; break;
+                case BaseType::SHORT:    case BaseType::USHORT:   layout += 'h'; break;
+                case BaseType::INTEGER:  case BaseType::UINTEGER: layout += 'w'; break;
+                case BaseType::LONG:     case BaseType::ULONG:    layout += 'l'; break;
+                case BaseType::SINGLE:   layout += 's'; break;
+                case BaseType::DOUBLE:   layout += 'd'; break;
+                case BaseType::STRING:   case BaseType::UNICODE:  layout += '$'; break;
+                default:
+                    layout.clear();
+                    break;
+            }
+            if (layout.empty()) break;
+        }
+        if (layout.empty()) {
+            builder_.emitComment("ERROR: READCSV supports TYPEs with numeric and string fields only: " +
+                                 arrRef->name);
+            continue;
+        }
+        std::string layoutLabel = builder_.registerString(layout);
+        builder_.emitCall("", "", "file_column_record",
+                          "l " + file + ", l " + arrPtr + ", l $" + layoutLabel);
+    }
+
+    std::string rows = builder_.newTemp();
+    builder_.emitCall(rows, "w", "file_read_columns", "l " + file);
+    return rows;
+}
+
 void ASTEmitter::emitEndStatement(const EndStatement* stmt) {
     // END statement - terminate execution.
     // SAMM: Must shut down scope-aware memory management before exiting
@@ -3401,6 +4207,27 @@ void ASTEmitter::emitEndStatement(const EndStatement* stmt) {
     builder_.emitReturn("0");
 }
 
+void ASTEmitter::emitDefStatement(const DefStatement* stmt) {
+    // The CFG builder places the DEF statement in the evaluation block of
+    // its own FN function; there the expression is the return value.
+    // Anywhere else DEF FN is purely declarative.
+    std::string currentFunc = symbolMapper_.getCurrentFunction();
+    if (!stmt->body || currentFunc != stmt->functionName) {
+        return;
+    }
+
+    const auto& symbolTable = semantic_.getSymbolTable();
+    auto funcIt = symbolTable.functions.find(currentFunc);
+    if (funcIt == symbolTable.functions.end()) {
+        builder_.emitComment("ERROR: DEF FN not found in symbol table");
+        return;
+    }
+
+    BaseType returnType = funcIt->second.returnTypeDesc.baseType;
+    std::string value = emitExpressionAs(stmt->body.get(), returnType);
+    storeVariable(typeManager_.getReturnVariableName(currentFunc, returnType), value);
+}
+
 void ASTEmitter::emitReturnStatement(const ReturnStatement* stmt) {
     // RETURN statement - return from FUNCTION, SUB, or METHOD
     if (stmt->returnValue) {
@@ -3675,16 +4502,16 @@ void ASTEmitter::emitDimStatement(const DimStatement* stmt) {
                         } else if (elemType != FasterBASIC::BaseType::UNKNOWN) {
                             // Typed list without initializer: list_create_typed(elem_flag)
                             // Map BaseType to LIST_FLAG_ELEM_* values from list_ops.h
-                            int elemFlag = 0x00; // LIST_FLAG_ELEM_ANY
+                            int elemFlag = 0x0000; // LIST_FLAG_ELEM_ANY
                             if (elemType == FasterBASIC::BaseType::INTEGER || elemType == FasterBASIC::BaseType::LONG ||
                                 elemType == FasterBASIC::BaseType::BYTE || elemType == FasterBASIC::BaseType::SHORT) {
-                                elemFlag = 0x10; // LIST_FLAG_ELEM_INT
+                                elemFlag = 0x0100; // LIST_FLAG_ELEM_INT
                             } else if (elemType == FasterBASIC::BaseType::DOUBLE || elemType == FasterBASIC::BaseType::SINGLE) {
-                                elemFlag = 0x20; // LIST_FLAG_ELEM_FLOAT
+                                elemFlag = 0x0200; // LIST_FLAG_ELEM_FLOAT
                             } else if (elemType == FasterBASIC::BaseType::STRING) {
-                                elemFlag = 0x30; // LIST_FLAG_ELEM_STRING
+                                elemFlag = 0x0300; // LIST_FLAG_ELEM_STRING
                             } else if (elemType == FasterBASIC::BaseType::OBJECT) {
-                                elemFlag = 0x40; // LIST_FLAG_ELEM_LIST (or OBJECT)
+                                elemFlag = 0x0400; // LIST_FLAG_ELEM_LIST (or OBJECT)
                             }
                             builder_.emitComment("LIST OF " + std::string(
                                 elemType == FasterBASIC::BaseType::INTEGER ? "INTEGER" :
@@ -5214,6 +6041,14 @@ void ASTEmitter::storeVariable(const std::string& varName, const std::string& va
     }
 }
 
+void ASTEmitter::emitStringSlotStore(const std::string& value, const std::string& addr) {
+    // The slot borrows the descriptor, as at any plain pointer store;
+    // string_share only stops the in-place paths from mutating it.
+    std::string sharedPtr = builder_.newTemp();
+    builder_.emitCall(sharedPtr, "l", "string_share", "l " + value);
+    builder_.emitStore("l", sharedPtr, addr);
+}
+
 // === Array Access ===
 
 std::string ASTEmitter::emitArrayAccess(const std::string& arrayName,
@@ -5238,7 +6073,9 @@ std::string ASTEmitter::emitArrayAccess(const std::string& arrayName,
     }
     
     int numIndices = indices.size();
-    builder_.emitComment("Array access: " + arrayName + " (using array_get_address)");
+    bool inlineAccess = numIndices == 1 || numIndices == 2;
+    builder_.emitComment("Array access: " + arrayName +
+                         (inlineAccess ? " (inline)" : " (using array_get_address)"));
     
     // Load the BasicArray* pointer
     std::string arrayPtr = builder_.newTemp();
@@ -5256,36 +6093,215 @@ std::string ASTEmitter::emitArrayAccess(const std::string& arrayName,
         builder_.emitAlloc(indicesArrayPtr, indicesSize);
     }
     
-    // Store each index into the indices array
+    // Evaluate each index and convert it to int32_t (word)
+    std::vector<std::string> indexWords;
+    for (int i = 0; i < numIndices; i++) {
+        std::string indexReg = emitExpression(indices[i].get());
+        std::string indexWord = builder_.newTemp();
+        builder_.emitInstruction(indexWord + " =w copy " + indexReg);
+        indexWords.push_back(indexWord);
+    }
+    
+    // Store the indices into the indices array at offset i*4
+    auto storeIndices = [&]() {
+        for (int i = 0; i < numIndices; i++) {
+            std::string indexAddr = builder_.newTemp();
+            int offset = i * 4;
+            if (offset == 0) {
+                builder_.emitInstruction(indexAddr + " =l copy " + indicesArrayPtr);
+            } else {
+                builder_.emitBinary(indexAddr, "l", "add", indicesArrayPtr, std::to_string(offset));
+            }
+            builder_.emitStore("w", indexWords[i], indexAddr);
+        }
+    };
+    
+    // Decide how each subscript is checked: on every access (FULL),
+    // through the enclosing loop's entry test (PRE_LOOP), or not at all
+    // (NONE, proved by BoundsCheckAnalysis)
+    using CheckKind = BoundsCheckAnalysis::CheckKind;
+    bool useAnalysis = boundsAnalysis_ && currentBlock_ && inlineAccess &&
+                       !inDirectEmitContext_ && !currentClassContext_;
+    std::vector<CheckKind> kinds(numIndices, CheckKind::FULL);
+    std::vector<std::string> preLoopFlags(numIndices);
+    for (int i = 0; i < numIndices; i++) {
+        BoundsCheckRecord record;
+        record.line = currentStatementLine_;
+        record.function = currentFunctionName_.empty() ? "main" : currentFunctionName_;
+        record.array = arrayName;
+        record.dimension = i;
+        if (!inlineAccess) {
+            record.reason = "more than two dimensions";
+        } else if (!useAnalysis) {
+            record.reason = "not emitted from a CFG block";
+        } else {
+            auto check = boundsAnalysis_->classify(currentBlock_, arrayName, i, indices[i].get());
+            record.reason = check.reason;
+            if (check.kind == CheckKind::PRE_LOOP) {
+                auto loopIt = boundsFlags_.find(check.loop->stmt);
+                auto flagIt = loopIt != boundsFlags_.end() ? loopIt->second.find(check.test)
+                                                           : std::map<BoundsCheckAnalysis::PreLoopCheck,
+                                                                      std::string>::const_iterator();
+                if (loopIt != boundsFlags_.end() && flagIt != loopIt->second.end()) {
+                    preLoopFlags[i] = flagIt->second;
+                } else {
+                    check.kind = CheckKind::FULL;
+                    record.reason = "loop has no pre-loop test";
+                }
+            }
+            kinds[i] = check.kind;
+        }
+        record.kind = kinds[i];
+        boundsRecords_.push_back(record);
+    }
+
+    if (!inlineAccess) {
+        // Call array_get_address(BasicArray* array, int32_t* indices)
+        storeIndices();
+        std::string elementPtr = builder_.newTemp();
+        builder_.emitCall(elementPtr, "l", "array_get_address", 
+                         "l " + arrayPtr + ", l " + indicesArrayPtr);
+        return elementPtr;
+    }
+    
+    // --- Inline addressing for 1-D and 2-D arrays ---
+    // BasicArray layout: data@0, element_size@8, bounds@24 (int32 pairs
+    // [lower, upper] per dimension).  Strides are row-major with the last
+    // dimension contiguous, so the 2-D stride is the second extent.
+    // Out-of-range indices branch to a cold call to array_get_address,
+    // which reports the subscript error and does not return; ending that
+    // block in hlt keeps the call out of the enclosing loop, so the
+    // descriptor loads and bounds compares can be hoisted by QBE.
+    // Arrays with a single constant DIM use its bounds as constants.
+    int id = builder_.getNextLabelId();
+    std::string okLabel  = "arr_ok_" + std::to_string(id);
+    std::string oobLabel = "arr_oob_" + std::to_string(id);
+    std::string slowLabel = "arr_chk_" + std::to_string(id);
+    
+    bool staticBounds = boundsAnalysis_ && boundsAnalysis_->isStaticArray(arrayName) &&
+                        static_cast<int>(arraySymbol.dimensions.size()) == numIndices;
+    std::string bounds;
+    if (!staticBounds) {
+        std::string boundsAddr = builder_.newTemp();
+        builder_.emitBinary(boundsAddr, "l", "add", arrayPtr, "24");
+        bounds = builder_.newTemp();
+        builder_.emitLoad(bounds, "l", boundsAddr);
+    }
+    
+    std::vector<std::string> relative, lowers, uppers;
+    auto andInto = [&](std::string& acc, const std::string& value) {
+        if (acc.empty()) {
+            acc = value;
+        } else {
+            std::string both = builder_.newTemp();
+            builder_.emitBinary(both, "w", "and", acc, value);
+            acc = both;
+        }
+    };
+    // Full range test of subscript i against its bounds
+    auto rangeTest = [&](int i) {
+        std::string geLower = builder_.newTemp();
+        builder_.emitCompare(geLower, "w", "sge", indexWords[i], lowers[i]);
+        std::string leUpper = builder_.newTemp();
+        builder_.emitCompare(leUpper, "w", "sle", indexWords[i], uppers[i]);
+        std::string ok = builder_.newTemp();
+        builder_.emitBinary(ok, "w", "and", geLower, leUpper);
+        return ok;
+    };
     for (int i = 0; i < numIndices; i++) {
-        // Evaluate index expression
-        std::string indexReg = emitExpression(indices[i].get());
-        
-        // Convert index to int32_t (word) if needed
-        std::string indexWord = builder_.newTemp();
-        std::string indexType = typeManager_.getQBEType(getExpressionType(indices[i].get()));
-        if (indexType == "l") {
-            // Truncate long to int
-            builder_.emitInstruction(indexWord + " =w copy " + indexReg);
+        std::string lower, upper;
+        if (staticBounds) {
+            lower = "0";
+            upper = std::to_string(arraySymbol.dimensions[i] - 1);
         } else {
-            builder_.emitInstruction(indexWord + " =w copy " + indexReg);
+            std::string lowerAddr = bounds;
+            if (i > 0) {
+                lowerAddr = builder_.newTemp();
+                builder_.emitBinary(lowerAddr, "l", "add", bounds, std::to_string(i * 8));
+            }
+            std::string upperAddr = builder_.newTemp();
+            builder_.emitBinary(upperAddr, "l", "add", bounds, std::to_string(i * 8 + 4));
+            lower = builder_.newTemp();
+            builder_.emitLoad(lower, "w", lowerAddr);
+            upper = builder_.newTemp();
+            builder_.emitLoad(upper, "w", upperAddr);
         }
+        lowers.push_back(lower);
+        uppers.push_back(upper);
         
-        // Store into indices array at offset i*4
-        std::string indexAddr = builder_.newTemp();
-        int offset = i * 4;
-        if (offset == 0) {
-            builder_.emitInstruction(indexAddr + " =l copy " + indicesArrayPtr);
-        } else {
-            builder_.emitBinary(indexAddr, "l", "add", indicesArrayPtr, std::to_string(offset));
+        std::string rel = indexWords[i];
+        if (lower != "0") {
+            rel = builder_.newTemp();
+            builder_.emitBinary(rel, "w", "sub", indexWords[i], lower);
+        }
+        relative.push_back(rel);
+    }
+    
+    // Fast test: pre-loop flags stand in for their subscripts' compares
+    std::string inRange;
+    bool hasPreLoop = false;
+    for (int i = 0; i < numIndices; i++) {
+        if (kinds[i] == CheckKind::PRE_LOOP) {
+            andInto(inRange, preLoopFlags[i]);
+            hasPreLoop = true;
+        } else if (kinds[i] == CheckKind::FULL) {
+            andInto(inRange, rangeTest(i));
+        }
+    }
+    
+    if (!inRange.empty()) {
+        builder_.emitBranch(inRange, okLabel, hasPreLoop ? slowLabel : oobLabel);
+        if (hasPreLoop) {
+            // The loop's range did not fit: check this access on its own
+            builder_.emitLabel(slowLabel);
+            std::string full;
+            for (int i = 0; i < numIndices; i++) {
+                if (kinds[i] != CheckKind::NONE) andInto(full, rangeTest(i));
+            }
+            builder_.emitBranch(full, okLabel, oobLabel);
         }
-        builder_.emitStore("w", indexWord, indexAddr);
+        
+        builder_.emitLabel(oobLabel);
+        storeIndices();
+        builder_.emitCall("", "", "array_get_address", "l " + arrayPtr + ", l " + indicesArrayPtr);
+        builder_.emitRaw("    hlt\n");
+        builder_.emitLabel(okLabel);
     }
     
-    // Call array_get_address(BasicArray* array, int32_t* indices)
+    std::string offset = builder_.newTemp();
+    builder_.emitInstruction(offset + " =l extuw " + relative.back());
+    if (numIndices == 2) {
+        // offset = rel0 * (upper1 - lower1 + 1) + rel1
+        std::string extentL;
+        if (staticBounds) {
+            extentL = std::to_string(arraySymbol.dimensions[1]);
+        } else {
+            std::string span = builder_.newTemp();
+            builder_.emitBinary(span, "w", "sub", uppers[1], lowers[1]);
+            std::string extent = builder_.newTemp();
+            builder_.emitBinary(extent, "w", "add", span, "1");
+            extentL = builder_.newTemp();
+            builder_.emitInstruction(extentL + " =l extuw " + extent);
+        }
+        std::string rel0 = builder_.newTemp();
+        builder_.emitInstruction(rel0 + " =l extuw " + relative[0]);
+        std::string rowOffset = builder_.newTemp();
+        builder_.emitBinary(rowOffset, "l", "mul", rel0, extentL);
+        std::string total = builder_.newTemp();
+        builder_.emitBinary(total, "l", "add", rowOffset, offset);
+        offset = total;
+    }
+    
+    std::string data = builder_.newTemp();
+    builder_.emitLoad(data, "l", arrayPtr);
+    std::string sizeAddr = builder_.newTemp();
+    builder_.emitBinary(sizeAddr, "l", "add", arrayPtr, "8");
+    std::string elementSize = builder_.newTemp();
+    builder_.emitLoad(elementSize, "l", sizeAddr);
+    std::string byteOffset = builder_.newTemp();
+    builder_.emitBinary(byteOffset, "l", "mul", offset, elementSize);
     std::string elementPtr = builder_.newTemp();
-    builder_.emitCall(elementPtr, "l", "array_get_address", 
-                     "l " + arrayPtr + ", l " + indicesArrayPtr);
+    builder_.emitBinary(elementPtr, "l", "add", data, byteOffset);
     
     return elementPtr;
 }
@@ -5317,13 +6333,8 @@ std::string ASTEmitter::loadArrayElement(const std::string& arrayName,
                 
                 std::string keyValue = emitExpressionAs(indices[0].get(), objDesc->subscriptKeyType.baseType);
                 
-                // If key is a string descriptor, extract C string pointer
+                // String keys are passed as the StringDescriptor* itself
                 std::string keyArg = keyValue;
-                if (objDesc->subscriptKeyType.baseType == BaseType::STRING) {
-                    std::string cStringPtr = builder_.newTemp();
-                    builder_.emitCall(cStringPtr, "l", "string_to_utf8", "l " + keyValue);
-                    keyArg = cStringPtr;
-                }
                 
                 // Call the subscript get function from registry
                 std::string resultPtr = builder_.newTemp();
@@ -5388,19 +6399,21 @@ void ASTEmitter::storeArrayElement(const std::string& arrayName,
                 
                 std::string keyValue = emitExpressionAs(indices[0].get(), objDesc->subscriptKeyType.baseType);
                 
-                // If key is a string descriptor, extract C string pointer
+                // String keys are passed as the StringDescriptor* itself
                 std::string keyArg = keyValue;
-                if (objDesc->subscriptKeyType.baseType == BaseType::STRING) {
-                    std::string cStringPtr = builder_.newTemp();
-                    builder_.emitCall(cStringPtr, "l", "string_to_utf8", "l " + keyValue);
-                    keyArg = cStringPtr;
-                }
                 
                 // For now, we'll pass the value directly as a long (pointer or integer)
                 // TODO: Implement proper boxing for different value types
                 std::string valueQBEType = "l"; // Assume pointer for now
+                std::string storedValue = value;
+                
+                // The map owns its string values (released on replace/remove)
+                if (typeManager_.isString(objDesc->subscriptReturnType.baseType)) {
+                    storedValue = builder_.newTemp();
+                    builder_.emitCall(storedValue, "l", "string_retain", "l " + value);
+                }
                 builder_.emitCall("", "l", objDesc->subscriptSetFunction,
-                                "l " + objectPtr + ", l " + keyArg + ", " + valueQBEType + " " + value);
+                                "l " + objectPtr + ", l " + keyArg + ", " + valueQBEType + " " + storedValue);
                 
                 return;
             }
@@ -5420,6 +6433,12 @@ void ASTEmitter::storeArrayElement(const std::string& arrayName,
     
     BaseType elemType = arraySymbol.elementTypeDesc.baseType;
     
+    // String elements borrow the descriptor; see emitStringSlotStore
+    if (typeManager_.isString(elemType)) {
+        emitStringSlotStore(value, elemAddr);
+        return;
+    }
+    
     // Use sub-word store ops for BYTE/SHORT to avoid corrupting adjacent elements
     std::string qbeType, loadOp, storeOp;
     getMemoryLoadStoreOps(elemType, qbeType, loadOp, storeOp);
@@ -5556,7 +6575,9 @@ BaseType ASTEmitter::getExpressionType(const Expression* expr) {
             // Integer functions
             if (upperName == "LEN" || upperName == "ASC" || upperName == "INSTR" ||
                 upperName == "INT" || upperName == "FIX" || upperName == "SGN" ||
-                upperName == "CINT" || upperName == "ERR" || upperName == "ERL") {
+                upperName == "CINT" || upperName == "ERR" || upperName == "ERL" ||
+                upperName == "EOF" || upperName == "READCSV" ||
+                upperName == "LBOUND" || upperName == "UBOUND") {
                 return BaseType::INTEGER;
             }
             
@@ -5565,6 +6586,18 @@ BaseType ASTEmitter::getExpressionType(const Expression* expr) {
                 return getExpressionType(callExpr->arguments[0].get());
             }
             
+            // SUM, MAX, MIN, AVG of a LIST: LONG for integer lists (AVG always
+            // DOUBLE), DOUBLE otherwise — see tryEmitArrayReduction
+            if ((upperName == "SUM" || upperName == "AVG" || upperName == "MAX" || upperName == "MIN") &&
+                callExpr->arguments.size() == 1) {
+                if (const auto* listSym = listVariableOf(callExpr->arguments[0].get())) {
+                    BaseType listElem = listSym->typeDesc.listElementType();
+                    bool intList = (listElem == BaseType::INTEGER || listElem == BaseType::LONG ||
+                                    listElem == BaseType::BYTE || listElem == BaseType::SHORT);
+                    return (intList && upperName != "AVG") ? BaseType::LONG : BaseType::DOUBLE;
+                }
+            }
+            
             // SUM, MAX, MIN, AVG, DOT — array reductions return the element type
             // of the source array (inferred from the argument expression).
             // For 1-arg forms (array reduction), return argument's element type.
@@ -5674,8 +6707,14 @@ BaseType ASTEmitter::getExpressionType(const Expression* expr) {
                                         // else: default INTEGER/LONG from registry
                                     } else if (upperMeth == "JOIN") {
                                         return FasterBASIC::BaseType::STRING;
-                                    } else if (upperMeth == "REST" || upperMeth == "COPY" || upperMeth == "REVERSE") {
+                                    } else if (upperMeth == "REST" || upperMeth == "COPY" || upperMeth == "REVERSE" ||
+                                               upperMeth == "FILTER" || upperMeth == "MAP") {
                                         return FasterBASIC::BaseType::LONG; // ListHeader pointer
+                                    } else if (upperMeth == "SUM" || upperMeth == "MIN" || upperMeth == "MAX") {
+                                        if (listElem != FasterBASIC::BaseType::INTEGER && listElem != FasterBASIC::BaseType::LONG &&
+                                            listElem != FasterBASIC::BaseType::BYTE && listElem != FasterBASIC::BaseType::SHORT) {
+                                            return FasterBASIC::BaseType::DOUBLE;
+                                        }
                                     }
                                 }
                                 return method->returnType;
@@ -6046,15 +7085,16 @@ void ASTEmitter::emitForInit(const ForStatement* stmt) {
     std::string limitVar = "__for_limit_" + stmt->variable;
     std::string stepVar  = "__for_step_" + stmt->variable;
     bool slotsPreAllocated = forLoopTempAddresses_.find(limitVar) != forLoopTempAddresses_.end();
+    std::string limitValue;
+    std::string stepValue;
 
     if (slotsPreAllocated) {
         // Use pre-allocated slots — only emit stores
         std::string limitAddr = forLoopTempAddresses_[limitVar];
-        std::string limitValue = emitExpressionAs(stmt->end.get(), BaseType::INTEGER);
+        limitValue = emitExpressionAs(stmt->end.get(), BaseType::INTEGER);
         builder_.emitRaw("    storew " + limitValue + ", " + limitAddr);
 
         std::string stepAddr = forLoopTempAddresses_[stepVar];
-        std::string stepValue;
         if (stmt->step) {
             stepValue = emitExpressionAs(stmt->step.get(), BaseType::INTEGER);
         } else {
@@ -6067,14 +7107,13 @@ void ASTEmitter::emitForInit(const ForStatement* stmt) {
         // 2. Allocate and initialize limit variable (constant during loop)
         std::string limitAddr = builder_.newTemp();
         builder_.emitRaw("    " + limitAddr + " =l alloc4 4");
-        std::string limitValue = emitExpressionAs(stmt->end.get(), BaseType::INTEGER);
+        limitValue = emitExpressionAs(stmt->end.get(), BaseType::INTEGER);
         builder_.emitRaw("    storew " + limitValue + ", " + limitAddr);
         forLoopTempAddresses_[limitVar] = limitAddr;
 
         // 3. Allocate and initialize step variable (constant during loop, default to 1)
         std::string stepAddr = builder_.newTemp();
         builder_.emitRaw("    " + stepAddr + " =l alloc4 4");
-        std::string stepValue;
         if (stmt->step) {
             stepValue = emitExpressionAs(stmt->step.get(), BaseType::INTEGER);
         } else {
@@ -6084,6 +7123,51 @@ void ASTEmitter::emitForInit(const ForStatement* stmt) {
         builder_.emitRaw("    storew " + stepValue + ", " + stepAddr);
         forLoopTempAddresses_[stepVar] = stepAddr;
     }
+
+    emitPreLoopBoundsChecks(stmt, startValue, limitValue);
+}
+
+void ASTEmitter::emitPreLoopBoundsChecks(const ForStatement* stmt,
+                                         const std::string& startValue,
+                                         const std::string& limitValue) {
+    // One range test per subscript the analysis could not prove: the body
+    // sees every value from the smaller to the larger of start and limit,
+    // so the test covers all iterations.  A failed test only sends the
+    // subscript back to the per-access check, which reports the error.
+    const BoundsCheckAnalysis::InductionLoop* loop =
+        boundsAnalysis_ ? boundsAnalysis_->loopFor(stmt) : nullptr;
+    boundsFlags_.erase(stmt);
+    if (!loop || loop->preLoopChecks.empty()) return;
+
+    std::string lowValue = loop->step > 0 ? startValue : limitValue;
+    std::string highValue = loop->step > 0 ? limitValue : startValue;
+    std::string lowL = builder_.newTemp();
+    builder_.emitInstruction(lowL + " =l extsw " + lowValue);
+    std::string highL = builder_.newTemp();
+    builder_.emitInstruction(highL + " =l extsw " + highValue);
+
+    auto& flags = boundsFlags_[stmt];
+    for (const auto& check : loop->preLoopChecks) {
+        std::string descName = getArrayDescriptorPtr(check.array);
+        if (descName.empty()) continue;
+        builder_.emitComment("Pre-loop range test: " + check.array + " dimension " +
+                             std::to_string(check.dimension + 1));
+        std::string arrayPtr = builder_.newTemp();
+        builder_.emitLoad(arrayPtr, "l", descName);
+        std::string low = lowL;
+        std::string high = highL;
+        if (check.offset != 0) {
+            low = builder_.newTemp();
+            builder_.emitBinary(low, "l", "add", lowL, std::to_string(check.offset));
+            high = builder_.newTemp();
+            builder_.emitBinary(high, "l", "add", highL, std::to_string(check.offset));
+        }
+        std::string flag = builder_.newTemp();
+        builder_.emitCall(flag, "w", "array_range_in_bounds",
+                          "l " + arrayPtr + ", w " + std::to_string(check.dimension + 1) +
+                          ", l " + low + ", l " + high);
+        flags[check] = flag;
+    }
 }
 
 std::string ASTEmitter::emitForCondition(const ForStatement* stmt) {
@@ -6175,6 +7259,13 @@ void ASTEmitter::emitForIncrement(const ForStatement* stmt) {
 //       [idx  = __foreach_idx_<var>]   (if index variable present)
 //       <body>
 //       __foreach_idx_<var> += 1
+//
+// FOR k, v IN map walks the HASHMAP in place with a cursor:
+//   __foreach_cursor_<var> = hashmap_iter_next(map, &__foreach_idx_<var>)
+//   loop while __foreach_cursor_<var> <> NULL:
+//       k = cursor->key  [v = cursor->value]
+//       <body>
+//       __foreach_cursor_<var> = hashmap_iter_next(map, &__foreach_idx_<var>)
 // =============================================================================
 
 // ---------------------------------------------------------------------------
@@ -6350,25 +7441,18 @@ void ASTEmitter::preAllocateForEachSlots(const ForInStatement* stmt) {
         forEachListElemType_[stmt->variable] = elemType;
 
     } else if (isHashmap) {
-        // idx (0-based index, w)
+        // iteration position (l) — advanced by hashmap_iter_next
         std::string idxAddr = builder_.newTemp();
-        builder_.emitRaw("    " + idxAddr + " =l alloc4 4");
-        builder_.emitStore("w", "0", idxAddr);
+        builder_.emitRaw("    " + idxAddr + " =l alloc8 8");
+        builder_.emitStore("l", "0", idxAddr);
         forLoopTempAddresses_[idxVarKey] = idxAddr;
 
-        // upper bound / count (w)
-        std::string ubVar = "__foreach_ub_" + stmt->variable;
-        std::string ubAddr = builder_.newTemp();
-        builder_.emitRaw("    " + ubAddr + " =l alloc4 4");
-        builder_.emitStore("w", "0", ubAddr);
-        forLoopTempAddresses_[ubVar] = ubAddr;
-
-        // keys array pointer (l)
-        std::string keysVar = "__foreach_arr_" + stmt->variable;
-        std::string keysAddr = builder_.newTemp();
-        builder_.emitRaw("    " + keysAddr + " =l alloc8 8");
-        builder_.emitStore("l", "0", keysAddr);
-        forLoopTempAddresses_[keysVar] = keysAddr;
+        // cursor (l) — current entry, NULL when done
+        std::string cursorVar = "__foreach_cursor_" + stmt->variable;
+        std::string cursorAddr = builder_.newTemp();
+        builder_.emitRaw("    " + cursorAddr + " =l alloc8 8");
+        builder_.emitStore("l", "0", cursorAddr);
+        forLoopTempAddresses_[cursorVar] = cursorAddr;
 
         // map pointer (l)
         std::string mapVar = "__foreach_map_" + stmt->variable;
@@ -6557,24 +7641,15 @@ void ASTEmitter::emitForEachInit(const ForInStatement* stmt) {
         // --- Load hashmap pointer ---
         std::string mapPtr = loadVariable(collectionName);
 
-        // --- Call hashmap_keys(map) to get NULL-terminated char** array ---
-        std::string keysArr = builder_.newTemp();
-        builder_.emitCall(keysArr, "l", "hashmap_keys", "l " + mapPtr);
-
-        // --- Call hashmap_size(map) to get entry count ---
-        std::string count = builder_.newTemp();
-        builder_.emitCall(count, "w", "hashmap_size", "l " + mapPtr);
-
+        // Entries are walked in place: hashmap_iter_next(map, &pos) returns
+        // the next entry (key and value together) or NULL, so nothing is
+        // allocated per loop or per key.
+        std::string idxAddr;
+        std::string cursorAddr;
         if (slotsPreAllocated) {
             // Use pre-allocated slots — only emit stores
-            std::string idxAddr = forLoopTempAddresses_["__foreach_idx_" + stmt->variable];
-            builder_.emitStore("w", "0", idxAddr);
-
-            std::string ubAddr = forLoopTempAddresses_["__foreach_ub_" + stmt->variable];
-            builder_.emitStore("w", count, ubAddr);
-
-            std::string keysAddrSlot = forLoopTempAddresses_["__foreach_arr_" + stmt->variable];
-            builder_.emitStore("l", keysArr, keysAddrSlot);
+            idxAddr = forLoopTempAddresses_["__foreach_idx_" + stmt->variable];
+            cursorAddr = forLoopTempAddresses_["__foreach_cursor_" + stmt->variable];
 
             std::string mapAddrSlot = forLoopTempAddresses_["__foreach_map_" + stmt->variable];
             builder_.emitStore("l", mapPtr, mapAddrSlot);
@@ -6583,22 +7658,14 @@ void ASTEmitter::emitForEachInit(const ForInStatement* stmt) {
         } else {
             // Fallback: inline allocs (only safe if init block not in a loop)
             std::string idxVar  = "__foreach_idx_" + stmt->variable;
-            std::string idxAddr = builder_.newTemp();
-            builder_.emitRaw("    " + idxAddr + " =l alloc4 4");
-            builder_.emitStore("w", "0", idxAddr);
+            idxAddr = builder_.newTemp();
+            builder_.emitRaw("    " + idxAddr + " =l alloc8 8");
             forLoopTempAddresses_[idxVar] = idxAddr;
 
-            std::string ubVar  = "__foreach_ub_" + stmt->variable;
-            std::string ubAddr = builder_.newTemp();
-            builder_.emitRaw("    " + ubAddr + " =l alloc4 4");
-            builder_.emitStore("w", count, ubAddr);
-            forLoopTempAddresses_[ubVar] = ubAddr;
-
-            std::string keysVar = "__foreach_arr_" + stmt->variable;
-            std::string keysAddrSlot = builder_.newTemp();
-            builder_.emitRaw("    " + keysAddrSlot + " =l alloc8 8");
-            builder_.emitStore("l", keysArr, keysAddrSlot);
-            forLoopTempAddresses_[keysVar] = keysAddrSlot;
+            std::string cursorVar = "__foreach_cursor_" + stmt->variable;
+            cursorAddr = builder_.newTemp();
+            builder_.emitRaw("    " + cursorAddr + " =l alloc8 8");
+            forLoopTempAddresses_[cursorVar] = cursorAddr;
 
             std::string mapVar = "__foreach_map_" + stmt->variable;
             std::string mapAddrSlot = builder_.newTemp();
@@ -6627,6 +7694,12 @@ void ASTEmitter::emitForEachInit(const ForInStatement* stmt) {
             }
         }
 
+        // --- Position the cursor on the first entry ---
+        builder_.emitStore("l", "0", idxAddr);
+        std::string entry = builder_.newTemp();
+        builder_.emitCall(entry, "l", "hashmap_iter_next", "l " + mapPtr + ", l " + idxAddr);
+        builder_.emitStore("l", entry, cursorAddr);
+
     } else {
         // =================================================================
         // ARRAY iteration
@@ -6723,8 +7796,8 @@ void ASTEmitter::emitForEachInit(const ForInStatement* stmt) {
 }
 
 std::string ASTEmitter::emitForEachCondition(const ForInStatement* stmt) {
-    // --- LIST iteration: cursor != NULL ---
-    if (forEachIsList_.count(stmt->variable)) {
+    // --- LIST / HASHMAP iteration: cursor != NULL ---
+    if (forEachIsList_.count(stmt->variable) || forEachIsHashmap_.count(stmt->variable)) {
         std::string cursorVar = "__foreach_cursor_" + stmt->variable;
         std::string cursorAddr = forLoopTempAddresses_[cursorVar];
         
@@ -6749,19 +7822,12 @@ std::string ASTEmitter::emitForEachCondition(const ForInStatement* stmt) {
     std::string ub = builder_.newTemp();
     builder_.emitRaw("    " + ub + " =w loadw " + ubAddr);
 
-    if (forEachIsHashmap_.count(stmt->variable)) {
-        // Hashmap: 0-based index, condition is idx < count
-        std::string cond = builder_.newTemp();
-        builder_.emitRaw("    " + cond + " =w csltw " + idx + ", " + ub);
-        return cond;
-    } else {
-        // Array: lbound-based index, condition is idx <= ubound
-        std::string gt = builder_.newTemp();
-        builder_.emitRaw("    " + gt + " =w csgtw " + idx + ", " + ub);
-        std::string cond = builder_.newTemp();
-        builder_.emitRaw("    " + cond + " =w xor " + gt + ", 1");
-        return cond;
-    }
+    // Array: lbound-based index, condition is idx <= ubound
+    std::string gt = builder_.newTemp();
+    builder_.emitRaw("    " + gt + " =w csgtw " + idx + ", " + ub);
+    std::string cond = builder_.newTemp();
+    builder_.emitRaw("    " + cond + " =w xor " + gt + ", 1");
+    return cond;
 }
 
 void ASTEmitter::emitForEachIncrement(const ForInStatement* stmt) {
@@ -6793,6 +7859,20 @@ void ASTEmitter::emitForEachIncrement(const ForInStatement* stmt) {
         return;
     }
 
+    // --- HASHMAP iteration: advance cursor to the next entry ---
+    if (forEachIsHashmap_.count(stmt->variable)) {
+        std::string mapAddr = forLoopTempAddresses_["__foreach_map_" + stmt->variable];
+        std::string posAddr = forLoopTempAddresses_["__foreach_idx_" + stmt->variable];
+        std::string cursorAddr = forLoopTempAddresses_["__foreach_cursor_" + stmt->variable];
+
+        std::string mapPtr = builder_.newTemp();
+        builder_.emitRaw("    " + mapPtr + " =l loadl " + mapAddr + "\n");
+        std::string entry = builder_.newTemp();
+        builder_.emitCall(entry, "l", "hashmap_iter_next", "l " + mapPtr + ", l " + posAddr);
+        builder_.emitStore("l", entry, cursorAddr);
+        return;
+    }
+
     std::string idxVar  = "__foreach_idx_" + stmt->variable;
     std::string idxAddr = forLoopTempAddresses_[idxVar];
 
@@ -6897,131 +7977,111 @@ void ASTEmitter::emitForEachBodyPreamble(const ForInStatement* stmt) {
         return;
     }
 
-    // --- Load current index ---
-    std::string idxVar  = "__foreach_idx_" + stmt->variable;
-    std::string idxAddr = forLoopTempAddresses_[idxVar];
-    std::string idx = builder_.newTemp();
-    builder_.emitRaw("    " + idx + " =w loadw " + idxAddr);
-
     if (forEachIsHashmap_.count(stmt->variable)) {
         // =================================================================
-        // HASHMAP body preamble
+        // HASHMAP body preamble: key and value come from the cursor entry
+        // (a HashMapSlot: key at offset 8, value at offset 16).  The loop
+        // variables own their strings like any string variable, so the body
+        // may remove the key or reassign the variables.
         // =================================================================
         builder_.emitComment("FOR EACH body (HASHMAP): load key into " + stmt->variable);
 
-        // --- Load keys array pointer ---
-        std::string keysVar = "__foreach_arr_" + stmt->variable;
-        std::string keysAddrSlot = forLoopTempAddresses_[keysVar];
-        std::string keysArr = builder_.newTemp();
-        builder_.emitRaw("    " + keysArr + " =l loadl " + keysAddrSlot);
-
-        // --- Compute keys[idx]: each pointer is 8 bytes ---
-        std::string idxL = builder_.newTemp();
-        builder_.emitRaw("    " + idxL + " =l extsw " + idx);
-        std::string offset = builder_.newTemp();
-        builder_.emitRaw("    " + offset + " =l mul " + idxL + ", 8");
-        std::string keyPtrAddr = builder_.newTemp();
-        builder_.emitRaw("    " + keyPtrAddr + " =l add " + keysArr + ", " + offset);
-        std::string keyCStr = builder_.newTemp();
-        builder_.emitRaw("    " + keyCStr + " =l loadl " + keyPtrAddr);
-
-        // --- Wrap raw C string as a string descriptor ---
-        std::string keyDesc = builder_.newTemp();
-        builder_.emitCall(keyDesc, "l", "string_new_utf8", "l " + keyCStr);
-
-        // --- Store key descriptor into key variable slot ---
-        std::string varSlotKey = "__foreach_slot_" + stmt->variable;
-        std::string keySlotAddr = forLoopTempAddresses_[varSlotKey];
-        builder_.emitStore("l", keyDesc, keySlotAddr);
+        std::string cursorAddr = forLoopTempAddresses_["__foreach_cursor_" + stmt->variable];
+        std::string entry = builder_.newTemp();
+        builder_.emitRaw("    " + entry + " =l loadl " + cursorAddr);
 
-        // --- If value variable present, call hashmap_lookup ---
+        auto assignFromEntry = [&](const std::string& var, int offset) {
+            std::string fieldAddr = builder_.newTemp();
+            builder_.emitRaw("    " + fieldAddr + " =l add " + entry + ", " + std::to_string(offset));
+            std::string value = builder_.newTemp();
+            builder_.emitRaw("    " + value + " =l loadl " + fieldAddr);
+            std::string slotAddr = forLoopTempAddresses_["__foreach_slot_" + var];
+            std::string oldPtr = builder_.newTemp();
+            builder_.emitRaw("    " + oldPtr + " =l loadl " + slotAddr);
+            std::string retainedPtr = builder_.newTemp();
+            builder_.emitCall(retainedPtr, "l", "string_retain", "l " + value);
+            builder_.emitStore("l", retainedPtr, slotAddr);
+            builder_.emitCall("", "", "string_release", "l " + oldPtr);
+        };
+
+        assignFromEntry(stmt->variable, 8);
         if (!stmt->indexVariable.empty()) {
             builder_.emitComment("FOR EACH body (HASHMAP): load value into " + stmt->indexVariable);
+            assignFromEntry(stmt->indexVariable, 16);
+        }
+        return;
+    }
 
-            // Load hashmap pointer
-            std::string mapVar = "__foreach_map_" + stmt->variable;
-            std::string mapAddrSlot = forLoopTempAddresses_[mapVar];
-            std::string mapPtr = builder_.newTemp();
-            builder_.emitRaw("    " + mapPtr + " =l loadl " + mapAddrSlot);
+    // --- Load current index ---
+    std::string idxVar  = "__foreach_idx_" + stmt->variable;
+    std::string idxAddr = forLoopTempAddresses_[idxVar];
+    std::string idx = builder_.newTemp();
+    builder_.emitRaw("    " + idx + " =w loadw " + idxAddr);
 
-            // Call hashmap_lookup — returns the stored value pointer
-            // For HASHMAP, values are string descriptors (BasicString*)
-            std::string valuePtr = builder_.newTemp();
-            builder_.emitCall(valuePtr, "l", "hashmap_lookup",
-                             "l " + mapPtr + ", l " + keyCStr);
+    // =================================================================
+    // ARRAY body preamble (existing logic)
+    // =================================================================
+    builder_.emitComment("FOR EACH body: load element into " + stmt->variable);
 
-            // Store value pointer into value variable slot
-            std::string valSlotKey = "__foreach_slot_" + stmt->indexVariable;
-            std::string valSlotAddr = forLoopTempAddresses_[valSlotKey];
-            builder_.emitStore("l", valuePtr, valSlotAddr);
+    // --- Store index into user-visible index variable (slot allocated in init) ---
+    if (!stmt->indexVariable.empty()) {
+        std::string idxSlotKey = "__foreach_slot_" + stmt->indexVariable;
+        auto isit = forLoopTempAddresses_.find(idxSlotKey);
+        if (isit != forLoopTempAddresses_.end()) {
+            builder_.emitStore("w", idx, isit->second);
         }
+    }
 
-    } else {
-        // =================================================================
-        // ARRAY body preamble (existing logic)
-        // =================================================================
-        builder_.emitComment("FOR EACH body: load element into " + stmt->variable);
+    // --- Load array descriptor ---
+    std::string arrVar  = "__foreach_arr_" + stmt->variable;
+    std::string arrPtrAddr = forLoopTempAddresses_[arrVar];
+    std::string arrPtr = builder_.newTemp();
+    builder_.emitRaw("    " + arrPtr + " =l loadl " + arrPtrAddr);
 
-        // --- Store index into user-visible index variable (slot allocated in init) ---
-        if (!stmt->indexVariable.empty()) {
-            std::string idxSlotKey = "__foreach_slot_" + stmt->indexVariable;
-            auto isit = forLoopTempAddresses_.find(idxSlotKey);
-            if (isit != forLoopTempAddresses_.end()) {
-                builder_.emitStore("w", idx, isit->second);
-            }
-        }
+    // --- Build single-element indices array (reuse shared buffer) ---
+    std::string indicesPtr;
+    if (!sharedIndicesBuffer_.empty()) {
+        indicesPtr = sharedIndicesBuffer_;
+    } else {
+        indicesPtr = builder_.newTemp();
+        builder_.emitRaw("    " + indicesPtr + " =l alloc4 4");
+    }
+    builder_.emitStore("w", idx, indicesPtr);
 
-        // --- Load array descriptor ---
-        std::string arrVar  = "__foreach_arr_" + stmt->variable;
-        std::string arrPtrAddr = forLoopTempAddresses_[arrVar];
-        std::string arrPtr = builder_.newTemp();
-        builder_.emitRaw("    " + arrPtr + " =l loadl " + arrPtrAddr);
+    // --- Call array_get_address ---
+    std::string elemAddr = builder_.newTemp();
+    builder_.emitCall(elemAddr, "l", "array_get_address",
+                     "l " + arrPtr + ", l " + indicesPtr);
 
-        // --- Build single-element indices array (reuse shared buffer) ---
-        std::string indicesPtr;
-        if (!sharedIndicesBuffer_.empty()) {
-            indicesPtr = sharedIndicesBuffer_;
-        } else {
-            indicesPtr = builder_.newTemp();
-            builder_.emitRaw("    " + indicesPtr + " =l alloc4 4");
-        }
-        builder_.emitStore("w", idx, indicesPtr);
+    // --- Determine element type from the type registered at init time ---
+    BaseType elemType = BaseType::DOUBLE; // default
+    auto feIt = forEachVarTypes_.find(stmt->variable);
+    if (feIt != forEachVarTypes_.end()) {
+        elemType = feIt->second;
+    }
 
-        // --- Call array_get_address ---
-        std::string elemAddr = builder_.newTemp();
-        builder_.emitCall(elemAddr, "l", "array_get_address",
-                         "l " + arrPtr + ", l " + indicesPtr);
+    // --- Load element value and store into loop variable slot ---
+    std::string qbeType = typeManager_.getQBEType(elemType);
+    std::string loadOp;
+    if (qbeType == "w")      loadOp = "loadw";
+    else if (qbeType == "l") loadOp = "loadl";
+    else if (qbeType == "s") loadOp = "loads";
+    else if (qbeType == "d") loadOp = "loadd";
+    else                     loadOp = "loadl"; // pointer-sized fallback
 
-        // --- Determine element type from the type registered at init time ---
-        BaseType elemType = BaseType::DOUBLE; // default
-        auto feIt = forEachVarTypes_.find(stmt->variable);
-        if (feIt != forEachVarTypes_.end()) {
-            elemType = feIt->second;
-        }
+    std::string elemVal = builder_.newTemp();
+    builder_.emitRaw("    " + elemVal + " =" + qbeType + " " + loadOp + " " + elemAddr);
 
-        // --- Load element value and store into loop variable slot ---
-        std::string qbeType = typeManager_.getQBEType(elemType);
-        std::string loadOp;
-        if (qbeType == "w")      loadOp = "loadw";
-        else if (qbeType == "l") loadOp = "loadl";
-        else if (qbeType == "s") loadOp = "loads";
-        else if (qbeType == "d") loadOp = "loadd";
-        else                     loadOp = "loadl"; // pointer-sized fallback
-
-        std::string elemVal = builder_.newTemp();
-        builder_.emitRaw("    " + elemVal + " =" + qbeType + " " + loadOp + " " + elemAddr);
-
-        // The loop variable slot was pre-allocated in emitForEachInit and
-        // registered in forLoopTempAddresses_ / globalVarAddresses_.
-        std::string varSlotKey = "__foreach_slot_" + stmt->variable;
-        std::string slotAddr = forLoopTempAddresses_[varSlotKey];
+    // The loop variable slot was pre-allocated in emitForEachInit and
+    // registered in forLoopTempAddresses_ / globalVarAddresses_.
+    std::string varSlotKey = "__foreach_slot_" + stmt->variable;
+    std::string slotAddr = forLoopTempAddresses_[varSlotKey];
 
-        if (qbeType == "w")      builder_.emitStore("w", elemVal, slotAddr);
-        else if (qbeType == "l") builder_.emitStore("l", elemVal, slotAddr);
-        else if (qbeType == "s") builder_.emitRaw("    stores " + elemVal + ", " + slotAddr);
-        else if (qbeType == "d") builder_.emitRaw("    stored " + elemVal + ", " + slotAddr);
-        else                     builder_.emitStore("l", elemVal, slotAddr);
-    }
+    if (qbeType == "w")      builder_.emitStore("w", elemVal, slotAddr);
+    else if (qbeType == "l") builder_.emitStore("l", elemVal, slotAddr);
+    else if (qbeType == "s") builder_.emitRaw("    stores " + elemVal + ", " + slotAddr);
+    else if (qbeType == "d") builder_.emitRaw("    stored " + elemVal + ", " + slotAddr);
+    else                     builder_.emitStore("l", elemVal, slotAddr);
 }
 
 void ASTEmitter::emitForEachCleanup(const ForInStatement* stmt) {
@@ -7031,30 +8091,22 @@ void ASTEmitter::emitForEachCleanup(const ForInStatement* stmt) {
         return;
     }
     
-    // Only hashmap iteration needs cleanup (free the keys array)
-    if (!forEachIsHashmap_.count(stmt->variable)) {
-        return;
-    }
-    builder_.emitComment("FOR EACH cleanup: free hashmap keys array");
-
-    // Load the keys-array pointer from the pre-allocated slot and free it.
-    std::string keysVar = "__foreach_arr_" + stmt->variable;
-    auto it = forLoopTempAddresses_.find(keysVar);
-    if (it != forLoopTempAddresses_.end()) {
-        std::string keysAddrSlot = it->second;
-        std::string keysArr = builder_.newTemp();
-        builder_.emitLoad(keysArr, "l", keysAddrSlot);
-        // Call free() — returns void, so no result capture
-        builder_.emitRaw("    call $free(l " + keysArr + ")");
+    // HASHMAP iteration walks the map in place: nothing to free
+    if (forEachIsHashmap_.count(stmt->variable)) {
+        builder_.emitComment("FOR EACH HASHMAP cleanup (no-op)");
     }
 }
 
 std::string ASTEmitter::emitIfCondition(const IfStatement* stmt) {
-    return emitExpression(stmt->condition.get());
+    std::string condition = emitNonEscapingExpression(stmt->condition.get());
+    releaseNonEscapingTemps();
+    return condition;
 }
 
 std::string ASTEmitter::emitWhileCondition(const WhileStatement* stmt) {
-    return emitExpression(stmt->condition.get());
+    std::string condition = emitNonEscapingExpression(stmt->condition.get());
+    releaseNonEscapingTemps();
+    return condition;
 }
 
 std::string ASTEmitter::emitDoPreCondition(const DoStatement* stmt) {
@@ -7069,7 +8121,9 @@ std::string ASTEmitter::emitDoPreCondition(const DoStatement* stmt) {
     // Just emit the condition - CFG has already set up edges correctly
     // For DO WHILE: true → body, false → exit
     // For DO UNTIL: true → exit, false → body (CFG reverses edges)
-    return emitExpression(stmt->preCondition.get());
+    std::string condition = emitNonEscapingExpression(stmt->preCondition.get());
+    releaseNonEscapingTemps();
+    return condition;
 }
 
 std::string ASTEmitter::emitLoopPostCondition(const LoopStatement* stmt) {
@@ -7084,7 +8138,9 @@ std::string ASTEmitter::emitLoopPostCondition(const LoopStatement* stmt) {
     // Just emit the condition - CFG has already set up edges correctly
     // For LOOP WHILE: true → body, false → exit
     // For LOOP UNTIL: true → exit, false → body (CFG reverses edges)
-    return emitExpression(stmt->condition.get());
+    std::string condition = emitNonEscapingExpression(stmt->condition.get());
+    releaseNonEscapingTemps();
+    return condition;
 }
 
 void ASTEmitter::emitReadStatement(const ReadStatement* stmt) {
@@ -8013,19 +9069,29 @@ std::string ASTEmitter::emitUDTComparison(
 // String fields are printed with surrounding double-quotes.
 // Nested UDTs are printed recursively.
 // Numeric fields use the normal print routines for their type.
+// With a file handle the same text is written with the PRINT # routines.
 
 void ASTEmitter::emitPrintUDTValue(
         const std::string& udtAddr,
         const FasterBASIC::TypeSymbol& udtDef,
-        const std::unordered_map<std::string, FasterBASIC::TypeSymbol>& udtMap) {
+        const std::unordered_map<std::string, FasterBASIC::TypeSymbol>& udtMap,
+        const std::string& file) {
 
     builder_.emitComment("PRINT UDT " + udtDef.name);
 
+    auto printString = [&](const std::string& desc) {
+        if (file.empty()) {
+            runtime_.emitPrintString(desc);
+        } else {
+            builder_.emitCall("", "", "file_print_string_desc", "l " + file + ", l " + desc);
+        }
+    };
+
     // Print "TypeName("
     std::string openStr = udtDef.name + "(";
     std::string openLabel = builder_.registerString(openStr);
     std::string openDesc = runtime_.emitStringLiteral(openLabel);
-    runtime_.emitPrintString(openDesc);
+    printString(openDesc);
 
     int64_t offset = 0;
     for (size_t i = 0; i < udtDef.fields.size(); ++i) {
@@ -8033,7 +9099,7 @@ void ASTEmitter::emitPrintUDTValue(
         if (i > 0) {
             std::string commaLabel = builder_.registerString(", ");
             std::string commaDesc = runtime_.emitStringLiteral(commaLabel);
-            runtime_.emitPrintString(commaDesc);
+            printString(commaDesc);
         }
 
         const auto& field = udtDef.fields[i];
@@ -8052,21 +9118,21 @@ void ASTEmitter::emitPrintUDTValue(
             // String field: print with surrounding quotes → "value"
             std::string quoteLabel = builder_.registerString("\"");
             std::string quoteDesc = runtime_.emitStringLiteral(quoteLabel);
-            runtime_.emitPrintString(quoteDesc);
+            printString(quoteDesc);
 
             std::string strPtr = builder_.newTemp();
             builder_.emitLoad(strPtr, "l", fieldAddr);
-            runtime_.emitPrintString(strPtr);
+            printString(strPtr);
 
             std::string quoteDesc2 = runtime_.emitStringLiteral(quoteLabel);
-            runtime_.emitPrintString(quoteDesc2);
+            printString(quoteDesc2);
             offset += 8;
 
         } else if (fieldType == BaseType::USER_DEFINED) {
             // Nested UDT: print recursively
             auto nestedIt = udtMap.find(field.typeDesc.udtName);
             if (nestedIt != udtMap.end()) {
-                emitPrintUDTValue(fieldAddr, nestedIt->second, udtMap);
+                emitPrintUDTValue(fieldAddr, nestedIt->second, udtMap, file);
                 offset += typeManager_.getUDTSizeRecursive(nestedIt->second, udtMap);
             } else {
                 builder_.emitComment("PRINT: unknown nested UDT " + field.typeDesc.udtName);
@@ -8079,7 +9145,23 @@ void ASTEmitter::emitPrintUDTValue(
             std::string val = builder_.newTemp();
             builder_.emitLoad(val, qbeType, fieldAddr);
 
-            if (fieldType == BaseType::SINGLE) {
+            if (!file.empty()) {
+                if (typeManager_.isFloatingPoint(fieldType)) {
+                    if (fieldType == BaseType::SINGLE) {
+                        std::string wide = builder_.newTemp();
+                        builder_.emitConvert(wide, "d", "exts", val);
+                        val = wide;
+                    }
+                    builder_.emitCall("", "", "file_print_double", "l " + file + ", d " + val);
+                } else {
+                    if (qbeType == "w") {
+                        std::string wide = builder_.newTemp();
+                        builder_.emitConvert(wide, "l", "extsw", val);
+                        val = wide;
+                    }
+                    builder_.emitCall("", "", "file_print_long", "l " + file + ", l " + val);
+                }
+            } else if (fieldType == BaseType::SINGLE) {
                 // SINGLE: extend to double for printing (basic_print_float
                 // expects single, but let's use the right call)
                 runtime_.emitPrintFloat(val);
@@ -8103,7 +9185,7 @@ void ASTEmitter::emitPrintUDTValue(
     // Print closing ")"
     std::string closeLabel = builder_.registerString(")");
     std::string closeDesc = runtime_.emitStringLiteral(closeLabel);
-    runtime_.emitPrintString(closeDesc);
+    printString(closeDesc);
 
     builder_.emitComment("End PRINT UDT " + udtDef.name);
 }
@@ -9014,6 +10096,363 @@ void ASTEmitter::emitWhileDirect(const FasterBASIC::WhileStatement* stmt) {
     builder_.emitLabel(endLabel);
 }
 
+// =============================================================================
+// PARALLEL FOR
+// =============================================================================
+//
+// PARALLEL FOR i = a TO b [STEP s] [REDUCE op(v), ...] is lowered to
+//
+//   data $parfor_env_N = { a, s, <inputs...>, <accumulators...> }
+//   function $parfor_body_N(l %env, l %first, l %last)   ; deferred
+//   %n =l call $basic_parallel_for($parfor_body_N, $parfor_env_N, a, b, s)
+//
+// The body function runs iterations first..last-1 on private stack copies
+// of every scalar the loop uses (the semantic pass has checked that none
+// of them carries a value between iterations):
+//
+//   - the loop variable, set to a + k * s each iteration
+//   - scalars only read in the body, copied in from the env block
+//   - scalars assigned in the body (and inner FOR variables), zeroed
+//   - REDUCE variables, started at the operator's identity and folded into
+//     the env accumulator when the chunk is done
+//
+// The privates are registered like METHOD locals so the body can be
+// emitted with the direct (non-CFG) statement emitters.  Afterwards the
+// caller copies the accumulators back and leaves the loop variable where
+// the sequential loop would have.
+
+void ASTEmitter::collectParallelScalars(const Expression* expr,
+                                        std::vector<std::string>& names) {
+    if (!expr) return;
+    switch (expr->getType()) {
+        case ASTNodeType::EXPR_VARIABLE:
+            names.push_back(static_cast<const VariableExpression*>(expr)->name);
+            break;
+        case ASTNodeType::EXPR_ARRAY_ACCESS:
+            for (const auto& idx : static_cast<const ArrayAccessExpression*>(expr)->indices) {
+                collectParallelScalars(idx.get(), names);
+            }
+            break;
+        case ASTNodeType::EXPR_BINARY: {
+            const auto* bin = static_cast<const BinaryExpression*>(expr);
+            collectParallelScalars(bin->left.get(), names);
+            collectParallelScalars(bin->right.get(), names);
+            break;
+        }
+        case ASTNodeType::EXPR_UNARY:
+            collectParallelScalars(static_cast<const UnaryExpression*>(expr)->expr.get(), names);
+            break;
+        case ASTNodeType::EXPR_IIF: {
+            const auto* iif = static_cast<const IIFExpression*>(expr);
+            collectParallelScalars(iif->condition.get(), names);
+            collectParallelScalars(iif->trueValue.get(), names);
+            collectParallelScalars(iif->falseValue.get(), names);
+            break;
+        }
+        case ASTNodeType::EXPR_FUNCTION_CALL:
+            for (const auto& arg : static_cast<const FunctionCallExpression*>(expr)->arguments) {
+                collectParallelScalars(arg.get(), names);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void ASTEmitter::collectParallelScalars(const std::vector<StatementPtr>& body,
+                                        std::vector<std::string>& names,
+                                        std::unordered_set<std::string>& written,
+                                        std::unordered_set<std::string>& forVars) {
+    for (const auto& s : body) {
+        if (!s) continue;
+        switch (s->getType()) {
+            case ASTNodeType::STMT_LET: {
+                const auto* let = static_cast<const LetStatement*>(s.get());
+                for (const auto& idx : let->indices) collectParallelScalars(idx.get(), names);
+                collectParallelScalars(let->value.get(), names);
+                if (let->indices.empty()) {
+                    names.push_back(let->variable);
+                    written.insert(normalizeVariableName(let->variable));
+                }
+                break;
+            }
+            case ASTNodeType::STMT_IF: {
+                const auto* ifStmt = static_cast<const IfStatement*>(s.get());
+                collectParallelScalars(ifStmt->condition.get(), names);
+                collectParallelScalars(ifStmt->thenStatements, names, written, forVars);
+                for (const auto& clause : ifStmt->elseIfClauses) {
+                    collectParallelScalars(clause.condition.get(), names);
+                    collectParallelScalars(clause.statements, names, written, forVars);
+                }
+                collectParallelScalars(ifStmt->elseStatements, names, written, forVars);
+                break;
+            }
+            case ASTNodeType::STMT_FOR: {
+                const auto* forStmt = static_cast<const ForStatement*>(s.get());
+                collectParallelScalars(forStmt->start.get(), names);
+                collectParallelScalars(forStmt->end.get(), names);
+                collectParallelScalars(forStmt->step.get(), names);
+                names.push_back(forStmt->variable);
+                forVars.insert(normalizeVariableName(forStmt->variable));
+                collectParallelScalars(forStmt->body, names, written, forVars);
+                break;
+            }
+            case ASTNodeType::STMT_WHILE: {
+                const auto* whileStmt = static_cast<const WhileStatement*>(s.get());
+                collectParallelScalars(whileStmt->condition.get(), names);
+                collectParallelScalars(whileStmt->body, names, written, forVars);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+void ASTEmitter::emitParallelFor(const ForStatement* stmt) {
+    if (!stmt) return;
+
+    int id = builder_.getNextLabelId();
+    std::string bodyName = "parfor_body_" + std::to_string(id);
+    std::string envName  = "$parfor_env_" + std::to_string(id);
+    std::string prefix   = "pfor_" + std::to_string(id);
+
+    builder_.emitComment("PARALLEL FOR " + stmt->variable + " (body: $" + bodyName + ")");
+
+    // --- Classify the scalars the loop uses ---
+    enum class Kind { Loop, Input, Private, Reduce };
+    struct Scalar {
+        std::vector<std::string> rawNames;
+        BaseType type;
+        Kind kind;
+        int op;          // PARALLEL_REDUCE_* for Reduce
+        int offset;      // env offset for Input / Reduce
+        std::string slot;
+    };
+    std::vector<Scalar> scalars;
+    std::unordered_map<std::string, size_t> byName;
+
+    std::vector<std::string> names;
+    std::unordered_set<std::string> written, forVars;
+    names.push_back(stmt->variable);
+    for (const auto& red : stmt->reductions) {
+        names.push_back(static_cast<const VariableExpression*>(red.variable.get())->name);
+    }
+    collectParallelScalars(stmt->body, names, written, forVars);
+
+    std::string loopName = normalizeVariableName(stmt->variable);
+    std::unordered_map<std::string, int> reduceOps;
+    for (const auto& red : stmt->reductions) {
+        int op = red.op == "MIN" ? 1 : red.op == "MAX" ? 2 : 0;
+        reduceOps[normalizeVariableName(static_cast<const VariableExpression*>(red.variable.get())->name)] = op;
+    }
+
+    int envSize = 16;  // start, step
+    for (const auto& raw : names) {
+        std::string name = normalizeVariableName(raw);
+        auto it = byName.find(name);
+        if (it != byName.end()) {
+            auto& known = scalars[it->second].rawNames;
+            if (std::find(known.begin(), known.end(), raw) == known.end()) known.push_back(raw);
+            continue;
+        }
+        Scalar sc;
+        sc.rawNames = {raw};
+        sc.type = getVariableType(raw);
+        sc.op = 0;
+        sc.offset = -1;
+        if (name == loopName) {
+            sc.kind = Kind::Loop;
+        } else if (reduceOps.count(name)) {
+            sc.kind = Kind::Reduce;
+            sc.op = reduceOps[name];
+        } else if (forVars.count(name)) {
+            sc.kind = Kind::Private;
+            sc.type = BaseType::LONG;  // emitForDirect keeps its counter in a LONG
+        } else if (written.count(name)) {
+            sc.kind = Kind::Private;
+        } else {
+            sc.kind = Kind::Input;
+        }
+        if (sc.kind == Kind::Input || sc.kind == Kind::Reduce) {
+            sc.offset = envSize;
+            envSize += 8;
+        }
+        if (name != raw) sc.rawNames.push_back(name);
+        byName[name] = scalars.size();
+        scalars.push_back(std::move(sc));
+    }
+
+    auto envAddr = [&](const std::string& base, int offset) {
+        if (offset == 0) return base;
+        std::string addr = builder_.newTemp();
+        builder_.emitBinary(addr, "l", "add", base, std::to_string(offset));
+        return addr;
+    };
+    auto isFloat = [&](BaseType t) {
+        return t == BaseType::SINGLE || t == BaseType::DOUBLE;
+    };
+
+    // --- Body function ---
+    auto savedParamAddresses = methodParamAddresses_;
+    auto savedParamTypes = methodParamTypes_;
+    auto savedParamClassNames = methodParamClassNames_;
+    auto savedForLoopTemps = forLoopTempAddresses_;
+    auto savedElemCache = arrayElemBaseCache_;
+    std::string savedBounds = sharedBoundsBuffer_;
+    std::string savedIndices = sharedIndicesBuffer_;
+    bool savedDirect = inDirectEmitContext_;
+
+    builder_.beginDeferredFunction();
+    builder_.emitRaw("data " + envName + " = align 8 { z " + std::to_string(envSize) + " }");
+    builder_.emitBlankLine();
+    builder_.emitFunctionStart(bodyName, "", "l %env, l %first, l %last");
+    builder_.emitLabel("start");
+
+    clearMethodParams();
+    forLoopTempAddresses_.clear();
+    arrayElemBaseCache_.clear();
+    sharedBoundsBuffer_.clear();
+    sharedIndicesBuffer_.clear();
+    inDirectEmitContext_ = true;
+    preAllocateSharedBuffers();
+
+    Scalar* loopVar = nullptr;
+    for (auto& sc : scalars) {
+        std::string qbeT = typeManager_.getQBEType(sc.type);
+        sc.slot = builder_.newTemp();
+        builder_.emitRaw("    " + sc.slot + " =l alloc8 8");
+        for (const auto& raw : sc.rawNames) registerMethodParam(raw, sc.slot, sc.type);
+
+        switch (sc.kind) {
+            case Kind::Loop:
+                loopVar = &sc;
+                break;
+            case Kind::Input: {
+                std::string value = builder_.newTemp();
+                builder_.emitLoad(value, qbeT, envAddr("%env", sc.offset));
+                builder_.emitStore(qbeT, value, sc.slot);
+                break;
+            }
+            case Kind::Private:
+                builder_.emitStore("l", "0", sc.slot);
+                break;
+            case Kind::Reduce: {
+                // Identity of the operator: 0 for SUM, the type's largest
+                // value for MIN and its smallest for MAX
+                std::string identity = "0";
+                if (sc.op != 0) {
+                    bool min = sc.op == 1;
+                    if (qbeT == "d")      identity = min ? "d_1.7976931348623157e308" : "d_-1.7976931348623157e308";
+                    else if (qbeT == "s") identity = min ? "s_3.4028234e38" : "s_-3.4028234e38";
+                    else if (qbeT == "l") identity = min ? "9223372036854775807" : "-9223372036854775807";
+                    else                  identity = min ? "2147483647" : "-2147483648";
+                } else if (qbeT == "d" || qbeT == "s") {
+                    identity = qbeT + "_0";
+                }
+                builder_.emitStore(qbeT, identity, sc.slot);
+                break;
+            }
+        }
+    }
+
+    std::string start = builder_.newTemp();
+    builder_.emitLoad(start, "l", "%env");
+    std::string step = builder_.newTemp();
+    builder_.emitLoad(step, "l", envAddr("%env", 8));
+    std::string counter = builder_.newTemp();
+    builder_.emitRaw("    " + counter + " =l alloc8 8");
+    builder_.emitStore("l", "%first", counter);
+    builder_.emitJump(prefix + "_cond");
+
+    builder_.emitLabel(prefix + "_cond");
+    std::string k = builder_.newTemp();
+    builder_.emitLoad(k, "l", counter);
+    std::string more = builder_.newTemp();
+    builder_.emitCompare(more, "l", "slt", k, "%last");
+    builder_.emitBranch(more, prefix + "_body", prefix + "_done");
+
+    builder_.emitLabel(prefix + "_body");
+    std::string scaled = builder_.newTemp();
+    builder_.emitBinary(scaled, "l", "mul", k, step);
+    std::string index = builder_.newTemp();
+    builder_.emitBinary(index, "l", "add", start, scaled);
+    storeVariable(stmt->variable, emitTypeConversion(index, BaseType::LONG, loopVar->type));
+    for (const auto& s : stmt->body) {
+        if (s) emitStatement(s.get());
+    }
+    std::string k2 = builder_.newTemp();
+    builder_.emitLoad(k2, "l", counter);
+    std::string next = builder_.newTemp();
+    builder_.emitBinary(next, "l", "add", k2, "1");
+    builder_.emitStore("l", next, counter);
+    builder_.emitJump(prefix + "_cond");
+
+    builder_.emitLabel(prefix + "_done");
+    for (const auto& sc : scalars) {
+        if (sc.kind != Kind::Reduce) continue;
+        BaseType accType = isFloat(sc.type) ? BaseType::DOUBLE : BaseType::LONG;
+        std::string partial = emitTypeConversion(loadVariable(sc.rawNames.front()), sc.type, accType);
+        std::string acc = envAddr("%env", sc.offset);
+        builder_.emitCall("", "",
+                          accType == BaseType::DOUBLE ? "basic_parallel_reduce_double"
+                                                      : "basic_parallel_reduce_long",
+                          "l " + acc + ", " + (accType == BaseType::DOUBLE ? "d " : "l ") + partial +
+                          ", w " + std::to_string(sc.op));
+    }
+    builder_.emitReturn("");
+    builder_.emitFunctionEnd();
+    builder_.endDeferredFunction();
+
+    methodParamAddresses_ = savedParamAddresses;
+    methodParamTypes_ = savedParamTypes;
+    methodParamClassNames_ = savedParamClassNames;
+    forLoopTempAddresses_ = savedForLoopTemps;
+    arrayElemBaseCache_ = savedElemCache;
+    sharedBoundsBuffer_ = savedBounds;
+    sharedIndicesBuffer_ = savedIndices;
+    inDirectEmitContext_ = savedDirect;
+
+    // --- Caller: fill the env block, run, copy the results back ---
+    std::string startVal = emitExpressionAs(stmt->start.get(), BaseType::LONG);
+    std::string endVal = emitExpressionAs(stmt->end.get(), BaseType::LONG);
+    std::string stepVal = stmt->step ? emitExpressionAs(stmt->step.get(), BaseType::LONG) : "1";
+    builder_.emitStore("l", startVal, envName);
+    builder_.emitStore("l", stepVal, envAddr(envName, 8));
+
+    for (const auto& sc : scalars) {
+        if (sc.kind == Kind::Input) {
+            std::string value = loadVariable(sc.rawNames.front());
+            builder_.emitStore(typeManager_.getQBEType(sc.type), value, envAddr(envName, sc.offset));
+        } else if (sc.kind == Kind::Reduce) {
+            BaseType accType = isFloat(sc.type) ? BaseType::DOUBLE : BaseType::LONG;
+            std::string value = emitTypeConversion(loadVariable(sc.rawNames.front()), sc.type, accType);
+            builder_.emitStore(accType == BaseType::DOUBLE ? "d" : "l", value, envAddr(envName, sc.offset));
+        }
+    }
+
+    std::string count = builder_.newTemp();
+    builder_.emitCall(count, "l", "basic_parallel_for",
+                      "l $" + bodyName + ", l " + envName + ", l " + startVal +
+                      ", l " + endVal + ", l " + stepVal);
+
+    for (const auto& sc : scalars) {
+        if (sc.kind != Kind::Reduce) continue;
+        BaseType accType = isFloat(sc.type) ? BaseType::DOUBLE : BaseType::LONG;
+        std::string acc = builder_.newTemp();
+        builder_.emitLoad(acc, accType == BaseType::DOUBLE ? "d" : "l", envAddr(envName, sc.offset));
+        storeVariable(sc.rawNames.front(), emitTypeConversion(acc, accType, sc.type));
+    }
+
+    // The loop variable ends one step past the last iteration, as it would
+    // after the sequential loop
+    std::string travelled = builder_.newTemp();
+    builder_.emitBinary(travelled, "l", "mul", count, stepVal);
+    std::string finalVal = builder_.newTemp();
+    builder_.emitBinary(finalVal, "l", "add", startVal, travelled);
+    storeVariable(stmt->variable, emitTypeConversion(finalVal, BaseType::LONG, getVariableType(stmt->variable)));
+}
+
 // ===========================================================================
 // Whole-Array Expression Implementation (Phase 4)
 // ===========================================================================
@@ -9053,6 +10492,21 @@ bool ASTEmitter::isWholeArrayRef(const FasterBASIC::Expression* expr) {
     return symbolTable.arrays.count(arr->name) > 0;
 }
 
+// ---------------------------------------------------------------------------
+// listVariableOf — the symbol of a LIST variable expression, or nullptr
+// ---------------------------------------------------------------------------
+const FasterBASIC::VariableSymbol* ASTEmitter::listVariableOf(const FasterBASIC::Expression* expr) {
+    using namespace FasterBASIC;
+    if (!expr || expr->getType() != ASTNodeType::EXPR_VARIABLE) return nullptr;
+    const auto* varExpr = static_cast<const VariableExpression*>(expr);
+    const VariableSymbol* varSym =
+        semantic_.lookupVariableScoped(varExpr->name, symbolMapper_.getCurrentFunction());
+    if (!varSym) {
+        varSym = semantic_.getSymbolTable().lookupVariableLegacy(varExpr->name);
+    }
+    return (varSym && varSym->typeDesc.isList()) ? varSym : nullptr;
+}
+
 // ---------------------------------------------------------------------------
 // getSIMDInfoForArrayElement — construct SIMDInfo for a numeric element type
 // ---------------------------------------------------------------------------
@@ -11290,6 +12744,27 @@ std::string ASTEmitter::tryEmitArrayReduction(
     bool isAVG = (upperFunc == "AVG");
     bool isDOT = (upperFunc == "DOT");
 
+    // SUM/MAX/MIN/AVG of a LIST: the runtime walks it (a typed list chunk
+    // by chunk), integer lists exactly, all others as DOUBLE
+    if ((isSUM || isMAX || isMIN || isAVG) && expr->arguments.size() == 1) {
+        if (const VariableSymbol* listSym = listVariableOf(expr->arguments[0].get())) {
+            BaseType listElem = listSym->typeDesc.listElementType();
+            bool intList = (listElem == BaseType::INTEGER || listElem == BaseType::LONG ||
+                            listElem == BaseType::BYTE || listElem == BaseType::SHORT);
+            std::string func = "list_avg";
+            if (!isAVG) {
+                func = std::string(isSUM ? "list_sum" : isMAX ? "list_max" : "list_min") +
+                       (intList ? "_int" : "_float");
+            }
+            std::string retType = (intList && !isAVG) ? "l" : "d";
+            builder_.emitComment("List reduction: " + upperFunc + "(" + listSym->name + ")");
+            std::string listPtr = emitExpression(expr->arguments[0].get());
+            std::string result = builder_.newTemp();
+            builder_.emitCall(result, retType, func, "l " + listPtr);
+            return result;
+        }
+    }
+
     // SUM/MAX/MIN/AVG take 1 array arg, DOT takes 2
     if (isSUM || isMAX || isMIN || isAVG) {
         if (expr->arguments.size() != 1) return "";
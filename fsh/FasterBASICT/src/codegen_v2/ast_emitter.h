@@ -2,11 +2,14 @@
 #define AST_EMITTER_H
 
 #include <string>
+#include <map>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include "../fasterbasic_ast.h"
 #include "../fasterbasic_semantic.h"
+#include "../fasterbasic_cfg.h"
+#include "../cfg/cfg_bounds_analysis.h"
 #include "qbe_builder.h"
 #include "type_manager.h"
 #include "symbol_mapper.h"
@@ -79,6 +82,65 @@ public:
      */
     bool isSAMMEnabled() const;
 
+    // === SAMM Tracking Elision ===
+
+    /**
+     * Counters for SAMM work that codegen proved unnecessary.
+     * Reported by the driver under --profile.
+     */
+    struct SAMMElisionStats {
+        int functionsAnalyzed = 0;     // SUB/FUNCTION bodies examined
+        int scopesElided = 0;          // ...whose enter/exit scope was skipped
+        int literalTracksElided = 0;   // literal sites emitted untracked
+        int tempsReleased = 0;         // temporaries released at end of statement
+    };
+
+    /**
+     * Decide whether a SUB/FUNCTION body needs its own SAMM scope.
+     * Conservative: returns false only when no statement in the CFG can
+     * create a trackable allocation (strings, lists, objects, UDTs, or
+     * anything the analysis does not understand). Updates the stats.
+     */
+    bool needsSAMMScope(const FasterBASIC::ControlFlowGraph* cfg);
+
+    const SAMMElisionStats& getSAMMElisionStats() const { return sammElision_; }
+    void resetSAMMElisionStats() { sammElision_ = SAMMElisionStats(); }
+
+    // === Bounds-Check Elimination ===
+
+    /**
+     * One array subscript as emitted.  Reported by the driver under
+     * --bce-report.
+     */
+    struct BoundsCheckRecord {
+        int line = 0;
+        std::string function;          // "main" for the main program
+        std::string array;
+        int dimension = 0;             // 0-based
+        FasterBASIC::BoundsCheckAnalysis::CheckKind kind =
+            FasterBASIC::BoundsCheckAnalysis::CheckKind::FULL;
+        std::string reason;            // FULL: why the check stays
+    };
+
+    /**
+     * Use `analysis` to drop or hoist subscript checks inside FOR loops.
+     * nullptr (the default) checks every subscript.
+     */
+    void setBoundsCheckAnalysis(const FasterBASIC::BoundsCheckAnalysis* analysis) {
+        boundsAnalysis_ = analysis;
+    }
+
+    /**
+     * Set the CFG block whose statements are being emitted (nullptr
+     * outside block emission).  Subscripts are classified against it.
+     */
+    void setCurrentBlock(const FasterBASIC::BasicBlock* block, const std::string& functionName) {
+        currentBlock_ = block;
+        currentFunctionName_ = functionName;
+    }
+
+    const std::vector<BoundsCheckRecord>& getBoundsCheckRecords() const { return boundsRecords_; }
+
     // === Expression Emission ===
     
     /**
@@ -207,6 +269,24 @@ public:
      */
     void emitInputStatement(const FasterBASIC::InputStatement* stmt);
     
+    /**
+     * Emit OPEN / CLOSE statements (numbered files)
+     */
+    void emitOpenStatement(const FasterBASIC::OpenStatement* stmt);
+    void emitCloseStatement(const FasterBASIC::CloseStatement* stmt);
+    
+    /**
+     * Emit PRINT # / WRITE # and INPUT # / LINE INPUT # (fileNumber > 0)
+     */
+    void emitFilePrintStatement(const FasterBASIC::PrintStatement* stmt);
+    void emitFileInputStatement(const FasterBASIC::InputStatement* stmt);
+
+    /**
+     * Emit READCSV(n, a(), b$(), ...) — bulk INPUT # into whole arrays
+     * @return QBE word temporary holding the number of rows read
+     */
+    std::string emitReadCsvCall(const FasterBASIC::FunctionCallExpression* expr);
+    
     /**
      * Emit READ statement
      * @param stmt READ statement
@@ -344,6 +424,12 @@ public:
      * @param stmt RETURN statement
      */
     void emitReturnStatement(const FasterBASIC::ReturnStatement* stmt);
+
+    /**
+     * Emit DEF FN statement (the body of a DEF FN function)
+     * @param stmt DEF statement
+     */
+    void emitDefStatement(const FasterBASIC::DefStatement* stmt);
     
     /**
      * Emit DIM statement (array declaration)
@@ -404,6 +490,30 @@ public:
      */
     void storeVariable(const std::string& varName, const std::string& value);
 
+    /**
+     * Store a string into a slot that borrows it (array element, UDT or
+     * CLASS field).  The descriptor goes through string_share first so
+     * that a later S$ = S$ + X$ cannot grow it in place under the slot.
+     * @param value String descriptor to store (temporary)
+     * @param addr Address of the slot
+     */
+    void emitStringSlotStore(const std::string& value, const std::string& addr);
+
+    /**
+     * Emit S$ = S$ + X$ [+ Y$ ...] as in-place appends (string_append)
+     * instead of building a fresh concatenation each time.
+     * @return true if handled, false to fall through to the generic path
+     */
+    bool tryEmitStringSelfAppend(const FasterBASIC::LetStatement* stmt);
+
+    /**
+     * True if `name` is a plain string variable that holds its own
+     * reference, so runtime calls may consume and return it
+     * (string_append, LINE INPUT #) without a retain/release pair.
+     * Parameters, FOR EACH variables and METHOD locals do not qualify.
+     */
+    bool isOwnedStringVariable(const std::string& name);
+
     // === Array Access ===
     
     /**
@@ -646,9 +756,11 @@ private:
     // String fields are printed with surrounding quotes.
     // Nested UDTs are printed recursively.
     // Numeric fields use the appropriate print routine for their type.
+    // With a non-empty file (a FILE handle temp) the value goes to PRINT #.
     void emitPrintUDTValue(const std::string& udtAddr,
                            const FasterBASIC::TypeSymbol& udtDef,
-                           const std::unordered_map<std::string, FasterBASIC::TypeSymbol>& udtMap);
+                           const std::unordered_map<std::string, FasterBASIC::TypeSymbol>& udtMap,
+                           const std::string& file = "");
     
     // === NEON Phase 2: Element-wise UDT arithmetic ===
     // Detects patterns like C = A + B where A, B, C are the same SIMD-eligible
@@ -704,6 +816,12 @@ private:
      */
     bool isWholeArrayRef(const FasterBASIC::Expression* expr);
 
+    /**
+     * If an expression is a plain variable of LIST type, return its
+     * symbol (so SUM(L), MAX(L), ... can reduce it), else nullptr.
+     */
+    const FasterBASIC::VariableSymbol* listVariableOf(const FasterBASIC::Expression* expr);
+
     /**
      * Top-level dispatcher for whole-array expressions.
      * Called from emitLetStatement when the LHS has empty indices and
@@ -836,7 +954,8 @@ private:
 
     /**
      * Try to emit an array reduction function call.
-     * Handles SUM(A()), MAX(A()), MIN(A()), AVG(A()), DOT(A(), B()).
+     * Handles SUM(A()), MAX(A()), MIN(A()), AVG(A()), DOT(A(), B()),
+     * and SUM/MAX/MIN/AVG of a LIST variable (a list runtime call).
      * Returns the QBE temporary holding the scalar result, or "" if
      * the call is not a recognised array reduction.
      */
@@ -907,7 +1026,25 @@ public:
      */
     void emitWhileDirect(const FasterBASIC::WhileStatement* stmt);
 
+    /**
+     * Emit a PARALLEL FOR: the body is outlined to a deferred function
+     * $parfor_body_N(env, first, last) run on the thread pool by
+     * basic_parallel_for (see runtime_c/parallel_runtime.h).
+     */
+    void emitParallelFor(const FasterBASIC::ForStatement* stmt);
+
 private:
+    // === PARALLEL FOR helpers ===
+
+    // Collect the raw names of the scalars a PARALLEL FOR body uses, and the
+    // normalized names of those it assigns (LET targets, inner FOR variables).
+    void collectParallelScalars(const FasterBASIC::Expression* expr,
+                                std::vector<std::string>& names);
+    void collectParallelScalars(const std::vector<FasterBASIC::StatementPtr>& body,
+                                std::vector<std::string>& names,
+                                std::unordered_set<std::string>& written,
+                                std::unordered_set<std::string>& forVars);
+
     // === NEON Phase 3 helpers ===
 
     // Check whether a LetStatement body is a whole-UDT binary op on array
@@ -931,6 +1068,48 @@ private:
     // Helper: get the array descriptor QBE name for an array
     std::string getArrayDescriptorPtr(const std::string& arrayName);
 
+    // === SAMM tracking elision helpers ===
+
+    // True if evaluating the expression may create a SAMM-tracked
+    // allocation (or if the analysis cannot tell).
+    bool expressionMayTrack(const FasterBASIC::Expression* expr);
+
+    // True if executing the statement may create a SAMM-tracked allocation.
+    bool statementMayTrack(const FasterBASIC::Statement* stmt);
+
+    // True if varName is the enclosing FUNCTION's (numeric) return value.
+    bool isNumericReturnAssignment(const std::string& varName);
+
+    // True if every string temporary produced by the expression dies at
+    // the end of the statement: only literals, variables, numbers, string
+    // concatenation/comparison and arithmetic — no calls, no branches.
+    bool isNonEscapingExpression(const FasterBASIC::Expression* expr);
+
+    // Emit a PRINT item / condition.  Non-escaping expressions get their
+    // literals allocated untracked and concatenation results recorded so
+    // releaseNonEscapingTemps() can free them directly.
+    std::string emitNonEscapingExpression(const FasterBASIC::Expression* expr);
+    void releaseNonEscapingTemps();
+
+    bool nonEscapingScope_ = false;
+    std::vector<std::string> nonEscapingTemps_;
+    SAMMElisionStats sammElision_;
+
+    // Bounds-check elimination state (see setBoundsCheckAnalysis)
+    const FasterBASIC::BoundsCheckAnalysis* boundsAnalysis_ = nullptr;
+    const FasterBASIC::BasicBlock* currentBlock_ = nullptr;
+    std::string currentFunctionName_;
+    int currentStatementLine_ = 0;
+    // Pre-loop range test results per loop, keyed by the subscript they cover
+    std::map<const FasterBASIC::ForStatement*,
+             std::map<FasterBASIC::BoundsCheckAnalysis::PreLoopCheck, std::string>> boundsFlags_;
+    std::vector<BoundsCheckRecord> boundsRecords_;
+
+    // Emit the pre-loop range tests of an analysed FOR loop
+    void emitPreLoopBoundsChecks(const FasterBASIC::ForStatement* stmt,
+                                 const std::string& startValue,
+                                 const std::string& limitValue);
+
     // Helper: check if an expression is a simple variable reference
     // to the loop index variable
     bool isLoopIndexVar(const FasterBASIC::Expression* expr,
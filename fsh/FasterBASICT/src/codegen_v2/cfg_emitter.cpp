@@ -32,6 +32,12 @@ void CFGEmitter::setSAMMPreamble(SAMMPreamble type, const std::string& label) {
     sammPreambleLabel_ = label;
 }
 
+bool CFGEmitter::hasSAMMScope() const {
+    // SUB/FUNCTION bodies that allocate nothing trackable are emitted
+    // without SCOPE_ENTER; their exits must not pop a scope either.
+    return sammPreamble_ == SAMMPreamble::SCOPE_ENTER && astEmitter_.isSAMMEnabled();
+}
+
 // =============================================================================
 // Parsing Helpers
 // =============================================================================
@@ -139,6 +145,7 @@ void CFGEmitter::emitCFG(const ControlFlowGraph* cfg, const std::string& functio
         }
     }
     
+    astEmitter_.setCurrentBlock(nullptr, "");
     currentCFG_ = nullptr;
     sammPreamble_ = SAMMPreamble::NONE;
     sammPreambleLabel_.clear();
@@ -152,6 +159,7 @@ void CFGEmitter::emitBlock(const BasicBlock* block, const ControlFlowGraph* cfg)
     }
     
     int blockId = block->id;
+    astEmitter_.setCurrentBlock(block, cfg ? cfg->functionName : "");
     
     // Emit label for this block
     std::string label = getBlockLabel(blockId);
@@ -173,6 +181,12 @@ void CFGEmitter::emitBlock(const BasicBlock* block, const ControlFlowGraph* cfg)
     // The preamble MUST be emitted after the label because QBE requires
     // all instructions to be inside a labeled block.
     if (blockId == 0) {
+        if (currentFunction_ == "main") {
+            // Console buffering must be chosen before anything is printed
+            int outputMode = static_cast<int>(astEmitter_.getSymbolTable().outputMode);
+            builder_.emitComment("Select console output buffering (OPTION OUTPUT)");
+            builder_.emitCall("", "", "basic_output_init", "w " + std::to_string(outputMode));
+        }
         if (sammPreamble_ == SAMMPreamble::MAIN_INIT && astEmitter_.isSAMMEnabled()) {
             builder_.emitComment("SAMM: Initialise scope-aware memory management");
             builder_.emitCall("", "", "samm_init", "");
@@ -504,7 +518,8 @@ void CFGEmitter::emitBlock(const BasicBlock* block, const ControlFlowGraph* cfg)
     {
         const ForStatement* forStmtForSIMD = nullptr;
         for (const Statement* s : block->statements) {
-            if (s && s->getType() == ASTNodeType::STMT_FOR) {
+            if (s && s->getType() == ASTNodeType::STMT_FOR &&
+                !static_cast<const ForStatement*>(s)->parallel) {
                 forStmtForSIMD = static_cast<const ForStatement*>(s);
                 break;
             }
@@ -628,7 +643,7 @@ void CFGEmitter::emitExitBlockTerminator() {
     auto funcIt = symbolTable.functions.find(currentFunction_);
     if (funcIt == symbolTable.functions.end()) {
         // Unknown function — still exit scope to avoid leak
-        if (astEmitter_.isSAMMEnabled()) {
+        if (hasSAMMScope()) {
             builder_.emitComment("SAMM: Exit scope (unknown function)");
             builder_.emitCall("", "", "samm_exit_scope", "");
         }
@@ -644,7 +659,7 @@ void CFGEmitter::emitExitBlockTerminator() {
     // SUBs have VOID return type – just return without a value
     if (returnType == BaseType::VOID) {
         // SAMM: Exit SUB scope before returning
-        if (astEmitter_.isSAMMEnabled()) {
+        if (hasSAMMScope()) {
             builder_.emitComment("SAMM: Exit SUB scope");
             builder_.emitCall("", "", "samm_exit_scope", "");
         }
@@ -664,7 +679,7 @@ void CFGEmitter::emitExitBlockTerminator() {
     // SAMM: If returning a CLASS instance, RETAIN it to the parent scope
     // so it survives the current scope's cleanup. This is essential for
     // factory functions that create and return objects.
-    if (returnType == BaseType::CLASS_INSTANCE && astEmitter_.isSAMMEnabled()) {
+    if (returnType == BaseType::CLASS_INSTANCE && hasSAMMScope()) {
         builder_.emitComment("SAMM: RETAIN returned CLASS instance to parent scope");
         builder_.emitCall("", "", "samm_retain_parent", "l " + retTemp);
     }
@@ -674,14 +689,14 @@ void CFGEmitter::emitExitBlockTerminator() {
     // auto-tracked by SAMM in every scope, so without RETAIN the
     // returned string would be released on scope exit before the caller
     // can use it.
-    if (returnType == BaseType::STRING && astEmitter_.isSAMMEnabled()) {
+    if (returnType == BaseType::STRING && hasSAMMScope()) {
         builder_.emitComment("SAMM: RETAIN returned STRING to parent scope");
         builder_.emitCall("", "", "samm_retain_parent", "l " + retTemp);
     }
 
     // SAMM: Exit FUNCTION scope before returning.
     // Tracked allocations (except RETAINed ones) are queued for cleanup.
-    if (astEmitter_.isSAMMEnabled()) {
+    if (hasSAMMScope()) {
         builder_.emitComment("SAMM: Exit FUNCTION scope");
         builder_.emitCall("", "", "samm_exit_scope", "");
     }
@@ -1184,6 +1199,7 @@ void CFGEmitter::preAllocateAllLoopSlots(const FasterBASIC::ControlFlowGraph* cf
                 astEmitter_.preAllocateForEachSlots(forInStmt);
             } else if (stmt->getType() == FasterBASIC::ASTNodeType::STMT_FOR) {
                 const auto* forStmt = static_cast<const FasterBASIC::ForStatement*>(stmt);
+                if (forStmt->parallel) continue;  // no limit/step slots: see emitParallelFor
                 astEmitter_.preAllocateForSlots(forStmt);
             }
         }
@@ -273,6 +273,12 @@ private:
 
     // === Helper Methods ===
 
+    /**
+     * True if the function being emitted entered a SAMM scope in its
+     * preamble, i.e. its exits must emit samm_exit_scope().
+     */
+    bool hasSAMMScope() const;
+
     /**
      * Scan all blocks in the CFG for FOR and FOR EACH statements and
      * pre-allocate their internal stack slots (limit, step, index, etc.)
@@ -1,4 +1,5 @@
 #include "qbe_builder.h"
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -26,6 +27,8 @@ void QBEBuilder::reset() {
     currentFunction_ = "";
     stringPool_.clear();
     stringCounter_ = 0;
+    savedOutputs_.clear();
+    deferredIL_.clear();
 }
 
 // === Function/Block Structure ===
@@ -441,6 +444,61 @@ void QBEBuilder::emitRaw(const std::string& line) {
     il_ << line << "\n";
 }
 
+// === Deferred Functions ===
+
+void QBEBuilder::beginDeferredFunction() {
+    savedOutputs_.push_back({il_.str(), tempCounter_, inFunction_, currentFunction_});
+    il_.str("");
+    il_.clear();
+    inFunction_ = false;
+    currentFunction_ = "";
+}
+
+void QBEBuilder::endDeferredFunction() {
+    if (savedOutputs_.empty()) {
+        emitComment("WARNING: endDeferredFunction without beginDeferredFunction");
+        return;
+    }
+    // Direct statement emitters (FOR/IF/WHILE outside the CFG) allocate
+    // their slots where they stand; move every alloc into the start block
+    // so QBE sees fixed-size frame slots rather than dynamic allocations.
+    std::istringstream in(il_.str());
+    std::vector<std::string> lines, allocs;
+    std::string line;
+    bool inStart = false;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line[0] == '@') {
+            inStart = (line == "@start");
+        } else if (!inStart && line.find(" =l alloc") != std::string::npos) {
+            allocs.push_back(line);
+            continue;
+        }
+        lines.push_back(line);
+    }
+    auto startIt = std::find(lines.begin(), lines.end(), "@start");
+    if (startIt != lines.end()) {
+        lines.insert(startIt + 1, allocs.begin(), allocs.end());
+    }
+    deferredIL_ += "\n";
+    for (const auto& l : lines) {
+        deferredIL_ += l + "\n";
+    }
+
+    SavedOutput saved = std::move(savedOutputs_.back());
+    savedOutputs_.pop_back();
+    il_.str("");
+    il_.clear();
+    il_ << saved.il;
+    tempCounter_ = saved.tempCounter;
+    inFunction_ = saved.inFunction;
+    currentFunction_ = saved.currentFunction;
+}
+
+void QBEBuilder::emitDeferredFunctions() {
+    il_ << deferredIL_;
+    deferredIL_.clear();
+}
+
 // === Private Helpers ===
 
 void QBEBuilder::emitInstruction(const std::string& instr) {
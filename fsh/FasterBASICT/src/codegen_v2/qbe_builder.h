@@ -304,6 +304,27 @@ public:
      */
     void emitRaw(const std::string& line);
 
+    // === Deferred Functions ===
+    
+    /**
+     * Start building a function while another one is still open
+     * (e.g. the body of a PARALLEL FOR, outlined from its caller).
+     * Emission goes to a fresh buffer until endDeferredFunction().
+     */
+    void beginDeferredFunction();
+    
+    /**
+     * Finish the deferred function: its allocs are moved to its start
+     * block, its IL is queued for emitDeferredFunctions() and emission
+     * returns to the enclosing function where it left off.
+     */
+    void endDeferredFunction();
+    
+    /**
+     * Emit all queued deferred functions at the current (top-level) position
+     */
+    void emitDeferredFunctions();
+
     // === Helper Methods ===
     
     /**
@@ -325,6 +346,16 @@ private:
     bool inFunction_;                // Are we inside a function?
     std::string currentFunction_;    // Current function name
     
+    // Deferred functions (beginDeferredFunction / endDeferredFunction)
+    struct SavedOutput {
+        std::string il;
+        int tempCounter;
+        bool inFunction;
+        std::string currentFunction;
+    };
+    std::vector<SavedOutput> savedOutputs_;  // Enclosing functions, innermost last
+    std::string deferredIL_;                 // Finished deferred functions
+    
     // String constant pool
     std::map<std::string, std::string> stringPool_;  // value -> label
     std::set<std::string> emittedStrings_;            // labels already emitted by emitStringPool()
@@ -50,6 +50,11 @@ std::string QBECodeGeneratorV2::generateProgram(const Program* program,
     // PHASE 1: Collect all string literals from the entire program
     collectStringLiterals(program, programCFG);
     
+    // Prove which array subscripts inside FOR loops stay in bounds
+    boundsAnalysis_ = std::make_unique<BoundsCheckAnalysis>(semantic_.getSymbolTable());
+    boundsAnalysis_->analyze(*programCFG);
+    astEmitter_->setBoundsCheckAnalysis(boundsAnalysis_.get());
+    
     // Emit file header
     emitFileHeader();
     
@@ -88,8 +93,13 @@ std::string QBECodeGeneratorV2::generateProgram(const Program* program,
         // Look up the function symbol from semantic analyzer
         const auto& symbolTable = semantic_.getSymbolTable();
         auto it = symbolTable.functions.find(name);
+        if (it == symbolTable.functions.end() && name.compare(0, 2, "FN") == 0) {
+            // DEF FN bodies are keyed "FN<name>" in the ProgramCFG but
+            // registered under <name> by the semantic analyzer
+            it = symbolTable.functions.find(name.substr(2));
+        }
         const FunctionSymbol* funcSymbol = (it != symbolTable.functions.end()) ? &it->second : nullptr;
-        
+
         if (!funcSymbol) {
             builder_->emitComment("WARNING: Function symbol not found for: " + name);
             continue;
@@ -105,6 +115,10 @@ std::string QBECodeGeneratorV2::generateProgram(const Program* program,
         }
     }
     
+    // Functions outlined while generating the code above
+    // (PARALLEL FOR bodies)
+    builder_->emitDeferredFunctions();
+    
     // Emit any strings that were registered during code generation
     // (e.g. null-check error messages, class method/field names)
     builder_->emitLateStringPool();
@@ -156,8 +170,13 @@ std::string QBECodeGeneratorV2::generateFunction(const FunctionSymbol* funcSymbo
     // (after the @block_0 label). QBE requires all instructions to be
     // inside a labeled block. samm_exit_scope() is emitted by
     // emitExitBlockTerminator() before each exit `ret`.
+    // Bodies that cannot allocate anything trackable skip the scope.
     if (isSAMMEnabled()) {
-        cfgEmitter_->setSAMMPreamble(CFGEmitter::SAMMPreamble::SCOPE_ENTER, "FUNCTION");
+        if (astEmitter_->needsSAMMScope(cfg)) {
+            cfgEmitter_->setSAMMPreamble(CFGEmitter::SAMMPreamble::SCOPE_ENTER, "FUNCTION");
+        } else {
+            builder_->emitComment("SAMM: scope elided (no trackable allocations)");
+        }
     }
     cfgEmitter_->emitCFG(cfg, funcSymbol->name);
     
@@ -211,8 +230,13 @@ std::string QBECodeGeneratorV2::generateSub(const FunctionSymbol* subSymbol,
     // (after the @block_0 label). QBE requires all instructions to be
     // inside a labeled block. samm_exit_scope() is emitted by
     // emitExitBlockTerminator() before each exit `ret`.
+    // Bodies that cannot allocate anything trackable skip the scope.
     if (isSAMMEnabled()) {
-        cfgEmitter_->setSAMMPreamble(CFGEmitter::SAMMPreamble::SCOPE_ENTER, "SUB");
+        if (astEmitter_->needsSAMMScope(cfg)) {
+            cfgEmitter_->setSAMMPreamble(CFGEmitter::SAMMPreamble::SCOPE_ENTER, "SUB");
+        } else {
+            builder_->emitComment("SAMM: scope elided (no trackable allocations)");
+        }
     }
     cfgEmitter_->emitCFG(cfg, subSymbol->name);
     
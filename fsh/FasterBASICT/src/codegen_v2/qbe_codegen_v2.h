@@ -181,6 +181,9 @@ private:
     std::unique_ptr<ASTEmitter> astEmitter_;
     std::unique_ptr<CFGEmitter> cfgEmitter_;
     
+    // FOR-loop subscript ranges, rebuilt per program
+    std::unique_ptr<FasterBASIC::BoundsCheckAnalysis> boundsAnalysis_;
+    
     // Configuration
     bool verbose_;
     bool optimize_;
@@ -55,14 +55,18 @@ std::string RuntimeLibrary::emitStringConcat(const std::string& left, const std:
     return emitRuntimeCall("string_concat", "l", "l " + left + ", l " + right);
 }
 
+std::string RuntimeLibrary::emitStringAppend(const std::string& target, const std::string& suffix) {
+    return emitRuntimeCall("string_append", "l", "l " + target + ", l " + suffix);
+}
+
 std::string RuntimeLibrary::emitStringLen(const std::string& stringPtr) {
     // StringDescriptor layout (string_descriptor.h):
     //   offset 0:  void*   data        (8 bytes)
     //   offset 8:  int64_t length      (8 bytes) — length in characters
-    //   offset 16: int64_t capacity    (8 bytes)
-    //   offset 24: int32_t refcount    (4 bytes)
-    //   offset 28: uint8_t encoding    (1 byte)
+    //   offset 16: int32_t refcount    (4 bytes)
+    //   offset 20: uint8_t encoding    (1 byte)
     //   ...
+    //   offset 24: capacity/utf8_cache, or inline chars (SSO)
     // We load the length field at offset 8.
     
     std::string lengthAddr = builder_.newTemp();
@@ -88,25 +92,30 @@ std::string RuntimeLibrary::emitAsc(const std::string& stringPtr) {
 }
 
 std::string RuntimeLibrary::emitMid(const std::string& stringPtr, const std::string& start, 
-                                   const std::string& length) {
+                                   const std::string& length, bool view) {
+    std::string func = view ? "basic_mid_view" : "basic_mid";
     if (length.empty()) {
         // MID$(s$, start) - to end of string
         // Pass very large length to get remainder
-        return emitRuntimeCall("basic_mid", "l", 
+        return emitRuntimeCall(func, "l", 
             "l " + stringPtr + ", w " + start + ", w " + std::to_string(MID_TO_END_SENTINEL));
     } else {
         // MID$(s$, start, length)
-        return emitRuntimeCall("basic_mid", "l", 
+        return emitRuntimeCall(func, "l", 
             "l " + stringPtr + ", w " + start + ", w " + length);
     }
 }
 
-std::string RuntimeLibrary::emitLeft(const std::string& stringPtr, const std::string& count) {
-    return emitRuntimeCall("basic_left", "l", "l " + stringPtr + ", w " + count);
+std::string RuntimeLibrary::emitLeft(const std::string& stringPtr, const std::string& count,
+                                    bool view) {
+    return emitRuntimeCall(view ? "basic_left_view" : "basic_left", "l",
+                           "l " + stringPtr + ", w " + count);
 }
 
-std::string RuntimeLibrary::emitRight(const std::string& stringPtr, const std::string& count) {
-    return emitRuntimeCall("basic_right", "l", "l " + stringPtr + ", w " + count);
+std::string RuntimeLibrary::emitRight(const std::string& stringPtr, const std::string& count,
+                                     bool view) {
+    return emitRuntimeCall(view ? "basic_right_view" : "basic_right", "l",
+                           "l " + stringPtr + ", w " + count);
 }
 
 std::string RuntimeLibrary::emitUCase(const std::string& stringPtr) {
@@ -133,6 +142,11 @@ std::string RuntimeLibrary::emitStringLiteral(const std::string& stringConstant)
     return emitRuntimeCall("string_new_utf8", "l", "l $" + stringConstant);
 }
 
+std::string RuntimeLibrary::emitStringLiteralTemp(const std::string& stringConstant) {
+    // Same as string_new_utf8, but not registered with the SAMM scope
+    return emitRuntimeCall("string_new_utf8_temp", "l", "l $" + stringConstant);
+}
+
 // === String Lifecycle Management ===
 
 std::string RuntimeLibrary::emitStringClone(const std::string& stringPtr) {
@@ -73,6 +73,14 @@ public:
      */
     std::string emitStringConcat(const std::string& left, const std::string& right);
     
+    /**
+     * Emit an in-place append for S$ = S$ + X$ (string_append)
+     * @param target The variable's current descriptor (reference is consumed)
+     * @param suffix String descriptor to append
+     * @return Temporary holding the descriptor to store back (not retained)
+     */
+    std::string emitStringAppend(const std::string& target, const std::string& suffix);
+    
     /**
      * Emit a LEN() call
      * @param stringPtr String descriptor pointer
@@ -99,26 +107,31 @@ public:
      * @param stringPtr String descriptor pointer
      * @param start Start position (1-based)
      * @param length Length (optional, empty for "to end")
+     * @param view Emit the untracked view form (caller must release it)
      * @return Temporary holding substring descriptor
      */
     std::string emitMid(const std::string& stringPtr, const std::string& start, 
-                       const std::string& length = "");
+                       const std::string& length = "", bool view = false);
     
     /**
      * Emit a LEFT$() call
      * @param stringPtr String descriptor pointer
      * @param count Number of characters
+     * @param view Emit the untracked view form (caller must release it)
      * @return Temporary holding substring descriptor
      */
-    std::string emitLeft(const std::string& stringPtr, const std::string& count);
+    std::string emitLeft(const std::string& stringPtr, const std::string& count,
+                         bool view = false);
     
     /**
      * Emit a RIGHT$() call
      * @param stringPtr String descriptor pointer
      * @param count Number of characters
+     * @param view Emit the untracked view form (caller must release it)
      * @return Temporary holding substring descriptor
      */
-    std::string emitRight(const std::string& stringPtr, const std::string& count);
+    std::string emitRight(const std::string& stringPtr, const std::string& count,
+                          bool view = false);
     
     /**
      * Emit an UCASE$() call (convert to uppercase)
@@ -155,6 +168,14 @@ public:
      * @return Temporary holding string descriptor (l)
      */
     std::string emitStringLiteral(const std::string& stringConstant);
+
+    /**
+     * Emit an untracked string literal for a non-escaping temporary.
+     * The caller must emit a matching string_release after the last use.
+     * @param stringConstant String constant name (e.g., "$str_0")
+     * @return Temporary holding string descriptor (l)
+     */
+    std::string emitStringLiteralTemp(const std::string& stringConstant);
     
     // === String Lifecycle Management ===
     
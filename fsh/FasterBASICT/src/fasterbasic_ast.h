@@ -565,6 +565,7 @@ public:
     };
 
     int fileNumber;  // 0 for console, >0 for file
+    bool isWrite;    // true for WRITE# (quoted strings, comma-separated)
 
     std::vector<PrintItem> items;
     bool trailingNewline;  // false if ends with ; or ,
@@ -574,7 +575,7 @@ public:
     ExpressionPtr formatExpr;               // Format string expression
     std::vector<ExpressionPtr> usingValues; // Values to format
 
-    PrintStatement() : fileNumber(0), trailingNewline(true), hasUsing(false) {}
+    PrintStatement() : fileNumber(0), isWrite(false), trailingNewline(true), hasUsing(false) {}
 
     void addItem(ExpressionPtr expr, bool semicolon, bool comma) {
         items.emplace_back(std::move(expr), semicolon, comma);
@@ -1749,6 +1750,12 @@ public:
 };
 
 // FOR statement
+// REDUCE clause entry of a PARALLEL FOR: REDUCE SUM(total), MAX(peak)
+struct ForReduction {
+    std::string op;                // "SUM", "MIN" or "MAX"
+    ExpressionPtr variable;        // VariableExpression naming the scalar
+};
+
 class ForStatement : public Statement {
 public:
     std::string variable;          // Loop variable name (plain, no suffix)
@@ -1756,6 +1763,8 @@ public:
     ExpressionPtr end;
     ExpressionPtr step;            // nullptr if no STEP clause
     std::vector<StatementPtr> body;  // Loop body statements
+    bool parallel = false;         // PARALLEL FOR: iterations run on the thread pool
+    std::vector<ForReduction> reductions;  // PARALLEL FOR ... REDUCE clause
 
     ForStatement(const std::string& var) : variable(var) {}
 
@@ -1767,7 +1776,7 @@ public:
 
     std::string toString(int indent = 0) const override {
         std::ostringstream oss;
-        oss << makeIndent(indent) << "FOR " << variable << "\n";
+        oss << makeIndent(indent) << (parallel ? "PARALLEL FOR " : "FOR ") << variable << "\n";
         oss << makeIndent(indent + 1) << "Start:\n";
         oss << start->toString(indent + 2);
         oss << makeIndent(indent + 1) << "End:\n";
@@ -1776,6 +1785,10 @@ public:
             oss << makeIndent(indent + 1) << "Step:\n";
             oss << step->toString(indent + 2);
         }
+        for (const auto& red : reductions) {
+            oss << makeIndent(indent + 1) << "Reduce " << red.op << ":\n";
+            oss << red.variable->toString(indent + 2);
+        }
         if (!body.empty()) {
             oss << makeIndent(indent + 1) << "Body:\n";
             for (const auto& stmt : body) {
@@ -2488,7 +2501,8 @@ public:
         ERROR,
         CANCELLABLE,
         BOUNDS_CHECK,
-        SAMM
+        SAMM,
+        OUTPUT
     };
 
     OptionType type;
@@ -2513,6 +2527,7 @@ public:
             case OptionType::CANCELLABLE: oss << "CANCELLABLE"; break;
             case OptionType::BOUNDS_CHECK: oss << "BOUNDS_CHECK"; break;
             case OptionType::SAMM: oss << "SAMM"; break;
+            case OptionType::OUTPUT: oss << (value ? "OUTPUT BUFFERED" : "OUTPUT UNBUFFERED"); break;
         }
         oss << "\n";
         return oss.str();
@@ -43,6 +43,8 @@ void Lexer::initializeKeywords() {
         s_keywords["EACH"] = TokenType::EACH;
         s_keywords["TO"] = TokenType::TO;
         s_keywords["STEP"] = TokenType::STEP;
+        s_keywords["PARALLEL"] = TokenType::PARALLEL;
+        s_keywords["REDUCE"] = TokenType::REDUCE;
         s_keywords["IN"] = TokenType::IN;
         s_keywords["NEXT"] = TokenType::NEXT;
         s_keywords["WHILE"] = TokenType::WHILE;
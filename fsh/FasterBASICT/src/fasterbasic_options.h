@@ -23,6 +23,13 @@ struct CompilerOptions {
         DETECTSTRING   // OPTION DETECTSTRING - detect per-literal (ASCII if all bytes < 128, else Unicode)
     };
     
+    // Console output buffering (values match BASIC_OUTPUT_* in the runtime)
+    enum class OutputMode {
+        AUTO,          // Default - line-buffered on a terminal, block-buffered when redirected
+        BUFFERED,      // OPTION OUTPUT BUFFERED - block-buffered even on a terminal
+        UNBUFFERED     // OPTION OUTPUT UNBUFFERED - flush after every PRINT item
+    };
+    
     // FOR loop variable type
     enum class ForLoopType {
         INTEGER,       // OPTION FOR INTEGER - FOR loop variables are 32-bit integers (w)
@@ -87,6 +94,12 @@ struct CompilerOptions {
     // Default is true (enabled); can also be controlled via ENABLE_NEON_LOOP env var
     bool neonEnabled = true;
     
+    // Console output: OPTION OUTPUT BUFFERED / OPTION OUTPUT UNBUFFERED
+    // AUTO flushes at each newline on a terminal and only when the buffer is
+    // full when output is redirected; buffered output is always flushed
+    // before keyboard input and at program exit
+    OutputMode outputMode = OutputMode::AUTO;
+    
     // Constructor with defaults
     CompilerOptions() = default;
     
@@ -104,6 +117,7 @@ struct CompilerOptions {
         forceYieldEnabled = false;
         forceYieldBudget = 10000;
         neonEnabled = true;
+        outputMode = OutputMode::AUTO;
     }
 };
 
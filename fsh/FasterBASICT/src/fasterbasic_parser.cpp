@@ -93,6 +93,19 @@ bool Parser::match(TokenType type) {
     return false;
 }
 
+bool Parser::matchWord(const char* word) {
+    if (current().type != TokenType::IDENTIFIER) {
+        return false;
+    }
+    std::string upper = current().value;
+    for (auto& c : upper) c = toupper(c);
+    if (upper != word) {
+        return false;
+    }
+    advance();
+    return true;
+}
+
 bool Parser::match(const std::vector<TokenType>& types) {
     for (TokenType type : types) {
         if (check(type)) {
@@ -380,6 +393,14 @@ void Parser::collectOptionsFromTokens() {
                 } else {
                     error("Expected ON or OFF after OPTION NEON");
                 }
+            } else if (matchWord("OUTPUT")) {
+                if (matchWord("BUFFERED")) {
+                    m_options.outputMode = CompilerOptions::OutputMode::BUFFERED;
+                } else if (matchWord("UNBUFFERED")) {
+                    m_options.outputMode = CompilerOptions::OutputMode::UNBUFFERED;
+                } else {
+                    error("Expected BUFFERED or UNBUFFERED after OPTION OUTPUT");
+                }
             } else {
                 error("Unknown OPTION type");
             }
@@ -615,6 +636,18 @@ StatementPtr Parser::parseStatement() {
         return nullptr;
     }
 
+    // Statements that do not record their own location get the position
+    // of their first token (used by diagnostics such as --bce-report)
+    SourceLocation loc = current().location;
+    StatementPtr stmt = parseStatementKind();
+    if (stmt && stmt->location.line == 0) {
+        stmt->location = loc;
+    }
+    return stmt;
+}
+
+StatementPtr Parser::parseStatementKind() {
+
     // Check for label definition: labelname: (identifier/keyword followed by colon)
     // Must be at start of statement (not after an expression)
     if ((current().type == TokenType::IDENTIFIER || current().isKeyword()) && 
@@ -634,6 +667,11 @@ StatementPtr Parser::parseStatement() {
         case TokenType::CONSOLE:
             return parseConsoleStatement();
         case TokenType::INPUT:
+            // "INPUT #n, ..." with a space is the same as INPUT#
+            if (peek().type == TokenType::HASH) {
+                advance(); // consume INPUT; parseInputStreamStatement consumes #
+                return parseInputStreamStatement();
+            }
             return parseInputStatement();
         case TokenType::OPEN:
             return parseOpenStatement();
@@ -729,6 +767,10 @@ StatementPtr Parser::parseStatement() {
                 stmt->setMethodCallExpression(std::move(expr));
                 return stmt;
             }
+            // WRITE #n, ... (WRITE is not a keyword)
+            if (peek().type == TokenType::HASH && matchWord("WRITE")) {
+                return parseWriteStreamStatement();  // consumes #
+            }
             // Fall through to error for bare identifiers
             [[fallthrough]];
         case TokenType::GOTO:
@@ -828,6 +870,8 @@ StatementPtr Parser::parseStatement() {
             return parseMatchTypeStatement();
         case TokenType::FOR:
             return parseForStatement();
+        case TokenType::PARALLEL:
+            return parseParallelForStatement();
         case TokenType::NEXT:
             return parseNextStatement();
         case TokenType::WHILE:
@@ -2668,11 +2712,30 @@ StatementPtr Parser::parseMatchTypeStatement() {
     return stmt;
 }
 
-StatementPtr Parser::parseForStatement() {
+StatementPtr Parser::parseParallelForStatement() {
+    SourceLocation loc = current().location;
+    advance(); // consume PARALLEL
+
+    if (current().type != TokenType::FOR) {
+        error("Expected FOR after PARALLEL");
+        return nullptr;
+    }
+    StatementPtr stmt = parseForStatement(true);
+    if (stmt) {
+        stmt->location = loc;  // for the semantic checks on the loop body
+    }
+    return stmt;
+}
+
+StatementPtr Parser::parseForStatement(bool parallel) {
     advance(); // consume FOR
 
     // Check for VB-style FOR EACH...IN syntax
     if (current().type == TokenType::EACH) {
+        if (parallel) {
+            error("PARALLEL FOR requires FOR var = start TO end");
+            return nullptr;
+        }
         advance(); // consume EACH
 
         if (current().type != TokenType::IDENTIFIER &&
@@ -2817,6 +2880,11 @@ StatementPtr Parser::parseForStatement() {
     
     advance(); // consume identifier (with suffix already stripped from varName)
 
+    if (parallel && current().type != TokenType::EQUAL) {
+        error("PARALLEL FOR requires FOR var = start TO end");
+        return nullptr;
+    }
+
     // Check if this is FOR...IN (without EACH) or traditional FOR...TO
     if (current().type == TokenType::IN) {
         // FOR...IN syntax: FOR var IN array (alternative syntax)
@@ -2968,6 +3036,28 @@ StatementPtr Parser::parseForStatement() {
             stmt->step = parseExpression();
         }
 
+        // PARALLEL FOR: optional REDUCE SUM(x), MIN(y), MAX(z)
+        stmt->parallel = parallel;
+        if (parallel && match(TokenType::REDUCE)) {
+            do {
+                SourceLocation redLocation = current().location;
+                ExpressionPtr clause = parseExpression();
+                auto* call = dynamic_cast<FunctionCallExpression*>(clause.get());
+                std::string op = call ? call->name : "";
+                for (auto& c : op) c = toupper(c);
+                if (!call || (op != "SUM" && op != "MIN" && op != "MAX") ||
+                    call->arguments.size() != 1 ||
+                    !dynamic_cast<VariableExpression*>(call->arguments[0].get())) {
+                    error("Expected SUM(var), MIN(var) or MAX(var) after REDUCE", redLocation);
+                    return nullptr;
+                }
+                ForReduction red;
+                red.op = op;
+                red.variable = std::move(call->arguments[0]);
+                stmt->reductions.push_back(std::move(red));
+            } while (match(TokenType::COMMA));
+        }
+
         // Skip to next line
         if (current().type == TokenType::END_OF_LINE) {
             advance();
@@ -4661,12 +4751,20 @@ StatementPtr Parser::parseOpenStatement() {
     }
 
     // Parse mode (INPUT, OUTPUT, APPEND, RANDOM)
-    // INPUT is a keyword token, others are identifiers
+    // INPUT and APPEND are keyword tokens, others are identifiers
     if (current().type == TokenType::INPUT) {
         stmt->mode = "INPUT";
         advance();
+    } else if (current().type == TokenType::APPEND) {
+        stmt->mode = "APPEND";
+        advance();
     } else if (current().type == TokenType::IDENTIFIER) {
         stmt->mode = current().value;
+        std::transform(stmt->mode.begin(), stmt->mode.end(), stmt->mode.begin(), ::toupper);
+        // Single-letter aliases
+        if (stmt->mode == "I") stmt->mode = "INPUT";
+        else if (stmt->mode == "O") stmt->mode = "OUTPUT";
+        else if (stmt->mode == "A") stmt->mode = "APPEND";
         advance();
     } else {
         error("Expected file mode (INPUT, OUTPUT, APPEND, RANDOM) after FOR");
@@ -4814,6 +4912,7 @@ StatementPtr Parser::parseInputStreamStatement() {
 
 StatementPtr Parser::parseWriteStreamStatement() {
     auto stmt = std::make_unique<PrintStatement>();
+    stmt->isWrite = true;
     advance(); // consume WRITE#
 
     // Parse file number
@@ -4942,8 +5041,18 @@ StatementPtr Parser::parseOptionStatement() {
             error("Expected ON or OFF after OPTION SAMM");
             return nullptr;
         }
+    } else if (matchWord("OUTPUT")) {
+        // Parse BUFFERED/UNBUFFERED for OPTION OUTPUT
+        if (matchWord("BUFFERED")) {
+            return std::make_unique<OptionStatement>(OptionStatement::OptionType::OUTPUT, 1);
+        } else if (matchWord("UNBUFFERED")) {
+            return std::make_unique<OptionStatement>(OptionStatement::OptionType::OUTPUT, 0);
+        } else {
+            error("Expected BUFFERED or UNBUFFERED after OPTION OUTPUT");
+            return nullptr;
+        }
     } else {
-        error("Unknown OPTION type. Expected BITWISE, LOGICAL, BASE, EXPLICIT, UNICODE, ASCII, DETECTSTRING, ERROR, CANCELLABLE, BOUNDS_CHECK, or SAMM");
+        error("Unknown OPTION type. Expected BITWISE, LOGICAL, BASE, EXPLICIT, UNICODE, ASCII, DETECTSTRING, ERROR, CANCELLABLE, BOUNDS_CHECK, SAMM, or OUTPUT");
         return nullptr;
     }
 }
@@ -6862,9 +6971,10 @@ bool Parser::isBuiltinFunction(const std::string& name) const {
         "LEFT$", "RIGHT$", "MID$", "LEFT_STRING", "RIGHT_STRING", "MID_STRING",
         "INSTR", "SPACE$", "STRING$", "UCASE$", "LCASE$", "LTRIM$", "RTRIM$", "TRIM$",
         "UCASE_STRING", "LCASE_STRING", "LTRIM_STRING", "RTRIM_STRING", "TRIM_STRING",
-        "GETTICKS", "LOF", "EOF", "PEEK", "PEEK2", "PEEK4",
+        "GETTICKS", "LOF", "EOF", "READCSV", "PEEK", "PEEK2", "PEEK4",
         "INKEY$", "INKEY_STRING", "CSRLIN", "POS",  // Terminal I/O functions
         "ERR", "ERL",  // Exception handling functions
+        "LBOUND", "UBOUND",  // Array bounds inquiry
         // Add more as needed
     };
     
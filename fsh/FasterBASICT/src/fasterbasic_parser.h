@@ -193,6 +193,7 @@ private:
     bool check(TokenType type) const;
     bool match(TokenType type);
     bool match(const std::vector<TokenType>& types);
+    bool matchWord(const char* word);  // Identifier used as a contextual keyword
     const Token& consume(TokenType type, const std::string& errorMsg);
     
     // Skip to end of line (for error recovery)
@@ -217,6 +218,7 @@ private:
     
     // Statement parsing
     StatementPtr parseStatement();
+    StatementPtr parseStatementKind();
     StatementPtr parsePrintStatement();
     StatementPtr parseConsoleStatement();
     StatementPtr parseInputStatement();
@@ -232,7 +234,8 @@ private:
     StatementPtr parseCaseStatement();
     StatementPtr parseSelectCaseStatement();
     StatementPtr parseMatchTypeStatement();
-    StatementPtr parseForStatement();
+    StatementPtr parseForStatement(bool parallel = false);
+    StatementPtr parseParallelForStatement();
     StatementPtr parseNextStatement();
     StatementPtr parseWhileStatement();
     StatementPtr parseWendStatement();
@@ -11,6 +11,7 @@
 #include "runtime_objects.h"
 
 #include <algorithm>
+#include <iterator>
 #include <sstream>
 #include <cmath>
 #include <iostream>
@@ -322,6 +323,7 @@ bool SemanticAnalyzer::analyze(Program& program, const CompilerOptions& options)
     m_symbolTable.forceYieldBudget = options.forceYieldBudget;
     m_symbolTable.sammEnabled = options.sammEnabled;
     m_symbolTable.neonEnabled = options.neonEnabled;
+    m_symbolTable.outputMode = options.outputMode;
     m_cancellableLoops = options.cancellableLoops;
     
     // Clear control flow stacks
@@ -1943,6 +1945,13 @@ void SemanticAnalyzer::processDefStatement(const DefStatement& stmt) {
     }
     
     m_symbolTable.functions[stmt.functionName] = sym;
+
+    // Return variable, as for FUNCTION (the body is stored into it)
+    Scope funcScope = Scope::makeFunction(stmt.functionName);
+    std::string normalizedReturnVarName = normalizeVariableName(stmt.functionName, sym.returnTypeDesc);
+    VariableSymbol returnVar(normalizedReturnVarName, sym.returnTypeDesc, funcScope, true);
+    returnVar.firstUse = stmt.location;
+    m_symbolTable.insertVariable(normalizedReturnVarName, returnVar);
 }
 
 void SemanticAnalyzer::processConstantStatement(const ConstantStatement& stmt) {
@@ -2074,6 +2083,9 @@ void SemanticAnalyzer::validateStatement(const Statement& stmt) {
         case ASTNodeType::STMT_INPUT:
             validateInputStatement(static_cast<const InputStatement&>(stmt));
             break;
+        case ASTNodeType::STMT_OPEN:
+            validateOpenStatement(static_cast<const OpenStatement&>(stmt));
+            break;
         case ASTNodeType::STMT_INPUT_AT:
             // Check if INPUT AT is being called from within a timer handler
             if (m_inTimerHandler) {
@@ -2470,6 +2482,17 @@ void SemanticAnalyzer::validateInputStatement(const InputStatement& stmt) {
     }
 }
 
+void SemanticAnalyzer::validateOpenStatement(const OpenStatement& stmt) {
+    // The runtime only implements sequential files
+    std::string mode = stmt.mode;
+    std::transform(mode.begin(), mode.end(), mode.begin(), ::toupper);
+    if (mode != "INPUT" && mode != "OUTPUT" && mode != "APPEND") {
+        error(SemanticErrorType::TYPE_ERROR,
+              "OPEN FOR " + mode + " is not supported (use INPUT, OUTPUT or APPEND)",
+              stmt.location);
+    }
+}
+
 void SemanticAnalyzer::validateSliceAssignStatement(const SliceAssignStatement& stmt) {
     // Validate the variable exists and is a string type
     useVariable(stmt.variable, stmt.location);
@@ -2974,6 +2997,291 @@ void SemanticAnalyzer::validateForStatement(const ForStatement& stmt) {
     if (getenv("FASTERBASIC_DEBUG")) {
         std::cerr << "[DEBUG] FOR stack size after pop: " << m_forStack.size() << std::endl;
     }
+
+    if (stmt.parallel) {
+        validateParallelFor(stmt);
+    }
+}
+
+// =============================================================================
+// PARALLEL FOR
+// =============================================================================
+//
+// Iterations of a PARALLEL FOR run concurrently, each on private copies of
+// the scalars the body uses, so the body must not depend on what another
+// iteration did to a scalar:
+//
+//   - a scalar assigned in the body must be assigned before it is read,
+//     on every path through the iteration (otherwise it carries a value
+//     from one iteration to the next), unless it is a REDUCE variable
+//   - the loop variable is read-only
+//   - only numeric code: assignments, IF, FOR and WHILE over numeric
+//     scalars, numeric arrays and the built-in math functions (no I/O,
+//     strings, objects, calls or jumps)
+//
+// Arrays are shared; iterations writing the same element is a race the
+// program has to avoid, as with any data-parallel loop.
+
+std::string SemanticAnalyzer::parallelScalarName(const std::string& name) {
+    const VariableSymbol* sym = lookupVariable(name);
+    return sym ? sym->name : name;
+}
+
+void SemanticAnalyzer::parallelError(ParallelScan& scan, const std::string& message) {
+    if (scan.failed) return;  // one error per loop; the rest would cascade
+    scan.failed = true;
+    error(SemanticErrorType::PARALLEL_ERROR, "PARALLEL FOR: " + message, scan.location);
+}
+
+void SemanticAnalyzer::collectParallelWrites(const std::vector<StatementPtr>& body,
+                                             std::set<std::string>& written) {
+    for (const auto& stmt : body) {
+        if (!stmt) continue;
+        switch (stmt->getType()) {
+            case ASTNodeType::STMT_LET: {
+                const auto& let = static_cast<const LetStatement&>(*stmt);
+                if (let.indices.empty() && let.memberChain.empty()) {
+                    written.insert(parallelScalarName(let.variable));
+                }
+                break;
+            }
+            case ASTNodeType::STMT_IF: {
+                const auto& ifStmt = static_cast<const IfStatement&>(*stmt);
+                collectParallelWrites(ifStmt.thenStatements, written);
+                for (const auto& clause : ifStmt.elseIfClauses) {
+                    collectParallelWrites(clause.statements, written);
+                }
+                collectParallelWrites(ifStmt.elseStatements, written);
+                break;
+            }
+            case ASTNodeType::STMT_FOR: {
+                const auto& forStmt = static_cast<const ForStatement&>(*stmt);
+                written.insert(parallelScalarName(forStmt.variable));
+                collectParallelWrites(forStmt.body, written);
+                break;
+            }
+            case ASTNodeType::STMT_WHILE:
+                collectParallelWrites(static_cast<const WhileStatement&>(*stmt).body, written);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void SemanticAnalyzer::validateParallelFor(const ForStatement& stmt) {
+    ParallelScan scan;
+    scan.location = stmt.location;
+    scan.loopVariable = parallelScalarName(stmt.variable);
+    collectParallelWrites(stmt.body, scan.written);
+
+    for (const auto& red : stmt.reductions) {
+        const auto& var = static_cast<const VariableExpression&>(*red.variable);
+        validateExpression(var);
+        std::string name = parallelScalarName(var.name);
+        if (name == scan.loopVariable) {
+            parallelError(scan, "cannot REDUCE the loop variable '" + stmt.variable + "'");
+        } else if (!isNumericType(inferExpressionType(var)) || lookupArray(var.name)) {
+            parallelError(scan, "REDUCE variable '" + var.name + "' must be a numeric scalar");
+        } else if (!scan.reductions.insert(name).second) {
+            parallelError(scan, "'" + var.name + "' appears twice in REDUCE");
+        }
+    }
+
+    std::set<std::string> assigned;
+    checkParallelStatements(stmt.body, scan, assigned);
+}
+
+void SemanticAnalyzer::checkParallelStatements(const std::vector<StatementPtr>& body,
+                                               ParallelScan& scan,
+                                               std::set<std::string>& assigned) {
+    for (const auto& stmt : body) {
+        if (!stmt || scan.failed) continue;
+        switch (stmt->getType()) {
+            case ASTNodeType::STMT_REM:
+                break;
+
+            case ASTNodeType::STMT_LET: {
+                const auto& let = static_cast<const LetStatement&>(*stmt);
+                if (!let.memberChain.empty()) {
+                    parallelError(scan, "cannot assign to a member ('" + let.variable + "." +
+                                        let.memberChain.front() + "')");
+                    break;
+                }
+                for (const auto& index : let.indices) {
+                    checkParallelExpression(index.get(), scan, assigned);
+                }
+                checkParallelExpression(let.value.get(), scan, assigned);
+                if (!let.indices.empty()) {
+                    const ArraySymbol* arr = lookupArray(let.variable);
+                    if (!arr || !arr->elementTypeDesc.isNumeric()) {
+                        parallelError(scan, "'" + let.variable + "' is not a numeric array");
+                    }
+                    break;
+                }
+                std::string name = parallelScalarName(let.variable);
+                const VariableSymbol* sym = lookupVariable(let.variable);
+                if (name == scan.loopVariable) {
+                    parallelError(scan, "cannot assign the loop variable '" + let.variable + "'");
+                } else if (lookupArray(let.variable) || (sym && !sym->typeDesc.isNumeric())) {
+                    parallelError(scan, "'" + let.variable + "' is not a numeric scalar");
+                }
+                assigned.insert(name);
+                break;
+            }
+
+            case ASTNodeType::STMT_IF: {
+                const auto& ifStmt = static_cast<const IfStatement&>(*stmt);
+                if (ifStmt.hasGoto) {
+                    parallelError(scan, "cannot jump out of the loop body");
+                    break;
+                }
+                checkParallelExpression(ifStmt.condition.get(), scan, assigned);
+                // A scalar is assigned after the IF only if every branch
+                // assigns it; without ELSE the fall-through path assigns nothing.
+                std::set<std::string> merged;
+                {
+                    std::set<std::string> branch = assigned;
+                    checkParallelStatements(ifStmt.thenStatements, scan, branch);
+                    merged = branch;
+                }
+                for (const auto& clause : ifStmt.elseIfClauses) {
+                    checkParallelExpression(clause.condition.get(), scan, assigned);
+                    std::set<std::string> branch = assigned;
+                    checkParallelStatements(clause.statements, scan, branch);
+                    std::set<std::string> both;
+                    std::set_intersection(merged.begin(), merged.end(), branch.begin(), branch.end(),
+                                          std::inserter(both, both.begin()));
+                    merged.swap(both);
+                }
+                if (!ifStmt.elseStatements.empty()) {
+                    std::set<std::string> branch = assigned;
+                    checkParallelStatements(ifStmt.elseStatements, scan, branch);
+                    std::set<std::string> both;
+                    std::set_intersection(merged.begin(), merged.end(), branch.begin(), branch.end(),
+                                          std::inserter(both, both.begin()));
+                    merged.swap(both);
+                    assigned.swap(merged);
+                }
+                break;
+            }
+
+            case ASTNodeType::STMT_FOR: {
+                const auto& forStmt = static_cast<const ForStatement&>(*stmt);
+                if (forStmt.parallel) {
+                    parallelError(scan, "PARALLEL FOR cannot be nested");
+                    break;
+                }
+                checkParallelExpression(forStmt.start.get(), scan, assigned);
+                checkParallelExpression(forStmt.end.get(), scan, assigned);
+                checkParallelExpression(forStmt.step.get(), scan, assigned);
+                std::string name = parallelScalarName(forStmt.variable);
+                if (name == scan.loopVariable) {
+                    parallelError(scan, "cannot reuse the loop variable '" + forStmt.variable + "'");
+                    break;
+                }
+                assigned.insert(name);
+                // The inner body may run zero times: what it assigns is
+                // not assigned after the loop.
+                std::set<std::string> inner = assigned;
+                checkParallelStatements(forStmt.body, scan, inner);
+                break;
+            }
+
+            case ASTNodeType::STMT_WHILE: {
+                const auto& whileStmt = static_cast<const WhileStatement&>(*stmt);
+                checkParallelExpression(whileStmt.condition.get(), scan, assigned);
+                std::set<std::string> inner = assigned;
+                checkParallelStatements(whileStmt.body, scan, inner);
+                break;
+            }
+
+            default:
+                parallelError(scan, "the loop body can only contain assignments, IF, FOR and WHILE");
+                break;
+        }
+    }
+}
+
+void SemanticAnalyzer::checkParallelExpression(const Expression* expr, ParallelScan& scan,
+                                               const std::set<std::string>& assigned) {
+    if (!expr || scan.failed) return;
+
+    switch (expr->getType()) {
+        case ASTNodeType::EXPR_NUMBER:
+            return;
+
+        case ASTNodeType::EXPR_VARIABLE: {
+            const auto& var = static_cast<const VariableExpression&>(*expr);
+            if (lookupArray(var.name) || !isNumericType(inferExpressionType(var))) {
+                parallelError(scan, "'" + var.name + "' is not a numeric scalar");
+                return;
+            }
+            std::string name = parallelScalarName(var.name);
+            if (scan.written.count(name) && !scan.reductions.count(name) && !assigned.count(name)) {
+                parallelError(scan, "'" + var.name + "' is read before it is assigned in the loop "
+                                    "body, so it carries a value between iterations; assign it "
+                                    "first or declare it with REDUCE");
+            }
+            return;
+        }
+
+        case ASTNodeType::EXPR_ARRAY_ACCESS: {
+            const auto& access = static_cast<const ArrayAccessExpression&>(*expr);
+            const ArraySymbol* arr = lookupArray(access.name);
+            if (!arr || !arr->elementTypeDesc.isNumeric()) {
+                parallelError(scan, "'" + access.name + "' is not a numeric array");
+                return;
+            }
+            for (const auto& index : access.indices) {
+                checkParallelExpression(index.get(), scan, assigned);
+            }
+            return;
+        }
+
+        case ASTNodeType::EXPR_BINARY: {
+            const auto& bin = static_cast<const BinaryExpression&>(*expr);
+            checkParallelExpression(bin.left.get(), scan, assigned);
+            checkParallelExpression(bin.right.get(), scan, assigned);
+            return;
+        }
+
+        case ASTNodeType::EXPR_UNARY:
+            checkParallelExpression(static_cast<const UnaryExpression&>(*expr).expr.get(), scan, assigned);
+            return;
+
+        case ASTNodeType::EXPR_IIF: {
+            const auto& iif = static_cast<const IIFExpression&>(*expr);
+            checkParallelExpression(iif.condition.get(), scan, assigned);
+            checkParallelExpression(iif.trueValue.get(), scan, assigned);
+            checkParallelExpression(iif.falseValue.get(), scan, assigned);
+            return;
+        }
+
+        case ASTNodeType::EXPR_FUNCTION_CALL: {
+            // Pure numeric built-ins only (RND shares its generator state)
+            static const std::set<std::string> pure = {
+                "ABS", "SIN", "COS", "TAN", "ATAN", "ATN", "SQRT", "SQR", "INT", "SGN",
+                "LOG", "EXP", "POW", "ATAN2", "MIN", "MAX", "FIX", "CINT"
+            };
+            const auto* call = dynamic_cast<const FunctionCallExpression*>(expr);
+            std::string name = call ? call->name : "";
+            for (auto& c : name) c = toupper(c);
+            if (!call || call->isFN || !pure.count(name) || lookupFunction(call->name)) {
+                parallelError(scan, "the loop body can only call built-in math functions");
+                return;
+            }
+            for (const auto& arg : call->arguments) {
+                checkParallelExpression(arg.get(), scan, assigned);
+            }
+            return;
+        }
+
+        default:
+            parallelError(scan, "the loop body can only use numeric scalars, numeric arrays "
+                                "and built-in math functions");
+            return;
+    }
 }
 
 void SemanticAnalyzer::validateForInStatement(ForInStatement& stmt) {
@@ -3991,6 +4299,28 @@ VariableType SemanticAnalyzer::inferArrayAccessType(const ArrayAccessExpression&
 }
 
 VariableType SemanticAnalyzer::inferFunctionCallType(const FunctionCallExpression& expr) {
+    // LBOUND(a [, dim]) / UBOUND(a [, dim]) take an array, written a or a()
+    std::string upperCall = expr.name;
+    std::transform(upperCall.begin(), upperCall.end(), upperCall.begin(), ::toupper);
+    if (!expr.isFN && (upperCall == "LBOUND" || upperCall == "UBOUND") && !lookupFunction(expr.name)) {
+        const Expression* arrayArg = expr.arguments.empty() ? nullptr : expr.arguments[0].get();
+        std::string arrayName;
+        if (arrayArg && arrayArg->getType() == ASTNodeType::EXPR_VARIABLE) {
+            arrayName = static_cast<const VariableExpression*>(arrayArg)->name;
+        } else if (arrayArg && arrayArg->getType() == ASTNodeType::EXPR_ARRAY_ACCESS &&
+                   static_cast<const ArrayAccessExpression*>(arrayArg)->indices.empty()) {
+            arrayName = static_cast<const ArrayAccessExpression*>(arrayArg)->name;
+        }
+        if (expr.arguments.size() > 2 || arrayName.empty() || !lookupArray(arrayName)) {
+            error(SemanticErrorType::TYPE_MISMATCH,
+                  upperCall + " expects an array and an optional dimension",
+                  expr.location);
+        } else if (expr.arguments.size() == 2) {
+            validateExpression(*expr.arguments[1]);
+        }
+        return VariableType::INT;
+    }
+
     // Validate arguments
     for (const auto& arg : expr.arguments) {
         validateExpression(*arg);
@@ -4094,7 +4424,8 @@ VariableType SemanticAnalyzer::inferFunctionCallType(const FunctionCallExpressio
         // Functions that return INT
         if (upperName == "FIX" || upperName == "CINT" || upperName == "INT" ||
             upperName == "SGN" || upperName == "ASC" || upperName == "INSTR" ||
-            upperName == "LEN" || upperName == "STRTYPE") {
+            upperName == "LEN" || upperName == "STRTYPE" ||
+            upperName == "LBOUND" || upperName == "UBOUND") {
             return VariableType::INT;
         }
         
@@ -4915,6 +5246,7 @@ void SemanticAnalyzer::initializeBuiltinFunctions() {
     m_builtinFunctions["EOF"] = 1;    // (file_number) Returns INT (bool)
     m_builtinFunctions["LOC"] = 1;    // (file_number) Returns INT (position)
     m_builtinFunctions["LOF"] = 1;    // (file_number) Returns INT (length)
+    m_builtinFunctions["READCSV"] = -1;  // (file_number, array(), ...) Returns INT (rows read)
     
     // Terminal I/O functions
     m_builtinFunctions["INKEY$"] = 0;    // Returns STRING (non-blocking keyboard input)
@@ -5168,8 +5500,9 @@ VariableType SemanticAnalyzer::getBuiltinReturnType(const std::string& name) con
             VariableType::UNICODE : VariableType::STRING;
     }
     
-    // LEN and ASC return INT
-    if (name == "LEN" || name == "ASC" || name == "STRTYPE") {
+    // LEN, ASC, READCSV and the array bounds return INT
+    if (name == "LEN" || name == "ASC" || name == "STRTYPE" || name == "READCSV" ||
+        name == "LBOUND" || name == "UBOUND") {
         return VariableType::INT;
     }
     
@@ -954,6 +954,7 @@ struct SymbolTable {
     int forceYieldBudget = 10000;  // OPTION FORCE_YIELD budget: instructions before forced yield
     bool sammEnabled = true;  // OPTION SAMM: if true, emit SAMM scope enter/exit calls for automatic memory management
     bool neonEnabled = true;  // OPTION NEON: if true, use NEON SIMD for array expressions on ARM64
+    CompilerOptions::OutputMode outputMode = CompilerOptions::OutputMode::AUTO;  // OPTION OUTPUT BUFFERED/UNBUFFERED
     
     // Type registry for UDT type IDs (new type system)
     std::unordered_map<std::string, int> typeNameToId;  // UDT name -> unique type ID
@@ -1151,7 +1152,9 @@ enum class SemanticErrorType {
     UNDEFINED_CLASS,
     DUPLICATE_CLASS,
     CIRCULAR_INHERITANCE,
-    CLASS_ERROR
+    CLASS_ERROR,
+    // PARALLEL FOR errors
+    PARALLEL_ERROR
 };
 
 struct SemanticError {
@@ -1306,6 +1309,7 @@ private:
     void validatePrintStatement(const PrintStatement& stmt);
     void validateConsoleStatement(const ConsoleStatement& stmt);
     void validateInputStatement(const InputStatement& stmt);
+    void validateOpenStatement(const OpenStatement& stmt);
     void validateLetStatement(const LetStatement& stmt);
     void validateSliceAssignStatement(const SliceAssignStatement& stmt);
     void validateGotoStatement(const GotoStatement& stmt);
@@ -1314,6 +1318,7 @@ private:
     void validateOnGosubStatement(const OnGosubStatement& stmt);
     void validateIfStatement(const IfStatement& stmt);
     void validateForStatement(const ForStatement& stmt);
+    void validateParallelFor(const ForStatement& stmt);
     void validateForInStatement(ForInStatement& stmt);
     void validateNextStatement(const NextStatement& stmt);
     void validateWhileStatement(const WhileStatement& stmt);
@@ -1499,6 +1504,22 @@ private:
         SourceLocation location;
     };
     std::stack<ForContext> m_forStack;
+
+    // PARALLEL FOR body checks (see validateParallelFor)
+    struct ParallelScan {
+        SourceLocation location;
+        std::string loopVariable;            // canonical names, as parallelScalarName
+        std::set<std::string> written;       // scalars assigned anywhere in the body
+        std::set<std::string> reductions;
+        bool failed = false;
+    };
+    std::string parallelScalarName(const std::string& name);
+    void collectParallelWrites(const std::vector<StatementPtr>& body, std::set<std::string>& written);
+    void checkParallelStatements(const std::vector<StatementPtr>& body, ParallelScan& scan,
+                                 std::set<std::string>& assigned);
+    void checkParallelExpression(const Expression* expr, ParallelScan& scan,
+                                 const std::set<std::string>& assigned);
+    void parallelError(ParallelScan& scan, const std::string& message);
     std::stack<SourceLocation> m_whileStack;
     std::stack<SourceLocation> m_repeatStack;
     std::stack<SourceLocation> m_doStack;
@@ -48,6 +48,8 @@ enum class TokenType {
     EACH,            // EACH (for FOR EACH...IN loops)
     TO,              // TO
     STEP,            // STEP
+    PARALLEL,        // PARALLEL (PARALLEL FOR)
+    REDUCE,          // REDUCE (PARALLEL FOR ... REDUCE SUM(x))
     IN,              // IN (for FOR...IN loops)
     NEXT,            // NEXT
     WHILE,           // WHILE
@@ -416,6 +418,8 @@ inline const char* tokenTypeToString(TokenType type) {
         case TokenType::EACH: return "EACH";
         case TokenType::TO: return "TO";
         case TokenType::STEP: return "STEP";
+        case TokenType::PARALLEL: return "PARALLEL";
+        case TokenType::REDUCE: return "REDUCE";
         case TokenType::IN: return "IN";
         case TokenType::NEXT: return "NEXT";
         case TokenType::WHILE: return "WHILE";
@@ -69,21 +69,22 @@ void RuntimeObjectRegistry::registerHashmapType() {
     hashmap.typeName = "HASHMAP";
     hashmap.description = "Hash table / dictionary for key-value storage with string keys";
     
-    // Set constructor: hashmap_new(capacity) with default capacity of 128
-    // NOTE: Smaller capacities (16, 31, 32) trigger a bug when multiple hashmaps are used
-    // TODO: Investigate why BASIC code hangs with small capacities while C code works fine
-    hashmap.setConstructor("hashmap_new", {"w 128"});
+    // Set constructor: hashmap_new_string_values(capacity) with default capacity
+    // of 128.  The map owns its string values and releases them when they are
+    // replaced or removed.
+    hashmap.setConstructor("hashmap_new_string_values", {"w 128"});
     
     // Enable subscript operator: dict("key") = value and value = dict("key")
+    // String keys are passed as StringDescriptor* (the _str entry points)
     hashmap.enableSubscript(
         TypeDescriptor(BaseType::STRING),   // Keys must be strings
         TypeDescriptor(BaseType::STRING),   // Values are strings (for now)
-        "hashmap_lookup",                    // Runtime function for dict("key")
-        "hashmap_insert"                     // Runtime function for dict("key") = value
+        "hashmap_lookup_str",                // Runtime function for dict("key")
+        "hashmap_insert_str"                 // Runtime function for dict("key") = value
     );
     
     // HASKEY(key$) -> INTEGER (returns 1 if key exists, 0 otherwise)
-    MethodSignature haskey("HASKEY", BaseType::INTEGER, "hashmap_has_key");
+    MethodSignature haskey("HASKEY", BaseType::INTEGER, "hashmap_has_key_str");
     haskey.addParam("key", BaseType::STRING)
           .withDescription("Check if a key exists in the hashmap");
     hashmap.addMethod(haskey);
@@ -94,7 +95,7 @@ void RuntimeObjectRegistry::registerHashmapType() {
     hashmap.addMethod(size);
     
     // REMOVE(key$) -> INTEGER (returns 1 if removed, 0 if not found)
-    MethodSignature remove("REMOVE", BaseType::INTEGER, "hashmap_remove");
+    MethodSignature remove("REMOVE", BaseType::INTEGER, "hashmap_remove_str");
     remove.addParam("key", BaseType::STRING)
           .withDescription("Remove a key-value pair from the hashmap");
     hashmap.addMethod(remove);
@@ -110,6 +111,28 @@ void RuntimeObjectRegistry::registerHashmapType() {
     keys.withDescription("Get an array of all keys in the hashmap");
     hashmap.addMethod(keys);
     
+    // STATS() -> STRING (size, capacity, resize progress and pauses)
+    MethodSignature stats("STATS", BaseType::STRING, "hashmap_stats_string");
+    stats.withDescription("Get a one-line report of the hashmap's size, capacity and resize pauses");
+    hashmap.addMethod(stats);
+    
+    // MAXPAUSE() -> LONG (longest time, in ns, one operation spent resizing)
+    MethodSignature maxpause("MAXPAUSE", BaseType::LONG, "hashmap_max_pause");
+    maxpause.withDescription("Get the worst resize pause of a single operation in nanoseconds");
+    hashmap.addMethod(maxpause);
+    
+    // INCREMENTAL(flag%) -> void (1 = spread resizes over later operations)
+    MethodSignature incremental("INCREMENTAL", BaseType::UNKNOWN, "hashmap_set_incremental");
+    incremental.addParam("flag", BaseType::INTEGER)
+               .withDescription("Choose incremental (1) or one-go (0) resizing");
+    hashmap.addMethod(incremental);
+    
+    // ORDERED(flag%) -> void (1 = iterate in insertion order)
+    MethodSignature ordered("ORDERED", BaseType::UNKNOWN, "hashmap_set_ordered");
+    ordered.addParam("flag", BaseType::INTEGER)
+           .withDescription("Keep entries in insertion order (1) or table order (0)");
+    hashmap.addMethod(ordered);
+    
     // Register the hashmap type
     registerObjectType(hashmap);
 }
@@ -223,6 +246,51 @@ void RuntimeObjectRegistry::registerListType() {
     reverse.withDescription("Create a new list in reversed order");
     list.addMethod(reverse);
 
+    // FILTER(op$, value) — new list of the elements e for which "e op value"
+    // holds; op$ is "=", "<>", "<", "<=", ">" or ">="
+    MethodSignature filter("FILTER", BaseType::OBJECT, "list_filter_int");
+    filter.addParam("op", BaseType::STRING)
+          .addParam("value", BaseType::LONG)
+          .withDescription("New list of the elements that compare true against value");
+    list.addMethod(filter);
+
+    // MAP(op$, value) — new list of "e op value" for every number e;
+    // op$ is "+", "-", "*", "/" or "MOD"
+    MethodSignature map("MAP", BaseType::OBJECT, "list_map_int");
+    map.addParam("op", BaseType::STRING)
+       .addParam("value", BaseType::LONG)
+       .withDescription("New list with an arithmetic operation applied to every number");
+    list.addMethod(map);
+
+    // --- In-place sort ---
+
+    // SORT([descending%], [nocase%]) — stable sort; numbers before strings
+    MethodSignature sort("SORT", BaseType::UNKNOWN, "list_sort");
+    sort.addOptionalParam("descending", BaseType::INTEGER, "0")
+        .addOptionalParam("nocase", BaseType::INTEGER, "0")
+        .withDescription("Sort in place (stable), optionally descending / ignoring case");
+    list.addMethod(sort);
+
+    // --- Reductions over the numeric elements (0 for an empty list) ---
+    // Integer lists reduce to LONG; the codegen uses the _float forms and
+    // DOUBLE for all other lists.
+
+    MethodSignature sum("SUM", BaseType::LONG, "list_sum_int");
+    sum.withDescription("Sum of the numeric elements");
+    list.addMethod(sum);
+
+    MethodSignature minimum("MIN", BaseType::LONG, "list_min_int");
+    minimum.withDescription("Smallest numeric element");
+    list.addMethod(minimum);
+
+    MethodSignature maximum("MAX", BaseType::LONG, "list_max_int");
+    maximum.withDescription("Largest numeric element");
+    list.addMethod(maximum);
+
+    MethodSignature avg("AVG", BaseType::DOUBLE, "list_avg");
+    avg.withDescription("Average of the numeric elements");
+    list.addMethod(avg);
+
     // --- Stack/Queue methods ---
 
     // SHIFT() — remove and return the first element
@@ -0,0 +1,10 @@
+SUB Fill()
+  DIM a$(10)
+  FOR j = 0 TO 10
+    a$(j) = "item" + STR$(j)
+  NEXT j
+END SUB
+FOR i = 1 TO 2000
+  Fill()
+NEXT i
+PRINT "done"
@@ -0,0 +1,614 @@
+/*
+ * bench_hashmap.c
+ * HASHMAP benchmark (hashmap_runtime.c)
+ *
+ * Runs the same insert / lookup / delete mix on the SwissTable-style map
+ * and on the previous implementation (reproduced below as old_*: linear
+ * probing over 24-byte entries, 32-bit FNV-1a, strdup'ed keys, resize at
+ * 70% load), for 1K to 10M keys:
+ *
+ *   insert    N new keys
+ *   hit       N lookups of present keys
+ *   miss      N lookups of absent keys
+ *   delete    N/2 removals, then N/2 re-inserts (tombstone reuse)
+ *   mixed     N operations, 80% lookup / 10% insert / 10% delete
+ *
+ * Then the tail latency of single inserts: max_keys integer keys are
+ * inserted into a map that resizes in one go and into one that resizes
+ * incrementally, timing every insert (and comparing the worst one with
+ * what hashmap_stats reports).
+ *
+ * Last, a walk over max_keys string keys: the old FOR EACH lowering
+ * (hashmap_keys() plus a hashmap_lookup() per key) against the cursor
+ * (hashmap_iter_next) on an unordered and an ordered map, and against
+ * hashmap_export in batches.
+ *
+ * String keys are StringDescriptor*s, as BASIC passes them: the new map
+ * takes them directly, the old one gets the key's UTF-8 text (what the
+ * cached string_to_utf8() call in generated code returned).  The key
+ * descriptors are built in place rather than taken from the SAMM pool,
+ * which is not sized for tens of millions of live strings.  Integer and
+ * double keys run on hashmap_new_int / hashmap_new_double; the old map
+ * only had string keys, so they are compared against it with the key
+ * formatted as text (what a BASIC program had to do).
+ *
+ * Every operation's result is cross-checked between the two maps.
+ *
+ * Build:
+ *   cc -O2 \
+ *      -I fsh/FasterBASICT/runtime_c \
+ *      performance_tests/bench_hashmap.c \
+ *      fsh/FasterBASICT/runtime_c/hashmap_runtime.c \
+ *      fsh/FasterBASICT/runtime_c/samm_core.c \
+ *      fsh/FasterBASICT/runtime_c/samm_pool.c \
+ *      fsh/FasterBASICT/runtime_c/list_ops.c \
+ *      fsh/FasterBASICT/runtime_c/string_utf32.c \
+ *      fsh/FasterBASICT/runtime_c/string_simd.c \
+ *      fsh/FasterBASICT/runtime_c/string_pool.c \
+ *      fsh/FasterBASICT/runtime_c/array_descriptor_runtime.c \
+ *      -lpthread -lm \
+ *      -o performance_tests/bench_hashmap
+ *   ./performance_tests/bench_hashmap [max_keys]     (default 1000000)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "samm_bridge.h"
+#include "string_descriptor.h"
+#include "hashmap_runtime.h"
+
+#define DEFAULT_MAX_KEYS  1000000
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int check(int ok, const char* what) {
+    printf("  %-48s %s\n", what, ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+/* ========================================================================= */
+/* Previous implementation                                                    */
+/* ========================================================================= */
+
+typedef struct {
+    char*    key;
+    void*    value;
+    uint32_t hash;
+    uint32_t state;     /* 0 = empty, 1 = occupied, 2 = tombstone */
+} OldEntry;
+
+typedef struct {
+    int64_t   capacity;
+    int64_t   size;
+    OldEntry* entries;
+    int64_t   tombstones;
+} OldMap;
+
+static uint32_t old_hash(const char* s) {
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= (uint8_t)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static OldMap* old_new(int64_t capacity) {
+    OldMap* m = (OldMap*)malloc(sizeof(OldMap));
+    m->capacity = capacity < 16 ? 16 : capacity;
+    m->size = 0;
+    m->tombstones = 0;
+    m->entries = (OldEntry*)calloc((size_t)m->capacity, sizeof(OldEntry));
+    return m;
+}
+
+static void old_free(OldMap* m) {
+    for (int64_t i = 0; i < m->capacity; i++) {
+        if (m->entries[i].state == 1) free(m->entries[i].key);
+    }
+    free(m->entries);
+    free(m);
+}
+
+static int64_t old_find(const OldMap* m, const char* key, uint32_t h) {
+    int64_t i = h % m->capacity;
+    for (int64_t n = 0; n < m->capacity; n++) {
+        const OldEntry* e = &m->entries[i];
+        if (e->state == 0) return -1;
+        if (e->state == 1 && e->hash == h && strcmp(e->key, key) == 0) return i;
+        i = (i + 1) % m->capacity;
+    }
+    return -1;
+}
+
+static void old_resize(OldMap* m, int64_t capacity) {
+    OldEntry* old = m->entries;
+    int64_t old_cap = m->capacity;
+    m->entries = (OldEntry*)calloc((size_t)capacity, sizeof(OldEntry));
+    m->capacity = capacity;
+    m->tombstones = 0;
+    for (int64_t k = 0; k < old_cap; k++) {
+        if (old[k].state != 1) continue;
+        int64_t i = old[k].hash % capacity;
+        while (m->entries[i].state != 0) i = (i + 1) % capacity;
+        m->entries[i] = old[k];
+    }
+    free(old);
+}
+
+static int32_t old_insert(OldMap* m, const char* key, void* value) {
+    if ((m->size + m->tombstones + 1) * 10 > m->capacity * 7) {
+        old_resize(m, m->capacity * 2);
+    }
+    uint32_t h = old_hash(key);
+    int64_t i = old_find(m, key, h);
+    if (i >= 0) {
+        m->entries[i].value = value;
+        return 1;
+    }
+    i = h % m->capacity;
+    while (m->entries[i].state == 1) i = (i + 1) % m->capacity;
+    if (m->entries[i].state == 2) m->tombstones--;
+    m->entries[i].key = strdup(key);
+    m->entries[i].value = value;
+    m->entries[i].hash = h;
+    m->entries[i].state = 1;
+    m->size++;
+    return 1;
+}
+
+static void* old_lookup(OldMap* m, const char* key) {
+    int64_t i = old_find(m, key, old_hash(key));
+    return i < 0 ? NULL : m->entries[i].value;
+}
+
+static int32_t old_remove(OldMap* m, const char* key) {
+    int64_t i = old_find(m, key, old_hash(key));
+    if (i < 0) return 0;
+    free(m->entries[i].key);
+    m->entries[i].state = 2;
+    m->size--;
+    m->tombstones++;
+    return 1;
+}
+
+/* ========================================================================= */
+/* Workload                                                                   */
+/* ========================================================================= */
+
+enum { KEYS_STRING, KEYS_INT, KEYS_DOUBLE };
+
+static const char* kind_name[] = { "string", "int", "double" };
+
+enum { OP_INSERT, OP_HIT, OP_MISS, OP_DELETE, OP_MIXED, OP_COUNT };
+
+static const char* op_name[] = { "insert", "hit", "miss", "delete", "mixed" };
+
+typedef struct {
+    double seconds[OP_COUNT];
+    long   checksum[OP_COUNT];
+} Timings;
+
+/* Key material for the 2N key ids: ids < N are inserted, ids >= N miss */
+typedef struct {
+    int64_t            n;
+    int64_t*           ints;
+    double*            doubles;
+    StringDescriptor*  strs;    /* ASCII descriptors over texts[]      */
+    char**             texts;   /* per kind: the text the old map sees */
+} Keys;
+
+static int64_t scramble(int64_t i) {
+    uint64_t x = (uint64_t)i * 0x9E3779B97F4A7C15ull;
+    return (int64_t)(x ^ (x >> 29));
+}
+
+static void make_keys(Keys* k, int64_t n, int kind) {
+    char buf[64];
+    k->n = n;
+    k->ints = (int64_t*)malloc((size_t)(2 * n) * sizeof(int64_t));
+    k->doubles = (double*)malloc((size_t)(2 * n) * sizeof(double));
+    k->strs = (StringDescriptor*)calloc((size_t)(2 * n), sizeof(StringDescriptor));
+    k->texts = (char**)malloc((size_t)(2 * n) * sizeof(char*));
+    for (int64_t i = 0; i < 2 * n; i++) {
+        k->ints[i] = scramble(i);
+        k->doubles[i] = (double)i * 0.25 - 1000.0;
+        if (kind == KEYS_STRING) {
+            snprintf(buf, sizeof(buf), "customer-%lld", (long long)k->ints[i]);
+        } else if (kind == KEYS_INT) {
+            snprintf(buf, sizeof(buf), "%lld", (long long)k->ints[i]);
+        } else {
+            snprintf(buf, sizeof(buf), "%.17g", k->doubles[i]);
+        }
+        k->texts[i] = strdup(buf);
+        k->strs[i].data = k->texts[i];
+        k->strs[i].length = (int64_t)strlen(buf);
+        k->strs[i].refcount = 1;    /* never drops to 0: the map only retains */
+        k->strs[i].encoding = STRING_ENCODING_ASCII;
+    }
+}
+
+static void free_keys(Keys* k) {
+    for (int64_t i = 0; i < 2 * k->n; i++) {
+        free(k->texts[i]);
+        free(k->strs[i].utf8_cache);    /* hashmap_keys() fills it */
+    }
+    free(k->texts);
+    free(k->ints);
+    free(k->doubles);
+    free(k->strs);
+}
+
+static inline void* value_for(int64_t id) {
+    return (void*)(intptr_t)(id + 1);
+}
+
+/* ---- one operation on either map ---------------------------------------- */
+
+typedef struct {
+    int      old;       /* run on OldMap */
+    int      kind;
+    HashMap* map;
+    OldMap*  old_map;
+    Keys*    keys;
+} Target;
+
+/* The cached UTF-8 form, read through the descriptor as string_to_utf8 does */
+static inline const char* old_key(Target* t, int64_t id) {
+    return (const char*)t->keys->strs[id].data;
+}
+
+static inline long do_insert(Target* t, int64_t id) {
+    if (t->old) return old_insert(t->old_map, old_key(t, id), value_for(id));
+    switch (t->kind) {
+    case KEYS_INT:    return hashmap_insert_int(t->map, t->keys->ints[id], value_for(id));
+    case KEYS_DOUBLE: return hashmap_insert_double(t->map, t->keys->doubles[id], value_for(id));
+    default:          return hashmap_insert_str(t->map, &t->keys->strs[id], value_for(id));
+    }
+}
+
+static inline long do_lookup(Target* t, int64_t id) {
+    void* v;
+    if (t->old) {
+        v = old_lookup(t->old_map, old_key(t, id));
+    } else {
+        switch (t->kind) {
+        case KEYS_INT:    v = hashmap_lookup_int(t->map, t->keys->ints[id]); break;
+        case KEYS_DOUBLE: v = hashmap_lookup_double(t->map, t->keys->doubles[id]); break;
+        default:          v = hashmap_lookup_str(t->map, &t->keys->strs[id]); break;
+        }
+    }
+    return (long)(intptr_t)v;
+}
+
+static inline long do_remove(Target* t, int64_t id) {
+    if (t->old) return old_remove(t->old_map, old_key(t, id));
+    switch (t->kind) {
+    case KEYS_INT:    return hashmap_remove_int(t->map, t->keys->ints[id]);
+    case KEYS_DOUBLE: return hashmap_remove_double(t->map, t->keys->doubles[id]);
+    default:          return hashmap_remove_str(t->map, &t->keys->strs[id]);
+    }
+}
+
+static Timings run(Target* t) {
+    Timings r = {{0}, {0}};
+    int64_t n = t->keys->n;
+    double t0;
+
+    if (t->old) {
+        t->old_map = old_new(128);
+    } else {
+        t->map = t->kind == KEYS_INT ? hashmap_new_int(128)
+               : t->kind == KEYS_DOUBLE ? hashmap_new_double(128) : hashmap_new(128);
+    }
+
+    t0 = now_seconds();
+    for (int64_t i = 0; i < n; i++) r.checksum[OP_INSERT] += do_insert(t, i);
+    r.seconds[OP_INSERT] = now_seconds() - t0;
+
+    t0 = now_seconds();
+    for (int64_t i = 0; i < n; i++) r.checksum[OP_HIT] += do_lookup(t, (i * 7919) % n);
+    r.seconds[OP_HIT] = now_seconds() - t0;
+
+    t0 = now_seconds();
+    for (int64_t i = 0; i < n; i++) r.checksum[OP_MISS] += do_lookup(t, n + i);
+    r.seconds[OP_MISS] = now_seconds() - t0;
+
+    t0 = now_seconds();
+    for (int64_t i = 0; i < n; i += 2) r.checksum[OP_DELETE] += do_remove(t, i);
+    for (int64_t i = 0; i < n; i += 2) r.checksum[OP_DELETE] += do_insert(t, i);
+    r.seconds[OP_DELETE] = now_seconds() - t0;
+
+    uint64_t rng = 88172645463325252ull;
+    t0 = now_seconds();
+    for (int64_t i = 0; i < n; i++) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        int64_t id = (int64_t)((rng >> 8) % (uint64_t)(2 * n));
+        int op = (int)(rng & 0xFF) % 10;
+        long v = op == 0 ? do_insert(t, id) : op == 1 ? do_remove(t, id) : do_lookup(t, id);
+        r.checksum[OP_MIXED] = r.checksum[OP_MIXED] * 31 + v;
+    }
+    r.seconds[OP_MIXED] = now_seconds() - t0;
+
+    long size = t->old ? (long)t->old_map->size : (long)hashmap_size(t->map);
+    r.checksum[OP_MIXED] += size;
+    if (t->old) old_free(t->old_map); else hashmap_free(t->map);
+    return r;
+}
+
+/* ========================================================================= */
+/* Correctness                                                                */
+/* ========================================================================= */
+
+static int check_semantics(void) {
+    int errors = 0;
+
+    /* ASCII and UTF-32 forms of one string are one key */
+    HashMap* m = hashmap_new(4);
+    StringDescriptor* ascii = string_new_ascii("caf");
+    StringDescriptor* wide = string_new_utf8("caf\xc3\xa9");
+    StringDescriptor* prefix = string_left(wide, 3);    /* UTF-32 "caf" */
+    hashmap_insert_str(m, ascii, value_for(1));
+    hashmap_insert_str(m, wide, value_for(2));
+    if (hashmap_hash_string(ascii) != hashmap_hash_string(prefix)) errors++;
+    if (hashmap_lookup_str(m, prefix) != value_for(1)) errors++;
+    if (hashmap_lookup(m, "caf\xc3\xa9") != value_for(2)) errors++;
+    if (hashmap_size(m) != 2) errors++;
+
+    /* Keys are retained: the caller's reference can go */
+    string_release(ascii);
+    if (hashmap_lookup(m, "caf") != value_for(1)) errors++;
+    if (!hashmap_remove(m, "caf") || hashmap_has_key_str(m, prefix)) errors++;
+    hashmap_clear(m);
+    if (hashmap_size(m) != 0 || hashmap_lookup_str(m, wide)) errors++;
+    hashmap_free(m);
+    string_release(wide);
+    string_release(prefix);
+
+    /* Double keys by value */
+    m = hashmap_new_double(0);
+    hashmap_insert_double(m, 0.0, value_for(1));
+    hashmap_insert_double(m, 0.0 / 0.0, value_for(2));
+    if (hashmap_lookup_double(m, -0.0) != value_for(1)) errors++;
+    if (hashmap_lookup_double(m, -(0.0 / 0.0)) != value_for(2)) errors++;
+    if (hashmap_size(m) != 2) errors++;
+    hashmap_free(m);
+
+    /* Heavy churn at a fixed size: tombstones must not fill the table */
+    m = hashmap_new_int(0);
+    for (int64_t i = 0; i < 200000; i++) {
+        hashmap_insert_int(m, i, value_for(i));
+        if (i >= 100) hashmap_remove_int(m, i - 100);
+    }
+    if (hashmap_size(m) != 100 || m->capacity > 1024) errors++;
+    for (int64_t i = 199900; i < 200000; i++) {
+        if (hashmap_lookup_int(m, i) != value_for(i)) errors++;
+    }
+    hashmap_free(m);
+
+    /* Incremental resize: keys stay visible in both tables mid-move */
+    m = hashmap_new_int(0);
+    int64_t n = 4 * HASHMAP_INCREMENTAL_MIN;
+    int seen_migration = 0;
+    for (int64_t i = 0; i < n; i++) {
+        hashmap_insert_int(m, i, value_for(i));
+        if (m->old_ctrl) seen_migration = 1;
+        if (i % 3 == 0 && (i / 2) % 7 != 6 && hashmap_lookup_int(m, i / 2) != value_for(i / 2)) errors++;
+        if (i % 7 == 0) hashmap_remove_int(m, i - 1);
+    }
+    for (int64_t i = 0; i < n; i++) {
+        void* want = (i % 7 == 6 && i + 1 < n) ? NULL : value_for(i);
+        if (hashmap_lookup_int(m, i) != want) errors++;
+    }
+    HashMapStats st;
+    hashmap_stats(m, &st);
+    if (!seen_migration || st.resizes == 0 || st.size != hashmap_size(m)) errors++;
+
+    /* Iteration mid-resize sees every key once */
+    int64_t pos = 0, seen = 0;
+    HashMapSlot* e;
+    while ((e = hashmap_iter_next(m, &pos)) != NULL) {
+        if (e->value != value_for(e->key.i)) errors++;
+        seen++;
+    }
+    if (seen != hashmap_size(m)) errors++;
+    hashmap_free(m);
+
+    /* Ordered: insertion order survives removes, re-inserts and compaction */
+    m = hashmap_new_int(0);
+    hashmap_set_ordered(m, 1);
+    for (int64_t i = 0; i < 100000; i++) {
+        hashmap_insert_int(m, i, value_for(i));
+        if (i % 4 == 0) hashmap_remove_int(m, i / 2);
+    }
+    hashmap_insert_int(m, 0, value_for(0));
+    int64_t total = hashmap_size(m), last = 0;
+    pos = 0;
+    seen = 0;
+    while ((e = hashmap_iter_next(m, &pos)) != NULL) {
+        if (e->value != value_for(e->key.i)) errors++;
+        if (e->key.i == 0 ? seen != total - 1 : e->key.i <= last) errors++;
+        last = e->key.i;
+        if (e->key.i % 3 == 0) hashmap_remove_int(m, e->key.i);   /* in the loop */
+        seen++;
+    }
+    pos = 0;
+    while ((e = hashmap_iter_next(m, &pos)) != NULL) {
+        if (e->key.i % 3 == 0) errors++;
+    }
+    hashmap_set_ordered(m, 0);
+    for (int64_t i = 1; i < 100000; i += 3) {
+        if (hashmap_has_key_int(m, i) && hashmap_lookup_int(m, i) != value_for(i)) errors++;
+    }
+    hashmap_free(m);
+    return errors;
+}
+
+/* ========================================================================= */
+/* Insert tail latency                                                        */
+/* ========================================================================= */
+
+static int compare_i64(const void* a, const void* b) {
+    int64_t x = *(const int64_t*)a, y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void tail_latency(int64_t n, int incremental) {
+    int64_t* ns = (int64_t*)malloc((size_t)n * sizeof(int64_t));
+    HashMap* m = hashmap_new_int(128);
+    hashmap_set_incremental(m, incremental);
+
+    double t0 = now_seconds();
+    for (int64_t i = 0; i < n; i++) {
+        double a = now_seconds();
+        hashmap_insert_int(m, scramble(i), value_for(i));
+        ns[i] = (int64_t)((now_seconds() - a) * 1e9);
+    }
+    double total = now_seconds() - t0;
+
+    HashMapStats st;
+    hashmap_stats(m, &st);
+    qsort(ns, (size_t)n, sizeof(int64_t), compare_i64);
+    printf("  %-12s %9.1f ms %10lld %10lld %12.1f %14.1f\n",
+           incremental ? "incremental" : "one-go", total * 1e3,
+           (long long)ns[n / 2], (long long)ns[n - 1 - n / 10000],
+           ns[n - 1] / 1e3, st.max_pause_ns / 1e3);
+    hashmap_free(m);
+    free(ns);
+}
+
+/* ========================================================================= */
+/* Iteration                                                                  */
+/* ========================================================================= */
+
+#define EXPORT_BATCH 256
+
+static int iteration(int64_t n) {
+    Keys keys;
+    make_keys(&keys, n, KEYS_STRING);
+    HashMap* plain = hashmap_new(0);
+    HashMap* ordered = hashmap_new(0);
+    hashmap_set_ordered(ordered, 1);
+    for (int64_t i = 0; i < n; i++) {
+        hashmap_insert_str(plain, &keys.strs[i], value_for(i));
+        hashmap_insert_str(ordered, &keys.strs[i], value_for(i));
+    }
+
+    long sums[4] = { 0, 0, 0, 0 };
+    double secs[4];
+    double t = now_seconds();
+    void** list = hashmap_keys(plain);
+    for (int64_t i = 0; list[i]; i++) {
+        sums[0] += (long)(intptr_t)hashmap_lookup(plain, (const char*)list[i]);
+    }
+    free(list);
+    secs[0] = now_seconds() - t;
+
+    HashMap* maps[2] = { plain, ordered };
+    for (int k = 0; k < 2; k++) {
+        t = now_seconds();
+        int64_t pos = 0;
+        HashMapSlot* e;
+        while ((e = hashmap_iter_next(maps[k], &pos)) != NULL) {
+            sums[1 + k] += (long)(intptr_t)e->value + (long)e->key.str->length;
+        }
+        secs[1 + k] = now_seconds() - t;
+    }
+
+    HashMapSlot batch[EXPORT_BATCH];
+    t = now_seconds();
+    int64_t pos = 0, got;
+    while ((got = hashmap_export(ordered, &pos, batch, EXPORT_BATCH)) > 0) {
+        for (int64_t i = 0; i < got; i++) {
+            sums[3] += (long)(intptr_t)batch[i].value + (long)batch[i].key.str->length;
+        }
+    }
+    secs[3] = now_seconds() - t;
+
+    long lengths = 0;
+    for (int64_t i = 0; i < n; i++) lengths += (long)keys.strs[i].length;
+    static const char* how[] = { "keys+lookup", "cursor", "cursor ordered", "export ordered" };
+    for (int k = 0; k < 4; k++) {
+        printf("  %-16s %9.1f ms %8.1f ns/entry %6.1fx\n", how[k], secs[k] * 1e3,
+               secs[k] * 1e9 / (double)n, secs[k] > 0 ? secs[0] / secs[k] : 0.0);
+    }
+    int failed = check(sums[1] - lengths == sums[0] && sums[2] == sums[1] && sums[3] == sums[1],
+                       "every walk sees every entry once");
+
+    hashmap_free(plain);
+    hashmap_free(ordered);
+    free_keys(&keys);
+    return failed;
+}
+
+int main(int argc, char** argv) {
+    int64_t max_keys = DEFAULT_MAX_KEYS;
+    if (argc > 1) {
+        max_keys = atoll(argv[1]);
+        if (max_keys <= 0) max_keys = DEFAULT_MAX_KEYS;
+    }
+
+    samm_init();
+    printf("HASHMAP benchmark: 1K to %lld keys (ms per operation batch, old / new)\n\n",
+           (long long)max_keys);
+
+    int failures = check(check_semantics() == 0, "key semantics (encoding, NaN, churn)");
+    printf("\n");
+
+    for (int kind = KEYS_STRING; kind <= KEYS_DOUBLE; kind++) {
+        printf("  %s keys\n", kind_name[kind]);
+        printf("  %10s", "keys");
+        for (int op = 0; op < OP_COUNT; op++) printf("  %20s", op_name[op]);
+        printf("\n");
+
+        int agree = 1;
+        for (int64_t n = 1000; n <= max_keys; n *= 10) {
+            Keys keys;
+            make_keys(&keys, n, kind);
+            Target old_t = { 1, kind, NULL, NULL, &keys };
+            Target new_t = { 0, kind, NULL, NULL, &keys };
+            Timings o = run(&old_t);
+            Timings w = run(&new_t);
+            free_keys(&keys);
+
+            printf("  %10lld", (long long)n);
+            for (int op = 0; op < OP_COUNT; op++) {
+                char cell[64];
+                snprintf(cell, sizeof(cell), "%.1f/%.1f %4.1fx",
+                         o.seconds[op] * 1e3, w.seconds[op] * 1e3,
+                         w.seconds[op] > 0 ? o.seconds[op] / w.seconds[op] : 0.0);
+                printf("  %20s", cell);
+                if (o.checksum[op] != w.checksum[op]) agree = 0;
+            }
+            printf("\n");
+        }
+        char what[64];
+        snprintf(what, sizeof(what), "old and new maps agree (%s keys)", kind_name[kind]);
+        failures += check(agree, what);
+        printf("\n");
+    }
+
+    printf("  insert latency, %lld int keys\n", (long long)max_keys);
+    printf("  %-12s %12s %10s %10s %12s %14s\n",
+           "", "total", "p50 ns", "p99.99 ns", "worst us", "STATS max us");
+    tail_latency(max_keys, 0);
+    tail_latency(max_keys, 1);
+    printf("\n");
+
+    printf("  walk over %lld string keys (key and value)\n", (long long)max_keys);
+    failures += iteration(max_keys);
+    printf("\n");
+
+    samm_shutdown();
+    printf("%s\n", failures ? "FAILED" : "ALL PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,280 @@
+/*
+ * bench_string_simd.c
+ * Vectorised string kernel benchmark (string_simd.c)
+ *
+ * Times the runtime calls behind INSTR, string comparison, UCASE$ and
+ * ASCII + UTF-32 concatenation on a 64 KB text, once with the kernels
+ * pinned to scalar code and once at the best level the CPU supports:
+ *
+ *   INSTR, 6-char needle        first/last-character vector filter
+ *   INSTR, 40-char needle       Boyer-Moore-Horspool when scalar
+ *   a$ = b$ on equal strings    mismatch kernel
+ *   UCASE$(a$)                  case kernel
+ *   ascii$ + utf32$             widening kernel
+ *
+ * (The scan kernel used by LINE INPUT # on mapped files is checked but
+ * not timed here.)
+ *
+ * Before timing, every kernel is checked against a plain reference loop
+ * on random inputs of every length from 0 to 200 (ASCII and UTF-32, at
+ * every available level), so tails and block boundaries are covered.
+ *
+ * Build:
+ *   cc -O2 \
+ *      -I fsh/FasterBASICT/runtime_c \
+ *      performance_tests/bench_string_simd.c \
+ *      fsh/FasterBASICT/runtime_c/samm_core.c \
+ *      fsh/FasterBASICT/runtime_c/samm_pool.c \
+ *      fsh/FasterBASICT/runtime_c/list_ops.c \
+ *      fsh/FasterBASICT/runtime_c/string_utf32.c \
+ *      fsh/FasterBASICT/runtime_c/string_simd.c \
+ *      fsh/FasterBASICT/runtime_c/string_pool.c \
+ *      fsh/FasterBASICT/runtime_c/array_descriptor_runtime.c \
+ *      -lpthread -lm \
+ *      -o performance_tests/bench_string_simd
+ *   ./performance_tests/bench_string_simd [passes]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "samm_bridge.h"
+#include "string_descriptor.h"
+#include "string_simd.h"
+
+#define DEFAULT_PASSES  2000
+#define TEXT_LENGTH     65536
+#define MAX_CHECK_LEN   200
+#define SHORT_NEEDLE    "zephyr"
+#define LONG_NEEDLE     "zephyr quartz vexing jumbo blitz fjord!!"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int check(int ok, const char* what) {
+    printf("  %-48s %s\n", what, ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+/* ========================================================================= */
+/* Correctness                                                                */
+/* ========================================================================= */
+
+static int64_t ref_find(const uint32_t* h, int64_t n, const uint32_t* nd, int64_t m) {
+    for (int64_t i = 0; i + m <= n; i++) {
+        int64_t j = 0;
+        while (j < m && h[i + j] == nd[j]) j++;
+        if (j == m) return i;
+    }
+    return -1;
+}
+
+static uint32_t ref_case(uint32_t c, int upper) {
+    if (upper) return (c >= 'a' && c <= 'z') ? c - 32 : c;
+    return (c >= 'A' && c <= 'Z') ? c + 32 : c;
+}
+
+/* Small alphabet (letters and their neighbours) so that partial matches
+ * are frequent, plus bytes >= 0x80 and, for UTF-32, code points above
+ * 0xFFFF. */
+static uint32_t random_char(int wide) {
+    static const char alphabet[] = "abAB{@`Z";
+    int r = rand() % 10;
+    if (r == 8) return 0x80 + (uint32_t)(rand() % 0x80);
+    if (r == 9) return wide ? 0x1F600 + (uint32_t)(rand() % 3) : 0xE1;
+    return (uint8_t)alphabet[r];
+}
+
+static int check_kernels(void) {
+    uint8_t  h8[MAX_CHECK_LEN], n8[MAX_CHECK_LEN], o8[MAX_CHECK_LEN];
+    uint32_t h32[MAX_CHECK_LEN], n32[MAX_CHECK_LEN], o32[MAX_CHECK_LEN];
+    int errors = 0;
+
+    for (int n = 0; n < MAX_CHECK_LEN; n++) {
+        for (int trial = 0; trial < 8; trial++) {
+            for (int i = 0; i < n; i++) {
+                h32[i] = random_char(1);
+                h8[i] = (uint8_t)random_char(0);
+            }
+
+            /* Needle: usually a slice of the haystack, sometimes random */
+            int m = n ? rand() % (n + 1) : 0;
+            if (trial == 7) m = n < 48 ? n : 40;
+            int at = (n - m) ? rand() % (n - m + 1) : 0;
+            for (int i = 0; i < m; i++) {
+                n32[i] = (trial & 1) ? random_char(1) : h32[at + i];
+                n8[i]  = (trial & 1) ? (uint8_t)random_char(0) : h8[at + i];
+            }
+
+            uint32_t w[MAX_CHECK_LEN];
+            for (int i = 0; i < n; i++) w[i] = h8[i];
+            uint32_t wn[MAX_CHECK_LEN];
+            for (int i = 0; i < m; i++) wn[i] = n8[i];
+
+            if (simd_find_u8(h8, n, n8, m) != (m ? ref_find(w, n, wn, m) : 0)) errors++;
+            if (simd_find_u32(h32, n, n32, m) != (m ? ref_find(h32, n, n32, m) : 0)) errors++;
+
+            /* Mismatch: copy and flip one element */
+            memcpy(o8, h8, (size_t)n);
+            memcpy(o32, h32, (size_t)n * sizeof(uint32_t));
+            int64_t diff = n;
+            if (n && (trial & 1)) {
+                diff = rand() % n;
+                o8[diff] ^= 1;
+                o32[diff] ^= 0x10000;
+            }
+            if (simd_mismatch_u8(h8, o8, n) != diff) errors++;
+            if (simd_mismatch_u32(h32, o32, n) != diff) errors++;
+
+            /* Widen */
+            simd_widen_u8_u32(o32, h8, n);
+            if (memcmp(o32, w, (size_t)n * sizeof(uint32_t)) != 0) errors++;
+
+            /* Scan for either of two bytes, noting bytes >= 0x80 before it */
+            uint8_t a = h8[n ? rand() % n : 0], b = (trial & 2) ? a : (uint8_t)'@';
+            int64_t stop = 0;
+            bool high = false, got_high;
+            while (stop < n && h8[stop] != a && h8[stop] != b) high |= h8[stop++] >= 0x80;
+            if (simd_scan_u8(h8, n, a, b, &got_high) != stop || got_high != high) errors++;
+
+            /* Case mapping, in place */
+            int upper = trial & 1;
+            memcpy(o8, h8, (size_t)n);
+            memcpy(o32, h32, (size_t)n * sizeof(uint32_t));
+            simd_case_u8(o8, o8, n, upper);
+            simd_case_u32(o32, o32, n, upper);
+            for (int i = 0; i < n; i++) {
+                if (o8[i] != ref_case(h8[i], upper)) { errors++; break; }
+                if (o32[i] != ref_case(h32[i], upper)) { errors++; break; }
+            }
+        }
+    }
+    return errors;
+}
+
+/* ========================================================================= */
+/* Timing                                                                     */
+/* ========================================================================= */
+
+typedef struct {
+    double instr_short;
+    double instr_long;
+    double compare;
+    double upper;
+    double widen;
+    long   checksum;
+} Timings;
+
+static Timings run(StringDescriptor* text, StringDescriptor* copy,
+                   StringDescriptor* wide, long passes) {
+    StringDescriptor* short_needle = string_new_ascii(SHORT_NEEDLE);
+    StringDescriptor* long_needle  = string_new_ascii(LONG_NEEDLE);
+    Timings t = {0};
+    double t0;
+
+    t0 = now_seconds();
+    for (long k = 0; k < passes; k++) t.checksum += string_instr(text, short_needle, k % 64);
+    t.instr_short = now_seconds() - t0;
+
+    t0 = now_seconds();
+    for (long k = 0; k < passes; k++) t.checksum += string_instr(text, long_needle, k % 64);
+    t.instr_long = now_seconds() - t0;
+
+    t0 = now_seconds();
+    for (long k = 0; k < passes; k++) t.checksum += string_compare(text, copy);
+    t.compare = now_seconds() - t0;
+
+    t0 = now_seconds();
+    for (long k = 0; k < passes; k++) {
+        StringDescriptor* u = string_upper(text);
+        t.checksum += (long)string_char_at(u, k % TEXT_LENGTH);
+        string_release(u);
+    }
+    t.upper = now_seconds() - t0;
+
+    t0 = now_seconds();
+    for (long k = 0; k < passes; k++) {
+        StringDescriptor* c = string_concat(text, wide);
+        t.checksum += c->length;
+        string_release(c);
+    }
+    t.widen = now_seconds() - t0;
+
+    string_release(short_needle);
+    string_release(long_needle);
+    return t;
+}
+
+static void report(const char* what, double scalar, double simd, long passes) {
+    double mb = (double)passes * TEXT_LENGTH / 1e6;
+    printf("  %-28s %8.3f s  %8.3f s  %6.1fx  (%7.0f MB/s)\n",
+           what, scalar, simd, simd > 0 ? scalar / simd : 0.0, simd > 0 ? mb / simd : 0.0);
+}
+
+int main(int argc, char** argv) {
+    long passes = DEFAULT_PASSES;
+    if (argc > 1) {
+        passes = atol(argv[1]);
+        if (passes <= 0) passes = DEFAULT_PASSES;
+    }
+
+    samm_init();
+    srand(12345);
+
+    StringSimdLevel best = string_simd_detect();
+    printf("String SIMD benchmark: %ld passes over %d characters (best level: %s)\n\n",
+           passes, TEXT_LENGTH, string_simd_level_name(best));
+
+    int failures = 0;
+    for (int level = STRING_SIMD_SCALAR; level <= STRING_SIMD_NEON; level++) {
+        if (string_simd_set_level((StringSimdLevel)level) != (StringSimdLevel)level) continue;
+        char what[64];
+        snprintf(what, sizeof(what), "kernels match reference (%s)",
+                 string_simd_level_name((StringSimdLevel)level));
+        failures += check(check_kernels() == 0, what);
+    }
+    printf("\n");
+
+    /* Text: repeated sentence without the needles, which sit at the end */
+    char* buf = (char*)malloc(TEXT_LENGTH + 1);
+    static const char sentence[] = "the quick brown fox jumps over the lazy dog. ";
+    for (int i = 0; i < TEXT_LENGTH; i++) buf[i] = sentence[i % (sizeof(sentence) - 1)];
+    memcpy(buf + TEXT_LENGTH - strlen(LONG_NEEDLE), LONG_NEEDLE, strlen(LONG_NEEDLE));
+    buf[TEXT_LENGTH] = '\0';
+
+    StringDescriptor* text = string_new_ascii(buf);
+    StringDescriptor* copy = string_new_ascii(buf);
+    StringDescriptor* wide = basic_chr(0x263A);
+    free(buf);
+
+    string_simd_set_level(STRING_SIMD_SCALAR);
+    Timings scalar = run(text, copy, wide, passes);
+    string_simd_set_level(best);
+    Timings simd = run(text, copy, wide, passes);
+
+    printf("  %-28s %10s  %10s\n", "", "scalar", string_simd_level_name(best));
+    report("INSTR, 6-char needle", scalar.instr_short, simd.instr_short, passes);
+    report("INSTR, 40-char needle", scalar.instr_long, simd.instr_long, passes);
+    report("compare equal strings", scalar.compare, simd.compare, passes);
+    report("UCASE$", scalar.upper, simd.upper, passes);
+    report("ASCII + UTF-32 concat", scalar.widen, simd.widen, passes);
+    printf("  checksum: %ld / %ld\n\n", scalar.checksum, simd.checksum);
+
+    failures += check(scalar.checksum == simd.checksum, "scalar and vector results agree");
+    failures += check(string_instr(text, copy, 0) == 0, "INSTR of an equal string is 0");
+
+    string_release(text);
+    string_release(copy);
+    string_release(wide);
+    samm_shutdown();
+
+    printf("\n%s\n", failures ? "FAILED" : "ALL PASSED");
+    return failures ? 1 : 0;
+}
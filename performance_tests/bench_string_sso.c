@@ -0,0 +1,156 @@
+/*
+ * bench_string_sso.c
+ * Short-string (SSO) microbenchmark (string_utf32.c)
+ *
+ * Mirrors the runtime calls a character-at-a-time BASIC loop makes:
+ *
+ *   samm_enter_scope()
+ *     64 x  c$ = MID$(s$, i, 1)    : IF c$ = "o" ...
+ *     64 x  p$ = LEFT$(s$, 1..12)
+ *     64 x  h$ = CHR$(65 + i MOD 26)
+ *     (each result string_release()d after use)
+ *   samm_exit_scope()
+ *
+ * Every result is at most SSO_THRESHOLD ASCII characters, so it is stored
+ * in the descriptor's inline buffer and the loop makes no malloc/free
+ * calls for character data.  A second round builds 40-character strings,
+ * which still take the heap path, for comparison.
+ *
+ * The benchmark also checks that short results really are inline and
+ * that string_to_utf8() hands back the inline buffer.
+ *
+ * Build:
+ *   cc -O2 \
+ *      -I fsh/FasterBASICT/runtime_c \
+ *      performance_tests/bench_string_sso.c \
+ *      fsh/FasterBASICT/runtime_c/samm_core.c \
+ *      fsh/FasterBASICT/runtime_c/samm_pool.c \
+ *      fsh/FasterBASICT/runtime_c/list_ops.c \
+ *      fsh/FasterBASICT/runtime_c/string_utf32.c \
+ *      fsh/FasterBASICT/runtime_c/string_simd.c \
+ *      fsh/FasterBASICT/runtime_c/string_pool.c \
+ *      fsh/FasterBASICT/runtime_c/array_descriptor_runtime.c \
+ *      -lpthread -lm \
+ *      -o performance_tests/bench_string_sso
+ *   ./performance_tests/bench_string_sso [passes]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "samm_bridge.h"
+#include "string_descriptor.h"
+
+#define DEFAULT_PASSES  200000
+#define LINE_TEXT       "the quick brown fox jumps over the lazy dog and keeps on running"
+#define LINE_LENGTH     64
+#define LONG_LENGTH     40
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int check(int ok, const char* what) {
+    printf("  %-48s %s\n", what, ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+/* One pass over the line: MID$ / LEFT$ / CHR$ per character. */
+static long scan_short(StringDescriptor* line, StringDescriptor* letter_o) {
+    long n = 0;
+    samm_enter_scope();
+    for (int64_t i = 0; i < LINE_LENGTH; i++) {
+        StringDescriptor* c = string_mid(line, i, 1);
+        if (string_compare(c, letter_o) == 0) n++;
+        string_release(c);
+
+        StringDescriptor* p = string_left(line, (i % 12) + 1);
+        n += p->length;
+        string_release(p);
+
+        StringDescriptor* h = basic_chr((uint32_t)(65 + (i % 26)));
+        if (string_to_utf8(h)[0] == 'Z') n++;
+        string_release(h);
+    }
+    samm_exit_scope();
+    return n;
+}
+
+/* Same shape, but every result is too long to be stored inline. */
+static long scan_long(StringDescriptor* line) {
+    long n = 0;
+    samm_enter_scope();
+    for (int64_t i = 0; i < LINE_LENGTH; i++) {
+        StringDescriptor* p = string_mid(line, i % (LINE_LENGTH - LONG_LENGTH), LONG_LENGTH);
+        n += p->length;
+        string_release(p);
+    }
+    samm_exit_scope();
+    return n;
+}
+
+int main(int argc, char** argv) {
+    long passes = DEFAULT_PASSES;
+    if (argc > 1) {
+        passes = atol(argv[1]);
+        if (passes <= 0) passes = DEFAULT_PASSES;
+    }
+
+    samm_init();
+
+    printf("Short-string (SSO) benchmark: %ld passes over a %d-char line\n\n",
+           passes, LINE_LENGTH);
+
+    StringDescriptor* line = string_new_ascii(LINE_TEXT);
+    StringDescriptor* letter_o = string_new_ascii("o");
+
+    double t0 = now_seconds();
+    long total = 0;
+    for (long k = 0; k < passes; k++) {
+        total += scan_short(line, letter_o);
+    }
+    double t1 = now_seconds();
+    for (long k = 0; k < passes; k++) {
+        total += scan_long(line);
+    }
+    double t2 = now_seconds();
+
+    double short_ops = (double)passes * LINE_LENGTH * 3;
+    double long_ops  = (double)passes * LINE_LENGTH;
+    printf("  1-12 char results (inline): %7.3f s  = %6.1f ns/string\n",
+           t1 - t0, (t1 - t0) / short_ops * 1e9);
+    printf("  %d char results (heap):     %7.3f s  = %6.1f ns/string\n",
+           LONG_LENGTH, t2 - t1, (t2 - t1) / long_ops * 1e9);
+    printf("  checksum: %ld\n\n", total);
+
+    int failures = 0;
+    StringDescriptor* one = basic_chr('A');
+    StringDescriptor* max = string_left(line, SSO_THRESHOLD);
+    StringDescriptor* big = string_left(line, SSO_THRESHOLD + 1);
+    StringDescriptor* wide = basic_chr(0x263A);
+    failures += check(string_is_inline(one), "CHR$ result stored inline");
+    failures += check(string_is_inline(max), "SSO_THRESHOLD chars stored inline");
+    failures += check(!string_is_inline(big), "SSO_THRESHOLD+1 chars on the heap");
+    failures += check(!string_is_inline(wide), "UTF-32 string on the heap");
+    failures += check(string_to_utf8(max) == (const char*)max->data,
+                      "string_to_utf8 returns the inline buffer");
+    string_promote_to_utf32(one);
+    failures += check(!string_is_inline(one) && string_char_at(one, 0) == 'A',
+                      "promotion moves inline chars to the heap");
+    string_release(one);
+    string_release(max);
+    string_release(big);
+    string_release(wide);
+
+    string_release(letter_o);
+    string_release(line);
+    samm_shutdown();
+
+    printf("\n%s\n", failures ? "FAILED" : "ALL PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,162 @@
+/*
+ * bench_worker_pool.c
+ * WORKER benchmark (zig_compiler/runtime/worker_runtime.c)
+ *
+ * Spawns N tiny workers (default 100000) and awaits them all, the way
+ *
+ *   FOR i = 1 TO N : f(i) = SPAWN Tiny(i) : NEXT i
+ *   FOR i = 1 TO N : total = total + AWAIT f(i) : NEXT i
+ *
+ * runs, in batches of up to `batch` futures in flight (default 1000):
+ *
+ *   thread    the previous lowering, reproduced below as old_*: one
+ *             pthread_create per SPAWN, pthread_join in AWAIT
+ *   pool      worker_spawn / worker_await on the persistent pool
+ *
+ * and then once more on the pool with every future in flight at once
+ * (the thread-per-worker version cannot do this with 100k threads).
+ * Each run's sum of results is checked against the closed form.
+ *
+ * The messaging queues live in messaging.zig; plain SPAWN never touches
+ * them, so they are stubbed out here.
+ *
+ * Build:
+ *   cc -O2 \
+ *      -I zig_compiler/runtime \
+ *      performance_tests/bench_worker_pool.c \
+ *      zig_compiler/runtime/worker_runtime.c \
+ *      -lpthread \
+ *      -o performance_tests/bench_worker_pool
+ *   ./performance_tests/bench_worker_pool [workers] [batch]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* ── worker_runtime.c API ─────────────────────────────────────────── */
+
+typedef struct WorkerArgs   WorkerArgs;
+typedef struct FutureHandle FutureHandle;
+
+extern WorkerArgs   *worker_args_alloc(int32_t num_args);
+extern void          worker_args_set_double(WorkerArgs *args, int32_t index, double value);
+extern FutureHandle *worker_spawn(void *func_ptr, WorkerArgs *args,
+                                  int32_t num_args, int32_t ret_type);
+extern double        worker_await(FutureHandle *handle);
+
+/* ── Messaging stubs ──────────────────────────────────────────────── */
+
+typedef struct MessageQueue MessageQueue;
+
+MessageQueue *msg_queue_create(void) { return NULL; }
+void msg_queue_destroy(MessageQueue *q) { (void)q; }
+void msg_queue_close(MessageQueue *q) { (void)q; }
+void msg_drain_and_destroy(MessageQueue *outbox, MessageQueue *inbox) {
+    (void)outbox;
+    (void)inbox;
+}
+
+/* ── The worker ───────────────────────────────────────────────────── */
+
+static double tiny(double x) {
+    return x * 2.0 + 1.0;
+}
+
+/* ── Old lowering: one thread per SPAWN ───────────────────────────── */
+
+typedef struct {
+    pthread_t thread;
+    double    arg;
+    double    result;
+} OldFuture;
+
+static void *old_entry(void *ctx) {
+    OldFuture *f = (OldFuture *)ctx;
+    f->result = tiny(f->arg);
+    return NULL;
+}
+
+static OldFuture *old_spawn(double arg) {
+    OldFuture *f = (OldFuture *)calloc(1, sizeof(OldFuture));
+    f->arg = arg;
+    pthread_create(&f->thread, NULL, old_entry, f);
+    return f;
+}
+
+static double old_await(OldFuture *f) {
+    pthread_join(f->thread, NULL);
+    double r = f->result;
+    free(f);
+    return r;
+}
+
+/* ── Timing ───────────────────────────────────────────────────────── */
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static void report(const char *name, long n, double ms, double sum, double expect) {
+    printf("  %-24s %10.1f ms  %8.2f us/worker  %s\n",
+           name, ms, ms * 1e3 / (double)n, sum == expect ? "ok" : "WRONG SUM");
+    if (sum != expect) exit(1);
+}
+
+int main(int argc, char **argv) {
+    long n     = argc > 1 ? atol(argv[1]) : 100000;
+    long batch = argc > 2 ? atol(argv[2]) : 1000;
+    if (n < 1) n = 1;
+    if (batch < 1) batch = 1;
+    if (batch > n) batch = n;
+
+    /* sum of 2i+1 for i = 0..n-1 */
+    double expect = (double)n * (double)n;
+
+    OldFuture    **old = (OldFuture **)malloc((size_t)batch * sizeof(*old));
+    FutureHandle **fut = (FutureHandle **)malloc((size_t)n * sizeof(*fut));
+    if (!old || !fut) return 1;
+
+    printf("%ld workers, %ld in flight\n", n, batch);
+
+    double t0 = now_ms(), sum = 0.0;
+    for (long base = 0; base < n; base += batch) {
+        long m = n - base < batch ? n - base : batch;
+        for (long i = 0; i < m; i++) old[i] = old_spawn((double)(base + i));
+        for (long i = 0; i < m; i++) sum += old_await(old[i]);
+    }
+    report("thread per worker", n, now_ms() - t0, sum, expect);
+
+    t0 = now_ms();
+    sum = 0.0;
+    for (long base = 0; base < n; base += batch) {
+        long m = n - base < batch ? n - base : batch;
+        for (long i = 0; i < m; i++) {
+            WorkerArgs *args = worker_args_alloc(1);
+            worker_args_set_double(args, 0, (double)(base + i));
+            fut[i] = worker_spawn((void *)tiny, args, 1, 0);
+        }
+        for (long i = 0; i < m; i++) sum += worker_await(fut[i]);
+    }
+    report("pool", n, now_ms() - t0, sum, expect);
+
+    t0 = now_ms();
+    sum = 0.0;
+    for (long i = 0; i < n; i++) {
+        WorkerArgs *args = worker_args_alloc(1);
+        worker_args_set_double(args, 0, (double)i);
+        fut[i] = worker_spawn((void *)tiny, args, 1, 0);
+    }
+    for (long i = 0; i < n; i++) sum += worker_await(fut[i]);
+    report("pool, all in flight", n, now_ms() - t0, sum, expect);
+
+    free(old);
+    free(fut);
+    return 0;
+}
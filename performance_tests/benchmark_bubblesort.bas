@@ -3,8 +3,8 @@
 
 PRINT "Running Bubblesort (1000 items, 100 iterations)..."
 
-DIM size AS INTEGER
-size = 1000
+DIM n AS INTEGER
+n = 1000
 
 ' Allocate slightly more to be safe with 1-based indexing
 DIM arr(1005) AS INTEGER
@@ -12,18 +12,21 @@ DIM arr(1005) AS INTEGER
 DIM i AS INTEGER
 DIM j AS INTEGER
 DIM iter AS INTEGER
+DIM tmp AS INTEGER
 
 FOR iter = 1 TO 100
     ' Fill array with reverse ordered data (Worst case for Bubble Sort)
-    FOR i = 1 TO size
-        arr(i) = size - i
+    FOR i = 1 TO n
+        arr(i) = n - i
     NEXT i
 
     ' Bubble Sort Algorithm
-    FOR i = 1 TO size - 1
-        FOR j = 1 TO size - i
+    FOR i = 1 TO n - 1
+        FOR j = 1 TO n - i
             IF arr(j) > arr(j + 1) THEN
-                SWAP arr(j), arr(j + 1)
+                tmp = arr(j)
+                arr(j) = arr(j + 1)
+                arr(j + 1) = tmp
             END IF
         NEXT j
     NEXT i
@@ -31,7 +34,7 @@ NEXT iter
 
 ' Verify result of the last iteration
 PRINT "Verifying sort..."
-FOR i = 1 TO size - 1
+FOR i = 1 TO n - 1
     IF arr(i) > arr(i + 1) THEN
         PRINT "Error: Sort failed at index "; i; " ("; arr(i); " > "; arr(i + 1); ")"
     END IF
@@ -0,0 +1,17 @@
+' Iterative Fibonacci Benchmark, GLOBAL variables
+' Same work as benchmark_fib_iterative.bas with every variable a GLOBAL
+
+GLOBAL a%, b%, temp%, i%, k%, result%
+
+PRINT "Calculating Fib(40) 1,000,000 times..."
+FOR k% = 1 TO 1000000
+    a% = 0
+    b% = 1
+    FOR i% = 2 TO 40
+        temp% = a% + b%
+        a% = b%
+        b% = temp%
+    NEXT i%
+    result% = b%
+NEXT k%
+PRINT "Last Result: "; result%
@@ -4,8 +4,8 @@
 
 PRINT "Running Sieve of Eratosthenes (5000 iterations)..."
 
-DIM Size AS INTEGER
-Size = 8190
+DIM Limit AS INTEGER
+Limit = 8190
 
 DIM flags(8191) AS INTEGER
 DIM i AS INTEGER
@@ -18,17 +18,17 @@ FOR iter = 1 TO 5000
     count = 0
 
     ' Reset flags
-    FOR i = 0 TO Size
+    FOR i = 0 TO Limit
         flags(i) = 1
     NEXT i
 
     ' Sieve
-    FOR i = 0 TO Size
+    FOR i = 0 TO Limit
         IF flags(i) = 1 THEN
             prime = i + i + 3
             k = i + prime
 
-            WHILE k <= Size
+            WHILE k <= Limit
                 flags(k) = 0
                 k = k + prime
             WEND
@@ -0,0 +1,10 @@
+' PRINT Throughput Benchmark
+' Writes 1,000,000 short lines.  Redirect the output to a file or /dev/null
+' to measure it: with buffered output the lines are written in 64 KB blocks
+' instead of one write per PRINT item.
+
+DIM i AS INTEGER
+
+FOR i = 1 TO 1000000
+    PRINT "line "; i; " of output"
+NEXT i
@@ -0,0 +1,22 @@
+' Small Function Benchmark
+' Calls a one-line FUNCTION and a DEF FN 20,000,000 times each
+
+DEF FN Wrap(v%) = v% AND 1023
+
+FUNCTION Sq(x AS INTEGER) AS INTEGER
+    Sq = x * x
+END FUNCTION
+
+PRINT "Calling Sq and FN Wrap 20,000,000 times..."
+DIM i AS INTEGER
+DIM k AS INTEGER
+DIM s AS LONG
+
+s = 0
+FOR k = 1 TO 200
+    FOR i = 1 TO 100000
+        s = s + Sq(FN Wrap(i))
+    NEXT i
+NEXT k
+
+PRINT "Sum: "; s
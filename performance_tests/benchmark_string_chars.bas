@@ -0,0 +1,36 @@
+' Character-at-a-time String Benchmark
+' Walks a 64-character line with MID$(s$, i, 1), LEFT$ and CHR$ 200,000 times.
+' Every intermediate is a 1-12 character string, so this measures the cost of
+' creating and releasing short strings (stored inline in the descriptor).
+
+FUNCTION ScanLine(s AS STRING) AS INTEGER
+    DIM i AS INTEGER
+    DIM n AS INTEGER
+
+    n = 0
+    FOR i = 1 TO LEN(s)
+        IF MID$(s, i, 1) = "o" THEN
+            n = n + 1
+        END IF
+        n = n + LEN(LEFT$(s, (i MOD 12) + 1))
+        IF CHR$(65 + (i MOD 26)) = "Z" THEN
+            n = n + 1
+        END IF
+    NEXT i
+    ScanLine = n
+END FUNCTION
+
+PRINT "Scanning a 64-char line character by character (200,000 passes)..."
+
+DIM text AS STRING
+DIM total AS INTEGER
+DIM k AS INTEGER
+
+text = "the quick brown fox jumps over the lazy dog and keeps on running"
+total = 0
+
+FOR k = 1 TO 200000
+    total = total + ScanLine(text)
+NEXT k
+
+PRINT "Total: "; total
@@ -0,0 +1,25 @@
+' Substring Scan Benchmark
+' Slides a 24-character MID$ window across a 2,280-character string 500 times
+' and compares each window with a pattern.  The substrings only live for the
+' IF condition, so they are views of text$ rather than copies.
+
+PRINT "Scanning 2,280 characters with a 24-char MID$ window (500 passes)..."
+
+DIM text$
+DIM i AS INTEGER
+DIM k AS INTEGER
+DIM hits AS INTEGER
+
+text$ = ""
+FOR i = 1 TO 40
+    text$ = text$ + "alpha beta gamma delta epsilon zeta eta theta iota kappa "
+NEXT i
+
+hits = 0
+FOR k = 1 TO 500
+    FOR i = 1 TO LEN(text$) - 24
+        IF MID$(text$, i, 24) = "theta iota kappa alpha b" THEN hits = hits + 1
+    NEXT i
+NEXT k
+
+PRINT "Hits: "; hits
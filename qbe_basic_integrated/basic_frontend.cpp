@@ -12,6 +12,8 @@ extern "C" void set_trace_cfg_impl(int enable);
 extern "C" void set_trace_ast_impl(int enable);
 extern "C" void set_trace_symbols_impl(int enable);
 extern "C" void set_show_il_impl(int enable);
+extern "C" void set_profile_impl(int enable);
+extern "C" void set_bce_report_impl(int enable);
 
 extern "C" {
 
@@ -92,4 +94,14 @@ void set_show_il(int enable) {
     set_show_il_impl(enable);
 }
 
+/* Report per-phase compile times and codegen counters */
+void set_profile(int enable) {
+    set_profile_impl(enable);
+}
+
+/* Report which array subscripts kept their bounds checks */
+void set_bce_report(int enable) {
+    set_bce_report_impl(enable);
+}
+
 }  // extern "C"
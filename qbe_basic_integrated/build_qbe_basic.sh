@@ -66,6 +66,7 @@ printf '%s\n' \
     "$FASTERBASIC_SRC/cfg/cfg_builder_exception.cpp" \
     "$FASTERBASIC_SRC/cfg/cfg_builder_functions.cpp" \
     "$FASTERBASIC_SRC/cfg/cfg_builder_edges.cpp" \
+    "$FASTERBASIC_SRC/cfg/cfg_bounds_analysis.cpp" \
     "$FASTERBASIC_SRC/fasterbasic_data_preprocessor.cpp" \
     "$FASTERBASIC_SRC/fasterbasic_ast_dump.cpp" \
     "$FASTERBASIC_SRC/modular_commands.cpp" \
@@ -176,7 +177,7 @@ fi
 # Compile QBE C sources in parallel
 echo "  Compiling QBE core..."
 printf '%s\n' \
-    main.c parse.c ssa.c live.c copy.c fold.c simpl.c ifopt.c gcm.c gvn.c \
+    main.c parse.c ssa.c live.c copy.c fold.c simpl.c ifopt.c gcm.c gvn.c licm.c gpromote.c inline.c \
     mem.c alias.c load.c util.c rega.c emit.c cfg.c abi.c spill.c \
 | xargs -n 1 -P "$NUM_JOBS" -I {} cc -std=c99 -O2 -c {}
 
@@ -211,7 +212,7 @@ echo "  ✓ QBE objects built"
 echo "Linking fbc_qbe compiler..."
 
 clang++ -O2 -o "$PROJECT_ROOT/fbc_qbe" \
-    main.o parse.o ssa.o live.o copy.o fold.o simpl.o ifopt.o gcm.o gvn.o \
+    main.o parse.o ssa.o live.o copy.o fold.o simpl.o ifopt.o gcm.o gvn.o licm.o gpromote.o inline.o \
     mem.o alias.o load.o util.o rega.o emit.o cfg.o abi.o spill.o \
     amd64/*.o \
     arm64/*.o \
@@ -8,6 +8,9 @@
 #include <fstream>
 #include <cstring>
 #include <cstdlib>
+#include <chrono>
+#include <iomanip>
+#include <vector>
 
 #include "fasterbasic_lexer.h"
 #include "fasterbasic_parser.h"
@@ -28,6 +31,35 @@ static bool g_traceAST = false;
 static bool g_traceSymbols = false;
 static bool g_showIL = false;
 static bool g_verbose = false;
+static bool g_profile = false;
+static bool g_bceReport = false;
+
+// --profile: wall-clock time of each front-end phase
+class PhaseTimer {
+public:
+    void mark(const char* phase) {
+        auto now = std::chrono::steady_clock::now();
+        phases_.emplace_back(phase, std::chrono::duration<double, std::milli>(now - last_).count());
+        last_ = now;
+    }
+
+    void report(std::ostream& out) const {
+        double total = 0.0;
+        out << std::fixed << std::setprecision(3);
+        for (const auto& p : phases_) {
+            out << "  " << std::left << std::setw(10) << (std::string(p.first) + ":")
+                << std::right << std::setw(10) << p.second << " ms\n";
+            total += p.second;
+        }
+        out << "  " << std::left << std::setw(10) << "total:"
+            << std::right << std::setw(10) << total << " ms\n";
+        out.unsetf(std::ios::floatfield);
+    }
+
+private:
+    std::chrono::steady_clock::time_point last_ = std::chrono::steady_clock::now();
+    std::vector<std::pair<const char*, double>> phases_;
+};
 
 extern "C" {
 
@@ -60,6 +92,8 @@ char* compile_basic_to_qbe_string(const char *basic_path) {
                            std::istreambuf_iterator<char>());
         file.close();
         
+        PhaseTimer timer;
+
         // Preprocess DATA statements
         DataPreprocessor dataPreprocessor;
         DataPreprocessorResult dataResult = dataPreprocessor.process(source);
@@ -95,6 +129,7 @@ char* compile_basic_to_qbe_string(const char *basic_path) {
         Lexer lexer;
         lexer.tokenize(source);
         auto tokens = lexer.getTokens();
+        timer.mark("lex");
         
         // Parser
         SemanticAnalyzer semantic;
@@ -112,6 +147,7 @@ char* compile_basic_to_qbe_string(const char *basic_path) {
             }
             return nullptr;
         }
+        timer.mark("parse");
         
         // Semantic analysis
         const auto& compilerOptions = parser.getOptions();
@@ -125,6 +161,7 @@ char* compile_basic_to_qbe_string(const char *basic_path) {
             }
             return nullptr;
         }
+        timer.mark("semantic");
         
         // Debug: Dump AST if requested
         if (g_traceAST || getenv("TRACE_AST")) {
@@ -175,6 +212,7 @@ char* compile_basic_to_qbe_string(const char *basic_path) {
             std::cerr << "[ERROR] ProgramCFG build failed\n";
             return nullptr;
         }
+        timer.mark("cfg");
         
         if (g_verbose) {
             std::cerr << "[INFO] ProgramCFG build successful!\n";
@@ -243,8 +281,46 @@ char* compile_basic_to_qbe_string(const char *basic_path) {
         fbc::QBECodeGeneratorV2 codegen(semantic);
         codegen.setDataValues(dataResult);  // Pass DATA values to code generator
         std::string qbeIL = codegen.generateProgram(ast.get(), programCFG);
+        timer.mark("codegen");
         
         delete programCFG;
+
+        if (g_profile) {
+            const auto& samm = codegen.getASTEmitter().getSAMMElisionStats();
+            std::cerr << "\n=== Compile profile: " << basic_path << " ===\n";
+            timer.report(std::cerr);
+            std::cerr << "SAMM tracking elided:\n";
+            std::cerr << "  scopes elided:           " << samm.scopesElided << " of "
+                      << samm.functionsAnalyzed << " SUB/FUNCTION bodies\n";
+            std::cerr << "  literal track calls:     " << samm.literalTracksElided << "\n";
+            std::cerr << "  temporaries released:    " << samm.tempsReleased << "\n";
+            std::cerr << "\n";
+        }
+
+        if (g_bceReport) {
+            // --bce-report: every subscript whose check was not eliminated
+            using CheckKind = BoundsCheckAnalysis::CheckKind;
+            const auto& records = codegen.getASTEmitter().getBoundsCheckRecords();
+            int eliminated = 0, preLoop = 0, kept = 0;
+            for (const auto& r : records) {
+                if (r.kind == CheckKind::NONE) eliminated++;
+                else if (r.kind == CheckKind::PRE_LOOP) preLoop++;
+                else kept++;
+            }
+            std::cerr << "\n=== Bounds checks: " << basic_path << " ===\n";
+            std::cerr << "  eliminated:  " << eliminated << "\n";
+            std::cerr << "  pre-loop:    " << preLoop << "\n";
+            std::cerr << "  kept:        " << kept << "\n";
+            for (const auto& r : records) {
+                if (r.kind == CheckKind::NONE) continue;
+                std::cerr << "  line " << r.line << " (" << r.function << "): "
+                          << BoundsCheckAnalysis::sourceName(r.array) << " subscript " << (r.dimension + 1) << ": "
+                          << (r.kind == CheckKind::PRE_LOOP ? "checked once before the loop"
+                                                            : "checked, " + r.reason)
+                          << "\n";
+            }
+            std::cerr << "\n";
+        }
         
         if (qbeIL.empty()) {
             std::cerr << "[ERROR] Code generation produced empty IL\n";
@@ -298,6 +374,16 @@ void set_show_il_impl(int enable) {
     }
 }
 
+/* Enable/disable compile-phase profiling report */
+void set_profile_impl(int enable) {
+    g_profile = (enable != 0);
+}
+
+/* Enable/disable the bounds-check elimination report */
+void set_bce_report_impl(int enable) {
+    g_bceReport = (enable != 0);
+}
+
 /* Enable/disable verbose output */
 void set_verbose_impl(int enable) {
     g_verbose = (enable != 0);
@@ -195,6 +195,7 @@ enum {
 #define isstore(o) INRANGE(o, Ostoreb, Ostored)
 #define isload(o) INRANGE(o, Oloadsb, Oload)
 #define isneonstore(o) ((o) == Oneonstr || (o) == Oneonstr2)
+#define isneonload(o) ((o) == Oneonldr || (o) == Oneonldr2 || (o) == Oneonldr3)
 #define isalloc(o) INRANGE(o, Oalloc4, Oalloc16)
 #define isext(o) INRANGE(o, Oextsb, Oextuw)
 #define ispar(o) INRANGE(o, Opar, Opare)
@@ -602,6 +603,16 @@ void gvn(Fn *);
 int pinned(Ins *);
 void gcm(Fn *);
 
+/* gpromote.c */
+void gpromote(Fn *);
+
+/* inline.c */
+void inlinefns(Fn **, uint, FILE *);
+
+/* licm.c */
+void licm(Fn *);
+void licmfin(FILE *);
+
 /* ifopt.c */
 void ifconvert(Fn *fn);
 
@@ -0,0 +1,412 @@
+#include "all.h"
+
+/* Global scalar promotion
+ *
+ * FasterBASIC keeps GLOBAL and SHARED scalars in data
+ * symbols, so promote() leaves every access to them in
+ * memory.  In a natural loop without calls, a symbol that
+ * the loop stores to is given a stack slot instead: it is
+ * loaded into the slot at the end of the preheader, every
+ * access in the loop goes to the slot, and the slot is
+ * written back at the start of each block the loop exits
+ * to.  promote() and ssa() then turn the slot into
+ * temporaries.  Loads of symbols the loop only reads are
+ * left to licm().
+ *
+ * A call anywhere in the loop may read or write the
+ * symbol, so such loops are skipped; the write-back at the
+ * exits is what happens "before the call" in the code that
+ * follows them.  Loads and stores through pointers other
+ * than stack slots only disqualify symbols whose address is
+ * used for something other than a plain load or store in
+ * the function (FasterBASIC never keeps a global's address
+ * in memory): through an alias, a load would miss the value
+ * held in the slot and a store would be overwritten by the
+ * write-back.
+ *
+ * Only used for IL produced by the BASIC frontend.
+ */
+
+typedef struct Cand Cand;
+
+struct Cand {
+	Sym sym;
+	int sz;    /* access size */
+	int cls;   /* class of the stores */
+	int bad;
+	Ref slot;
+};
+
+static char *inloop;   /* per block id */
+static Sym *escsym;    /* symbols whose address escapes */
+static uint nescsym;
+static Cand *cand;
+static uint ncand;
+
+/* the symbol of a global scalar address */
+static int
+symof(Fn *fn, Ref r, Sym *s)
+{
+	Con *c;
+
+	if (rtype(r) != RCon)
+		return 0;
+	c = &fn->con[r.val];
+	if (c->type != CAddr || c->sym.type != SGlo || c->bits.i != 0)
+		return 0;
+	*s = c->sym;
+	return 1;
+}
+
+static int
+symesc(Sym s)
+{
+	uint n;
+
+	for (n=0; n<nescsym; n++)
+		if (symeq(escsym[n], s))
+			return 1;
+	return 0;
+}
+
+static void
+markesc(Fn *fn, Ref r)
+{
+	Con *c;
+
+	if (rtype(r) != RCon)
+		return;
+	c = &fn->con[r.val];
+	if (c->type != CAddr || symesc(c->sym))
+		return;
+	vgrow(&escsym, ++nescsym);
+	escsym[nescsym-1] = c->sym;
+}
+
+static void
+fillesc(Fn *fn)
+{
+	Blk *b;
+	Ins *i;
+	Sym s;
+
+	nescsym = 0;
+	for (b=fn->start; b; b=b->link) {
+		for (i=b->ins; i<&b->ins[b->nins]; i++) {
+			if (isload(i->op)) {
+				if (!symof(fn, i->arg[0], &s))
+					markesc(fn, i->arg[0]);
+				continue;
+			}
+			if (isstore(i->op)) {
+				markesc(fn, i->arg[0]);
+				if (!symof(fn, i->arg[1], &s))
+					markesc(fn, i->arg[1]);
+				continue;
+			}
+			markesc(fn, i->arg[0]);
+			markesc(fn, i->arg[1]);
+		}
+		markesc(fn, b->jmp.arg);
+	}
+}
+
+static int
+isslot(Fn *fn, Ref r)
+{
+	Ins *i;
+
+	if (rtype(r) != RTmp)
+		return 0;
+	i = fn->tmp[r.val].def;
+	return fn->tmp[r.val].ndef == 1 && i && isalloc(i->op);
+}
+
+static Cand *
+getcand(Sym s)
+{
+	uint n;
+
+	for (n=0; n<ncand; n++)
+		if (symeq(cand[n].sym, s))
+			return &cand[n];
+	vgrow(&cand, ++ncand);
+	cand[ncand-1] = (Cand){.sym = s, .sz = -1, .cls = -1};
+	return &cand[ncand-1];
+}
+
+static void
+markloop(Blk *hd, Blk *b, int *ok)
+{
+	uint p;
+
+	if (inloop[b->id])
+		return;
+	if (b->id < hd->id || !dom(hd, b)) {
+		*ok = 0;
+		return;
+	}
+	inloop[b->id] = 1;
+	for (p=0; p<b->npred; p++)
+		markloop(hd, b->pred[p], ok);
+}
+
+/* prepend (at = 0) or append (at = 1) n instructions */
+static void
+insert(Blk *b, Ins *ins, uint n, int at)
+{
+	Ins *i;
+
+	i = vnew(b->nins + n, sizeof(Ins), PFn);
+	if (at)
+		icpy(icpy(i, b->ins, b->nins), ins, n);
+	else
+		icpy(icpy(i, ins, n), b->ins, b->nins);
+	b->ins = i;
+	b->nins += n;
+}
+
+static Ref
+symref(Fn *fn, Sym s)
+{
+	Con c;
+
+	memset(&c, 0, sizeof c);
+	c.type = CAddr;
+	c.sym = s;
+	return newcon(&c, fn);
+}
+
+/* load from src and store to dst, through a fresh temporary */
+static void
+copymem(Fn *fn, Ins *ins, Cand *c, Ref dst, Ref src)
+{
+	Ref t;
+
+	t = newtmp("gp", c->cls, fn);
+	ins[0] = (Ins){Oload, c->cls, t, {src, R}};
+	ins[1] = (Ins){Ostorew + c->cls, Kw, R, {t, dst}};
+}
+
+/* s is only entered from the loop */
+static int
+loopexit(Blk *s)
+{
+	uint p;
+
+	for (p=0; p<s->npred; p++)
+		if (!inloop[s->pred[p]->id])
+			return 0;
+	return 1;
+}
+
+/* a new block on the edge b -> s */
+static Blk *
+split(Fn *fn, Blk *b, Blk *s)
+{
+	Blk *b1;
+
+	b1 = newblk();
+	strf(b1->name, "%s_%s", b->name, s->name);
+	b1->jmp.type = Jjmp;
+	b1->s1 = s;
+	b1->link = b->link;
+	b->link = b1;
+	if (b->s1 == s)
+		b->s1 = b1;
+	if (b->s2 == s)
+		b->s2 = b1;
+	fn->nblk++;
+	return b1;
+}
+
+static uint
+promloop(Fn *fn, Blk *hd)
+{
+	Blk *b, *ph, *s;
+	Ins *i, ins[2];
+	Sym sym;
+	Cand *c;
+	Ref *addr;
+	uint n, p, e, np, unk, nblk;
+	int ok;
+
+	memset(inloop, 0, fn->nblk);
+	ok = 1;
+	inloop[hd->id] = 1;
+	for (p=0; p<hd->npred; p++)
+		if (hd->pred[p]->id >= hd->id)
+			markloop(hd, hd->pred[p], &ok);
+	if (!ok)
+		return 0;
+
+	/* a single preheader that only jumps to the header */
+	ph = 0;
+	for (p=0; p<hd->npred; p++)
+		if (!inloop[hd->pred[p]->id]) {
+			if (ph)
+				return 0;
+			ph = hd->pred[p];
+		}
+	if (!ph || ph->s1 != hd || ph->s2)
+		return 0;
+
+	/* symbols stored to, with uniform accesses */
+	ncand = 0;
+	unk = 0;
+	for (n=hd->id; n<fn->nblk; n++) {
+		if (!inloop[n])
+			continue;
+		b = fn->rpo[n];
+		for (i=b->ins; i<&b->ins[b->nins]; i++) {
+			if (i->op == Ocall || i->op == Ovastart || i->op == Ovaarg)
+				return 0;
+			if (isload(i->op)) {
+				if (!symof(fn, i->arg[0], &sym)
+				&& !isslot(fn, i->arg[0]))
+					unk = 1;
+			} else if (isstore(i->op)) {
+				if (!symof(fn, i->arg[1], &sym)) {
+					if (!isslot(fn, i->arg[1]))
+						unk = 1;
+					continue;
+				}
+				c = getcand(sym);
+				if ((c->sz != -1 && c->sz != storesz(i))
+				|| (c->cls != -1 && c->cls != optab[i->op].argcls[0][0]))
+					c->bad = 1;
+				c->sz = storesz(i);
+				c->cls = optab[i->op].argcls[0][0];
+			} else if (isneonstore(i->op) || isneonload(i->op)
+			|| i->op == Oblit0)
+				unk = 1;
+		}
+	}
+	if (!ncand)
+		return 0;
+	for (n=hd->id; n<fn->nblk; n++) {
+		if (!inloop[n])
+			continue;
+		b = fn->rpo[n];
+		for (i=b->ins; i<&b->ins[b->nins]; i++)
+			if (isload(i->op) && symof(fn, i->arg[0], &sym))
+			for (c=cand; c<&cand[ncand]; c++)
+				if (symeq(c->sym, sym) && loadsz(i) != c->sz)
+					c->bad = 1;
+	}
+
+	/* redirect the accesses to stack slots */
+	np = 0;
+	for (c=cand; c<&cand[ncand]; c++) {
+		if (c->bad || (c->sz != 4 && c->sz != 8)
+		|| (unk && symesc(c->sym))) {
+			c->bad = 1;
+			continue;
+		}
+		c->slot = newtmp("gp", Kl, fn);
+		ins[0] = (Ins){c->sz == 8 ? Oalloc8 : Oalloc4, Kl, c->slot,
+			{getcon(c->sz, fn), R}};
+		insert(fn->start, ins, 1, 1);
+		np++;
+	}
+	if (!np)
+		return 0;
+	for (n=hd->id; n<fn->nblk; n++) {
+		if (!inloop[n])
+			continue;
+		b = fn->rpo[n];
+		for (i=b->ins; i<&b->ins[b->nins]; i++) {
+			if (isload(i->op))
+				addr = &i->arg[0];
+			else if (isstore(i->op))
+				addr = &i->arg[1];
+			else
+				continue;
+			if (!symof(fn, *addr, &sym))
+				continue;
+			for (c=cand; c<&cand[ncand]; c++)
+				if (!c->bad && symeq(c->sym, sym))
+					*addr = c->slot;
+		}
+	}
+
+	/* fill the slots in the preheader, write them back at the exits */
+	for (c=cand; c<&cand[ncand]; c++) {
+		if (c->bad)
+			continue;
+		copymem(fn, ins, c, c->slot, symref(fn, c->sym));
+		insert(ph, ins, 2, 1);
+	}
+	/* split() adds blocks past the end of rpo and inloop */
+	nblk = fn->nblk;
+	for (n=hd->id; n<nblk; n++) {
+		if (!inloop[n])
+			continue;
+		b = fn->rpo[n];
+		for (e=0; e<2; e++) {
+			s = e ? b->s2 : b->s1;
+			if (!s || inloop[s->id] || s->visit)
+				continue;
+			if (!loopexit(s))
+				s = split(fn, b, s);
+			s->visit = 1;
+			for (c=cand; c<&cand[ncand]; c++) {
+				if (c->bad)
+					continue;
+				copymem(fn, ins, c, symref(fn, c->sym), c->slot);
+				insert(s, ins, 2, 0);
+			}
+		}
+	}
+	if (debug['M'])
+		for (c=cand; c<&cand[ncand]; c++)
+			if (!c->bad)
+				fprintf(stderr, "gpromote: $%s in loop @%s\n",
+					str(c->sym.id), hd->name);
+	return np;
+}
+
+/* requires rpo, preds, dom and use
+ * maintains rpo, preds and dom
+ * breaks use
+ */
+void
+gpromote(Fn *fn)
+{
+	Blk *b;
+	uint n, p, np;
+
+	escsym = vnew(0, sizeof escsym[0], PHeap);
+	cand = vnew(0, sizeof cand[0], PHeap);
+	fillesc(fn);
+
+	/* outer loops first; an inner loop then finds the
+	 * symbols of its enclosing loop already in slots;
+	 * blocks added on exit edges need a fresh cfg */
+	np = 0;
+Again:
+	inloop = alloc(fn->nblk);
+	for (b=fn->start; b; b=b->link)
+		b->visit = 0;
+	for (n=0; n<fn->nblk; n++) {
+		b = fn->rpo[n];
+		for (p=0; p<b->npred; p++)
+			if (b->pred[p]->id >= n) {
+				if (promloop(fn, b)) {
+					np++;
+					fillcfg(fn);
+					filldom(fn);
+					goto Again;
+				}
+				break;
+			}
+	}
+
+	vfree(escsym);
+	vfree(cand);
+
+	if (debug['M'] && np) {
+		fprintf(stderr, "\n> After global promotion:\n");
+		printfn(fn, stderr);
+	}
+}
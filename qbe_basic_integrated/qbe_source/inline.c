@@ -0,0 +1,432 @@
+#include "all.h"
+
+/* Inlining of small functions
+ *
+ * The BASIC frontend emits every SUB, FUNCTION and DEF FN
+ * as a function of its own, so a one-line accessor costs a
+ * call plus the samm_enter_scope()/samm_exit_scope() pair
+ * around its body.  inlinefns() sees all the functions of
+ * the program at once, straight after parsing, and copies
+ * the bodies of small ones into their callers.
+ *
+ * The call graph is made of the direct calls between the
+ * parsed functions (one per entry of the frontend's
+ * ProgramCFG::functionCFGs, plus main).  Functions on a
+ * cycle are never inlined, and callers are processed after
+ * their callees so that chains of small functions collapse.
+ *
+ * A callee that calls nothing but the SAMM scope functions
+ * cannot allocate anything the scope would have to release,
+ * so the scope calls are dropped from the inlined copy.
+ *
+ * Only used for IL produced by the BASIC frontend.
+ */
+
+enum {
+	MaxCost = 64,    /* instructions in an inlined body */
+	MaxBlk = 16,     /* blocks in an inlined body */
+	MaxGrow = 1024,  /* instructions added to one caller */
+};
+
+typedef struct Site Site;
+
+struct Site {
+	Fn *caller;
+	Fn *callee;
+	uint n;
+};
+
+static Fn **fns;
+static uint nfn;
+static char *calls;    /* calls[f*nfn+g]: fns[f] calls fns[g] */
+static int *cost;      /* -1 if not inlinable */
+static char *nosamm;   /* the scope calls can be dropped */
+static char *visit;
+static Site *site;
+static uint nsite;
+static uint nsamm;
+static uint ninl;
+
+static char *
+callname(Fn *fn, Ins *i)
+{
+	Con *c;
+
+	if (i->op != Ocall || rtype(i->arg[0]) != RCon)
+		return 0;
+	c = &fn->con[i->arg[0].val];
+	if (c->type != CAddr || c->sym.type != SGlo || c->bits.i != 0)
+		return 0;
+	return str(c->sym.id);
+}
+
+static int
+fnidx(Fn *fn, Ins *i)
+{
+	char *s;
+	uint n;
+
+	s = callname(fn, i);
+	if (!s)
+		return -1;
+	for (n=0; n<nfn; n++)
+		if (strcmp(fns[n]->name, s) == 0)
+			return n;
+	return -1;
+}
+
+static int
+isscope(Fn *fn, Ins *i)
+{
+	char *s;
+
+	s = callname(fn, i);
+	return s
+		&& (strcmp(s, "samm_enter_scope") == 0
+		|| strcmp(s, "samm_exit_scope") == 0);
+}
+
+/* the size of fn, or -1 if it cannot be inlined */
+static int
+fncost(Fn *fn, char *ns)
+{
+	Blk *b;
+	Ins *i;
+	char *s;
+	int c, nb;
+
+	if (fn->vararg || fn->retty != Kx || strcmp(fn->name, "main") == 0)
+		return -1;
+	*ns = 1;
+	c = 0;
+	nb = 0;
+	for (b=fn->start; b; b=b->link) {
+		if (b->phi || ++nb > MaxBlk)
+			return -1;
+		for (i=b->ins; i<&b->ins[b->nins]; i++) {
+			switch (i->op) {
+			case Onop:
+			case Odbgloc:
+				continue;
+			case Opar:
+				if (b != fn->start)
+					return -1;
+				continue;
+			case Ovastart:
+			case Ovaarg:
+				return -1;
+			case Ocall:
+				if (isscope(fn, i))
+					continue;
+				*ns = 0;
+				s = callname(fn, i);
+				if (s && strstr(s, "setjmp"))
+					return -1;
+				break;
+			default:
+				if (ispar(i->op))
+					return -1;
+				if (isalloc(i->op)) {
+					if (b != fn->start
+					|| rtype(i->arg[0]) != RCon)
+						return -1;
+					continue;
+				}
+				break;
+			}
+			c++;
+		}
+		if (b->jmp.type == Jretc || isretbh(b->jmp.type))
+			return -1;
+		c++;
+	}
+	return c > MaxCost ? -1 : c;
+}
+
+/* fns[g] can be reached from fns[f] */
+static int
+reach(uint f, uint g)
+{
+	uint h;
+
+	if (visit[f])
+		return 0;
+	visit[f] = 1;
+	for (h=0; h<nfn; h++)
+		if (calls[f*nfn+h] && (h == g || reach(h, g)))
+			return 1;
+	return 0;
+}
+
+static Ref
+remap(Ref r, Fn *fn, Fn *f, Ref *tmap)
+{
+	switch (rtype(r)) {
+	case RTmp:
+		if (r.val >= Tmp0)
+			return tmap[r.val];
+		break;
+	case RCon:
+		if (r.val > 1) /* UNDEF and CON_Z are shared */
+			return newcon(&f->con[r.val], fn);
+		break;
+	}
+	return r;
+}
+
+static int
+retcls(int j)
+{
+	return j == Jret0 ? -1 : j - Jretw;
+}
+
+/* the call at b->ins[k], with arguments at b->ins[a..k),
+ * is replaced by a copy of f; returns the continuation
+ */
+static Blk *
+inlcall(Fn *fn, Blk *b, uint a, uint k, Fn *f, int ns)
+{
+	Blk **bmap, *cb, *nb, *cont, *last;
+	Ins *i, *ins, *alc, call, ni;
+	Ref *tmap, *arg;
+	uint n, nins, nalc, npar;
+
+	n = 0;
+	for (cb=f->start; cb; cb=cb->link)
+		cb->id = n++;
+	bmap = alloc(n * sizeof bmap[0]);
+	tmap = alloc(f->ntmp * sizeof tmap[0]);
+	for (n=Tmp0; n<(uint)f->ntmp; n++)
+		tmap[n] = newtmp(f->tmp[n].name, f->tmp[n].cls, fn);
+	arg = alloc((k - a + 1) * sizeof arg[0]);
+	for (n=a; n<k; n++)
+		arg[n-a] = b->ins[n].arg[0];
+	call = b->ins[k];
+	ninl++;
+
+	cont = newblk();
+	strf(cont->name, "%s.i%d", b->name, ninl);
+	idup(cont, &b->ins[k+1], b->nins - (k+1));
+	cont->jmp = b->jmp;
+	cont->s1 = b->s1;
+	cont->s2 = b->s2;
+	cont->link = b->link;
+
+	for (cb=f->start; cb; cb=cb->link) {
+		nb = newblk();
+		strf(nb->name, "i%d.%s", ninl, cb->name);
+		bmap[cb->id] = nb;
+	}
+	last = b;
+	ins = vnew(0, sizeof ins[0], PFn);
+	alc = vnew(0, sizeof alc[0], PFn);
+	nalc = 0;
+	for (cb=f->start; cb; cb=cb->link) {
+		nb = bmap[cb->id];
+		nins = 0;
+		npar = 0;
+		for (i=cb->ins; i<&cb->ins[cb->nins]; i++) {
+			if (ns && isscope(f, i))
+				continue;
+			ni = *i;
+			ni.to = remap(i->to, fn, f, tmap);
+			ni.arg[0] = remap(i->arg[0], fn, f, tmap);
+			ni.arg[1] = remap(i->arg[1], fn, f, tmap);
+			if (i->op == Opar) {
+				ni.op = Ocopy;
+				ni.arg[0] = arg[npar++];
+			}
+			if (isalloc(i->op))
+				addins(&alc, &nalc, &ni);
+			else
+				addins(&ins, &nins, &ni);
+		}
+		nb->jmp = cb->jmp;
+		nb->jmp.arg = remap(cb->jmp.arg, fn, f, tmap);
+		if (isret(cb->jmp.type)) {
+			if (!req(call.to, R)) {
+				ni = (Ins){Ocopy, call.cls, call.to, {nb->jmp.arg, R}};
+				addins(&ins, &nins, &ni);
+			}
+			nb->jmp.type = Jjmp;
+			nb->jmp.arg = R;
+			nb->s1 = cont;
+		} else {
+			if (cb->s1)
+				nb->s1 = bmap[cb->s1->id];
+			if (cb->s2)
+				nb->s2 = bmap[cb->s2->id];
+		}
+		idup(nb, ins, nins);
+		last->link = nb;
+		last = nb;
+	}
+	last->link = cont;
+
+	b->nins = a;
+	b->jmp.type = Jjmp;
+	b->jmp.arg = R;
+	b->s1 = bmap[f->start->id];
+	b->s2 = 0;
+
+	/* the callee's stack slots go after the pars of fn */
+	if (nalc) {
+		cb = fn->start;
+		for (n=0; n<cb->nins && ispar(cb->ins[n].op); n++)
+			;
+		i = vnew(cb->nins + nalc, sizeof(Ins), PFn);
+		icpy(icpy(icpy(i, cb->ins, n), alc, nalc), &cb->ins[n], cb->nins - n);
+		cb->ins = i;
+		cb->nins += nalc;
+	}
+	vfree(ins);
+	vfree(alc);
+	return cont;
+}
+
+/* the arguments and the return value of the call at
+ * b->ins[k] match the parameters and returns of f;
+ * the arguments start at *pa
+ */
+static int
+matchcall(Blk *b, uint k, Fn *f, uint *pa)
+{
+	Blk *cb;
+	Ins *i;
+	uint a, n;
+
+	for (a=k; a>0 && isarg(b->ins[a-1].op); a--)
+		;
+	n = a;
+	for (i=f->start->ins; i<&f->start->ins[f->start->nins]; i++) {
+		if (i->op != Opar)
+			continue;
+		if (n == k || b->ins[n].op != Oarg || b->ins[n].cls != i->cls)
+			return 0;
+		n++;
+	}
+	if (n != k)
+		return 0;
+	if (!req(b->ins[k].to, R))
+		for (cb=f->start; cb; cb=cb->link)
+			if (isret(cb->jmp.type)
+			&& retcls(cb->jmp.type) != b->ins[k].cls)
+				return 0;
+	*pa = a;
+	return 1;
+}
+
+static void
+report(Fn *caller, Fn *callee)
+{
+	Site *s;
+
+	for (s=site; s<&site[nsite]; s++)
+		if (s->caller == caller && s->callee == callee) {
+			s->n++;
+			return;
+		}
+	vgrow(&site, ++nsite);
+	site[nsite-1] = (Site){caller, callee, 1};
+}
+
+static void
+inlfn(uint f)
+{
+	Fn *fn;
+	Blk *b;
+	uint k, a, grow;
+	int g;
+
+	fn = fns[f];
+	grow = 0;
+	for (b=fn->start; b; b=b->link)
+		for (k=0; k<b->nins; k++) {
+			g = fnidx(fn, &b->ins[k]);
+			if (g < 0 || (uint)g == f || cost[g] < 0
+			|| grow + cost[g] > MaxGrow
+			|| !matchcall(b, k, fns[g], &a))
+				continue;
+			grow += cost[g];
+			if (nosamm[g])
+				nsamm++;
+			report(fn, fns[g]);
+			/* the copied body is not scanned again */
+			b = inlcall(fn, b, a, k, fns[g], nosamm[g]);
+			k = -1;
+		}
+	k = 0;
+	for (b=fn->start; b; b=b->link)
+		b->id = k++;
+	fn->nblk = k;
+}
+
+/* callees before their callers */
+static void
+postorder(uint f)
+{
+	uint g;
+
+	if (visit[f])
+		return;
+	visit[f] = 1;
+	for (g=0; g<nfn; g++)
+		if (calls[f*nfn+g])
+			postorder(g);
+	inlfn(f);
+	if (cost[f] >= 0)
+		cost[f] = fncost(fns[f], &nosamm[f]);
+}
+
+void
+inlinefns(Fn **fn, uint n, FILE *rep)
+{
+	Blk *b;
+	Ins *i;
+	Site *s;
+	uint f, g;
+	int h;
+
+	fns = fn;
+	nfn = n;
+	calls = emalloc(n * n + 1);
+	cost = emalloc((n + 1) * sizeof cost[0]);
+	nosamm = emalloc(n + 1);
+	visit = emalloc(n + 1);
+	site = vnew(0, sizeof site[0], PHeap);
+	nsite = 0;
+	nsamm = 0;
+
+	for (f=0; f<n; f++)
+		for (b=fns[f]->start; b; b=b->link)
+			for (i=b->ins; i<&b->ins[b->nins]; i++)
+				if ((h = fnidx(fns[f], i)) >= 0)
+					calls[f*n+h] = 1;
+	for (f=0; f<n; f++) {
+		memset(visit, 0, n);
+		if (reach(f, f))
+			cost[f] = -1;
+		else
+			cost[f] = fncost(fns[f], &nosamm[f]);
+	}
+	memset(visit, 0, n);
+	for (f=0; f<n; f++)
+		postorder(f);
+
+	if (rep) {
+		g = 0;
+		for (s=site; s<&site[nsite]; s++)
+			g += s->n;
+		fprintf(rep, "Inlined call sites:         %u\n", g);
+		for (s=site; s<&site[nsite]; s++)
+			fprintf(rep, "  %s <- %s (%u)\n",
+				s->caller->name, s->callee->name, s->n);
+		fprintf(rep, "  SAMM scopes removed:      %u\n\n", nsamm);
+	}
+
+	free(calls);
+	free(cost);
+	free(nosamm);
+	free(visit);
+	vfree(site);
+}
@@ -0,0 +1,502 @@
+#include "all.h"
+
+/* Loop-invariant load motion
+ *
+ * gcm() already places pure instructions at the shallowest
+ * legal loop depth, but loads are pinned.  This pass moves
+ * two kinds of loads from natural loops into the loop's
+ * preheader when the loop contains no call:
+ *
+ *  - loads of global symbols that no store in the loop may
+ *    write; a store through an unknown pointer is assumed
+ *    not to write a symbol whose address does not escape in
+ *    the function (FasterBASIC never keeps a global's
+ *    address in memory)
+ *
+ *  - loads from FasterBASIC array descriptor headers: the
+ *    BasicArray pointed to by a $arr_desc_* symbol and its
+ *    bounds/strides vectors are only written by the runtime,
+ *    so without calls in the loop they are invariant
+ *
+ * A hoisted load runs even when the loop body would not, so
+ * the second kind reads through a descriptor pointer that is
+ * replaced by a zeroed block when null (array never DIMmed).
+ *
+ * Only used for IL produced by the BASIC frontend.
+ */
+
+enum {
+	HdrSize = 64,   /* bytes of a descriptor block read speculatively */
+	BoundsOff = 24, /* BasicArray.bounds */
+	StridesOff = 32 /* BasicArray.strides */
+};
+
+typedef struct Store Store;
+
+struct Store {
+	Ref addr;
+	int sz;
+};
+
+static int zeroused;
+static char zeroname[] = "qbe_licm_zero";
+
+static char *inloop;   /* per block id */
+static signed char *descptr; /* per tmp: points to descriptor memory */
+static Ref *safeof;    /* per tmp: null-safe copy in the preheader */
+static int *canon;     /* per tmp: hoisted load it duplicates */
+static uint ntmp0;     /* temporaries before the pass */
+static Store *stores;
+static uint nstores;
+static Sym *escsym;    /* symbols whose address escapes */
+static uint nescsym;
+static Ins *hoisted;
+static uint nhoisted;
+
+static int
+symesc(Sym s)
+{
+	uint n;
+
+	for (n=0; n<nescsym; n++)
+		if (symeq(escsym[n], s))
+			return 1;
+	return 0;
+}
+
+static void
+markesc(Fn *fn, Ref r)
+{
+	Alias a;
+
+	if (rtype(r) != RTmp && rtype(r) != RCon)
+		return;
+	if (rtype(r) == RCon && fn->con[r.val].type != CAddr)
+		return;
+	getalias(&a, r, fn);
+	if (a.type != ASym || symesc(a.u.sym))
+		return;
+	vgrow(&escsym, ++nescsym);
+	escsym[nescsym-1] = a.u.sym;
+}
+
+/* a symbol escapes when its address is used for anything
+ * but the address of a load or store, or to derive another
+ * address with add/copy (fillalias follows those)
+ */
+static void
+fillesc(Fn *fn)
+{
+	Blk *b;
+	Phi *p;
+	Ins *i;
+	uint n;
+
+	nescsym = 0;
+	for (b=fn->start; b; b=b->link) {
+		for (p=b->phi; p; p=p->link)
+			for (n=0; n<p->narg; n++)
+				markesc(fn, p->arg[n]);
+		for (i=b->ins; i<&b->ins[b->nins]; i++) {
+			if (isload(i->op) || i->op == Oadd || i->op == Ocopy
+			|| i->op == Oblit0)
+				continue;
+			if (isstore(i->op)) {
+				markesc(fn, i->arg[0]);
+				continue;
+			}
+			markesc(fn, i->arg[0]);
+			markesc(fn, i->arg[1]);
+		}
+		markesc(fn, b->jmp.arg);
+	}
+}
+
+/* t holds a pointer to runtime-owned descriptor memory:
+ * a BasicArray loaded from $arr_desc_*, or its bounds or
+ * strides vector; computed before anything moves, since
+ * hoisting leaves Tmp.def stale
+ */
+static int
+isdescptr(Fn *fn, int t)
+{
+	Ins *i;
+	Alias a;
+
+	if (descptr[t] != -1)
+		return descptr[t];
+	descptr[t] = 0;
+	i = fn->tmp[t].def;
+	if (!i || i->op != Oload || i->cls != Kl)
+		return 0;
+	getalias(&a, i->arg[0], fn);
+	if (a.type == ASym)
+		descptr[t] = strncmp(str(a.u.sym.id), "arr_desc_", 9) == 0;
+	else if (a.type == AUnk && a.base != t
+	&& (a.offset == BoundsOff || a.offset == StridesOff))
+		descptr[t] = isdescptr(fn, a.base);
+	return descptr[t];
+}
+
+static int
+invariant(Fn *fn, int t)
+{
+	return !inloop[fn->tmp[t].bid];
+}
+
+static int
+canonof(int t)
+{
+	while (canon[t] != t)
+		t = canon[t];
+	return t;
+}
+
+static int
+symclobbered(Fn *fn, Alias *ld, int sz)
+{
+	Alias a;
+	uint n;
+
+	for (n=0; n<nstores; n++) {
+		getalias(&a, stores[n].addr, fn);
+		switch (a.type) {
+		case ASym:
+			if (symeq(a.u.sym, ld->u.sym)
+			&& a.offset < ld->offset + sz
+			&& ld->offset < a.offset + stores[n].sz)
+				return 1;
+			break;
+		case AUnk:
+		case ACon:
+			if (symesc(ld->u.sym))
+				return 1;
+			break;
+		default:
+			break;
+		}
+	}
+	return 0;
+}
+
+static int
+hdrclobbered(Fn *fn, int base)
+{
+	Alias a;
+	uint n;
+
+	for (n=0; n<nstores; n++) {
+		getalias(&a, stores[n].addr, fn);
+		if (a.type == AUnk && canonof(a.base) == canonof(base))
+			return 1;
+	}
+	return 0;
+}
+
+static Ref
+hoist(Fn *fn, Blk *ph, int op, int k, Ref to, Ref arg0, Ref arg1)
+{
+	Ins i;
+	uint n;
+
+	if (req(to, R)) {
+		for (n=0; n<nhoisted; n++)
+			if (hoisted[n].op == op && hoisted[n].cls == k
+			&& req(hoisted[n].arg[0], arg0)
+			&& req(hoisted[n].arg[1], arg1))
+				return hoisted[n].to;
+		to = newtmp("licm", k, fn);
+	}
+	i = (Ins){op, k, to, {arg0, arg1}};
+	addins(&hoisted, &nhoisted, &i);
+	fn->tmp[to.val].bid = ph->id;
+	return to;
+}
+
+static void
+setalias(Fn *fn, Ref r, int base, int64_t off)
+{
+	Alias *a;
+
+	a = &fn->tmp[r.val].alias;
+	a->type = AUnk;
+	a->base = base;
+	a->offset = off;
+	a->slot = 0;
+}
+
+/* base if non-null, else the zero block */
+static Ref
+safebase(Fn *fn, Blk *ph, int base)
+{
+	Con c;
+	Ref z, zero, m, s;
+
+	base = canonof(base);
+	if (!req(safeof[base], R))
+		return safeof[base];
+	memset(&c, 0, sizeof c);
+	c.type = CAddr;
+	c.sym.type = SGlo;
+	c.sym.id = intern(zeroname);
+	zeroused = 1;
+	z = hoist(fn, ph, Oceql, Kl, R, TMP(base), getcon(0, fn));
+	zero = hoist(fn, ph, Ocopy, Kl, R, newcon(&c, fn), R);
+	m = hoist(fn, ph, Omul, Kl, R, z, zero);
+	s = hoist(fn, ph, Oor, Kl, R, TMP(base), m);
+	setalias(fn, s, base, 0);
+	safeof[base] = s;
+	return s;
+}
+
+/* the address of a hoisted load is rebuilt in the preheader
+ * from its alias information, so it does not matter where
+ * the original address was computed
+ */
+static int
+hoistload(Fn *fn, Blk *ph, Ins *i)
+{
+	Alias a;
+	Con c;
+	Ref addr;
+	uint n;
+	int sz;
+
+	getalias(&a, i->arg[0], fn);
+	sz = loadsz(i);
+	if (a.type == ASym) {
+		if (a.u.sym.type != SGlo || symclobbered(fn, &a, sz))
+			return 0;
+		memset(&c, 0, sizeof c);
+		c.type = CAddr;
+		c.sym = a.u.sym;
+		c.bits.i = a.offset;
+		addr = newcon(&c, fn);
+	} else if (a.type == AUnk) {
+		if (a.base >= (int)ntmp0
+		|| a.offset < 0 || a.offset + sz > HdrSize
+		|| !invariant(fn, canonof(a.base))
+		|| !descptr[a.base]
+		|| hdrclobbered(fn, a.base))
+			return 0;
+		addr = safebase(fn, ph, a.base);
+		if (a.offset) {
+			addr = hoist(fn, ph, Oadd, Kl, R, addr, getcon(a.offset, fn));
+			setalias(fn, addr, canonof(a.base), a.offset);
+		}
+	} else
+		return 0;
+	/* the same load already hoisted */
+	for (n=0; n<nhoisted; n++)
+		if (hoisted[n].op == i->op && hoisted[n].cls == i->cls
+		&& req(hoisted[n].arg[0], addr)) {
+			hoist(fn, ph, Ocopy, i->cls, i->to, hoisted[n].to, R);
+			canon[i->to.val] = hoisted[n].to.val;
+			*i = (Ins){.op = Onop};
+			return 1;
+		}
+	hoist(fn, ph, i->op, i->cls, i->to, addr, R);
+	*i = (Ins){.op = Onop};
+	return 1;
+}
+
+static void
+markloop(Blk *hd, Blk *b, int *ok)
+{
+	uint p;
+
+	if (inloop[b->id])
+		return;
+	if (b->id < hd->id || !dom(hd, b)) {
+		*ok = 0;
+		return;
+	}
+	inloop[b->id] = 1;
+	for (p=0; p<b->npred; p++)
+		markloop(hd, b->pred[p], ok);
+}
+
+static void
+addstore(Ref addr, int sz)
+{
+	vgrow(&stores, ++nstores);
+	stores[nstores-1].addr = addr;
+	stores[nstores-1].sz = sz;
+}
+
+static uint
+hoistloop(Fn *fn, Blk *hd)
+{
+	Blk *b, *ph;
+	Ins *i;
+	uint n, p, nh, t;
+	int ok, changed;
+
+	memset(inloop, 0, fn->nblk);
+	ok = 1;
+	inloop[hd->id] = 1;
+	for (p=0; p<hd->npred; p++)
+		if (hd->pred[p]->id >= hd->id)
+			markloop(hd, hd->pred[p], &ok);
+	if (!ok)
+		return 0;
+
+	/* a single preheader that only jumps to the header */
+	ph = 0;
+	for (p=0; p<hd->npred; p++)
+		if (!inloop[hd->pred[p]->id]) {
+			if (ph)
+				return 0;
+			ph = hd->pred[p];
+		}
+	if (!ph || ph->s1 != hd || ph->s2)
+		return 0;
+
+	/* memory written inside the loop */
+	nstores = 0;
+	for (n=hd->id; n<fn->nblk; n++) {
+		if (!inloop[n])
+			continue;
+		b = fn->rpo[n];
+		for (i=b->ins; i<&b->ins[b->nins]; i++) {
+			if (i->op == Ocall || i->op == Ovastart || i->op == Ovaarg)
+				return 0;
+			if (isstore(i->op))
+				addstore(i->arg[1], storesz(i));
+			else if (isneonstore(i->op))
+				addstore(i->arg[0], 16);
+			else if (i->op == Oblit0)
+				addstore(i->arg[1], abs(rsval((i+1)->arg[0])));
+		}
+	}
+
+	for (t=0; t<ntmp0; t++)
+		safeof[t] = R;
+	nhoisted = 0;
+	nh = 0;
+	do {
+		changed = 0;
+		for (n=hd->id; n<fn->nblk; n++) {
+			if (!inloop[n])
+				continue;
+			b = fn->rpo[n];
+			for (i=b->ins; i<&b->ins[b->nins]; i++)
+				if (isload(i->op) && hoistload(fn, ph, i)) {
+					changed = 1;
+					nh++;
+				}
+		}
+	} while (changed);
+
+	if (nhoisted) {
+		i = vnew(ph->nins + nhoisted, sizeof(Ins), PFn);
+		icpy(icpy(i, ph->ins, ph->nins), hoisted, nhoisted);
+		ph->ins = i;
+		ph->nins += nhoisted;
+	}
+	if (nh && debug['H'])
+		fprintf(stderr, "licm: %u loads from loop @%s to @%s\n",
+			nh, hd->name, ph->name);
+	return nh;
+}
+
+/* drop null-safe copies left unused when an enclosing
+ * loop hoisted the loads that read them
+ */
+static void
+sweep(Fn *fn)
+{
+	Blk *b;
+	Ins *i;
+	Tmp *t;
+	int changed;
+
+	filluse(fn);
+	do {
+		changed = 0;
+		for (b=fn->start; b; b=b->link)
+			for (i=b->ins; i<&b->ins[b->nins]; i++) {
+				if (rtype(i->to) != RTmp || i->to.val < ntmp0)
+					continue;
+				t = &fn->tmp[i->to.val];
+				if (t->nuse)
+					continue;
+				chuse(i->arg[0], -1, fn);
+				chuse(i->arg[1], -1, fn);
+				*i = (Ins){.op = Onop};
+				changed = 1;
+			}
+	} while (changed);
+}
+
+/* requires rpo, preds, dom and alias information
+ * maintains rpo, preds and dom
+ * breaks use
+ */
+void
+licm(Fn *fn)
+{
+	Blk *hd;
+	uint n, p, nh, t;
+
+	ntmp0 = fn->ntmp;
+	inloop = alloc(fn->nblk);
+	descptr = alloc(ntmp0);
+	memset(descptr, -1, ntmp0);
+	for (t=Tmp0; t<ntmp0; t++)
+		isdescptr(fn, t);
+	safeof = alloc(ntmp0 * sizeof safeof[0]);
+	canon = alloc(ntmp0 * sizeof canon[0]);
+	for (t=0; t<ntmp0; t++)
+		canon[t] = t;
+	stores = vnew(0, sizeof stores[0], PHeap);
+	escsym = vnew(0, sizeof escsym[0], PHeap);
+	hoisted = vnew(0, sizeof hoisted[0], PHeap);
+	fillesc(fn);
+
+	/* inner loops first, so that what they hoist into
+	 * their preheaders can move on out of enclosing loops */
+	nh = 0;
+	for (n=fn->nblk; n-->0;) {
+		hd = fn->rpo[n];
+		for (p=0; p<hd->npred; p++)
+			if (hd->pred[p]->id >= n) {
+				nh += hoistloop(fn, hd);
+				break;
+			}
+	}
+	if (nh)
+		sweep(fn);
+
+	vfree(stores);
+	vfree(escsym);
+	vfree(hoisted);
+
+	if (debug['H']) {
+		fprintf(stderr, "\n> After loop-invariant load motion:\n");
+		printfn(fn, stderr);
+	}
+}
+
+/* emit the zero block read through null descriptors */
+void
+licmfin(FILE *f)
+{
+	Lnk lnk;
+	Dat d;
+
+	if (!zeroused)
+		return;
+	memset(&lnk, 0, sizeof lnk);
+	memset(&d, 0, sizeof d);
+	d.name = zeroname;
+	d.lnk = &lnk;
+	d.type = DStart;
+	emitdat(&d, f);
+	d.type = DZ;
+	d.u.num = HdrSize;
+	emitdat(&d, f);
+	d.type = DEnd;
+	emitdat(&d, f);
+	zeroused = 0;
+}
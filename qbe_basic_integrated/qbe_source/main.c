@@ -15,6 +15,8 @@ extern void set_trace_cfg(int enable);
 extern void set_trace_ast(int enable);
 extern void set_trace_symbols(int enable);
 extern void set_show_il(int enable);
+extern void set_profile(int enable);
+extern void set_bce_report(int enable);
 
 /* Global flag for MADD fusion control */
 static int enable_madd_fusion = 1;  /* Enabled by default */
@@ -54,6 +56,7 @@ char debug['Z'+1] = {
 	['N'] = 0, /* ssa construction */
 	['C'] = 0, /* copy elimination */
 	['F'] = 0, /* constant folding */
+	['H'] = 0, /* loop-invariant loads */
 	['K'] = 0, /* if-conversion */
 	['A'] = 0, /* abi lowering */
 	['I'] = 0, /* instruction selection */
@@ -78,6 +81,10 @@ static Target *tlist[] = {
 };
 static FILE *outf;
 static int dbg;
+static int basicil; /* input IL comes from the BASIC frontend */
+static int profile;
+static Fn **fnbuf;  /* BASIC functions waiting for inlinefns() */
+static uint nfnbuf;
 
 static void
 data(Dat *d)
@@ -87,7 +94,8 @@ data(Dat *d)
 	emitdat(d, outf);
 	if (d->type == DEnd) {
 		fputs("/* end data */\n\n", outf);
-		freeall();
+		if (!nfnbuf)
+			freeall();
 	}
 }
 
@@ -96,6 +104,8 @@ func(Fn *fn)
 {
 	uint n;
 
+	if (!fn)
+		return;
 	if (dbg)
 		fprintf(stderr, "**** Function %s ****", fn->name);
 	if (debug['P']) {
@@ -105,6 +115,11 @@ func(Fn *fn)
 	T.abi0(fn);
 	fillcfg(fn);
 	filluse(fn);
+	if (basicil) {
+		filldom(fn);
+		gpromote(fn);
+		filluse(fn);
+	}
 	promote(fn);
 	filluse(fn);
 	ssa(fn);
@@ -126,6 +141,12 @@ func(Fn *fn)
 	gcm(fn);
 	filluse(fn);
 	ssacheck(fn);
+	if (basicil) {
+		fillalias(fn);
+		licm(fn);
+		filluse(fn);
+		ssacheck(fn);
+	}
 	if (T.cansel) {
 		ifconvert(fn);
 		fillcfg(fn);
@@ -160,6 +181,29 @@ func(Fn *fn)
 		fprintf(outf, "/* end function %s */\n\n", fn->name);
 	} else
 		fprintf(stderr, "\n");
+	if (!nfnbuf)
+		freeall();
+}
+
+/* the functions of a BASIC program are held until the end
+ * of the input (fn == 0) so that inlinefns() sees them all
+ */
+static void
+basicfunc(Fn *fn)
+{
+	uint n;
+
+	if (fn) {
+		vgrow(&fnbuf, ++nfnbuf);
+		fnbuf[nfnbuf-1] = fn;
+		return;
+	}
+	if (!nfnbuf)
+		return;
+	inlinefns(fnbuf, nfnbuf, profile ? stderr : 0);
+	for (n=0; n<nfnbuf; n++)
+		func(fnbuf[n]);
+	nfnbuf = 0;
 	freeall();
 }
 
@@ -184,6 +228,7 @@ main(int ac, char *av[])
 	int trace_ast = 0;
 	int trace_symbols = 0;
 	int debug_mode = 0;
+	int bce_report = 0;
 	int i;
 	char *target_name = NULL;
 	char *debug_flags = NULL;
@@ -203,6 +248,10 @@ main(int ac, char *av[])
 			enable_madd_fusion = 0;
 		} else if (strcmp(arg, "--debug") == 0 || strcmp(arg, "-D") == 0) {
 			debug_mode = 1;
+		} else if (strcmp(arg, "--profile") == 0) {
+			profile = 1;
+		} else if (strcmp(arg, "--bce-report") == 0) {
+			bce_report = 1;
 		}
 		/* Short options */
 		else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
@@ -222,6 +271,8 @@ main(int ac, char *av[])
 			fprintf(stderr, "  %-20s trace AST and exit (BASIC files only)\n", "-A");
 			fprintf(stderr, "  %-20s trace symbols and exit (BASIC files only)\n", "-S");
 			fprintf(stderr, "  %-20s enable debug output\n", "-D, --debug");
+			fprintf(stderr, "  %-20s report compile phase times and optimisations\n", "--profile");
+			fprintf(stderr, "  %-20s report array subscripts that kept their bounds checks\n", "--bce-report");
 			fprintf(stderr, "  %-20s enable MADD/MSUB fusion (default)\n", "--enable-madd-fusion");
 			fprintf(stderr, "  %-20s disable MADD/MSUB fusion\n", "--disable-madd-fusion");
 			fprintf(stderr, "  %-20s generate for target\n", "-t <target>");
@@ -338,6 +389,13 @@ main(int ac, char *av[])
 		set_trace_symbols(1);
 	}
 	
+	if (profile) {
+		set_profile(1);
+	}
+	if (bce_report) {
+		set_bce_report(1);
+	}
+	
 	/* Set show-il flag if -i was specified */
 	if (il_only) {
 		set_show_il(1);
@@ -440,11 +498,15 @@ main(int ac, char *av[])
 		}
 		need_linking = !compile_only;
 		
-		parse(inf, f, dbgfile, data, func);
+		basicil = 1;
+		fnbuf = vnew(0, sizeof fnbuf[0], PHeap);
+		parse(inf, f, dbgfile, data, basicfunc);
 		fclose(inf);
 		
-		if (!dbg)
+		if (!dbg) {
+			licmfin(outf);
 			T.emitfin(outf);
+		}
 		fclose(outf);
 		
 		/* If -c was specified, copy temp asm to output file instead of linking */
@@ -618,6 +680,7 @@ main(int ac, char *av[])
 			"string_ops.c",
 			"string_pool.c",
 			"string_utf32.c",
+			"string_simd.c",
 			"conversion_ops.c",
 			"array_ops.c",
 			"array_descriptor_runtime.c",
@@ -628,6 +691,8 @@ main(int ac, char *av[])
 			"samm_pool.c",
 			"samm_core.c",
 			"list_ops.c",
+			"hashmap_runtime.c",
+			"parallel_runtime.c",
 			NULL
 		};
 		
@@ -1252,6 +1252,7 @@ parse(FILE *f, char *path, void dbgfile(char *), void data(Dat *), void func(Fn
 			parsetyp();
 			break;
 		case Teof:
+			func(0); /* end of input */
 			for (n=0; n<ntyp; n++)
 				if (typ[n].nunion)
 					vfree(typ[n].fields);
@@ -432,6 +432,17 @@ int32_t array_ubound(BasicArray* array, int32_t dimension) {
     return array->bounds[(dimension - 1) * 2 + 1];
 }
 
+// Used by loops that test their whole index range once on entry instead of
+// checking every access; never raises an error itself
+int32_t array_range_in_bounds(BasicArray* array, int32_t dimension, int64_t low, int64_t high) {
+    if (!array || dimension < 1 || dimension > array->dimensions) {
+        return 0;
+    }
+
+    return low >= array->bounds[(dimension - 1) * 2] &&
+           high <= array->bounds[(dimension - 1) * 2 + 1];
+}
+
 // =============================================================================
 // Array Redimension
 // =============================================================================
@@ -52,6 +52,15 @@ typedef struct BasicArray {
     char type_suffix;     // Type suffix: '%', '#', '!', '$', '&'
 } BasicArray;
 
+// One column of a bulk READCSV: the value of row r is stored at
+// data + r * stride as `kind` ('b', 'h', 'w', 'l', 's', 'd' as in QBE, or
+// '$' for a StringDescriptor* slot)
+typedef struct BasicColumn {
+    uint8_t* data;
+    size_t   stride;
+    char     kind;
+} BasicColumn;
+
 // File handle
 typedef struct BasicFile {
     FILE* fp;
@@ -59,10 +68,22 @@ typedef struct BasicFile {
     char* filename;
     char* mode;
     bool is_open;
-    // Buffered reader fields (used by INPUT mode).
+    // stdio buffer (FILE_BUFFER_SIZE bytes; freed after fclose)
+    char*    io_buf;
+    // Whole-file mapping for large INPUT files (NULL: read through fp);
+    // read_pos is then the offset of the next unread byte
+    StringDescriptor* mapping;
+    // Line/field buffer for LINE INPUT # and INPUT # (grown as needed)
     uint8_t* read_buf;
     size_t   read_buf_size;
     size_t   read_pos;
+    // Mapped pages below this offset have been given back (READCSV)
+    size_t   released_pos;
+    // Columns collected for the next file_read_columns() call
+    BasicColumn* columns;
+    int32_t  column_count;
+    int32_t  column_capacity;
+    int64_t  column_rows;       // rows that fit in every column
 } BasicFile;
 
 // =============================================================================
@@ -162,6 +183,12 @@ float str_to_float(BasicString* str);
 // Convert string to double
 double str_to_double(BasicString* str);
 
+// Parse a number from p[0..n) (not NUL-terminated), skipping leading
+// blanks; *used is set to the characters consumed (0 if none).  Same
+// results as strtod/strtoll, with a fast path for plain decimals.
+double basic_parse_double(const char* p, int64_t n, int64_t* used);
+int64_t basic_parse_long(const char* p, int64_t n, int64_t* used);
+
 // =============================================================================
 // Exception Handling
 // =============================================================================
@@ -258,6 +285,9 @@ int32_t array_lbound(BasicArray* array, int32_t dimension);
 // Get upper bound for dimension (1-based)
 int32_t array_ubound(BasicArray* array, int32_t dimension);
 
+// 1 if every index in [low, high] is valid for dimension (1-based), else 0
+int32_t array_range_in_bounds(BasicArray* array, int32_t dimension, int64_t low, int64_t high);
+
 // Redimension array (preserves data if possible)
 void array_redim(BasicArray* array, int32_t* new_bounds, bool preserve);
 
@@ -265,6 +295,21 @@ void array_redim(BasicArray* array, int32_t* new_bounds, bool preserve);
 // I/O Operations - Console
 // =============================================================================
 
+// Console output buffering (OPTION OUTPUT)
+#define BASIC_OUTPUT_AUTO        0  // Line-buffered on a terminal, block-buffered otherwise
+#define BASIC_OUTPUT_BUFFERED    1  // Block-buffered; flushed when full, at input and at exit
+#define BASIC_OUTPUT_UNBUFFERED  2  // Flushed after every PRINT item
+
+// Select the stdout buffering mode; called once at program start,
+// before anything is printed
+void basic_output_init(int32_t mode);
+
+// Write out any buffered console output
+void basic_output_flush(void);
+
+// Called by the print functions after writing to stdout (internal)
+void _basic_output_written(void);
+
 // Print integer
 void basic_print_int(int64_t value);
 
@@ -379,6 +424,51 @@ BasicString* file_read_line(BasicFile* file);
 // Check if end of file
 bool file_eof(BasicFile* file);
 
+// Write buffered data to disk (files are otherwise flushed on close and exit)
+void file_flush(BasicFile* file);
+
+// Numbered files: OPEN "name" FOR <mode> AS #n
+#define BASIC_FILE_INPUT   0
+#define BASIC_FILE_OUTPUT  1
+#define BASIC_FILE_APPEND  2
+
+void file_open_number(int32_t file_number, StringDescriptor* filename, int32_t mode);
+void file_close_number(int32_t file_number);
+
+// Handle for file #n (looked up once per PRINT #/INPUT # statement)
+BasicFile* file_get_handle(int32_t file_number);
+
+// EOF(n): -1 if the next read would hit end of file, else 0
+int32_t file_eof_number(int32_t file_number);
+
+// PRINT # items
+void file_print_string_desc(BasicFile* file, StringDescriptor* str);
+void file_print_long(BasicFile* file, int64_t value);
+void file_print_double(BasicFile* file, double value);
+void file_print_tab(BasicFile* file);
+void file_print_char(BasicFile* file, int32_t c);
+
+// WRITE # string item (quoted)
+void file_write_string_desc(BasicFile* file, StringDescriptor* str);
+
+// LINE INPUT #: next line without its line ending.  Assigned like
+// string_assign_utf8: `target` (the variable's reference, or NULL) is
+// consumed and reused when exclusively owned; store the result unretained.
+StringDescriptor* file_line_input(BasicFile* file, StringDescriptor* target);
+
+// INPUT #: next comma- or line-separated field (string fields as above)
+StringDescriptor* file_input_string(BasicFile* file, StringDescriptor* target);
+double file_input_double(BasicFile* file);
+int64_t file_input_long(BasicFile* file);
+
+// READCSV(n, a(), b$(), ...): add each array as a column (a UDT array adds
+// one column per field, `layout` holding the field kinds in order), then
+// read one line per row into elements from the lower bound up.  Returns the
+// rows read: fewer than the arrays hold only at end of file.
+void file_column_array(BasicFile* file, BasicArray* array);
+void file_column_record(BasicFile* file, BasicArray* array, const char* layout);
+int32_t file_read_columns(BasicFile* file);
+
 // =============================================================================
 // Math Functions
 // =============================================================================
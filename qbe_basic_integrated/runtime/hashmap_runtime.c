@@ -0,0 +1,994 @@
+/*
+ * hashmap_runtime.c
+ * FasterBASIC Runtime — HASHMAP (see hashmap_runtime.h for the design)
+ */
+
+#include "hashmap_runtime.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define HASHMAP_HAVE_SSE2 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define HASHMAP_HAVE_NEON 1
+#endif
+
+// =============================================================================
+// Hashing
+// =============================================================================
+//
+// Multiply-fold mixing (as in wyhash): a 64x64->128-bit multiply whose
+// halves are xor'ed together.  Strings are hashed 16 bytes per round; a
+// UTF-32 string whose characters are all ASCII is narrowed on the fly and
+// hashes exactly like its ASCII form, so equal keys always hash alike.
+
+#define HASH_SEED  0x243F6A8885A308D3ull
+#define HASH_K1    0xA0761D6478BD642Full
+#define HASH_K2    0xE7037ED1A0B428DBull
+#define HASH_K3    0x8EBC6AF09C88C6E3ull
+
+static inline uint64_t mix(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+#else
+    uint64_t lo = a * b;
+    uint64_t hi = ((a >> 32) * (b >> 32)) + (((a >> 32) * (uint32_t)b) >> 32) +
+                  (((uint32_t)a * (b >> 32)) >> 32);
+    return lo ^ hi;
+#endif
+}
+
+static inline uint64_t load64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint64_t hash_bytes(const uint8_t* p, int64_t n, uint64_t seed) {
+    uint64_t h = seed ^ mix((uint64_t)n ^ HASH_K1, HASH_K2);
+    while (n >= 16) {
+        h = mix(load64(p) ^ HASH_K1, load64(p + 8) ^ h);
+        p += 16;
+        n -= 16;
+    }
+    if (n > 0) {
+        uint8_t tail[16] = {0};
+        memcpy(tail, p, (size_t)n);
+        h = mix(load64(tail) ^ HASH_K1, load64(tail + 8) ^ h);
+    }
+    return mix(h ^ HASH_K3, HASH_K2);
+}
+
+uint64_t hashmap_hash_string(const StringDescriptor* key) {
+    if (!key || key->length == 0) return hash_bytes(NULL, 0, HASH_SEED);
+    if (key->encoding == STRING_ENCODING_ASCII) {
+        return hash_bytes((const uint8_t*)key->data, key->length, HASH_SEED);
+    }
+
+    const uint32_t* cp = (const uint32_t*)key->data;
+    int64_t n = key->length;
+    uint32_t high = 0;
+    for (int64_t i = 0; i < n; i++) high |= cp[i];
+    if (high >= 0x80) {
+        // Cannot equal any ASCII string: hash the code points as they are
+        return hash_bytes((const uint8_t*)cp, n * 4, HASH_SEED ^ HASH_K3);
+    }
+
+    // Same rounds as hash_bytes() over the narrowed characters
+    uint64_t h = HASH_SEED ^ mix((uint64_t)n ^ HASH_K1, HASH_K2);
+    uint8_t block[16];
+    while (n > 0) {
+        int64_t take = n < 16 ? n : 16;
+        memset(block, 0, sizeof(block));
+        for (int64_t i = 0; i < take; i++) block[i] = (uint8_t)cp[i];
+        h = mix(load64(block) ^ HASH_K1, load64(block + 8) ^ h);
+        cp += take;
+        n -= take;
+    }
+    return mix(h ^ HASH_K3, HASH_K2);
+}
+
+uint64_t hashmap_hash_int(int64_t key) {
+    return mix((uint64_t)key ^ HASH_K1, HASH_SEED ^ HASH_K2);
+}
+
+// One bit pattern per key value: 0.0 and -0.0, and all NaNs, coincide
+static int64_t double_key_bits(double key) {
+    int64_t bits;
+    if (key == 0.0) key = 0.0;
+    if (key != key) {
+        bits = 0x7FF8000000000000ll;
+    } else {
+        memcpy(&bits, &key, sizeof(bits));
+    }
+    return bits;
+}
+
+uint64_t hashmap_hash_double(double key) {
+    return mix((uint64_t)double_key_bits(key) ^ HASH_K3, HASH_SEED ^ HASH_K1);
+}
+
+static bool strings_equal(const StringDescriptor* a, const StringDescriptor* b) {
+    if (a == b) return true;
+    if (a->length != b->length) return false;
+    int64_t n = a->length;
+    if (a->encoding == b->encoding) {
+        size_t width = a->encoding == STRING_ENCODING_ASCII ? 1 : 4;
+        return n == 0 || memcmp(a->data, b->data, (size_t)n * width) == 0;
+    }
+    const uint8_t* s8 = (const uint8_t*)(a->encoding == STRING_ENCODING_ASCII ? a : b)->data;
+    const uint32_t* s32 = (const uint32_t*)(a->encoding == STRING_ENCODING_ASCII ? b : a)->data;
+    for (int64_t i = 0; i < n; i++) {
+        if (s8[i] != s32[i]) return false;
+    }
+    return true;
+}
+
+// =============================================================================
+// Control Byte Groups
+// =============================================================================
+//
+// A GroupMask has one set bit per matching control byte; group_next()
+// pops the lowest match and returns its offset in the group.  NEON has no
+// movemask, so its masks keep one bit per 4-bit lane (offset = bit / 4).
+
+typedef uint64_t GroupMask;
+
+#if defined(HASHMAP_HAVE_SSE2)
+
+#define GROUP_SHIFT 0
+#define GROUP_ALL   0xFFFFull
+
+static inline GroupMask group_match(const uint8_t* ctrl, uint8_t tag) {
+    __m128i g = _mm_loadu_si128((const __m128i*)ctrl);
+    return (uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)tag)));
+}
+
+static inline GroupMask group_match_empty_or_deleted(const uint8_t* ctrl) {
+    // EMPTY and DELETED are the only bytes with the high bit set
+    return (uint16_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+}
+
+#elif defined(HASHMAP_HAVE_NEON)
+
+#define GROUP_SHIFT 2
+#define GROUP_ALL   0x8888888888888888ull
+
+static inline GroupMask neon_mask(uint8x16_t eq) {
+    uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+}
+
+static inline GroupMask group_match(const uint8_t* ctrl, uint8_t tag) {
+    return neon_mask(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(tag)));
+}
+
+static inline GroupMask group_match_empty_or_deleted(const uint8_t* ctrl) {
+    return neon_mask(vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(ctrl)), vdupq_n_s8(0)));
+}
+
+#else
+
+#define GROUP_SHIFT 0
+#define GROUP_ALL   0xFFFFull
+
+static inline GroupMask group_match(const uint8_t* ctrl, uint8_t tag) {
+    GroupMask m = 0;
+    for (int i = 0; i < HASHMAP_GROUP_WIDTH; i++) {
+        if (ctrl[i] == tag) m |= (GroupMask)1 << i;
+    }
+    return m;
+}
+
+static inline GroupMask group_match_empty_or_deleted(const uint8_t* ctrl) {
+    GroupMask m = 0;
+    for (int i = 0; i < HASHMAP_GROUP_WIDTH; i++) {
+        if (ctrl[i] & 0x80) m |= (GroupMask)1 << i;
+    }
+    return m;
+}
+
+#endif
+
+static inline GroupMask group_match_empty(const uint8_t* ctrl) {
+    return group_match(ctrl, HASHMAP_CTRL_EMPTY);
+}
+
+static inline GroupMask group_match_full(const uint8_t* ctrl) {
+    return group_match_empty_or_deleted(ctrl) ^ GROUP_ALL;
+}
+
+static inline int64_t group_next(GroupMask* m) {
+    int64_t offset = __builtin_ctzll(*m) >> GROUP_SHIFT;
+    *m &= *m - 1;
+    return offset;
+}
+
+static inline uint8_t hash_tag(uint64_t hash) {
+    return (uint8_t)(hash & 0x7F);
+}
+
+static inline int64_t hash_start(uint64_t hash) {
+    return (int64_t)(hash >> 7);
+}
+
+// =============================================================================
+// Table Storage
+// =============================================================================
+//
+// A Table is one control-byte array with its slots: the map's current
+// table, or the previous one while an incremental resize is under way.
+
+typedef struct {
+    uint8_t*     ctrl;
+    HashMapSlot* slots;
+    int64_t      capacity;
+} Table;
+
+static inline Table current_table(const HashMap* map) {
+    Table t = { map->ctrl, map->slots, map->capacity };
+    return t;
+}
+
+static inline Table old_table(const HashMap* map) {
+    Table t = { map->old_ctrl, map->old_slots, map->old_capacity };
+    return t;
+}
+
+static inline void set_ctrl(Table t, int64_t i, uint8_t c) {
+    t.ctrl[i] = c;
+    if (i < HASHMAP_GROUP_WIDTH) {
+        t.ctrl[t.capacity + i] = c;  // mirror for wrap-around loads
+    }
+}
+
+static int64_t max_load(int64_t capacity) {
+    return capacity - capacity / 8;
+}
+
+// Control bytes and slots in one block (ctrl first, padded to 8 bytes).
+// Sets the current table; entry counts are the caller's business.
+static bool alloc_table(HashMap* map, int64_t capacity) {
+    size_t ctrl_bytes = ((size_t)capacity + HASHMAP_GROUP_WIDTH + 7) & ~(size_t)7;
+    uint8_t* block = (uint8_t*)malloc(ctrl_bytes + (size_t)capacity * sizeof(HashMapSlot));
+    if (!block) return false;
+    memset(block, HASHMAP_CTRL_EMPTY, (size_t)capacity + HASHMAP_GROUP_WIDTH);
+    map->ctrl = block;
+    map->slots = (HashMapSlot*)(block + ctrl_bytes);
+    map->capacity = capacity;
+    map->tombstones = 0;
+    map->growth_left = max_load(capacity);
+    return true;
+}
+
+static int64_t capacity_for(int64_t entries) {
+    int64_t cap = HASHMAP_MIN_CAPACITY;
+    while (max_load(cap) < entries) cap *= 2;
+    return cap;
+}
+
+// First EMPTY or DELETED slot on the probe sequence of `hash`
+static int64_t find_free_slot(Table t, uint64_t hash) {
+    int64_t mask = t.capacity - 1;
+    int64_t pos = hash_start(hash) & mask;
+    for (int64_t step = HASHMAP_GROUP_WIDTH;; step += HASHMAP_GROUP_WIDTH) {
+        GroupMask m = group_match_empty_or_deleted(t.ctrl + pos);
+        if (m) return (pos + group_next(&m)) & mask;
+        pos = (pos + step) & mask;
+    }
+}
+
+// Claim a slot of the current table for `hash` (tag set, hash cached)
+static int64_t place(HashMap* map, uint64_t hash) {
+    Table t = current_table(map);
+    int64_t i = find_free_slot(t, hash);
+    if (t.ctrl[i] == HASHMAP_CTRL_DELETED) {
+        map->tombstones--;
+    } else {
+        map->growth_left--;
+    }
+    set_ctrl(t, i, hash_tag(hash));
+    t.slots[i].hash = hash;
+    return i;
+}
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000ll + ts.tv_nsec;
+}
+
+static void record_pause(HashMap* map, int64_t start_ns) {
+    int64_t pause = now_ns() - start_ns;
+    map->last_pause_ns = pause;
+    if (pause > map->max_pause_ns) map->max_pause_ns = pause;
+}
+
+// =============================================================================
+// Resizing
+// =============================================================================
+//
+// A resize moves every entry into a new table (cached hashes: no key is
+// rehashed or compared).  Small maps do it in one go.  From
+// HASHMAP_INCREMENTAL_MIN entries on, an incremental map keeps the old
+// table and moves HASHMAP_MIGRATE_STEP of its slots on every later
+// insert, lookup or remove; a moved slot becomes DELETED in the old table
+// so probes there skip it.  Until the old table is empty, lookups try the
+// current table first and then the old one.  With 16 or more slots moved
+// per operation the move completes well before the new table can fill.
+// The pages of moved slots are returned as the move goes, so neither the
+// last step nor the free() of the old table unmaps it all at once.
+
+static void free_old_table(HashMap* map) {
+    free(map->old_ctrl);
+    map->old_ctrl = NULL;
+    map->old_slots = NULL;
+    map->old_capacity = 0;
+    map->old_size = 0;
+    map->migrate_pos = 0;
+    map->old_released = 0;
+}
+
+// Give back the pages of old slots that have been moved, a chunk at a
+// time, so the final free() does not have to unmap the whole table
+static void release_moved_slots(HashMap* map) {
+#ifdef MADV_DONTNEED
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t base = (uintptr_t)map->old_slots;
+    uintptr_t first = (base + page - 1) / page * page;
+    uintptr_t from = first + (uintptr_t)map->old_released;
+    uintptr_t end = (base + (uintptr_t)map->migrate_pos * sizeof(HashMapSlot)) / page * page;
+    if (end >= from + HASHMAP_RELEASE_CHUNK) {
+        madvise((void*)from, end - from, MADV_DONTNEED);
+        map->old_released = (int64_t)(end - first);
+    }
+#else
+    (void)map;
+#endif
+}
+
+// Move up to `count` old slots (from migrate_pos on) into the current table
+static void migrate(HashMap* map, int64_t count) {
+    Table old = old_table(map);
+    Table cur = current_table(map);
+    int64_t end = map->migrate_pos + count;
+    if (end > old.capacity) end = old.capacity;
+    for (int64_t i = map->migrate_pos; i < end; i++) {
+        if (old.ctrl[i] & 0x80) continue;
+        int64_t to = place(map, old.slots[i].hash);
+        cur.slots[to] = old.slots[i];
+        set_ctrl(old, i, HASHMAP_CTRL_DELETED);
+        map->old_size--;
+    }
+    map->migrate_pos = end;
+    if (end == old.capacity || map->old_size == 0) {
+        free_old_table(map);
+    } else {
+        release_moved_slots(map);
+    }
+}
+
+static inline void migrate_step(HashMap* map) {
+    if (map->old_ctrl) {
+        int64_t start = now_ns();
+        migrate(map, HASHMAP_MIGRATE_STEP);
+        record_pause(map, start);
+    }
+}
+
+static bool resize(HashMap* map, int64_t new_capacity) {
+    HashMap prev = *map;
+    if (!alloc_table(map, new_capacity)) {
+        *map = prev;
+        return false;
+    }
+    map->old_ctrl = prev.ctrl;
+    map->old_slots = prev.slots;
+    map->old_capacity = prev.capacity;
+    map->old_size = prev.size;
+    map->migrate_pos = 0;
+    map->old_released = 0;
+    map->resizes++;
+    if (!map->incremental || prev.size < HASHMAP_INCREMENTAL_MIN) {
+        migrate(map, prev.capacity);
+    }
+    return true;
+}
+
+// Make room for one more entry in the current table: drop tombstones if
+// they are most of the load, else double the table
+static bool reserve_one(HashMap* map) {
+    if (map->growth_left > 0) return true;
+    int64_t start = now_ns();
+    if (map->old_ctrl) migrate(map, map->old_capacity);  // never two resizes at once
+    int64_t cap = map->capacity;
+    bool ok = map->growth_left > 0 ||
+              resize(map, map->size + 1 <= max_load(cap) / 2 ? cap : cap * 2);
+    record_pause(map, start);
+    return ok;
+}
+
+static HashMap* new_map(int32_t initial_capacity, int32_t key_kind, int32_t value_kind) {
+    HashMap* map = (HashMap*)calloc(1, sizeof(HashMap));
+    if (!map) return NULL;
+    map->key_kind = key_kind;
+    map->value_kind = value_kind;
+    map->incremental = 1;
+    if (!alloc_table(map, capacity_for(initial_capacity > 0 ? initial_capacity : 0))) {
+        free(map);
+        return NULL;
+    }
+    return map;
+}
+
+HashMap* hashmap_new(int32_t initial_capacity) {
+    return new_map(initial_capacity, HASHMAP_KEY_STRING, HASHMAP_VALUE_RAW);
+}
+
+HashMap* hashmap_new_string_values(int32_t initial_capacity) {
+    return new_map(initial_capacity, HASHMAP_KEY_STRING, HASHMAP_VALUE_STRING);
+}
+
+HashMap* hashmap_new_int(int32_t initial_capacity) {
+    return new_map(initial_capacity, HASHMAP_KEY_INT, HASHMAP_VALUE_RAW);
+}
+
+HashMap* hashmap_new_double(int32_t initial_capacity) {
+    return new_map(initial_capacity, HASHMAP_KEY_DOUBLE, HASHMAP_VALUE_RAW);
+}
+
+void hashmap_set_incremental(HashMap* map, int32_t incremental) {
+    if (!map) return;
+    map->incremental = incremental != 0;
+    if (!map->incremental && map->old_ctrl) migrate(map, map->old_capacity);
+}
+
+static inline void** value_ref(HashMap* map, HashMapSlot* s);
+
+// Drop the map's reference to a value it owns
+static inline void release_value(HashMap* map, void* value) {
+    if (map->value_kind == HASHMAP_VALUE_STRING) string_release((StringDescriptor*)value);
+}
+
+static void release_table(HashMap* map, Table t) {
+    for (int64_t i = 0; i < t.capacity; i++) {
+        if (!(t.ctrl[i] & 0x80)) {
+            if (map->key_kind == HASHMAP_KEY_STRING) string_release(t.slots[i].key.str);
+            release_value(map, *value_ref(map, &t.slots[i]));
+        }
+    }
+}
+
+// Release the keys and values of every entry
+static void release_entries(HashMap* map) {
+    if (map->size == 0) return;
+    if (map->key_kind != HASHMAP_KEY_STRING && map->value_kind == HASHMAP_VALUE_RAW) return;
+    release_table(map, current_table(map));
+    if (map->old_ctrl) release_table(map, old_table(map));
+}
+
+void hashmap_free(HashMap* map) {
+    if (!map) return;
+    release_entries(map);
+    free(map->entries);
+    free(map->old_ctrl);
+    free(map->ctrl);
+    free(map);
+}
+
+void hashmap_clear(HashMap* map) {
+    if (!map) return;
+    release_entries(map);
+    free_old_table(map);
+    memset(map->ctrl, HASHMAP_CTRL_EMPTY, (size_t)map->capacity + HASHMAP_GROUP_WIDTH);
+    map->size = 0;
+    map->tombstones = 0;
+    map->growth_left = max_load(map->capacity);
+    map->entries_used = 0;
+}
+
+int64_t hashmap_size(HashMap* map) {
+    return map ? map->size : 0;
+}
+
+// =============================================================================
+// Lookup, Insert, Remove
+// =============================================================================
+//
+// One probe loop per key kind (the key compare is inlined into each).
+// FIND_SLOT expands to: slot index of the key in table t, or -1.  The
+// first slots of the home group are prefetched while its control bytes
+// are matched, so a large table costs one cache miss per lookup rather
+// than two in a row.
+
+#define FIND_SLOT(t, hash, EQUAL)                                            \
+    do {                                                                     \
+        int64_t mask_ = (t).capacity - 1;                                    \
+        int64_t pos_ = hash_start(hash) & mask_;                             \
+        uint8_t tag_ = hash_tag(hash);                                       \
+        __builtin_prefetch(&(t).slots[pos_]);                                \
+        for (int64_t step_ = HASHMAP_GROUP_WIDTH;; step_ += HASHMAP_GROUP_WIDTH) { \
+            const uint8_t* group_ = (t).ctrl + pos_;                         \
+            GroupMask m_ = group_match(group_, tag_);                        \
+            while (m_) {                                                     \
+                int64_t i_ = (pos_ + group_next(&m_)) & mask_;               \
+                const HashMapSlot* s_ = &(t).slots[i_];                      \
+                if (s_->hash == (hash) && (EQUAL)) return i_;                \
+            }                                                                \
+            if (group_match_empty(group_)) return -1;                        \
+            pos_ = (pos_ + step_) & mask_;                                   \
+        }                                                                    \
+    } while (0)
+
+static int64_t find_str(Table t, const StringDescriptor* key, uint64_t hash) {
+    FIND_SLOT(t, hash, strings_equal(s_->key.str, key));
+}
+
+// Integer keys, and double keys stored as their canonical bit pattern
+static int64_t find_bits(Table t, int64_t bits, uint64_t hash) {
+    FIND_SLOT(t, hash, s_->key.i == bits);
+}
+
+// A key of any kind: str for string maps, bits otherwise
+typedef struct {
+    const StringDescriptor* str;
+    int64_t                 bits;
+} MapKey;
+
+static inline int64_t find_in(Table t, int32_t kind, MapKey key, uint64_t hash) {
+    return kind == HASHMAP_KEY_STRING ? find_str(t, key.str, hash) : find_bits(t, key.bits, hash);
+}
+
+// The key's slot in the current or (during a resize) the old table, or NULL
+static HashMapSlot* locate(HashMap* map, MapKey key, uint64_t hash,
+                           Table* where, int64_t* index) {
+    Table t = current_table(map);
+    int64_t i = find_in(t, map->key_kind, key, hash);
+    if (i < 0 && map->old_ctrl) {
+        t = old_table(map);
+        i = find_in(t, map->key_kind, key, hash);
+    }
+    if (i < 0) return NULL;
+    if (where) *where = t;
+    if (index) *index = i;
+    return &t.slots[i];
+}
+
+// =============================================================================
+// Ordered Maps
+// =============================================================================
+//
+// An ordered map appends each new key to map->entries and keeps the
+// entry's index in the value field of the key's table slot, so the table
+// is only an index: a lookup costs one more load, and iteration reads the
+// entries in order.  Removing a key only marks its entry, so a loop may
+// remove the key it is visiting.  Marked entries are squeezed out when an
+// append finds the array full and at least half of it removed.
+
+static char removed_marker;
+#define REMOVED_ENTRY ((void*)&removed_marker)
+
+static inline int64_t entry_index(const HashMapSlot* s) {
+    return (int64_t)(intptr_t)s->value;
+}
+
+// Where the value of the key in slot s is kept
+static inline void** value_ref(HashMap* map, HashMapSlot* s) {
+    return map->entries ? &map->entries[entry_index(s)].value : &s->value;
+}
+
+static bool grow_entries(HashMap* map, int64_t capacity) {
+    HashMapSlot* e = (HashMapSlot*)realloc(map->entries, (size_t)capacity * sizeof(HashMapSlot));
+    if (!e) return false;
+    map->entries = e;
+    map->entries_capacity = capacity;
+    return true;
+}
+
+// Close the gaps left by removed entries and re-point the table at the
+// entries' new places
+static void compact_entries(HashMap* map) {
+    int64_t n = 0;
+    for (int64_t i = 0; i < map->entries_used; i++) {
+        HashMapSlot e = map->entries[i];
+        if (e.value == REMOVED_ENTRY) continue;
+        MapKey key = { e.key.str, e.key.i };
+        HashMapSlot* s = locate(map, key, e.hash, NULL, NULL);
+        s->value = (void*)(intptr_t)n;
+        map->entries[n++] = e;
+    }
+    map->entries_used = n;
+}
+
+// Room for one more entry
+static bool reserve_entry(HashMap* map) {
+    if (map->entries_used < map->entries_capacity) return true;
+    if (map->entries_used - map->size >= map->entries_used / 2) {
+        compact_entries(map);
+        return true;
+    }
+    return grow_entries(map, map->entries_capacity * 2);
+}
+
+// Give the new key in slot s (hash and key set) the next entry
+static void append_entry(HashMap* map, HashMapSlot* s) {
+    int64_t i = map->entries_used++;
+    map->entries[i] = *s;
+    s->value = (void*)(intptr_t)i;
+}
+
+// Entries for the full slots of t, in table order
+static void link_entries(HashMap* map, Table t) {
+    for (int64_t i = 0; i < t.capacity; i++) {
+        if (!(t.ctrl[i] & 0x80)) append_entry(map, &t.slots[i]);
+    }
+}
+
+// Move the values of t's full slots back from their entries
+static void unlink_entries(HashMap* map, Table t) {
+    for (int64_t i = 0; i < t.capacity; i++) {
+        if (!(t.ctrl[i] & 0x80)) t.slots[i].value = map->entries[entry_index(&t.slots[i])].value;
+    }
+}
+
+void hashmap_set_ordered(HashMap* map, int32_t ordered) {
+    if (!map || (ordered != 0) == (map->entries != NULL)) return;
+    if (ordered) {
+        int64_t cap = HASHMAP_MIN_CAPACITY;
+        while (cap < map->size) cap *= 2;
+        if (!grow_entries(map, cap)) return;
+        map->entries_used = 0;
+        link_entries(map, current_table(map));
+        if (map->old_ctrl) link_entries(map, old_table(map));
+    } else {
+        unlink_entries(map, current_table(map));
+        if (map->old_ctrl) unlink_entries(map, old_table(map));
+        free(map->entries);
+        map->entries = NULL;
+        map->entries_used = 0;
+        map->entries_capacity = 0;
+    }
+}
+
+static void* lookup_key(HashMap* map, MapKey key, uint64_t hash) {
+    migrate_step(map);
+    HashMapSlot* s = locate(map, key, hash, NULL, NULL);
+    return s ? *value_ref(map, s) : NULL;
+}
+
+static int32_t has_key(HashMap* map, MapKey key, uint64_t hash) {
+    migrate_step(map);
+    return locate(map, key, hash, NULL, NULL) != NULL;
+}
+
+// Set the key's value; a new string key is retained and a replaced value
+// released.  0 if the table could not grow.
+static int32_t insert_key(HashMap* map, MapKey key, uint64_t hash, void* value) {
+    migrate_step(map);
+    HashMapSlot* s = locate(map, key, hash, NULL, NULL);
+    if (!s) {
+        if (!reserve_one(map) || (map->entries && !reserve_entry(map))) return 0;
+        s = &map->slots[place(map, hash)];
+        if (map->key_kind == HASHMAP_KEY_STRING) {
+            s->key.str = string_retain((StringDescriptor*)key.str);
+        } else {
+            s->key.i = key.bits;
+        }
+        if (map->entries) append_entry(map, s);
+        map->size++;
+        *value_ref(map, s) = value;
+        return 1;
+    }
+    void** ref = value_ref(map, s);
+    void* old = *ref;
+    *ref = value;
+    release_value(map, old);
+    return 1;
+}
+
+// Remove the key; its slot (still holding the key) or NULL if absent
+static HashMapSlot* remove_key(HashMap* map, MapKey key, uint64_t hash) {
+    migrate_step(map);
+    Table t;
+    int64_t i;
+    HashMapSlot* s = locate(map, key, hash, &t, &i);
+    if (!s) return NULL;
+    set_ctrl(t, i, HASHMAP_CTRL_DELETED);
+    release_value(map, *value_ref(map, s));
+    if (map->entries) map->entries[entry_index(s)].value = REMOVED_ENTRY;
+    s->value = NULL;
+    map->size--;
+    if (t.ctrl == map->ctrl) {
+        map->tombstones++;
+    } else {
+        map->old_size--;
+    }
+    return s;
+}
+
+static inline MapKey str_key(const StringDescriptor* key) {
+    MapKey k = { key, 0 };
+    return k;
+}
+
+static inline MapKey bits_key(int64_t bits) {
+    MapKey k = { NULL, bits };
+    return k;
+}
+
+int32_t hashmap_insert_str(HashMap* map, StringDescriptor* key, void* value) {
+    if (!map || !key) return 0;
+    return insert_key(map, str_key(key), hashmap_hash_string(key), value);
+}
+
+void* hashmap_lookup_str(HashMap* map, const StringDescriptor* key) {
+    if (!map || !key) return NULL;
+    return lookup_key(map, str_key(key), hashmap_hash_string(key));
+}
+
+int32_t hashmap_has_key_str(HashMap* map, const StringDescriptor* key) {
+    if (!map || !key) return 0;
+    return has_key(map, str_key(key), hashmap_hash_string(key));
+}
+
+int32_t hashmap_remove_str(HashMap* map, const StringDescriptor* key) {
+    if (!map || !key) return 0;
+    HashMapSlot* s = remove_key(map, str_key(key), hashmap_hash_string(key));
+    if (!s) return 0;
+    string_release(s->key.str);
+    return 1;
+}
+
+int32_t hashmap_insert_int(HashMap* map, int64_t key, void* value) {
+    if (!map) return 0;
+    return insert_key(map, bits_key(key), hashmap_hash_int(key), value);
+}
+
+void* hashmap_lookup_int(HashMap* map, int64_t key) {
+    if (!map) return NULL;
+    return lookup_key(map, bits_key(key), hashmap_hash_int(key));
+}
+
+int32_t hashmap_has_key_int(HashMap* map, int64_t key) {
+    if (!map) return 0;
+    return has_key(map, bits_key(key), hashmap_hash_int(key));
+}
+
+int32_t hashmap_remove_int(HashMap* map, int64_t key) {
+    if (!map) return 0;
+    return remove_key(map, bits_key(key), hashmap_hash_int(key)) != NULL;
+}
+
+int32_t hashmap_insert_double(HashMap* map, double key, void* value) {
+    if (!map) return 0;
+    return insert_key(map, bits_key(double_key_bits(key)), hashmap_hash_double(key), value);
+}
+
+void* hashmap_lookup_double(HashMap* map, double key) {
+    if (!map) return NULL;
+    return lookup_key(map, bits_key(double_key_bits(key)), hashmap_hash_double(key));
+}
+
+int32_t hashmap_has_key_double(HashMap* map, double key) {
+    if (!map) return 0;
+    return has_key(map, bits_key(double_key_bits(key)), hashmap_hash_double(key));
+}
+
+int32_t hashmap_remove_double(HashMap* map, double key) {
+    if (!map) return 0;
+    return remove_key(map, bits_key(double_key_bits(key)), hashmap_hash_double(key)) != NULL;
+}
+
+// =============================================================================
+// Statistics
+// =============================================================================
+
+void hashmap_stats(HashMap* map, HashMapStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+    if (!map) return;
+    stats->size = map->size;
+    stats->capacity = map->capacity;
+    stats->tombstones = map->tombstones;
+    stats->migrating = map->old_size;
+    stats->resizes = map->resizes;
+    stats->max_pause_ns = map->max_pause_ns;
+    stats->last_pause_ns = map->last_pause_ns;
+    stats->incremental = map->incremental;
+    stats->ordered = map->entries != NULL;
+}
+
+StringDescriptor* hashmap_stats_string(HashMap* map) {
+    HashMapStats s;
+    char buf[256];
+    hashmap_stats(map, &s);
+    snprintf(buf, sizeof(buf),
+             "size=%lld capacity=%lld tombstones=%lld migrating=%lld resizes=%lld "
+             "max_pause_us=%.1f last_pause_us=%.1f ordered=%d incremental=%d",
+             (long long)s.size, (long long)s.capacity, (long long)s.tombstones,
+             (long long)s.migrating, (long long)s.resizes,
+             s.max_pause_ns / 1000.0, s.last_pause_ns / 1000.0, s.ordered, s.incremental);
+    return string_new_ascii(buf);
+}
+
+int64_t hashmap_max_pause(HashMap* map) {
+    return map ? map->max_pause_ns : 0;
+}
+
+void hashmap_reset_stats(HashMap* map) {
+    if (!map) return;
+    map->max_pause_ns = 0;
+    map->last_pause_ns = 0;
+    map->resizes = 0;
+}
+
+// =============================================================================
+// C String Keys
+// =============================================================================
+//
+// An ASCII key is looked up through a descriptor on the stack; other UTF-8
+// is decoded first (to UTF-32, as BASIC strings would hold it).
+
+static bool is_ascii(const char* s, size_t n) {
+    uint8_t high = 0;
+    for (size_t i = 0; i < n; i++) high |= (uint8_t)s[i];
+    return high < 0x80;
+}
+
+static void stack_key(StringDescriptor* desc, const char* key, size_t n) {
+    memset(desc, 0, sizeof(*desc));
+    desc->data = (void*)key;
+    desc->length = (int64_t)n;
+    desc->refcount = 1;
+    desc->encoding = STRING_ENCODING_ASCII;
+}
+
+int32_t hashmap_insert(HashMap* map, const char* key, void* value) {
+    if (!map || !key) return 0;
+    // The map keeps its own copy, so the key needs a heap descriptor
+    StringDescriptor* desc = string_assign_utf8(NULL, key, (int64_t)strlen(key));
+    if (!desc) return 0;
+    int32_t ok = hashmap_insert_str(map, desc, value);
+    string_release(desc);
+    return ok;
+}
+
+void* hashmap_lookup(HashMap* map, const char* key) {
+    if (!map || !key) return NULL;
+    size_t n = strlen(key);
+    if (is_ascii(key, n)) {
+        StringDescriptor desc;
+        stack_key(&desc, key, n);
+        return hashmap_lookup_str(map, &desc);
+    }
+    StringDescriptor* desc = string_assign_utf8(NULL, key, (int64_t)n);
+    void* value = hashmap_lookup_str(map, desc);
+    string_release(desc);
+    return value;
+}
+
+int32_t hashmap_has_key(HashMap* map, const char* key) {
+    if (!map || !key) return 0;
+    size_t n = strlen(key);
+    if (is_ascii(key, n)) {
+        StringDescriptor desc;
+        stack_key(&desc, key, n);
+        return hashmap_has_key_str(map, &desc);
+    }
+    StringDescriptor* desc = string_assign_utf8(NULL, key, (int64_t)n);
+    int32_t found = hashmap_has_key_str(map, desc);
+    string_release(desc);
+    return found;
+}
+
+int32_t hashmap_remove(HashMap* map, const char* key) {
+    if (!map || !key) return 0;
+    size_t n = strlen(key);
+    if (is_ascii(key, n)) {
+        StringDescriptor desc;
+        stack_key(&desc, key, n);
+        return hashmap_remove_str(map, &desc);
+    }
+    StringDescriptor* desc = string_assign_utf8(NULL, key, (int64_t)n);
+    int32_t removed = hashmap_remove_str(map, desc);
+    string_release(desc);
+    return removed;
+}
+
+// =============================================================================
+// Iteration
+// =============================================================================
+//
+// An ordered map is walked through its entries.  Otherwise positions below
+// capacity are slots of the current table, a group of control bytes at a
+// time, and the ones above are slots of the old table (only there if an
+// insert in the loop started a resize).
+
+_Static_assert(offsetof(HashMapSlot, key) == HASHMAP_SLOT_KEY_OFFSET, "HashMapSlot.key offset");
+_Static_assert(offsetof(HashMapSlot, value) == HASHMAP_SLOT_VALUE_OFFSET, "HashMapSlot.value offset");
+
+// First full slot of t at or after `from`, or -1
+static int64_t next_full(Table t, int64_t from) {
+    int64_t base = from & ~(int64_t)(HASHMAP_GROUP_WIDTH - 1);
+    if (base >= t.capacity) return -1;
+    GroupMask m = group_match_full(t.ctrl + base) &
+                  ~(((GroupMask)1 << ((from - base) << GROUP_SHIFT)) - 1);
+    while (!m) {
+        base += HASHMAP_GROUP_WIDTH;
+        if (base >= t.capacity) return -1;
+        m = group_match_full(t.ctrl + base);
+    }
+    return base + group_next(&m);
+}
+
+HashMapSlot* hashmap_iter_next(HashMap* map, int64_t* pos) {
+    if (!map) return NULL;
+    int64_t p = *pos;
+    if (p == 0 && map->old_ctrl && !map->entries) {
+        // Moving entries between tables mid-loop would skip some of them
+        int64_t start = now_ns();
+        migrate(map, map->old_capacity);
+        record_pause(map, start);
+    }
+
+    if (map->entries) {
+        while (p < map->entries_used) {
+            HashMapSlot* e = &map->entries[p++];
+            if (e->value != REMOVED_ENTRY) {
+                *pos = p;
+                return e;
+            }
+        }
+        *pos = p;
+        return NULL;
+    }
+
+    if (p < map->capacity) {
+        int64_t i = next_full(current_table(map), p);
+        if (i >= 0) {
+            *pos = i + 1;
+            return &map->slots[i];
+        }
+        p = map->capacity;
+    }
+    if (map->old_ctrl) {
+        int64_t i = next_full(old_table(map), p - map->capacity);
+        if (i >= 0) {
+            *pos = map->capacity + i + 1;
+            return &map->old_slots[i];
+        }
+    }
+    *pos = p;
+    return NULL;
+}
+
+int64_t hashmap_export(HashMap* map, int64_t* pos, HashMapSlot* out, int64_t max) {
+    int64_t n = 0;
+    HashMapSlot* e;
+    while (n < max && (e = hashmap_iter_next(map, pos)) != NULL) out[n++] = *e;
+    return n;
+}
+
+void** hashmap_keys(HashMap* map) {
+    if (!map) return NULL;
+    void** keys = (void**)malloc((size_t)(map->size + 1) * sizeof(void*));
+    if (!keys) return NULL;
+    int64_t n = 0;
+    if (map->key_kind == HASHMAP_KEY_STRING) {
+        int64_t pos = 0;
+        HashMapSlot* e;
+        while ((e = hashmap_iter_next(map, &pos)) != NULL) {
+            keys[n++] = (void*)string_to_utf8(e->key.str);
+        }
+    }
+    keys[n] = NULL;
+    return keys;
+}
@@ -231,7 +231,7 @@ void basic_print_using(StringDescriptor* format, int64_t count, StringDescriptor
         }
     }
 
-    fflush(stdout);
+    _basic_output_written();
 
     // Clean up
     if (arg_strings) {
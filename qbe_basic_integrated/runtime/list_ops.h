@@ -13,9 +13,22 @@
  * The type tag on each atom allows heterogeneous LIST OF ANY collections
  * while typed lists (LIST OF INTEGER, etc.) always set the same tag.
  *
+ * Chunked storage (LIST OF INTEGER / DOUBLE / STRING):
+ *   A list whose flags say LIST_FLAG_ELEM_INT, _FLOAT or _STRING keeps its
+ *   atoms in ListChunk blocks — an unrolled list of contiguous atom arrays
+ *   — instead of one pool slot per atom.  The atoms are ordinary ListAtoms
+ *   still chained by `next` (head, tail and the list_iter_* cursor work
+ *   unchanged), but:
+ *     - positional get / insert / remove skip whole chunks: O(n / chunk)
+ *     - pop is O(1) (the tail's chunk is found from the tail atom)
+ *     - iteration walks memory in order
+ *   In a chunked list atom->pad holds the atom's index in its chunk.
+ *   Chunks belong to the header (they are not SAMM-tracked one by one) and
+ *   are freed with it.
+ *
  * SAMM integration:
  *   - list_create() tracks the header as SAMM_ALLOC_LIST
- *   - Each atom is tracked as SAMM_ALLOC_LIST_ATOM
+ *   - Each atom of a linked list is tracked as SAMM_ALLOC_LIST_ATOM
  *   - String atoms call string_retain() on append, string_release() on free
  *   - Nested list atoms are recursively freed via list_free()
  *
@@ -80,6 +93,28 @@ typedef struct ListAtom {
     struct ListAtom* next;  /* Next atom in chain (NULL = last element)     */
 } ListAtom;
 
+/* ========================================================================= */
+/* ListChunk — block of atoms for typed lists                                 */
+/* ========================================================================= */
+/*
+ * Atoms cells[start .. start+count-1] are in use.  Chunks start small and
+ * double up to LIST_CHUNK_MAX atoms as the list grows, so a short list
+ * costs little more than its linked form.
+ */
+
+#define LIST_CHUNK_MIN  4
+#define LIST_CHUNK_MAX  64
+
+typedef struct ListChunk {
+    struct ListChunk* prev;
+    struct ListChunk* next;
+    int32_t  start;         /* First atom in use                            */
+    int32_t  count;         /* Atoms in use                                 */
+    int32_t  capacity;      /* Atoms in cells[]                             */
+    int32_t  pad;
+    ListAtom cells[];
+} ListChunk;
+
 /* ========================================================================= */
 /* ListHeader — 32 bytes, the "handle" that BASIC variables point to          */
 /* ========================================================================= */
@@ -145,7 +180,7 @@ void list_prepend_string(ListHeader* list, StringDescriptor* value);
 void list_prepend_list(ListHeader* list, ListHeader* nested);
 
 /* ========================================================================= */
-/* Adding Elements — Insert (at 1-based position, O(n))                       */
+/* Adding Elements — Insert (at 1-based position; O(n / chunk) if chunked)    */
 /* ========================================================================= */
 
 void list_insert_int(ListHeader* list, int64_t pos, int64_t value);
@@ -178,7 +213,7 @@ int32_t  list_shift_type(ListHeader* list);
 void     list_shift(ListHeader* list);
 
 /* ========================================================================= */
-/* Removing Elements — Pop (remove last, O(n) for singly-linked)              */
+/* Removing Elements — Pop (remove last; O(n) linked, O(1) chunked)          */
 /* ========================================================================= */
 
 /** Remove last element, return its integer value. Returns 0 if empty. */
@@ -204,7 +239,7 @@ void list_remove(ListHeader* list, int64_t pos);
 void list_clear(ListHeader* list);
 
 /* ========================================================================= */
-/* Access — Positional (1-based, O(n))                                        */
+/* Access — Positional (1-based; O(n) linked, O(n / chunk) chunked)          */
 /* ========================================================================= */
 
 /** Get integer value at 1-based position. Returns 0 if out of range. */
@@ -347,6 +382,56 @@ int64_t  list_indexof_string(ListHeader* list, StringDescriptor* value);
  */
 StringDescriptor* list_join(ListHeader* list, StringDescriptor* separator);
 
+/* ========================================================================= */
+/* Operations — Sort                                                          */
+/* ========================================================================= */
+
+/**
+ * Sort the list in place, stable, in O(n log n).  Numbers (INT and FLOAT
+ * atoms, compared by value) come before strings, strings before any other
+ * atoms, which keep their order.  nocase compares strings ignoring case.
+ * The atoms stay where they are; their values move.
+ */
+void list_sort(ListHeader* list, int32_t descending, int32_t nocase);
+
+/* ========================================================================= */
+/* Operations — Reductions                                                    */
+/* ========================================================================= */
+/*
+ * Over the numeric (INT and FLOAT) atoms; other atoms are skipped.  An
+ * empty list (or one without numbers) gives 0.  The _int forms truncate
+ * FLOAT atoms.
+ */
+
+int64_t list_sum_int(ListHeader* list);
+double  list_sum_float(ListHeader* list);
+int64_t list_min_int(ListHeader* list);
+double  list_min_float(ListHeader* list);
+int64_t list_max_int(ListHeader* list);
+double  list_max_float(ListHeader* list);
+double  list_avg(ListHeader* list);
+
+/* ========================================================================= */
+/* Operations — Filter / Map (return new lists)                               */
+/* ========================================================================= */
+/*
+ * op is a comparison for filters: "=", "<>", "<", "<=", ">", ">="
+ * ("==" and "!=" also work), and an operator for maps: "+", "-", "*",
+ * "/", "MOD".  An unknown op prints a warning and gives an empty list.
+ *
+ * Filters keep the atoms of the matching kind (numbers for _int/_float,
+ * strings for _string) for which `atom op value` holds.  Maps compute
+ * `atom op value` for every number and copy other atoms unchanged;
+ * list_map_int divides as integers (a zero divisor gives 0), list_map_float
+ * turns every number into a FLOAT.  The result has the source's flags.
+ */
+
+ListHeader* list_filter_int(ListHeader* list, StringDescriptor* op, int64_t value);
+ListHeader* list_filter_float(ListHeader* list, StringDescriptor* op, double value);
+ListHeader* list_filter_string(ListHeader* list, StringDescriptor* op, StringDescriptor* value);
+ListHeader* list_map_int(ListHeader* list, StringDescriptor* op, int64_t value);
+ListHeader* list_map_float(ListHeader* list, StringDescriptor* op, double value);
+
 /* ========================================================================= */
 /* Utility                                                                    */
 /* ========================================================================= */
@@ -368,6 +453,16 @@ static inline int32_t list_elem_type_flag(const ListHeader* list) {
     return list->flags & LIST_FLAG_ELEM_MASK;
 }
 
+/**
+ * 1 if the list keeps its atoms in ListChunks (LIST OF INTEGER / DOUBLE /
+ * STRING), 0 if each atom is a separate allocation.
+ */
+static inline int list_is_chunked(const ListHeader* list) {
+    int32_t elem = list_elem_type_flag(list);
+    return elem == LIST_FLAG_ELEM_INT || elem == LIST_FLAG_ELEM_FLOAT ||
+           elem == LIST_FLAG_ELEM_STRING;
+}
+
 /**
  * Debug: print list contents to stderr.
  */
@@ -395,8 +490,9 @@ void list_debug_print(ListHeader* list);
 
 /**
  * Called by SAMM cleanup for SAMM_ALLOC_LIST pointers.
- * Frees the header struct only — does NOT walk the atom chain,
- * because SAMM tracks and frees atoms independently.
+ * Frees the header struct — and, for a chunked list, its chunks and their
+ * payloads.  It does NOT walk a linked list's atom chain, because SAMM
+ * tracks and frees those atoms independently.
  */
 void list_free_from_samm(void* header_ptr);
 
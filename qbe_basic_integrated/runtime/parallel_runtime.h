@@ -0,0 +1,58 @@
+/*
+ * parallel_runtime.h
+ * FasterBASIC Runtime — PARALLEL FOR
+ *
+ * PARALLEL FOR i = a TO b [STEP s] [REDUCE op(var), ...] is compiled to:
+ *
+ *   - a body function  body(env, first, last)  that runs iterations
+ *     k = first .. last-1 of the loop, with i = a + k * s, on private
+ *     copies of every scalar the loop body uses
+ *   - an environment block holding a and s, the values of the scalars
+ *     the body reads, and one accumulator per REDUCE variable
+ *   - a call to basic_parallel_for(body, env, a, b, s), which splits the
+ *     iteration space into chunks and runs them on a pool of threads
+ *     (the calling thread included), returning once all have finished
+ *
+ * At the end of its chunk the body folds each private partial result
+ * into the accumulator with basic_parallel_reduce_long/_double; the
+ * caller then copies the accumulators back to the REDUCE variables.
+ *
+ * The pool has one thread per core (BASIC_THREADS overrides the count,
+ * the calling thread included), started on the first PARALLEL FOR.
+ * Chunks are handed out from a shared counter, so threads that finish
+ * early take more.  Loops run one at a time; PARALLEL FOR does not nest.
+ */
+
+#ifndef PARALLEL_RUNTIME_H
+#define PARALLEL_RUNTIME_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* REDUCE operators (op argument of basic_parallel_reduce_*) */
+#define PARALLEL_REDUCE_SUM  0
+#define PARALLEL_REDUCE_MIN  1
+#define PARALLEL_REDUCE_MAX  2
+
+typedef void (*ParallelBody)(void *env, int64_t first, int64_t last);
+
+/* Run body over the iterations of FOR i = start TO end STEP step.
+ * Returns the number of iterations (0 if the range is empty). */
+int64_t basic_parallel_for(ParallelBody body, void *env,
+                           int64_t start, int64_t end, int64_t step);
+
+/* Fold a chunk's partial result into a REDUCE accumulator. */
+void basic_parallel_reduce_long(int64_t *acc, int64_t value, int32_t op);
+void basic_parallel_reduce_double(double *acc, double value, int32_t op);
+
+/* Number of threads PARALLEL FOR uses, the calling thread included. */
+int32_t basic_parallel_threads(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PARALLEL_RUNTIME_H */
@@ -45,6 +45,57 @@ SammSlabPool g_list_atom_pool   = {0};
 
 SammSlabPool g_object_pools[SAMM_OBJECT_SIZE_CLASSES] = {{0}};
 
+/* ========================================================================= */
+/* Thread-Local Magazines                                                     */
+/*                                                                            */
+/* Every pool that gets a cache_id at init owns one magazine slot in each    */
+/* thread's SammThreadCache.  A magazine is a LIFO stack of free slots that  */
+/* only its thread touches, so alloc/free on it need no lock.  Slots move    */
+/* between a magazine and the pool's shared free list SAMM_POOL_MAGAZINE_    */
+/* BATCH at a time under pool->lock.                                          */
+/*                                                                            */
+/* A magazine remembers the pool generation it was filled from.  When a      */
+/* pool is destroyed or re-initialised its generation changes and any stale  */
+/* magazine is simply emptied on next use: its slots belonged to slabs that  */
+/* no longer exist.                                                           */
+/*                                                                            */
+/* The registry below maps cache_id -> live pool so that a thread-exit       */
+/* destructor can hand its magazines back.  Lock order: registry -> pool.    */
+/* ========================================================================= */
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define SAMM_POOL_THREAD_LOCAL  _Thread_local
+#else
+#define SAMM_POOL_THREAD_LOCAL  __thread
+#endif
+
+typedef struct {
+    void*         slots[SAMM_POOL_MAGAZINE_SIZE];
+    uint32_t      count;        /* Free slots currently held             */
+    uint32_t      reported;     /* count as last folded into pool->cached */
+    uint32_t      generation;   /* pool->generation when attached (0=none)*/
+    SammSlabPool* pool;
+    /* Pending counters, folded into the pool under its lock */
+    size_t        allocs;
+    size_t        frees;
+    size_t        hits;
+    size_t        misses;
+} SammMagazine;
+
+typedef struct {
+    SammMagazine mags[SAMM_POOL_MAX_CACHED_POOLS];
+} SammThreadCache;
+
+static struct {
+    pthread_mutex_t mutex;
+    pthread_once_t  key_once;
+    pthread_key_t   key;
+    SammSlabPool*   pools[SAMM_POOL_MAX_CACHED_POOLS];
+    uint32_t        next_generation;
+} g_pool_cache = { .mutex = PTHREAD_MUTEX_INITIALIZER, .key_once = PTHREAD_ONCE_INIT };
+
+static SAMM_POOL_THREAD_LOCAL SammThreadCache* t_pool_cache = NULL;
+
 /* ========================================================================= */
 /* Internal: Free-list link overlay                                           */
 /*                                                                            */
@@ -90,9 +141,11 @@ static bool pool_add_slab(SammSlabPool* pool) {
 
     /* Safety limit */
     if (pool->total_slabs >= SAMM_SLAB_POOL_MAX_SLABS) {
-        fprintf(stderr, "ERROR: %s pool maximum slabs reached (%d)\n",
-                pool->name ? pool->name : "SammSlabPool",
-                SAMM_SLAB_POOL_MAX_SLABS);
+        if (!pool->exhausted) {
+            fprintf(stderr, "ERROR: %s pool maximum slabs reached (%d)\n",
+                    pool->name ? pool->name : "SammSlabPool",
+                    SAMM_SLAB_POOL_MAX_SLABS);
+        }
         return false;
     }
 
@@ -146,6 +199,199 @@ static bool pool_add_slab(SammSlabPool* pool) {
     return true;
 }
 
+/* ========================================================================= */
+/* Internal: Magazine refill / spill                                          */
+/* ========================================================================= */
+
+/*
+ * Fold a magazine's pending counters into its pool.
+ * Caller must hold pool->lock.
+ */
+static void magazine_fold(SammSlabPool* pool, SammMagazine* m) {
+    pool->total_allocs += m->allocs;
+    pool->total_frees  += m->frees;
+    pool->cache_hits   += m->hits;
+    pool->cache_misses += m->misses;
+    m->allocs = m->frees = m->hits = m->misses = 0;
+
+    pool->cached = pool->cached + m->count >= m->reported
+                       ? pool->cached + m->count - m->reported : 0;
+    m->reported = m->count;
+
+    size_t live = pool->in_use > pool->cached ? pool->in_use - pool->cached : 0;
+    if (live > pool->peak_use) {
+        pool->peak_use = live;
+    }
+}
+
+/*
+ * Move up to SAMM_POOL_MAGAZINE_BATCH slots from the shared free list into
+ * an empty magazine, growing the pool if needed.
+ * Caller must hold pool->lock.
+ */
+static void magazine_refill(SammSlabPool* pool, SammMagazine* m) {
+    while (m->count < SAMM_POOL_MAGAZINE_BATCH) {
+        if (!pool->free_list && !pool_add_slab(pool)) break;
+        void* slot = pool->free_list;
+        pool->free_list = freelist_next(slot);
+        pool->in_use++;
+        m->slots[m->count++] = slot;
+    }
+    magazine_fold(pool, m);
+}
+
+/*
+ * Return the top `n` slots of a magazine to the shared free list.
+ * Caller must hold pool->lock.
+ */
+static void magazine_spill(SammSlabPool* pool, SammMagazine* m, uint32_t n) {
+    if (n > m->count) n = m->count;
+    for (uint32_t i = 0; i < n; i++) {
+        void* slot = m->slots[--m->count];
+        freelist_set_next(slot, pool->free_list);
+        pool->free_list = slot;
+    }
+    if (pool->in_use >= n) {
+        pool->in_use -= n;
+    } else {
+        fprintf(stderr, "WARNING: %s pool free when in_use is already 0 "
+                "(double free?)\n",
+                pool->name ? pool->name : "SammSlabPool");
+        pool->in_use = 0;
+    }
+    magazine_fold(pool, m);
+}
+
+/* pthread key destructor: hand a dying thread's magazines back. */
+static void pool_cache_thread_exit(void* arg) {
+    SammThreadCache* tc = (SammThreadCache*)arg;
+    if (!tc) return;
+
+    pthread_mutex_lock(&g_pool_cache.mutex);
+    for (int id = 0; id < SAMM_POOL_MAX_CACHED_POOLS; id++) {
+        SammMagazine* m = &tc->mags[id];
+        SammSlabPool* pool = g_pool_cache.pools[id];
+        if (pool && m->pool == pool && m->generation == pool->generation) {
+            pthread_mutex_lock(&pool->lock);
+            magazine_spill(pool, m, m->count);
+            pthread_mutex_unlock(&pool->lock);
+        }
+    }
+    pthread_mutex_unlock(&g_pool_cache.mutex);
+
+    if (t_pool_cache == tc) t_pool_cache = NULL;
+    free(tc);
+}
+
+static void pool_cache_make_key(void) {
+    pthread_key_create(&g_pool_cache.key, pool_cache_thread_exit);
+}
+
+/*
+ * The calling thread's magazine for `pool`, or NULL if the pool is not
+ * cached (no cache_id, or the thread cache could not be allocated).
+ */
+static inline SammMagazine* pool_magazine(SammSlabPool* pool) {
+    /* generation 0: never initialised, or already destroyed */
+    if (pool->cache_id < 0 || pool->generation == 0) return NULL;
+
+    SammThreadCache* tc = t_pool_cache;
+    if (!tc) {
+        pthread_once(&g_pool_cache.key_once, pool_cache_make_key);
+        tc = (SammThreadCache*)calloc(1, sizeof(SammThreadCache));
+        if (!tc) return NULL;
+        pthread_setspecific(g_pool_cache.key, tc);
+        t_pool_cache = tc;
+    }
+
+    SammMagazine* m = &tc->mags[pool->cache_id];
+    if (m->pool != pool || m->generation != pool->generation) {
+        /* Unused, or left over from a destroyed pool: start empty. */
+        memset(m, 0, sizeof(*m));
+        m->pool       = pool;
+        m->generation = pool->generation;
+    }
+    return m;
+}
+
+/*
+ * Give `pool` a magazine slot.  Re-initialising a pool that is still
+ * registered keeps its slot.  Pools beyond SAMM_POOL_MAX_CACHED_POOLS run
+ * uncached.
+ */
+static void pool_cache_register(SammSlabPool* pool) {
+    pthread_mutex_lock(&g_pool_cache.mutex);
+    int id = -1;
+    for (int i = 0; i < SAMM_POOL_MAX_CACHED_POOLS; i++) {
+        if (g_pool_cache.pools[i] == pool) { id = i; break; }
+        if (id < 0 && !g_pool_cache.pools[i]) id = i;
+    }
+    if (id >= 0) g_pool_cache.pools[id] = pool;
+    if (++g_pool_cache.next_generation == 0) g_pool_cache.next_generation = 1;
+    pool->cache_id   = id;
+    pool->generation = g_pool_cache.next_generation;
+    pthread_mutex_unlock(&g_pool_cache.mutex);
+}
+
+static void pool_cache_unregister(SammSlabPool* pool) {
+    if (pool->cache_id < 0 || pool->generation == 0) return;
+
+    /* Hand back the calling thread's magazine so its slots are not
+     * counted as leaks. */
+    SammThreadCache* tc = t_pool_cache;
+    if (tc) {
+        SammMagazine* m = &tc->mags[pool->cache_id];
+        if (m->pool == pool && m->generation == pool->generation) {
+            pthread_mutex_lock(&pool->lock);
+            magazine_spill(pool, m, m->count);
+            pthread_mutex_unlock(&pool->lock);
+        }
+    }
+
+    pthread_mutex_lock(&g_pool_cache.mutex);
+    if (g_pool_cache.pools[pool->cache_id] == pool) {
+        g_pool_cache.pools[pool->cache_id] = NULL;
+    }
+    pthread_mutex_unlock(&g_pool_cache.mutex);
+    pool->cache_id = -1;
+}
+
+/*
+ * Counters as seen by the calling thread: the pool's folded totals plus
+ * this thread's pending magazine counts.
+ */
+typedef struct {
+    size_t live;
+    size_t allocs;
+    size_t frees;
+    size_t hits;
+    size_t misses;
+} SammPoolView;
+
+static SammPoolView pool_view(const SammSlabPool* pool) {
+    SammPoolView v;
+    size_t cached = pool->cached;
+    v.allocs = pool->total_allocs;
+    v.frees  = pool->total_frees;
+    v.hits   = pool->cache_hits;
+    v.misses = pool->cache_misses;
+
+    SammThreadCache* tc = t_pool_cache;
+    if (tc && pool->cache_id >= 0) {
+        const SammMagazine* m = &tc->mags[pool->cache_id];
+        if (m->pool == pool && m->generation == pool->generation) {
+            v.allocs += m->allocs;
+            v.frees  += m->frees;
+            v.hits   += m->hits;
+            v.misses += m->misses;
+            cached = cached + m->count >= m->reported
+                         ? cached + m->count - m->reported : 0;
+        }
+    }
+    v.live = pool->in_use > cached ? pool->in_use - cached : 0;
+    return v;
+}
+
 /* ========================================================================= */
 /* Public API: Initialisation & Destruction                                   */
 /* ========================================================================= */
@@ -174,6 +420,11 @@ void samm_slab_pool_init(SammSlabPool* pool,
     pool->peak_footprint_bytes = 0;
     pool->total_allocs   = 0;
     pool->total_frees    = 0;
+    pool->cached         = 0;
+    pool->cache_hits     = 0;
+    pool->cache_misses   = 0;
+
+    pool_cache_register(pool);
 
     /* Pre-allocate initial slabs so the first alloc doesn't hit malloc */
     for (size_t i = 0; i < SAMM_SLAB_POOL_INITIAL_SLABS; i++) {
@@ -193,16 +444,22 @@ void samm_slab_pool_init(SammSlabPool* pool,
 void samm_slab_pool_destroy(SammSlabPool* pool) {
     if (!pool) return;
 
+    /* Take the pool out of the magazine registry first so no exiting
+     * thread can spill into it while the slabs are being freed. */
+    pool_cache_unregister(pool);
+
     SAMM_POOL_TRACE("%s: destroying (slabs=%zu, in_use=%zu, peak=%zu, "
                     "allocs=%zu, frees=%zu)",
                     pool->name ? pool->name : "pool",
                     pool->total_slabs, pool->in_use, pool->peak_use,
                     pool->total_allocs, pool->total_frees);
 
-    /* Report leaks */
-    if (pool->in_use > 0) {
+    /* Report leaks (slots still parked in other live threads' magazines
+     * are free, not leaked) */
+    size_t live = pool->in_use > pool->cached ? pool->in_use - pool->cached : 0;
+    if (live > 0) {
         fprintf(stderr, "WARNING: %s pool has %zu leaked slots at shutdown\n",
-                pool->name ? pool->name : "SammSlabPool", pool->in_use);
+                pool->name ? pool->name : "SammSlabPool", live);
     }
 
     /* Free all slabs */
@@ -220,6 +477,7 @@ void samm_slab_pool_destroy(SammSlabPool* pool) {
     const char* saved_name = pool->name;
     memset(pool, 0, sizeof(SammSlabPool));
     pool->name = saved_name; /* preserve name for post-mortem diagnostics */
+    pool->cache_id = -1;
 }
 
 /* ========================================================================= */
@@ -229,6 +487,27 @@ void samm_slab_pool_destroy(SammSlabPool* pool) {
 void* samm_slab_pool_alloc(SammSlabPool* pool) {
     if (!pool) return NULL;
 
+    SammMagazine* m = pool_magazine(pool);
+    if (m) {
+        if (m->count > 0) {
+            m->hits++;
+        } else {
+            pthread_mutex_lock(&pool->lock);
+            m->misses++;
+            magazine_refill(pool, m);
+            pthread_mutex_unlock(&pool->lock);
+        }
+
+        if (m->count > 0) {
+            void* slot = m->slots[--m->count];
+            m->allocs++;
+            memset(slot, 0, pool->slot_size);
+            return slot;
+        }
+
+        /* Pool could not grow: fall through to the malloc fallback */
+    }
+
     pthread_mutex_lock(&pool->lock);
 
     /* If free list is empty, grow the pool */
@@ -237,11 +516,19 @@ void* samm_slab_pool_alloc(SammSlabPool* pool) {
             pthread_mutex_unlock(&pool->lock);
 
             /* Fallback to malloc — print warning once */
-            fprintf(stderr, "WARNING: %s pool exhausted, falling back to malloc\n",
-                    pool->name ? pool->name : "SammSlabPool");
+            if (!pool->exhausted) {
+                pool->exhausted = true;
+                fprintf(stderr, "WARNING: %s pool exhausted, falling back to malloc\n",
+                        pool->name ? pool->name : "SammSlabPool");
+            }
             void* ptr = malloc(pool->slot_size);
             if (ptr) {
                 memset(ptr, 0, pool->slot_size);
+                /* Counted as in use: its free adopts it into the free list */
+                pthread_mutex_lock(&pool->lock);
+                pool->in_use++;
+                pool->total_allocs++;
+                pthread_mutex_unlock(&pool->lock);
             }
             return ptr;
         }
@@ -275,6 +562,21 @@ void* samm_slab_pool_alloc(SammSlabPool* pool) {
 void samm_slab_pool_free(SammSlabPool* pool, void* ptr) {
     if (!pool || !ptr) return;
 
+    SammMagazine* m = pool_magazine(pool);
+    if (m) {
+        if (m->count < SAMM_POOL_MAGAZINE_SIZE) {
+            m->hits++;
+        } else {
+            pthread_mutex_lock(&pool->lock);
+            m->misses++;
+            magazine_spill(pool, m, SAMM_POOL_MAGAZINE_BATCH);
+            pthread_mutex_unlock(&pool->lock);
+        }
+        m->slots[m->count++] = ptr;
+        m->frees++;
+        return;
+    }
+
     pthread_mutex_lock(&pool->lock);
 
     /* Push onto free list head */
@@ -308,41 +610,55 @@ void samm_slab_pool_stats(const SammSlabPool* pool,
                           size_t* out_peak_use,
                           size_t* out_slabs,
                           size_t* out_allocs,
-                          size_t* out_frees) {
+                          size_t* out_frees,
+                          size_t* out_cache_hits,
+                          size_t* out_cache_misses) {
     if (!pool) return;
 
-    if (out_in_use)   *out_in_use   = pool->in_use;
-    if (out_capacity) *out_capacity = pool->total_capacity;
-    if (out_peak_use) *out_peak_use = pool->peak_use;
-    if (out_slabs)    *out_slabs    = pool->total_slabs;
-    if (out_allocs)   *out_allocs   = pool->total_allocs;
-    if (out_frees)    *out_frees    = pool->total_frees;
+    SammPoolView v = pool_view(pool);
+
+    if (out_in_use)       *out_in_use       = v.live;
+    if (out_capacity)     *out_capacity     = pool->total_capacity;
+    if (out_peak_use)     *out_peak_use     = pool->peak_use > v.live
+                                                  ? pool->peak_use : v.live;
+    if (out_slabs)        *out_slabs        = pool->total_slabs;
+    if (out_allocs)       *out_allocs       = v.allocs;
+    if (out_frees)        *out_frees        = v.frees;
+    if (out_cache_hits)   *out_cache_hits   = v.hits;
+    if (out_cache_misses) *out_cache_misses = v.misses;
 }
 
 void samm_slab_pool_print_stats(const SammSlabPool* pool) {
     if (!pool) return;
 
     const char* name = pool->name ? pool->name : "SammSlabPool";
+    SammPoolView v = pool_view(pool);
+    size_t peak_use = pool->peak_use > v.live ? pool->peak_use : v.live;
+    size_t cache_ops = v.hits + v.misses;
 
     fprintf(stderr, "=== %s Pool Statistics ===\n", name);
     fprintf(stderr, "  Slot size:       %u bytes\n",  pool->slot_size);
     fprintf(stderr, "  Slots/slab:      %u\n",        pool->slots_per_slab);
     fprintf(stderr, "  Slabs:           %zu\n",       pool->total_slabs);
     fprintf(stderr, "  Capacity:        %zu slots\n", pool->total_capacity);
-    fprintf(stderr, "  In use:          %zu slots\n", pool->in_use);
+    fprintf(stderr, "  In use:          %zu slots\n", v.live);
     fprintf(stderr, "  Free:            %zu slots\n",
-            pool->total_capacity > pool->in_use
-                ? pool->total_capacity - pool->in_use : 0);
-    fprintf(stderr, "  Peak usage:      %zu slots\n", pool->peak_use);
+            pool->total_capacity > v.live
+                ? pool->total_capacity - v.live : 0);
+    fprintf(stderr, "  Peak usage:      %zu slots\n", peak_use);
     fprintf(stderr, "  Usage:           %.1f%%\n",
-            samm_slab_pool_usage_percent(pool));
-    fprintf(stderr, "  Total allocs:    %zu\n",       pool->total_allocs);
-    fprintf(stderr, "  Total frees:     %zu\n",       pool->total_frees);
+            pool->total_capacity
+                ? (double)v.live / (double)pool->total_capacity * 100.0 : 0.0);
+    fprintf(stderr, "  Total allocs:    %zu\n",       v.allocs);
+    fprintf(stderr, "  Total frees:     %zu\n",       v.frees);
     fprintf(stderr, "  Net allocations: %+zd\n",
-            (ssize_t)pool->total_allocs - (ssize_t)pool->total_frees);
+            (ssize_t)v.allocs - (ssize_t)v.frees);
+    fprintf(stderr, "  Magazine hits:   %zu (%.1f%%)\n", v.hits,
+            cache_ops ? (double)v.hits / (double)cache_ops * 100.0 : 0.0);
+    fprintf(stderr, "  Magazine misses: %zu\n",       v.misses);
     size_t current_footprint = pool->total_slabs * (sizeof(SammSlab) +
         (size_t)pool->slots_per_slab * (size_t)pool->slot_size);
-    size_t peak_obj_bytes = pool->peak_use * (size_t)pool->slot_size;
+    size_t peak_obj_bytes = peak_use * (size_t)pool->slot_size;
     fprintf(stderr, "  Memory footprint: %zu bytes (%.1f KB)\n",
             current_footprint, (double)current_footprint / 1024.0);
     fprintf(stderr, "  Peak footprint:   %zu bytes (%.1f KB)\n",
@@ -350,7 +666,7 @@ void samm_slab_pool_print_stats(const SammSlabPool* pool) {
             (double)pool->peak_footprint_bytes / 1024.0);
     fprintf(stderr, "  Peak object mem:  %zu bytes (%.1f KB)  [%zu slots x %u B]\n",
             peak_obj_bytes, (double)peak_obj_bytes / 1024.0,
-            pool->peak_use, pool->slot_size);
+            peak_use, pool->slot_size);
     fprintf(stderr, "=======================================\n");
 }
 
@@ -391,18 +707,27 @@ void samm_slab_pool_check_leaks(const SammSlabPool* pool) {
     if (!pool) return;
 
     const char* name = pool->name ? pool->name : "SammSlabPool";
+    SammPoolView v = pool_view(pool);
 
-    if (pool->in_use == 0) {
+    if (v.live == 0) {
         fprintf(stderr, "%s: no leaked slots detected.\n", name);
         return;
     }
 
     fprintf(stderr, "WARNING: %s has %zu leaked slots (%zu allocs, %zu frees)\n",
-            name, pool->in_use, pool->total_allocs, pool->total_frees);
+            name, v.live, v.allocs, v.frees);
+
+    /* Slots in the calling thread's magazine are free too. */
+    const SammMagazine* mag = NULL;
+    if (t_pool_cache && pool->cache_id >= 0) {
+        mag = &t_pool_cache->mags[pool->cache_id];
+        if (mag->pool != pool || mag->generation != pool->generation) mag = NULL;
+    }
 
     /*
      * Enumerate leaked slots by scanning all slabs and checking which
-     * slots are NOT on the free list.
+     * slots are NOT on the free list (or in this thread's magazine;
+     * other threads' magazines are not visible and may show up here).
      *
      * This is O(slabs * slots_per_slab * free_list_length) in the worst
      * case, so it's only suitable for diagnostics at shutdown, not for
@@ -425,6 +750,9 @@ void samm_slab_pool_check_leaks(const SammSlabPool* pool) {
                 }
                 free_slot = freelist_next(free_slot);
             }
+            for (uint32_t k = 0; mag && !in_free_list && k < mag->count; k++) {
+                if (mag->slots[k] == slot) in_free_list = true;
+            }
 
             if (!in_free_list) {
                 leaked++;
@@ -439,7 +767,7 @@ void samm_slab_pool_check_leaks(const SammSlabPool* pool) {
                 /* Limit output for large leaks */
                 if (leaked >= 20) {
                     fprintf(stderr, "  ... (%zu more leaked slots not shown)\n",
-                            pool->in_use - leaked);
+                            v.live > leaked ? v.live - leaked : 0);
                     return;
                 }
             }
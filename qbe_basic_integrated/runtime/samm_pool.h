@@ -18,8 +18,16 @@
  *   Deallocation is O(1) — push onto free list head.
  *
  * Thread safety:
- *   A per-pool pthread_mutex protects alloc/free. Contention is expected
- *   to be low (main thread allocs, background worker frees, minimal overlap).
+ *   Each thread keeps a small magazine (stack of free slots) per pool.
+ *   Alloc pops from the calling thread's magazine and free pushes onto it
+ *   without taking any lock.  Only when a magazine runs empty (refill) or
+ *   full (spill) is the per-pool pthread_mutex taken, and then a whole
+ *   batch of SAMM_POOL_MAGAZINE_BATCH slots moves between the magazine and
+ *   the shared free list.  The main thread (allocating) and the SAMM
+ *   background worker (freeing) therefore meet on the lock once per batch
+ *   instead of once per slot.  A thread's magazines are returned to their
+ *   pools when the thread exits, and the calling thread's magazine is
+ *   returned when a pool is destroyed.
  *
  * See SAMM_POOL_DESIGN.md §4.1 / §9 Phase 5 for design rationale.
  */
@@ -86,20 +94,47 @@ typedef struct {
     size_t          peak_footprint_bytes; /* High-water mark of slab memory  */
     size_t          total_allocs;       /* Lifetime allocation count         */
     size_t          total_frees;        /* Lifetime free count               */
-    pthread_mutex_t lock;               /* Thread safety for alloc/free      */
+    size_t          cached;             /* Slots parked in thread magazines  */
+    size_t          cache_hits;         /* Alloc/free served by a magazine   */
+    size_t          cache_misses;       /* Alloc/free that took the lock     */
+    int32_t         cache_id;           /* Magazine slot (-1 = uncached)     */
+    uint32_t        generation;         /* Bumped on every init              */
+    bool            exhausted;          /* MAX_SLABS reached (warned once)   */
+    pthread_mutex_t lock;               /* Protects free list and slabs      */
     const char*     name;               /* Pool name for diagnostics         */
 } SammSlabPool;
 
+/*
+ * Accounting with magazines:
+ *   in_use        counts slots taken off the shared free list, including
+ *                 those sitting in a thread's magazine.
+ *   cached        is the magazine share of in_use, so the number of slots
+ *                 actually held by callers is (in_use - cached).
+ *   total_allocs, total_frees, cache_hits, cache_misses and cached are
+ *   folded in from each thread's magazine whenever it refills or spills
+ *   (and at thread exit), so other threads' figures may lag by up to one
+ *   batch.  samm_slab_pool_stats() adds the calling thread's pending counts.
+ */
+
 /* ========================================================================= */
 /* Configuration                                                              */
 /* ========================================================================= */
 
-/* Maximum number of slabs per pool (safety limit) */
-#define SAMM_SLAB_POOL_MAX_SLABS    1024
+/* Maximum number of slabs per pool (safety limit; 4M string descriptors,
+ * enough for a HASHMAP of 2M string keys and values) */
+#define SAMM_SLAB_POOL_MAX_SLABS    16384
 
 /* Initial slabs to pre-allocate at init (1 slab gives immediate capacity) */
 #define SAMM_SLAB_POOL_INITIAL_SLABS  1
 
+/* Per-thread magazine capacity (slots) and refill/spill batch size */
+#define SAMM_POOL_MAGAZINE_SIZE       64
+#define SAMM_POOL_MAGAZINE_BATCH      32
+
+/* Maximum number of live pools with magazines; further pools fall back
+ * to the locked path (SAMM itself uses 9) */
+#define SAMM_POOL_MAX_CACHED_POOLS    16
+
 /* ========================================================================= */
 /* Pool API                                                                   */
 /* ========================================================================= */
@@ -138,7 +173,8 @@ void samm_slab_pool_destroy(SammSlabPool* pool);
  * If slab allocation fails (MAX_SLABS reached), falls back to malloc
  * and prints a warning.
  *
- * Thread-safe (acquires pool lock).
+ * Thread-safe.  Served lock-free from the calling thread's magazine; the
+ * pool lock is taken only to refill an empty magazine.
  *
  * @param pool  Pool to allocate from
  * @return      Pointer to zeroed slot, or NULL on total failure
@@ -152,7 +188,8 @@ void* samm_slab_pool_alloc(SammSlabPool* pool);
  * at the next allocation.  The first sizeof(void*) bytes are overwritten
  * with the free-list link.
  *
- * Thread-safe (acquires pool lock).
+ * Thread-safe.  Pushed lock-free onto the calling thread's magazine; the
+ * pool lock is taken only to spill a full magazine back to the pool.
  *
  * @param pool  Pool that owns the slot
  * @param ptr   Pointer previously returned by samm_slab_pool_alloc()
@@ -166,6 +203,10 @@ void samm_slab_pool_free(SammSlabPool* pool, void* ptr);
 /**
  * Get pool statistics (snapshot, not locked — advisory only).
  *
+ * out_in_use excludes slots parked in thread magazines.  out_cache_hits
+ * counts allocs/frees served by a magazine without the pool lock;
+ * out_cache_misses counts those that had to refill or spill.
+ *
  * Any output pointer may be NULL to skip that stat.
  */
 void samm_slab_pool_stats(const SammSlabPool* pool,
@@ -174,7 +215,9 @@ void samm_slab_pool_stats(const SammSlabPool* pool,
                           size_t* out_peak_use,
                           size_t* out_slabs,
                           size_t* out_allocs,
-                          size_t* out_frees);
+                          size_t* out_frees,
+                          size_t* out_cache_hits,
+                          size_t* out_cache_misses);
 
 /**
  * Print pool statistics to stderr.
@@ -200,7 +243,8 @@ void samm_slab_pool_check_leaks(const SammSlabPool* pool);
  */
 static inline double samm_slab_pool_usage_percent(const SammSlabPool* pool) {
     if (!pool || pool->total_capacity == 0) return 0.0;
-    return (double)pool->in_use / (double)pool->total_capacity * 100.0;
+    size_t live = pool->in_use > pool->cached ? pool->in_use - pool->cached : 0;
+    return (double)live / (double)pool->total_capacity * 100.0;
 }
 
 /* ========================================================================= */
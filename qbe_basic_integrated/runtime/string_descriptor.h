@@ -42,51 +42,76 @@ typedef enum {
 // Memory layout:
 //   Offset 0:  void* data          - Pointer to character data (uint8_t* or uint32_t*)
 //   Offset 8:  int64_t length       - Length in characters (not bytes)
-//   Offset 16: int64_t capacity     - Allocated capacity in characters
-//   Offset 24: int32_t refcount     - Reference count for sharing
-//   Offset 28: uint8_t encoding     - STRING_ENCODING_ASCII or STRING_ENCODING_UTF32
-//   Offset 29: uint8_t dirty        - Needs UTF-8 re-encoding flag
-//   Offset 30: uint8_t _padding[2]  - Alignment padding
-//   Offset 32: char* utf8_cache     - Cached UTF-8 representation (NULL if dirty)
+//   Offset 16: int32_t refcount     - Reference count for sharing
+//   Offset 20: uint8_t encoding     - STRING_ENCODING_ASCII or STRING_ENCODING_UTF32
+//   Offset 21: uint8_t dirty        - Needs UTF-8 re-encoding flag
+//   Offset 22: uint8_t flags        - STRING_FLAG_* bits
+//   Offset 23: uint8_t _padding     - Alignment padding
+//   Offset 24: int64_t capacity     - Allocated capacity in characters  (heap)
+//   Offset 24: StringDescriptor* parent - Owner of the characters       (view)
+//   Offset 32: char* utf8_cache     - Cached UTF-8 representation       (heap, view)
+//   Offset 24: char sso_buf[16]     - Inline ASCII characters + NUL     (inline)
 //
-// Total size: 40 bytes (aligned)
+// Total size: 40 bytes (aligned) — one g_string_desc_pool slot.
 //
-typedef struct {
+// Small String Optimization (SSO): an ASCII string of up to SSO_THRESHOLD
+// characters is stored in sso_buf, overlaying capacity and utf8_cache, and
+// `data` points at sso_buf.  The buffer is always NUL-terminated, so it is
+// also the string's UTF-8 form and no cache is needed.  Inline strings are
+// recognised by string_is_inline(); their data must never be freed or
+// realloc'd, and capacity/utf8_cache must not be read.  UTF-32 strings
+// always live on the heap.
+//
+// Substring views: a descriptor with STRING_FLAG_VIEW shares its characters
+// with `parent` (data points into the parent's buffer) and holds one
+// reference on it.  Views are read-only and never NUL-terminated; they are
+// turned into ordinary strings by string_materialize(), which happens
+// automatically on string_retain() (the view escapes) and before any
+// in-place mutation.  The parent is never itself a view.
+//
+// Mapped files: OPEN FOR INPUT may map the whole file and wrap the mapping
+// in a STRING_FLAG_MAPPED descriptor (capacity = mapped size).  Lines read
+// from it are views of that descriptor, so the mapping stays alive until
+// the file is closed and the last view is released or materialized.
+//
+#define SSO_BUF_SIZE  16
+#define SSO_THRESHOLD (SSO_BUF_SIZE - 1)  // ASCII characters stored inline
+
+typedef struct StringDescriptor {
     void*     data;        // Character data (uint8_t* for ASCII, uint32_t* for UTF-32)
     int64_t   length;      // Length in characters
-    int64_t   capacity;    // Capacity in characters
     int32_t   refcount;    // Reference count
     uint8_t   encoding;    // STRING_ENCODING_ASCII or STRING_ENCODING_UTF32
     uint8_t   dirty;       // UTF-8 cache is invalid
-    uint8_t   _padding[2]; // Alignment
-    char*     utf8_cache;  // Cached UTF-8 string (for C interop)
-} StringDescriptor;
-
-// Small String Optimization (SSO) threshold
-// Strings shorter than this are stored inline to avoid heap allocation
-#define SSO_THRESHOLD 8  // code points (32 bytes of data)
-
-//
-// StringDescriptor with Small String Optimization
-//
-typedef struct {
+    uint8_t   flags;       // STRING_FLAG_* bits
+    uint8_t   _padding;    // Alignment
     union {
         struct {
-            uint32_t* data;
-            int64_t   length;
-            int64_t   capacity;
-            int32_t   refcount;
-            uint8_t   dirty;
-            uint8_t   _padding[3];
-            char*     utf8_cache;
-        } heap;
-        struct {
-            uint32_t  inline_data[8];  // 8 code points inline
-            uint8_t   length;          // Length in code points
-            uint8_t   is_sso;          // Always 1 for SSO
-        } sso;
+            union {
+                int64_t capacity;                 // Capacity in characters
+                struct StringDescriptor* parent;  // Buffer owner (views)
+            };
+            char*   utf8_cache;  // Cached UTF-8 string (for C interop)
+        };
+        char sso_buf[SSO_BUF_SIZE];  // Inline ASCII storage (SSO)
     };
-} StringDescriptorSSO;
+} StringDescriptor;
+
+// Descriptor flags
+#define STRING_FLAG_OWNED 0x01  // Untracked; the assignment target is its sole owner
+#define STRING_FLAG_VIEW  0x02  // Characters belong to `parent` (read-only)
+#define STRING_FLAG_MAPPED 0x04 // Characters are a read-only file mapping
+                                // (munmap'd on release); only ever a parent
+
+// True if the string's characters live in its own sso_buf
+static inline bool string_is_inline(const StringDescriptor* str) {
+    return str->data == (const void*)str->sso_buf;
+}
+
+// True if the string's characters are borrowed from a parent string
+static inline bool string_is_view(const StringDescriptor* str) {
+    return (str->flags & STRING_FLAG_VIEW) != 0;
+}
 
 //
 // Basic String Operations (Core API)
@@ -95,9 +120,17 @@ typedef struct {
 // Create new ASCII string (for pure 7-bit ASCII literals)
 StringDescriptor* string_new_ascii(const char* ascii_str);
 
+// Create new ASCII string from a buffer of `length` bytes (all < 0x80)
+StringDescriptor* string_new_ascii_len(const uint8_t* data, int64_t length);
+
 // Create new string from UTF-8 C string (auto-detects ASCII vs UTF-32)
 StringDescriptor* string_new_utf8(const char* utf8_str);
 
+// Same as string_new_utf8, but the descriptor is NOT tracked by SAMM.
+// Emitted by the compiler for literals that provably do not escape the
+// statement; the caller must string_release() it after the last use.
+StringDescriptor* string_new_utf8_temp(const char* utf8_str);
+
 // Create new string from UTF-32 data
 StringDescriptor* string_new_utf32(const uint32_t* data, int64_t length);
 
@@ -122,6 +155,13 @@ StringDescriptor* string_retain(StringDescriptor* str);
 // Release string (decrement refcount, free if 0)
 void string_release(StringDescriptor* str);
 
+// Prepare a string for a store into a slot that holds no reference of its
+// own (array element, UDT or CLASS field).  An untracked descriptor
+// (STRING_FLAG_OWNED or a view) is handed to the current SAMM scope, so it
+// outlives the variable's next reassignment and is never grown in place.
+// Returns `str`.
+StringDescriptor* string_share(StringDescriptor* str);
+
 // Get UTF-8 representation (cached, valid until string modified)
 const char* string_to_utf8(StringDescriptor* str);
 
@@ -164,6 +204,34 @@ static inline bool string_set_char(StringDescriptor* str, int64_t index, uint32_
 // Concatenate two strings (A$ + B$)
 StringDescriptor* string_concat(const StringDescriptor* a, const StringDescriptor* b);
 
+// Append for the self-append pattern S$ = S$ + X$.  `target` is the
+// variable's own reference and is consumed: if it is the only reference the
+// suffix is appended in place (capacity grows geometrically, so repeated
+// appends are amortised O(1)); otherwise a new, untracked descriptor owned
+// solely by the variable is returned.  Store the result without retaining.
+// Only descriptors created here (STRING_FLAG_OWNED) are ever grown in place:
+// anything else may still be tracked by a SAMM scope.
+StringDescriptor* string_append(StringDescriptor* target, const StringDescriptor* suffix);
+
+// Assignment of UTF-8 text (NUL-terminated at text[length] unless it is
+// plain ASCII) with the same
+// ownership contract as string_append: `target` is consumed and the result
+// is stored without retaining.  An exclusively owned ASCII target is
+// overwritten in its existing buffer, so LINE INPUT # in a loop stops
+// allocating once the buffer fits the longest line.
+StringDescriptor* string_assign_utf8(StringDescriptor* target, const char* text, int64_t length);
+
+// Same contract, assigning characters [start, start + length) of `owner`
+// (an ASCII buffer, e.g. a file mapping) as a view: nothing is copied
+// unless the string is short enough to be stored inline.  A target that is
+// already an unshared view is re-pointed instead of reallocated.
+StringDescriptor* string_assign_view(StringDescriptor* target, StringDescriptor* owner,
+                                     int64_t start, int64_t length);
+
+// Wrap a read-only mapping of `size` bytes (see STRING_FLAG_MAPPED).
+// Not tracked by SAMM; the caller holds the only reference.
+StringDescriptor* string_new_mapped(void* base, int64_t size);
+
 // Substring (MID$): extract from start for given length
 // 0-based indexing internally (converted from BASIC's 1-based)
 StringDescriptor* string_mid(const StringDescriptor* str, int64_t start, int64_t length);
@@ -174,6 +242,21 @@ StringDescriptor* string_left(const StringDescriptor* str, int64_t count);
 // Right substring (RIGHT$): last n characters
 StringDescriptor* string_right(const StringDescriptor* str, int64_t count);
 
+// Substring views of characters [start, start + length) (0-based, clamped).
+// The result is NOT tracked by SAMM and must be string_release()d by the
+// caller.  Results longer than SSO_THRESHOLD reference `str`'s buffer
+// instead of copying it; shorter ASCII results are copied inline.  Emitted
+// by the compiler for substrings that die within their statement.
+StringDescriptor* string_view(const StringDescriptor* str, int64_t start, int64_t length);
+StringDescriptor* string_mid_view(const StringDescriptor* str, int64_t start, int64_t length);
+StringDescriptor* string_left_view(const StringDescriptor* str, int64_t count);
+StringDescriptor* string_right_view(const StringDescriptor* str, int64_t count);
+StringDescriptor* string_slice_view(const StringDescriptor* str, int64_t start, int64_t end);
+
+// Give a view its own copy of the characters and drop the parent
+// reference.  No-op for ordinary strings.
+void string_materialize(StringDescriptor* str);
+
 // Find substring (INSTR): returns index of first occurrence (0-based, -1 if not found)
 int64_t string_instr(const StringDescriptor* haystack, const StringDescriptor* needle, int64_t start_pos);
 
@@ -329,7 +412,7 @@ void string_shrink_to_fit(StringDescriptor* str);
 static inline void string_mark_dirty(StringDescriptor* str) {
     if (str) {
         str->dirty = 1;
-        if (str->utf8_cache) {
+        if (!string_is_inline(str) && str->utf8_cache) {
             free(str->utf8_cache);
             str->utf8_cache = NULL;
         }
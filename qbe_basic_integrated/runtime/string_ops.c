@@ -372,4 +372,18 @@ StringDescriptor* basic_left(StringDescriptor* str, int32_t count) {
 // Call the UTF-32 aware version from string_utf32.c
 StringDescriptor* basic_right(StringDescriptor* str, int32_t count) {
     return string_right(str, count);
-}
\ No newline at end of file
+}
+
+// Statement-local forms of MID$/LEFT$/RIGHT$: untracked substring views
+// (see string_view).  The compiler releases the result after its last use.
+StringDescriptor* basic_mid_view(StringDescriptor* str, int32_t start, int32_t length) {
+    return string_mid_view(str, start - 1, length);
+}
+
+StringDescriptor* basic_left_view(StringDescriptor* str, int32_t count) {
+    return string_left_view(str, count);
+}
+
+StringDescriptor* basic_right_view(StringDescriptor* str, int32_t count) {
+    return string_right_view(str, count);
+}
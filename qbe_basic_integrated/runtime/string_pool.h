@@ -29,6 +29,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <sys/mman.h>
 #include "string_descriptor.h"
 #include "samm_pool.h"
 
@@ -69,14 +70,21 @@ static inline StringDescriptor* string_desc_alloc(void) {
 //
 static inline void string_desc_free(StringDescriptor* desc) {
     if (!desc) return;
-    // Safety: free any remaining buffers
-    if (desc->data) {
-        free(desc->data);
-        desc->data = NULL;
-    }
-    if (desc->utf8_cache) {
-        free(desc->utf8_cache);
-        desc->utf8_cache = NULL;
+    // Safety: free any remaining buffers (inline strings own none)
+    if (string_is_view(desc)) {
+        if (desc->utf8_cache) {
+            free(desc->utf8_cache);
+        }
+        string_release(desc->parent);
+    } else if (desc->flags & STRING_FLAG_MAPPED) {
+        munmap(desc->data, (size_t)desc->capacity);
+    } else if (!string_is_inline(desc)) {
+        if (desc->data) {
+            free(desc->data);
+        }
+        if (desc->utf8_cache) {
+            free(desc->utf8_cache);
+        }
     }
     samm_slab_pool_free(&g_string_desc_pool, desc);
 }
@@ -93,22 +101,37 @@ static inline void string_desc_init_empty(StringDescriptor* desc) {
     desc->refcount = 1;
     desc->encoding = STRING_ENCODING_ASCII;
     desc->dirty = 1;
-    desc->_padding[0] = 0;
-    desc->_padding[1] = 0;
+    desc->flags = 0;
+    desc->_padding = 0;
     desc->utf8_cache = NULL;
 }
 
 // Free a descriptor's data buffers (but not the descriptor itself)
 static inline void string_desc_free_data(StringDescriptor* desc) {
     if (desc) {
-        if (desc->data) {
-            free(desc->data);
-            desc->data = NULL;
-        }
-        if (desc->utf8_cache) {
-            free(desc->utf8_cache);
-            desc->utf8_cache = NULL;
+        if (string_is_view(desc)) {
+            // A view borrows its characters: drop the parent reference
+            StringDescriptor* parent = desc->parent;
+            if (desc->utf8_cache) {
+                free(desc->utf8_cache);
+            }
+            desc->flags &= (uint8_t)~STRING_FLAG_VIEW;
+            string_release(parent);
+        } else if (desc->flags & STRING_FLAG_MAPPED) {
+            // A file mapping owner: its characters are the mapped pages
+            munmap(desc->data, (size_t)desc->capacity);
+            desc->flags &= (uint8_t)~STRING_FLAG_MAPPED;
+        } else if (!string_is_inline(desc)) {
+            // Inline (SSO) strings keep their characters in the descriptor
+            if (desc->data) {
+                free(desc->data);
+            }
+            if (desc->utf8_cache) {
+                free(desc->utf8_cache);
+            }
         }
+        desc->data = NULL;
+        desc->utf8_cache = NULL;
         desc->length = 0;
         desc->capacity = 0;
         desc->dirty = 1;
@@ -124,8 +147,14 @@ static inline StringDescriptor* string_desc_clone(const StringDescriptor* src) {
     StringDescriptor* dest = string_desc_alloc();
     if (!dest) return NULL;
 
-    // Allocate new data buffer — size depends on encoding
-    if (src->length > 0 && src->data) {
+    // Short ASCII strings are copied inline (SSO); otherwise allocate a
+    // new data buffer — size depends on encoding
+    if (src->length > 0 && src->data && src->encoding == STRING_ENCODING_ASCII &&
+        src->length <= SSO_THRESHOLD) {
+        memcpy(dest->sso_buf, src->data, (size_t)src->length);
+        dest->sso_buf[src->length] = '\0';
+        dest->data = dest->sso_buf;
+    } else if (src->length > 0 && src->data) {
         size_t elem_size = (src->encoding == STRING_ENCODING_ASCII) ? sizeof(uint8_t) : sizeof(uint32_t);
         size_t bytes = src->length * elem_size;
         dest->data = malloc(bytes);
@@ -139,11 +168,14 @@ static inline StringDescriptor* string_desc_clone(const StringDescriptor* src) {
     }
 
     dest->length   = src->length;
-    dest->capacity = src->length;
     dest->refcount = 1;
     dest->encoding = src->encoding;
     dest->dirty    = 1;
-    dest->utf8_cache = NULL;
+    dest->flags    = 0;
+    if (!string_is_inline(dest)) {
+        dest->capacity   = src->length;
+        dest->utf8_cache = NULL;
+    }
 
     return dest;
 }
@@ -218,7 +250,7 @@ static inline void string_pool_stats(const StringDescriptorPool* pool,
     (void)pool;
     samm_slab_pool_stats(&g_string_desc_pool,
                          out_allocated, out_capacity, out_peak_usage,
-                         out_slabs, NULL, NULL);
+                         out_slabs, NULL, NULL, NULL, NULL);
 }
 
 static inline bool string_pool_validate(const StringDescriptorPool* pool) {
@@ -0,0 +1,753 @@
+/*
+ * string_simd.c
+ * FasterBASIC Runtime — Vectorised String Kernels
+ *
+ * SSE2/AVX2 (x86-64), NEON (AArch64) and scalar implementations of the
+ * string inner loops.  See string_simd.h for the API and design notes.
+ *
+ * Build:
+ *   cc -std=c99 -O2 -c string_simd.c -o string_simd.o
+ */
+
+#include "string_simd.h"
+#include <string.h>
+
+#if defined(__x86_64__)
+#define STRING_SIMD_HAVE_X86 1
+#include <immintrin.h>
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__aarch64__)
+#define STRING_SIMD_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* Inputs shorter than this skip the vector code entirely */
+#define SIMD_MIN_LENGTH 16
+
+/* ========================================================================= */
+/* Dispatch                                                                   */
+/* ========================================================================= */
+
+static int g_detected_level = -1;   /* StringSimdLevel, -1 = not detected  */
+static int g_active_level   = -1;   /* StringSimdLevel, -1 = use detected  */
+
+StringSimdLevel string_simd_detect(void) {
+    int level = __atomic_load_n(&g_detected_level, __ATOMIC_RELAXED);
+    if (level >= 0) return (StringSimdLevel)level;
+
+#if defined(STRING_SIMD_HAVE_X86)
+    __builtin_cpu_init();
+    level = __builtin_cpu_supports("avx2") ? STRING_SIMD_AVX2 : STRING_SIMD_SSE2;
+#elif defined(STRING_SIMD_HAVE_NEON)
+    level = STRING_SIMD_NEON;
+#else
+    level = STRING_SIMD_SCALAR;
+#endif
+
+    __atomic_store_n(&g_detected_level, level, __ATOMIC_RELAXED);
+    return (StringSimdLevel)level;
+}
+
+StringSimdLevel string_simd_level(void) {
+    int level = __atomic_load_n(&g_active_level, __ATOMIC_RELAXED);
+    if (level >= 0) return (StringSimdLevel)level;
+    level = string_simd_detect();
+    __atomic_store_n(&g_active_level, level, __ATOMIC_RELAXED);
+    return (StringSimdLevel)level;
+}
+
+StringSimdLevel string_simd_set_level(StringSimdLevel level) {
+    StringSimdLevel best = string_simd_detect();
+    bool supported = level == STRING_SIMD_SCALAR || level == best ||
+                     (level == STRING_SIMD_SSE2 && best == STRING_SIMD_AVX2);
+    if (!supported) level = best;
+    __atomic_store_n(&g_active_level, (int)level, __ATOMIC_RELAXED);
+    return level;
+}
+
+const char* string_simd_level_name(StringSimdLevel level) {
+    switch (level) {
+        case STRING_SIMD_SCALAR: return "scalar";
+        case STRING_SIMD_SSE2:   return "sse2";
+        case STRING_SIMD_AVX2:   return "avx2";
+        case STRING_SIMD_NEON:   return "neon";
+    }
+    return "unknown";
+}
+
+/* ========================================================================= */
+/* Scalar Kernels                                                             */
+/* ========================================================================= */
+
+static int64_t find_u8_scalar(const uint8_t* hay, int64_t n,
+                              const uint8_t* needle, int64_t m) {
+    if (m == 0) return 0;
+    if (m > n) return -1;
+    const uint8_t* p = hay;
+    const uint8_t* end = hay + (n - m) + 1;   /* one past the last candidate */
+    while (p < end) {
+        p = (const uint8_t*)memchr(p, needle[0], (size_t)(end - p));
+        if (!p) return -1;
+        if (memcmp(p + 1, needle + 1, (size_t)(m - 1)) == 0) return p - hay;
+        p++;
+    }
+    return -1;
+}
+
+static int64_t find_u32_scalar(const uint32_t* hay, int64_t n,
+                               const uint32_t* needle, int64_t m) {
+    if (m == 0) return 0;
+    if (m > n) return -1;
+    const uint32_t first = needle[0];
+    for (int64_t i = 0; i <= n - m; i++) {
+        if (hay[i] == first &&
+            memcmp(hay + i + 1, needle + 1, (size_t)(m - 1) * sizeof(uint32_t)) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Boyer-Moore-Horspool.  The shift table is indexed by the haystack
+ * character under the needle's last position. */
+static int64_t horspool_u8(const uint8_t* hay, int64_t n,
+                           const uint8_t* needle, int64_t m) {
+    int64_t shift[256];
+    for (int c = 0; c < 256; c++) shift[c] = m;
+    for (int64_t j = 0; j < m - 1; j++) shift[needle[j]] = m - 1 - j;
+
+    const uint8_t last = needle[m - 1];
+    for (int64_t i = 0; i <= n - m; ) {
+        uint8_t c = hay[i + m - 1];
+        if (c == last && memcmp(hay + i, needle, (size_t)(m - 1)) == 0) return i;
+        i += shift[c];
+    }
+    return -1;
+}
+
+/* Same for code points, hashing on the low byte.  Later needle positions
+ * overwrite earlier ones, so every bucket holds the smallest (safe) shift
+ * of the characters that share it. */
+static int64_t horspool_u32(const uint32_t* hay, int64_t n,
+                            const uint32_t* needle, int64_t m) {
+    int64_t shift[256];
+    for (int c = 0; c < 256; c++) shift[c] = m;
+    for (int64_t j = 0; j < m - 1; j++) shift[needle[j] & 0xFF] = m - 1 - j;
+
+    const uint32_t last = needle[m - 1];
+    for (int64_t i = 0; i <= n - m; ) {
+        uint32_t c = hay[i + m - 1];
+        if (c == last &&
+            memcmp(hay + i, needle, (size_t)(m - 1) * sizeof(uint32_t)) == 0) {
+            return i;
+        }
+        i += shift[c & 0xFF];
+    }
+    return -1;
+}
+
+static int64_t mismatch_u8_scalar(const uint8_t* a, const uint8_t* b, int64_t n) {
+    for (int64_t i = 0; i < n; i++) {
+        if (a[i] != b[i]) return i;
+    }
+    return n;
+}
+
+static int64_t mismatch_u32_scalar(const uint32_t* a, const uint32_t* b, int64_t n) {
+    for (int64_t i = 0; i < n; i++) {
+        if (a[i] != b[i]) return i;
+    }
+    return n;
+}
+
+static void widen_scalar(uint32_t* dst, const uint8_t* src, int64_t n) {
+    for (int64_t i = 0; i < n; i++) dst[i] = src[i];
+}
+
+static void case_u8_scalar(uint8_t* dst, const uint8_t* src, int64_t n, bool upper) {
+    const uint8_t lo = upper ? 'a' : 'A';
+    for (int64_t i = 0; i < n; i++) {
+        uint8_t c = src[i];
+        dst[i] = (uint8_t)(c - lo) < 26 ? (uint8_t)(c ^ 0x20) : c;
+    }
+}
+
+static void case_u32_scalar(uint32_t* dst, const uint32_t* src, int64_t n, bool upper) {
+    const uint32_t lo = upper ? 'a' : 'A';
+    for (int64_t i = 0; i < n; i++) {
+        uint32_t c = src[i];
+        dst[i] = (c - lo) < 26 ? (c ^ 0x20) : c;
+    }
+}
+
+/* Bytes >= 0x80 seen before the stop byte are ORed into *high */
+static int64_t scan_u8_scalar(const uint8_t* p, int64_t n, uint8_t a, uint8_t b,
+                              uint8_t* high) {
+    uint8_t acc = 0;
+    int64_t i = 0;
+    for (; i < n; i++) {
+        uint8_t c = p[i];
+        if (c == a || c == b) break;
+        acc |= c;
+    }
+    *high |= (uint8_t)(acc & 0x80);
+    return i;
+}
+
+/* ========================================================================= */
+/* x86-64: SSE2 and AVX2                                                      */
+/*                                                                            */
+/* Search filter: compare a block of candidate start positions against the   */
+/* needle's first character and the block shifted by m-1 against its last     */
+/* character; only positions where both match are verified with memcmp.       */
+/* Signed compares are fine for case mapping: bytes >= 0x80 compare below     */
+/* 'A' and can never be letters.                                              */
+/* ========================================================================= */
+
+#if defined(STRING_SIMD_HAVE_X86)
+
+static int64_t find_u8_sse2(const uint8_t* hay, int64_t n,
+                            const uint8_t* needle, int64_t m) {
+    const __m128i first = _mm_set1_epi8((char)needle[0]);
+    const __m128i last  = _mm_set1_epi8((char)needle[m - 1]);
+    int64_t i = 0;
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        __m128i bf = _mm_loadu_si128((const __m128i*)(hay + i));
+        __m128i bl = _mm_loadu_si128((const __m128i*)(hay + i + m - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(last, bl)));
+        while (mask) {
+            int bit = __builtin_ctz(mask);
+            if (m <= 2 || memcmp(hay + i + bit + 1, needle + 1, (size_t)(m - 2)) == 0) {
+                return i + bit;
+            }
+            mask &= mask - 1;
+        }
+    }
+    int64_t rest = find_u8_scalar(hay + i, n - i, needle, m);
+    return rest < 0 ? -1 : i + rest;
+}
+
+TARGET_AVX2
+static int64_t find_u8_avx2(const uint8_t* hay, int64_t n,
+                            const uint8_t* needle, int64_t m) {
+    const __m256i first = _mm256_set1_epi8((char)needle[0]);
+    const __m256i last  = _mm256_set1_epi8((char)needle[m - 1]);
+    int64_t i = 0;
+    for (; i + m - 1 + 32 <= n; i += 32) {
+        __m256i bf = _mm256_loadu_si256((const __m256i*)(hay + i));
+        __m256i bl = _mm256_loadu_si256((const __m256i*)(hay + i + m - 1));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(first, bf), _mm256_cmpeq_epi8(last, bl)));
+        while (mask) {
+            int bit = __builtin_ctz(mask);
+            if (m <= 2 || memcmp(hay + i + bit + 1, needle + 1, (size_t)(m - 2)) == 0) {
+                return i + bit;
+            }
+            mask &= mask - 1;
+        }
+    }
+    int64_t rest = find_u8_scalar(hay + i, n - i, needle, m);
+    return rest < 0 ? -1 : i + rest;
+}
+
+static int64_t find_u32_sse2(const uint32_t* hay, int64_t n,
+                             const uint32_t* needle, int64_t m) {
+    const __m128i first = _mm_set1_epi32((int)needle[0]);
+    const __m128i last  = _mm_set1_epi32((int)needle[m - 1]);
+    int64_t i = 0;
+    for (; i + m - 1 + 4 <= n; i += 4) {
+        __m128i bf = _mm_loadu_si128((const __m128i*)(hay + i));
+        __m128i bl = _mm_loadu_si128((const __m128i*)(hay + i + m - 1));
+        unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(
+            _mm_and_si128(_mm_cmpeq_epi32(first, bf), _mm_cmpeq_epi32(last, bl))));
+        while (mask) {
+            int lane = __builtin_ctz(mask);
+            if (m <= 2 || memcmp(hay + i + lane + 1, needle + 1,
+                                 (size_t)(m - 2) * sizeof(uint32_t)) == 0) {
+                return i + lane;
+            }
+            mask &= mask - 1;
+        }
+    }
+    int64_t rest = find_u32_scalar(hay + i, n - i, needle, m);
+    return rest < 0 ? -1 : i + rest;
+}
+
+TARGET_AVX2
+static int64_t find_u32_avx2(const uint32_t* hay, int64_t n,
+                             const uint32_t* needle, int64_t m) {
+    const __m256i first = _mm256_set1_epi32((int)needle[0]);
+    const __m256i last  = _mm256_set1_epi32((int)needle[m - 1]);
+    int64_t i = 0;
+    for (; i + m - 1 + 8 <= n; i += 8) {
+        __m256i bf = _mm256_loadu_si256((const __m256i*)(hay + i));
+        __m256i bl = _mm256_loadu_si256((const __m256i*)(hay + i + m - 1));
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(
+            _mm256_and_si256(_mm256_cmpeq_epi32(first, bf), _mm256_cmpeq_epi32(last, bl))));
+        while (mask) {
+            int lane = __builtin_ctz(mask);
+            if (m <= 2 || memcmp(hay + i + lane + 1, needle + 1,
+                                 (size_t)(m - 2) * sizeof(uint32_t)) == 0) {
+                return i + lane;
+            }
+            mask &= mask - 1;
+        }
+    }
+    int64_t rest = find_u32_scalar(hay + i, n - i, needle, m);
+    return rest < 0 ? -1 : i + rest;
+}
+
+static int64_t mismatch_u8_sse2(const uint8_t* a, const uint8_t* b, int64_t n) {
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + i)),
+                                    _mm_loadu_si128((const __m128i*)(b + i)));
+        unsigned diff = ~(unsigned)_mm_movemask_epi8(eq) & 0xFFFFu;
+        if (diff) return i + __builtin_ctz(diff);
+    }
+    return i + mismatch_u8_scalar(a + i, b + i, n - i);
+}
+
+TARGET_AVX2
+static int64_t mismatch_u8_avx2(const uint8_t* a, const uint8_t* b, int64_t n) {
+    int64_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                       _mm256_loadu_si256((const __m256i*)(b + i)));
+        unsigned diff = ~(unsigned)_mm256_movemask_epi8(eq);
+        if (diff) return i + __builtin_ctz(diff);
+    }
+    return i + mismatch_u8_scalar(a + i, b + i, n - i);
+}
+
+static int64_t mismatch_u32_sse2(const uint32_t* a, const uint32_t* b, int64_t n) {
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a + i)),
+                                     _mm_loadu_si128((const __m128i*)(b + i)));
+        unsigned diff = ~(unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq)) & 0xFu;
+        if (diff) return i + __builtin_ctz(diff);
+    }
+    return i + mismatch_u32_scalar(a + i, b + i, n - i);
+}
+
+TARGET_AVX2
+static int64_t mismatch_u32_avx2(const uint32_t* a, const uint32_t* b, int64_t n) {
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                        _mm256_loadu_si256((const __m256i*)(b + i)));
+        unsigned diff = ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq)) & 0xFFu;
+        if (diff) return i + __builtin_ctz(diff);
+    }
+    return i + mismatch_u32_scalar(a + i, b + i, n - i);
+}
+
+static void widen_sse2(uint32_t* dst, const uint8_t* src, int64_t n) {
+    const __m128i zero = _mm_setzero_si128();
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+        __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+        _mm_storeu_si128((__m128i*)(dst + i),      _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 4),  _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 8),  _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 12), _mm_unpackhi_epi16(hi, zero));
+    }
+    widen_scalar(dst + i, src + i, n - i);
+}
+
+TARGET_AVX2
+static void widen_avx2(uint32_t* dst, const uint8_t* src, int64_t n) {
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_cvtepu8_epi32(bytes));
+        _mm256_storeu_si256((__m256i*)(dst + i + 8),
+                            _mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8)));
+    }
+    widen_scalar(dst + i, src + i, n - i);
+}
+
+static void case_u8_sse2(uint8_t* dst, const uint8_t* src, int64_t n, bool upper) {
+    const __m128i lo   = _mm_set1_epi8(upper ? 'a' - 1 : 'A' - 1);
+    const __m128i hi   = _mm_set1_epi8(upper ? 'z' + 1 : 'Z' + 1);
+    const __m128i flip = _mm_set1_epi8(0x20);
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(v, lo), _mm_cmpgt_epi8(hi, v));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(v, _mm_and_si128(letter, flip)));
+    }
+    case_u8_scalar(dst + i, src + i, n - i, upper);
+}
+
+TARGET_AVX2
+static void case_u8_avx2(uint8_t* dst, const uint8_t* src, int64_t n, bool upper) {
+    const __m256i lo   = _mm256_set1_epi8(upper ? 'a' - 1 : 'A' - 1);
+    const __m256i hi   = _mm256_set1_epi8(upper ? 'z' + 1 : 'Z' + 1);
+    const __m256i flip = _mm256_set1_epi8(0x20);
+    int64_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(v, lo), _mm256_cmpgt_epi8(hi, v));
+        _mm256_storeu_si256((__m256i*)(dst + i),
+                            _mm256_xor_si256(v, _mm256_and_si256(letter, flip)));
+    }
+    case_u8_scalar(dst + i, src + i, n - i, upper);
+}
+
+static void case_u32_sse2(uint32_t* dst, const uint32_t* src, int64_t n, bool upper) {
+    const __m128i lo   = _mm_set1_epi32(upper ? 'a' - 1 : 'A' - 1);
+    const __m128i hi   = _mm_set1_epi32(upper ? 'z' + 1 : 'Z' + 1);
+    const __m128i flip = _mm_set1_epi32(0x20);
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi32(v, lo), _mm_cmpgt_epi32(hi, v));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(v, _mm_and_si128(letter, flip)));
+    }
+    case_u32_scalar(dst + i, src + i, n - i, upper);
+}
+
+TARGET_AVX2
+static void case_u32_avx2(uint32_t* dst, const uint32_t* src, int64_t n, bool upper) {
+    const __m256i lo   = _mm256_set1_epi32(upper ? 'a' - 1 : 'A' - 1);
+    const __m256i hi   = _mm256_set1_epi32(upper ? 'z' + 1 : 'Z' + 1);
+    const __m256i flip = _mm256_set1_epi32(0x20);
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi32(v, lo), _mm256_cmpgt_epi32(hi, v));
+        _mm256_storeu_si256((__m256i*)(dst + i),
+                            _mm256_xor_si256(v, _mm256_and_si256(letter, flip)));
+    }
+    case_u32_scalar(dst + i, src + i, n - i, upper);
+}
+
+static int64_t scan_u8_sse2(const uint8_t* p, int64_t n, uint8_t a, uint8_t b,
+                            uint8_t* high) {
+    const __m128i va = _mm_set1_epi8((char)a);
+    const __m128i vb = _mm_set1_epi8((char)b);
+    __m128i acc = _mm_setzero_si128();
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        unsigned hit = (unsigned)_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)));
+        if (hit) {
+            int k = __builtin_ctz(hit);
+            unsigned before = (unsigned)_mm_movemask_epi8(v) & ((1u << k) - 1);
+            if (before || _mm_movemask_epi8(acc)) *high |= 0x80;
+            return i + k;
+        }
+        acc = _mm_or_si128(acc, v);
+    }
+    if (_mm_movemask_epi8(acc)) *high |= 0x80;
+    return i + scan_u8_scalar(p + i, n - i, a, b, high);
+}
+
+TARGET_AVX2
+static int64_t scan_u8_avx2(const uint8_t* p, int64_t n, uint8_t a, uint8_t b,
+                            uint8_t* high) {
+    const __m256i va = _mm256_set1_epi8((char)a);
+    const __m256i vb = _mm256_set1_epi8((char)b);
+    __m256i acc = _mm256_setzero_si256();
+    int64_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+        unsigned hit = (unsigned)_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb)));
+        if (hit) {
+            int k = __builtin_ctz(hit);
+            unsigned before = (unsigned)_mm256_movemask_epi8(v) & (unsigned)((1ull << k) - 1);
+            if (before || _mm256_movemask_epi8(acc)) *high |= 0x80;
+            return i + k;
+        }
+        acc = _mm256_or_si256(acc, v);
+    }
+    if (_mm256_movemask_epi8(acc)) *high |= 0x80;
+    return i + scan_u8_scalar(p + i, n - i, a, b, high);
+}
+
+#endif /* STRING_SIMD_HAVE_X86 */
+
+/* ========================================================================= */
+/* AArch64: NEON                                                              */
+/*                                                                            */
+/* NEON has no movemask; a byte compare result is narrowed with SHRN #4 into  */
+/* a 64-bit value holding one nibble per byte (lane k -> bits 4k..4k+3), and  */
+/* a 32-bit compare with XTN into one 16-bit field per lane.                  */
+/* ========================================================================= */
+
+#if defined(STRING_SIMD_HAVE_NEON)
+
+static inline uint64_t neon_mask_u8(uint8x16_t eq) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+}
+
+static inline uint64_t neon_mask_u32(uint32x4_t eq) {
+    return vget_lane_u64(vreinterpret_u64_u16(vmovn_u32(eq)), 0);
+}
+
+static int64_t find_u8_neon(const uint8_t* hay, int64_t n,
+                            const uint8_t* needle, int64_t m) {
+    const uint8x16_t first = vdupq_n_u8(needle[0]);
+    const uint8x16_t last  = vdupq_n_u8(needle[m - 1]);
+    int64_t i = 0;
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        uint8x16_t eq = vandq_u8(vceqq_u8(first, vld1q_u8(hay + i)),
+                                 vceqq_u8(last, vld1q_u8(hay + i + m - 1)));
+        uint64_t mask = neon_mask_u8(eq);
+        while (mask) {
+            int bit = __builtin_ctzll(mask) >> 2;
+            if (m <= 2 || memcmp(hay + i + bit + 1, needle + 1, (size_t)(m - 2)) == 0) {
+                return i + bit;
+            }
+            mask &= ~(0xFULL << (bit * 4));
+        }
+    }
+    int64_t rest = find_u8_scalar(hay + i, n - i, needle, m);
+    return rest < 0 ? -1 : i + rest;
+}
+
+static int64_t find_u32_neon(const uint32_t* hay, int64_t n,
+                             const uint32_t* needle, int64_t m) {
+    const uint32x4_t first = vdupq_n_u32(needle[0]);
+    const uint32x4_t last  = vdupq_n_u32(needle[m - 1]);
+    int64_t i = 0;
+    for (; i + m - 1 + 4 <= n; i += 4) {
+        uint32x4_t eq = vandq_u32(vceqq_u32(first, vld1q_u32(hay + i)),
+                                  vceqq_u32(last, vld1q_u32(hay + i + m - 1)));
+        uint64_t mask = neon_mask_u32(eq);
+        while (mask) {
+            int lane = __builtin_ctzll(mask) >> 4;
+            if (m <= 2 || memcmp(hay + i + lane + 1, needle + 1,
+                                 (size_t)(m - 2) * sizeof(uint32_t)) == 0) {
+                return i + lane;
+            }
+            mask &= ~(0xFFFFULL << (lane * 16));
+        }
+    }
+    int64_t rest = find_u32_scalar(hay + i, n - i, needle, m);
+    return rest < 0 ? -1 : i + rest;
+}
+
+static int64_t mismatch_u8_neon(const uint8_t* a, const uint8_t* b, int64_t n) {
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t eq = vceqq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+        if (vminvq_u8(eq) != 0xFF) {
+            return i + (__builtin_ctzll(neon_mask_u8(vmvnq_u8(eq))) >> 2);
+        }
+    }
+    return i + mismatch_u8_scalar(a + i, b + i, n - i);
+}
+
+static int64_t mismatch_u32_neon(const uint32_t* a, const uint32_t* b, int64_t n) {
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint32x4_t eq = vceqq_u32(vld1q_u32(a + i), vld1q_u32(b + i));
+        if (vminvq_u32(eq) != 0xFFFFFFFFu) {
+            return i + (__builtin_ctzll(neon_mask_u32(vmvnq_u32(eq))) >> 4);
+        }
+    }
+    return i + mismatch_u32_scalar(a + i, b + i, n - i);
+}
+
+static void widen_neon(uint32_t* dst, const uint8_t* src, int64_t n) {
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t bytes = vld1q_u8(src + i);
+        uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+        uint16x8_t hi = vmovl_u8(vget_high_u8(bytes));
+        vst1q_u32(dst + i,      vmovl_u16(vget_low_u16(lo)));
+        vst1q_u32(dst + i + 4,  vmovl_u16(vget_high_u16(lo)));
+        vst1q_u32(dst + i + 8,  vmovl_u16(vget_low_u16(hi)));
+        vst1q_u32(dst + i + 12, vmovl_u16(vget_high_u16(hi)));
+    }
+    widen_scalar(dst + i, src + i, n - i);
+}
+
+static void case_u8_neon(uint8_t* dst, const uint8_t* src, int64_t n, bool upper) {
+    const uint8x16_t lo   = vdupq_n_u8(upper ? 'a' : 'A');
+    const uint8x16_t hi   = vdupq_n_u8(upper ? 'z' : 'Z');
+    const uint8x16_t flip = vdupq_n_u8(0x20);
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t v = vld1q_u8(src + i);
+        uint8x16_t letter = vandq_u8(vcgeq_u8(v, lo), vcleq_u8(v, hi));
+        vst1q_u8(dst + i, veorq_u8(v, vandq_u8(letter, flip)));
+    }
+    case_u8_scalar(dst + i, src + i, n - i, upper);
+}
+
+static void case_u32_neon(uint32_t* dst, const uint32_t* src, int64_t n, bool upper) {
+    const uint32x4_t lo   = vdupq_n_u32(upper ? 'a' : 'A');
+    const uint32x4_t hi   = vdupq_n_u32(upper ? 'z' : 'Z');
+    const uint32x4_t flip = vdupq_n_u32(0x20);
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint32x4_t v = vld1q_u32(src + i);
+        uint32x4_t letter = vandq_u32(vcgeq_u32(v, lo), vcleq_u32(v, hi));
+        vst1q_u32(dst + i, veorq_u32(v, vandq_u32(letter, flip)));
+    }
+    case_u32_scalar(dst + i, src + i, n - i, upper);
+}
+
+static int64_t scan_u8_neon(const uint8_t* p, int64_t n, uint8_t a, uint8_t b,
+                            uint8_t* high) {
+    const uint8x16_t va = vdupq_n_u8(a);
+    const uint8x16_t vb = vdupq_n_u8(b);
+    uint8x16_t acc = vdupq_n_u8(0);
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t v = vld1q_u8(p + i);
+        uint64_t hit = neon_mask_u8(vorrq_u8(vceqq_u8(v, va), vceqq_u8(v, vb)));
+        if (hit) {
+            int k = __builtin_ctzll(hit) >> 2;
+            uint64_t before = neon_mask_u8(vcgeq_u8(v, vdupq_n_u8(0x80))) &
+                              ((1ULL << (k * 4)) - 1);
+            if (before || vmaxvq_u8(acc) >= 0x80) *high |= 0x80;
+            return i + k;
+        }
+        acc = vorrq_u8(acc, v);
+    }
+    if (vmaxvq_u8(acc) >= 0x80) *high |= 0x80;
+    return i + scan_u8_scalar(p + i, n - i, a, b, high);
+}
+
+#endif /* STRING_SIMD_HAVE_NEON */
+
+/* ========================================================================= */
+/* Public Entry Points                                                        */
+/* ========================================================================= */
+
+int64_t simd_find_u8(const uint8_t* hay, int64_t n, const uint8_t* needle, int64_t m) {
+    if (m == 0) return 0;
+    if (m > n) return -1;
+    if (n >= SIMD_MIN_LENGTH) {
+        switch (string_simd_level()) {
+#if defined(STRING_SIMD_HAVE_X86)
+            case STRING_SIMD_AVX2: return find_u8_avx2(hay, n, needle, m);
+            case STRING_SIMD_SSE2: return find_u8_sse2(hay, n, needle, m);
+#elif defined(STRING_SIMD_HAVE_NEON)
+            case STRING_SIMD_NEON: return find_u8_neon(hay, n, needle, m);
+#endif
+            default: break;
+        }
+    }
+    if (m >= STRING_SIMD_HORSPOOL_MIN) return horspool_u8(hay, n, needle, m);
+    return find_u8_scalar(hay, n, needle, m);
+}
+
+int64_t simd_find_u32(const uint32_t* hay, int64_t n, const uint32_t* needle, int64_t m) {
+    if (m == 0) return 0;
+    if (m > n) return -1;
+    if (n >= SIMD_MIN_LENGTH) {
+        switch (string_simd_level()) {
+#if defined(STRING_SIMD_HAVE_X86)
+            case STRING_SIMD_AVX2: return find_u32_avx2(hay, n, needle, m);
+            case STRING_SIMD_SSE2: return find_u32_sse2(hay, n, needle, m);
+#elif defined(STRING_SIMD_HAVE_NEON)
+            case STRING_SIMD_NEON: return find_u32_neon(hay, n, needle, m);
+#endif
+            default: break;
+        }
+    }
+    if (m >= STRING_SIMD_HORSPOOL_MIN) return horspool_u32(hay, n, needle, m);
+    return find_u32_scalar(hay, n, needle, m);
+}
+
+int64_t simd_mismatch_u8(const uint8_t* a, const uint8_t* b, int64_t n) {
+    if (n >= SIMD_MIN_LENGTH) {
+        switch (string_simd_level()) {
+#if defined(STRING_SIMD_HAVE_X86)
+            case STRING_SIMD_AVX2: return mismatch_u8_avx2(a, b, n);
+            case STRING_SIMD_SSE2: return mismatch_u8_sse2(a, b, n);
+#elif defined(STRING_SIMD_HAVE_NEON)
+            case STRING_SIMD_NEON: return mismatch_u8_neon(a, b, n);
+#endif
+            default: break;
+        }
+    }
+    return mismatch_u8_scalar(a, b, n);
+}
+
+int64_t simd_mismatch_u32(const uint32_t* a, const uint32_t* b, int64_t n) {
+    if (n >= SIMD_MIN_LENGTH) {
+        switch (string_simd_level()) {
+#if defined(STRING_SIMD_HAVE_X86)
+            case STRING_SIMD_AVX2: return mismatch_u32_avx2(a, b, n);
+            case STRING_SIMD_SSE2: return mismatch_u32_sse2(a, b, n);
+#elif defined(STRING_SIMD_HAVE_NEON)
+            case STRING_SIMD_NEON: return mismatch_u32_neon(a, b, n);
+#endif
+            default: break;
+        }
+    }
+    return mismatch_u32_scalar(a, b, n);
+}
+
+void simd_widen_u8_u32(uint32_t* dst, const uint8_t* src, int64_t n) {
+    if (n >= SIMD_MIN_LENGTH) {
+        switch (string_simd_level()) {
+#if defined(STRING_SIMD_HAVE_X86)
+            case STRING_SIMD_AVX2: widen_avx2(dst, src, n); return;
+            case STRING_SIMD_SSE2: widen_sse2(dst, src, n); return;
+#elif defined(STRING_SIMD_HAVE_NEON)
+            case STRING_SIMD_NEON: widen_neon(dst, src, n); return;
+#endif
+            default: break;
+        }
+    }
+    widen_scalar(dst, src, n);
+}
+
+void simd_case_u8(uint8_t* dst, const uint8_t* src, int64_t n, bool upper) {
+    if (n >= SIMD_MIN_LENGTH) {
+        switch (string_simd_level()) {
+#if defined(STRING_SIMD_HAVE_X86)
+            case STRING_SIMD_AVX2: case_u8_avx2(dst, src, n, upper); return;
+            case STRING_SIMD_SSE2: case_u8_sse2(dst, src, n, upper); return;
+#elif defined(STRING_SIMD_HAVE_NEON)
+            case STRING_SIMD_NEON: case_u8_neon(dst, src, n, upper); return;
+#endif
+            default: break;
+        }
+    }
+    case_u8_scalar(dst, src, n, upper);
+}
+
+void simd_case_u32(uint32_t* dst, const uint32_t* src, int64_t n, bool upper) {
+    if (n >= SIMD_MIN_LENGTH) {
+        switch (string_simd_level()) {
+#if defined(STRING_SIMD_HAVE_X86)
+            case STRING_SIMD_AVX2: case_u32_avx2(dst, src, n, upper); return;
+            case STRING_SIMD_SSE2: case_u32_sse2(dst, src, n, upper); return;
+#elif defined(STRING_SIMD_HAVE_NEON)
+            case STRING_SIMD_NEON: case_u32_neon(dst, src, n, upper); return;
+#endif
+            default: break;
+        }
+    }
+    case_u32_scalar(dst, src, n, upper);
+}
+
+int64_t simd_scan_u8(const uint8_t* p, int64_t n, uint8_t a, uint8_t b, bool* non_ascii) {
+    uint8_t high = 0;
+    int64_t i;
+    switch (n >= SIMD_MIN_LENGTH ? string_simd_level() : STRING_SIMD_SCALAR) {
+#if defined(STRING_SIMD_HAVE_X86)
+        case STRING_SIMD_AVX2: i = scan_u8_avx2(p, n, a, b, &high); break;
+        case STRING_SIMD_SSE2: i = scan_u8_sse2(p, n, a, b, &high); break;
+#elif defined(STRING_SIMD_HAVE_NEON)
+        case STRING_SIMD_NEON: i = scan_u8_neon(p, n, a, b, &high); break;
+#endif
+        default: i = scan_u8_scalar(p, n, a, b, &high); break;
+    }
+    *non_ascii = high != 0;
+    return i;
+}
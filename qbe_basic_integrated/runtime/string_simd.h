@@ -0,0 +1,96 @@
+/*
+ * string_simd.h
+ * FasterBASIC Runtime — Vectorised String Kernels
+ *
+ * Inner loops of the string runtime (string_utf32.c) over raw character
+ * buffers.  The string kernels come in an 8-bit (ASCII encoding) and a
+ * 32-bit (UTF-32 encoding) flavour; scan works on raw file bytes:
+ *
+ *   find      INSTR            first occurrence of a needle
+ *   mismatch  string_compare   first index where two buffers differ
+ *   widen     concat/promote   ASCII bytes → UTF-32 code points
+ *   case      UCASE$/LCASE$    ASCII letter case mapping
+ *   scan      LINE INPUT #     next delimiter byte in a mapped file
+ *
+ * Implementations:
+ *   x86-64   SSE2 (always available) and AVX2, chosen at runtime with
+ *            __builtin_cpu_supports(); the AVX2 code is compiled with a
+ *            target attribute so the runtime still builds with plain -O2.
+ *   AArch64  NEON (always available).
+ *   other    portable scalar code.
+ *
+ * Needle search uses the "first and last character" vector filter: a
+ * whole block of candidate positions is rejected with two compares, and
+ * only survivors are verified with memcmp.  Without vector support, needles
+ * of STRING_SIMD_HORSPOOL_MIN characters or more are searched with
+ * Boyer-Moore-Horspool, which skips ahead instead of trying every position.
+ * (With vectors the filter is faster even for long needles on text.)
+ *
+ * string_simd_set_level() exists for benchmarks and tests: it pins the
+ * dispatch to a lower level (e.g. scalar) so the kernels can be compared.
+ */
+
+#ifndef STRING_SIMD_H
+#define STRING_SIMD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Needles at least this long use Boyer-Moore-Horspool on the scalar path */
+#ifndef STRING_SIMD_HORSPOOL_MIN
+#define STRING_SIMD_HORSPOOL_MIN  32
+#endif
+
+typedef enum {
+    STRING_SIMD_SCALAR = 0,
+    STRING_SIMD_SSE2   = 1,
+    STRING_SIMD_AVX2   = 2,
+    STRING_SIMD_NEON   = 3
+} StringSimdLevel;
+
+/* Best level supported by this CPU (detected once) */
+StringSimdLevel string_simd_detect(void);
+
+/* Level currently used by the kernels */
+StringSimdLevel string_simd_level(void);
+
+/* Pin the kernels to `level` (clamped to what the CPU supports).
+ * Returns the level actually selected. */
+StringSimdLevel string_simd_set_level(StringSimdLevel level);
+
+/* Human-readable name of a level ("scalar", "sse2", "avx2", "neon") */
+const char* string_simd_level_name(StringSimdLevel level);
+
+/* Index of the first occurrence of needle[0..m) in hay[0..n), or -1.
+ * An empty needle matches at 0. */
+int64_t simd_find_u8(const uint8_t* hay, int64_t n, const uint8_t* needle, int64_t m);
+int64_t simd_find_u32(const uint32_t* hay, int64_t n, const uint32_t* needle, int64_t m);
+
+/* Index of the first element where a[] and b[] differ, or n if equal */
+int64_t simd_mismatch_u8(const uint8_t* a, const uint8_t* b, int64_t n);
+int64_t simd_mismatch_u32(const uint32_t* a, const uint32_t* b, int64_t n);
+
+/* dst[i] = src[i] for i < n (zero-extend bytes to code points) */
+void simd_widen_u8_u32(uint32_t* dst, const uint8_t* src, int64_t n);
+
+/* Index of the first byte equal to a or b in p[0..n), or n if none (pass
+ * a == b to stop at a single byte).  *non_ascii is set if any byte before
+ * that index is >= 0x80.  Used to split mapped files into lines and fields
+ * and to decide, in the same pass, whether a line can be used as ASCII. */
+int64_t simd_scan_u8(const uint8_t* p, int64_t n, uint8_t a, uint8_t b, bool* non_ascii);
+
+/* dst[i] = src[i] with 'a'..'z' mapped to upper case (upper = true) or
+ * 'A'..'Z' mapped to lower case; all other values are copied unchanged.
+ * dst may equal src. */
+void simd_case_u8(uint8_t* dst, const uint8_t* src, int64_t n, bool upper);
+void simd_case_u32(uint32_t* dst, const uint32_t* src, int64_t n, bool upper);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRING_SIMD_H */
@@ -32,6 +32,13 @@ TIMEOUT_TESTS=0
 declare -a FAILED_TEST_NAMES
 declare -a TIMEOUT_TEST_NAMES
 
+# Tests that release everything they allocate, so SAMM must report no leaks
+# (most tests end with live string variables, which SAMM counts as leaked)
+LEAK_CHECKED_TESTS=(
+    "test_hashmap_overwrite"
+    "test_string_slot_ownership"
+)
+
 echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
 echo "  FasterBASIC Test Runner"
 echo "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"
@@ -79,6 +86,16 @@ run_test() {
         return 1
     fi
 
+    # Check leak-checked tests for SAMM's shutdown warning
+    if [[ " ${LEAK_CHECKED_TESTS[*]} " == *" $test_name "* ]] &&
+       grep -q "leaked slots at shutdown" "$TEMP_DIR/${test_name}.out"; then
+        echo -e "${RED}FAIL${NC} (leaked slots at shutdown)"
+        FAILED_TESTS=$((FAILED_TESTS + 1))
+        FAILED_TEST_NAMES+=("$test_name (leak)")
+        echo "    $(grep "leaked slots at shutdown" "$TEMP_DIR/${test_name}.out" | head -1)"
+        return 1
+    fi
+
     # Success
     echo -e "${GREEN}PASS${NC}"
     PASSED_TESTS=$((PASSED_TESTS + 1))
@@ -0,0 +1,82 @@
+' Test: array accesses in loops whose descriptor loads are hoisted
+' Tests: 1-D and 2-D loops, a loop that never runs over an erased
+'        array, REDIM between loops, GLOBAL scalars written in a loop
+
+' === Test 1: 1-D loop ===
+PRINT "=== Test 1: 1-D loop ==="
+DIM a(199) AS INTEGER
+DIM i AS INTEGER
+DIM j AS INTEGER
+DIM n AS INTEGER
+DIM s AS LONG
+FOR i = 0 TO 199
+    a(i) = i + 1
+NEXT i
+s = 0
+FOR i = 0 TO 199
+    s = s + a(i)
+NEXT i
+IF s <> 20100 THEN PRINT "ERROR: 1-D sum: "; s : END
+PRINT "sum = "; s
+
+' === Test 2: nested 2-D loop ===
+PRINT ""
+PRINT "=== Test 2: 2-D loop ==="
+DIM m(7, 11) AS LONG
+FOR i = 0 TO 7
+    FOR j = 0 TO 11
+        m(i, j) = i * 12 + j
+    NEXT j
+NEXT i
+s = 0
+FOR i = 0 TO 7
+    FOR j = 0 TO 11
+        s = s + m(i, j)
+    NEXT j
+NEXT i
+IF s <> 4560 THEN PRINT "ERROR: 2-D sum: "; s : END
+PRINT "sum = "; s
+
+' === Test 3: loop that never runs over an erased array ===
+PRINT ""
+PRINT "=== Test 3: erased array ==="
+DIM e(9) AS INTEGER
+ERASE e
+n = 0
+s = 0
+FOR i = 1 TO n
+    s = s + e(i)
+NEXT i
+IF s <> 0 THEN PRINT "ERROR: erased array loop" : END
+PRINT "no iterations"
+
+' === Test 4: REDIM between loops ===
+PRINT ""
+PRINT "=== Test 4: REDIM ==="
+n = 10
+REDIM a(n)
+FOR i = 0 TO n
+    a(i) = i * i
+NEXT i
+s = 0
+FOR i = 0 TO n
+    s = s + a(i)
+NEXT i
+IF s <> 385 THEN PRINT "ERROR: REDIM sum: "; s : END
+PRINT "sum = "; s
+
+' === Test 5: GLOBAL scalars read and written in a loop ===
+PRINT ""
+PRINT "=== Test 5: GLOBAL scalars ==="
+GLOBAL g%
+GLOBAL limit%
+g% = 0
+limit% = 50
+FOR i = 1 TO 100
+    IF g% < limit% THEN g% = g% + 1
+NEXT i
+IF g% <> 50 THEN PRINT "ERROR: GLOBAL loop: "; g% : END
+PRINT "g% = "; g%
+
+PRINT ""
+PRINT "PASS: loop-invariant array access"
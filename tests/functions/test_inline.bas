@@ -0,0 +1,120 @@
+' Test: small SUBs, FUNCTIONs and DEF FNs inlined into their callers
+' Tests: accessor FUNCTION in a loop, DEF FN, a chain of small
+'        functions, EXIT FUNCTION, recursion (never inlined), a SUB
+'        with SHARED and a local, a string FUNCTION, DOUBLE arguments
+
+GLOBAL counter%
+
+DEF FN Twice(x%) = x% * 2
+
+FUNCTION Sq(x AS INTEGER) AS INTEGER
+    Sq = x * x
+END FUNCTION
+
+FUNCTION SumSq(a AS INTEGER, b AS INTEGER) AS INTEGER
+    SumSq = Sq(a) + Sq(b)
+END FUNCTION
+
+FUNCTION Restrict(v AS INTEGER, lo AS INTEGER, hi AS INTEGER) AS INTEGER
+    IF v < lo THEN
+        Restrict = lo
+        EXIT FUNCTION
+    END IF
+    IF v > hi THEN
+        Restrict = hi
+        EXIT FUNCTION
+    END IF
+    Restrict = v
+END FUNCTION
+
+FUNCTION Factorial(n AS INTEGER) AS LONG
+    IF n <= 1 THEN
+        Factorial = 1
+    ELSE
+        Factorial = n * Factorial(n - 1)
+    END IF
+END FUNCTION
+
+FUNCTION Half(d AS DOUBLE) AS DOUBLE
+    Half = d / 2
+END FUNCTION
+
+FUNCTION Greet(name AS STRING) AS STRING
+    Greet = "Hello, " + name
+END FUNCTION
+
+SUB Tick(n AS INTEGER)
+    SHARED counter%
+    DIM k AS INTEGER
+    k = n + 1
+    counter% = counter% + k
+END SUB
+
+DIM i AS INTEGER
+DIM s AS LONG
+DIM d AS DOUBLE
+
+' === Test 1: accessor FUNCTION in a loop ===
+PRINT "=== Test 1: FUNCTION in a loop ==="
+s = 0
+FOR i = 1 TO 100
+    s = s + Sq(i)
+NEXT i
+IF s <> 338350 THEN PRINT "ERROR: Sq loop "; s : END
+PRINT "sum of squares = "; s
+
+' === Test 2: DEF FN ===
+PRINT ""
+PRINT "=== Test 2: DEF FN ==="
+s = 0
+FOR i = 1 TO 10
+    s = s + FN Twice(i)
+NEXT i
+IF s <> 110 THEN PRINT "ERROR: DEF FN "; s : END
+PRINT "twice sum = "; s
+
+' === Test 3: chain of small functions ===
+PRINT ""
+PRINT "=== Test 3: chain ==="
+IF SumSq(3, 4) <> 25 THEN PRINT "ERROR: SumSq "; SumSq(3, 4) : END
+PRINT "SumSq(3, 4) = "; SumSq(3, 4)
+
+' === Test 4: EXIT FUNCTION ===
+PRINT ""
+PRINT "=== Test 4: EXIT FUNCTION ==="
+s = 0
+FOR i = -5 TO 15
+    s = s + Restrict(i, 0, 10)
+NEXT i
+IF s <> 105 THEN PRINT "ERROR: Restrict "; s : END
+PRINT "clamped sum = "; s
+
+' === Test 5: recursion ===
+PRINT ""
+PRINT "=== Test 5: recursion ==="
+IF Factorial(10) <> 3628800 THEN PRINT "ERROR: Factorial "; Factorial(10) : END
+PRINT "Factorial(10) = "; Factorial(10)
+
+' === Test 6: SUB with SHARED ===
+PRINT ""
+PRINT "=== Test 6: SUB with SHARED ==="
+counter% = 0
+FOR i = 1 TO 4
+    CALL Tick(i)
+NEXT i
+IF counter% <> 14 THEN PRINT "ERROR: Tick "; counter% : END
+PRINT "counter% = "; counter%
+
+' === Test 7: DOUBLE and STRING functions ===
+PRINT ""
+PRINT "=== Test 7: DOUBLE and STRING ==="
+d = Half(5)
+IF d <> 2.5 THEN PRINT "ERROR: Half "; d : END
+PRINT "Half(5) = "; d
+FOR i = 1 TO 3
+    IF Greet("BASIC") <> "Hello, BASIC" THEN PRINT "ERROR: Greet" : END
+NEXT i
+PRINT Greet("BASIC")
+
+PRINT ""
+PRINT "PASS: function inlining"
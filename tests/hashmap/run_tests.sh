@@ -29,6 +29,13 @@ WORKING_TESTS=(
     "test_hashmap_two_maps_multiple_inserts.bas"
     "test_hashmap_comprehensive_verified.bas"
     "test_contacts_list_arrays.bas"
+    "test_hashmap_overwrite.bas"
+)
+
+# Tests that empty their maps before exit, so SAMM must report no leaks
+# (other tests end with live map entries, which SAMM counts as leaked)
+LEAK_CHECKED_TESTS=(
+    "test_hashmap_overwrite.bas"
 )
 
 # Counters
@@ -68,8 +75,14 @@ for test in "${WORKING_TESTS[@]}"; do
 
     # Run the test with timeout
     if timeout 10s ./"$TEST_NAME" > /tmp/run_$$.log 2>&1; then
-        # Check if output contains PASS or ERROR
-        if grep -q "PASS" /tmp/run_$$.log && ! grep -q "ERROR" /tmp/run_$$.log; then
+        # Check if output contains PASS or ERROR, and for leak-checked
+        # tests that SAMM reported no leaked slots
+        LEAKED=0
+        if [[ " ${LEAK_CHECKED_TESTS[*]} " == *" $test "* ]] &&
+           grep -q "leaked slots at shutdown" /tmp/run_$$.log; then
+            LEAKED=1
+        fi
+        if grep -q "PASS" /tmp/run_$$.log && ! grep -q "ERROR" /tmp/run_$$.log && [ $LEAKED -eq 0 ]; then
             echo -e "${GREEN}PASS${NC}"
             PASSED=$((PASSED + 1))
         else
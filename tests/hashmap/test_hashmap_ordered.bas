@@ -0,0 +1,78 @@
+REM Test: FOR EACH over a HASHMAP, ORDERED() insertion-order iteration
+REM Tests: key and value together, removing keys inside the loop,
+REM        reassigning loop variables, ordered iteration after removes
+
+DIM dict AS HASHMAP
+DIM i AS INTEGER
+DIM n AS INTEGER
+DIM count AS INTEGER
+DIM expect AS INTEGER
+DIM s$
+
+REM --- Unordered: every key once, with its own value ---
+n = 1000
+FOR i = 1 TO n
+    dict("k" + STR$(i)) = "v" + STR$(i)
+NEXT i
+count = 0
+FOR k, v IN dict
+    IF "v" + RIGHT$(k, LEN(k) - 1) <> v THEN PRINT "ERROR: "; k; " => "; v : END
+    count = count + 1
+NEXT
+IF count <> n THEN PRINT "ERROR: visited "; count; " of "; n : END
+
+REM --- Remove every key while iterating; the key variable stays valid ---
+count = 0
+FOR EACH k IN dict
+    IF dict.REMOVE(k) <> 1 THEN PRINT "ERROR: REMOVE "; k : END
+    IF LEFT$(k, 1) <> "k" THEN PRINT "ERROR: key lost after REMOVE" : END
+    count = count + 1
+NEXT
+IF count <> n OR dict.SIZE() <> 0 THEN PRINT "ERROR: remove in loop "; count : END
+PRINT "Unordered: "; n; " keys visited and removed"
+
+REM --- Ordered: iteration follows insertion order ---
+DIM ord AS HASHMAP
+ord.ORDERED(1)
+FOR i = 1 TO n
+    ord("k" + STR$(n - i)) = STR$(i)
+NEXT i
+FOR i = 0 TO n - 1 STEP 3
+    IF ord.REMOVE("k" + STR$(i)) <> 1 THEN PRINT "ERROR: ordered REMOVE" : END
+NEXT i
+REM re-inserted keys go to the end
+ord("k" + STR$(0)) = "last"
+
+expect = n - 1
+count = 0
+FOR k, v IN ord
+    IF k = "k" + STR$(0) THEN
+        IF v <> "last" OR count <> ord.SIZE() - 1 THEN PRINT "ERROR: re-inserted key" : END
+    ELSE
+        WHILE expect MOD 3 = 0
+            expect = expect - 1
+        WEND
+        IF k <> "k" + STR$(expect) THEN PRINT "ERROR: order "; k; " expected "; expect : END
+        IF VAL(v) <> n - expect THEN PRINT "ERROR: ordered value of "; k : END
+        expect = expect - 1
+    ENDIF
+    count = count + 1
+    k = "reassigned"
+    v = ""
+NEXT
+IF count <> ord.SIZE() THEN PRINT "ERROR: ordered count "; count : END
+IF ord("k" + STR$(1)) <> STR$(n - 1) THEN PRINT "ERROR: value changed by loop" : END
+
+s$ = ord.STATS()
+IF RIGHT$(s$, 23) <> "ordered=1 incremental=1" THEN PRINT "ERROR: STATS() "; s$ : END
+
+REM --- Switching back keeps the contents ---
+ord.ORDERED(0)
+count = 0
+FOR EACH k IN ord
+    count = count + 1
+NEXT
+IF count <> ord.SIZE() THEN PRINT "ERROR: unordered again "; count : END
+PRINT "Ordered: "; count; " keys in insertion order"
+
+PRINT "PASS: hashmap ordered iteration"
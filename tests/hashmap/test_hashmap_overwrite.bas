@@ -0,0 +1,42 @@
+REM Test: Hashmap value ownership
+REM Tests: overwriting, removing and clearing string values releases them.
+REM        The runner fails a test whose SAMM shutdown reports leaked
+REM        slots, so every value replaced below must be released.
+
+DIM dict AS HASHMAP
+DIM i AS INTEGER
+
+REM Overwrite the same key with a fresh string each time.  No string
+REM variables here: a variable's last value is still held at shutdown.
+FOR i = 1 TO 200000
+    dict("k") = "value" + STR$(i)
+NEXT i
+
+IF dict.SIZE() <> 1 THEN
+    PRINT "ERROR: SIZE should be 1, got "; dict.SIZE()
+    END
+ENDIF
+IF dict("k") <> "value" + STR$(200000) THEN
+    PRINT "ERROR: last value not kept: "; dict("k")
+    END
+ENDIF
+
+REM Values of removed keys are released too
+FOR i = 1 TO 1000
+    dict("r" + STR$(i)) = "gone" + STR$(i)
+NEXT i
+FOR i = 1 TO 1000
+    IF dict.REMOVE("r" + STR$(i)) <> 1 THEN
+        PRINT "ERROR: REMOVE of r"; i
+        END
+    ENDIF
+NEXT i
+
+REM CLEAR releases the remaining keys and values
+dict.CLEAR()
+IF dict.SIZE() <> 0 THEN
+    PRINT "ERROR: SIZE after CLEAR should be 0"
+    END
+ENDIF
+
+PRINT "PASS: hashmap overwrite"
@@ -0,0 +1,86 @@
+REM Test: Hashmap incremental resize and STATS()
+REM Tests: lookups, updates and removes while a large map is resizing,
+REM        STATS(), MAXPAUSE(), INCREMENTAL()
+
+DIM dict AS HASHMAP
+DIM i AS INTEGER
+DIM n AS INTEGER
+DIM j AS INTEGER
+DIM found AS INTEGER
+DIM s$
+
+n = 100000
+
+REM Insert enough keys for several resizes, checking older keys as we go
+FOR i = 1 TO n
+    dict("key" + STR$(i)) = "value" + STR$(i)
+    IF i MOD 1000 = 0 THEN
+        j = i / 2
+        IF dict("key" + STR$(j)) <> "value" + STR$(j) THEN
+            PRINT "ERROR: lookup of key"; j; " during insert "; i
+            END
+        ENDIF
+    ENDIF
+NEXT i
+
+IF dict.SIZE() <> n THEN
+    PRINT "ERROR: SIZE should be "; n; ", got "; dict.SIZE()
+    END
+ENDIF
+
+REM Update and remove some keys, then check every key
+FOR i = 1 TO n STEP 10
+    dict("key" + STR$(i)) = "changed"
+NEXT i
+FOR i = 5 TO n STEP 10
+    IF dict.REMOVE("key" + STR$(i)) <> 1 THEN
+        PRINT "ERROR: REMOVE of key"; i
+        END
+    ENDIF
+NEXT i
+
+found = 0
+FOR i = 1 TO n
+    s$ = "key" + STR$(i)
+    IF dict.HASKEY(s$) THEN
+        found = found + 1
+        IF i MOD 10 = 1 THEN
+            IF dict(s$) <> "changed" THEN PRINT "ERROR: update of "; s$ : END
+        ELSE
+            IF dict(s$) <> "value" + STR$(i) THEN PRINT "ERROR: value of "; s$ : END
+        ENDIF
+    ENDIF
+NEXT i
+IF found <> n - n / 10 THEN
+    PRINT "ERROR: found "; found; " keys"
+    END
+ENDIF
+PRINT "Keys after resize: "; found
+
+REM Statistics
+s$ = dict.STATS()
+IF LEFT$(s$, 11) <> "size=90000 " THEN
+    PRINT "ERROR: STATS() "; s$
+    END
+ENDIF
+IF dict.MAXPAUSE() <= 0 THEN
+    PRINT "ERROR: MAXPAUSE() should be positive"
+    END
+ENDIF
+
+REM One-go resizing still works
+DIM other AS HASHMAP
+other.INCREMENTAL(0)
+FOR i = 1 TO 50000
+    other("k" + STR$(i)) = "v"
+NEXT i
+IF other.SIZE() <> 50000 OR other("k" + STR$(49999)) <> "v" THEN
+    PRINT "ERROR: one-go resize"
+    END
+ENDIF
+IF RIGHT$(other.STATS(), 13) <> "incremental=0" THEN
+    PRINT "ERROR: INCREMENTAL(0) not reported"
+    END
+ENDIF
+
+PRINT "PASS: hashmap resize"
@@ -0,0 +1,121 @@
+' test_file_buffered_io.bas
+' OPEN/PRINT #/WRITE #/LINE INPUT #/INPUT #/EOF/CLOSE round trip through a
+' temporary file.  Writes are buffered by the runtime, so everything must be
+' on disk after CLOSE; lines longer than 4096 characters come back whole.
+' A whole UDT printed to a file reads back as the same text PRINT shows.
+
+TYPE Inner
+    Tag AS STRING
+    W AS SINGLE
+END TYPE
+
+TYPE Rec
+    Id AS INTEGER
+    Big AS LONG
+    Ratio AS DOUBLE
+    Part AS Inner
+END TYPE
+
+DIM i AS INTEGER
+DIM n AS INTEGER
+DIM total AS INTEGER
+DIM x AS DOUBLE
+DIM line$, name$, big$
+
+PRINT "=== Buffered File I/O Test ==="
+PRINT ""
+
+' =============================================================================
+' Test 1: PRINT # many lines, read back with LINE INPUT #
+' =============================================================================
+PRINT "Test 1: PRINT # / LINE INPUT #"
+OPEN "/tmp/fb_test_file_io.txt" FOR OUTPUT AS #1
+FOR i = 1 TO 1000
+    PRINT #1, "line "; i
+NEXT i
+CLOSE #1
+
+OPEN "/tmp/fb_test_file_io.txt" FOR INPUT AS #1
+n = 0
+total = 0
+WHILE EOF(1) = 0
+    LINE INPUT #1, line$
+    n = n + 1
+    total = total + VAL(RIGHT$(line$, LEN(line$) - 5))
+WEND
+CLOSE #1
+IF n <> 1000 THEN PRINT "ERROR: read "; n; " lines" : END
+IF total <> 500500 THEN PRINT "ERROR: line total "; total : END
+PRINT "  PASS"
+
+' =============================================================================
+' Test 2: long line and APPEND
+' =============================================================================
+PRINT "Test 2: Long line"
+big$ = ""
+FOR i = 1 TO 1000
+    big$ = big$ + "0123456789"
+NEXT i
+big$ = big$ + "end"
+OPEN "/tmp/fb_test_file_io.txt" FOR OUTPUT AS #2
+PRINT #2, big$
+CLOSE #2
+OPEN "/tmp/fb_test_file_io.txt" FOR APPEND AS #2
+PRINT #2, "tail"
+CLOSE #2
+
+OPEN "/tmp/fb_test_file_io.txt" FOR INPUT AS #2
+LINE INPUT #2, line$
+IF LEN(line$) <> 10003 THEN PRINT "ERROR: long line length "; LEN(line$) : END
+IF RIGHT$(line$, 3) <> "end" THEN PRINT "ERROR: long line tail" : END
+LINE INPUT #2, line$
+IF line$ <> "tail" THEN PRINT "ERROR: appended line '"; line$; "'" : END
+IF EOF(2) = 0 THEN PRINT "ERROR: EOF not reached" : END
+CLOSE #2
+PRINT "  PASS"
+
+' =============================================================================
+' Test 3: WRITE # fields read back with INPUT #
+' =============================================================================
+PRINT "Test 3: WRITE # / INPUT #"
+OPEN "/tmp/fb_test_file_io.txt" FOR OUTPUT AS #3
+FOR i = 1 TO 3
+    WRITE #3, "item, " + STR$(i), i * 10, i / 4
+NEXT i
+CLOSE
+
+OPEN "/tmp/fb_test_file_io.txt" FOR INPUT AS #3
+total = 0
+x = 0
+FOR i = 1 TO 3
+    INPUT #3, name$, n, x
+    total = total + n
+NEXT i
+CLOSE #3
+IF LEFT$(name$, 6) <> "item, " THEN PRINT "ERROR: quoted field '"; name$; "'" : END
+IF total <> 60 THEN PRINT "ERROR: integer fields "; total : END
+IF x <> 0.75 THEN PRINT "ERROR: double field "; x : END
+PRINT "  PASS"
+
+' =============================================================================
+' Test 4: PRINT # of a whole UDT, single-letter mode aliases
+' =============================================================================
+PRINT "Test 4: PRINT # UDT"
+DIM r AS Rec
+r.Id = 7
+r.Big = 1234567890123
+r.Ratio = 2.5
+r.Part.Tag = "x, y"
+r.Part.W = 0.5
+OPEN "/tmp/fb_test_file_io.txt" FOR O AS #4
+PRINT #4, "rec: "; r
+CLOSE #4
+OPEN "/tmp/fb_test_file_io.txt" FOR I AS #4
+LINE INPUT #4, line$
+CLOSE #4
+IF line$ <> "rec: Rec(7, 1234567890123, 2.5, Inner(" + CHR$(34) + "x, y" + CHR$(34) + ", 0.5))" THEN PRINT "ERROR: UDT line '"; line$; "'" : END
+PRINT r
+PRINT "  PASS"
+
+PRINT ""
+PRINT "=== All buffered file I/O tests passed ==="
@@ -0,0 +1,89 @@
+' test_file_mapped_input.bas
+' OPEN FOR INPUT maps files of 64 KB or more.  Lines are views of the
+' mapping: check them against what was written, including CRLF endings, a
+' last line without a newline, non-ASCII text, INPUT # fields, and strings
+' that are kept after the file is closed.
+
+DIM i AS INTEGER
+DIM n AS INTEGER
+DIM total AS INTEGER
+DIM line$, kept$, first$, name$, lastline$
+DIM count AS INTEGER
+
+PRINT "=== Mapped File Input Test ==="
+PRINT ""
+
+' =============================================================================
+' Test 1: many lines
+' =============================================================================
+PRINT "Test 1: LINE INPUT # from a mapped file"
+OPEN "/tmp/fb_test_mapped.txt" FOR OUTPUT AS #1
+FOR i = 1 TO 20000
+    PRINT #1, "line number "; i; " of the mapped input file"
+NEXT i
+PRINT #1, "caf"; CHR$(233); " "; CHR$(9786)
+PRINT #1, "windows line"; CHR$(13)
+PRINT #1, "no newline at the end";
+CLOSE #1
+
+OPEN "/tmp/fb_test_mapped.txt" FOR INPUT AS #1
+n = 0
+total = 0
+WHILE EOF(1) = 0
+    LINE INPUT #1, line$
+    n = n + 1
+    IF n = 1 THEN first$ = line$
+    IF n = 777 THEN kept$ = line$
+    IF n <= 20000 THEN total = total + VAL(MID$(line$, 13, 5))
+    IF n = 20001 THEN
+        IF LEN(line$) <> 6 THEN PRINT "ERROR: non-ASCII length "; LEN(line$) : END
+        IF ASC(MID$(line$, 4, 1)) <> 233 THEN PRINT "ERROR: non-ASCII text" : END
+        IF ASC(RIGHT$(line$, 1)) <> 9786 THEN PRINT "ERROR: non-ASCII symbol" : END
+    END IF
+    IF n = 20002 AND line$ <> "windows line" THEN PRINT "ERROR: CRLF '"; line$; "'" : END
+WEND
+CLOSE #1
+lastline$ = line$
+
+IF n <> 20003 THEN PRINT "ERROR: read "; n; " lines" : END
+IF total <> 200010000 THEN PRINT "ERROR: line total "; total : END
+IF lastline$ <> "no newline at the end" THEN PRINT "ERROR: last line '"; lastline$; "'" : END
+PRINT "  PASS"
+
+' =============================================================================
+' Test 2: strings kept after CLOSE
+' =============================================================================
+PRINT "Test 2: Kept lines"
+IF first$ <> "line number 1 of the mapped input file" THEN PRINT "ERROR: first$ '"; first$; "'" : END
+IF kept$ <> "line number 777 of the mapped input file" THEN PRINT "ERROR: kept$ '"; kept$; "'" : END
+kept$ = kept$ + "!"
+IF RIGHT$(kept$, 5) <> "file!" THEN PRINT "ERROR: append to kept line" : END
+IF UCASE$(LEFT$(first$, 4)) <> "LINE" THEN PRINT "ERROR: UCASE$ of kept line" : END
+PRINT "  PASS"
+
+' =============================================================================
+' Test 3: INPUT # fields
+' =============================================================================
+PRINT "Test 3: INPUT # from a mapped file"
+OPEN "/tmp/fb_test_mapped.txt" FOR OUTPUT AS #2
+FOR i = 1 TO 5000
+    WRITE #2, "name, " + STR$(i), i, i * 3
+NEXT i
+CLOSE #2
+
+OPEN "/tmp/fb_test_mapped.txt" FOR INPUT AS #2
+total = 0
+count = 0
+FOR i = 1 TO 5000
+    INPUT #2, name$, n, total
+    IF LEFT$(name$, 6) = "name, " THEN count = count + 1
+NEXT i
+IF EOF(2) = 0 THEN PRINT "ERROR: EOF after fields" : END
+CLOSE #2
+IF count <> 5000 THEN PRINT "ERROR: quoted fields "; count : END
+IF n <> 5000 THEN PRINT "ERROR: last integer field "; n : END
+IF total <> 15000 THEN PRINT "ERROR: last product field "; total : END
+PRINT "  PASS"
+
+PRINT ""
+PRINT "=== All mapped file input tests passed ==="
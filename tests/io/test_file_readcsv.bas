@@ -0,0 +1,116 @@
+' test_file_readcsv.bas
+' READCSV(n, a(), b$(), ...) fills whole arrays from a delimited file, one
+' line per row.  Check typed and UDT arrays, quoted and missing fields,
+' extra fields, number formats, chunked reads and the stdio (small file)
+' and mapped (large file) paths.
+
+TYPE Trade
+    id AS INTEGER
+    price AS DOUBLE
+    sym AS STRING
+    qty AS LONG
+END TYPE
+
+DIM i AS INTEGER
+DIM n AS INTEGER
+DIM total AS INTEGER
+DIM rows AS INTEGER
+DIM sum AS DOUBLE
+DIM ids%(9)
+DIM prices#(9)
+DIM names$(9)
+DIM big%(999)
+DIM bigx#(999)
+DIM bigs$(999)
+DIM trades(4) AS Trade
+DIM header$
+
+PRINT "=== READCSV Test ==="
+PRINT ""
+
+' =============================================================================
+' Test 1: typed arrays from a small file
+' =============================================================================
+PRINT "Test 1: Typed columns"
+OPEN "/tmp/fb_test_readcsv.txt" FOR OUTPUT AS #1
+PRINT #1, "id,price,name"
+PRINT #1, "1,2.5,apple"
+PRINT #1, "2, -0.125 , "; CHR$(34); "pear, green"; CHR$(34)
+PRINT #1, "3,1e3,plum,extra,fields"
+PRINT #1, "4"
+PRINT #1, "5,12345678901234567890,fig"
+CLOSE #1
+
+OPEN "/tmp/fb_test_readcsv.txt" FOR INPUT AS #1
+LINE INPUT #1, header$
+rows = READCSV(1, ids%(), prices#(), names$())
+CLOSE #1
+IF header$ <> "id,price,name" THEN PRINT "ERROR: header '"; header$; "'" : END
+IF rows <> 5 THEN PRINT "ERROR: rows "; rows : END
+IF ids%(0) <> 1 OR ids%(4) <> 5 THEN PRINT "ERROR: ids "; ids%(0); ids%(4) : END
+IF prices#(0) <> 2.5 THEN PRINT "ERROR: price 0 "; prices#(0) : END
+IF prices#(1) <> -0.125 THEN PRINT "ERROR: price 1 "; prices#(1) : END
+IF prices#(2) <> 1000 THEN PRINT "ERROR: price 2 "; prices#(2) : END
+IF prices#(3) <> 0 THEN PRINT "ERROR: missing price "; prices#(3) : END
+IF prices#(4) <> VAL("12345678901234567890") THEN PRINT "ERROR: long mantissa "; prices#(4) : END
+IF names$(0) <> "apple" THEN PRINT "ERROR: name 0 '"; names$(0); "'" : END
+IF names$(1) <> "pear, green" THEN PRINT "ERROR: quoted name '"; names$(1); "'" : END
+IF names$(2) <> "plum" THEN PRINT "ERROR: extra fields '"; names$(2); "'" : END
+IF names$(3) <> "" THEN PRINT "ERROR: missing name '"; names$(3); "'" : END
+IF names$(4) <> "fig" THEN PRINT "ERROR: name 4 '"; names$(4); "'" : END
+PRINT "  PASS"
+
+' =============================================================================
+' Test 2: UDT array
+' =============================================================================
+PRINT "Test 2: UDT columns"
+OPEN "/tmp/fb_test_readcsv.txt" FOR OUTPUT AS #2
+FOR i = 1 TO 5
+    PRINT #2, i; ","; i * 1.5; ",SYM"; i; ","; i * 100000000
+NEXT i
+CLOSE #2
+
+OPEN "/tmp/fb_test_readcsv.txt" FOR INPUT AS #2
+rows = READCSV(2, trades())
+CLOSE #2
+IF rows <> 5 THEN PRINT "ERROR: UDT rows "; rows : END
+IF trades(0).id <> 1 OR trades(4).id <> 5 THEN PRINT "ERROR: UDT id" : END
+IF trades(2).price <> 4.5 THEN PRINT "ERROR: UDT price "; trades(2).price : END
+IF trades(3).sym <> "SYM4" THEN PRINT "ERROR: UDT sym '"; trades(3).sym; "'" : END
+IF trades(4).qty <> 500000000 THEN PRINT "ERROR: UDT qty "; trades(4).qty : END
+PRINT "  PASS"
+
+' =============================================================================
+' Test 3: chunked reads from a mapped file
+' =============================================================================
+PRINT "Test 3: Chunks"
+OPEN "/tmp/fb_test_readcsv.txt" FOR OUTPUT AS #3
+FOR i = 1 TO 20500
+    PRINT #3, i; ","; i; ".25,row number "; i
+NEXT i
+CLOSE #3
+
+OPEN "/tmp/fb_test_readcsv.txt" FOR INPUT AS #3
+n = 0
+total = 0
+sum = 0
+rows = READCSV(3, big%(), bigx#(), bigs$())
+WHILE rows > 0
+    FOR i = 0 TO rows - 1
+        IF big%(i) <> n + i + 1 THEN PRINT "ERROR: row "; n + i; " id "; big%(i) : END
+        sum = sum + bigx#(i) - big%(i)
+    NEXT i
+    IF bigs$(rows - 1) <> "row number " + STR$(n + rows) THEN PRINT "ERROR: text '"; bigs$(rows - 1); "'" : END
+    n = n + rows
+    total = total + 1
+    rows = READCSV(3, big%(), bigx#(), bigs$())
+WEND
+IF EOF(3) = 0 THEN PRINT "ERROR: EOF after chunks" : END
+CLOSE #3
+IF n <> 20500 THEN PRINT "ERROR: chunk rows "; n : END
+IF total <> 21 THEN PRINT "ERROR: chunks "; total : END
+IF sum <> 5125 THEN PRINT "ERROR: fractions "; sum : END
+PRINT "  PASS"
+
+PRINT ""
+PRINT "=== All READCSV tests passed ==="
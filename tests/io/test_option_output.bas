@@ -0,0 +1,18 @@
+' test_option_output.bas
+' OPTION OUTPUT UNBUFFERED restores a flush after every PRINT item.  The
+' output must be complete and in order whatever the buffering mode.
+
+OPTION OUTPUT UNBUFFERED
+
+DIM i AS INTEGER
+DIM total AS INTEGER
+
+PRINT "=== OPTION OUTPUT Test ==="
+total = 0
+FOR i = 1 TO 5
+    PRINT "item "; i;
+    PRINT " done"
+    total = total + i
+NEXT i
+IF total <> 15 THEN PRINT "ERROR: loop total "; total : END
+PRINT "=== OPTION OUTPUT test passed ==="
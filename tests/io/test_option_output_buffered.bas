@@ -0,0 +1,77 @@
+' test_option_output_buffered.bas
+' OPTION OUTPUT BUFFERED keeps PRINT output in a 64 KB stdout buffer.  More
+' than a buffer's worth is printed here, so the buffer fills and drains
+' several times, interleaved with buffered file I/O that also writes past
+' its buffer, reads the file back, and reopens it to append and re-read.
+' The console output must be complete and in order: the last line below
+' only appears if every flush happened.
+
+OPTION OUTPUT BUFFERED
+
+DIM i AS INTEGER
+DIM n AS INTEGER
+DIM total AS LONG
+DIM line$, pad$
+
+PRINT "=== OPTION OUTPUT BUFFERED Test ==="
+
+pad$ = ""
+FOR i = 1 TO 10
+    pad$ = pad$ + "0123456789"
+NEXT i
+
+' =============================================================================
+' Test 1: fill the stdout buffer several times over (2000 x ~110 bytes)
+' =============================================================================
+FOR i = 1 TO 2000
+    PRINT "console "; i; " "; pad$
+NEXT i
+PRINT "Test 1: 2000 console lines"
+
+' =============================================================================
+' Test 2: write a file past its buffer, then read it back
+' =============================================================================
+OPEN "/tmp/fb_test_output_buffered.txt" FOR OUTPUT AS #1
+FOR i = 1 TO 5000
+    PRINT #1, i; " "; pad$
+    IF i MOD 1000 = 0 THEN PRINT "  written "; i
+NEXT i
+CLOSE #1
+
+OPEN "/tmp/fb_test_output_buffered.txt" FOR INPUT AS #1
+n = 0
+total = 0
+WHILE EOF(1) = 0
+    LINE INPUT #1, line$
+    n = n + 1
+    total = total + VAL(line$)
+    IF RIGHT$(line$, 10) <> "0123456789" THEN PRINT "ERROR: line "; n; " truncated" : END
+WEND
+CLOSE #1
+IF n <> 5000 THEN PRINT "ERROR: read "; n; " lines" : END
+IF total <> 12502500 THEN PRINT "ERROR: line total "; total : END
+PRINT "Test 2: PASS"
+
+' =============================================================================
+' Test 3: reopen to append past the buffer again, then re-read everything
+' =============================================================================
+OPEN "/tmp/fb_test_output_buffered.txt" FOR APPEND AS #1
+FOR i = 5001 TO 6000
+    PRINT #1, i; " "; pad$
+NEXT i
+CLOSE #1
+
+OPEN "/tmp/fb_test_output_buffered.txt" FOR INPUT AS #1
+n = 0
+total = 0
+WHILE EOF(1) = 0
+    LINE INPUT #1, line$
+    n = n + 1
+    total = total + VAL(line$)
+WEND
+CLOSE #1
+IF n <> 6000 THEN PRINT "ERROR: read "; n; " lines after append" : END
+IF total <> 18003000 THEN PRINT "ERROR: line total after append "; total : END
+PRINT "Test 3: PASS"
+
+PRINT "=== OPTION OUTPUT BUFFERED test passed ==="
@@ -0,0 +1,80 @@
+' test_instr.bas
+' INSTR([start,] haystack$, needle$): 1-based position, start offset,
+' empty needle, not found, and a match past the first vector block.
+
+PRINT "=== INSTR Test ==="
+PRINT ""
+
+DIM h$, n$, long$
+DIM i AS INTEGER
+DIM p AS INTEGER
+
+h$ = "hello world, hello basic"
+
+' =============================================================================
+' Test 1: Two-argument form
+' =============================================================================
+PRINT "Test 1: Two arguments"
+IF INSTR(h$, "hello") <> 1 THEN PRINT "ERROR: match at start "; INSTR(h$, "hello") : END
+IF INSTR(h$, "world") <> 7 THEN PRINT "ERROR: match inside "; INSTR(h$, "world") : END
+IF INSTR(h$, "basic") <> 20 THEN PRINT "ERROR: match at end "; INSTR(h$, "basic") : END
+IF INSTR(h$, "c") <> 24 THEN PRINT "ERROR: last char "; INSTR(h$, "c") : END
+PRINT "INSTR(h$, world) = "; INSTR(h$, "world")
+
+' =============================================================================
+' Test 2: Start offset
+' =============================================================================
+PRINT "Test 2: Start offset"
+IF INSTR(1, h$, "hello") <> 1 THEN PRINT "ERROR: start 1 "; INSTR(1, h$, "hello") : END
+IF INSTR(2, h$, "hello") <> 14 THEN PRINT "ERROR: start 2 "; INSTR(2, h$, "hello") : END
+IF INSTR(14, h$, "hello") <> 14 THEN PRINT "ERROR: start on match "; INSTR(14, h$, "hello") : END
+IF INSTR(15, h$, "hello") <> 0 THEN PRINT "ERROR: start past match "; INSTR(15, h$, "hello") : END
+p = 0
+i = 0
+DO
+    p = INSTR(p + 1, h$, "o")
+    IF p > 0 THEN i = i + 1
+LOOP WHILE p > 0
+IF i <> 3 THEN PRINT "ERROR: count of o "; i : END
+PRINT "INSTR(2, h$, hello) = "; INSTR(2, h$, "hello")
+PRINT "occurrences of o = "; i
+
+' =============================================================================
+' Test 3: Empty needle
+' =============================================================================
+PRINT "Test 3: Empty needle"
+n$ = ""
+IF INSTR(h$, n$) <> 1 THEN PRINT "ERROR: empty needle "; INSTR(h$, n$) : END
+IF INSTR(5, h$, "") <> 5 THEN PRINT "ERROR: empty needle at 5 "; INSTR(5, h$, "") : END
+IF INSTR(24, h$, "") <> 24 THEN PRINT "ERROR: empty needle at end "; INSTR(24, h$, "") : END
+IF INSTR(25, h$, "") <> 0 THEN PRINT "ERROR: empty needle past end "; INSTR(25, h$, "") : END
+IF INSTR("", "") <> 0 THEN PRINT "ERROR: empty in empty "; INSTR("", "") : END
+PRINT "INSTR(5, h$, empty) = "; INSTR(5, h$, "")
+
+' =============================================================================
+' Test 4: Not found
+' =============================================================================
+PRINT "Test 4: Not found"
+IF INSTR(h$, "xyz") <> 0 THEN PRINT "ERROR: absent needle "; INSTR(h$, "xyz") : END
+IF INSTR(h$, "Hello") <> 0 THEN PRINT "ERROR: case differs "; INSTR(h$, "Hello") : END
+IF INSTR("abc", "abcd") <> 0 THEN PRINT "ERROR: needle longer "; INSTR("abc", "abcd") : END
+IF INSTR("", "a") <> 0 THEN PRINT "ERROR: empty haystack "; INSTR("", "a") : END
+IF INSTR(100, h$, "hello") <> 0 THEN PRINT "ERROR: start past end "; INSTR(100, h$, "hello") : END
+PRINT "INSTR(h$, xyz) = "; INSTR(h$, "xyz")
+
+' =============================================================================
+' Test 5: Long haystack
+' =============================================================================
+PRINT "Test 5: Long haystack"
+long$ = ""
+FOR i = 1 TO 20
+    long$ = long$ + "abcdefgh"
+NEXT i
+long$ = long$ + "needle" + long$
+IF INSTR(long$, "needle") <> 161 THEN PRINT "ERROR: long match "; INSTR(long$, "needle") : END
+IF INSTR(162, long$, "needle") <> 0 THEN PRINT "ERROR: long past match" : END
+IF INSTR(160, long$, "habc") <> 174 THEN PRINT "ERROR: match after needle "; INSTR(160, long$, "habc") : END
+PRINT "INSTR(long$, needle) = "; INSTR(long$, "needle")
+
+PRINT ""
+PRINT "PASS: INSTR"
@@ -0,0 +1,67 @@
+' test_string_self_append.bas
+' S$ = S$ + X$ is compiled to an in-place append. Check that the result is
+' right and that copies held elsewhere never see the appended text.
+
+PRINT "=== String Self-Append Test ==="
+PRINT ""
+
+DIM names$(3)
+DIM a$, b$, c$
+DIM i AS INTEGER
+
+' =============================================================================
+' Test 1: Long append loop
+' =============================================================================
+PRINT "Test 1: Append 100000 characters"
+a$ = ""
+FOR i = 1 TO 100000
+    a$ = a$ + "x"
+NEXT i
+IF LEN(a$) <> 100000 THEN PRINT "ERROR: expected 100000 characters, got "; LEN(a$) : END
+PRINT "  PASS: LEN = "; LEN(a$)
+
+' =============================================================================
+' Test 2: Copies are not changed by a later append
+' =============================================================================
+PRINT "Test 2: Copies stay independent"
+a$ = ""
+FOR i = 1 TO 10
+    a$ = a$ + "ab"
+NEXT i
+names$(1) = a$
+b$ = a$
+a$ = a$ + "c"
+c$ = names$(1)
+IF c$ <> "abababababababababab" THEN PRINT "ERROR: array element changed: "; c$ : END
+IF b$ <> "abababababababababab" THEN PRINT "ERROR: copy changed: "; b$ : END
+IF a$ <> "ababababababababababc" THEN PRINT "ERROR: append result: "; a$ : END
+PRINT "  PASS: "; a$
+
+' =============================================================================
+' Test 3: Appending the string to itself
+' =============================================================================
+PRINT "Test 3: S$ = S$ + S$"
+a$ = "xy"
+a$ = a$ + "z"
+a$ = a$ + a$
+IF a$ <> "xyzxyz" THEN PRINT "ERROR: self append: "; a$ : END
+a$ = a$ + "!" + a$
+IF a$ <> "xyzxyz!xyzxyz" THEN PRINT "ERROR: chained self append: "; a$ : END
+PRINT "  PASS: "; a$
+
+' =============================================================================
+' Test 4: Chained and mixed-width appends
+' =============================================================================
+PRINT "Test 4: Chained and Unicode appends"
+a$ = "hi"
+a$ = a$ + "-" + "there" + b$
+IF LEN(a$) <> 28 THEN PRINT "ERROR: chained append length: "; LEN(a$) : END
+a$ = "hi"
+a$ = a$ + CHR$(9786)
+a$ = a$ + "!"
+IF LEN(a$) <> 4 THEN PRINT "ERROR: Unicode append length: "; LEN(a$) : END
+IF RIGHT$(a$, 1) <> "!" THEN PRINT "ERROR: Unicode append tail" : END
+PRINT "  PASS: "; a$
+
+PRINT ""
+PRINT "=== All self-append tests passed ==="
@@ -0,0 +1,67 @@
+' test_string_simd_kernels.bas
+' String comparison, UCASE$/LCASE$ and ASCII + Unicode concatenation run
+' vector kernels on long strings.  Check results around block boundaries.
+
+PRINT "=== String Kernel Test ==="
+PRINT ""
+
+DIM a$, b$, u$, w$
+DIM i AS INTEGER
+DIM n AS INTEGER
+
+a$ = ""
+FOR i = 1 TO 10
+    a$ = a$ + "Hello, World! [abc]{xyz}@`"
+NEXT i
+
+' =============================================================================
+' Test 1: Comparison of long strings
+' =============================================================================
+PRINT "Test 1: Compare"
+b$ = a$
+IF a$ <> b$ THEN PRINT "ERROR: equal strings differ" : END
+b$ = a$ + "!"
+IF a$ >= b$ THEN PRINT "ERROR: prefix not smaller" : END
+b$ = LEFT$(a$, 199) + "A" + RIGHT$(a$, 60)
+IF LEN(b$) <> LEN(a$) THEN PRINT "ERROR: rebuilt length "; LEN(b$) : END
+IF a$ = b$ THEN PRINT "ERROR: late difference missed" : END
+IF MID$(a$, 200, 1) < "A" THEN
+    IF a$ >= b$ THEN PRINT "ERROR: ordering" : END
+ELSE
+    IF a$ <= b$ THEN PRINT "ERROR: ordering" : END
+END IF
+PRINT "  PASS"
+
+' =============================================================================
+' Test 2: UCASE$ / LCASE$
+' =============================================================================
+PRINT "Test 2: Case mapping"
+u$ = UCASE$(a$)
+IF LEN(u$) <> 260 THEN PRINT "ERROR: UCASE$ length" : END
+IF LEFT$(u$, 26) <> "HELLO, WORLD! [ABC]{XYZ}@`" THEN PRINT "ERROR: UCASE$ "; LEFT$(u$, 26) : END
+IF RIGHT$(u$, 26) <> "HELLO, WORLD! [ABC]{XYZ}@`" THEN PRINT "ERROR: UCASE$ tail" : END
+u$ = LCASE$(a$)
+IF RIGHT$(u$, 26) <> "hello, world! [abc]{xyz}@`" THEN PRINT "ERROR: LCASE$ "; RIGHT$(u$, 26) : END
+w$ = a$ + CHR$(9786)
+u$ = UCASE$(w$)
+IF LEN(u$) <> 261 THEN PRINT "ERROR: Unicode UCASE$ length" : END
+IF MID$(u$, 235, 26) <> "HELLO, WORLD! [ABC]{XYZ}@`" THEN PRINT "ERROR: Unicode UCASE$" : END
+IF ASC(RIGHT$(u$, 1)) <> 9786 THEN PRINT "ERROR: Unicode UCASE$ symbol" : END
+PRINT "  PASS: "; LEFT$(u$, 13)
+
+' =============================================================================
+' Test 3: ASCII + Unicode concatenation
+' =============================================================================
+PRINT "Test 3: Widening concat"
+w$ = CHR$(9786) + a$
+IF LEN(w$) <> 261 THEN PRINT "ERROR: concat length" : END
+n = 0
+FOR i = 2 TO 261
+    IF MID$(w$, i, 1) = MID$(a$, i - 1, 1) THEN n = n + 1
+NEXT i
+IF n <> 260 THEN PRINT "ERROR: widened characters "; n : END
+IF w$ <> CHR$(9786) + a$ THEN PRINT "ERROR: Unicode compare" : END
+PRINT "  PASS"
+
+PRINT ""
+PRINT "=== All string kernel tests passed ==="
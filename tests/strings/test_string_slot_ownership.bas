@@ -0,0 +1,61 @@
+' test_string_slot_ownership.bas
+' Strings stored into CLASS fields, UDT fields and array elements.  The
+' runner fails this test if SAMM reports leaked slots at shutdown, so every
+' string stored below must be freed by the time the program ends.  String
+' variables are avoided: a variable's last value is still held at shutdown.
+
+TYPE Rec
+    Name AS STRING
+    N AS INTEGER
+END TYPE
+
+CLASS Person
+    Name AS STRING
+END CLASS
+
+DIM names(10) AS STRING
+DIM i AS INTEGER
+
+SUB MakePerson(n AS INTEGER)
+    DIM p AS Person
+    p = NEW Person()
+    p.Name = "person" + STR$(n)
+    IF p.Name <> "person" + STR$(n) THEN PRINT "ERROR: CLASS field "; p.Name
+END SUB
+
+SUB FillRec(n AS INTEGER)
+    DIM r AS Rec
+    r.Name = "rec" + STR$(n)
+    r.N = n
+    IF r.Name <> "rec" + STR$(n) THEN PRINT "ERROR: UDT field "; r.Name
+END SUB
+
+PRINT "=== String Slot Ownership Test ==="
+
+' =============================================================================
+' Test 1: CLASS string field set in a SUB, many times
+' =============================================================================
+FOR i = 1 TO 5000
+    CALL MakePerson(i)
+NEXT i
+PRINT "Test 1: PASS"
+
+' =============================================================================
+' Test 2: local UDT string field set in a SUB, many times
+' =============================================================================
+FOR i = 1 TO 5000
+    CALL FillRec(i)
+NEXT i
+PRINT "Test 2: PASS"
+
+' =============================================================================
+' Test 3: array elements overwritten many times
+' =============================================================================
+FOR i = 1 TO 50000
+    names(i MOD 10) = "name" + STR$(i)
+NEXT i
+IF names(0) <> "name" + STR$(50000) THEN PRINT "ERROR: element 0 "; names(0) : END
+IF names(9) <> "name" + STR$(49999) THEN PRINT "ERROR: element 9 "; names(9) : END
+PRINT "Test 3: PASS"
+
+PRINT "=== String slot ownership test passed ==="
@@ -0,0 +1,65 @@
+' test_string_views.bas
+' MID$/LEFT$/RIGHT$/slices used inside PRINT items and conditions are
+' compiled to substring views that share the source string's characters.
+' Check the results, and that views stored in variables stay independent.
+
+PRINT "=== Substring View Test ==="
+PRINT ""
+
+DIM s$, w$, acc$, u$
+DIM i AS INTEGER
+DIM n AS INTEGER
+
+s$ = "the quick brown fox jumps over the lazy dog and keeps on running"
+
+' =============================================================================
+' Test 1: Views in conditions
+' =============================================================================
+PRINT "Test 1: Views in conditions"
+IF MID$(s$, 5, 20) <> "quick brown fox jump" THEN PRINT "ERROR: MID$ view" : END
+IF LEFT$(s$, 19) <> "the quick brown fox" THEN PRINT "ERROR: LEFT$ view" : END
+IF RIGHT$(s$, 16) <> "keeps on running" THEN PRINT "ERROR: RIGHT$ view" : END
+IF s$(11 TO 30) <> "brown fox jumps over" THEN PRINT "ERROR: slice view" : END
+IF LEN(MID$(s$, 50, 99)) <> 15 THEN PRINT "ERROR: LEN of view" : END
+IF MID$(s$, 99, 5) <> "" THEN PRINT "ERROR: out of range view" : END
+PRINT "  PASS"
+
+' =============================================================================
+' Test 2: Scanning with a view per position
+' =============================================================================
+PRINT "Test 2: Scan"
+n = 0
+FOR i = 1 TO LEN(s$) - 19
+    IF MID$(s$, i, 20) = "over the lazy dog an" THEN n = i
+NEXT i
+IF n <> 27 THEN PRINT "ERROR: scan found "; n : END
+PRINT "  PASS: found at"; n
+
+' =============================================================================
+' Test 3: Stored and appended substrings are copies
+' =============================================================================
+PRINT "Test 3: Escaping substrings"
+w$ = MID$(s$, 5, 20)
+acc$ = ""
+FOR i = 1 TO 3
+    acc$ = acc$ + MID$(s$, 1 + (i - 1) * 20, 20)
+NEXT i
+s$ = "replaced"
+IF w$ <> "quick brown fox jump" THEN PRINT "ERROR: stored view changed: "; w$ : END
+IF LEFT$(acc$, 24) <> "the quick brown fox jump" THEN PRINT "ERROR: appended view: "; acc$ : END
+IF LEN(acc$) <> 60 THEN PRINT "ERROR: appended length "; LEN(acc$) : END
+PRINT "  PASS: "; w$
+
+' =============================================================================
+' Test 4: UTF-32 strings
+' =============================================================================
+PRINT "Test 4: UTF-32 views"
+u$ = "x"
+u$ = u$ + CHR$(9786) + "abcdefghijklmnopqrstuvwxyz"
+IF MID$(u$, 3, 20) <> "abcdefghijklmnopqrst" THEN PRINT "ERROR: UTF-32 MID$" : END
+IF RIGHT$(u$, 17) <> "jklmnopqrstuvwxyz" THEN PRINT "ERROR: UTF-32 RIGHT$" : END
+IF ASC(MID$(u$, 2, 20)) <> 9786 THEN PRINT "ERROR: UTF-32 ASC" : END
+PRINT "  PASS: "; MID$(u$, 1, 18)
+
+PRINT ""
+PRINT "=== All substring view tests passed ==="
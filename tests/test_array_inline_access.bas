@@ -0,0 +1,57 @@
+' Test: inline array element addressing
+' Tests: 1-D and 2-D reads/writes of every numeric type and strings,
+'        REDIM, and subscripts at each bound
+
+' === Test 1: 1-D arrays ===
+PRINT "=== Test 1: 1-D arrays ==="
+DIM ai(100) AS INTEGER
+DIM al(100) AS LONG
+DIM ad(100) AS DOUBLE
+DIM asg(100) AS SINGLE
+DIM astr$(100)
+DIM i AS INTEGER
+DIM j AS INTEGER
+FOR i = 0 TO 100
+    ai(i) = i * 3
+    al(i) = i * 100000
+    ad(i) = i / 4
+    asg(i) = i
+    astr$(i) = STR$(i)
+NEXT i
+IF ai(0) <> 0 OR ai(100) <> 300 OR ai(57) <> 171 THEN PRINT "ERROR: INTEGER" : END
+IF al(100) <> 10000000 OR al(1) <> 100000 THEN PRINT "ERROR: LONG" : END
+IF ad(2) <> 0.5 OR ad(100) <> 25 THEN PRINT "ERROR: DOUBLE" : END
+IF asg(99) <> 99 THEN PRINT "ERROR: SINGLE" : END
+IF astr$(42) <> STR$(42) THEN PRINT "ERROR: STRING" : END
+PRINT "ai(57) = "; ai(57); " ad(100) = "; ad(100)
+
+' === Test 2: 2-D arrays ===
+PRINT ""
+PRINT "=== Test 2: 2-D arrays ==="
+DIM m(10, 20) AS DOUBLE
+DIM g(3, 4) AS INTEGER
+FOR i = 0 TO 10
+    FOR j = 0 TO 20
+        m(i, j) = i * 100 + j
+    NEXT j
+NEXT i
+IF m(0, 0) <> 0 OR m(10, 20) <> 1020 OR m(3, 17) <> 317 OR m(7, 0) <> 700 THEN PRINT "ERROR: 2-D" : END
+FOR i = 0 TO 3
+    FOR j = 0 TO 4
+        g(i, j) = i - j
+    NEXT j
+NEXT i
+IF g(3, 0) <> 3 OR g(0, 4) <> -4 OR g(2, 2) <> 0 THEN PRINT "ERROR: 2-D INTEGER" : END
+PRINT "m(3, 17) = "; m(3, 17)
+
+' === Test 3: REDIM ===
+PRINT ""
+PRINT "=== Test 3: REDIM ==="
+REDIM ai(200)
+FOR i = 0 TO 200
+    ai(i) = 200 - i
+NEXT i
+IF ai(200) <> 0 OR ai(0) <> 200 THEN PRINT "ERROR: REDIM" : END
+
+PRINT ""
+PRINT "PASS: inline array access"
@@ -0,0 +1,74 @@
+' Test: bounds-check elimination in FOR loops
+' Tests: constant loops over constant DIMs, LBOUND/UBOUND loops, nested
+'        2-D loops, variable limits (pre-loop test), STEP -1, subscript
+'        offsets, LBOUND/UBOUND values
+
+' === Test 1: constant loop over a constant DIM ===
+PRINT "=== Test 1: constant loop ==="
+DIM a(99) AS INTEGER
+DIM i AS INTEGER
+DIM j AS INTEGER
+DIM n AS INTEGER
+DIM s AS LONG
+FOR i = 0 TO 99
+    a(i) = i * 2
+NEXT i
+IF a(0) <> 0 OR a(99) <> 198 THEN PRINT "ERROR: constant loop" : END
+PRINT "a(99) = "; a(99)
+
+' === Test 2: LBOUND / UBOUND ===
+PRINT ""
+PRINT "=== Test 2: LBOUND/UBOUND ==="
+DIM m(9, 19) AS LONG
+IF LBOUND(a) <> 0 OR UBOUND(a) <> 99 THEN PRINT "ERROR: bounds of a" : END
+IF UBOUND(m, 1) <> 9 OR UBOUND(m, 2) <> 19 OR LBOUND(m, 2) <> 0 THEN PRINT "ERROR: bounds of m" : END
+s = 0
+FOR i = LBOUND(a) TO UBOUND(a)
+    s = s + a(i)
+NEXT i
+IF s <> 9900 THEN PRINT "ERROR: LBOUND/UBOUND loop sum: "; s : END
+PRINT "sum = "; s
+
+' === Test 3: nested 2-D loop ===
+PRINT ""
+PRINT "=== Test 3: 2-D loop ==="
+FOR i = 0 TO UBOUND(m, 1)
+    FOR j = 0 TO 19
+        m(i, j) = i * 100 + j
+    NEXT j
+NEXT i
+IF m(0, 0) <> 0 OR m(9, 19) <> 919 OR m(4, 7) <> 407 THEN PRINT "ERROR: 2-D loop" : END
+PRINT "m(9, 19) = "; m(9, 19)
+
+' === Test 4: variable limit and offsets ===
+PRINT ""
+PRINT "=== Test 4: variable limit ==="
+n = 50
+s = 0
+FOR i = 1 TO n
+    s = s + a(i) + a(i - 1)
+NEXT i
+IF s <> 5000 THEN PRINT "ERROR: variable limit sum: "; s : END
+PRINT "sum = "; s
+
+' === Test 5: STEP -1 ===
+PRINT ""
+PRINT "=== Test 5: STEP -1 ==="
+FOR i = UBOUND(a) TO 1 STEP -1
+    a(i) = a(i - 1) + 1
+NEXT i
+IF a(99) <> 197 OR a(1) <> 1 OR a(0) <> 0 THEN PRINT "ERROR: STEP -1" : END
+PRINT "a(99) = "; a(99)
+
+' === Test 6: early exit from an over-long loop ===
+PRINT ""
+PRINT "=== Test 6: EXIT FOR ==="
+n = 200
+FOR i = 0 TO n
+    IF i > UBOUND(a) THEN EXIT FOR
+    a(i) = -i
+NEXT i
+IF i <> 100 OR a(99) <> -99 THEN PRINT "ERROR: EXIT FOR" : END
+
+PRINT ""
+PRINT "PASS: bounds check elimination"
@@ -0,0 +1,87 @@
+' Test: GLOBAL scalars kept in registers across loops
+' Tests: GLOBAL loop counters and accumulators, EXIT FOR, nested loops,
+'        SHARED variables in a SUB, a loop with a SUB call, DOUBLE and
+'        LONG globals, GOTO out of a loop
+
+GLOBAL a%, b%, t%, i%, j%, hits%
+GLOBAL total&
+GLOBAL x#
+
+SUB Bump()
+    SHARED hits%
+    hits% = hits% + 1
+END SUB
+
+SUB CountUp(n AS INTEGER)
+    SHARED t%
+    DIM q AS INTEGER
+    FOR q = 1 TO n
+        t% = t% + q
+    NEXT q
+END SUB
+
+' === Test 1: Fibonacci in globals ===
+PRINT "=== Test 1: Fibonacci ==="
+a% = 0
+b% = 1
+FOR i% = 2 TO 30
+    t% = a% + b%
+    a% = b%
+    b% = t%
+NEXT i%
+IF b% <> 832040 OR a% <> 514229 OR i% <> 31 THEN PRINT "ERROR: fib "; a%; b%; i% : END
+PRINT "fib(30) = "; b%
+
+' === Test 2: EXIT FOR ===
+PRINT ""
+PRINT "=== Test 2: EXIT FOR ==="
+t% = 0
+FOR i% = 1 TO 100
+    t% = t% + i%
+    IF t% > 50 THEN EXIT FOR
+NEXT i%
+IF t% <> 55 OR i% <> 10 THEN PRINT "ERROR: EXIT FOR "; t%; i% : END
+PRINT "t% = "; t%; " i% = "; i%
+
+' === Test 3: nested loops with LONG and DOUBLE ===
+PRINT ""
+PRINT "=== Test 3: nested ==="
+total& = 0
+x# = 0
+FOR i% = 1 TO 10
+    FOR j% = 1 TO 10
+        total& = total& + i% * j%
+        x# = x# + 0.5
+    NEXT j%
+NEXT i%
+IF total& <> 3025 OR x# <> 50 THEN PRINT "ERROR: nested "; total&; x# : END
+PRINT "total& = "; total&; " x# = "; x#
+
+' === Test 4: SUB calls in and around loops ===
+PRINT ""
+PRINT "=== Test 4: SUB calls ==="
+hits% = 0
+FOR i% = 1 TO 5
+    hits% = hits% + 10
+    CALL Bump
+NEXT i%
+IF hits% <> 55 THEN PRINT "ERROR: calls in loop "; hits% : END
+t% = 100
+CALL CountUp(10)
+IF t% <> 155 THEN PRINT "ERROR: SHARED loop "; t% : END
+PRINT "hits% = "; hits%; " t% = "; t%
+
+' === Test 5: GOTO out of a loop ===
+PRINT ""
+PRINT "=== Test 5: GOTO ==="
+a% = 0
+WHILE a% < 1000
+    a% = a% + 7
+    IF a% > 40 THEN GOTO past_loop
+WEND
+past_loop:
+IF a% <> 42 THEN PRINT "ERROR: GOTO "; a% : END
+PRINT "a% = "; a%
+
+PRINT ""
+PRINT "PASS: global loop promotion"
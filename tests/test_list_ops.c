@@ -22,17 +22,22 @@
  *   - Free
  *   - SAMM cleanup path (list_free_from_samm, list_atom_free_from_samm)
  *   - Debug print
+ *   - Sort, reductions, filter and map
+ *   - Chunked typed lists, checked against a plain array model, and a
+ *     benchmark of the chunked layout against the linked one
  *
- * Build:
- *   cd compact_repo
+ * Build (from the repository root; basic_error_msg is defined below
+ * instead of linking basic_runtime.c):
  *   cc -std=c99 -g -O0 \
  *      -I fsh/FasterBASICT/runtime_c \
  *      tests/test_list_ops.c \
  *      fsh/FasterBASICT/runtime_c/list_ops.c \
  *      fsh/FasterBASICT/runtime_c/string_utf32.c \
+ *      fsh/FasterBASICT/runtime_c/string_simd.c \
  *      fsh/FasterBASICT/runtime_c/string_ops.c \
  *      fsh/FasterBASICT/runtime_c/string_pool.c \
  *      fsh/FasterBASICT/runtime_c/samm_core.c \
+ *      fsh/FasterBASICT/runtime_c/samm_pool.c \
  *      fsh/FasterBASICT/runtime_c/array_descriptor_runtime.c \
  *      -lpthread -lm \
  *      -o tests/test_list_ops
@@ -43,10 +48,19 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
 
 #include "list_ops.h"
 #include "string_descriptor.h"
 #include "samm_bridge.h"
+#include "samm_pool.h"
+
+/* The runtime reports fatal errors through basic_runtime.c, which pulls
+ * in the rest of the BASIC runtime; a test run just stops. */
+void basic_error_msg(const char* message) {
+    fprintf(stderr, "Runtime error: %s\n", message);
+    exit(1);
+}
 
 /* ========================================================================= */
 /* Test framework                                                             */
@@ -1129,8 +1143,16 @@ static void test_append_null_string(void) {
 static void test_samm_cleanup_functions(void) {
     TEST("list_free_from_samm / list_atom_free_from_samm");
 
+    /* The SAMM cleanup functions return shells to the slab pools, so
+     * they must come from the pools rather than malloc. */
+    size_t headers_before, atoms_before, headers_after, atoms_after;
+    samm_slab_pool_stats(&g_list_header_pool, &headers_before,
+                         NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    samm_slab_pool_stats(&g_list_atom_pool, &atoms_before,
+                         NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
     /* Test list_free_from_samm — should free header only */
-    ListHeader* h = (ListHeader*)malloc(sizeof(ListHeader));
+    ListHeader* h = (ListHeader*)samm_alloc_list();
     h->type = ATOM_SENTINEL;
     h->flags = 0;
     h->length = 0;
@@ -1140,7 +1162,7 @@ static void test_samm_cleanup_functions(void) {
     /* If we get here without crash, it worked */
 
     /* Test list_atom_free_from_samm with INT atom */
-    ListAtom* atom = (ListAtom*)malloc(sizeof(ListAtom));
+    ListAtom* atom = (ListAtom*)samm_alloc_list_atom();
     atom->type = ATOM_INT;
     atom->pad = 0;
     atom->value.int_value = 42;
@@ -1148,7 +1170,7 @@ static void test_samm_cleanup_functions(void) {
     list_atom_free_from_samm(atom);
 
     /* Test list_atom_free_from_samm with STRING atom */
-    ListAtom* strAtom = (ListAtom*)malloc(sizeof(ListAtom));
+    ListAtom* strAtom = (ListAtom*)samm_alloc_list_atom();
     strAtom->type = ATOM_STRING;
     strAtom->pad = 0;
     StringDescriptor* sd = string_new_ascii("samm_test");
@@ -1162,6 +1184,13 @@ static void test_samm_cleanup_functions(void) {
     list_free_from_samm(NULL);
     list_atom_free_from_samm(NULL);
 
+    samm_slab_pool_stats(&g_list_header_pool, &headers_after,
+                         NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    samm_slab_pool_stats(&g_list_atom_pool, &atoms_after,
+                         NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    ASSERT_EQ_INT(headers_before, headers_after, "header pool in_use restored");
+    ASSERT_EQ_INT(atoms_before, atoms_after, "atom pool in_use restored");
+
     PASS();
 }
 
@@ -1330,6 +1359,460 @@ static void test_string_cleanup_on_free(void) {
     PASS();
 }
 
+/* ========================================================================= */
+/* Tests: Sort / Reductions / Filter / Map                                    */
+/* ========================================================================= */
+
+static void test_sort_int(void) {
+    TEST("list_sort — integers, both layouts, both orders");
+
+    for (int kind = 0; kind < 2; kind++) {
+        ListHeader* list = kind == 0 ? list_create()
+                                     : list_create_typed(LIST_FLAG_ELEM_INT);
+        uint32_t seed = 7;
+        for (int i = 0; i < 1000; i++) {
+            seed = seed * 1103515245u + 12345u;
+            list_append_int(list, (int64_t)(seed >> 16) % 500 - 250);
+        }
+
+        list_sort(list, 0, 0);
+        ASSERT_EQ_INT(1000, list_length(list), "length after sort");
+        for (ListAtom* a = list->head; a->next; a = a->next) {
+            if (a->value.int_value > a->next->value.int_value) {
+                FAIL("ascending order");
+                return;
+            }
+        }
+
+        list_sort(list, 1, 0);
+        for (ListAtom* a = list->head; a->next; a = a->next) {
+            if (a->value.int_value < a->next->value.int_value) {
+                FAIL("descending order");
+                return;
+            }
+        }
+        ASSERT_NULL(list->tail->next, "tail->next");
+        list_free(list);
+    }
+    PASS();
+}
+
+static void test_sort_mixed_stable(void) {
+    TEST("list_sort — mixed types, stable, nocase");
+
+    ListHeader* list = list_create();
+    StringDescriptor* b  = string_new_ascii("b");
+    StringDescriptor* A  = string_new_ascii("A");
+    StringDescriptor* a  = string_new_ascii("a");
+    list_append_string(list, b);
+    list_append_float(list, 2.5);
+    list_append_string(list, A);
+    list_append_int(list, 3);
+    list_append_string(list, a);
+    list_append_int(list, -1);
+
+    /* Numbers first (by value, INT and FLOAT together), then strings */
+    list_sort(list, 0, 1);
+    ASSERT_EQ_INT(-1, list_get_int(list, 1), "1st");
+    ASSERT_EQ_DOUBLE(2.5, list_get_float(list, 2), "2nd");
+    ASSERT_EQ_INT(3, list_get_int(list, 3), "3rd");
+    /* "A" and "a" are equal ignoring case: they keep their order */
+    ASSERT_EQ_INT(1, list_get_ptr(list, 4) == A, "4th is A");
+    ASSERT_EQ_INT(1, list_get_ptr(list, 5) == a, "5th is a");
+    ASSERT_EQ_INT(1, list_get_ptr(list, 6) == b, "6th is b");
+
+    /* Case-sensitive: "A" < "a" < "b" */
+    list_sort(list, 1, 0);
+    ASSERT_EQ_INT(1, list_get_ptr(list, 1) == b, "desc 1st is b");
+    ASSERT_EQ_INT(1, list_get_ptr(list, 3) == A, "desc 3rd is A");
+    ASSERT_EQ_INT(-1, list_get_int(list, 6), "desc last");
+
+    /* Refcounts unchanged: the list still holds one reference each */
+    ASSERT_EQ_INT(2, a->refcount, "refcount");
+
+    list_free(list);
+    string_release(a);
+    string_release(A);
+    string_release(b);
+    PASS();
+}
+
+static void test_reductions(void) {
+    TEST("list_sum/min/max/avg");
+
+    ListHeader* ints = list_create_typed(LIST_FLAG_ELEM_INT);
+    for (int i = 1; i <= 100; i++) list_append_int(ints, i);
+    list_append_int(ints, -7);
+    ASSERT_EQ_INT(5043, list_sum_int(ints), "sum");
+    ASSERT_EQ_INT(-7, list_min_int(ints), "min");
+    ASSERT_EQ_INT(100, list_max_int(ints), "max");
+    ASSERT_EQ_DOUBLE(5043.0 / 101.0, list_avg(ints), "avg");
+
+    ListHeader* mixed = list_create();
+    list_append_float(mixed, 1.5);
+    list_append_string(mixed, NULL);
+    list_append_int(mixed, 2);
+    ASSERT_EQ_DOUBLE(3.5, list_sum_float(mixed), "mixed sum");
+    ASSERT_EQ_DOUBLE(1.5, list_min_float(mixed), "mixed min");
+    ASSERT_EQ_DOUBLE(2.0, list_max_float(mixed), "mixed max");
+    ASSERT_EQ_DOUBLE(1.75, list_avg(mixed), "mixed avg");
+
+    ListHeader* empty = list_create_typed(LIST_FLAG_ELEM_FLOAT);
+    ASSERT_EQ_DOUBLE(0.0, list_max_float(empty), "empty max");
+    ASSERT_EQ_DOUBLE(0.0, list_avg(empty), "empty avg");
+    ASSERT_EQ_INT(0, list_sum_int(NULL), "NULL sum");
+
+    list_free(ints);
+    list_free(mixed);
+    list_free(empty);
+    PASS();
+}
+
+static void test_filter_map(void) {
+    TEST("list_filter_* / list_map_*");
+
+    StringDescriptor* ge  = string_new_ascii(">=");
+    StringDescriptor* ne  = string_new_ascii("<>");
+    StringDescriptor* mul = string_new_ascii("*");
+    StringDescriptor* div = string_new_ascii("/");
+    StringDescriptor* bad = string_new_ascii("~");
+
+    ListHeader* ints = list_create_typed(LIST_FLAG_ELEM_INT);
+    for (int i = 1; i <= 10; i++) list_append_int(ints, i);
+
+    ListHeader* big = list_filter_int(ints, ge, 7);
+    ASSERT_EQ_INT(4, list_length(big), "filter length");
+    ASSERT_EQ_INT(7, list_head_int(big), "filter head");
+    ASSERT_EQ_INT(LIST_FLAG_ELEM_INT, list_elem_type_flag(big), "filter keeps flags");
+
+    ListHeader* tripled = list_map_int(ints, mul, 3);
+    ASSERT_EQ_INT(165, list_sum_int(tripled), "map *");
+    ListHeader* halves = list_map_float(ints, div, 2.0);
+    ASSERT_EQ_DOUBLE(27.5, list_sum_float(halves), "map / float");
+    ListHeader* halvesInt = list_map_int(ints, div, 2);
+    ASSERT_EQ_INT(25, list_sum_int(halvesInt), "map / int");
+
+    ListHeader* none = list_filter_int(ints, bad, 0);
+    ASSERT_EQ_INT(0, list_length(none), "unknown op gives empty list");
+
+    ListHeader* strs = list_create_typed(LIST_FLAG_ELEM_STRING);
+    StringDescriptor* x = string_new_ascii("x");
+    StringDescriptor* y = string_new_ascii("y");
+    list_append_string(strs, x);
+    list_append_string(strs, y);
+    list_append_string(strs, x);
+    ListHeader* notx = list_filter_string(strs, ne, x);
+    ASSERT_EQ_INT(1, list_length(notx), "string filter");
+    ASSERT_EQ_INT(1, list_head_ptr(notx) == y, "string filter value");
+    ASSERT_EQ_INT(3, y->refcount, "filtered string retained");
+
+    list_free(ints);
+    list_free(big);
+    list_free(tripled);
+    list_free(halves);
+    list_free(halvesInt);
+    list_free(none);
+    list_free(strs);
+    list_free(notx);
+    string_release(x);
+    string_release(y);
+    string_release(ge);
+    string_release(ne);
+    string_release(mul);
+    string_release(div);
+    string_release(bad);
+    PASS();
+}
+
+/* ========================================================================= */
+/* Tests: Chunked typed lists                                                 */
+/* ========================================================================= */
+
+/*
+ * Walk a list through head/next and check it against model[0..n-1]:
+ * length, values, tail, tail->next == NULL.  For a chunked list also
+ * check that every atom's pad is its index in its chunk and that the
+ * chunks' counts add up.  Returns NULL or a description of the mismatch.
+ */
+static const char* check_list_against(ListHeader* list, const int64_t* model, int64_t n) {
+    if (list->length != n) return "length";
+    if (n == 0) return (list->head || list->tail) ? "head/tail of empty list" : NULL;
+
+    ListAtom* prev = NULL;
+    ListAtom* curr = list->head;
+    for (int64_t i = 0; i < n; i++) {
+        if (!curr) return "chain shorter than length";
+        if (curr->value.int_value != model[i]) return "value";
+        prev = curr;
+        curr = curr->next;
+    }
+    if (curr) return "chain longer than length";
+    if (prev != list->tail) return "tail";
+
+    if (list_is_chunked(list)) {
+        int64_t total = 0;
+        const ListChunk* c = (const ListChunk*)((const char*)(list->head - list->head->pad) -
+                                                offsetof(ListChunk, cells));
+        if (c->prev) return "first chunk has a prev";
+        for (; c; c = c->next) {
+            if (c->count <= 0) return "empty chunk";
+            if (c->start < 0 || c->start + c->count > c->capacity) return "chunk range";
+            for (int32_t i = c->start; i < c->start + c->count; i++) {
+                if (c->cells[i].pad != i) return "pad";
+            }
+            if (c->next && c->next->prev != c) return "chunk prev";
+            total += c->count;
+        }
+        if (total != n) return "chunk counts";
+    }
+    return NULL;
+}
+
+static void test_chunked_selected(void) {
+    TEST("typed lists are chunked, ANY/LIST/OBJECT linked");
+
+    ListHeader* a = list_create();
+    ListHeader* i = list_create_typed(LIST_FLAG_ELEM_INT);
+    ListHeader* f = list_create_typed(LIST_FLAG_ELEM_FLOAT);
+    ListHeader* s = list_create_typed(LIST_FLAG_ELEM_STRING);
+    ListHeader* l = list_create_typed(LIST_FLAG_ELEM_LIST);
+
+    ASSERT_EQ_INT(0, list_is_chunked(a), "ANY");
+    ASSERT_EQ_INT(1, list_is_chunked(i), "INT");
+    ASSERT_EQ_INT(1, list_is_chunked(f), "FLOAT");
+    ASSERT_EQ_INT(1, list_is_chunked(s), "STRING");
+    ASSERT_EQ_INT(0, list_is_chunked(l), "LIST");
+
+    /* Copies keep the representation */
+    list_append_int(i, 1);
+    ListHeader* c = list_copy(i);
+    ASSERT_EQ_INT(1, list_is_chunked(c), "copy of INT");
+
+    list_free(a);
+    list_free(i);
+    list_free(f);
+    list_free(s);
+    list_free(l);
+    list_free(c);
+    PASS();
+}
+
+static void test_chunked_random_ops(void) {
+    TEST("chunked list — 20000 random ops vs array model");
+
+    enum { MAX = 4096 };
+    static int64_t model[MAX];
+    int64_t n = 0;
+    uint32_t seed = 12345;
+    ListHeader* list = list_create_typed(LIST_FLAG_ELEM_INT);
+
+    for (int step = 0; step < 20000; step++) {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t r = seed >> 8;
+        int op = (int)(r % 8);
+        int64_t v = step;
+
+        /* Grow more than shrink until the list is big, then hover */
+        if (n >= MAX - 1) op = 4 + op % 4;
+
+        if (op <= 1) {
+            list_append_int(list, v);
+            model[n++] = v;
+        } else if (op == 2) {
+            list_prepend_int(list, v);
+            memmove(&model[1], &model[0], (size_t)n * sizeof(int64_t));
+            model[0] = v;
+            n++;
+        } else if (op == 3) {
+            int64_t pos = (int64_t)((r >> 4) % (uint32_t)(n + 2));   /* 0..n+1: clamps too */
+            list_insert_int(list, pos, v);
+            int64_t at = pos <= 1 ? 0 : (pos > n ? n : pos - 1);
+            memmove(&model[at + 1], &model[at], (size_t)(n - at) * sizeof(int64_t));
+            model[at] = v;
+            n++;
+        } else if (op == 4 && n > 0) {
+            int64_t pos = 1 + (int64_t)((r >> 4) % (uint32_t)n);
+            list_remove(list, pos);
+            memmove(&model[pos - 1], &model[pos], (size_t)(n - pos) * sizeof(int64_t));
+            n--;
+        } else if (op == 5 && n > 0) {
+            ASSERT_EQ_INT(model[n - 1], list_pop_int(list), "pop");
+            n--;
+        } else if (op == 6 && n > 0) {
+            ASSERT_EQ_INT(model[0], list_shift_int(list), "shift");
+            memmove(&model[0], &model[1], (size_t)(n - 1) * sizeof(int64_t));
+            n--;
+        } else if (n > 0) {
+            int64_t pos = 1 + (int64_t)((r >> 4) % (uint32_t)n);
+            ASSERT_EQ_INT(model[pos - 1], list_get_int(list, pos), "get");
+        }
+
+        if (step % 97 == 0) {
+            const char* err = check_list_against(list, model, n);
+            if (err) {
+                FAIL(err);
+                return;
+            }
+        }
+    }
+
+    const char* err = check_list_against(list, model, n);
+    if (err) {
+        FAIL(err);
+        return;
+    }
+
+    /* Drain from both ends */
+    while (n > 0) {
+        ASSERT_EQ_INT(model[n - 1], list_pop_int(list), "drain pop");
+        n--;
+        if (n == 0) break;
+        ASSERT_EQ_INT(model[0], list_shift_int(list), "drain shift");
+        memmove(&model[0], &model[1], (size_t)(n - 1) * sizeof(int64_t));
+        n--;
+    }
+    ASSERT_NULL(list->head, "head after drain");
+    ASSERT_NULL(list->tail, "tail after drain");
+    ASSERT_EQ_INT(0, list_pop_int(list), "pop on empty");
+
+    list_free(list);
+    PASS();
+}
+
+static void test_chunked_iteration(void) {
+    TEST("chunked list — list_iter_* across chunks");
+
+    ListHeader* list = list_create_typed(LIST_FLAG_ELEM_FLOAT);
+    for (int i = 0; i < 1000; i++) {
+        list_append_float(list, i * 0.5);
+    }
+    list_insert_float(list, 500, -1.0);
+    list_remove(list, 500);
+
+    int count = 0;
+    double sum = 0.0;
+    for (ListAtom* it = list_iter_begin(list); it; it = list_iter_next(it)) {
+        ASSERT_EQ_INT(ATOM_FLOAT, list_iter_type(it), "type");
+        sum += list_iter_value_float(it);
+        count++;
+    }
+    ASSERT_EQ_INT(1000, count, "count");
+    ASSERT_EQ_DOUBLE(0.5 * 999 * 1000 / 2, sum, "sum");
+    ASSERT_EQ_DOUBLE(499.5, list_get_float(list, 1000), "last");
+
+    list_free(list);
+    PASS();
+}
+
+static void test_chunked_strings(void) {
+    TEST("chunked string list — refcounts");
+
+    size_t headers_before, headers_after;
+    samm_slab_pool_stats(&g_list_header_pool, &headers_before,
+                         NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
+    StringDescriptor* s = string_new_ascii("chunked");
+    ListHeader* list = list_create_typed(LIST_FLAG_ELEM_STRING);
+    for (int i = 0; i < 100; i++) {
+        list_append_string(list, s);
+    }
+    list_insert_string(list, 50, s);
+    ASSERT_EQ_INT(102, s->refcount, "refcount after 101 adds");
+
+    list_remove(list, 50);
+    list_pop(list);
+    list_shift(list);
+    ASSERT_EQ_INT(99, s->refcount, "refcount after 3 removes");
+
+    /* _ptr variants hand the reference to the caller */
+    StringDescriptor* p = (StringDescriptor*)list_pop_ptr(list);
+    ASSERT_EQ_INT(1, p == s, "pop_ptr value");
+    ASSERT_EQ_INT(99, s->refcount, "pop_ptr keeps the reference");
+    string_release(p);
+
+    list_clear(list);
+    ASSERT_EQ_INT(1, s->refcount, "refcount after clear");
+
+    /* The SAMM path frees a chunked list's atoms with the header */
+    for (int i = 0; i < 10; i++) {
+        list_append_string(list, s);
+    }
+    ASSERT_EQ_INT(11, s->refcount, "refcount before samm free");
+    /* SAMM tracks the header since samm_init(); hand it over first, as
+     * the scope cleanup would, so samm_shutdown() does not free it again */
+    samm_untrack(list);
+    list_free_from_samm(list);
+    ASSERT_EQ_INT(1, s->refcount, "refcount after samm free");
+
+    samm_slab_pool_stats(&g_list_header_pool, &headers_after,
+                         NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    ASSERT_EQ_INT(headers_before, headers_after, "header pool in_use restored");
+
+    string_release(s);
+    PASS();
+}
+
+/* ========================================================================= */
+/* Benchmark: linked vs chunked                                               */
+/* ========================================================================= */
+
+static double elapsed_ms(clock_t t0) {
+    return (double)(clock() - t0) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+/*
+ * The same operations on LIST OF ANY (one pooled atom per element) and
+ * LIST OF INTEGER (chunks).  Timings are printed, not asserted; the two
+ * sums must agree.
+ */
+static void bench_linked_vs_chunked(void) {
+    enum { N = 20000 };
+    static const char* names[2] = { "linked", "chunked" };
+    int64_t sums[2] = { 0, 0 };
+
+    fprintf(stderr, "  %-8s %10s %10s %10s %10s %10s\n",
+            "", "append", "iterate", "get(i)", "insert", "pop");
+
+    for (int kind = 0; kind < 2; kind++) {
+        ListHeader* list = kind == 0 ? list_create()
+                                     : list_create_typed(LIST_FLAG_ELEM_INT);
+        int64_t sum = 0;
+
+        clock_t t0 = clock();
+        for (int i = 0; i < N; i++) list_append_int(list, i);
+        double t_append = elapsed_ms(t0);
+
+        t0 = clock();
+        for (int rep = 0; rep < 100; rep++) {
+            for (ListAtom* it = list_iter_begin(list); it; it = list_iter_next(it)) {
+                sum += list_iter_value_int(it);
+            }
+        }
+        double t_iter = elapsed_ms(t0);
+
+        t0 = clock();
+        for (int64_t i = 1; i <= N; i += 7) sum += list_get_int(list, i);
+        double t_get = elapsed_ms(t0);
+
+        t0 = clock();
+        for (int i = 0; i < 2000; i++) list_insert_int(list, N / 2, i);
+        double t_insert = elapsed_ms(t0);
+
+        t0 = clock();
+        while (!list_empty(list)) sum += list_pop_int(list);
+        double t_pop = elapsed_ms(t0);
+
+        fprintf(stderr, "  %-8s %8.2fms %8.2fms %8.2fms %8.2fms %8.2fms\n",
+                names[kind], t_append, t_iter, t_get, t_insert, t_pop);
+        sums[kind] = sum;
+        list_free(list);
+    }
+
+    TEST("benchmark — linked and chunked agree");
+    ASSERT_EQ_INT(sums[0], sums[1], "checksum");
+    PASS();
+}
+
 /* ========================================================================= */
 /* Main                                                                       */
 /* ========================================================================= */
@@ -1459,6 +1942,24 @@ int main(int argc, char** argv) {
     fprintf(stderr, "\n--- Debug ---\n");
     test_debug_print();
 
+    /* Sort / reductions / filter / map */
+    fprintf(stderr, "\n--- Sort / Reduce / Filter / Map ---\n");
+    test_sort_int();
+    test_sort_mixed_stable();
+    test_reductions();
+    test_filter_map();
+
+    /* Chunked typed lists */
+    fprintf(stderr, "\n--- Chunked Lists ---\n");
+    test_chunked_selected();
+    test_chunked_random_ops();
+    test_chunked_iteration();
+    test_chunked_strings();
+
+    /* Benchmark */
+    fprintf(stderr, "\n--- Benchmark: linked vs chunked (%d elements) ---\n", 20000);
+    bench_linked_vs_chunked();
+
     /* Summary */
     fprintf(stderr, "\n");
     fprintf(stderr, "══════════════════════════════════════════════════════════\n");
@@ -0,0 +1,90 @@
+OPTION SAMM ON
+
+' Test: LIST SORT, reductions, FILTER and MAP
+' Tests: SORT() / SORT(1) / SORT(0, 1), SUM/MIN/MAX/AVG as methods and as
+'        SUM(list) etc., FILTER(op$, value), MAP(op$, value)
+
+' === Test 1: SORT on LIST OF INTEGER ===
+PRINT "=== Test 1: SORT integers ==="
+DIM nums AS LIST OF INTEGER
+DIM i AS INTEGER
+DIM prev AS LONG
+DIM seed AS LONG
+DIM n AS INTEGER
+seed = 17
+FOR i = 1 TO 500
+    seed = (seed * 1103 + 12345) MOD 65536
+    nums.APPEND(seed MOD 1000 - 500)
+NEXT i
+nums.SORT()
+prev = nums.GET(1)
+n = nums.LENGTH()
+FOR i = 2 TO n
+    IF nums.GET(i) < prev THEN PRINT "ERROR: not ascending at "; i : END
+    prev = nums.GET(i)
+NEXT i
+nums.SORT(1)
+IF nums.HEAD() < nums.GET(nums.LENGTH()) THEN PRINT "ERROR: not descending" : END
+PRINT "Sorted "; nums.LENGTH(); " integers"
+
+' === Test 2: SORT on LIST OF STRING, ignoring case ===
+PRINT ""
+PRINT "=== Test 2: SORT strings ==="
+DIM words AS LIST OF STRING
+words.APPEND("pear")
+words.APPEND("Apple")
+words.APPEND("banana")
+words.APPEND("apple")
+words.SORT(0, 1)
+PRINT words.JOIN(",")
+IF words.JOIN(",") <> "Apple,apple,banana,pear" THEN PRINT "ERROR: nocase sort" : END
+words.SORT()
+IF words.JOIN(",") <> "Apple,apple,banana,pear" THEN PRINT "ERROR: case sort" : END
+words.SORT(1)
+IF words.JOIN(",") <> "pear,banana,apple,Apple" THEN PRINT "ERROR: descending sort" : END
+
+' === Test 3: Reductions ===
+PRINT ""
+PRINT "=== Test 3: Reductions ==="
+DIM small AS LIST OF INTEGER
+FOR i = 1 TO 10
+    small.APPEND(i * i)
+NEXT i
+PRINT "SUM: "; small.SUM(); " MIN: "; small.MIN(); " MAX: "; small.MAX(); " AVG: "; small.AVG()
+IF small.SUM() <> 385 THEN PRINT "ERROR: SUM" : END
+IF small.MIN() <> 1 OR small.MAX() <> 100 THEN PRINT "ERROR: MIN/MAX" : END
+IF small.AVG() <> 38.5 THEN PRINT "ERROR: AVG" : END
+IF SUM(small) <> 385 OR MAX(small) <> 100 OR MIN(small) <> 1 THEN PRINT "ERROR: SUM(list)" : END
+IF AVG(small) <> 38.5 THEN PRINT "ERROR: AVG(list)" : END
+
+DIM prices AS LIST OF DOUBLE
+prices.APPEND(1.25)
+prices.APPEND(2.5)
+prices.APPEND(0.75)
+IF prices.SUM() <> 4.5 THEN PRINT "ERROR: DOUBLE SUM" : END
+IF prices.MIN() <> 0.75 OR MAX(prices) <> 2.5 THEN PRINT "ERROR: DOUBLE MIN/MAX" : END
+PRINT "DOUBLE SUM: "; prices.SUM()
+
+' === Test 4: FILTER and MAP ===
+PRINT ""
+PRINT "=== Test 4: FILTER and MAP ==="
+DIM big AS LIST OF INTEGER
+big = small.FILTER(">", 50)
+PRINT "FILTER > 50: "; big.JOIN(" ")
+IF big.JOIN(" ") <> "64 81 100" THEN PRINT "ERROR: FILTER" : END
+
+DIM doubled AS LIST OF INTEGER
+doubled = small.MAP("*", 2)
+IF doubled.SUM() <> 770 THEN PRINT "ERROR: MAP" : END
+
+DIM cheap AS LIST OF DOUBLE
+cheap = prices.FILTER("<", 2.0)
+IF cheap.LENGTH() <> 2 THEN PRINT "ERROR: DOUBLE FILTER" : END
+
+DIM notpear AS LIST OF STRING
+notpear = words.FILTER("<>", "pear")
+IF notpear.JOIN(",") <> "banana,apple,Apple" THEN PRINT "ERROR: STRING FILTER" : END
+PRINT "FILTER <> pear: "; notpear.JOIN(",")
+
+PRINT ""
+PRINT "PASS: list sort and reductions"
@@ -0,0 +1,78 @@
+' Test: PARALLEL FOR
+' Tests: array fill, REDUCE SUM/MIN/MAX, STEP, scalars private to an
+'        iteration, inputs read from the enclosing program, inner FOR/IF
+
+' === Test 1: fill an array ===
+PRINT "=== Test 1: array fill ==="
+DIM a(10000) AS DOUBLE
+DIM b(10000) AS INTEGER
+DIM i AS INTEGER
+DIM scale AS DOUBLE
+scale = 0.5
+PARALLEL FOR i = 0 TO 10000
+    a(i) = i * scale
+    b(i) = i MOD 7
+NEXT i
+IF a(0) <> 0 OR a(10000) <> 5000 OR a(1235) <> 617.5 THEN PRINT "ERROR: fill" : END
+IF b(10000) <> 10000 MOD 7 THEN PRINT "ERROR: fill b" : END
+IF i <> 10001 THEN PRINT "ERROR: loop variable after loop: "; i : END
+PRINT "a(1235) = "; a(1235)
+
+' === Test 2: reductions ===
+PRINT ""
+PRINT "=== Test 2: REDUCE ==="
+DIM total AS LONG
+DIM lo AS INTEGER
+DIM hi AS INTEGER
+DIM dsum AS DOUBLE
+total = 100
+lo = 9999
+hi = -9999
+dsum = 0
+PARALLEL FOR i = 1 TO 10000 REDUCE SUM(total), MIN(lo), MAX(hi), SUM(dsum)
+    total = total + b(i)
+    lo = MIN(lo, b(i) - 3)
+    hi = MAX(hi, b(i) * 2)
+    dsum = dsum + 0.25
+NEXT i
+PRINT "SUM: "; total; " MIN: "; lo; " MAX: "; hi; " DSUM: "; dsum
+' sum of i MOD 7 for i = 1..10000: 1428 full cycles of 21 plus 1+2+3+4
+IF total <> 100 + 1428 * 21 + 10 THEN PRINT "ERROR: SUM" : END
+IF lo <> -3 OR hi <> 12 THEN PRINT "ERROR: MIN/MAX" : END
+IF dsum <> 2500 THEN PRINT "ERROR: DOUBLE SUM" : END
+
+' === Test 3: STEP and private scalars ===
+PRINT ""
+PRINT "=== Test 3: STEP and private scalars ==="
+DIM c(1000) AS LONG
+DIM sq AS LONG
+DIM j AS INTEGER
+DIM acc AS LONG
+FOR i = 0 TO 1000 : c(i) = -1 : NEXT i
+PARALLEL FOR i = 1000 TO 0 STEP -2
+    sq = i * i
+    acc = 0
+    FOR j = 1 TO 3
+        acc = acc + j
+    NEXT j
+    IF sq > 250000 THEN
+        c(i) = sq + acc
+    ELSE
+        c(i) = acc
+    END IF
+NEXT i
+IF c(1000) <> 1000006 OR c(2) <> 6 OR c(999) <> -1 OR c(0) <> 6 THEN PRINT "ERROR: STEP" : END
+IF i <> -2 THEN PRINT "ERROR: loop variable after STEP loop: "; i : END
+PRINT "c(1000) = "; c(1000)
+
+' === Test 4: empty range ===
+PRINT ""
+PRINT "=== Test 4: empty range ==="
+total = 7
+PARALLEL FOR i = 5 TO 1 REDUCE SUM(total)
+    total = total + 1
+NEXT i
+IF total <> 7 OR i <> 5 THEN PRINT "ERROR: empty range" : END
+
+PRINT ""
+PRINT "PASS: parallel for"
@@ -0,0 +1,137 @@
+/*
+ * test_samm_free_1m.c
+ * SAMM explicit-free stress test (samm_core.c)
+ *
+ * Tracks 1,000,000 allocations in a single scope and then releases every
+ * one of them explicitly before the scope exits, the pattern produced by a
+ * BASIC loop that builds a large collection and then ERASEs / DELETEs it
+ * element by element:
+ *
+ *   samm_enter_scope()
+ *     1M x malloc + samm_track(GENERIC)
+ *     count/10 x samm_alloc_object + samm_track_object
+ *     count/10 x samm_free_object     (oldest first, scope holds 1.1M)
+ *     1M x samm_untrack + free        (oldest first)
+ *   samm_exit_scope()                 (must find nothing left to clean)
+ *
+ * Only a tenth as many CLASS objects are used because the object slab
+ * pools are capped (SAMM_SLAB_POOL_MAX_SLABS); they are freed while the
+ * full million generic entries are still tracked alongside them.
+ *
+ * Removal is driven oldest-first on purpose: a scope that searched its
+ * pointer vector linearly would walk almost the whole vector for every
+ * call, turning this test quadratic (hours rather than milliseconds).
+ * With the per-thread pointer index each removal is O(1).
+ *
+ * Build:
+ *   cc -O2 \
+ *      -I fsh/FasterBASICT/runtime_c \
+ *      tests_stress/test_samm_free_1m.c \
+ *      fsh/FasterBASICT/runtime_c/samm_core.c \
+ *      fsh/FasterBASICT/runtime_c/samm_pool.c \
+ *      fsh/FasterBASICT/runtime_c/list_ops.c \
+ *      fsh/FasterBASICT/runtime_c/string_utf32.c \
+ *      fsh/FasterBASICT/runtime_c/string_simd.c \
+ *      fsh/FasterBASICT/runtime_c/string_pool.c \
+ *      fsh/FasterBASICT/runtime_c/array_descriptor_runtime.c \
+ *      -lpthread -lm \
+ *      -o tests_stress/test_samm_free_1m
+ *   ./tests_stress/test_samm_free_1m [count]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <inttypes.h>
+
+#include "samm_bridge.h"
+
+#define DEFAULT_COUNT   1000000
+#define OBJECT_SIZE     48
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int check(int ok, const char* what) {
+    printf("  %-44s %s\n", what, ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    long count = DEFAULT_COUNT;
+    if (argc > 1) {
+        count = atol(argv[1]);
+        if (count <= 0) count = DEFAULT_COUNT;
+    }
+
+    samm_init();
+
+    printf("SAMM explicit-free stress test (%ld items in one scope)\n\n", count);
+
+    void** items = (void**)malloc(sizeof(void*) * (size_t)count);
+    if (!items) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    SAMMStats before, after;
+    samm_get_stats(&before);
+
+    samm_enter_scope();
+
+    /* --- Fill the scope with generic heap blocks --- */
+    double t0 = now_seconds();
+    for (long i = 0; i < count; i++) {
+        items[i] = malloc(16);
+        samm_track(items[i], SAMM_ALLOC_GENERIC);
+    }
+
+    /* --- Objects: track, then free oldest first --- */
+    long nobj = count / 10;
+    void** objs = (void**)malloc(sizeof(void*) * (size_t)(nobj ? nobj : 1));
+    for (long i = 0; i < nobj; i++) {
+        objs[i] = samm_alloc_object(OBJECT_SIZE);
+        samm_track_object(objs[i]);
+    }
+    double t1 = now_seconds();
+    for (long i = 0; i < nobj; i++) {
+        samm_free_object(objs[i]);
+    }
+    double t2 = now_seconds();
+
+    /* --- Generic blocks: untrack oldest first, then free --- */
+    for (long i = 0; i < count; i++) {
+        samm_untrack(items[i]);
+        free(items[i]);
+    }
+    double t3 = now_seconds();
+
+    printf("  track   %8ld allocations: %7.3f s\n", count + nobj, t1 - t0);
+    printf("  free    %8ld objects:     %7.3f s\n", nobj, t2 - t1);
+    printf("  untrack %8ld blocks:      %7.3f s\n\n", count, t3 - t2);
+
+    samm_exit_scope();
+    samm_wait();
+    samm_get_stats(&after);
+
+    free(objs);
+    free(items);
+
+    int failures = 0;
+    failures += check(after.objects_freed - before.objects_freed ==
+                      (uint64_t)nobj, "every object freed explicitly");
+    failures += check(after.objects_cleaned == before.objects_cleaned,
+                      "scope exit found nothing left to clean");
+    failures += check(after.double_free_attempts == before.double_free_attempts,
+                      "no double frees detected");
+
+    samm_shutdown();
+
+    printf("\n%s\n", failures ? "FAILED" : "ALL PASSED");
+    return failures ? 1 : 0;
+}
@@ -11,6 +11,14 @@
  * The only synchronization is a single mutex+condvar per FUTURE,
  * used to signal completion.
  *
+ * Thread pool:
+ * - Non-messaging workers run as tasks on a persistent pool of one
+ *   thread per core, started on the first SPAWN
+ * - Each pool thread owns a deque: it pushes and pops its own tasks at
+ *   the back (LIFO), idle threads steal from the front (FIFO)
+ * - AWAIT on an unfinished future runs queued tasks on the waiting
+ *   thread instead of blocking, and only sleeps when there are none
+ *
  * Messaging extension:
  * - FutureHandle now carries optional outbox/inbox MessageQueue pointers
  * - worker_spawn_messaging() allocates queues for bidirectional messaging
@@ -19,10 +27,12 @@
  */
 
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <unistd.h>
 #include "array_descriptor.h"
 
 /* ── Forward declarations for messaging (implemented in messaging.zig) ─ */
@@ -78,15 +88,16 @@ void worker_args_set_ptr(WorkerArgs *args, int32_t index, void *value) {
 /* ── Future handle ─────────────────────────────────────────────────── */
 
 /**
- * A FutureHandle represents a running or completed worker.
- * It owns the thread, the argument block, the result, and
- * optional messaging queues.
+ * A FutureHandle represents a queued, running or completed worker.
+ * It owns the argument block, the result, optional messaging queues,
+ * and — for messaging workers — the thread.
  */
 typedef struct {
-    pthread_t       thread;
+    pthread_t       thread;     /* valid only when own_thread is set */
     pthread_mutex_t mutex;
     pthread_cond_t  cond;
-    int             done;       /* 0 = running, 1 = completed */
+    atomic_int      done;       /* 0 = queued/running, 1 = completed */
+    int32_t         own_thread; /* 1 = dedicated thread, 0 = pool task */
     double          result;     /* result stored as double (64 bits) */
     int32_t         ret_type;   /* 0=double, 1=int, 2=ptr */
 
@@ -115,10 +126,10 @@ int32_t worker_future_inbox_offset(void) {
     return (int32_t)offsetof(FutureHandle, inbox);
 }
 
-/* ── Thread entry point ────────────────────────────────────────────── */
+/* ── Running a worker ───────────────────────────────────────────────── */
 
 /**
- * Generic worker thread function.
+ * Call the worker function with its packed arguments.
  *
  * The compiled worker function is a normal QBE function with typed
  * parameters.  We call it via a function pointer, passing arguments
@@ -128,9 +139,7 @@ int32_t worker_future_inbox_offset(void) {
  * we can call them with up to 8 double arguments directly.  For
  * simplicity and safety, we support up to 8 double args.
  */
-static void *worker_thread_entry(void *ctx) {
-    FutureHandle *fh = (FutureHandle *)ctx;
-
+static double worker_call(FutureHandle *fh) {
     /* Cast the function pointer based on argument count.
      * QBE functions use the platform ABI, so we can call them
      * with the right number of double arguments.
@@ -194,20 +203,234 @@ static void *worker_thread_entry(void *ctx) {
             break;
     }
 
-    /* Signal completion */
+    return result;
+}
+
+/**
+ * Run a worker to completion on the calling thread and wake anyone
+ * blocked in worker_await on it.
+ */
+static void worker_run(FutureHandle *fh) {
+    double result = worker_call(fh);
+
     pthread_mutex_lock(&fh->mutex);
     fh->result = result;
-    fh->done = 1;
+    atomic_store_explicit(&fh->done, 1, memory_order_release);
     pthread_cond_signal(&fh->cond);
     pthread_mutex_unlock(&fh->mutex);
+}
+
+/** Entry point for workers with a dedicated thread (messaging workers). */
+static void *worker_thread_entry(void *ctx) {
+    worker_run((FutureHandle *)ctx);
+    return NULL;
+}
+
+/* ── Thread pool ───────────────────────────────────────────────────── */
+
+/*
+ * A work deque is a growable ring of pending tasks behind a mutex.
+ * The owning pool thread pushes and pops at the back; everyone else
+ * (idle pool threads, threads helping in worker_await) takes from the
+ * front, so thieves get the oldest tasks and the owner keeps the
+ * newest, cache-warm ones.  Tasks spawned from outside the pool are
+ * dealt round-robin onto the deques' backs.
+ *
+ * `pending` counts tasks sitting in deques; it only changes under a
+ * deque lock.  A pool thread that finds nothing to do sleeps on
+ * `wake` until pending goes non-zero; spawners signal only when
+ * `sleepers` says someone is asleep.  Both counters are seq_cst, so a
+ * spawner either sees the sleeper or the sleeper sees the task.
+ */
+
+#define WORKER_DEQUE_INITIAL 64
+
+typedef struct {
+    pthread_mutex_t lock;
+    FutureHandle  **ring;
+    size_t          capacity;   /* power of two */
+    size_t          head;       /* front: oldest task */
+    size_t          count;
+} WorkDeque;
+
+typedef struct {
+    int32_t         nthreads;
+    WorkDeque      *deques;     /* one per pool thread */
+    pthread_mutex_t sleep_lock;
+    pthread_cond_t  wake;
+    atomic_long     pending;
+    atomic_int      sleepers;
+    atomic_uint     next_deque; /* round-robin target for outside spawns */
+} WorkerPool;
+
+static WorkerPool     g_pool;
+static pthread_once_t g_pool_once = PTHREAD_ONCE_INIT;
+
+/* Index of the calling thread's deque, or -1 outside the pool. */
+static __thread int32_t tls_pool_index = -1;
+
+static int deque_push_back(WorkDeque *dq, FutureHandle *fh) {
+    pthread_mutex_lock(&dq->lock);
+    if (dq->count == dq->capacity) {
+        size_t cap = dq->capacity ? dq->capacity * 2 : WORKER_DEQUE_INITIAL;
+        FutureHandle **ring = (FutureHandle **)malloc(cap * sizeof(*ring));
+        if (!ring) {
+            pthread_mutex_unlock(&dq->lock);
+            return 0;
+        }
+        for (size_t i = 0; i < dq->count; i++)
+            ring[i] = dq->ring[(dq->head + i) & (dq->capacity - 1)];
+        free(dq->ring);
+        dq->ring     = ring;
+        dq->capacity = cap;
+        dq->head     = 0;
+    }
+    dq->ring[(dq->head + dq->count) & (dq->capacity - 1)] = fh;
+    dq->count++;
+    atomic_fetch_add(&g_pool.pending, 1);
+    pthread_mutex_unlock(&dq->lock);
+    return 1;
+}
+
+static FutureHandle *deque_pop_back(WorkDeque *dq) {
+    FutureHandle *fh = NULL;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->count > 0) {
+        dq->count--;
+        fh = dq->ring[(dq->head + dq->count) & (dq->capacity - 1)];
+        atomic_fetch_sub(&g_pool.pending, 1);
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return fh;
+}
+
+static FutureHandle *deque_pop_front(WorkDeque *dq) {
+    FutureHandle *fh = NULL;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->count > 0) {
+        fh = dq->ring[dq->head];
+        dq->head = (dq->head + 1) & (dq->capacity - 1);
+        dq->count--;
+        atomic_fetch_sub(&g_pool.pending, 1);
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return fh;
+}
 
+/**
+ * Find a task for the calling thread: its own deque's newest task
+ * first (pool threads only), then the oldest task of every other deque.
+ * Returns NULL when all deques are empty.
+ */
+static FutureHandle *pool_take_task(void) {
+    int32_t n    = g_pool.nthreads;
+    int32_t self = tls_pool_index;
+    FutureHandle *fh;
+
+    if (n == 0 || atomic_load(&g_pool.pending) == 0) return NULL;
+
+    if (self >= 0 && (fh = deque_pop_back(&g_pool.deques[self])) != NULL)
+        return fh;
+
+    int32_t start = self >= 0
+        ? self + 1
+        : (int32_t)(atomic_load_explicit(&g_pool.next_deque,
+                                         memory_order_relaxed) % (unsigned)n);
+    for (int32_t i = 0; i < n; i++) {
+        int32_t victim = (start + i) % n;
+        if (victim == self) continue;
+        if ((fh = deque_pop_front(&g_pool.deques[victim])) != NULL)
+            return fh;
+    }
     return NULL;
 }
 
+static void *pool_thread_main(void *arg) {
+    tls_pool_index = (int32_t)(intptr_t)arg;
+
+    for (;;) {
+        FutureHandle *fh = pool_take_task();
+        if (fh) {
+            worker_run(fh);
+            continue;
+        }
+
+        pthread_mutex_lock(&g_pool.sleep_lock);
+        atomic_fetch_add(&g_pool.sleepers, 1);
+        while (atomic_load(&g_pool.pending) == 0)
+            pthread_cond_wait(&g_pool.wake, &g_pool.sleep_lock);
+        atomic_fetch_sub(&g_pool.sleepers, 1);
+        pthread_mutex_unlock(&g_pool.sleep_lock);
+    }
+    return NULL;
+}
+
+static void pool_init(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) cores = 1;
+    if (cores > 256) cores = 256;
+
+    pthread_mutex_init(&g_pool.sleep_lock, NULL);
+    pthread_cond_init(&g_pool.wake, NULL);
+    atomic_init(&g_pool.pending, 0);
+    atomic_init(&g_pool.sleepers, 0);
+    atomic_init(&g_pool.next_deque, 0);
+
+    g_pool.deques = (WorkDeque *)calloc((size_t)cores, sizeof(WorkDeque));
+    if (!g_pool.deques) return;
+    for (long i = 0; i < cores; i++)
+        pthread_mutex_init(&g_pool.deques[i].lock, NULL);
+
+    /* Pool threads never exit; they die with the process.  Deques of
+     * threads that fail to start still get tasks and are drained by
+     * stealing; with no thread at all, spawns fall back to one thread
+     * per worker. */
+    g_pool.nthreads = (int32_t)cores;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+    int32_t started = 0;
+    for (long i = 0; i < cores; i++) {
+        pthread_t t;
+        if (pthread_create(&t, &attr, pool_thread_main, (void *)(intptr_t)i) == 0)
+            started++;
+    }
+    pthread_attr_destroy(&attr);
+
+    if (started == 0) g_pool.nthreads = 0;
+}
+
+/**
+ * Queue a task on the pool.  Returns 0 if there is no pool (no thread
+ * could be started) or the deque could not grow, in which case the
+ * caller falls back to a dedicated thread.
+ */
+static int pool_submit(FutureHandle *fh) {
+    pthread_once(&g_pool_once, pool_init);
+    int32_t n = g_pool.nthreads;
+    if (n == 0) return 0;
+
+    int32_t target = tls_pool_index >= 0
+        ? tls_pool_index
+        : (int32_t)(atomic_fetch_add_explicit(&g_pool.next_deque, 1,
+                                              memory_order_relaxed) % (unsigned)n);
+    if (!deque_push_back(&g_pool.deques[target], fh)) return 0;
+
+    if (atomic_load(&g_pool.sleepers) > 0) {
+        pthread_mutex_lock(&g_pool.sleep_lock);
+        pthread_cond_signal(&g_pool.wake);
+        pthread_mutex_unlock(&g_pool.sleep_lock);
+    }
+    return 1;
+}
+
+
 /* ── Public API ────────────────────────────────────────────────────── */
 
 /**
- * Spawn a worker on a new thread (non-messaging).
+ * Spawn a worker as a pool task (non-messaging).
  *
  * @param func_ptr  Pointer to the compiled worker function
  * @param args      Packed argument block (ownership transferred)
@@ -224,15 +447,18 @@ FutureHandle *worker_spawn(void *func_ptr, WorkerArgs *args,
     fh->args     = args;
     fh->num_args = num_args;
     fh->ret_type = ret_type;
-    fh->done     = 0;
     fh->result   = 0.0;
     fh->outbox   = NULL;
     fh->inbox    = NULL;
+    atomic_init(&fh->done, 0);
 
     pthread_mutex_init(&fh->mutex, NULL);
     pthread_cond_init(&fh->cond, NULL);
 
-    pthread_create(&fh->thread, NULL, worker_thread_entry, fh);
+    if (!pool_submit(fh)) {
+        fh->own_thread = 1;
+        pthread_create(&fh->thread, NULL, worker_thread_entry, fh);
+    }
 
     return fh;
 }
@@ -242,6 +468,8 @@ FutureHandle *worker_spawn(void *func_ptr, WorkerArgs *args,
  *
  * Creates outbox and inbox message queues and passes the FutureHandle
  * pointer as a hidden last argument so the worker can access PARENT.
+ * Messaging workers keep a dedicated thread: they block in RECEIVE,
+ * which on the pool would tie up a core or deadlock it outright.
  *
  * @param func_ptr  Pointer to the compiled worker function
  * @param args      Packed argument block (ownership transferred)
@@ -257,8 +485,8 @@ FutureHandle *worker_spawn_messaging(void *func_ptr, WorkerArgs *args,
     fh->func_ptr = func_ptr;
     fh->args     = args;
     fh->ret_type = ret_type;
-    fh->done     = 0;
     fh->result   = 0.0;
+    atomic_init(&fh->done, 0);
 
     /* Allocate messaging queues */
     fh->outbox = msg_queue_create();
@@ -272,6 +500,7 @@ FutureHandle *worker_spawn_messaging(void *func_ptr, WorkerArgs *args,
     pthread_mutex_init(&fh->mutex, NULL);
     pthread_cond_init(&fh->cond, NULL);
 
+    fh->own_thread = 1;
     pthread_create(&fh->thread, NULL, worker_thread_entry, fh);
 
     return fh;
@@ -281,6 +510,10 @@ FutureHandle *worker_spawn_messaging(void *func_ptr, WorkerArgs *args,
  * Wait for a worker to complete and return its result.
  * After this call, the future handle is destroyed and must not be reused.
  *
+ * While the worker is unfinished, the caller runs queued pool tasks
+ * (possibly the awaited one itself) rather than sleeping; it blocks
+ * only once there is nothing left to take.
+ *
  * If the worker had messaging queues, they are closed, drained, and
  * destroyed before the handle is freed.
  *
@@ -290,16 +523,21 @@ FutureHandle *worker_spawn_messaging(void *func_ptr, WorkerArgs *args,
 double worker_await(FutureHandle *handle) {
     if (!handle) return 0.0;
 
+    while (!atomic_load_explicit(&handle->done, memory_order_acquire)) {
+        FutureHandle *task = pool_take_task();
+        if (!task) break;
+        worker_run(task);
+    }
+
     pthread_mutex_lock(&handle->mutex);
-    while (!handle->done) {
+    while (!atomic_load_explicit(&handle->done, memory_order_relaxed)) {
         pthread_cond_wait(&handle->cond, &handle->mutex);
     }
-    pthread_mutex_unlock(&handle->mutex);
-
     double result = handle->result;
+    pthread_mutex_unlock(&handle->mutex);
 
     /* Clean up thread */
-    pthread_join(handle->thread, NULL);
+    if (handle->own_thread) pthread_join(handle->thread, NULL);
     pthread_mutex_destroy(&handle->mutex);
     pthread_cond_destroy(&handle->cond);
 
@@ -325,11 +563,7 @@ double worker_await(FutureHandle *handle) {
 int32_t worker_ready(FutureHandle *handle) {
     if (!handle) return 1;
 
-    pthread_mutex_lock(&handle->mutex);
-    int done = handle->done;
-    pthread_mutex_unlock(&handle->mutex);
-
-    return done ? 1 : 0;
+    return atomic_load_explicit(&handle->done, memory_order_acquire) ? 1 : 0;
 }
 
 /* ── MARSHALL / UNMARSHALL ─────────────────────────────────────────── */